@@ -0,0 +1,542 @@
+# CMAKE generated file: DO NOT EDIT!
+# Generated by "Unix Makefiles" Generator, CMake Version 3.25
+
+# The generator used is:
+set(CMAKE_DEPENDS_GENERATOR "Unix Makefiles")
+
+# The top level Makefile was generated from the following files:
+set(CMAKE_MAKEFILE_DEPENDS
+  "CMakeCache.txt"
+  "/root/repo/CMakeLists.txt"
+  "/root/repo/DuckDBConfig.cmake.in"
+  "/root/repo/DuckDBConfigVersion.cmake.in"
+  "CMakeFiles/3.25.1/CMakeCCompiler.cmake"
+  "CMakeFiles/3.25.1/CMakeCXXCompiler.cmake"
+  "CMakeFiles/3.25.1/CMakeSystem.cmake"
+  "/root/repo/extension/CMakeLists.txt"
+  "/root/repo/extension/httpfs/CMakeLists.txt"
+  "/root/repo/extension/parquet/CMakeLists.txt"
+  "/root/repo/src/CMakeLists.txt"
+  "/root/repo/src/catalog/CMakeLists.txt"
+  "/root/repo/src/catalog/catalog_entry/CMakeLists.txt"
+  "/root/repo/src/catalog/default/CMakeLists.txt"
+  "/root/repo/src/common/CMakeLists.txt"
+  "/root/repo/src/common/crypto/CMakeLists.txt"
+  "/root/repo/src/common/enums/CMakeLists.txt"
+  "/root/repo/src/common/operator/CMakeLists.txt"
+  "/root/repo/src/common/serializer/CMakeLists.txt"
+  "/root/repo/src/common/types/CMakeLists.txt"
+  "/root/repo/src/common/value_operations/CMakeLists.txt"
+  "/root/repo/src/common/vector_operations/CMakeLists.txt"
+  "/root/repo/src/execution/CMakeLists.txt"
+  "/root/repo/src/execution/expression_executor/CMakeLists.txt"
+  "/root/repo/src/execution/index/art/CMakeLists.txt"
+  "/root/repo/src/execution/merge_join/CMakeLists.txt"
+  "/root/repo/src/execution/nested_loop_join/CMakeLists.txt"
+  "/root/repo/src/execution/operator/CMakeLists.txt"
+  "/root/repo/src/execution/operator/aggregate/CMakeLists.txt"
+  "/root/repo/src/execution/operator/filter/CMakeLists.txt"
+  "/root/repo/src/execution/operator/helper/CMakeLists.txt"
+  "/root/repo/src/execution/operator/join/CMakeLists.txt"
+  "/root/repo/src/execution/operator/order/CMakeLists.txt"
+  "/root/repo/src/execution/operator/persistent/CMakeLists.txt"
+  "/root/repo/src/execution/operator/projection/CMakeLists.txt"
+  "/root/repo/src/execution/operator/scan/CMakeLists.txt"
+  "/root/repo/src/execution/operator/schema/CMakeLists.txt"
+  "/root/repo/src/execution/operator/set/CMakeLists.txt"
+  "/root/repo/src/execution/physical_plan/CMakeLists.txt"
+  "/root/repo/src/function/CMakeLists.txt"
+  "/root/repo/src/function/aggregate/CMakeLists.txt"
+  "/root/repo/src/function/aggregate/algebraic/CMakeLists.txt"
+  "/root/repo/src/function/aggregate/distributive/CMakeLists.txt"
+  "/root/repo/src/function/aggregate/holistic/CMakeLists.txt"
+  "/root/repo/src/function/aggregate/nested/CMakeLists.txt"
+  "/root/repo/src/function/aggregate/regression/CMakeLists.txt"
+  "/root/repo/src/function/pragma/CMakeLists.txt"
+  "/root/repo/src/function/scalar/CMakeLists.txt"
+  "/root/repo/src/function/scalar/blob/CMakeLists.txt"
+  "/root/repo/src/function/scalar/date/CMakeLists.txt"
+  "/root/repo/src/function/scalar/generic/CMakeLists.txt"
+  "/root/repo/src/function/scalar/math/CMakeLists.txt"
+  "/root/repo/src/function/scalar/nested/CMakeLists.txt"
+  "/root/repo/src/function/scalar/operators/CMakeLists.txt"
+  "/root/repo/src/function/scalar/sequence/CMakeLists.txt"
+  "/root/repo/src/function/scalar/string/CMakeLists.txt"
+  "/root/repo/src/function/table/CMakeLists.txt"
+  "/root/repo/src/function/table/information_schema/CMakeLists.txt"
+  "/root/repo/src/function/table/sqlite/CMakeLists.txt"
+  "/root/repo/src/function/table/version/CMakeLists.txt"
+  "/root/repo/src/main/CMakeLists.txt"
+  "/root/repo/src/main/relation/CMakeLists.txt"
+  "/root/repo/src/optimizer/CMakeLists.txt"
+  "/root/repo/src/optimizer/join_order/CMakeLists.txt"
+  "/root/repo/src/optimizer/matcher/CMakeLists.txt"
+  "/root/repo/src/optimizer/pullup/CMakeLists.txt"
+  "/root/repo/src/optimizer/pushdown/CMakeLists.txt"
+  "/root/repo/src/optimizer/rule/CMakeLists.txt"
+  "/root/repo/src/optimizer/statistics/CMakeLists.txt"
+  "/root/repo/src/optimizer/statistics/expression/CMakeLists.txt"
+  "/root/repo/src/optimizer/statistics/operator/CMakeLists.txt"
+  "/root/repo/src/parallel/CMakeLists.txt"
+  "/root/repo/src/parser/CMakeLists.txt"
+  "/root/repo/src/parser/constraints/CMakeLists.txt"
+  "/root/repo/src/parser/expression/CMakeLists.txt"
+  "/root/repo/src/parser/parsed_data/CMakeLists.txt"
+  "/root/repo/src/parser/query_node/CMakeLists.txt"
+  "/root/repo/src/parser/statement/CMakeLists.txt"
+  "/root/repo/src/parser/tableref/CMakeLists.txt"
+  "/root/repo/src/parser/transform/CMakeLists.txt"
+  "/root/repo/src/parser/transform/constraint/CMakeLists.txt"
+  "/root/repo/src/parser/transform/expression/CMakeLists.txt"
+  "/root/repo/src/parser/transform/helpers/CMakeLists.txt"
+  "/root/repo/src/parser/transform/statement/CMakeLists.txt"
+  "/root/repo/src/parser/transform/tableref/CMakeLists.txt"
+  "/root/repo/src/planner/CMakeLists.txt"
+  "/root/repo/src/planner/binder/CMakeLists.txt"
+  "/root/repo/src/planner/binder/expression/CMakeLists.txt"
+  "/root/repo/src/planner/binder/query_node/CMakeLists.txt"
+  "/root/repo/src/planner/binder/statement/CMakeLists.txt"
+  "/root/repo/src/planner/binder/tableref/CMakeLists.txt"
+  "/root/repo/src/planner/expression/CMakeLists.txt"
+  "/root/repo/src/planner/expression_binder/CMakeLists.txt"
+  "/root/repo/src/planner/operator/CMakeLists.txt"
+  "/root/repo/src/planner/subquery/CMakeLists.txt"
+  "/root/repo/src/storage/CMakeLists.txt"
+  "/root/repo/src/storage/buffer/CMakeLists.txt"
+  "/root/repo/src/storage/checkpoint/CMakeLists.txt"
+  "/root/repo/src/storage/statistics/CMakeLists.txt"
+  "/root/repo/src/storage/table/CMakeLists.txt"
+  "/root/repo/src/transaction/CMakeLists.txt"
+  "/root/repo/test/CMakeLists.txt"
+  "/root/repo/test/api/CMakeLists.txt"
+  "/root/repo/test/api/capi/CMakeLists.txt"
+  "/root/repo/test/api/udf_function/CMakeLists.txt"
+  "/root/repo/test/appender/CMakeLists.txt"
+  "/root/repo/test/common/CMakeLists.txt"
+  "/root/repo/test/helpers/CMakeLists.txt"
+  "/root/repo/test/persistence/CMakeLists.txt"
+  "/root/repo/test/sql/CMakeLists.txt"
+  "/root/repo/test/sql/index/CMakeLists.txt"
+  "/root/repo/test/sql/parallelism/CMakeLists.txt"
+  "/root/repo/test/sql/parallelism/interquery/CMakeLists.txt"
+  "/root/repo/test/sql/storage/CMakeLists.txt"
+  "/root/repo/test/sql/storage/catalog/CMakeLists.txt"
+  "/root/repo/test/sql/tpcds/CMakeLists.txt"
+  "/root/repo/test/sqlite/CMakeLists.txt"
+  "/root/repo/third_party/CMakeLists.txt"
+  "/root/repo/third_party/dsdgen/CMakeLists.txt"
+  "/root/repo/third_party/dsdgen/dsdgen-c/CMakeLists.txt"
+  "/root/repo/third_party/fmt/CMakeLists.txt"
+  "/root/repo/third_party/hyperloglog/CMakeLists.txt"
+  "/root/repo/third_party/imdb/CMakeLists.txt"
+  "/root/repo/third_party/libpg_query/CMakeLists.txt"
+  "/root/repo/third_party/miniz/CMakeLists.txt"
+  "/root/repo/third_party/re2/CMakeLists.txt"
+  "/root/repo/third_party/sqlite/CMakeLists.txt"
+  "/root/repo/third_party/utf8proc/CMakeLists.txt"
+  "/root/repo/tools/CMakeLists.txt"
+  "/root/repo/tools/shell/CMakeLists.txt"
+  "/root/repo/tools/sqlite3_api_wrapper/CMakeLists.txt"
+  "/root/repo/tools/sqlite3_api_wrapper/sqlite3/CMakeLists.txt"
+  "/usr/share/cmake-3.25/Modules/CMakeCCompiler.cmake.in"
+  "/usr/share/cmake-3.25/Modules/CMakeCCompilerABI.c"
+  "/usr/share/cmake-3.25/Modules/CMakeCInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCXXCompiler.cmake.in"
+  "/usr/share/cmake-3.25/Modules/CMakeCXXCompilerABI.cpp"
+  "/usr/share/cmake-3.25/Modules/CMakeCXXInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCommonLanguageInclude.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCompilerIdDetection.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeDetermineCCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeDetermineCXXCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeDetermineCompileFeatures.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeDetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeDetermineCompilerABI.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeDetermineCompilerId.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeDetermineSystem.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeFindBinUtils.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeGenericSystem.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeInitializeConfigs.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeLanguageInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeParseImplicitIncludeInfo.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeParseImplicitLinkInfo.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeParseLibraryArchitecture.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystem.cmake.in"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInitialize.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeTestCCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeTestCXXCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeTestCompilerCommon.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeUnixFindMake.cmake"
+  "/usr/share/cmake-3.25/Modules/CTest.cmake"
+  "/usr/share/cmake-3.25/Modules/CTestTargets.cmake"
+  "/usr/share/cmake-3.25/Modules/CTestUseLaunchers.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckCSourceCompiles.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckIncludeFile.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckLibraryExists.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/ADSP-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/ARMCC-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/ARMClang-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/AppleClang-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/Borland-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/Bruce-C-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/CMakeCommonCompilerMacros.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/Clang-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/Clang-DetermineCompilerInternal.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/Comeau-CXX-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/Compaq-C-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/Compaq-CXX-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/Cray-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/Embarcadero-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/Fujitsu-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/FujitsuClang-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GHS-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU-C-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU-C.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU-CXX-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU-CXX.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU-FindBinUtils.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/HP-C-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/HP-CXX-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/IAR-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/IBMCPP-C-DetermineVersionInternal.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/IBMCPP-CXX-DetermineVersionInternal.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/IBMClang-C-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/IBMClang-CXX-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/Intel-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/IntelLLVM-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/LCC-C-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/LCC-CXX-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/MSVC-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/NVHPC-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/NVIDIA-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/OpenWatcom-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/PGI-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/PathScale-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/SCO-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/SDCC-C-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/SunPro-C-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/SunPro-CXX-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/TI-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/Tasking-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/TinyCC-C-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/VisualAge-C-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/VisualAge-CXX-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/Watcom-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/XL-C-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/XL-CXX-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/XLClang-C-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/XLClang-CXX-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/zOS-C-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/zOS-CXX-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/DartConfiguration.tcl.in"
+  "/usr/share/cmake-3.25/Modules/FindOpenSSL.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPackageHandleStandardArgs.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPackageMessage.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPkgConfig.cmake"
+  "/usr/share/cmake-3.25/Modules/FindThreads.cmake"
+  "/usr/share/cmake-3.25/Modules/Internal/CheckSourceCompiles.cmake"
+  "/usr/share/cmake-3.25/Modules/Internal/FeatureTesting.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-Determine-CXX.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU-C.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU-CXX.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/UnixPaths.cmake"
+  )
+
+# The corresponding makefile is:
+set(CMAKE_MAKEFILE_OUTPUTS
+  "Makefile"
+  "CMakeFiles/cmake.check_cache"
+  )
+
+# Byproducts of CMake generate step:
+set(CMAKE_MAKEFILE_PRODUCTS
+  "CMakeFiles/3.25.1/CMakeSystem.cmake"
+  "CMakeFiles/3.25.1/CMakeCCompiler.cmake"
+  "CMakeFiles/3.25.1/CMakeCXXCompiler.cmake"
+  "CMakeFiles/3.25.1/CMakeCCompiler.cmake"
+  "CMakeFiles/3.25.1/CMakeCXXCompiler.cmake"
+  "DuckDBConfig.cmake"
+  "CMakeFiles/DuckDBConfig.cmake"
+  "DuckDBConfigVersion.cmake"
+  "CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/optimizer/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/optimizer/matcher/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/optimizer/join_order/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/optimizer/pushdown/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/optimizer/pullup/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/optimizer/rule/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/optimizer/statistics/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/optimizer/statistics/expression/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/optimizer/statistics/operator/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/planner/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/planner/expression/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/planner/binder/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/planner/binder/expression/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/planner/binder/query_node/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/planner/binder/statement/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/planner/binder/tableref/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/planner/expression_binder/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/planner/operator/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/planner/subquery/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/parser/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/parser/constraints/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/parser/expression/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/parser/parsed_data/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/parser/query_node/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/parser/statement/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/parser/tableref/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/parser/transform/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/parser/transform/constraint/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/parser/transform/expression/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/parser/transform/helpers/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/parser/transform/statement/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/parser/transform/tableref/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/function/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/function/aggregate/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/function/aggregate/algebraic/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/function/aggregate/distributive/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/function/aggregate/holistic/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/function/aggregate/nested/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/function/aggregate/regression/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/function/pragma/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/function/scalar/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/function/scalar/blob/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/function/scalar/date/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/function/scalar/generic/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/function/scalar/math/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/function/scalar/operators/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/function/scalar/sequence/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/function/scalar/string/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/function/scalar/nested/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/function/table/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/function/table/information_schema/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/function/table/sqlite/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/function/table/version/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/catalog/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/catalog/catalog_entry/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/catalog/default/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/common/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/common/crypto/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/common/enums/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/common/operator/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/common/serializer/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/common/types/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/common/value_operations/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/common/vector_operations/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/execution/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/execution/expression_executor/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/execution/merge_join/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/execution/nested_loop_join/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/execution/operator/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/execution/operator/aggregate/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/execution/operator/filter/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/execution/operator/helper/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/execution/operator/join/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/execution/operator/order/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/execution/operator/persistent/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/execution/operator/projection/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/execution/operator/scan/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/execution/operator/schema/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/execution/operator/set/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/execution/physical_plan/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/execution/index/art/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/main/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/main/relation/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/parallel/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/storage/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/storage/buffer/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/storage/checkpoint/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/storage/statistics/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/storage/table/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/transaction/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "extension/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "extension/parquet/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "extension/httpfs/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "test/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "test/api/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "test/api/capi/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "test/api/udf_function/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "test/appender/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "test/common/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "test/helpers/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "test/sql/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "test/sql/index/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "test/sql/parallelism/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "test/sql/parallelism/interquery/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "test/sql/storage/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "test/sql/storage/catalog/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "test/sql/tpcds/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "test/sqlite/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "test/persistence/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "third_party/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "third_party/fmt/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "third_party/libpg_query/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "third_party/re2/DartConfiguration.tcl"
+  "third_party/re2/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "third_party/miniz/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "third_party/utf8proc/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "third_party/hyperloglog/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "third_party/imdb/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "third_party/dsdgen/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "third_party/dsdgen/dsdgen-c/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "third_party/sqlite/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "tools/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "tools/sqlite3_api_wrapper/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "tools/sqlite3_api_wrapper/sqlite3/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "tools/shell/CMakeFiles/CMakeDirectoryInformation.cmake"
+  )
+
+# Dependency information for all targets:
+set(CMAKE_DEPEND_INFO_FILES
+  "src/CMakeFiles/duckdb.dir/DependInfo.cmake"
+  "src/CMakeFiles/duckdb_static.dir/DependInfo.cmake"
+  "src/optimizer/CMakeFiles/duckdb_optimizer.dir/DependInfo.cmake"
+  "src/optimizer/matcher/CMakeFiles/duckdb_optimizer_matcher.dir/DependInfo.cmake"
+  "src/optimizer/join_order/CMakeFiles/duckdb_optimizer_join_order.dir/DependInfo.cmake"
+  "src/optimizer/pushdown/CMakeFiles/duckdb_optimizer_pushdown.dir/DependInfo.cmake"
+  "src/optimizer/pullup/CMakeFiles/duckdb_optimizer_pullup.dir/DependInfo.cmake"
+  "src/optimizer/rule/CMakeFiles/duckdb_optimizer_rules.dir/DependInfo.cmake"
+  "src/optimizer/statistics/expression/CMakeFiles/duckdb_optimizer_statistics_expr.dir/DependInfo.cmake"
+  "src/optimizer/statistics/operator/CMakeFiles/duckdb_optimizer_statistics_op.dir/DependInfo.cmake"
+  "src/planner/CMakeFiles/duckdb_planner.dir/DependInfo.cmake"
+  "src/planner/expression/CMakeFiles/duckdb_planner_expression.dir/DependInfo.cmake"
+  "src/planner/binder/expression/CMakeFiles/duckdb_bind_expression.dir/DependInfo.cmake"
+  "src/planner/binder/query_node/CMakeFiles/duckdb_bind_query_node.dir/DependInfo.cmake"
+  "src/planner/binder/statement/CMakeFiles/duckdb_bind_statement.dir/DependInfo.cmake"
+  "src/planner/binder/tableref/CMakeFiles/duckdb_bind_tableref.dir/DependInfo.cmake"
+  "src/planner/expression_binder/CMakeFiles/duckdb_expression_binders.dir/DependInfo.cmake"
+  "src/planner/operator/CMakeFiles/duckdb_planner_operator.dir/DependInfo.cmake"
+  "src/planner/subquery/CMakeFiles/duckdb_planner_subquery.dir/DependInfo.cmake"
+  "src/parser/CMakeFiles/duckdb_parser.dir/DependInfo.cmake"
+  "src/parser/constraints/CMakeFiles/duckdb_constraints.dir/DependInfo.cmake"
+  "src/parser/expression/CMakeFiles/duckdb_expression.dir/DependInfo.cmake"
+  "src/parser/parsed_data/CMakeFiles/duckdb_parsed_data.dir/DependInfo.cmake"
+  "src/parser/query_node/CMakeFiles/duckdb_query_node.dir/DependInfo.cmake"
+  "src/parser/statement/CMakeFiles/duckdb_statement.dir/DependInfo.cmake"
+  "src/parser/tableref/CMakeFiles/duckdb_parser_tableref.dir/DependInfo.cmake"
+  "src/parser/transform/constraint/CMakeFiles/duckdb_transformer_constraint.dir/DependInfo.cmake"
+  "src/parser/transform/expression/CMakeFiles/duckdb_transformer_expression.dir/DependInfo.cmake"
+  "src/parser/transform/helpers/CMakeFiles/duckdb_transformer_helpers.dir/DependInfo.cmake"
+  "src/parser/transform/statement/CMakeFiles/duckdb_transformer_statement.dir/DependInfo.cmake"
+  "src/parser/transform/tableref/CMakeFiles/duckdb_transformer_tableref.dir/DependInfo.cmake"
+  "src/function/CMakeFiles/duckdb_function.dir/DependInfo.cmake"
+  "src/function/aggregate/CMakeFiles/duckdb_func_aggr.dir/DependInfo.cmake"
+  "src/function/aggregate/algebraic/CMakeFiles/duckdb_aggr_algebraic.dir/DependInfo.cmake"
+  "src/function/aggregate/distributive/CMakeFiles/duckdb_aggr_distr.dir/DependInfo.cmake"
+  "src/function/aggregate/holistic/CMakeFiles/duckdb_aggr_holistic.dir/DependInfo.cmake"
+  "src/function/aggregate/nested/CMakeFiles/duckdb_aggr_nested.dir/DependInfo.cmake"
+  "src/function/aggregate/regression/CMakeFiles/duckdb_aggr_regr.dir/DependInfo.cmake"
+  "src/function/pragma/CMakeFiles/duckdb_func_pragma.dir/DependInfo.cmake"
+  "src/function/scalar/CMakeFiles/duckdb_func_scalar.dir/DependInfo.cmake"
+  "src/function/scalar/blob/CMakeFiles/duckdb_func_blob.dir/DependInfo.cmake"
+  "src/function/scalar/date/CMakeFiles/duckdb_func_date.dir/DependInfo.cmake"
+  "src/function/scalar/generic/CMakeFiles/duckdb_func_generic.dir/DependInfo.cmake"
+  "src/function/scalar/math/CMakeFiles/duckdb_func_math.dir/DependInfo.cmake"
+  "src/function/scalar/operators/CMakeFiles/duckdb_func_ops.dir/DependInfo.cmake"
+  "src/function/scalar/sequence/CMakeFiles/duckdb_func_seq.dir/DependInfo.cmake"
+  "src/function/scalar/string/CMakeFiles/duckdb_func_string.dir/DependInfo.cmake"
+  "src/function/scalar/nested/CMakeFiles/duckdb_func_nested.dir/DependInfo.cmake"
+  "src/function/table/CMakeFiles/duckdb_func_table.dir/DependInfo.cmake"
+  "src/function/table/information_schema/CMakeFiles/duckdb_func_information_schema.dir/DependInfo.cmake"
+  "src/function/table/sqlite/CMakeFiles/duckdb_func_sqlite.dir/DependInfo.cmake"
+  "src/function/table/version/CMakeFiles/duckdb_func_table_version.dir/DependInfo.cmake"
+  "src/catalog/CMakeFiles/duckdb_catalog.dir/DependInfo.cmake"
+  "src/catalog/catalog_entry/CMakeFiles/duckdb_catalog_entries.dir/DependInfo.cmake"
+  "src/catalog/default/CMakeFiles/duckdb_catalog_default_entries.dir/DependInfo.cmake"
+  "src/common/CMakeFiles/duckdb_common.dir/DependInfo.cmake"
+  "src/common/crypto/CMakeFiles/duckdb_common_crypto.dir/DependInfo.cmake"
+  "src/common/enums/CMakeFiles/duckdb_common_enums.dir/DependInfo.cmake"
+  "src/common/operator/CMakeFiles/duckdb_common_operators.dir/DependInfo.cmake"
+  "src/common/serializer/CMakeFiles/duckdb_common_serializer.dir/DependInfo.cmake"
+  "src/common/types/CMakeFiles/duckdb_common_types.dir/DependInfo.cmake"
+  "src/common/value_operations/CMakeFiles/duckdb_value_operations.dir/DependInfo.cmake"
+  "src/common/vector_operations/CMakeFiles/duckdb_vector_operations.dir/DependInfo.cmake"
+  "src/execution/CMakeFiles/duckdb_execution.dir/DependInfo.cmake"
+  "src/execution/expression_executor/CMakeFiles/duckdb_expression_executor.dir/DependInfo.cmake"
+  "src/execution/merge_join/CMakeFiles/duckdb_merge_join.dir/DependInfo.cmake"
+  "src/execution/nested_loop_join/CMakeFiles/duckdb_nested_loop_join.dir/DependInfo.cmake"
+  "src/execution/operator/aggregate/CMakeFiles/duckdb_operator_aggregate.dir/DependInfo.cmake"
+  "src/execution/operator/filter/CMakeFiles/duckdb_operator_filter.dir/DependInfo.cmake"
+  "src/execution/operator/helper/CMakeFiles/duckdb_operator_helper.dir/DependInfo.cmake"
+  "src/execution/operator/join/CMakeFiles/duckdb_operator_join.dir/DependInfo.cmake"
+  "src/execution/operator/order/CMakeFiles/duckdb_operator_order.dir/DependInfo.cmake"
+  "src/execution/operator/persistent/CMakeFiles/duckdb_operator_persistent.dir/DependInfo.cmake"
+  "src/execution/operator/projection/CMakeFiles/duckdb_operator_projection.dir/DependInfo.cmake"
+  "src/execution/operator/scan/CMakeFiles/duckdb_operator_scan.dir/DependInfo.cmake"
+  "src/execution/operator/schema/CMakeFiles/duckdb_operator_schema.dir/DependInfo.cmake"
+  "src/execution/operator/set/CMakeFiles/duckdb_operator_set.dir/DependInfo.cmake"
+  "src/execution/physical_plan/CMakeFiles/duckdb_physical_plan.dir/DependInfo.cmake"
+  "src/execution/index/art/CMakeFiles/duckdb_art_index_execution.dir/DependInfo.cmake"
+  "src/main/CMakeFiles/duckdb_main.dir/DependInfo.cmake"
+  "src/main/relation/CMakeFiles/duckdb_main_relation.dir/DependInfo.cmake"
+  "src/parallel/CMakeFiles/duckdb_parallel.dir/DependInfo.cmake"
+  "src/storage/CMakeFiles/duckdb_storage.dir/DependInfo.cmake"
+  "src/storage/buffer/CMakeFiles/duckdb_storage_buffer.dir/DependInfo.cmake"
+  "src/storage/checkpoint/CMakeFiles/duckdb_storage_checkpoint.dir/DependInfo.cmake"
+  "src/storage/statistics/CMakeFiles/duckdb_storage_statistics.dir/DependInfo.cmake"
+  "src/storage/table/CMakeFiles/duckdb_storage_table.dir/DependInfo.cmake"
+  "src/transaction/CMakeFiles/duckdb_transaction.dir/DependInfo.cmake"
+  "extension/parquet/CMakeFiles/parquet_extension.dir/DependInfo.cmake"
+  "extension/httpfs/CMakeFiles/httpfs_extension.dir/DependInfo.cmake"
+  "test/CMakeFiles/unittest.dir/DependInfo.cmake"
+  "test/api/CMakeFiles/test_api.dir/DependInfo.cmake"
+  "test/api/capi/CMakeFiles/test_sql_capi.dir/DependInfo.cmake"
+  "test/api/udf_function/CMakeFiles/test_api_udf_function.dir/DependInfo.cmake"
+  "test/appender/CMakeFiles/test_appender.dir/DependInfo.cmake"
+  "test/common/CMakeFiles/test_common.dir/DependInfo.cmake"
+  "test/helpers/CMakeFiles/test_helpers.dir/DependInfo.cmake"
+  "test/sql/index/CMakeFiles/test_index.dir/DependInfo.cmake"
+  "test/sql/parallelism/interquery/CMakeFiles/test_sql_interquery_parallelism.dir/DependInfo.cmake"
+  "test/sql/storage/CMakeFiles/test_sql_storage.dir/DependInfo.cmake"
+  "test/sql/storage/catalog/CMakeFiles/test_sql_storage_catalog.dir/DependInfo.cmake"
+  "test/sql/tpcds/CMakeFiles/test_sql_tpcds.dir/DependInfo.cmake"
+  "test/sqlite/CMakeFiles/test_sqlite.dir/DependInfo.cmake"
+  "test/persistence/CMakeFiles/test_persistence.dir/DependInfo.cmake"
+  "third_party/fmt/CMakeFiles/fmt.dir/DependInfo.cmake"
+  "third_party/libpg_query/CMakeFiles/pg_query.dir/DependInfo.cmake"
+  "third_party/re2/CMakeFiles/Experimental.dir/DependInfo.cmake"
+  "third_party/re2/CMakeFiles/Nightly.dir/DependInfo.cmake"
+  "third_party/re2/CMakeFiles/Continuous.dir/DependInfo.cmake"
+  "third_party/re2/CMakeFiles/NightlyMemoryCheck.dir/DependInfo.cmake"
+  "third_party/re2/CMakeFiles/NightlyStart.dir/DependInfo.cmake"
+  "third_party/re2/CMakeFiles/NightlyUpdate.dir/DependInfo.cmake"
+  "third_party/re2/CMakeFiles/NightlyConfigure.dir/DependInfo.cmake"
+  "third_party/re2/CMakeFiles/NightlyBuild.dir/DependInfo.cmake"
+  "third_party/re2/CMakeFiles/NightlyTest.dir/DependInfo.cmake"
+  "third_party/re2/CMakeFiles/NightlyCoverage.dir/DependInfo.cmake"
+  "third_party/re2/CMakeFiles/NightlyMemCheck.dir/DependInfo.cmake"
+  "third_party/re2/CMakeFiles/NightlySubmit.dir/DependInfo.cmake"
+  "third_party/re2/CMakeFiles/ExperimentalStart.dir/DependInfo.cmake"
+  "third_party/re2/CMakeFiles/ExperimentalUpdate.dir/DependInfo.cmake"
+  "third_party/re2/CMakeFiles/ExperimentalConfigure.dir/DependInfo.cmake"
+  "third_party/re2/CMakeFiles/ExperimentalBuild.dir/DependInfo.cmake"
+  "third_party/re2/CMakeFiles/ExperimentalTest.dir/DependInfo.cmake"
+  "third_party/re2/CMakeFiles/ExperimentalCoverage.dir/DependInfo.cmake"
+  "third_party/re2/CMakeFiles/ExperimentalMemCheck.dir/DependInfo.cmake"
+  "third_party/re2/CMakeFiles/ExperimentalSubmit.dir/DependInfo.cmake"
+  "third_party/re2/CMakeFiles/ContinuousStart.dir/DependInfo.cmake"
+  "third_party/re2/CMakeFiles/ContinuousUpdate.dir/DependInfo.cmake"
+  "third_party/re2/CMakeFiles/ContinuousConfigure.dir/DependInfo.cmake"
+  "third_party/re2/CMakeFiles/ContinuousBuild.dir/DependInfo.cmake"
+  "third_party/re2/CMakeFiles/ContinuousTest.dir/DependInfo.cmake"
+  "third_party/re2/CMakeFiles/ContinuousCoverage.dir/DependInfo.cmake"
+  "third_party/re2/CMakeFiles/ContinuousMemCheck.dir/DependInfo.cmake"
+  "third_party/re2/CMakeFiles/ContinuousSubmit.dir/DependInfo.cmake"
+  "third_party/re2/CMakeFiles/duckdb_re2.dir/DependInfo.cmake"
+  "third_party/miniz/CMakeFiles/miniz.dir/DependInfo.cmake"
+  "third_party/utf8proc/CMakeFiles/utf8proc.dir/DependInfo.cmake"
+  "third_party/hyperloglog/CMakeFiles/hyperloglog.dir/DependInfo.cmake"
+  "third_party/imdb/CMakeFiles/imdb.dir/DependInfo.cmake"
+  "third_party/dsdgen/CMakeFiles/dsdgen.dir/DependInfo.cmake"
+  "third_party/dsdgen/dsdgen-c/CMakeFiles/dsdgen_c.dir/DependInfo.cmake"
+  "third_party/sqlite/CMakeFiles/sqlite3.dir/DependInfo.cmake"
+  "tools/sqlite3_api_wrapper/CMakeFiles/sqlite3_api_wrapper_static.dir/DependInfo.cmake"
+  "tools/sqlite3_api_wrapper/CMakeFiles/sqlite3_api_wrapper.dir/DependInfo.cmake"
+  "tools/sqlite3_api_wrapper/CMakeFiles/test_sqlite3_api_wrapper.dir/DependInfo.cmake"
+  "tools/sqlite3_api_wrapper/sqlite3/CMakeFiles/sqlite3_api_wrapper_sqlite3.dir/DependInfo.cmake"
+  "tools/shell/CMakeFiles/shell.dir/DependInfo.cmake"
+  )
@@ -0,0 +1,23 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/extension/httpfs/crypto.cpp" "extension/httpfs/CMakeFiles/httpfs_extension.dir/crypto.cpp.o" "gcc" "extension/httpfs/CMakeFiles/httpfs_extension.dir/crypto.cpp.o.d"
+  "/root/repo/extension/httpfs/http_block_cache.cpp" "extension/httpfs/CMakeFiles/httpfs_extension.dir/http_block_cache.cpp.o" "gcc" "extension/httpfs/CMakeFiles/httpfs_extension.dir/http_block_cache.cpp.o.d"
+  "/root/repo/extension/httpfs/httpfs-extension.cpp" "extension/httpfs/CMakeFiles/httpfs_extension.dir/httpfs-extension.cpp.o" "gcc" "extension/httpfs/CMakeFiles/httpfs_extension.dir/httpfs-extension.cpp.o.d"
+  "/root/repo/extension/httpfs/httpfs.cpp" "extension/httpfs/CMakeFiles/httpfs_extension.dir/httpfs.cpp.o" "gcc" "extension/httpfs/CMakeFiles/httpfs_extension.dir/httpfs.cpp.o.d"
+  "/root/repo/extension/httpfs/s3fs.cpp" "extension/httpfs/CMakeFiles/httpfs_extension.dir/s3fs.cpp.o" "gcc" "extension/httpfs/CMakeFiles/httpfs_extension.dir/s3fs.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,19 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/httpfs_extension.dir/crypto.cpp.o"
+  "CMakeFiles/httpfs_extension.dir/crypto.cpp.o.d"
+  "CMakeFiles/httpfs_extension.dir/http_block_cache.cpp.o"
+  "CMakeFiles/httpfs_extension.dir/http_block_cache.cpp.o.d"
+  "CMakeFiles/httpfs_extension.dir/httpfs-extension.cpp.o"
+  "CMakeFiles/httpfs_extension.dir/httpfs-extension.cpp.o.d"
+  "CMakeFiles/httpfs_extension.dir/httpfs.cpp.o"
+  "CMakeFiles/httpfs_extension.dir/httpfs.cpp.o.d"
+  "CMakeFiles/httpfs_extension.dir/s3fs.cpp.o"
+  "CMakeFiles/httpfs_extension.dir/s3fs.cpp.o.d"
+  "libhttpfs_extension.a"
+  "libhttpfs_extension.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/httpfs_extension.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,79 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/parquet_extension.dir/__/__/third_party/parquet/parquet_constants.cpp.o"
+  "CMakeFiles/parquet_extension.dir/__/__/third_party/parquet/parquet_constants.cpp.o.d"
+  "CMakeFiles/parquet_extension.dir/__/__/third_party/parquet/parquet_types.cpp.o"
+  "CMakeFiles/parquet_extension.dir/__/__/third_party/parquet/parquet_types.cpp.o.d"
+  "CMakeFiles/parquet_extension.dir/__/__/third_party/snappy/snappy-sinksource.cc.o"
+  "CMakeFiles/parquet_extension.dir/__/__/third_party/snappy/snappy-sinksource.cc.o.d"
+  "CMakeFiles/parquet_extension.dir/__/__/third_party/snappy/snappy.cc.o"
+  "CMakeFiles/parquet_extension.dir/__/__/third_party/snappy/snappy.cc.o.d"
+  "CMakeFiles/parquet_extension.dir/__/__/third_party/thrift/thrift/protocol/TProtocol.cpp.o"
+  "CMakeFiles/parquet_extension.dir/__/__/third_party/thrift/thrift/protocol/TProtocol.cpp.o.d"
+  "CMakeFiles/parquet_extension.dir/__/__/third_party/thrift/thrift/transport/TBufferTransports.cpp.o"
+  "CMakeFiles/parquet_extension.dir/__/__/third_party/thrift/thrift/transport/TBufferTransports.cpp.o.d"
+  "CMakeFiles/parquet_extension.dir/__/__/third_party/thrift/thrift/transport/TTransportException.cpp.o"
+  "CMakeFiles/parquet_extension.dir/__/__/third_party/thrift/thrift/transport/TTransportException.cpp.o.d"
+  "CMakeFiles/parquet_extension.dir/__/__/third_party/zstd/common/entropy_common.cpp.o"
+  "CMakeFiles/parquet_extension.dir/__/__/third_party/zstd/common/entropy_common.cpp.o.d"
+  "CMakeFiles/parquet_extension.dir/__/__/third_party/zstd/common/error_private.cpp.o"
+  "CMakeFiles/parquet_extension.dir/__/__/third_party/zstd/common/error_private.cpp.o.d"
+  "CMakeFiles/parquet_extension.dir/__/__/third_party/zstd/common/fse_decompress.cpp.o"
+  "CMakeFiles/parquet_extension.dir/__/__/third_party/zstd/common/fse_decompress.cpp.o.d"
+  "CMakeFiles/parquet_extension.dir/__/__/third_party/zstd/common/xxhash.cpp.o"
+  "CMakeFiles/parquet_extension.dir/__/__/third_party/zstd/common/xxhash.cpp.o.d"
+  "CMakeFiles/parquet_extension.dir/__/__/third_party/zstd/common/zstd_common.cpp.o"
+  "CMakeFiles/parquet_extension.dir/__/__/third_party/zstd/common/zstd_common.cpp.o.d"
+  "CMakeFiles/parquet_extension.dir/__/__/third_party/zstd/compress/fse_compress.cpp.o"
+  "CMakeFiles/parquet_extension.dir/__/__/third_party/zstd/compress/fse_compress.cpp.o.d"
+  "CMakeFiles/parquet_extension.dir/__/__/third_party/zstd/compress/hist.cpp.o"
+  "CMakeFiles/parquet_extension.dir/__/__/third_party/zstd/compress/hist.cpp.o.d"
+  "CMakeFiles/parquet_extension.dir/__/__/third_party/zstd/compress/huf_compress.cpp.o"
+  "CMakeFiles/parquet_extension.dir/__/__/third_party/zstd/compress/huf_compress.cpp.o.d"
+  "CMakeFiles/parquet_extension.dir/__/__/third_party/zstd/compress/zstd_compress.cpp.o"
+  "CMakeFiles/parquet_extension.dir/__/__/third_party/zstd/compress/zstd_compress.cpp.o.d"
+  "CMakeFiles/parquet_extension.dir/__/__/third_party/zstd/compress/zstd_compress_literals.cpp.o"
+  "CMakeFiles/parquet_extension.dir/__/__/third_party/zstd/compress/zstd_compress_literals.cpp.o.d"
+  "CMakeFiles/parquet_extension.dir/__/__/third_party/zstd/compress/zstd_compress_sequences.cpp.o"
+  "CMakeFiles/parquet_extension.dir/__/__/third_party/zstd/compress/zstd_compress_sequences.cpp.o.d"
+  "CMakeFiles/parquet_extension.dir/__/__/third_party/zstd/compress/zstd_compress_superblock.cpp.o"
+  "CMakeFiles/parquet_extension.dir/__/__/third_party/zstd/compress/zstd_compress_superblock.cpp.o.d"
+  "CMakeFiles/parquet_extension.dir/__/__/third_party/zstd/compress/zstd_double_fast.cpp.o"
+  "CMakeFiles/parquet_extension.dir/__/__/third_party/zstd/compress/zstd_double_fast.cpp.o.d"
+  "CMakeFiles/parquet_extension.dir/__/__/third_party/zstd/compress/zstd_fast.cpp.o"
+  "CMakeFiles/parquet_extension.dir/__/__/third_party/zstd/compress/zstd_fast.cpp.o.d"
+  "CMakeFiles/parquet_extension.dir/__/__/third_party/zstd/compress/zstd_lazy.cpp.o"
+  "CMakeFiles/parquet_extension.dir/__/__/third_party/zstd/compress/zstd_lazy.cpp.o.d"
+  "CMakeFiles/parquet_extension.dir/__/__/third_party/zstd/compress/zstd_ldm.cpp.o"
+  "CMakeFiles/parquet_extension.dir/__/__/third_party/zstd/compress/zstd_ldm.cpp.o.d"
+  "CMakeFiles/parquet_extension.dir/__/__/third_party/zstd/compress/zstd_opt.cpp.o"
+  "CMakeFiles/parquet_extension.dir/__/__/third_party/zstd/compress/zstd_opt.cpp.o.d"
+  "CMakeFiles/parquet_extension.dir/__/__/third_party/zstd/decompress/huf_decompress.cpp.o"
+  "CMakeFiles/parquet_extension.dir/__/__/third_party/zstd/decompress/huf_decompress.cpp.o.d"
+  "CMakeFiles/parquet_extension.dir/__/__/third_party/zstd/decompress/zstd_ddict.cpp.o"
+  "CMakeFiles/parquet_extension.dir/__/__/third_party/zstd/decompress/zstd_ddict.cpp.o.d"
+  "CMakeFiles/parquet_extension.dir/__/__/third_party/zstd/decompress/zstd_decompress.cpp.o"
+  "CMakeFiles/parquet_extension.dir/__/__/third_party/zstd/decompress/zstd_decompress.cpp.o.d"
+  "CMakeFiles/parquet_extension.dir/__/__/third_party/zstd/decompress/zstd_decompress_block.cpp.o"
+  "CMakeFiles/parquet_extension.dir/__/__/third_party/zstd/decompress/zstd_decompress_block.cpp.o.d"
+  "CMakeFiles/parquet_extension.dir/column_reader.cpp.o"
+  "CMakeFiles/parquet_extension.dir/column_reader.cpp.o.d"
+  "CMakeFiles/parquet_extension.dir/parquet-extension.cpp.o"
+  "CMakeFiles/parquet_extension.dir/parquet-extension.cpp.o.d"
+  "CMakeFiles/parquet_extension.dir/parquet_file_metadata_cache.cpp.o"
+  "CMakeFiles/parquet_extension.dir/parquet_file_metadata_cache.cpp.o.d"
+  "CMakeFiles/parquet_extension.dir/parquet_reader.cpp.o"
+  "CMakeFiles/parquet_extension.dir/parquet_reader.cpp.o.d"
+  "CMakeFiles/parquet_extension.dir/parquet_statistics.cpp.o"
+  "CMakeFiles/parquet_extension.dir/parquet_statistics.cpp.o.d"
+  "CMakeFiles/parquet_extension.dir/parquet_timestamp.cpp.o"
+  "CMakeFiles/parquet_extension.dir/parquet_timestamp.cpp.o.d"
+  "CMakeFiles/parquet_extension.dir/parquet_writer.cpp.o"
+  "CMakeFiles/parquet_extension.dir/parquet_writer.cpp.o.d"
+  "libparquet_extension.a"
+  "libparquet_extension.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/parquet_extension.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,19 @@
+// Unity Build generated by CMake
+#line 0 "copy_function_catalog_entry.cpp"
+#include </root/repo/src/catalog/catalog_entry/copy_function_catalog_entry.cpp>
+#line 0 "index_catalog_entry.cpp"
+#include </root/repo/src/catalog/catalog_entry/index_catalog_entry.cpp>
+#line 0 "macro_catalog_entry.cpp"
+#include </root/repo/src/catalog/catalog_entry/macro_catalog_entry.cpp>
+#line 0 "pragma_function_catalog_entry.cpp"
+#include </root/repo/src/catalog/catalog_entry/pragma_function_catalog_entry.cpp>
+#line 0 "schema_catalog_entry.cpp"
+#include </root/repo/src/catalog/catalog_entry/schema_catalog_entry.cpp>
+#line 0 "sequence_catalog_entry.cpp"
+#include </root/repo/src/catalog/catalog_entry/sequence_catalog_entry.cpp>
+#line 0 "table_catalog_entry.cpp"
+#include </root/repo/src/catalog/catalog_entry/table_catalog_entry.cpp>
+#line 0 "table_function_catalog_entry.cpp"
+#include </root/repo/src/catalog/catalog_entry/table_function_catalog_entry.cpp>
+#line 0 "view_catalog_entry.cpp"
+#include </root/repo/src/catalog/catalog_entry/view_catalog_entry.cpp>
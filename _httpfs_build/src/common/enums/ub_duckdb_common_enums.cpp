@@ -0,0 +1,17 @@
+// Unity Build generated by CMake
+#line 0 "catalog_type.cpp"
+#include </root/repo/src/common/enums/catalog_type.cpp>
+#line 0 "compression_type.cpp"
+#include </root/repo/src/common/enums/compression_type.cpp>
+#line 0 "expression_type.cpp"
+#include </root/repo/src/common/enums/expression_type.cpp>
+#line 0 "join_type.cpp"
+#include </root/repo/src/common/enums/join_type.cpp>
+#line 0 "logical_operator_type.cpp"
+#include </root/repo/src/common/enums/logical_operator_type.cpp>
+#line 0 "physical_operator_type.cpp"
+#include </root/repo/src/common/enums/physical_operator_type.cpp>
+#line 0 "statement_type.cpp"
+#include </root/repo/src/common/enums/statement_type.cpp>
+#line 0 "relation_type.cpp"
+#include </root/repo/src/common/enums/relation_type.cpp>
@@ -0,0 +1,9 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/duckdb_common_operators.dir/ub_duckdb_common_operators.cpp.o"
+  "CMakeFiles/duckdb_common_operators.dir/ub_duckdb_common_operators.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/duckdb_common_operators.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
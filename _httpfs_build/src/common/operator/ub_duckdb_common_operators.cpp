@@ -0,0 +1,3 @@
+// Unity Build generated by CMake
+#line 0 "cast_operators.cpp"
+#include </root/repo/src/common/operator/cast_operators.cpp>
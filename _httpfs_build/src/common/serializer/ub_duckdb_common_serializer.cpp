@@ -0,0 +1,9 @@
+// Unity Build generated by CMake
+#line 0 "buffered_deserializer.cpp"
+#include </root/repo/src/common/serializer/buffered_deserializer.cpp>
+#line 0 "buffered_file_reader.cpp"
+#include </root/repo/src/common/serializer/buffered_file_reader.cpp>
+#line 0 "buffered_file_writer.cpp"
+#include </root/repo/src/common/serializer/buffered_file_writer.cpp>
+#line 0 "buffered_serializer.cpp"
+#include </root/repo/src/common/serializer/buffered_serializer.cpp>
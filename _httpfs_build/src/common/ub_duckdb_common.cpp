@@ -0,0 +1,35 @@
+// Unity Build generated by CMake
+#line 0 "assert.cpp"
+#include </root/repo/src/common/assert.cpp>
+#line 0 "constants.cpp"
+#include </root/repo/src/common/constants.cpp>
+#line 0 "checksum.cpp"
+#include </root/repo/src/common/checksum.cpp>
+#line 0 "exception.cpp"
+#include </root/repo/src/common/exception.cpp>
+#line 0 "exception_format_value.cpp"
+#include </root/repo/src/common/exception_format_value.cpp>
+#line 0 "file_buffer.cpp"
+#include </root/repo/src/common/file_buffer.cpp>
+#line 0 "file_system.cpp"
+#include </root/repo/src/common/file_system.cpp>
+#line 0 "gzip_stream.cpp"
+#include </root/repo/src/common/gzip_stream.cpp>
+#line 0 "limits.cpp"
+#include </root/repo/src/common/limits.cpp>
+#line 0 "printer.cpp"
+#include </root/repo/src/common/printer.cpp>
+#line 0 "progress_bar.cpp"
+#include </root/repo/src/common/progress_bar.cpp>
+#line 0 "serializer.cpp"
+#include </root/repo/src/common/serializer.cpp>
+#line 0 "string_util.cpp"
+#include </root/repo/src/common/string_util.cpp>
+#line 0 "symbols.cpp"
+#include </root/repo/src/common/symbols.cpp>
+#line 0 "tree_renderer.cpp"
+#include </root/repo/src/common/tree_renderer.cpp>
+#line 0 "types.cpp"
+#include </root/repo/src/common/types.cpp>
+#line 0 "fstream_util.cpp"
+#include </root/repo/src/common/fstream_util.cpp>
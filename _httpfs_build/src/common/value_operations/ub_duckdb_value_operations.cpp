@@ -0,0 +1,7 @@
+// Unity Build generated by CMake
+#line 0 "comparison_operations.cpp"
+#include </root/repo/src/common/value_operations/comparison_operations.cpp>
+#line 0 "hash.cpp"
+#include </root/repo/src/common/value_operations/hash.cpp>
+#line 0 "numeric_operations.cpp"
+#include </root/repo/src/common/value_operations/numeric_operations.cpp>
@@ -0,0 +1,23 @@
+// Unity Build generated by CMake
+#line 0 "boolean_operators.cpp"
+#include </root/repo/src/common/vector_operations/boolean_operators.cpp>
+#line 0 "vector_cast.cpp"
+#include </root/repo/src/common/vector_operations/vector_cast.cpp>
+#line 0 "comparison_operators.cpp"
+#include </root/repo/src/common/vector_operations/comparison_operators.cpp>
+#line 0 "vector_copy.cpp"
+#include </root/repo/src/common/vector_operations/vector_copy.cpp>
+#line 0 "generators.cpp"
+#include </root/repo/src/common/vector_operations/generators.cpp>
+#line 0 "gather.cpp"
+#include </root/repo/src/common/vector_operations/gather.cpp>
+#line 0 "vector_hash.cpp"
+#include </root/repo/src/common/vector_operations/vector_hash.cpp>
+#line 0 "vector_storage.cpp"
+#include </root/repo/src/common/vector_operations/vector_storage.cpp>
+#line 0 "null_operations.cpp"
+#include </root/repo/src/common/vector_operations/null_operations.cpp>
+#line 0 "numeric_inplace_operators.cpp"
+#include </root/repo/src/common/vector_operations/numeric_inplace_operators.cpp>
+#line 0 "is_distinct_from.cpp"
+#include </root/repo/src/common/vector_operations/is_distinct_from.cpp>
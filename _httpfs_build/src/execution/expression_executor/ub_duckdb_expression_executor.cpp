@@ -0,0 +1,21 @@
+// Unity Build generated by CMake
+#line 0 "execute_between.cpp"
+#include </root/repo/src/execution/expression_executor/execute_between.cpp>
+#line 0 "execute_case.cpp"
+#include </root/repo/src/execution/expression_executor/execute_case.cpp>
+#line 0 "execute_cast.cpp"
+#include </root/repo/src/execution/expression_executor/execute_cast.cpp>
+#line 0 "execute_comparison.cpp"
+#include </root/repo/src/execution/expression_executor/execute_comparison.cpp>
+#line 0 "execute_conjunction.cpp"
+#include </root/repo/src/execution/expression_executor/execute_conjunction.cpp>
+#line 0 "execute_constant.cpp"
+#include </root/repo/src/execution/expression_executor/execute_constant.cpp>
+#line 0 "execute_function.cpp"
+#include </root/repo/src/execution/expression_executor/execute_function.cpp>
+#line 0 "execute_operator.cpp"
+#include </root/repo/src/execution/expression_executor/execute_operator.cpp>
+#line 0 "execute_parameter.cpp"
+#include </root/repo/src/execution/expression_executor/execute_parameter.cpp>
+#line 0 "execute_reference.cpp"
+#include </root/repo/src/execution/expression_executor/execute_reference.cpp>
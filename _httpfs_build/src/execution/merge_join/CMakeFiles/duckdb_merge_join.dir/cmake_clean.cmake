@@ -0,0 +1,9 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/duckdb_merge_join.dir/ub_duckdb_merge_join.cpp.o"
+  "CMakeFiles/duckdb_merge_join.dir/ub_duckdb_merge_join.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/duckdb_merge_join.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
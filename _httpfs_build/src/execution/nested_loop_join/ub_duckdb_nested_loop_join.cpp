@@ -0,0 +1,5 @@
+// Unity Build generated by CMake
+#line 0 "nested_loop_join_inner.cpp"
+#include </root/repo/src/execution/nested_loop_join/nested_loop_join_inner.cpp>
+#line 0 "nested_loop_join_mark.cpp"
+#include </root/repo/src/execution/nested_loop_join/nested_loop_join_mark.cpp>
@@ -0,0 +1,9 @@
+// Unity Build generated by CMake
+#line 0 "physical_hash_aggregate.cpp"
+#include </root/repo/src/execution/operator/aggregate/physical_hash_aggregate.cpp>
+#line 0 "physical_perfecthash_aggregate.cpp"
+#include </root/repo/src/execution/operator/aggregate/physical_perfecthash_aggregate.cpp>
+#line 0 "physical_simple_aggregate.cpp"
+#include </root/repo/src/execution/operator/aggregate/physical_simple_aggregate.cpp>
+#line 0 "physical_window.cpp"
+#include </root/repo/src/execution/operator/aggregate/physical_window.cpp>
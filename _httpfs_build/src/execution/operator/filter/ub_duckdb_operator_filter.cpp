@@ -0,0 +1,3 @@
+// Unity Build generated by CMake
+#line 0 "physical_filter.cpp"
+#include </root/repo/src/execution/operator/filter/physical_filter.cpp>
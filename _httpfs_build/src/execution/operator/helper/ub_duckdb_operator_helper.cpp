@@ -0,0 +1,19 @@
+// Unity Build generated by CMake
+#line 0 "physical_execute.cpp"
+#include </root/repo/src/execution/operator/helper/physical_execute.cpp>
+#line 0 "physical_limit.cpp"
+#include </root/repo/src/execution/operator/helper/physical_limit.cpp>
+#line 0 "physical_pragma.cpp"
+#include </root/repo/src/execution/operator/helper/physical_pragma.cpp>
+#line 0 "physical_prepare.cpp"
+#include </root/repo/src/execution/operator/helper/physical_prepare.cpp>
+#line 0 "physical_reservoir_sample.cpp"
+#include </root/repo/src/execution/operator/helper/physical_reservoir_sample.cpp>
+#line 0 "physical_set.cpp"
+#include </root/repo/src/execution/operator/helper/physical_set.cpp>
+#line 0 "physical_streaming_sample.cpp"
+#include </root/repo/src/execution/operator/helper/physical_streaming_sample.cpp>
+#line 0 "physical_transaction.cpp"
+#include </root/repo/src/execution/operator/helper/physical_transaction.cpp>
+#line 0 "physical_vacuum.cpp"
+#include </root/repo/src/execution/operator/helper/physical_vacuum.cpp>
@@ -0,0 +1,7 @@
+// Unity Build generated by CMake
+#line 0 "physical_order.cpp"
+#include </root/repo/src/execution/operator/order/physical_order.cpp>
+#line 0 "physical_top_n.cpp"
+#include </root/repo/src/execution/operator/order/physical_top_n.cpp>
+#line 0 "sorted_run.cpp"
+#include </root/repo/src/execution/operator/order/sorted_run.cpp>
@@ -0,0 +1,9 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/duckdb_operator_scan.dir/ub_duckdb_operator_scan.cpp.o"
+  "CMakeFiles/duckdb_operator_scan.dir/ub_duckdb_operator_scan.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/duckdb_operator_scan.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
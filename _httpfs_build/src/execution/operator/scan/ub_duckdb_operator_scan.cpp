@@ -0,0 +1,11 @@
+// Unity Build generated by CMake
+#line 0 "physical_chunk_scan.cpp"
+#include </root/repo/src/execution/operator/scan/physical_chunk_scan.cpp>
+#line 0 "physical_dummy_scan.cpp"
+#include </root/repo/src/execution/operator/scan/physical_dummy_scan.cpp>
+#line 0 "physical_empty_result.cpp"
+#include </root/repo/src/execution/operator/scan/physical_empty_result.cpp>
+#line 0 "physical_expression_scan.cpp"
+#include </root/repo/src/execution/operator/scan/physical_expression_scan.cpp>
+#line 0 "physical_table_scan.cpp"
+#include </root/repo/src/execution/operator/scan/physical_table_scan.cpp>
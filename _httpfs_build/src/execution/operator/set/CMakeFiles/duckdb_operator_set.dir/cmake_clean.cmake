@@ -0,0 +1,9 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/duckdb_operator_set.dir/ub_duckdb_operator_set.cpp.o"
+  "CMakeFiles/duckdb_operator_set.dir/ub_duckdb_operator_set.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/duckdb_operator_set.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
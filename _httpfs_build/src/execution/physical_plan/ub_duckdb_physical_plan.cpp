@@ -0,0 +1,75 @@
+// Unity Build generated by CMake
+#line 0 "plan_aggregate.cpp"
+#include </root/repo/src/execution/physical_plan/plan_aggregate.cpp>
+#line 0 "plan_any_join.cpp"
+#include </root/repo/src/execution/physical_plan/plan_any_join.cpp>
+#line 0 "plan_chunk_get.cpp"
+#include </root/repo/src/execution/physical_plan/plan_chunk_get.cpp>
+#line 0 "plan_comparison_join.cpp"
+#include </root/repo/src/execution/physical_plan/plan_comparison_join.cpp>
+#line 0 "plan_copy_to_file.cpp"
+#include </root/repo/src/execution/physical_plan/plan_copy_to_file.cpp>
+#line 0 "plan_create.cpp"
+#include </root/repo/src/execution/physical_plan/plan_create.cpp>
+#line 0 "plan_create_index.cpp"
+#include </root/repo/src/execution/physical_plan/plan_create_index.cpp>
+#line 0 "plan_create_table.cpp"
+#include </root/repo/src/execution/physical_plan/plan_create_table.cpp>
+#line 0 "plan_cross_product.cpp"
+#include </root/repo/src/execution/physical_plan/plan_cross_product.cpp>
+#line 0 "plan_delete.cpp"
+#include </root/repo/src/execution/physical_plan/plan_delete.cpp>
+#line 0 "plan_delim_get.cpp"
+#include </root/repo/src/execution/physical_plan/plan_delim_get.cpp>
+#line 0 "plan_delim_join.cpp"
+#include </root/repo/src/execution/physical_plan/plan_delim_join.cpp>
+#line 0 "plan_distinct.cpp"
+#include </root/repo/src/execution/physical_plan/plan_distinct.cpp>
+#line 0 "plan_dummy_scan.cpp"
+#include </root/repo/src/execution/physical_plan/plan_dummy_scan.cpp>
+#line 0 "plan_empty_result.cpp"
+#include </root/repo/src/execution/physical_plan/plan_empty_result.cpp>
+#line 0 "plan_execute.cpp"
+#include </root/repo/src/execution/physical_plan/plan_execute.cpp>
+#line 0 "plan_explain.cpp"
+#include </root/repo/src/execution/physical_plan/plan_explain.cpp>
+#line 0 "plan_export.cpp"
+#include </root/repo/src/execution/physical_plan/plan_export.cpp>
+#line 0 "plan_filter.cpp"
+#include </root/repo/src/execution/physical_plan/plan_filter.cpp>
+#line 0 "plan_get.cpp"
+#include </root/repo/src/execution/physical_plan/plan_get.cpp>
+#line 0 "plan_insert.cpp"
+#include </root/repo/src/execution/physical_plan/plan_insert.cpp>
+#line 0 "plan_limit.cpp"
+#include </root/repo/src/execution/physical_plan/plan_limit.cpp>
+#line 0 "plan_order.cpp"
+#include </root/repo/src/execution/physical_plan/plan_order.cpp>
+#line 0 "plan_pragma.cpp"
+#include </root/repo/src/execution/physical_plan/plan_pragma.cpp>
+#line 0 "plan_prepare.cpp"
+#include </root/repo/src/execution/physical_plan/plan_prepare.cpp>
+#line 0 "plan_projection.cpp"
+#include </root/repo/src/execution/physical_plan/plan_projection.cpp>
+#line 0 "plan_set_operation.cpp"
+#include </root/repo/src/execution/physical_plan/plan_set_operation.cpp>
+#line 0 "plan_set.cpp"
+#include </root/repo/src/execution/physical_plan/plan_set.cpp>
+#line 0 "plan_sample.cpp"
+#include </root/repo/src/execution/physical_plan/plan_sample.cpp>
+#line 0 "plan_show_select.cpp"
+#include </root/repo/src/execution/physical_plan/plan_show_select.cpp>
+#line 0 "plan_simple.cpp"
+#include </root/repo/src/execution/physical_plan/plan_simple.cpp>
+#line 0 "plan_top_n.cpp"
+#include </root/repo/src/execution/physical_plan/plan_top_n.cpp>
+#line 0 "plan_update.cpp"
+#include </root/repo/src/execution/physical_plan/plan_update.cpp>
+#line 0 "plan_window.cpp"
+#include </root/repo/src/execution/physical_plan/plan_window.cpp>
+#line 0 "plan_unnest.cpp"
+#include </root/repo/src/execution/physical_plan/plan_unnest.cpp>
+#line 0 "plan_expression_get.cpp"
+#include </root/repo/src/execution/physical_plan/plan_expression_get.cpp>
+#line 0 "plan_recursive_cte.cpp"
+#include </root/repo/src/execution/physical_plan/plan_recursive_cte.cpp>
@@ -0,0 +1,27 @@
+// Unity Build generated by CMake
+#line 0 "adaptive_filter.cpp"
+#include </root/repo/src/execution/adaptive_filter.cpp>
+#line 0 "aggregate_hashtable.cpp"
+#include </root/repo/src/execution/aggregate_hashtable.cpp>
+#line 0 "base_aggregate_hashtable.cpp"
+#include </root/repo/src/execution/base_aggregate_hashtable.cpp>
+#line 0 "column_binding_resolver.cpp"
+#include </root/repo/src/execution/column_binding_resolver.cpp>
+#line 0 "expression_executor.cpp"
+#include </root/repo/src/execution/expression_executor.cpp>
+#line 0 "expression_executor_state.cpp"
+#include </root/repo/src/execution/expression_executor_state.cpp>
+#line 0 "join_hashtable.cpp"
+#include </root/repo/src/execution/join_hashtable.cpp>
+#line 0 "partitionable_hashtable.cpp"
+#include </root/repo/src/execution/partitionable_hashtable.cpp>
+#line 0 "perfect_aggregate_hashtable.cpp"
+#include </root/repo/src/execution/perfect_aggregate_hashtable.cpp>
+#line 0 "physical_operator.cpp"
+#include </root/repo/src/execution/physical_operator.cpp>
+#line 0 "physical_plan_generator.cpp"
+#include </root/repo/src/execution/physical_plan_generator.cpp>
+#line 0 "reservoir_sample.cpp"
+#include </root/repo/src/execution/reservoir_sample.cpp>
+#line 0 "window_segment_tree.cpp"
+#include </root/repo/src/execution/window_segment_tree.cpp>
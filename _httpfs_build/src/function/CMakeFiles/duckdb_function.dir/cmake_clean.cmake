@@ -0,0 +1,9 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/duckdb_function.dir/ub_duckdb_function.cpp.o"
+  "CMakeFiles/duckdb_function.dir/ub_duckdb_function.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/duckdb_function.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
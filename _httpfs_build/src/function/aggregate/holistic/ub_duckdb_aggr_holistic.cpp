@@ -0,0 +1,7 @@
+// Unity Build generated by CMake
+#line 0 "quantile.cpp"
+#include </root/repo/src/function/aggregate/holistic/quantile.cpp>
+#line 0 "approximate_quantile.cpp"
+#include </root/repo/src/function/aggregate/holistic/approximate_quantile.cpp>
+#line 0 "reservoir_quantile.cpp"
+#include </root/repo/src/function/aggregate/holistic/reservoir_quantile.cpp>
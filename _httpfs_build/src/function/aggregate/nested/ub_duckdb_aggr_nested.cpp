@@ -0,0 +1,5 @@
+// Unity Build generated by CMake
+#line 0 "list.cpp"
+#include </root/repo/src/function/aggregate/nested/list.cpp>
+#line 0 "histogram.cpp"
+#include </root/repo/src/function/aggregate/nested/histogram.cpp>
@@ -0,0 +1,15 @@
+// Unity Build generated by CMake
+#line 0 "regr_avg.cpp"
+#include </root/repo/src/function/aggregate/regression/regr_avg.cpp>
+#line 0 "regr_count.cpp"
+#include </root/repo/src/function/aggregate/regression/regr_count.cpp>
+#line 0 "regr_slope.cpp"
+#include </root/repo/src/function/aggregate/regression/regr_slope.cpp>
+#line 0 "regr_r2.cpp"
+#include </root/repo/src/function/aggregate/regression/regr_r2.cpp>
+#line 0 "regr_sxx_syy.cpp"
+#include </root/repo/src/function/aggregate/regression/regr_sxx_syy.cpp>
+#line 0 "regr_sxy.cpp"
+#include </root/repo/src/function/aggregate/regression/regr_sxy.cpp>
+#line 0 "regr_intercept.cpp"
+#include </root/repo/src/function/aggregate/regression/regr_intercept.cpp>
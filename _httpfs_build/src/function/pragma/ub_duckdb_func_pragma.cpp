@@ -0,0 +1,5 @@
+// Unity Build generated by CMake
+#line 0 "pragma_functions.cpp"
+#include </root/repo/src/function/pragma/pragma_functions.cpp>
+#line 0 "pragma_queries.cpp"
+#include </root/repo/src/function/pragma/pragma_queries.cpp>
@@ -0,0 +1,15 @@
+// Unity Build generated by CMake
+#line 0 "age.cpp"
+#include </root/repo/src/function/scalar/date/age.cpp>
+#line 0 "current.cpp"
+#include </root/repo/src/function/scalar/date/current.cpp>
+#line 0 "epoch.cpp"
+#include </root/repo/src/function/scalar/date/epoch.cpp>
+#line 0 "date_trunc.cpp"
+#include </root/repo/src/function/scalar/date/date_trunc.cpp>
+#line 0 "date_part.cpp"
+#include </root/repo/src/function/scalar/date/date_part.cpp>
+#line 0 "strftime.cpp"
+#include </root/repo/src/function/scalar/date/strftime.cpp>
+#line 0 "to_interval.cpp"
+#include </root/repo/src/function/scalar/date/to_interval.cpp>
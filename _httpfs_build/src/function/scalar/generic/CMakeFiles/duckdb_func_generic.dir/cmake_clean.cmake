@@ -0,0 +1,9 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/duckdb_func_generic.dir/ub_duckdb_func_generic.cpp.o"
+  "CMakeFiles/duckdb_func_generic.dir/ub_duckdb_func_generic.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/duckdb_func_generic.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
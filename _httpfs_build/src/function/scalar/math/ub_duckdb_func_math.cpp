@@ -0,0 +1,7 @@
+// Unity Build generated by CMake
+#line 0 "numeric.cpp"
+#include </root/repo/src/function/scalar/math/numeric.cpp>
+#line 0 "random.cpp"
+#include </root/repo/src/function/scalar/math/random.cpp>
+#line 0 "setseed.cpp"
+#include </root/repo/src/function/scalar/math/setseed.cpp>
@@ -0,0 +1,11 @@
+// Unity Build generated by CMake
+#line 0 "add.cpp"
+#include </root/repo/src/function/scalar/operators/add.cpp>
+#line 0 "arithmetic.cpp"
+#include </root/repo/src/function/scalar/operators/arithmetic.cpp>
+#line 0 "bitwise.cpp"
+#include </root/repo/src/function/scalar/operators/bitwise.cpp>
+#line 0 "multiply.cpp"
+#include </root/repo/src/function/scalar/operators/multiply.cpp>
+#line 0 "subtract.cpp"
+#include </root/repo/src/function/scalar/operators/subtract.cpp>
@@ -0,0 +1,3 @@
+// Unity Build generated by CMake
+#line 0 "nextval.cpp"
+#include </root/repo/src/function/scalar/sequence/nextval.cpp>
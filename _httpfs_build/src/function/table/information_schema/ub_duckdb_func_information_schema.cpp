@@ -0,0 +1,7 @@
+// Unity Build generated by CMake
+#line 0 "information_schema_schemata.cpp"
+#include </root/repo/src/function/table/information_schema/information_schema_schemata.cpp>
+#line 0 "information_schema_tables.cpp"
+#include </root/repo/src/function/table/information_schema/information_schema_tables.cpp>
+#line 0 "information_schema_columns.cpp"
+#include </root/repo/src/function/table/information_schema/information_schema_columns.cpp>
@@ -0,0 +1,21 @@
+// Unity Build generated by CMake
+#line 0 "arrow.cpp"
+#include </root/repo/src/function/table/arrow.cpp>
+#line 0 "checkpoint.cpp"
+#include </root/repo/src/function/table/checkpoint.cpp>
+#line 0 "glob.cpp"
+#include </root/repo/src/function/table/glob.cpp>
+#line 0 "range.cpp"
+#include </root/repo/src/function/table/range.cpp>
+#line 0 "repeat.cpp"
+#include </root/repo/src/function/table/repeat.cpp>
+#line 0 "copy_csv.cpp"
+#include </root/repo/src/function/table/copy_csv.cpp>
+#line 0 "read_csv.cpp"
+#include </root/repo/src/function/table/read_csv.cpp>
+#line 0 "sqlite_functions.cpp"
+#include </root/repo/src/function/table/sqlite_functions.cpp>
+#line 0 "information_schema_functions.cpp"
+#include </root/repo/src/function/table/information_schema_functions.cpp>
+#line 0 "table_scan.cpp"
+#include </root/repo/src/function/table/table_scan.cpp>
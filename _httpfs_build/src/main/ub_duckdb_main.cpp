@@ -0,0 +1,25 @@
+// Unity Build generated by CMake
+#line 0 "appender.cpp"
+#include </root/repo/src/main/appender.cpp>
+#line 0 "client_context.cpp"
+#include </root/repo/src/main/client_context.cpp>
+#line 0 "connection.cpp"
+#include </root/repo/src/main/connection.cpp>
+#line 0 "database.cpp"
+#include </root/repo/src/main/database.cpp>
+#line 0 "materialized_query_result.cpp"
+#include </root/repo/src/main/materialized_query_result.cpp>
+#line 0 "prepared_statement.cpp"
+#include </root/repo/src/main/prepared_statement.cpp>
+#line 0 "prepared_statement_data.cpp"
+#include </root/repo/src/main/prepared_statement_data.cpp>
+#line 0 "relation.cpp"
+#include </root/repo/src/main/relation.cpp>
+#line 0 "query_profiler.cpp"
+#include </root/repo/src/main/query_profiler.cpp>
+#line 0 "query_result.cpp"
+#include </root/repo/src/main/query_result.cpp>
+#line 0 "stream_query_result.cpp"
+#include </root/repo/src/main/stream_query_result.cpp>
+#line 0 "duckdb-c.cpp"
+#include </root/repo/src/main/duckdb-c.cpp>
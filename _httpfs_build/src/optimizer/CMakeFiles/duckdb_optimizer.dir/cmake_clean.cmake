@@ -0,0 +1,9 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/duckdb_optimizer.dir/ub_duckdb_optimizer.cpp.o"
+  "CMakeFiles/duckdb_optimizer.dir/ub_duckdb_optimizer.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/duckdb_optimizer.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,5 @@
+// Unity Build generated by CMake
+#line 0 "query_graph.cpp"
+#include </root/repo/src/optimizer/join_order/query_graph.cpp>
+#line 0 "relation.cpp"
+#include </root/repo/src/optimizer/join_order/relation.cpp>
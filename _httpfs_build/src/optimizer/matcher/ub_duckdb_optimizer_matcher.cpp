@@ -0,0 +1,3 @@
+// Unity Build generated by CMake
+#line 0 "expression_matcher.cpp"
+#include </root/repo/src/optimizer/matcher/expression_matcher.cpp>
@@ -0,0 +1,11 @@
+// Unity Build generated by CMake
+#line 0 "pullup_filter.cpp"
+#include </root/repo/src/optimizer/pullup/pullup_filter.cpp>
+#line 0 "pullup_projection.cpp"
+#include </root/repo/src/optimizer/pullup/pullup_projection.cpp>
+#line 0 "pullup_from_left.cpp"
+#include </root/repo/src/optimizer/pullup/pullup_from_left.cpp>
+#line 0 "pullup_both_side.cpp"
+#include </root/repo/src/optimizer/pullup/pullup_both_side.cpp>
+#line 0 "pullup_set_operation.cpp"
+#include </root/repo/src/optimizer/pullup/pullup_set_operation.cpp>
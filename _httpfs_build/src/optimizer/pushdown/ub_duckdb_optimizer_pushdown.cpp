@@ -0,0 +1,21 @@
+// Unity Build generated by CMake
+#line 0 "pushdown_aggregate.cpp"
+#include </root/repo/src/optimizer/pushdown/pushdown_aggregate.cpp>
+#line 0 "pushdown_cross_product.cpp"
+#include </root/repo/src/optimizer/pushdown/pushdown_cross_product.cpp>
+#line 0 "pushdown_filter.cpp"
+#include </root/repo/src/optimizer/pushdown/pushdown_filter.cpp>
+#line 0 "pushdown_get.cpp"
+#include </root/repo/src/optimizer/pushdown/pushdown_get.cpp>
+#line 0 "pushdown_inner_join.cpp"
+#include </root/repo/src/optimizer/pushdown/pushdown_inner_join.cpp>
+#line 0 "pushdown_left_join.cpp"
+#include </root/repo/src/optimizer/pushdown/pushdown_left_join.cpp>
+#line 0 "pushdown_mark_join.cpp"
+#include </root/repo/src/optimizer/pushdown/pushdown_mark_join.cpp>
+#line 0 "pushdown_projection.cpp"
+#include </root/repo/src/optimizer/pushdown/pushdown_projection.cpp>
+#line 0 "pushdown_set_operation.cpp"
+#include </root/repo/src/optimizer/pushdown/pushdown_set_operation.cpp>
+#line 0 "pushdown_single_join.cpp"
+#include </root/repo/src/optimizer/pushdown/pushdown_single_join.cpp>
@@ -0,0 +1,23 @@
+// Unity Build generated by CMake
+#line 0 "arithmetic_simplification.cpp"
+#include </root/repo/src/optimizer/rule/arithmetic_simplification.cpp>
+#line 0 "case_simplification.cpp"
+#include </root/repo/src/optimizer/rule/case_simplification.cpp>
+#line 0 "comparison_simplification.cpp"
+#include </root/repo/src/optimizer/rule/comparison_simplification.cpp>
+#line 0 "conjunction_simplification.cpp"
+#include </root/repo/src/optimizer/rule/conjunction_simplification.cpp>
+#line 0 "constant_folding.cpp"
+#include </root/repo/src/optimizer/rule/constant_folding.cpp>
+#line 0 "date_part_simplification.cpp"
+#include </root/repo/src/optimizer/rule/date_part_simplification.cpp>
+#line 0 "distributivity.cpp"
+#include </root/repo/src/optimizer/rule/distributivity.cpp>
+#line 0 "empty_needle_removal.cpp"
+#include </root/repo/src/optimizer/rule/empty_needle_removal.cpp>
+#line 0 "move_constants.cpp"
+#include </root/repo/src/optimizer/rule/move_constants.cpp>
+#line 0 "like_optimizations.cpp"
+#include </root/repo/src/optimizer/rule/like_optimizations.cpp>
+#line 0 "in_clause_simplification_rule.cpp"
+#include </root/repo/src/optimizer/rule/in_clause_simplification_rule.cpp>
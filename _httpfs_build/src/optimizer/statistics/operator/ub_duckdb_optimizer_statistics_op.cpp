@@ -0,0 +1,21 @@
+// Unity Build generated by CMake
+#line 0 "propagate_aggregate.cpp"
+#include </root/repo/src/optimizer/statistics/operator/propagate_aggregate.cpp>
+#line 0 "propagate_cross_product.cpp"
+#include </root/repo/src/optimizer/statistics/operator/propagate_cross_product.cpp>
+#line 0 "propagate_filter.cpp"
+#include </root/repo/src/optimizer/statistics/operator/propagate_filter.cpp>
+#line 0 "propagate_get.cpp"
+#include </root/repo/src/optimizer/statistics/operator/propagate_get.cpp>
+#line 0 "propagate_limit.cpp"
+#include </root/repo/src/optimizer/statistics/operator/propagate_limit.cpp>
+#line 0 "propagate_join.cpp"
+#include </root/repo/src/optimizer/statistics/operator/propagate_join.cpp>
+#line 0 "propagate_order.cpp"
+#include </root/repo/src/optimizer/statistics/operator/propagate_order.cpp>
+#line 0 "propagate_projection.cpp"
+#include </root/repo/src/optimizer/statistics/operator/propagate_projection.cpp>
+#line 0 "propagate_set_operation.cpp"
+#include </root/repo/src/optimizer/statistics/operator/propagate_set_operation.cpp>
+#line 0 "propagate_window.cpp"
+#include </root/repo/src/optimizer/statistics/operator/propagate_window.cpp>
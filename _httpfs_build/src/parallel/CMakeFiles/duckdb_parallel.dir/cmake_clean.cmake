@@ -0,0 +1,9 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/duckdb_parallel.dir/ub_duckdb_parallel.cpp.o"
+  "CMakeFiles/duckdb_parallel.dir/ub_duckdb_parallel.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/duckdb_parallel.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,9 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/duckdb_constraints.dir/ub_duckdb_constraints.cpp.o"
+  "CMakeFiles/duckdb_constraints.dir/ub_duckdb_constraints.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/duckdb_constraints.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,7 @@
+// Unity Build generated by CMake
+#line 0 "check_constraint.cpp"
+#include </root/repo/src/parser/constraints/check_constraint.cpp>
+#line 0 "not_null_constraint.cpp"
+#include </root/repo/src/parser/constraints/not_null_constraint.cpp>
+#line 0 "unique_constraint.cpp"
+#include </root/repo/src/parser/constraints/unique_constraint.cpp>
@@ -0,0 +1,9 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/duckdb_expression.dir/ub_duckdb_expression.cpp.o"
+  "CMakeFiles/duckdb_expression.dir/ub_duckdb_expression.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/duckdb_expression.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,33 @@
+// Unity Build generated by CMake
+#line 0 "case_expression.cpp"
+#include </root/repo/src/parser/expression/case_expression.cpp>
+#line 0 "cast_expression.cpp"
+#include </root/repo/src/parser/expression/cast_expression.cpp>
+#line 0 "collate_expression.cpp"
+#include </root/repo/src/parser/expression/collate_expression.cpp>
+#line 0 "conjunction_expression.cpp"
+#include </root/repo/src/parser/expression/conjunction_expression.cpp>
+#line 0 "columnref_expression.cpp"
+#include </root/repo/src/parser/expression/columnref_expression.cpp>
+#line 0 "comparison_expression.cpp"
+#include </root/repo/src/parser/expression/comparison_expression.cpp>
+#line 0 "constant_expression.cpp"
+#include </root/repo/src/parser/expression/constant_expression.cpp>
+#line 0 "default_expression.cpp"
+#include </root/repo/src/parser/expression/default_expression.cpp>
+#line 0 "function_expression.cpp"
+#include </root/repo/src/parser/expression/function_expression.cpp>
+#line 0 "lambda_expression.cpp"
+#include </root/repo/src/parser/expression/lambda_expression.cpp>
+#line 0 "operator_expression.cpp"
+#include </root/repo/src/parser/expression/operator_expression.cpp>
+#line 0 "parameter_expression.cpp"
+#include </root/repo/src/parser/expression/parameter_expression.cpp>
+#line 0 "star_expression.cpp"
+#include </root/repo/src/parser/expression/star_expression.cpp>
+#line 0 "subquery_expression.cpp"
+#include </root/repo/src/parser/expression/subquery_expression.cpp>
+#line 0 "table_star_expression.cpp"
+#include </root/repo/src/parser/expression/table_star_expression.cpp>
+#line 0 "window_expression.cpp"
+#include </root/repo/src/parser/expression/window_expression.cpp>
@@ -0,0 +1,5 @@
+// Unity Build generated by CMake
+#line 0 "alter_table_info.cpp"
+#include </root/repo/src/parser/parsed_data/alter_table_info.cpp>
+#line 0 "sample_options.cpp"
+#include </root/repo/src/parser/parsed_data/sample_options.cpp>
@@ -0,0 +1,7 @@
+// Unity Build generated by CMake
+#line 0 "recursive_cte_node.cpp"
+#include </root/repo/src/parser/query_node/recursive_cte_node.cpp>
+#line 0 "select_node.cpp"
+#include </root/repo/src/parser/query_node/select_node.cpp>
+#line 0 "set_operation_node.cpp"
+#include </root/repo/src/parser/query_node/set_operation_node.cpp>
@@ -0,0 +1,39 @@
+// Unity Build generated by CMake
+#line 0 "alter_statement.cpp"
+#include </root/repo/src/parser/statement/alter_statement.cpp>
+#line 0 "call_statement.cpp"
+#include </root/repo/src/parser/statement/call_statement.cpp>
+#line 0 "copy_statement.cpp"
+#include </root/repo/src/parser/statement/copy_statement.cpp>
+#line 0 "create_statement.cpp"
+#include </root/repo/src/parser/statement/create_statement.cpp>
+#line 0 "delete_statement.cpp"
+#include </root/repo/src/parser/statement/delete_statement.cpp>
+#line 0 "drop_statement.cpp"
+#include </root/repo/src/parser/statement/drop_statement.cpp>
+#line 0 "execute_statement.cpp"
+#include </root/repo/src/parser/statement/execute_statement.cpp>
+#line 0 "explain_statement.cpp"
+#include </root/repo/src/parser/statement/explain_statement.cpp>
+#line 0 "export_statement.cpp"
+#include </root/repo/src/parser/statement/export_statement.cpp>
+#line 0 "insert_statement.cpp"
+#include </root/repo/src/parser/statement/insert_statement.cpp>
+#line 0 "pragma_statement.cpp"
+#include </root/repo/src/parser/statement/pragma_statement.cpp>
+#line 0 "prepare_statement.cpp"
+#include </root/repo/src/parser/statement/prepare_statement.cpp>
+#line 0 "relation_statement.cpp"
+#include </root/repo/src/parser/statement/relation_statement.cpp>
+#line 0 "select_statement.cpp"
+#include </root/repo/src/parser/statement/select_statement.cpp>
+#line 0 "set_statement.cpp"
+#include </root/repo/src/parser/statement/set_statement.cpp>
+#line 0 "show_statement.cpp"
+#include </root/repo/src/parser/statement/show_statement.cpp>
+#line 0 "transaction_statement.cpp"
+#include </root/repo/src/parser/statement/transaction_statement.cpp>
+#line 0 "update_statement.cpp"
+#include </root/repo/src/parser/statement/update_statement.cpp>
+#line 0 "vacuum_statement.cpp"
+#include </root/repo/src/parser/statement/vacuum_statement.cpp>
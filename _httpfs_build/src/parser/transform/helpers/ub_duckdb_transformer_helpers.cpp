@@ -0,0 +1,15 @@
+// Unity Build generated by CMake
+#line 0 "transform_alias.cpp"
+#include </root/repo/src/parser/transform/helpers/transform_alias.cpp>
+#line 0 "transform_cte.cpp"
+#include </root/repo/src/parser/transform/helpers/transform_cte.cpp>
+#line 0 "transform_groupby.cpp"
+#include </root/repo/src/parser/transform/helpers/transform_groupby.cpp>
+#line 0 "transform_orderby.cpp"
+#include </root/repo/src/parser/transform/helpers/transform_orderby.cpp>
+#line 0 "transform_sample.cpp"
+#include </root/repo/src/parser/transform/helpers/transform_sample.cpp>
+#line 0 "transform_typename.cpp"
+#include </root/repo/src/parser/transform/helpers/transform_typename.cpp>
+#line 0 "nodetype_to_string.cpp"
+#include </root/repo/src/parser/transform/helpers/nodetype_to_string.cpp>
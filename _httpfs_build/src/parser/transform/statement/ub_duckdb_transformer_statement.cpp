@@ -0,0 +1,57 @@
+// Unity Build generated by CMake
+#line 0 "transform_alter_table.cpp"
+#include </root/repo/src/parser/transform/statement/transform_alter_table.cpp>
+#line 0 "transform_call.cpp"
+#include </root/repo/src/parser/transform/statement/transform_call.cpp>
+#line 0 "transform_checkpoint.cpp"
+#include </root/repo/src/parser/transform/statement/transform_checkpoint.cpp>
+#line 0 "transform_create_function.cpp"
+#include </root/repo/src/parser/transform/statement/transform_create_function.cpp>
+#line 0 "transform_copy.cpp"
+#include </root/repo/src/parser/transform/statement/transform_copy.cpp>
+#line 0 "transform_create_table_as.cpp"
+#include </root/repo/src/parser/transform/statement/transform_create_table_as.cpp>
+#line 0 "transform_create_index.cpp"
+#include </root/repo/src/parser/transform/statement/transform_create_index.cpp>
+#line 0 "transform_create_schema.cpp"
+#include </root/repo/src/parser/transform/statement/transform_create_schema.cpp>
+#line 0 "transform_create_table.cpp"
+#include </root/repo/src/parser/transform/statement/transform_create_table.cpp>
+#line 0 "transform_create_view.cpp"
+#include </root/repo/src/parser/transform/statement/transform_create_view.cpp>
+#line 0 "transform_delete.cpp"
+#include </root/repo/src/parser/transform/statement/transform_delete.cpp>
+#line 0 "transform_explain.cpp"
+#include </root/repo/src/parser/transform/statement/transform_explain.cpp>
+#line 0 "transform_export.cpp"
+#include </root/repo/src/parser/transform/statement/transform_export.cpp>
+#line 0 "transform_drop.cpp"
+#include </root/repo/src/parser/transform/statement/transform_drop.cpp>
+#line 0 "transform_import.cpp"
+#include </root/repo/src/parser/transform/statement/transform_import.cpp>
+#line 0 "transform_insert.cpp"
+#include </root/repo/src/parser/transform/statement/transform_insert.cpp>
+#line 0 "transform_pragma.cpp"
+#include </root/repo/src/parser/transform/statement/transform_pragma.cpp>
+#line 0 "transform_rename.cpp"
+#include </root/repo/src/parser/transform/statement/transform_rename.cpp>
+#line 0 "transform_select.cpp"
+#include </root/repo/src/parser/transform/statement/transform_select.cpp>
+#line 0 "transform_select_node.cpp"
+#include </root/repo/src/parser/transform/statement/transform_select_node.cpp>
+#line 0 "transform_set.cpp"
+#include </root/repo/src/parser/transform/statement/transform_set.cpp>
+#line 0 "transform_prepare.cpp"
+#include </root/repo/src/parser/transform/statement/transform_prepare.cpp>
+#line 0 "transform_show.cpp"
+#include </root/repo/src/parser/transform/statement/transform_show.cpp>
+#line 0 "transform_show_select.cpp"
+#include </root/repo/src/parser/transform/statement/transform_show_select.cpp>
+#line 0 "transform_transaction.cpp"
+#include </root/repo/src/parser/transform/statement/transform_transaction.cpp>
+#line 0 "transform_update.cpp"
+#include </root/repo/src/parser/transform/statement/transform_update.cpp>
+#line 0 "transform_create_sequence.cpp"
+#include </root/repo/src/parser/transform/statement/transform_create_sequence.cpp>
+#line 0 "transform_vacuum.cpp"
+#include </root/repo/src/parser/transform/statement/transform_vacuum.cpp>
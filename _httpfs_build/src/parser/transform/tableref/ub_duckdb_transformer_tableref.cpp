@@ -0,0 +1,13 @@
+// Unity Build generated by CMake
+#line 0 "transform_base_tableref.cpp"
+#include </root/repo/src/parser/transform/tableref/transform_base_tableref.cpp>
+#line 0 "transform_join.cpp"
+#include </root/repo/src/parser/transform/tableref/transform_join.cpp>
+#line 0 "transform_from.cpp"
+#include </root/repo/src/parser/transform/tableref/transform_from.cpp>
+#line 0 "transform_subquery.cpp"
+#include </root/repo/src/parser/transform/tableref/transform_subquery.cpp>
+#line 0 "transform_table_function.cpp"
+#include </root/repo/src/parser/transform/tableref/transform_table_function.cpp>
+#line 0 "transform_tableref.cpp"
+#include </root/repo/src/parser/transform/tableref/transform_tableref.cpp>
@@ -0,0 +1,33 @@
+// Unity Build generated by CMake
+#line 0 "bind_aggregate_expression.cpp"
+#include </root/repo/src/planner/binder/expression/bind_aggregate_expression.cpp>
+#line 0 "bind_case_expression.cpp"
+#include </root/repo/src/planner/binder/expression/bind_case_expression.cpp>
+#line 0 "bind_cast_expression.cpp"
+#include </root/repo/src/planner/binder/expression/bind_cast_expression.cpp>
+#line 0 "bind_collate_expression.cpp"
+#include </root/repo/src/planner/binder/expression/bind_collate_expression.cpp>
+#line 0 "bind_columnref_expression.cpp"
+#include </root/repo/src/planner/binder/expression/bind_columnref_expression.cpp>
+#line 0 "bind_comparison_expression.cpp"
+#include </root/repo/src/planner/binder/expression/bind_comparison_expression.cpp>
+#line 0 "bind_conjunction_expression.cpp"
+#include </root/repo/src/planner/binder/expression/bind_conjunction_expression.cpp>
+#line 0 "bind_constant_expression.cpp"
+#include </root/repo/src/planner/binder/expression/bind_constant_expression.cpp>
+#line 0 "bind_function_expression.cpp"
+#include </root/repo/src/planner/binder/expression/bind_function_expression.cpp>
+#line 0 "bind_lambda.cpp"
+#include </root/repo/src/planner/binder/expression/bind_lambda.cpp>
+#line 0 "bind_macro_expression.cpp"
+#include </root/repo/src/planner/binder/expression/bind_macro_expression.cpp>
+#line 0 "bind_operator_expression.cpp"
+#include </root/repo/src/planner/binder/expression/bind_operator_expression.cpp>
+#line 0 "bind_parameter_expression.cpp"
+#include </root/repo/src/planner/binder/expression/bind_parameter_expression.cpp>
+#line 0 "bind_subquery_expression.cpp"
+#include </root/repo/src/planner/binder/expression/bind_subquery_expression.cpp>
+#line 0 "bind_unnest_expression.cpp"
+#include </root/repo/src/planner/binder/expression/bind_unnest_expression.cpp>
+#line 0 "bind_window_expression.cpp"
+#include </root/repo/src/planner/binder/expression/bind_window_expression.cpp>
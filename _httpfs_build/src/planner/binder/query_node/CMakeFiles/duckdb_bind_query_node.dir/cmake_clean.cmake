@@ -0,0 +1,9 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/duckdb_bind_query_node.dir/ub_duckdb_bind_query_node.cpp.o"
+  "CMakeFiles/duckdb_bind_query_node.dir/ub_duckdb_bind_query_node.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/duckdb_bind_query_node.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
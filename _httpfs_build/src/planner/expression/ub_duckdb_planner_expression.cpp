@@ -0,0 +1,31 @@
+// Unity Build generated by CMake
+#line 0 "bound_aggregate_expression.cpp"
+#include </root/repo/src/planner/expression/bound_aggregate_expression.cpp>
+#line 0 "bound_between_expression.cpp"
+#include </root/repo/src/planner/expression/bound_between_expression.cpp>
+#line 0 "bound_case_expression.cpp"
+#include </root/repo/src/planner/expression/bound_case_expression.cpp>
+#line 0 "bound_cast_expression.cpp"
+#include </root/repo/src/planner/expression/bound_cast_expression.cpp>
+#line 0 "bound_columnref_expression.cpp"
+#include </root/repo/src/planner/expression/bound_columnref_expression.cpp>
+#line 0 "bound_comparison_expression.cpp"
+#include </root/repo/src/planner/expression/bound_comparison_expression.cpp>
+#line 0 "bound_conjunction_expression.cpp"
+#include </root/repo/src/planner/expression/bound_conjunction_expression.cpp>
+#line 0 "bound_constant_expression.cpp"
+#include </root/repo/src/planner/expression/bound_constant_expression.cpp>
+#line 0 "bound_function_expression.cpp"
+#include </root/repo/src/planner/expression/bound_function_expression.cpp>
+#line 0 "bound_operator_expression.cpp"
+#include </root/repo/src/planner/expression/bound_operator_expression.cpp>
+#line 0 "bound_parameter_expression.cpp"
+#include </root/repo/src/planner/expression/bound_parameter_expression.cpp>
+#line 0 "bound_reference_expression.cpp"
+#include </root/repo/src/planner/expression/bound_reference_expression.cpp>
+#line 0 "bound_subquery_expression.cpp"
+#include </root/repo/src/planner/expression/bound_subquery_expression.cpp>
+#line 0 "bound_unnest_expression.cpp"
+#include </root/repo/src/planner/expression/bound_unnest_expression.cpp>
+#line 0 "bound_window_expression.cpp"
+#include </root/repo/src/planner/expression/bound_window_expression.cpp>
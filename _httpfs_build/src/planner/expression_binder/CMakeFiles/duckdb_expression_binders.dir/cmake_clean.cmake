@@ -0,0 +1,9 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/duckdb_expression_binders.dir/ub_duckdb_expression_binders.cpp.o"
+  "CMakeFiles/duckdb_expression_binders.dir/ub_duckdb_expression_binders.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/duckdb_expression_binders.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,27 @@
+// Unity Build generated by CMake
+#line 0 "aggregate_binder.cpp"
+#include </root/repo/src/planner/expression_binder/aggregate_binder.cpp>
+#line 0 "alter_binder.cpp"
+#include </root/repo/src/planner/expression_binder/alter_binder.cpp>
+#line 0 "check_binder.cpp"
+#include </root/repo/src/planner/expression_binder/check_binder.cpp>
+#line 0 "constant_binder.cpp"
+#include </root/repo/src/planner/expression_binder/constant_binder.cpp>
+#line 0 "group_binder.cpp"
+#include </root/repo/src/planner/expression_binder/group_binder.cpp>
+#line 0 "having_binder.cpp"
+#include </root/repo/src/planner/expression_binder/having_binder.cpp>
+#line 0 "index_binder.cpp"
+#include </root/repo/src/planner/expression_binder/index_binder.cpp>
+#line 0 "insert_binder.cpp"
+#include </root/repo/src/planner/expression_binder/insert_binder.cpp>
+#line 0 "order_binder.cpp"
+#include </root/repo/src/planner/expression_binder/order_binder.cpp>
+#line 0 "relation_binder.cpp"
+#include </root/repo/src/planner/expression_binder/relation_binder.cpp>
+#line 0 "select_binder.cpp"
+#include </root/repo/src/planner/expression_binder/select_binder.cpp>
+#line 0 "update_binder.cpp"
+#include </root/repo/src/planner/expression_binder/update_binder.cpp>
+#line 0 "where_binder.cpp"
+#include </root/repo/src/planner/expression_binder/where_binder.cpp>
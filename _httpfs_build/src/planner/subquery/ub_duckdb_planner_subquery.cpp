@@ -0,0 +1,7 @@
+// Unity Build generated by CMake
+#line 0 "flatten_dependent_join.cpp"
+#include </root/repo/src/planner/subquery/flatten_dependent_join.cpp>
+#line 0 "has_correlated_expressions.cpp"
+#include </root/repo/src/planner/subquery/has_correlated_expressions.cpp>
+#line 0 "rewrite_correlated_expressions.cpp"
+#include </root/repo/src/planner/subquery/rewrite_correlated_expressions.cpp>
@@ -0,0 +1,9 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/duckdb_storage.dir/ub_duckdb_storage.cpp.o"
+  "CMakeFiles/duckdb_storage.dir/ub_duckdb_storage.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/duckdb_storage.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
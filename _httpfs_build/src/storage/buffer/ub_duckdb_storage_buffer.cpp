@@ -0,0 +1,7 @@
+// Unity Build generated by CMake
+#line 0 "buffer_handle.cpp"
+#include </root/repo/src/storage/buffer/buffer_handle.cpp>
+#line 0 "buffer_list.cpp"
+#include </root/repo/src/storage/buffer/buffer_list.cpp>
+#line 0 "managed_buffer.cpp"
+#include </root/repo/src/storage/buffer/managed_buffer.cpp>
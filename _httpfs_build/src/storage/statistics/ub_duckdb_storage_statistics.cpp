@@ -0,0 +1,9 @@
+// Unity Build generated by CMake
+#line 0 "base_statistics.cpp"
+#include </root/repo/src/storage/statistics/base_statistics.cpp>
+#line 0 "numeric_statistics.cpp"
+#include </root/repo/src/storage/statistics/numeric_statistics.cpp>
+#line 0 "segment_statistics.cpp"
+#include </root/repo/src/storage/statistics/segment_statistics.cpp>
+#line 0 "string_statistics.cpp"
+#include </root/repo/src/storage/statistics/string_statistics.cpp>
@@ -0,0 +1,15 @@
+// Unity Build generated by CMake
+#line 0 "chunk_info.cpp"
+#include </root/repo/src/storage/table/chunk_info.cpp>
+#line 0 "column_segment.cpp"
+#include </root/repo/src/storage/table/column_segment.cpp>
+#line 0 "morsel_info.cpp"
+#include </root/repo/src/storage/table/morsel_info.cpp>
+#line 0 "persistent_table_data.cpp"
+#include </root/repo/src/storage/table/persistent_table_data.cpp>
+#line 0 "segment_tree.cpp"
+#include </root/repo/src/storage/table/segment_tree.cpp>
+#line 0 "persistent_segment.cpp"
+#include </root/repo/src/storage/table/persistent_segment.cpp>
+#line 0 "transient_segment.cpp"
+#include </root/repo/src/storage/table/transient_segment.cpp>
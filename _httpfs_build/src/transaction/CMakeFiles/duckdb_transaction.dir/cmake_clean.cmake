@@ -0,0 +1,9 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/duckdb_transaction.dir/ub_duckdb_transaction.cpp.o"
+  "CMakeFiles/duckdb_transaction.dir/ub_duckdb_transaction.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/duckdb_transaction.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,30 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/test/unittest.cpp" "test/CMakeFiles/unittest.dir/unittest.cpp.o" "gcc" "test/CMakeFiles/unittest.dir/unittest.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_httpfs_build/third_party/dsdgen/CMakeFiles/dsdgen.dir/DependInfo.cmake"
+  "/root/repo/_httpfs_build/test/helpers/CMakeFiles/test_helpers.dir/DependInfo.cmake"
+  "/root/repo/_httpfs_build/extension/parquet/CMakeFiles/parquet_extension.dir/DependInfo.cmake"
+  "/root/repo/_httpfs_build/extension/httpfs/CMakeFiles/httpfs_extension.dir/DependInfo.cmake"
+  "/root/repo/_httpfs_build/src/CMakeFiles/duckdb.dir/DependInfo.cmake"
+  "/root/repo/_httpfs_build/third_party/fmt/CMakeFiles/fmt.dir/DependInfo.cmake"
+  "/root/repo/_httpfs_build/third_party/libpg_query/CMakeFiles/pg_query.dir/DependInfo.cmake"
+  "/root/repo/_httpfs_build/third_party/re2/CMakeFiles/duckdb_re2.dir/DependInfo.cmake"
+  "/root/repo/_httpfs_build/third_party/miniz/CMakeFiles/miniz.dir/DependInfo.cmake"
+  "/root/repo/_httpfs_build/third_party/utf8proc/CMakeFiles/utf8proc.dir/DependInfo.cmake"
+  "/root/repo/_httpfs_build/third_party/hyperloglog/CMakeFiles/hyperloglog.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/unittest.dir/unittest.cpp.o"
+  "CMakeFiles/unittest.dir/unittest.cpp.o.d"
+  "unittest"
+  "unittest.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/unittest.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,9 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_sql_capi.dir/ub_test_sql_capi.cpp.o"
+  "CMakeFiles/test_sql_capi.dir/ub_test_sql_capi.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_sql_capi.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,9 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_appender.dir/ub_test_appender.cpp.o"
+  "CMakeFiles/test_appender.dir/ub_test_appender.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_appender.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,7 @@
+// Unity Build generated by CMake
+#line 0 "test_appender_abort.cpp"
+#include </root/repo/test/appender/test_appender_abort.cpp>
+#line 0 "test_appender.cpp"
+#include </root/repo/test/appender/test_appender.cpp>
+#line 0 "test_concurrent_append.cpp"
+#include </root/repo/test/appender/test_concurrent_append.cpp>
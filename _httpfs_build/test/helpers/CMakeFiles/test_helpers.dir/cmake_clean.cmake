@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_helpers.dir/test_helpers.cpp.o"
+  "CMakeFiles/test_helpers.dir/test_helpers.cpp.o.d"
+  "libtest_helpers.a"
+  "libtest_helpers.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_helpers.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
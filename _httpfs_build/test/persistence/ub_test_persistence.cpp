@@ -0,0 +1,7 @@
+// Unity Build generated by CMake
+#line 0 "test_persistence.cpp"
+#include </root/repo/test/persistence/test_persistence.cpp>
+#line 0 "test_locking.cpp"
+#include </root/repo/test/persistence/test_locking.cpp>
+#line 0 "test_sequence_crash.cpp"
+#include </root/repo/test/persistence/test_sequence_crash.cpp>
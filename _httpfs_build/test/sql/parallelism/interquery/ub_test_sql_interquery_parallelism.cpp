@@ -0,0 +1,15 @@
+// Unity Build generated by CMake
+#line 0 "concurrent_checkpoint.cpp"
+#include </root/repo/test/sql/parallelism/interquery/concurrent_checkpoint.cpp>
+#line 0 "test_concurrentappend.cpp"
+#include </root/repo/test/sql/parallelism/interquery/test_concurrentappend.cpp>
+#line 0 "test_concurrentdelete.cpp"
+#include </root/repo/test/sql/parallelism/interquery/test_concurrentdelete.cpp>
+#line 0 "test_concurrent_dependencies.cpp"
+#include </root/repo/test/sql/parallelism/interquery/test_concurrent_dependencies.cpp>
+#line 0 "test_concurrent_index.cpp"
+#include </root/repo/test/sql/parallelism/interquery/test_concurrent_index.cpp>
+#line 0 "test_concurrentupdate.cpp"
+#include </root/repo/test/sql/parallelism/interquery/test_concurrentupdate.cpp>
+#line 0 "test_concurrent_sequence.cpp"
+#include </root/repo/test/sql/parallelism/interquery/test_concurrent_sequence.cpp>
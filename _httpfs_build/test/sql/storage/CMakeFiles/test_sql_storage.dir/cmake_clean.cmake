@@ -0,0 +1,9 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_sql_storage.dir/ub_test_sql_storage.cpp.o"
+  "CMakeFiles/test_sql_storage.dir/ub_test_sql_storage.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_sql_storage.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
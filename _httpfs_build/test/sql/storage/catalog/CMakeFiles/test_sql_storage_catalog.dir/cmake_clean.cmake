@@ -0,0 +1,9 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_sql_storage_catalog.dir/ub_test_sql_storage_catalog.cpp.o"
+  "CMakeFiles/test_sql_storage_catalog.dir/ub_test_sql_storage_catalog.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_sql_storage_catalog.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
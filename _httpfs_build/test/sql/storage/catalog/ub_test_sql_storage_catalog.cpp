@@ -0,0 +1,3 @@
+// Unity Build generated by CMake
+#line 0 "test_storage_sequences.cpp"
+#include </root/repo/test/sql/storage/catalog/test_storage_sequences.cpp>
@@ -0,0 +1,19 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/_httpfs_build/test/sql/tpcds/ub_test_sql_tpcds.cpp" "test/sql/tpcds/CMakeFiles/test_sql_tpcds.dir/ub_test_sql_tpcds.cpp.o" "gcc" "test/sql/tpcds/CMakeFiles/test_sql_tpcds.dir/ub_test_sql_tpcds.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,9 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_sql_tpcds.dir/ub_test_sql_tpcds.cpp.o"
+  "CMakeFiles/test_sql_tpcds.dir/ub_test_sql_tpcds.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_sql_tpcds.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
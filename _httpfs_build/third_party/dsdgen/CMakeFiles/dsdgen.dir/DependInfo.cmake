@@ -0,0 +1,21 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/third_party/dsdgen/append_info-c.cpp" "third_party/dsdgen/CMakeFiles/dsdgen.dir/append_info-c.cpp.o" "gcc" "third_party/dsdgen/CMakeFiles/dsdgen.dir/append_info-c.cpp.o.d"
+  "/root/repo/third_party/dsdgen/dsdgen.cpp" "third_party/dsdgen/CMakeFiles/dsdgen.dir/dsdgen.cpp.o" "gcc" "third_party/dsdgen/CMakeFiles/dsdgen.dir/dsdgen.cpp.o.d"
+  "/root/repo/third_party/dsdgen/dsdgen_helpers.cpp" "third_party/dsdgen/CMakeFiles/dsdgen.dir/dsdgen_helpers.cpp.o" "gcc" "third_party/dsdgen/CMakeFiles/dsdgen.dir/dsdgen_helpers.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/imdb.dir/imdb.cpp.o"
+  "CMakeFiles/imdb.dir/imdb.cpp.o.d"
+  "libimdb.a"
+  "libimdb.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/imdb.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
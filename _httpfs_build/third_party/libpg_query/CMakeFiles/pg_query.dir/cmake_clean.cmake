@@ -0,0 +1,29 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/pg_query.dir/pg_functions.cpp.o"
+  "CMakeFiles/pg_query.dir/pg_functions.cpp.o.d"
+  "CMakeFiles/pg_query.dir/postgres_parser.cpp.o"
+  "CMakeFiles/pg_query.dir/postgres_parser.cpp.o.d"
+  "CMakeFiles/pg_query.dir/src_backend_nodes_list.cpp.o"
+  "CMakeFiles/pg_query.dir/src_backend_nodes_list.cpp.o.d"
+  "CMakeFiles/pg_query.dir/src_backend_nodes_makefuncs.cpp.o"
+  "CMakeFiles/pg_query.dir/src_backend_nodes_makefuncs.cpp.o.d"
+  "CMakeFiles/pg_query.dir/src_backend_nodes_value.cpp.o"
+  "CMakeFiles/pg_query.dir/src_backend_nodes_value.cpp.o.d"
+  "CMakeFiles/pg_query.dir/src_backend_parser_gram.cpp.o"
+  "CMakeFiles/pg_query.dir/src_backend_parser_gram.cpp.o.d"
+  "CMakeFiles/pg_query.dir/src_backend_parser_parser.cpp.o"
+  "CMakeFiles/pg_query.dir/src_backend_parser_parser.cpp.o.d"
+  "CMakeFiles/pg_query.dir/src_backend_parser_scan.cpp.o"
+  "CMakeFiles/pg_query.dir/src_backend_parser_scan.cpp.o.d"
+  "CMakeFiles/pg_query.dir/src_backend_parser_scansup.cpp.o"
+  "CMakeFiles/pg_query.dir/src_backend_parser_scansup.cpp.o.d"
+  "CMakeFiles/pg_query.dir/src_common_keywords.cpp.o"
+  "CMakeFiles/pg_query.dir/src_common_keywords.cpp.o.d"
+  "libpg_query.a"
+  "libpg_query.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/pg_query.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
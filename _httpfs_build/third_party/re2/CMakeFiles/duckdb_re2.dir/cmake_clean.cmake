@@ -0,0 +1,53 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/duckdb_re2.dir/re2/bitstate.cc.o"
+  "CMakeFiles/duckdb_re2.dir/re2/bitstate.cc.o.d"
+  "CMakeFiles/duckdb_re2.dir/re2/compile.cc.o"
+  "CMakeFiles/duckdb_re2.dir/re2/compile.cc.o.d"
+  "CMakeFiles/duckdb_re2.dir/re2/dfa.cc.o"
+  "CMakeFiles/duckdb_re2.dir/re2/dfa.cc.o.d"
+  "CMakeFiles/duckdb_re2.dir/re2/filtered_re2.cc.o"
+  "CMakeFiles/duckdb_re2.dir/re2/filtered_re2.cc.o.d"
+  "CMakeFiles/duckdb_re2.dir/re2/mimics_pcre.cc.o"
+  "CMakeFiles/duckdb_re2.dir/re2/mimics_pcre.cc.o.d"
+  "CMakeFiles/duckdb_re2.dir/re2/nfa.cc.o"
+  "CMakeFiles/duckdb_re2.dir/re2/nfa.cc.o.d"
+  "CMakeFiles/duckdb_re2.dir/re2/onepass.cc.o"
+  "CMakeFiles/duckdb_re2.dir/re2/onepass.cc.o.d"
+  "CMakeFiles/duckdb_re2.dir/re2/parse.cc.o"
+  "CMakeFiles/duckdb_re2.dir/re2/parse.cc.o.d"
+  "CMakeFiles/duckdb_re2.dir/re2/perl_groups.cc.o"
+  "CMakeFiles/duckdb_re2.dir/re2/perl_groups.cc.o.d"
+  "CMakeFiles/duckdb_re2.dir/re2/prefilter.cc.o"
+  "CMakeFiles/duckdb_re2.dir/re2/prefilter.cc.o.d"
+  "CMakeFiles/duckdb_re2.dir/re2/prefilter_tree.cc.o"
+  "CMakeFiles/duckdb_re2.dir/re2/prefilter_tree.cc.o.d"
+  "CMakeFiles/duckdb_re2.dir/re2/prog.cc.o"
+  "CMakeFiles/duckdb_re2.dir/re2/prog.cc.o.d"
+  "CMakeFiles/duckdb_re2.dir/re2/re2.cc.o"
+  "CMakeFiles/duckdb_re2.dir/re2/re2.cc.o.d"
+  "CMakeFiles/duckdb_re2.dir/re2/regexp.cc.o"
+  "CMakeFiles/duckdb_re2.dir/re2/regexp.cc.o.d"
+  "CMakeFiles/duckdb_re2.dir/re2/set.cc.o"
+  "CMakeFiles/duckdb_re2.dir/re2/set.cc.o.d"
+  "CMakeFiles/duckdb_re2.dir/re2/simplify.cc.o"
+  "CMakeFiles/duckdb_re2.dir/re2/simplify.cc.o.d"
+  "CMakeFiles/duckdb_re2.dir/re2/stringpiece.cc.o"
+  "CMakeFiles/duckdb_re2.dir/re2/stringpiece.cc.o.d"
+  "CMakeFiles/duckdb_re2.dir/re2/tostring.cc.o"
+  "CMakeFiles/duckdb_re2.dir/re2/tostring.cc.o.d"
+  "CMakeFiles/duckdb_re2.dir/re2/unicode_casefold.cc.o"
+  "CMakeFiles/duckdb_re2.dir/re2/unicode_casefold.cc.o.d"
+  "CMakeFiles/duckdb_re2.dir/re2/unicode_groups.cc.o"
+  "CMakeFiles/duckdb_re2.dir/re2/unicode_groups.cc.o.d"
+  "CMakeFiles/duckdb_re2.dir/util/rune.cc.o"
+  "CMakeFiles/duckdb_re2.dir/util/rune.cc.o.d"
+  "CMakeFiles/duckdb_re2.dir/util/strutil.cc.o"
+  "CMakeFiles/duckdb_re2.dir/util/strutil.cc.o.d"
+  "libduckdb_re2.a"
+  "libduckdb_re2.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/duckdb_re2.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
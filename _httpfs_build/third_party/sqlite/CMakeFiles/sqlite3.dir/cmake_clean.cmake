@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/sqlite3.dir/sqlite3.c.o"
+  "CMakeFiles/sqlite3.dir/sqlite3.c.o.d"
+  "libsqlite3.a"
+  "libsqlite3.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/sqlite3.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/utf8proc.dir/utf8proc.cpp.o"
+  "CMakeFiles/utf8proc.dir/utf8proc.cpp.o.d"
+  "CMakeFiles/utf8proc.dir/utf8proc_wrapper.cpp.o"
+  "CMakeFiles/utf8proc.dir/utf8proc_wrapper.cpp.o.d"
+  "libutf8proc.a"
+  "libutf8proc.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/utf8proc.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "../../duckdb"
+  "../../duckdb.pdb"
+  "CMakeFiles/shell.dir/linenoise.cpp.o"
+  "CMakeFiles/shell.dir/linenoise.cpp.o.d"
+  "CMakeFiles/shell.dir/shell.c.o"
+  "CMakeFiles/shell.dir/shell.c.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C CXX)
+  include(CMakeFiles/shell.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/sqlite3_api_wrapper_static.dir/sqlite3_api_wrapper.cpp.o"
+  "CMakeFiles/sqlite3_api_wrapper_static.dir/sqlite3_api_wrapper.cpp.o.d"
+  "libsqlite3_api_wrapper_static.a"
+  "libsqlite3_api_wrapper_static.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C CXX)
+  include(CMakeFiles/sqlite3_api_wrapper_static.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/sqlite3_api_wrapper_sqlite3.dir/printf.c.o"
+  "CMakeFiles/sqlite3_api_wrapper_sqlite3.dir/printf.c.o.d"
+  "CMakeFiles/sqlite3_api_wrapper_sqlite3.dir/strglob.c.o"
+  "CMakeFiles/sqlite3_api_wrapper_sqlite3.dir/strglob.c.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/sqlite3_api_wrapper_sqlite3.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,89 @@
+#include "benchmark_runner.hpp"
+#include "duckdb_benchmark_macro.hpp"
+
+#include <random>
+#include <thread>
+
+using namespace duckdb;
+
+#define CONCURRENT_INDEX_THREADS 4
+#define CONCURRENT_INDEX_ROWS 1000000
+#define CONCURRENT_INDEX_LOOKUPS 20000
+#define CONCURRENT_INDEX_INSERTS 1000
+
+static void ConcurrentIndexLookups(DuckDB *db, idx_t thread_nr) {
+	Connection con(*db);
+	auto prepared = con.Prepare("SELECT i FROM integers WHERE i=$1");
+	std::uniform_int_distribution<> distribution(0, CONCURRENT_INDEX_ROWS - 1);
+	std::mt19937 gen;
+	gen.seed(thread_nr);
+	for (idx_t i = 0; i < CONCURRENT_INDEX_LOOKUPS; i++) {
+		prepared->Execute(distribution(gen));
+	}
+}
+
+static void ConcurrentIndexInserts(DuckDB *db, idx_t thread_nr) {
+	Connection con(*db);
+	auto prepared = con.Prepare("INSERT INTO integers VALUES ($1)");
+	for (idx_t i = 0; i < CONCURRENT_INDEX_INSERTS; i++) {
+		prepared->Execute((int32_t)(CONCURRENT_INDEX_ROWS + thread_nr * CONCURRENT_INDEX_INSERTS + i));
+	}
+}
+
+//////////////////////////////
+// CONCURRENT POINT LOOKUPS //
+//////////////////////////////
+DUCKDB_BENCHMARK(ConcurrentIndexPointLookups, "[index]")
+void Load(DuckDBBenchmarkState *state) override {
+	state->conn.Query("CREATE TABLE integers(i INTEGER PRIMARY KEY)");
+	state->conn.Query("INSERT INTO integers SELECT * FROM range(0, " + to_string(CONCURRENT_INDEX_ROWS) + ")");
+}
+void RunBenchmark(DuckDBBenchmarkState *state) override {
+	std::thread threads[CONCURRENT_INDEX_THREADS];
+	for (idx_t i = 0; i < CONCURRENT_INDEX_THREADS; i++) {
+		threads[i] = std::thread(ConcurrentIndexLookups, &state->db, i);
+	}
+	for (idx_t i = 0; i < CONCURRENT_INDEX_THREADS; i++) {
+		threads[i].join();
+	}
+}
+string VerifyResult(QueryResult *result) override {
+	return string();
+}
+string BenchmarkInfo() override {
+	return "Point lookups on a PRIMARY KEY column from multiple connections";
+}
+FINISH_BENCHMARK(ConcurrentIndexPointLookups)
+
+//////////////////////////////////////////
+// CONCURRENT POINT LOOKUPS AND INSERTS //
+//////////////////////////////////////////
+DUCKDB_BENCHMARK(ConcurrentIndexPointLookupsInserts, "[index]")
+void Load(DuckDBBenchmarkState *state) override {
+	state->conn.Query("CREATE TABLE integers(i INTEGER PRIMARY KEY)");
+	state->conn.Query("INSERT INTO integers SELECT * FROM range(0, " + to_string(CONCURRENT_INDEX_ROWS) + ")");
+}
+void RunBenchmark(DuckDBBenchmarkState *state) override {
+	// half of the connections look up keys, the other half inserts new keys
+	std::thread threads[CONCURRENT_INDEX_THREADS];
+	for (idx_t i = 0; i < CONCURRENT_INDEX_THREADS; i++) {
+		if (i % 2 == 0) {
+			threads[i] = std::thread(ConcurrentIndexLookups, &state->db, i);
+		} else {
+			threads[i] = std::thread(ConcurrentIndexInserts, &state->db, i / 2);
+		}
+	}
+	for (idx_t i = 0; i < CONCURRENT_INDEX_THREADS; i++) {
+		threads[i].join();
+	}
+}
+void Cleanup(DuckDBBenchmarkState *state) override {
+	state->conn.Query("DELETE FROM integers WHERE i >= " + to_string(CONCURRENT_INDEX_ROWS));
+}
+string VerifyResult(QueryResult *result) override {
+	return string();
+}
+string BenchmarkInfo() override {
+	return "Point lookups on a PRIMARY KEY column while other connections insert into it";
+}
+FINISH_BENCHMARK(ConcurrentIndexPointLookupsInserts)
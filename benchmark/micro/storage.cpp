@@ -1,6 +1,7 @@
 #include "benchmark_runner.hpp"
 #include "duckdb_benchmark_macro.hpp"
 #include "duckdb/main/appender.hpp"
+#include "duckdb/storage/buffer_manager.hpp"
 
 using namespace duckdb;
 
@@ -38,3 +39,48 @@ string BenchmarkInfo() override {
 	return "Run the query \"SELECT 1\" 50K times in in-memory mode";
 }
 FINISH_BENCHMARK(SELECT1Disk)
+
+#define COLD_SCAN_BENCHMARK(THREADS)                                                                                   \
+	void Load(DuckDBBenchmarkState *state) override {                                                                  \
+		state->conn.Query("PRAGMA threads=" #THREADS);                                                                 \
+		state->conn.Query("CREATE TABLE integers AS SELECT i, i % 1000 AS j FROM range(0, 50000000) tbl(i)");         \
+		state->conn.Query("CHECKPOINT");                                                                               \
+	}                                                                                                                  \
+	string GetQuery() override {                                                                                       \
+		return "SELECT SUM(i), SUM(j) FROM integers";                                                                  \
+	}                                                                                                                  \
+	void Cleanup(DuckDBBenchmarkState *state) override {                                                               \
+		/* evict all blocks from the buffer pool, so the next run has to read them from the database file again */     \
+		auto &buffer_manager = BufferManager::GetBufferManager(*state->db.instance);                                   \
+		auto memory_limit = buffer_manager.GetMaxMemory();                                                             \
+		state->conn.Query("PRAGMA memory_limit='1MB'");                                                                \
+		buffer_manager.SetLimit(memory_limit);                                                                         \
+	}                                                                                                                  \
+	string VerifyResult(QueryResult *result) override {                                                                \
+		if (!result->success) {                                                                                        \
+			return result->error;                                                                                      \
+		}                                                                                                              \
+		return string();                                                                                               \
+	}                                                                                                                  \
+	bool InMemory() override {                                                                                         \
+		return false;                                                                                                  \
+	}                                                                                                                  \
+	string BenchmarkInfo() override {                                                                                  \
+		return "Scan 50M rows from a database file that are not in the buffer pool using " #THREADS " threads";       \
+	}
+
+DUCKDB_BENCHMARK(ColdScan1Thread, "[storage]")
+COLD_SCAN_BENCHMARK(1)
+FINISH_BENCHMARK(ColdScan1Thread)
+
+DUCKDB_BENCHMARK(ColdScan2Threads, "[storage]")
+COLD_SCAN_BENCHMARK(2)
+FINISH_BENCHMARK(ColdScan2Threads)
+
+DUCKDB_BENCHMARK(ColdScan4Threads, "[storage]")
+COLD_SCAN_BENCHMARK(4)
+FINISH_BENCHMARK(ColdScan4Threads)
+
+DUCKDB_BENCHMARK(ColdScan8Threads, "[storage]")
+COLD_SCAN_BENCHMARK(8)
+FINISH_BENCHMARK(ColdScan8Threads)
@@ -0,0 +1,252 @@
+#include "http_block_cache.hpp"
+
+#include "duckdb/common/string_util.hpp"
+#include "duckdb/storage/buffer_manager.hpp"
+
+#include <algorithm>
+
+namespace duckdb {
+
+HTTPBlockCache::HTTPBlockCache(DatabaseInstance &db) : configured_version(INVALID_INDEX), db(db) {
+}
+
+HTTPBlockCache::~HTTPBlockCache() {
+}
+
+void HTTPBlockCache::Configure(idx_t memory_limit_p, string directory_p, idx_t disk_limit_p) {
+	lock_guard<mutex> guard(lock);
+	memory_limit = memory_limit_p;
+	disk_limit = disk_limit_p;
+	if (directory != directory_p) {
+		directory = move(directory_p);
+		disk_lru.clear();
+		disk_map.clear();
+		disk_usage = 0;
+		if (!directory.empty()) {
+			if (!fs.DirectoryExists(directory)) {
+				fs.CreateDirectory(directory);
+			} else {
+				ScanDirectory();
+			}
+		}
+	}
+	EvictMemory();
+	EvictDisk();
+}
+
+idx_t HTTPBlockCache::GetMemoryLimit() {
+	lock_guard<mutex> guard(lock);
+	return memory_limit;
+}
+
+shared_ptr<HTTPCacheBlock> HTTPBlockCache::Allocate(idx_t size) {
+	auto &buffer_manager = BufferManager::GetBufferManager(db);
+	auto alloc_size = MaxValue<idx_t>(size + Storage::BLOCK_HEADER_SIZE, Storage::BLOCK_ALLOC_SIZE);
+	// the cache outlives the query that fills it, so its blocks are not charged to the memory budget of the query
+	auto budget = BufferManager::SetThreadMemoryBudget(nullptr);
+	shared_ptr<BlockHandle> handle;
+	try {
+		handle = buffer_manager.RegisterMemory(alloc_size, true);
+	} catch (...) {
+		BufferManager::SetThreadMemoryBudget(move(budget));
+		throw;
+	}
+	BufferManager::SetThreadMemoryBudget(move(budget));
+	return make_shared<HTTPCacheBlock>(buffer_manager.Pin(handle), size);
+}
+
+shared_ptr<HTTPCacheBlock> HTTPBlockCache::Get(const string &key) {
+	auto file_name = DiskFileName(key);
+	string path;
+	{
+		lock_guard<mutex> guard(lock);
+		auto entry = memory_map.find(key);
+		if (entry != memory_map.end()) {
+			auto &memory_entry = *entry->second;
+			auto pin = BufferManager::GetBufferManager(db).Pin(memory_entry.handle);
+			if (pin) {
+				// move the block to the front of the LRU list
+				memory_lru.splice(memory_lru.begin(), memory_lru, entry->second);
+				return make_shared<HTTPCacheBlock>(move(pin), memory_entry.size);
+			}
+			// the buffer manager evicted the block
+			memory_usage -= memory_entry.size;
+			memory_lru.erase(entry->second);
+			memory_map.erase(entry);
+		}
+		if (directory.empty() || disk_map.find(file_name) == disk_map.end()) {
+			return nullptr;
+		}
+		path = fs.JoinPath(directory, file_name);
+	}
+	// the file might be evicted while it is read, in which case the read fails and the block is not cached
+	idx_t file_size;
+	auto block = ReadFromDisk(path, key, file_size);
+	if (!block) {
+		return nullptr;
+	}
+	lock_guard<mutex> guard(lock);
+	auto disk_entry = disk_map.find(file_name);
+	if (disk_entry != disk_map.end()) {
+		disk_lru.splice(disk_lru.begin(), disk_lru, disk_entry->second);
+	}
+	PutInMemory(key, block);
+	return block;
+}
+
+void HTTPBlockCache::Put(const string &key, shared_ptr<HTTPCacheBlock> block) {
+	auto file_name = DiskFileName(key);
+	string path, temporary_path;
+	{
+		lock_guard<mutex> guard(lock);
+		PutInMemory(key, block);
+		if (directory.empty() || disk_map.find(file_name) != disk_map.end()) {
+			return;
+		}
+		path = fs.JoinPath(directory, file_name);
+		temporary_path = path + "." + std::to_string(temporary_file_count++) + ".tmp";
+	}
+	// the block is written to a temporary file first, so a partially written block is never read. Writing to the
+	// cache is best-effort: a failed write only means that the block is fetched again later.
+	try {
+		WriteToDisk(temporary_path, key, *block);
+	} catch (...) {
+		try {
+			fs.RemoveFile(temporary_path);
+		} catch (...) {
+		}
+		return;
+	}
+	lock_guard<mutex> guard(lock);
+	try {
+		if (disk_map.find(file_name) != disk_map.end() || path != fs.JoinPath(directory, file_name)) {
+			// another thread wrote the block in the meantime, or the cache directory was changed
+			fs.RemoveFile(temporary_path);
+			return;
+		}
+		fs.MoveFile(temporary_path, path);
+	} catch (...) {
+		return;
+	}
+	TouchDiskEntry(file_name, sizeof(uint32_t) + key.size() + block->size);
+	EvictDisk();
+}
+
+void HTTPBlockCache::PutInMemory(const string &key, shared_ptr<HTTPCacheBlock> block) {
+	auto entry = memory_map.find(key);
+	if (entry != memory_map.end()) {
+		memory_usage -= entry->second->size;
+		memory_lru.erase(entry->second);
+		memory_map.erase(entry);
+	}
+	memory_usage += block->size;
+	memory_lru.push_front(MemoryEntry {key, block->pin->handle, block->size});
+	memory_map[key] = memory_lru.begin();
+	EvictMemory();
+}
+
+void HTTPBlockCache::EvictMemory() {
+	while (memory_usage > memory_limit) {
+		D_ASSERT(!memory_lru.empty());
+		auto &entry = memory_lru.back();
+		memory_usage -= entry.size;
+		memory_map.erase(entry.key);
+		memory_lru.pop_back();
+	}
+}
+
+void HTTPBlockCache::ScanDirectory() {
+	// the files of the blocks, and the temporary files of writes that were interrupted (which are evicted first)
+	vector<string> file_names;
+	fs.ListFiles(directory, [&](string file_name, bool is_directory) {
+		if (!is_directory && (StringUtil::EndsWith(file_name, ".block") || StringUtil::EndsWith(file_name, ".tmp"))) {
+			file_names.push_back(move(file_name));
+		}
+	});
+	vector<std::pair<time_t, DiskEntry>> entries;
+	for (auto &file_name : file_names) {
+		try {
+			auto handle = fs.OpenFile(fs.JoinPath(directory, file_name).c_str(), FileFlags::FILE_FLAGS_READ);
+			auto last_modified = StringUtil::EndsWith(file_name, ".tmp") ? 0 : fs.GetLastModifiedTime(*handle);
+			entries.emplace_back(last_modified, DiskEntry {file_name, (idx_t)fs.GetFileSize(*handle)});
+		} catch (...) {
+			// the file was removed in the meantime
+		}
+	}
+	// the most recently modified files are the most recently used
+	std::sort(entries.begin(), entries.end(),
+	          [](const std::pair<time_t, DiskEntry> &a, const std::pair<time_t, DiskEntry> &b) {
+		          return a.first > b.first;
+	          });
+	for (auto &entry : entries) {
+		disk_usage += entry.second.size;
+		disk_lru.push_back(move(entry.second));
+		disk_map[disk_lru.back().file_name] = std::prev(disk_lru.end());
+	}
+}
+
+void HTTPBlockCache::TouchDiskEntry(const string &file_name, idx_t size) {
+	auto entry = disk_map.find(file_name);
+	if (entry != disk_map.end()) {
+		disk_lru.splice(disk_lru.begin(), disk_lru, entry->second);
+		return;
+	}
+	disk_usage += size;
+	disk_lru.push_front(DiskEntry {file_name, size});
+	disk_map[file_name] = disk_lru.begin();
+}
+
+void HTTPBlockCache::EvictDisk() {
+	while (disk_usage > disk_limit && !disk_lru.empty()) {
+		auto &entry = disk_lru.back();
+		try {
+			fs.RemoveFile(fs.JoinPath(directory, entry.file_name));
+		} catch (...) {
+			// the file was already removed, e.g. by another process that uses the same directory
+		}
+		disk_usage -= entry.size;
+		disk_map.erase(entry.file_name);
+		disk_lru.pop_back();
+	}
+}
+
+string HTTPBlockCache::DiskFileName(const string &key) {
+	return std::to_string(std::hash<string>()(key)) + ".block";
+}
+
+shared_ptr<HTTPCacheBlock> HTTPBlockCache::ReadFromDisk(const string &path, const string &key, idx_t &file_size) {
+	try {
+		// the file starts with the key of the block, which protects against hash collisions
+		auto handle = fs.OpenFile(path.c_str(), FileFlags::FILE_FLAGS_READ);
+		file_size = fs.GetFileSize(*handle);
+		if (file_size < sizeof(uint32_t) + key.size()) {
+			return nullptr;
+		}
+		uint32_t key_size;
+		handle->Read(&key_size, sizeof(uint32_t), 0);
+		if (key_size != key.size()) {
+			return nullptr;
+		}
+		auto file_key = unique_ptr<char[]>(new char[key_size]);
+		handle->Read(file_key.get(), key_size, sizeof(uint32_t));
+		if (string(file_key.get(), key_size) != key) {
+			return nullptr;
+		}
+		auto data_offset = sizeof(uint32_t) + key_size;
+		auto block = Allocate(file_size - data_offset);
+		handle->Read(block->data, block->size, data_offset);
+		return block;
+	} catch (...) {
+		return nullptr;
+	}
+}
+
+void HTTPBlockCache::WriteToDisk(const string &path, const string &key, HTTPCacheBlock &block) {
+	auto handle = fs.OpenFile(path.c_str(), FileFlags::FILE_FLAGS_WRITE | FileFlags::FILE_FLAGS_FILE_CREATE_NEW);
+	uint32_t key_size = key.size();
+	handle->Write(&key_size, sizeof(uint32_t), 0);
+	handle->Write((void *)key.c_str(), key_size, sizeof(uint32_t));
+	handle->Write(block.data, block.size, sizeof(uint32_t) + key_size);
+}
+
+} // namespace duckdb
@@ -6,9 +6,12 @@ namespace duckdb {
 
 void HTTPFsExtension::Load(DuckDB &db) {
 	S3FileSystem::Verify(); // run some tests to see if all the hashes work out
-	db.instance->GetFileSystem().RegisterProtocolHandler("https://", make_unique<HTTPFileSystem>());
-	db.instance->GetFileSystem().RegisterProtocolHandler("http://", make_unique<HTTPFileSystem>());
-	db.instance->GetFileSystem().RegisterProtocolHandler("s3://", make_unique<S3FileSystem>(*db.instance));
+	// all protocols share the same block cache
+	db.instance->GetObjectCache().Put(HTTPBlockCache::OBJECT_CACHE_KEY, make_shared<HTTPBlockCache>(*db.instance));
+	auto &fs = db.instance->GetFileSystem();
+	fs.RegisterProtocolHandler("https://", make_unique<HTTPFileSystem>(*db.instance));
+	fs.RegisterProtocolHandler("http://", make_unique<HTTPFileSystem>(*db.instance));
+	fs.RegisterProtocolHandler("s3://", make_unique<S3FileSystem>(*db.instance));
 }
 
 } // namespace duckdb
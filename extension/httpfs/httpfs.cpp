@@ -1,17 +1,16 @@
 #include "httpfs.hpp"
+#include "duckdb/main/database.hpp"
+#include "duckdb/parallel/task_scheduler.hpp"
+#include "duckdb/storage/buffer_manager.hpp"
 #define CPPHTTPLIB_OPENSSL_SUPPORT
 #include "httplib.hpp"
 
+#include <condition_variable>
 #include <map>
 
 using namespace duckdb;
 
-unique_ptr<ResponseWrapper> HTTPFileSystem::Request(FileHandle &handle, string url, string method, HeaderMap header_map,
-                                                    idx_t file_offset, char *buffer_out, idx_t buffer_len) {
-	auto headers = make_unique<httplib::Headers>();
-	for (auto &entry : header_map) {
-		headers->insert(entry);
-	}
+static void ParseUrl(const string &url, string &proto_host_port, string &path) {
 	if (url.rfind("http://", 0) != 0 && url.rfind("https://", 0) != 0) {
 		throw std::runtime_error("URL needs to start with http:// or https://");
 	}
@@ -19,19 +18,76 @@ unique_ptr<ResponseWrapper> HTTPFileSystem::Request(FileHandle &handle, string u
 	if (slash_pos == std::string::npos) {
 		throw std::runtime_error("URL needs to contain a '/' after the host");
 	}
-	auto proto_host_port = url.substr(0, slash_pos);
+	proto_host_port = url.substr(0, slash_pos);
 
-	auto path = url.substr(slash_pos);
+	path = url.substr(slash_pos);
 	if (path.empty()) {
 		throw std::runtime_error("URL needs to contain a path");
 	}
+}
 
-	httplib::Client cli(proto_host_port.c_str());
-	cli.set_follow_location(true);
-	cli.enable_server_certificate_verification(false);
+static unique_ptr<httplib::Client> GetClient(const string &proto_host_port) {
+	auto client = make_unique<httplib::Client>(proto_host_port.c_str());
+	client->set_follow_location(true);
+	client->enable_server_certificate_verification(false);
+	return client;
+}
+
+static httplib::Headers GetHeaders(HeaderMap &header_map) {
+	httplib::Headers headers;
+	for (auto &entry : header_map) {
+		headers.insert(entry);
+	}
+	return headers;
+}
+
+unique_ptr<ResponseWrapper> HTTPFileSystem::PutRequest(FileHandle &handle, string url, HeaderMap header_map,
+                                                       char *buffer_in, idx_t buffer_in_len) {
+	string proto_host_port, path;
+	ParseUrl(url, proto_host_port, path);
+	auto headers = GetHeaders(header_map);
+	auto client = GetClient(proto_host_port);
+	auto res = client->Put(path.c_str(), headers, buffer_in, buffer_in_len, "application/octet-stream");
+	if (res.error() != httplib::Error::Success) {
+		throw std::runtime_error("HTTP PUT error on '" + url + "' " + std::to_string(res.error()));
+	}
+	return make_unique<ResponseWrapper>(res.value());
+}
+
+unique_ptr<ResponseWrapper> HTTPFileSystem::PostRequest(FileHandle &handle, string url, HeaderMap header_map,
+                                                        char *buffer_in, idx_t buffer_in_len) {
+	string proto_host_port, path;
+	ParseUrl(url, proto_host_port, path);
+	auto headers = GetHeaders(header_map);
+	auto client = GetClient(proto_host_port);
+	auto res = client->Post(path.c_str(), headers, buffer_in, buffer_in_len, "application/octet-stream");
+	if (res.error() != httplib::Error::Success) {
+		throw std::runtime_error("HTTP POST error on '" + url + "' " + std::to_string(res.error()));
+	}
+	return make_unique<ResponseWrapper>(res.value());
+}
+
+unique_ptr<ResponseWrapper> HTTPFileSystem::DeleteRequest(FileHandle &handle, string url, HeaderMap header_map) {
+	string proto_host_port, path;
+	ParseUrl(url, proto_host_port, path);
+	auto headers = GetHeaders(header_map);
+	auto client = GetClient(proto_host_port);
+	auto res = client->Delete(path.c_str(), headers);
+	if (res.error() != httplib::Error::Success) {
+		throw std::runtime_error("HTTP DELETE error on '" + url + "' " + std::to_string(res.error()));
+	}
+	return make_unique<ResponseWrapper>(res.value());
+}
+
+unique_ptr<ResponseWrapper> HTTPFileSystem::Request(FileHandle &handle, string url, string method, HeaderMap header_map,
+                                                    idx_t file_offset, char *buffer_out, idx_t buffer_len) {
+	string proto_host_port, path;
+	ParseUrl(url, proto_host_port, path);
+	auto headers = GetHeaders(header_map);
+	auto client = GetClient(proto_host_port);
 
 	if (method == "HEAD") {
-		auto res = cli.Head(path.c_str(), *headers);
+		auto res = client->Head(path.c_str(), headers);
 		if (res.error() != httplib::Error::Success) {
 			throw std::runtime_error("HTTP HEAD error on '" + url + "' " + std::to_string(res.error()));
 		}
@@ -42,11 +98,11 @@ unique_ptr<ResponseWrapper> HTTPFileSystem::Request(FileHandle &handle, string u
 	// printf("%s(%llu, %llu)\n", method.c_str(), file_offset, buffer_len);
 
 	// send the Range header to read only subset of file
-	headers->insert(std::pair<std::string, std::string>("Range", range_expr));
+	headers.insert(std::pair<std::string, std::string>("Range", range_expr));
 
 	idx_t out_offset = 0;
-	auto res = cli.Get(
-	    path.c_str(), *headers,
+	auto res = client->Get(
+	    path.c_str(), headers,
 	    [&](const httplib::Response &response) {
 		    if (response.status >= 400) {
 			    throw std::runtime_error("HTTP error");
@@ -71,51 +127,254 @@ unique_ptr<ResponseWrapper> HTTPFileSystem::Request(FileHandle &handle, string u
 	return make_unique<ResponseWrapper>(res.value());
 }
 
-HTTPFileHandle::HTTPFileHandle(FileSystem &fs, std::string path)
-    : FileHandle(fs, path), length(0), buffer_available(0), buffer_idx(0), file_offset(0) {
-	buffer = std::unique_ptr<data_t[]>(new data_t[BUFFER_LEN]);
+HTTPFileHandle::HTTPFileHandle(FileSystem &fs, std::string path, uint8_t flags)
+    : FileHandle(fs, path), flags(flags), length(0), last_modified(0), current_block_idx(0) {
+}
+
+string HTTPFileHandle::BlockKey(idx_t block_idx) {
+	// files without ETag are validated using their size and modification time
+	auto validator = etag.empty() ? std::to_string(length) + ":" + std::to_string(last_modified) : etag;
+	return path + "\n" + validator + "\n" + std::to_string(block_idx);
+}
 
-	IntializeMetadata();
+static idx_t GetSizeSetting(DatabaseInstance &db, const string &name, idx_t default_value) {
+	auto entry = db.config.set_variables.find(name);
+	if (entry == db.config.set_variables.end()) {
+		return default_value;
+	}
+	auto value = entry->second.GetValue<int64_t>();
+	if (value < 0) {
+		throw std::runtime_error(name + " must be a positive amount of bytes");
+	}
+	return value;
+}
+
+shared_ptr<HTTPBlockCache> HTTPFileSystem::GetCache() {
+	auto cache = std::dynamic_pointer_cast<HTTPBlockCache>(
+	    database_instance.GetObjectCache().Get(HTTPBlockCache::OBJECT_CACHE_KEY));
+	D_ASSERT(cache);
+	// the settings are only parsed again if a SET statement was executed since the cache was configured
+	auto settings_version = database_instance.config.set_variables_version;
+	if (cache->configured_version == settings_version) {
+		return cache;
+	}
+	auto memory_limit = GetSizeSetting(database_instance, "http_cache_size", HTTPBlockCache::DEFAULT_MEMORY_LIMIT);
+	auto disk_limit = GetSizeSetting(database_instance, "http_cache_disk_size", HTTPBlockCache::DEFAULT_DISK_LIMIT);
+	string directory;
+	auto entry = database_instance.config.set_variables.find("http_cache_directory");
+	if (entry != database_instance.config.set_variables.end()) {
+		directory = entry->second.ToString();
+	}
+	cache->Configure(memory_limit, move(directory), disk_limit);
+	cache->configured_version = settings_version;
+	return cache;
 }
 
 std::unique_ptr<FileHandle> HTTPFileSystem::OpenFile(const char *path, uint8_t flags, FileLockType lock) {
-	return duckdb::make_unique<HTTPFileHandle>(*this, path);
+	if (flags & FileFlags::FILE_FLAGS_WRITE) {
+		throw std::runtime_error("Writing to HTTP files is not supported");
+	}
+	auto handle = duckdb::make_unique<HTTPFileHandle>(*this, path, flags);
+	handle->cache = GetCache();
+	handle->IntializeMetadata();
+	return move(handle);
 }
 
 void HTTPFileSystem::Read(FileHandle &handle, void *buffer, int64_t nr_bytes, idx_t location) {
 	auto &hfh = (HTTPFileHandle &)handle;
-	idx_t to_read = nr_bytes;
-	idx_t buffer_offset = 0;
 	if (location + nr_bytes > hfh.length) {
 		throw std::runtime_error("out of file");
 	}
+	if (nr_bytes == 0) {
+		return;
+	}
+	auto block_size = HTTPBlockCache::BLOCK_SIZE;
+	auto first_block = location / block_size;
+	auto last_block = (location + nr_bytes - 1) / block_size;
+	if (first_block == last_block && hfh.current_block && hfh.current_block_idx == first_block) {
+		memcpy(buffer, hfh.current_block->data + location - first_block * block_size, nr_bytes);
+		return;
+	}
+
+	auto blocks = GetBlocks(hfh, first_block, last_block);
+	idx_t buffer_offset = 0;
+	for (idx_t block_idx = first_block; block_idx <= last_block; block_idx++) {
+		auto &block = blocks[block_idx - first_block];
+		auto block_start = block_idx * block_size;
+		auto read_start = MaxValue<idx_t>(location, block_start);
+		auto read_end = MinValue<idx_t>(location + nr_bytes, block_start + block->size);
+		memcpy((char *)buffer + buffer_offset, block->data + read_start - block_start, read_end - read_start);
+		buffer_offset += read_end - read_start;
+	}
+	D_ASSERT(buffer_offset == (idx_t)nr_bytes);
+	hfh.current_block = move(blocks.back());
+	hfh.current_block_idx = last_block;
+}
+
+void HTTPFileSystem::Prefetch(FileHandle &handle, const vector<pair<idx_t, idx_t>> &ranges) {
+	auto &hfh = (HTTPFileHandle &)handle;
+	// prefetching more than the cache (or the buffer manager) can hold would evict the prefetched blocks before they
+	// are read
+	auto &buffer_manager = BufferManager::GetBufferManager(database_instance);
+	auto prefetch_limit =
+	    MinValue<idx_t>(hfh.cache->GetMemoryLimit(), buffer_manager.GetMaxMemory()) / 2 / HTTPBlockCache::BLOCK_SIZE;
+	vector<idx_t> blocks;
+	for (auto &range : ranges) {
+		auto range_end = MinValue<idx_t>(range.first + range.second, hfh.length);
+		if (range.second == 0 || range.first >= range_end) {
+			continue;
+		}
+		auto last_block = (range_end - 1) / HTTPBlockCache::BLOCK_SIZE;
+		for (auto block_idx = range.first / HTTPBlockCache::BLOCK_SIZE; block_idx <= last_block; block_idx++) {
+			blocks.push_back(block_idx);
+		}
+	}
+	std::sort(blocks.begin(), blocks.end());
+	blocks.erase(std::unique(blocks.begin(), blocks.end()), blocks.end());
+	if (blocks.size() > prefetch_limit) {
+		return;
+	}
+
+	vector<idx_t> missing_blocks;
+	for (auto block_idx : blocks) {
+		if (!hfh.cache->Get(hfh.BlockKey(block_idx))) {
+			missing_blocks.push_back(block_idx);
+		}
+	}
+	FetchBlocks(hfh, missing_blocks);
+}
+
+vector<shared_ptr<HTTPCacheBlock>> HTTPFileSystem::GetBlocks(HTTPFileHandle &handle, idx_t first_block,
+                                                             idx_t last_block) {
+	vector<shared_ptr<HTTPCacheBlock>> result;
+	vector<idx_t> missing_blocks;
+	for (idx_t block_idx = first_block; block_idx <= last_block; block_idx++) {
+		auto block = handle.cache->Get(handle.BlockKey(block_idx));
+		if (!block) {
+			missing_blocks.push_back(block_idx);
+		}
+		result.push_back(move(block));
+	}
+	if (missing_blocks.empty()) {
+		return result;
+	}
+	auto fetched_blocks = FetchBlocks(handle, missing_blocks);
+	for (auto block_idx : missing_blocks) {
+		result[block_idx - first_block] = fetched_blocks[block_idx];
+	}
+	return result;
+}
+
+//! A ranged GET request of FetchBlocks, which fetches one or more consecutive blocks
+struct HTTPRangeRequest {
+	idx_t first_block;
+	idx_t block_count;
+	idx_t offset;
+	idx_t length;
+	unique_ptr<char[]> buffer;
+	string error;
+};
+
+struct HTTPFetchState {
+	vector<HTTPRangeRequest> requests;
+	//! The amount of tasks that have finished, signaled with finished
+	mutex lock;
+	std::condition_variable finished;
+	idx_t finished_tasks = 0;
+};
+
+//! Performs every task_count-th request of a FetchBlocks call, starting at task_idx
+class HTTPFetchTask : public Task {
+public:
+	HTTPFetchTask(HTTPFileSystem &fs, HTTPFileHandle &handle, HTTPFetchState &state, idx_t task_idx, idx_t task_count)
+	    : fs(fs), handle(handle), state(state), task_idx(task_idx), task_count(task_count) {
+	}
 
-	// TODO we need to check if location is within the cached buffer and update or invalidate
-	// for now just invalidate
-	if (location != hfh.file_offset) {
-		hfh.buffer_available = 0;
-		hfh.buffer_idx = 0;
-		hfh.file_offset = location;
+	void Execute() override {
+		for (idx_t request_idx = task_idx; request_idx < state.requests.size(); request_idx += task_count) {
+			auto &request = state.requests[request_idx];
+			try {
+				fs.Request(handle, handle.path, "GET", {}, request.offset, request.buffer.get(), request.length);
+			} catch (std::exception &ex) {
+				request.error = ex.what();
+			}
+		}
+		// the state is destroyed once the last task has finished: it is only touched while holding the lock
+		lock_guard<mutex> guard(state.lock);
+		state.finished_tasks++;
+		state.finished.notify_one();
 	}
 
-	while (to_read > 0) {
-		auto buffer_read_len = MinValue<idx_t>(hfh.buffer_available, to_read);
-		memcpy((char *)buffer + buffer_offset, hfh.buffer.get() + hfh.buffer_idx, buffer_read_len);
+private:
+	HTTPFileSystem &fs;
+	HTTPFileHandle &handle;
+	HTTPFetchState &state;
+	idx_t task_idx;
+	idx_t task_count;
+};
 
-		buffer_offset += buffer_read_len;
-		to_read -= buffer_read_len;
+unordered_map<idx_t, shared_ptr<HTTPCacheBlock>> HTTPFileSystem::FetchBlocks(HTTPFileHandle &handle,
+                                                                             const vector<idx_t> &blocks) {
+	// coalesce the blocks into ranges, small gaps between the blocks are fetched as well
+	HTTPFetchState state;
+	auto &requests = state.requests;
+	for (auto block_idx : blocks) {
+		if (!requests.empty()) {
+			auto &last = requests.back();
+			auto end_block = last.first_block + last.block_count;
+			if (block_idx <= end_block + COALESCE_GAP_BLOCKS && block_idx - last.first_block < MAX_REQUEST_BLOCKS) {
+				last.block_count = block_idx - last.first_block + 1;
+				continue;
+			}
+		}
+		HTTPRangeRequest request;
+		request.first_block = block_idx;
+		request.block_count = 1;
+		requests.push_back(move(request));
+	}
+	for (auto &request : requests) {
+		request.offset = request.first_block * HTTPBlockCache::BLOCK_SIZE;
+		request.length =
+		    MinValue<idx_t>(request.block_count * HTTPBlockCache::BLOCK_SIZE, handle.length - request.offset);
+		request.buffer = unique_ptr<char[]>(new char[request.length]);
+	}
 
-		hfh.buffer_idx += buffer_read_len;
-		hfh.buffer_available -= buffer_read_len;
-		hfh.file_offset += buffer_read_len;
+	// perform the requests, several at a time, as tasks of the task scheduler. The tasks that are not picked up by a
+	// worker thread are executed by this thread, which then waits for the tasks of the worker threads to finish.
+	idx_t task_count = MinValue<idx_t>(MAX_PARALLEL_REQUESTS, requests.size());
+	if (task_count == 1) {
+		HTTPFetchTask(*this, handle, state, 0, 1).Execute();
+	} else if (task_count > 1) {
+		auto &scheduler = database_instance.GetScheduler();
+		auto producer = scheduler.CreateProducer();
+		for (idx_t task_idx = 0; task_idx < task_count; task_idx++) {
+			scheduler.ScheduleTask(*producer, make_unique<HTTPFetchTask>(*this, handle, state, task_idx, task_count));
+		}
+		unique_ptr<Task> task;
+		while (scheduler.GetTaskFromProducer(*producer, task)) {
+			task->Execute();
+			task.reset();
+		}
+		std::unique_lock<mutex> guard(state.lock);
+		state.finished.wait(guard, [&]() { return state.finished_tasks == task_count; });
+	}
 
-		if (to_read > 0 && hfh.buffer_available == 0) {
-			auto new_buffer_available = MinValue<idx_t>(hfh.BUFFER_LEN, hfh.length - hfh.file_offset);
-			Request(hfh, hfh.path, "GET", {}, hfh.file_offset, (char *)hfh.buffer.get(), new_buffer_available);
-			hfh.buffer_available = new_buffer_available;
-			hfh.buffer_idx = 0;
+	// split the responses into blocks
+	unordered_map<idx_t, shared_ptr<HTTPCacheBlock>> result;
+	for (auto &request : requests) {
+		if (!request.error.empty()) {
+			throw std::runtime_error(request.error);
+		}
+		for (idx_t i = 0; i < request.block_count; i++) {
+			auto block_offset = i * HTTPBlockCache::BLOCK_SIZE;
+			auto block =
+			    handle.cache->Allocate(MinValue<idx_t>(HTTPBlockCache::BLOCK_SIZE, request.length - block_offset));
+			memcpy(block->data, request.buffer.get() + block_offset, block->size);
+			handle.cache->Put(handle.BlockKey(request.first_block + i), block);
+			result[request.first_block + i] = move(block);
 		}
 	}
+	return result;
 }
 
 void HTTPFileHandle::IntializeMetadata() {
@@ -126,8 +385,9 @@ void HTTPFileHandle::IntializeMetadata() {
 		throw std::runtime_error("Unable to connect " + res->error);
 	}
 	length = std::atoll(res->headers["Content-Length"].c_str());
+	etag = res->headers["ETag"];
 
-	struct tm tm;
+	struct tm tm {};
 	strptime(res->headers["Last-Modified"].c_str(), "%a, %d %h %Y %T %Z", &tm);
 	last_modified = std::mktime(&tm);
 }
@@ -135,6 +395,7 @@ void HTTPFileHandle::IntializeMetadata() {
 ResponseWrapper::ResponseWrapper(httplib::Response &res) {
 	code = res.status;
 	error = res.body;
+	body = res.body;
 	for (auto &h : res.headers) {
 		headers[h.first] = h.second;
 	}
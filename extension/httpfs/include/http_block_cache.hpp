@@ -0,0 +1,120 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// http_block_cache.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/common/common.hpp"
+#include "duckdb/common/file_system.hpp"
+#include "duckdb/common/mutex.hpp"
+#include "duckdb/common/unordered_map.hpp"
+#include "duckdb/storage/buffer/buffer_handle.hpp"
+#include "duckdb/storage/object_cache.hpp"
+
+#include <atomic>
+#include <list>
+
+namespace duckdb {
+class BlockHandle;
+class DatabaseInstance;
+
+//! A block of a remote file. The data of the block is held in a buffer of the buffer manager, which is pinned while
+//! the block is used.
+struct HTTPCacheBlock {
+	HTTPCacheBlock(unique_ptr<BufferHandle> pin_p, idx_t size) : pin(move(pin_p)), data(pin->Ptr()), size(size) {
+	}
+
+	unique_ptr<BufferHandle> pin;
+	data_ptr_t data;
+	idx_t size;
+};
+
+//! The HTTPBlockCache holds blocks of remote files, so that repeated reads of the same files do not download them
+//! again. Blocks are evicted from memory in LRU order once the memory limit is exceeded. The blocks are held in buffers
+//! of the buffer manager, so they count towards the memory limit of the database, and the buffer manager evicts the
+//! blocks that are not in use when it runs out of memory. If a cache directory is set, blocks are also written to
+//! disk, where they survive memory eviction and restarts. The blocks that are in the directory when it is configured
+//! count towards the disk limit as well. Blocks are read from and written to disk without holding the lock of the
+//! cache.
+//! The cache is kept in the object cache of the database, which is destroyed before the buffer manager.
+class HTTPBlockCache : public ObjectCacheEntry {
+public:
+	//! The size of the blocks in which remote files are fetched and cached
+	static constexpr idx_t BLOCK_SIZE = 1024 * 1024;
+	static constexpr idx_t DEFAULT_MEMORY_LIMIT = 256 * BLOCK_SIZE;
+	static constexpr idx_t DEFAULT_DISK_LIMIT = 4096 * BLOCK_SIZE;
+	//! The key of the cache in the object cache of the database
+	static constexpr const char *OBJECT_CACHE_KEY = "http_block_cache";
+
+public:
+	explicit HTTPBlockCache(DatabaseInstance &db);
+	~HTTPBlockCache() override;
+
+	//! The version of the settings of the database (DBConfig::set_variables_version) that the cache was last
+	//! configured with
+	std::atomic<idx_t> configured_version;
+
+	//! Update the limits and the (optional) directory of the cache
+	void Configure(idx_t memory_limit, string directory, idx_t disk_limit);
+	//! Allocate a new block of at most BLOCK_SIZE bytes, which is not added to the cache yet
+	shared_ptr<HTTPCacheBlock> Allocate(idx_t size);
+
+	//! Returns the cached block with the given key, or nullptr if it is not cached
+	shared_ptr<HTTPCacheBlock> Get(const string &key);
+	//! Add a block to the cache
+	void Put(const string &key, shared_ptr<HTTPCacheBlock> block);
+
+	idx_t GetMemoryLimit();
+
+private:
+	struct MemoryEntry {
+		string key;
+		//! The (unpinned) buffer of the block, which is destroyed if the buffer manager evicts it
+		shared_ptr<BlockHandle> handle;
+		idx_t size;
+	};
+	struct DiskEntry {
+		//! The name of the file of the block in the cache directory
+		string file_name;
+		idx_t size;
+	};
+
+	DatabaseInstance &db;
+	mutex lock;
+	//! The local file system that holds the on-disk cache
+	FileSystem fs;
+
+	idx_t memory_limit = DEFAULT_MEMORY_LIMIT;
+	idx_t memory_usage = 0;
+	//! The blocks that are cached in memory, ordered from most to least recently used
+	std::list<MemoryEntry> memory_lru;
+	unordered_map<string, std::list<MemoryEntry>::iterator> memory_map;
+
+	string directory;
+	idx_t disk_limit = DEFAULT_DISK_LIMIT;
+	idx_t disk_usage = 0;
+	//! The blocks in the cache directory, ordered from most to least recently used
+	std::list<DiskEntry> disk_lru;
+	unordered_map<string, std::list<DiskEntry>::iterator> disk_map;
+	//! Used to give the temporary files of concurrent writes a unique name
+	idx_t temporary_file_count = 0;
+
+private:
+	void PutInMemory(const string &key, shared_ptr<HTTPCacheBlock> block);
+	void EvictMemory();
+	//! Register the block files that are in the cache directory (e.g. written before a restart)
+	void ScanDirectory();
+	//! Mark a block file as most recently used, adding it if it is not registered yet
+	void TouchDiskEntry(const string &file_name, idx_t size);
+	void EvictDisk();
+	static string DiskFileName(const string &key);
+	//! Reads and writes of block files, which are called without holding the lock
+	shared_ptr<HTTPCacheBlock> ReadFromDisk(const string &path, const string &key, idx_t &file_size);
+	void WriteToDisk(const string &path, const string &key, HTTPCacheBlock &block);
+};
+
+} // namespace duckdb
@@ -3,6 +3,7 @@
 #include "duckdb/common/file_system.hpp"
 #include "duckdb/common/pair.hpp"
 #include "duckdb/common/unordered_map.hpp"
+#include "http_block_cache.hpp"
 
 namespace httplib {
 struct Response;
@@ -10,6 +11,8 @@ struct Response;
 
 namespace duckdb {
 
+class DatabaseInstance;
+
 using HeaderMap = unordered_map<string, string>;
 
 struct ResponseWrapper { /* avoid including httplib in header */
@@ -17,45 +20,77 @@ public:
 	ResponseWrapper(httplib::Response &res);
 	int code;
 	string error;
+	string body;
 	HeaderMap headers;
 };
 
 class HTTPFileHandle : public FileHandle {
 public:
-	HTTPFileHandle(FileSystem &fs, std::string path);
+	HTTPFileHandle(FileSystem &fs, std::string path, uint8_t flags);
+
+	//! Fetch the length and modification time of the file
+	virtual void IntializeMetadata();
 
 protected:
 	void Close() override {
 	}
 
-private:
-	virtual void IntializeMetadata();
-
 public:
+	//! The flags the file was opened with
+	uint8_t flags;
 	idx_t length;
 	time_t last_modified;
+	//! The ETag of the file, if the server returned one
+	string etag;
+
+	//! The block cache of the database
+	shared_ptr<HTTPBlockCache> cache;
+	//! The block that was read last, most reads of a handle are small sequential reads within the same block
+	shared_ptr<HTTPCacheBlock> current_block;
+	idx_t current_block_idx;
 
-	std::unique_ptr<data_t[]> buffer;
-	constexpr static idx_t BUFFER_LEN = 10000; // FIXME make the buffer bigger
-	idx_t buffer_available;
-	idx_t buffer_idx;
-	idx_t file_offset;
+	//! The key of a block of this file in the block cache, which changes when the file is modified
+	string BlockKey(idx_t block_idx);
 };
 
 class HTTPFileSystem : public FileSystem {
 public:
+	//! The maximum amount of ranged GET requests that are in flight at the same time
+	static constexpr idx_t MAX_PARALLEL_REQUESTS = 8;
+	//! The maximum amount of blocks fetched by a single request
+	static constexpr idx_t MAX_REQUEST_BLOCKS = 16;
+	//! Uncached blocks that are at most this many blocks apart are fetched by the same request
+	static constexpr idx_t COALESCE_GAP_BLOCKS = 1;
+
+	explicit HTTPFileSystem(DatabaseInstance &instance_p) : database_instance(instance_p) {
+	}
+
 	std::unique_ptr<FileHandle> OpenFile(const char *path, uint8_t flags,
 	                                     FileLockType lock = FileLockType::NO_LOCK) override;
 
 	std::vector<std::string> Glob(const std::string &path) override {
 		return {path}; // FIXME
 	}
+	bool GlobFileInfo(const string &path, vector<string> &files, vector<FileInfo> &file_info) override {
+		files.clear();
+		file_info.clear();
+		return false;
+	}
 
 	void Read(FileHandle &handle, void *buffer, int64_t nr_bytes, idx_t location) override;
 
+	void Prefetch(FileHandle &handle, const vector<pair<idx_t, idx_t>> &ranges) override;
+
 	virtual unique_ptr<ResponseWrapper> Request(FileHandle &handle, string url, string method,
 	                                            HeaderMap header_map = {}, idx_t file_offset = 0,
 	                                            char *buffer_out = nullptr, idx_t buffer_len = 0);
+	//! Send buffer_in as the body of a PUT request
+	virtual unique_ptr<ResponseWrapper> PutRequest(FileHandle &handle, string url, HeaderMap header_map,
+	                                               char *buffer_in, idx_t buffer_in_len);
+	//! Send buffer_in as the body of a POST request, the response body is returned in the ResponseWrapper
+	virtual unique_ptr<ResponseWrapper> PostRequest(FileHandle &handle, string url, HeaderMap header_map,
+	                                                char *buffer_in, idx_t buffer_in_len);
+	virtual unique_ptr<ResponseWrapper> DeleteRequest(FileHandle &handle, string url, HeaderMap header_map);
 
 	int64_t Read(FileHandle &handle, void *buffer, int64_t nr_bytes) override {
 		throw std::runtime_error("Read3"); // unused by parquet reader
@@ -74,7 +109,7 @@ public:
 	bool FileExists(const string &filename) override {
 		try {
 			auto handle = OpenFile(filename.c_str(), FileFlags::FILE_FLAGS_READ);
-			auto &sfh = (HTTPFileHandle &)handle;
+			auto &sfh = (HTTPFileHandle &)*handle;
 			if (sfh.length == 0) {
 				throw std::runtime_error("not there this file");
 			}
@@ -85,6 +120,20 @@ public:
 	}
 
 	static void Verify();
+
+public:
+	DatabaseInstance &database_instance;
+
+protected:
+	//! Returns the block cache of the database, after updating its configuration if the http_cache_* settings might
+	//! have changed
+	shared_ptr<HTTPBlockCache> GetCache();
+
+private:
+	//! Returns the blocks [first_block, last_block] of the file
+	vector<shared_ptr<HTTPCacheBlock>> GetBlocks(HTTPFileHandle &handle, idx_t first_block, idx_t last_block);
+	//! Fetch the (sorted) blocks of the file, using as few requests as possible, and add them to the cache
+	unordered_map<idx_t, shared_ptr<HTTPCacheBlock>> FetchBlocks(HTTPFileHandle &handle, const vector<idx_t> &blocks);
 };
 
 } // namespace duckdb
@@ -3,11 +3,78 @@
 #include "httpfs.hpp"
 #include "duckdb/main/database.hpp"
 
+#include <list>
+#include <thread>
+
 namespace duckdb {
 
+//! The s3_* settings, read once when a file is opened
+struct S3AuthParams {
+	string region;
+	string access_key_id;
+	string secret_access_key;
+	//! The host of the S3 service, e.g. a local S3-compatible server
+	string endpoint;
+	//! Either "vhost" (bucket.endpoint/key) or "path" (endpoint/bucket/key)
+	string url_style;
+	bool use_ssl;
+
+	static S3AuthParams ReadFrom(DatabaseInstance &instance);
+};
+
+//! A part of a multipart upload that is being uploaded in the background
+struct S3PartUpload {
+	idx_t part_number;
+	unique_ptr<char[]> data;
+	idx_t size;
+	std::thread thread;
+	//! The ETag of the uploaded part, or the error that occurred during the upload
+	string etag;
+	string error;
+};
+
+class S3FileHandle : public HTTPFileHandle {
+public:
+	S3FileHandle(FileSystem &fs, std::string path, uint8_t flags, S3AuthParams auth_params, idx_t part_size)
+	    : HTTPFileHandle(fs, path, flags), auth_params(move(auth_params)), part_size(part_size), part_offset(0),
+	      part_count(0) {
+	}
+	~S3FileHandle() override;
+
+	S3AuthParams auth_params;
+
+	//! The id of the multipart upload of a file that is opened for writing
+	string upload_id;
+	//! The buffer of the part that is being written
+	unique_ptr<char[]> part_buffer;
+	//! The size of the parts, which grows as the amount of parts rises
+	idx_t part_size;
+	idx_t part_offset;
+	idx_t part_count;
+	//! The ETags of the parts that finished uploading
+	vector<string> part_etags;
+	//! The parts that are being uploaded
+	std::list<S3PartUpload> uploads;
+
+protected:
+	void Close() override;
+};
+
 class S3FileSystem : public HTTPFileSystem {
 public:
-	S3FileSystem(DatabaseInstance &instance_p) : database_instance(instance_p) {
+	//! The minimum size of the parts of a multipart upload, S3 requires parts (except the last one) of at least 5MB
+	static constexpr idx_t MIN_UPLOAD_PART_SIZE = 5 * 1024 * 1024;
+	//! The default size of the parts of a multipart upload
+	static constexpr idx_t DEFAULT_UPLOAD_PART_SIZE = MIN_UPLOAD_PART_SIZE;
+	//! The maximum amount of parts of a multipart upload that S3 accepts
+	static constexpr idx_t MAX_UPLOAD_PARTS = 10000;
+	//! The part size is doubled every time this many parts have been uploaded, so the part limit is only reached by
+	//! files of about 5TB (the maximum object size of S3) with the default part size
+	static constexpr idx_t PART_SIZE_DOUBLING_INTERVAL = 1000;
+	//! The maximum amount of parts that are uploaded at the same time, which bounds the memory used by an upload
+	static constexpr idx_t MAX_PARALLEL_UPLOADS = 4;
+
+	explicit S3FileSystem(DatabaseInstance &instance_p) : HTTPFileSystem(instance_p) {
 	}
 	std::unique_ptr<FileHandle> OpenFile(const char *path, uint8_t flags,
 	                                     FileLockType lock = FileLockType::NO_LOCK) override;
@@ -15,13 +82,38 @@ public:
 	unique_ptr<ResponseWrapper> Request(FileHandle &handle, string url, string method, HeaderMap header_map = {},
 	                                    idx_t file_offset = 0, char *buffer_out = nullptr,
 	                                    idx_t buffer_len = 0) override;
-	static void Verify();
+	unique_ptr<ResponseWrapper> PutRequest(FileHandle &handle, string url, HeaderMap header_map, char *buffer_in,
+	                                       idx_t buffer_in_len) override;
+	unique_ptr<ResponseWrapper> PostRequest(FileHandle &handle, string url, HeaderMap header_map, char *buffer_in,
+	                                        idx_t buffer_in_len) override;
+	unique_ptr<ResponseWrapper> DeleteRequest(FileHandle &handle, string url, HeaderMap header_map) override;
 
-public:
-	DatabaseInstance &database_instance;
+	//! Files are written using multipart uploads, which only support sequential writes
+	void Write(FileHandle &handle, void *buffer, int64_t nr_bytes, idx_t location) override;
+	int64_t Write(FileHandle &handle, void *buffer, int64_t nr_bytes) override;
+	//! Upload the remaining data and complete the multipart upload, the file only becomes visible afterwards
+	void FileSync(FileHandle &handle) override;
+
+	//! Returns the size of the parts that follow the part with the given number (numbered from 1)
+	static idx_t NextPartSize(idx_t part_size, idx_t part_number);
+
+	static void Verify();
 
 private:
-	HeaderMap CreateAuthHeaders(string host, string path, string method);
+	//! Returns the HTTP URL and the signed headers of a request to the s3:// URL
+	string PrepareRequest(S3FileHandle &handle, const string &url, const string &method, const char *payload,
+	                      idx_t payload_len, HeaderMap &header_map);
+
+	void InitializeMultipartUpload(S3FileHandle &handle);
+	//! Start the upload of the buffered part in the background
+	void FlushPart(S3FileHandle &handle);
+	//! Wait for the oldest part upload to finish
+	void WaitForUpload(S3FileHandle &handle);
+	void FinalizeMultipartUpload(S3FileHandle &handle);
+
+public:
+	//! Discard the parts of an upload that was not completed, S3 keeps (and bills) them until the upload is aborted
+	void AbortMultipartUpload(S3FileHandle &handle);
 };
 
 } // namespace duckdb
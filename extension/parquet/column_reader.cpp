@@ -104,17 +104,38 @@ unique_ptr<ColumnReader> ColumnReader::CreateReader(const LogicalType &type_p, c
 	throw NotImplementedException(type_p.ToString());
 }
 
-void ColumnReader::PrepareRead(parquet_filter_t &filter) {
-	dict_decoder.reset();
-	defined_decoder.reset();
-	block.reset();
+static bool IsDataPage(PageHeader &page_hdr) {
+	return page_hdr.type == PageType::DATA_PAGE || page_hdr.type == PageType::DATA_PAGE_V2;
+}
 
+static idx_t DataPageValueCount(PageHeader &page_hdr) {
+	return page_hdr.type == PageType::DATA_PAGE ? page_hdr.data_page_header.num_values
+	                                            : page_hdr.data_page_header_v2.num_values;
+}
+
+void ColumnReader::PrepareRead(parquet_filter_t &filter) {
 	PageHeader page_hdr;
 	page_hdr.read(protocol);
 
 	//	page_hdr.printTo(std::cout);
 	//	std::cout << '\n';
 
+	ProcessPage(page_hdr);
+}
+
+void ColumnReader::ProcessPage(PageHeader &page_hdr) {
+	dict_decoder.reset();
+	defined_decoder.reset();
+
+	page_skipped = false;
+	if (IsDataPage(page_hdr) && PageCanBeSkipped(page_hdr, data_page_idx++)) {
+		// none of the values in this page can pass the filters: skip it without decompressing it
+		SkipPageData(page_hdr);
+		page_rows_available = DataPageValueCount(page_hdr);
+		page_skipped = true;
+		return;
+	}
+
 	PreparePage(page_hdr.compressed_page_size, page_hdr.uncompressed_page_size);
 
 	switch (page_hdr.type) {
@@ -130,47 +151,82 @@ void ColumnReader::PrepareRead(parquet_filter_t &filter) {
 	}
 }
 
-void ColumnReader::PreparePage(idx_t compressed_page_size, idx_t uncompressed_page_size) {
+bool ColumnReader::PageCanBeSkipped(PageHeader &page_hdr, idx_t page_idx) {
+	if (!page_filters || HasRepeats()) {
+		return false;
+	}
+	// NULL values never pass a comparison filter
+	parquet::format::Statistics page_stats;
+	if (column_index && page_idx < column_index->null_pages.size()) {
+		// prefer the column index. Its min/max values are lower and upper bounds of the values of the page, which the
+		// Parquet spec allows to be truncated (e.g. long strings): the zonemap check only uses them as inclusive
+		// bounds, so a page is never skipped when the constant is equal to a (truncated) bound
+		if (column_index->null_pages[page_idx]) {
+			return true;
+		}
+		page_stats.__set_min_value(column_index->min_values[page_idx]);
+		page_stats.__set_max_value(column_index->max_values[page_idx]);
+	} else if (page_hdr.type == PageType::DATA_PAGE && page_hdr.data_page_header.__isset.statistics) {
+		page_stats = page_hdr.data_page_header.statistics;
+	} else if (page_hdr.type == PageType::DATA_PAGE_V2 && page_hdr.data_page_header_v2.__isset.statistics) {
+		page_stats = page_hdr.data_page_header_v2.statistics;
+	} else {
+		return false;
+	}
+	if (page_stats.__isset.null_count && page_stats.null_count == (int64_t)DataPageValueCount(page_hdr)) {
+		return true;
+	}
+	auto stats = ParquetTransformStatistics(schema, type, page_stats);
+	return stats && !ParquetCheckZonemap(*stats, *page_filters);
+}
+
+void ColumnReader::SkipPageData(PageHeader &page_hdr) {
 	auto trans = (ThriftFileTransport *)protocol->getTransport().get();
+	trans->SetLocation(trans->GetLocation() + page_hdr.compressed_page_size);
+}
 
-	block = make_shared<ResizeableBuffer>(compressed_page_size + 1);
-	trans->read((uint8_t *)block->ptr, compressed_page_size);
+void ColumnReader::PreparePage(idx_t compressed_page_size, idx_t uncompressed_page_size) {
+	auto trans = (ThriftFileTransport *)protocol->getTransport().get();
 
 	//			page_hdr.printTo(std::cout);
 	//			std::cout << '\n';
 
-	shared_ptr<ResizeableBuffer> unpacked_block;
-	if (chunk->meta_data.codec != CompressionCodec::UNCOMPRESSED) {
-		unpacked_block = make_shared<ResizeableBuffer>(uncompressed_page_size + 1);
+	// vectors can hold on to the page data (e.g. strings that point into it), only reuse it if none does
+	if (!block || block.use_count() > 1) {
+		block = make_shared<ResizeableBuffer>();
+	}
+	if (chunk->meta_data.codec == CompressionCodec::UNCOMPRESSED) {
+		block->resize(compressed_page_size + 1);
+		trans->read((uint8_t *)block->ptr, compressed_page_size);
+		return;
 	}
 
+	// the compressed data is decompressed straight into the page buffer
+	compressed_block.resize(compressed_page_size + 1);
+	trans->read((uint8_t *)compressed_block.ptr, compressed_page_size);
+	block->resize(uncompressed_page_size + 1);
+
 	switch (chunk->meta_data.codec) {
-	case CompressionCodec::UNCOMPRESSED:
-		break;
 	case CompressionCodec::GZIP: {
 		MiniZStream s;
 
-		s.Decompress((const char *)block->ptr, compressed_page_size, (char *)unpacked_block->ptr,
+		s.Decompress((const char *)compressed_block.ptr, compressed_page_size, (char *)block->ptr,
 		             uncompressed_page_size);
-		block = move(unpacked_block);
-
 		break;
 	}
 	case CompressionCodec::SNAPPY: {
-		auto res = snappy::RawUncompress((const char *)block->ptr, compressed_page_size, (char *)unpacked_block->ptr);
+		auto res = snappy::RawUncompress((const char *)compressed_block.ptr, compressed_page_size, (char *)block->ptr);
 		if (!res) {
 			throw std::runtime_error("Decompression failure");
 		}
-		block = move(unpacked_block);
 		break;
 	}
 	case CompressionCodec::ZSTD: {
-		auto res = duckdb_zstd::ZSTD_decompress((char *)unpacked_block->ptr, uncompressed_page_size,
-		                                        (const char *)block->ptr, compressed_page_size);
+		auto res = duckdb_zstd::ZSTD_decompress((char *)block->ptr, uncompressed_page_size,
+		                                        (const char *)compressed_block.ptr, compressed_page_size);
 		if (duckdb_zstd::ZSTD_isError(res) || res != (size_t)uncompressed_page_size) {
 			throw std::runtime_error("ZSTD Decompression failure");
 		}
-		block = move(unpacked_block);
 		break;
 	}
 
@@ -248,6 +304,9 @@ void ColumnReader::PrepareDataPage(PageHeader &page_hdr) {
 
 idx_t ColumnReader::Read(uint64_t num_values, parquet_filter_t &filter, uint8_t *define_out, uint8_t *repeat_out,
                          Vector &result) {
+	if (pending_skips > 0) {
+		ApplyPendingSkips();
+	}
 	// we need to reset the location because multiple column readers share the same protocol
 	auto trans = (ThriftFileTransport *)protocol->getTransport().get();
 	trans->SetLocation(chunk_read_offset);
@@ -260,11 +319,23 @@ idx_t ColumnReader::Read(uint64_t num_values, parquet_filter_t &filter, uint8_t
 			PrepareRead(filter);
 		}
 
-		D_ASSERT(block);
 		auto read_now = MinValue<idx_t>(to_read, page_rows_available);
 
 		D_ASSERT(read_now <= STANDARD_VECTOR_SIZE);
 
+		if (page_skipped) {
+			// the page was skipped, none of its rows can pass the filters
+			for (idx_t i = 0; i < read_now; i++) {
+				filter[i + result_offset] = false;
+				FlatVector::SetNull(result, i + result_offset, true);
+			}
+			result_offset += read_now;
+			page_rows_available -= read_now;
+			to_read -= read_now;
+			continue;
+		}
+		D_ASSERT(block);
+
 		if (HasRepeats()) {
 			D_ASSERT(repeated_decoder);
 			repeated_decoder->GetBatch<uint8_t>((char *)repeat_out + result_offset, read_now);
@@ -306,6 +377,11 @@ idx_t ColumnReader::Read(uint64_t num_values, parquet_filter_t &filter, uint8_t
 }
 
 void ColumnReader::Skip(idx_t num_values) {
+	if (!HasRepeats()) {
+		// defer the skip, so consecutive skips can skip entire pages without decompressing them
+		pending_skips += num_values;
+		return;
+	}
 	dummy_define.zero();
 	dummy_repeat.zero();
 
@@ -315,6 +391,50 @@ void ColumnReader::Skip(idx_t num_values) {
 	D_ASSERT(values_read == num_values);
 }
 
+void ColumnReader::ApplyPendingSkips() {
+	auto to_skip = pending_skips;
+	pending_skips = 0;
+
+	auto trans = (ThriftFileTransport *)protocol->getTransport().get();
+	while (to_skip > 0) {
+		if (page_rows_available == 0) {
+			trans->SetLocation(chunk_read_offset);
+			PageHeader page_hdr;
+			page_hdr.read(protocol);
+			if (IsDataPage(page_hdr) && DataPageValueCount(page_hdr) <= to_skip) {
+				// the entire page is skipped
+				SkipPageData(page_hdr);
+				data_page_idx++;
+				to_skip -= DataPageValueCount(page_hdr);
+				group_rows_available -= DataPageValueCount(page_hdr);
+			} else {
+				// dictionary pages and pages that are only partially skipped are read as usual
+				ProcessPage(page_hdr);
+			}
+			chunk_read_offset = trans->GetLocation();
+			continue;
+		}
+		dummy_define.zero();
+		dummy_repeat.zero();
+
+		auto skip_now = MinValue<idx_t>(MinValue<idx_t>(to_skip, page_rows_available), STANDARD_VECTOR_SIZE);
+		auto values_read = ColumnReader::Read(skip_now, none_filter, (uint8_t *)dummy_define.ptr,
+		                                      (uint8_t *)dummy_repeat.ptr, dummy_result);
+		D_ASSERT(values_read == skip_now);
+		to_skip -= skip_now;
+	}
+}
+
+class ParquetStringVectorBuffer : public VectorBuffer {
+public:
+	explicit ParquetStringVectorBuffer(shared_ptr<ByteBuffer> buffer_p)
+	    : VectorBuffer(VectorBufferType::OPAQUE_BUFFER), buffer(move(buffer_p)) {
+	}
+
+private:
+	shared_ptr<ByteBuffer> buffer;
+};
+
 void StringColumnReader::VerifyString(const char *str_data, idx_t str_len) {
 	if (Type() != LogicalTypeId::VARCHAR) {
 		return;
@@ -329,7 +449,10 @@ void StringColumnReader::VerifyString(const char *str_data, idx_t str_len) {
 
 void StringColumnReader::Dictionary(shared_ptr<ByteBuffer> data, idx_t num_entries) {
 	dict = move(data);
-	dict_strings = unique_ptr<string_t[]>(new string_t[num_entries]);
+	// the dictionary strings are stored in the data of a vector, so they can be referenced by dictionary vectors
+	// the last entry of the vector is NULL, NULL values of the column refer to it
+	auto dict_buffer = make_buffer<VectorBuffer>((num_entries + 1) * sizeof(string_t));
+	dict_strings = (string_t *)dict_buffer->GetData();
 	for (idx_t dict_idx = 0; dict_idx < num_entries; dict_idx++) {
 		uint32_t str_len = dict->read<uint32_t>();
 		dict->available(str_len);
@@ -338,17 +461,83 @@ void StringColumnReader::Dictionary(shared_ptr<ByteBuffer> data, idx_t num_entri
 		dict_strings[dict_idx] = string_t(dict->ptr, str_len);
 		dict->inc(str_len);
 	}
+	dict_strings[num_entries] = string_t();
+	dict_size = num_entries;
+
+	dict_vector = make_unique<Vector>(Type(), (data_ptr_t)dict_strings);
+	auto &validity = FlatVector::Validity(*dict_vector);
+	validity.Initialize(num_entries + 1);
+	validity.SetInvalid(num_entries);
+	StringVector::AddBuffer(*dict_vector, move(dict_buffer));
+	StringVector::AddBuffer(*dict_vector, make_buffer<ParquetStringVectorBuffer>(dict));
 }
 
-class ParquetStringVectorBuffer : public VectorBuffer {
-public:
-	explicit ParquetStringVectorBuffer(shared_ptr<ByteBuffer> buffer_p)
-	    : VectorBuffer(VectorBufferType::OPAQUE_BUFFER), buffer(move(buffer_p)) {
+idx_t StringColumnReader::Read(uint64_t num_values, parquet_filter_t &filter, uint8_t *define_out,
+                               uint8_t *repeat_out, Vector &result) {
+	if (!dictionary_vectors) {
+		return ColumnReader::Read(num_values, filter, define_out, repeat_out, result);
 	}
+	// values from dictionary pages are emitted as a selection into the dictionary, as long as the read does not
+	// include values from plain pages
+	emit_dictionary = true;
+	dict_sel.Initialize(STANDARD_VECTOR_SIZE);
+	auto values_read = ColumnReader::Read(num_values, filter, define_out, repeat_out, result);
+	if (emit_dictionary) {
+		result.Slice(*dict_vector, dict_sel, values_read);
+		emit_dictionary = false;
+	}
+	return values_read;
+}
 
-private:
-	shared_ptr<ByteBuffer> buffer;
-};
+void StringColumnReader::Offsets(uint32_t *offsets, uint8_t *defines, uint64_t num_values, parquet_filter_t &filter,
+                                 idx_t result_offset, Vector &result) {
+	if (emit_dictionary && dict_size >= STANDARD_VECTOR_SIZE) {
+		// dictionary vectors can only refer to STANDARD_VECTOR_SIZE entries: large dictionaries are materialized
+		MaterializeDictionary(result_offset, result);
+		emit_dictionary = false;
+	}
+	if (!emit_dictionary) {
+		TemplatedColumnReader<string_t, StringParquetValueConversion>::Offsets(offsets, defines, num_values, filter,
+		                                                                      result_offset, result);
+		return;
+	}
+	// the rows that do not pass the filter are selected as well: that is cheaper than skipping them
+	idx_t offset_idx = 0;
+	for (idx_t row_idx = 0; row_idx < num_values; row_idx++) {
+		if (HasDefines() && defines[row_idx + result_offset] != max_define) {
+			dict_sel.set_index(row_idx + result_offset, dict_size);
+			continue;
+		}
+		auto offset = offsets[offset_idx++];
+		if (offset >= dict_size) {
+			throw std::runtime_error("Parquet file is likely corrupted, dictionary offset out of range");
+		}
+		dict_sel.set_index(row_idx + result_offset, offset);
+	}
+}
+
+void StringColumnReader::Plain(shared_ptr<ByteBuffer> plain_data, uint8_t *defines, uint64_t num_values,
+                               parquet_filter_t &filter, idx_t result_offset, Vector &result) {
+	if (emit_dictionary) {
+		// the read includes plain values: write the values of the previous dictionary pages to the result instead
+		MaterializeDictionary(result_offset, result);
+		emit_dictionary = false;
+	}
+	TemplatedColumnReader<string_t, StringParquetValueConversion>::Plain(move(plain_data), defines, num_values,
+	                                                                     filter, result_offset, result);
+}
+
+void StringColumnReader::MaterializeDictionary(idx_t count, Vector &result) {
+	auto result_ptr = FlatVector::GetData<string_t>(result);
+	for (idx_t row_idx = 0; row_idx < count; row_idx++) {
+		auto dict_idx = dict_sel.get_index(row_idx);
+		if (dict_idx == dict_size) {
+			FlatVector::SetNull(result, row_idx, true);
+		} else {
+			result_ptr[row_idx] = dict_strings[dict_idx];
+		}
+	}
+}
 
 void StringColumnReader::DictReference(Vector &result) {
 	StringVector::AddBuffer(result, make_buffer<ParquetStringVectorBuffer>(dict));
@@ -377,6 +566,60 @@ void StringParquetValueConversion::PlainSkip(ByteBuffer &plain_data, ColumnReade
 	plain_data.inc(str_len);
 }
 
+void StructColumnReader::SetProjection(const vector<vector<idx_t>> &child_paths) {
+	projected_children.assign(child_readers.size(), false);
+	vector<bool> entire_children(child_readers.size(), false);
+	vector<vector<vector<idx_t>>> grandchild_paths(child_readers.size());
+	for (auto &path : child_paths) {
+		D_ASSERT(!path.empty() && path[0] < child_readers.size());
+		projected_children[path[0]] = true;
+		if (path.size() == 1) {
+			entire_children[path[0]] = true;
+		} else {
+			grandchild_paths[path[0]].emplace_back(path.begin() + 1, path.end());
+		}
+	}
+	for (idx_t i = 0; i < child_readers.size(); i++) {
+		if (projected_children[i] && !entire_children[i]) {
+			D_ASSERT(child_readers[i]->Type().id() == LogicalTypeId::STRUCT);
+			((StructColumnReader &)*child_readers[i]).SetProjection(grandchild_paths[i]);
+		}
+	}
+}
+
+//! Emit NULL for a field that is not read, STRUCT fields keep their children so the shape of the vector is intact
+static void StructNullField(const LogicalType &type, Vector &result) {
+	if (type.id() != LogicalTypeId::STRUCT) {
+		result.Reference(Value(type));
+		return;
+	}
+	result.Initialize(type);
+	for (auto &child_type : type.child_types()) {
+		auto child = make_unique<Vector>();
+		StructNullField(child_type.second, *child);
+		StructVector::AddEntry(result, child_type.first, move(child));
+	}
+}
+
+idx_t StructColumnReader::Read(uint64_t num_values, parquet_filter_t &filter, uint8_t *define_out, uint8_t *repeat_out,
+                               Vector &result) {
+	result.Initialize(Type());
+
+	for (idx_t i = 0; i < Type().child_types().size(); i++) {
+		auto child_read = make_unique<Vector>();
+		if (!IsProjected(i)) {
+			StructNullField(Type().child_types()[i].second, *child_read);
+		} else {
+			child_read->Initialize(Type().child_types()[i].second);
+			auto child_num_values = child_readers[i]->Read(num_values, filter, define_out, repeat_out, *child_read);
+			D_ASSERT(child_num_values == num_values);
+		}
+		StructVector::AddEntry(result, Type().child_types()[i].first, move(child_read));
+	}
+
+	return num_values;
+}
+
 idx_t ListColumnReader::Read(uint64_t num_values, parquet_filter_t &filter, uint8_t *define_out, uint8_t *repeat_out,
                              Vector &result_out) {
 	if (!ListVector::HasEntry(result_out)) {
@@ -13,12 +13,14 @@
 #include "duckdb/common/types/string_type.hpp"
 #include "duckdb/common/types/chunk_collection.hpp"
 #include "duckdb/common/operator/cast_operators.hpp"
+#include "duckdb/planner/table_filter.hpp"
 
 namespace duckdb {
 
 using apache::thrift::protocol::TProtocol;
 
 using parquet::format::ColumnChunk;
+using parquet::format::ColumnIndex;
 using parquet::format::FieldRepetitionType;
 using parquet::format::PageHeader;
 using parquet::format::SchemaElement;
@@ -34,7 +36,8 @@ public:
 	ColumnReader(LogicalType type_p, const SchemaElement &schema_p, idx_t file_idx_p, idx_t max_define_p,
 	             idx_t max_repeat_p)
 	    : schema(schema_p), file_idx(file_idx_p), max_define(max_define_p), max_repeat(max_repeat_p), type(type_p),
-	      page_rows_available(0) {
+	      page_rows_available(0), page_filters(nullptr), page_skipped(false), data_page_idx(0),
+	      pending_skips(0) {
 
 		// dummies for Skip()
 		dummy_result.Initialize(Type());
@@ -61,6 +64,18 @@ public:
 			chunk_read_offset = chunk->meta_data.dictionary_page_offset;
 		}
 		group_rows_available = chunk->meta_data.num_values;
+		page_rows_available = 0;
+		data_page_idx = 0;
+		pending_skips = 0;
+
+		// the column index holds the statistics of all data pages of the chunk, read it if we can use it
+		column_index.reset();
+		if (page_filters && !HasRepeats() && chunk->__isset.column_index_offset) {
+			auto trans = (ThriftFileTransport *)protocol->getTransport().get();
+			trans->SetLocation(chunk->column_index_offset);
+			column_index = make_unique<ColumnIndex>();
+			column_index->read(protocol);
+		}
 	}
 
 	virtual ~ColumnReader();
@@ -79,7 +94,23 @@ public:
 	}
 
 	virtual idx_t GroupRowsAvailable() {
-		return group_rows_available;
+		return group_rows_available - pending_skips;
+	}
+
+	//! Add the byte range of the column chunk in the current row group, so it can be prefetched
+	virtual void RegisterPrefetch(vector<pair<idx_t, idx_t>> &ranges) {
+		ranges.emplace_back(chunk_read_offset, chunk->meta_data.total_compressed_size);
+	}
+
+	//! Set the filters of this column, data pages whose statistics show that none of their values can pass the
+	//! filters are skipped without being decompressed. The rows of skipped pages are removed from the filter mask.
+	void SetPageFilters(vector<TableFilter> *page_filters_p) {
+		page_filters = page_filters_p;
+	}
+
+	//! Allow the reader to emit the values of dictionary-encoded pages as dictionary vectors
+	void EnableDictionaryVectors() {
+		dictionary_vectors = true;
 	}
 
 	unique_ptr<BaseStatistics> Stats(const std::vector<ColumnChunk> &columns) {
@@ -124,11 +155,16 @@ protected:
 	idx_t file_idx;
 	idx_t max_define;
 	idx_t max_repeat;
+	bool dictionary_vectors = false;
 
 private:
 	void PrepareRead(parquet_filter_t &filter);
+	void ProcessPage(PageHeader &page_hdr);
 	void PreparePage(idx_t compressed_page_size, idx_t uncompressed_page_size);
 	void PrepareDataPage(PageHeader &page_hdr);
+	bool PageCanBeSkipped(PageHeader &page_hdr, idx_t page_idx);
+	void SkipPageData(PageHeader &page_hdr);
+	void ApplyPendingSkips();
 
 	LogicalType type;
 	const parquet::format::ColumnChunk *chunk;
@@ -138,7 +174,21 @@ private:
 	idx_t group_rows_available;
 	idx_t chunk_read_offset;
 
+	//! The filters of this column, if any
+	vector<TableFilter> *page_filters;
+	//! Whether or not the current page was skipped because none of its values can pass the filters
+	bool page_skipped;
+	//! The index of the next data page within the column chunk
+	idx_t data_page_idx;
+	//! The page statistics of the column chunk, if the file has a column index
+	unique_ptr<ColumnIndex> column_index;
+	//! The amount of values that were skipped but not read yet
+	idx_t pending_skips;
+
+	//! The (uncompressed) data of the current page, reused for the next page unless a vector still references it
 	shared_ptr<ResizeableBuffer> block;
+	//! The compressed data of the current page
+	ResizeableBuffer compressed_block;
 
 	ResizeableBuffer offset_buffer;
 
@@ -244,14 +294,31 @@ public:
 	    : TemplatedColumnReader<string_t, StringParquetValueConversion>(type_p, schema_p, schema_idx_p, max_define_p,
 	                                                                    max_repeat_p) {};
 
+	idx_t Read(uint64_t num_values, parquet_filter_t &filter, uint8_t *define_out, uint8_t *repeat_out,
+	           Vector &result) override;
+
 	void Dictionary(shared_ptr<ByteBuffer> dictionary_data, idx_t num_entries) override;
 
-	unique_ptr<string_t[]> dict_strings;
+	string_t *dict_strings = nullptr;
 	void VerifyString(const char *str_data, idx_t str_len);
 
 protected:
+	void Offsets(uint32_t *offsets, uint8_t *defines, uint64_t num_values, parquet_filter_t &filter,
+	             idx_t result_offset, Vector &result) override;
+	void Plain(shared_ptr<ByteBuffer> plain_data, uint8_t *defines, uint64_t num_values, parquet_filter_t &filter,
+	           idx_t result_offset, Vector &result) override;
 	void DictReference(Vector &result) override;
 	void PlainReference(shared_ptr<ByteBuffer> plain_data, Vector &result) override;
+
+private:
+	//! The dictionary strings of the column chunk, followed by a NULL entry
+	unique_ptr<Vector> dict_vector;
+	idx_t dict_size = 0;
+	//! Whether the current read emits a dictionary vector, and the selection into the dictionary if it does
+	bool emit_dictionary = false;
+	SelectionVector dict_sel;
+
+	void MaterializeDictionary(idx_t count, Vector &result);
 };
 
 template <class DUCKDB_PHYSICAL_TYPE>
@@ -398,36 +465,54 @@ public:
 		return child_readers[child_idx].get();
 	}
 
+	//! Only read the (nested) fields at the given child paths, the other fields are emitted as NULL
+	void SetProjection(const vector<vector<idx_t>> &child_paths);
+
 	void IntializeRead(const std::vector<ColumnChunk> &columns, TProtocol &protocol_p) override {
-		for (auto &child : child_readers) {
-			child->IntializeRead(columns, protocol_p);
+		for (idx_t i = 0; i < child_readers.size(); i++) {
+			if (IsProjected(i)) {
+				child_readers[i]->IntializeRead(columns, protocol_p);
+			}
 		}
 	}
 
 	idx_t Read(uint64_t num_values, parquet_filter_t &filter, uint8_t *define_out, uint8_t *repeat_out,
-	           Vector &result) override {
-		result.Initialize(Type());
-
-		for (idx_t i = 0; i < Type().child_types().size(); i++) {
-			auto child_read = make_unique<Vector>();
-			child_read->Initialize(Type().child_types()[i].second);
-			auto child_num_values = child_readers[i]->Read(num_values, filter, define_out, repeat_out, *child_read);
-			D_ASSERT(child_num_values == num_values);
-			StructVector::AddEntry(result, Type().child_types()[i].first, move(child_read));
-		}
-
-		return num_values;
-	}
+	           Vector &result) override;
 
 	virtual void Skip(idx_t num_values) override {
-		D_ASSERT(0);
+		for (idx_t i = 0; i < child_readers.size(); i++) {
+			if (IsProjected(i)) {
+				child_readers[i]->Skip(num_values);
+			}
+		}
 	}
 
 	idx_t GroupRowsAvailable() override {
-		return child_readers[0]->GroupRowsAvailable();
+		for (idx_t i = 0; i < child_readers.size(); i++) {
+			if (IsProjected(i)) {
+				return child_readers[i]->GroupRowsAvailable();
+			}
+		}
+		throw InternalException("No projected fields in struct");
+	}
+
+	void RegisterPrefetch(vector<pair<idx_t, idx_t>> &ranges) override {
+		for (idx_t i = 0; i < child_readers.size(); i++) {
+			if (IsProjected(i)) {
+				child_readers[i]->RegisterPrefetch(ranges);
+			}
+		}
 	}
 
 	vector<unique_ptr<ColumnReader>> child_readers;
+
+private:
+	bool IsProjected(idx_t child_idx) {
+		return projected_children.empty() || projected_children[child_idx];
+	}
+
+	//! The children that are read, all children are read if this is empty
+	vector<bool> projected_children;
 };
 
 class ListColumnReader : public ColumnReader {
@@ -467,6 +552,10 @@ public:
 		return child_column_reader->GroupRowsAvailable();
 	}
 
+	void RegisterPrefetch(vector<pair<idx_t, idx_t>> &ranges) override {
+		child_column_reader->RegisterPrefetch(ranges);
+	}
+
 private:
 	unique_ptr<ColumnReader> child_column_reader;
 	ResizeableBuffer child_defines;
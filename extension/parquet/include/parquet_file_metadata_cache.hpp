@@ -7,18 +7,24 @@
 //===----------------------------------------------------------------------===//
 #pragma once
 
+#include "duckdb/common/serializer/buffered_serializer.hpp"
 #include "duckdb/storage/object_cache.hpp" // ObjectCache
-#include "parquet_types.h"                 // parquet::format::FileMetaData
+#include "duckdb/storage/statistics/base_statistics.hpp"
+#include "parquet_types.h" // parquet::format::FileMetaData
 
 namespace duckdb {
+class BufferedDeserializer;
+class ClientContext;
+class FileSystem;
 
 //! ParquetFileMetadataCache
 class ParquetFileMetadataCache : public ObjectCacheEntry {
 public:
 	ParquetFileMetadataCache() : metadata(nullptr) {
 	}
-	ParquetFileMetadataCache(std::unique_ptr<parquet::format::FileMetaData> file_metadata, time_t r_time)
-	    : metadata(std::move(file_metadata)), read_time(r_time) {
+	ParquetFileMetadataCache(std::unique_ptr<parquet::format::FileMetaData> file_metadata, time_t r_time,
+	                         idx_t file_size, time_t last_modified)
+	    : metadata(std::move(file_metadata)), read_time(r_time), file_size(file_size), last_modified(last_modified) {
 	}
 
 	~ParquetFileMetadataCache() override = default;
@@ -28,5 +34,109 @@ public:
 
 	//! read time
 	time_t read_time;
+	//! The size and the last modification time of the file when the metadata was read
+	idx_t file_size;
+	time_t last_modified;
+
+public:
+	//! The modification time of a file has a granularity of (at best) one second, and is even coarser on some file
+	//! systems (e.g. two seconds on FAT, and network file systems may cache the attributes of a file for several
+	//! seconds). A file that is modified again shortly after the metadata was read can therefore keep its modification
+	//! time, so metadata is only trusted if it was read at least this many seconds after the last modification.
+	static constexpr time_t MODIFICATION_TIME_GRANULARITY = 10;
+
+	//! Whether the metadata is current for a file with the given size and modification time
+	bool IsCurrent(idx_t file_size_p, time_t last_modified_p) const {
+		return file_size == file_size_p && last_modified == last_modified_p &&
+		       read_time > last_modified + MODIFICATION_TIME_GRANULARITY;
+	}
+
+	//! Returns the cached metadata of a file from the object cache or the on-disk metadata cache, or nullptr if the
+	//! file has no current metadata cached
+	static shared_ptr<ParquetFileMetadataCache> Get(ClientContext &context, const string &file_name, idx_t file_size,
+	                                                time_t last_modified);
+	//! Cache the metadata of a file in the object cache and the on-disk metadata cache, if they are enabled
+	static void Put(ClientContext &context, const string &file_name, shared_ptr<ParquetFileMetadataCache> metadata);
 };
+
+//! The merged statistics of the columns of a set of Parquet files, which spares reading the metadata of every file
+//! when a glob is planned again
+class ParquetGlobStatistics : public ObjectCacheEntry {
+public:
+	~ParquetGlobStatistics() override = default;
+
+	vector<string> files;
+	vector<idx_t> file_sizes;
+	vector<time_t> last_modified;
+	//! The read time of the oldest metadata the statistics were merged from
+	time_t read_time = 0;
+	//! The statistics of every column, or nullptr if a column has no statistics
+	vector<unique_ptr<BaseStatistics>> column_statistics;
+
+public:
+	//! Whether the statistics are current for the given files, which uses the same modification time granularity
+	//! guard as ParquetFileMetadataCache::IsCurrent for every file
+	bool IsCurrent(const vector<string> &files_p, const vector<idx_t> &file_sizes_p,
+	               const vector<time_t> &last_modified_p) const {
+		if (files != files_p || file_sizes != file_sizes_p || last_modified != last_modified_p) {
+			return false;
+		}
+		for (auto &file_last_modified : last_modified) {
+			if (read_time <= file_last_modified + ParquetFileMetadataCache::MODIFICATION_TIME_GRANULARITY) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	static string CacheKey(const vector<string> &files);
+	//! Returns the cached statistics of a set of files from the object cache or the on-disk metadata cache
+	static shared_ptr<ParquetGlobStatistics> Get(ClientContext &context, const vector<string> &files,
+	                                             const vector<idx_t> &file_sizes, const vector<time_t> &last_modified,
+	                                             const vector<LogicalType> &types);
+	static void Put(ClientContext &context, shared_ptr<ParquetGlobStatistics> statistics);
+};
+
+//! The on-disk metadata cache, which keeps the metadata of Parquet files and the statistics of globs across restarts.
+//! It is enabled by setting parquet_metadata_cache_directory. Once the files in the directory exceed
+//! parquet_metadata_cache_size bytes, the least recently used files are removed.
+class ParquetMetadataDiskCache {
+public:
+	static constexpr idx_t DEFAULT_SIZE_LIMIT = 128 * 1024 * 1024;
+	//! Every file of the cache starts with a magic number and the version of the format of the cache files. Files
+	//! with a different magic number or version (e.g. written by another version of the extension) are cache misses
+	static constexpr uint32_t MAGIC_NUMBER = 0x434D5150; // "PQMC"
+	static constexpr uint32_t FORMAT_VERSION = 2;
+
+	//! Returns the directory of the on-disk cache, or an empty string if it is disabled
+	static string GetDirectory(ClientContext &context);
+	//! Returns the maximum total size of the files in the cache directory
+	static idx_t GetSizeLimit(ClientContext &context);
+
+	static shared_ptr<ParquetFileMetadataCache> ReadMetadata(FileSystem &fs, const string &directory,
+	                                                         const string &file_name);
+	static void WriteMetadata(FileSystem &fs, const string &directory, idx_t size_limit, const string &file_name,
+	                          ParquetFileMetadataCache &metadata);
+
+	static shared_ptr<ParquetGlobStatistics> ReadStatistics(FileSystem &fs, const string &directory,
+	                                                        const string &key, const vector<LogicalType> &types);
+	static void WriteStatistics(FileSystem &fs, const string &directory, idx_t size_limit, const string &key,
+	                            ParquetGlobStatistics &statistics);
+
+private:
+	static string CachePath(FileSystem &fs, const string &directory, const string &key, const string &extension);
+	//! Write the magic number and the format version
+	static void WriteHeader(BufferedSerializer &serializer);
+	//! Read the magic number and the format version, returns false if they do not match
+	static bool ReadHeader(BufferedDeserializer &source);
+	//! Write the file atomically, so concurrent readers never observe a partially written cache entry. Failures are
+	//! ignored.
+	static void WriteFile(FileSystem &fs, const string &path, idx_t size_limit, BufferedSerializer &serializer);
+	static bool ReadFile(FileSystem &fs, const string &path, unique_ptr<data_t[]> &data, idx_t &size);
+	//! Mark a file of the cache directory as most recently used
+	static void TouchFile(FileSystem &fs, const string &path, idx_t size);
+	//! Remove the least recently used files of the cache directory until they fit in the size limit
+	static void EvictFiles(FileSystem &fs, const string &directory, idx_t size_limit);
+};
+
 } // namespace duckdb
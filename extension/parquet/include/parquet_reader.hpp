@@ -33,6 +33,21 @@ class ChunkCollection;
 class BaseStatistics;
 struct TableFilterSet;
 
+//! Filters on a (nested) field of a STRUCT column, which are used to skip row groups
+struct ParquetStructFilter {
+	column_t column_id;
+	//! The indexes of the fields from the outermost struct inwards
+	vector<idx_t> child_path;
+	vector<TableFilter> filters;
+};
+
+//! The projections and filters on the fields of STRUCT columns that are pushed into the scan
+struct ParquetStructPushdown {
+	//! The child paths of the fields that are read, for the STRUCT columns that are not read entirely
+	unordered_map<column_t, vector<vector<idx_t>>> projections;
+	vector<ParquetStructFilter> filters;
+};
+
 struct ParquetReaderScanState {
 	vector<idx_t> group_idx_list;
 	int64_t current_group;
@@ -43,6 +58,7 @@ struct ParquetReaderScanState {
 
 	bool finished;
 	TableFilterSet *filters;
+	const ParquetStructPushdown *struct_pushdown;
 	SelectionVector sel;
 
 	ResizeableBuffer define_buf;
@@ -61,10 +77,12 @@ public:
 	vector<LogicalType> return_types;
 	vector<string> names;
 	shared_ptr<ParquetFileMetadataCache> metadata;
+	//! The values of the hive partition columns, which follow the columns of the file
+	vector<Value> partition_values;
 
 public:
 	void Initialize(ParquetReaderScanState &state, vector<column_t> column_ids, vector<idx_t> groups_to_read,
-	                TableFilterSet *table_filters);
+	                TableFilterSet *table_filters, const ParquetStructPushdown *struct_pushdown = nullptr);
 	void Scan(ParquetReaderScanState &state, DataChunk &output);
 
 	idx_t NumRows();
@@ -80,6 +98,14 @@ private:
 
 	const parquet::format::RowGroup &GetGroup(ParquetReaderScanState &state);
 	void PrepareRowGroupBuffer(ParquetReaderScanState &state, idx_t out_col_idx);
+	//! Returns whether the current row group can contain rows that pass the filters on the fields of STRUCT columns
+	bool CheckStructFilters(ParquetReaderScanState &state);
+	//! Returns whether the column is read from the file, rather than being constant for the whole file (the row id or
+	//! a hive partition column)
+	bool IsFileColumn(column_t column_id) {
+		return column_id < return_types.size();
+	}
+	Value GetConstantColumnValue(column_t column_id);
 
 	template <typename... Args>
 	std::runtime_error FormatException(const string fmt_str, Args... params) {
@@ -0,0 +1,103 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// parquet_rle_bp_encoder.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/common/common.hpp"
+#include "duckdb/common/serializer.hpp"
+
+namespace duckdb {
+
+//! Encodes values using the RLE/bit-packing hybrid encoding of Parquet, which is used for the definition levels and
+//! the dictionary indices of a data page. Repeated values are written as RLE runs, other values are bit-packed in
+//! groups of 8.
+class RleBpEncoder {
+public:
+	explicit RleBpEncoder(uint32_t bit_width)
+	    : bit_width(bit_width), byte_width((bit_width + 7) / 8) {
+		D_ASSERT(bit_width > 0 && bit_width <= 32);
+	}
+
+	//! Encode the values and write them to the serializer
+	template <class T>
+	void Encode(Serializer &ser, const T *values, idx_t count) {
+		// the start of the values that have not been written yet, these are written as bit-packed literals
+		idx_t literal_start = 0;
+		idx_t i = 0;
+		while (i < count) {
+			idx_t run_end = i + 1;
+			while (run_end < count && values[run_end] == values[i]) {
+				run_end++;
+			}
+			// literal runs must consist of a multiple of 8 values: pad them with the values of the repeated run
+			idx_t literal_count = i - literal_start;
+			idx_t padding = (8 - literal_count % 8) % 8;
+			if (run_end - i >= padding + MINIMUM_RLE_RUN) {
+				i += padding;
+				WriteLiterals(ser, values + literal_start, i - literal_start);
+				WriteRun(ser, values[i], run_end - i);
+				literal_start = run_end;
+			}
+			i = run_end;
+		}
+		WriteLiterals(ser, values + literal_start, count - literal_start);
+	}
+
+private:
+	//! The minimum length of a run of repeated values that is written as RLE run
+	static constexpr idx_t MINIMUM_RLE_RUN = 8;
+
+	uint32_t bit_width;
+	uint32_t byte_width;
+
+	static void WriteVarint(Serializer &ser, uint32_t val) {
+		do {
+			uint8_t byte = val & 127;
+			val >>= 7;
+			if (val != 0) {
+				byte |= 128;
+			}
+			ser.Write<uint8_t>(byte);
+		} while (val != 0);
+	}
+
+	template <class T>
+	void WriteRun(Serializer &ser, T value, idx_t count) {
+		WriteVarint(ser, count << 1);
+		// the value is stored little-endian in the minimum amount of bytes
+		auto run_value = (uint32_t)value;
+		for (idx_t byte_idx = 0; byte_idx < byte_width; byte_idx++) {
+			ser.Write<uint8_t>((run_value >> (byte_idx * 8)) & 0xFF);
+		}
+	}
+
+	template <class T>
+	void WriteLiterals(Serializer &ser, const T *values, idx_t count) {
+		if (count == 0) {
+			return;
+		}
+		// the final group of 8 is padded with zeros
+		idx_t group_count = (count + 7) / 8;
+		WriteVarint(ser, (group_count << 1) | 1);
+		uint64_t buffer = 0;
+		uint32_t buffered_bits = 0;
+		for (idx_t i = 0; i < group_count * 8; i++) {
+			uint64_t value = i < count ? (uint32_t)values[i] : 0;
+			buffer |= value << buffered_bits;
+			buffered_bits += bit_width;
+			while (buffered_bits >= 8) {
+				ser.Write<uint8_t>(buffer & 0xFF);
+				buffer >>= 8;
+				buffered_bits -= 8;
+			}
+		}
+		D_ASSERT(buffered_bits == 0);
+	}
+};
+
+} // namespace duckdb
@@ -9,8 +9,16 @@ using parquet::format::ColumnChunk;
 using parquet::format::SchemaElement;
 
 struct LogicalType;
+struct TableFilter;
 
 unique_ptr<BaseStatistics> ParquetTransformColumnStatistics(const SchemaElement &s_ele, const LogicalType &type,
                                                             const ColumnChunk &column_chunk);
 
+//! Transform the statistics of a column chunk or of a single page
+unique_ptr<BaseStatistics> ParquetTransformStatistics(const SchemaElement &s_ele, const LogicalType &type,
+                                                      const parquet::format::Statistics &parquet_stats);
+
+//! Returns false if the statistics prove that none of the values can satisfy all of the filters
+bool ParquetCheckZonemap(BaseStatistics &stats, const vector<TableFilter> &filters);
+
 } // namespace duckdb
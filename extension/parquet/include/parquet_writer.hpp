@@ -12,6 +12,7 @@
 #include "duckdb/common/exception.hpp"
 #include "duckdb/common/mutex.hpp"
 #include "duckdb/common/serializer/buffered_file_writer.hpp"
+#include "duckdb/common/serializer/buffered_serializer.hpp"
 #include "duckdb/common/types/chunk_collection.hpp"
 
 #include "parquet_types.h"
@@ -20,15 +21,32 @@
 namespace duckdb {
 class FileSystem;
 
+//! A row group that has been encoded and compressed, but that has not been written to the file yet
+struct PreparedRowGroup {
+	parquet::format::RowGroup row_group;
+	//! The pages of all the column chunks of the row group
+	BufferedSerializer data;
+};
+
 class ParquetWriter {
 public:
 	ParquetWriter(FileSystem &fs, string file_name, vector<LogicalType> types, vector<string> names,
 	              parquet::format::CompressionCodec::type codec);
 
 public:
+	//! Encode and compress the row group, this does not touch the file and can run on many threads concurrently
+	void PrepareRowGroup(ChunkCollection &buffer, PreparedRowGroup &result);
+	//! Append a prepared row group to the file
+	void FlushRowGroup(PreparedRowGroup &row_group);
+	//! Prepare and flush a row group
 	void Flush(ChunkCollection &buffer);
 	void Finalize();
 
+private:
+	//! Compress the page and write it to the target, returns the uncompressed size of the page (including the header)
+	idx_t WritePage(parquet::format::PageHeader &hdr, BufferedSerializer &page_data, BufferedSerializer &target,
+	                apache::thrift::protocol::TProtocol &target_protocol);
+
 private:
 	string file_name;
 	vector<LogicalType> sql_types;
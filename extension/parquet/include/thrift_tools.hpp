@@ -25,6 +25,11 @@ public:
 		return location;
 	}
 
+	//! Hint that the (location, length) ranges of the file are about to be read
+	void Prefetch(const vector<pair<idx_t, idx_t>> &ranges) {
+		handle->Prefetch(ranges);
+	}
+
 private:
 	unique_ptr<duckdb::FileHandle> handle;
 	duckdb::idx_t location;
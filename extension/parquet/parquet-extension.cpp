@@ -12,7 +12,17 @@
 #include "duckdb/function/copy_function.hpp"
 #include "duckdb/function/table_function.hpp"
 #include "duckdb/common/file_system.hpp"
+#include "duckdb/execution/expression_executor.hpp"
+#include "duckdb/execution/operator/persistent/physical_copy_to_file.hpp"
+#include "duckdb/function/scalar/nested_functions.hpp"
 #include "duckdb/parallel/parallel_state.hpp"
+#include "duckdb/planner/expression/bound_between_expression.hpp"
+#include "duckdb/planner/expression/bound_columnref_expression.hpp"
+#include "duckdb/planner/expression/bound_comparison_expression.hpp"
+#include "duckdb/planner/expression/bound_constant_expression.hpp"
+#include "duckdb/planner/expression/bound_reference_expression.hpp"
+#include "duckdb/planner/expression_iterator.hpp"
+#include "duckdb/planner/operator/logical_get.hpp"
 #include "duckdb/parser/parsed_data/create_copy_function_info.hpp"
 #include "duckdb/parser/parsed_data/create_table_function_info.hpp"
 
@@ -26,7 +36,17 @@ namespace duckdb {
 struct ParquetReadBindData : public FunctionData {
 	shared_ptr<ParquetReader> initial_reader;
 	vector<string> files;
+	//! The size and the last modification time of every file as found by the glob, or empty if they are not known
+	vector<FileInfo> file_info;
 	vector<column_t> column_ids;
+	//! The names of the hive partition columns, which follow the columns of the files
+	vector<string> partition_names;
+	//! The values of the hive partition columns of every file
+	vector<vector<Value>> partition_values;
+	//! The statistics of the columns of the files, which are gathered when they are first requested
+	shared_ptr<ParquetGlobStatistics> statistics;
+	//! The projections and filters on the fields of STRUCT columns
+	ParquetStructPushdown struct_pushdown;
 };
 
 struct ParquetReadOperatorData : public FunctionOperatorData {
@@ -51,8 +71,10 @@ public:
 	    : TableFunction("parquet_scan", {LogicalType::VARCHAR}, ParquetScanImplementation, ParquetScanBind,
 	                    ParquetScanInit, /* statistics */ ParquetScanStats, /* cleanup */ nullptr,
 	                    /* dependency */ nullptr, ParquetCardinality,
-	                    /* pushdown_complex_filter */ nullptr, /* to_string */ nullptr, ParquetScanMaxThreads,
+	                    ParquetComplexFilterPushdown, /* to_string */ nullptr, ParquetScanMaxThreads,
 	                    ParquetInitParallelState, ParquetScanParallelInit, ParquetParallelStateNext) {
+		named_parameters["hive_partitioning"] = LogicalType::BOOLEAN;
+		pushdown_struct_projection = ParquetStructProjectionPushdown;
 		projection_pushdown = true;
 		filter_pushdown = true;
 	}
@@ -66,7 +88,9 @@ public:
 		auto result = make_unique<ParquetReadBindData>();
 
 		FileSystem &fs = FileSystem::GetFileSystem(context);
-		result->files = fs.Glob(info.file_path);
+		if (!fs.GlobFileInfo(info.file_path, result->files, result->file_info)) {
+			result->files = fs.Glob(info.file_path);
+		}
 		if (result->files.empty()) {
 			throw IOException("No files found that match the pattern \"%s\"", info.file_path);
 		}
@@ -78,62 +102,122 @@ public:
 	                                                   column_t column_index) {
 		auto &bind_data = (ParquetReadBindData &)*bind_data_p;
 
-		if (column_index == COLUMN_IDENTIFIER_ROW_ID) {
+		if (column_index == COLUMN_IDENTIFIER_ROW_ID || column_index >= bind_data.initial_reader->return_types.size()) {
+			// no statistics for the row id and the hive partition columns
 			return nullptr;
 		}
 
-		// we do not want to parse the Parquet metadata for the sole purpose of getting column statistics
-
-		// We already parsed the metadata for the first file in a glob because we need some type info.
-		auto overall_stats =
-		    ParquetReader::ReadStatistics(bind_data.initial_reader->return_types[column_index], column_index,
-		                                  bind_data.initial_reader->metadata->metadata.get());
-
-		if (!overall_stats) {
-			return nullptr;
+		if (!bind_data.statistics) {
+			// the statistics of all columns are gathered at once, so the files are only visited once per query
+			bind_data.statistics = GetGlobStatistics(context, bind_data);
 		}
+		auto &column_statistics = bind_data.statistics->column_statistics[column_index];
+		return column_statistics ? column_statistics->Copy() : nullptr;
+	}
+
+	//! Returns the merged statistics of the columns of all files
+	static shared_ptr<ParquetGlobStatistics> GetGlobStatistics(ClientContext &context,
+	                                                           const ParquetReadBindData &bind_data) {
+		auto &initial_reader = *bind_data.initial_reader;
+		auto &types = initial_reader.return_types;
+		auto result = make_shared<ParquetGlobStatistics>();
+		result->column_statistics.resize(types.size());
 
+		// we do not want to parse the Parquet metadata for the sole purpose of getting column statistics
+		// We already parsed the metadata for the first file in a glob because we need some type info.
 		// if there is only one file in the glob (quite common case), we are done
-		auto &config = DBConfig::GetConfig(context);
-		if (bind_data.files.size() < 2) {
-			return overall_stats;
-		} else if (config.object_cache_enable) {
-			auto &cache = ObjectCache::GetObjectCache(context);
-			// for more than one file, we could be lucky and metadata for *every* file is in the object cache (if
-			// enabled at all)
-			FileSystem &fs = FileSystem::GetFileSystem(context);
-			for (idx_t file_idx = 1; file_idx < bind_data.files.size(); file_idx++) {
-				auto &file_name = bind_data.files[file_idx];
-				auto metadata = std::dynamic_pointer_cast<ParquetFileMetadataCache>(cache.Get(file_name));
-				auto handle = fs.OpenFile(file_name, FileFlags::FILE_FLAGS_READ);
-				// but we need to check if the metadata cache entries are current
-				if (!metadata || (fs.GetLastModifiedTime(*handle) >= metadata->read_time)) {
-					// missing or invalid metadata entry in cache, no usable stats overall
-					return nullptr;
+		// (the first file may have been pruned using the hive partitions though)
+		if (bind_data.files.size() == 1 && bind_data.files[0] == initial_reader.file_name) {
+			for (idx_t col_idx = 0; col_idx < types.size(); col_idx++) {
+				result->column_statistics[col_idx] =
+				    ParquetReader::ReadStatistics(types[col_idx], col_idx, initial_reader.metadata->metadata.get());
+			}
+			return result;
+		}
+		if (bind_data.files.empty() ||
+		    (!ObjectCache::ObjectCacheEnabled(context) && ParquetMetadataDiskCache::GetDirectory(context).empty())) {
+			// we have more than one file and no metadata cache so no statistics overall
+			return result;
+		}
+		if (bind_data.file_info.size() != bind_data.files.size()) {
+			// we cannot tell whether the cache entries are current without opening every file
+			return result;
+		}
+		// for more than one file, we could be lucky and the statistics of this glob, or the metadata for *every* file
+		// is cached: the cache entries are checked against the file info found by the glob
+		vector<idx_t> file_sizes;
+		vector<time_t> last_modified;
+		for (auto &file_info : bind_data.file_info) {
+			file_sizes.push_back(file_info.file_size);
+			last_modified.push_back(file_info.last_modified);
+		}
+		auto cached_statistics = ParquetGlobStatistics::Get(context, bind_data.files, file_sizes, last_modified, types);
+		if (cached_statistics) {
+			return cached_statistics;
+		}
+		vector<bool> missing_statistics(types.size(), false);
+		time_t read_time = 0;
+		for (idx_t file_idx = 0; file_idx < bind_data.files.size(); file_idx++) {
+			auto &file_name = bind_data.files[file_idx];
+			auto metadata = file_name == initial_reader.file_name
+			                    ? initial_reader.metadata
+			                    : ParquetFileMetadataCache::Get(context, file_name, file_sizes[file_idx],
+			                                                    last_modified[file_idx]);
+			if (!metadata) {
+				// missing or invalid metadata entry in cache, no usable stats overall
+				for (auto &column_statistics : result->column_statistics) {
+					column_statistics.reset();
+				}
+				return result;
+			}
+			if (file_idx == 0 || metadata->read_time < read_time) {
+				read_time = metadata->read_time;
+			}
+			// get and merge stats for file
+			for (idx_t col_idx = 0; col_idx < types.size(); col_idx++) {
+				if (missing_statistics[col_idx]) {
+					continue;
 				}
-				// get and merge stats for file
-				auto file_stats = ParquetReader::ReadStatistics(bind_data.initial_reader->return_types[column_index],
-				                                                column_index, metadata->metadata.get());
+				auto file_stats = ParquetReader::ReadStatistics(types[col_idx], col_idx, metadata->metadata.get());
+				auto &overall_stats = result->column_statistics[col_idx];
 				if (!file_stats) {
-					return nullptr;
+					missing_statistics[col_idx] = true;
+					overall_stats.reset();
+				} else if (!overall_stats) {
+					overall_stats = move(file_stats);
+				} else {
+					overall_stats->Merge(*file_stats);
 				}
-				overall_stats->Merge(*file_stats);
 			}
-			// success!
-			return overall_stats;
 		}
-		// we have more than one file and no object cache so no statistics overall
-		return nullptr;
+		// success! cache the statistics of this glob, unless a file was modified too recently for the cache entry to
+		// ever be considered current
+		result->files = bind_data.files;
+		result->file_sizes = move(file_sizes);
+		result->last_modified = move(last_modified);
+		result->read_time = read_time;
+		if (result->IsCurrent(result->files, result->file_sizes, result->last_modified)) {
+			ParquetGlobStatistics::Put(context, result);
+		}
+		return result;
 	}
 
 	static unique_ptr<FunctionData> ParquetScanBind(ClientContext &context, vector<Value> &inputs,
 	                                                unordered_map<string, Value> &named_parameters,
 	                                                vector<LogicalType> &return_types, vector<string> &names) {
 		auto file_name = inputs[0].GetValue<string>();
+		bool hive_partitioning = false;
+		for (auto &kv : named_parameters) {
+			if (kv.first == "hive_partitioning") {
+				hive_partitioning = kv.second.GetValue<bool>();
+			}
+		}
 		auto result = make_unique<ParquetReadBindData>();
 
 		FileSystem &fs = FileSystem::GetFileSystem(context);
-		result->files = fs.Glob(file_name);
+		if (!fs.GlobFileInfo(file_name, result->files, result->file_info)) {
+			result->files = fs.Glob(file_name);
+		}
 		if (result->files.empty()) {
 			throw IOException("No files found that match the pattern \"%s\"", file_name);
 		}
@@ -142,9 +226,247 @@ public:
 		return_types = result->initial_reader->return_types;
 
 		names = result->initial_reader->names;
+		if (hive_partitioning) {
+			BindHivePartitions(*result, return_types, names);
+		}
 		return move(result);
 	}
 
+	//! Parse the key=value directories in the path of a file, e.g. "year=2021/month=3/data.parquet"
+	static vector<pair<string, string>> ParseHivePartitions(const string &file_name) {
+		vector<pair<string, string>> partitions;
+		idx_t start = 0;
+		for (idx_t i = 0; i < file_name.size(); i++) {
+			if (file_name[i] != '/' && file_name[i] != '\\') {
+				continue;
+			}
+			// the component [start, i) is a directory
+			auto directory = file_name.substr(start, i - start);
+			auto separator = directory.find('=');
+			if (separator != string::npos && separator > 0) {
+				partitions.emplace_back(directory.substr(0, separator), directory.substr(separator + 1));
+			}
+			start = i + 1;
+		}
+		return partitions;
+	}
+
+	//! Add the hive partitions of the files as VARCHAR columns that follow the columns of the files
+	static void BindHivePartitions(ParquetReadBindData &bind_data, vector<LogicalType> &return_types,
+	                               vector<string> &names) {
+		for (auto &file : bind_data.files) {
+			auto partitions = ParseHivePartitions(file);
+			if (&file == &bind_data.files[0]) {
+				for (auto &partition : partitions) {
+					for (auto &name : names) {
+						if (StringUtil::Lower(name) == StringUtil::Lower(partition.first)) {
+							throw BinderException("Hive partition \"%s\" has the same name as a column of file \"%s\"",
+							                      partition.first, file);
+						}
+					}
+					bind_data.partition_names.push_back(partition.first);
+				}
+			}
+			bool matches = partitions.size() == bind_data.partition_names.size();
+			vector<Value> values;
+			for (idx_t i = 0; matches && i < partitions.size(); i++) {
+				matches = partitions[i].first == bind_data.partition_names[i];
+				// NULL values are written to the default partition (as by COPY ... PARTITION_BY)
+				auto is_null = partitions[i].second == PhysicalCopyToFile::HIVE_DEFAULT_PARTITION;
+				values.push_back(is_null ? Value(LogicalType::VARCHAR) : Value(partitions[i].second));
+			}
+			if (!matches) {
+				throw IOException("Hive partitions of file \"%s\" do not match the partitions of file \"%s\"", file,
+				                  bind_data.files[0]);
+			}
+			bind_data.partition_values.push_back(move(values));
+		}
+		for (auto &name : bind_data.partition_names) {
+			return_types.push_back(LogicalType::VARCHAR);
+			names.push_back(name);
+		}
+		bind_data.initial_reader->partition_values = bind_data.partition_values[0];
+	}
+
+	//! Returns whether the expression only references hive partition columns, which are rewritten to references to
+	//! the partition values
+	static bool RewritePartitionExpression(const ParquetReadBindData &bind_data, LogicalGet &get,
+	                                       unique_ptr<Expression> &expr) {
+		if (expr->type == ExpressionType::BOUND_COLUMN_REF) {
+			auto &bound_colref = (BoundColumnRefExpression &)*expr;
+			auto column_id = get.column_ids[bound_colref.binding.column_index];
+			auto file_column_count = bind_data.initial_reader->return_types.size();
+			if (bound_colref.binding.table_index != get.table_index || column_id == COLUMN_IDENTIFIER_ROW_ID ||
+			    column_id < file_column_count) {
+				return false;
+			}
+			expr = make_unique<BoundReferenceExpression>(expr->return_type, column_id - file_column_count);
+			return true;
+		}
+		bool rewrite_possible = true;
+		ExpressionIterator::EnumerateChildren(*expr, [&](unique_ptr<Expression> &child) {
+			if (rewrite_possible) {
+				rewrite_possible = RewritePartitionExpression(bind_data, get, child);
+			}
+		});
+		return rewrite_possible;
+	}
+
+	//! Only read the referenced fields of a STRUCT column
+	static void ParquetStructProjectionPushdown(ClientContext &context, LogicalGet &get, FunctionData *bind_data_p,
+	                                            column_t column_id, const vector<vector<idx_t>> &child_paths) {
+		auto &bind_data = (ParquetReadBindData &)*bind_data_p;
+		if (column_id >= bind_data.initial_reader->return_types.size()) {
+			return;
+		}
+		bind_data.struct_pushdown.projections[column_id] = child_paths;
+	}
+
+	//! Add a filter on a (nested) field of a STRUCT column, e.g. struct_extract(payload, 'user_id') = 42
+	static void AddStructFilter(ParquetReadBindData &bind_data, LogicalGet &get, Expression &field,
+	                            ExpressionType comparison_type, Expression &constant) {
+		vector<idx_t> child_path;
+		auto colref = StructExtractFun::GetFieldPath(field, child_path);
+		if (!colref || colref->binding.table_index != get.table_index ||
+		    constant.type != ExpressionType::VALUE_CONSTANT) {
+			return;
+		}
+		auto column_id = get.column_ids[colref->binding.column_index];
+		auto &value = ((BoundConstantExpression &)constant).value;
+		if (column_id == COLUMN_IDENTIFIER_ROW_ID || column_id >= bind_data.initial_reader->return_types.size() ||
+		    value.is_null || value.type() != field.return_type) {
+			return;
+		}
+		auto &filters = bind_data.struct_pushdown.filters;
+		auto entry = filters.begin();
+		for (; entry != filters.end(); entry++) {
+			if (entry->column_id == column_id && entry->child_path == child_path) {
+				break;
+			}
+		}
+		if (entry == filters.end()) {
+			filters.push_back(ParquetStructFilter {column_id, move(child_path), vector<TableFilter>()});
+			entry = filters.end() - 1;
+		}
+		entry->filters.emplace_back(value, comparison_type, column_id);
+	}
+
+	//! Use the comparisons of (nested) fields of STRUCT columns with constants to skip row groups, the filters are
+	//! still evaluated on the rows that are read
+	static void PushdownStructFilters(ParquetReadBindData &bind_data, LogicalGet &get,
+	                                  vector<unique_ptr<Expression>> &filters) {
+		for (auto &filter : filters) {
+			switch (filter->type) {
+			case ExpressionType::COMPARE_EQUAL:
+			case ExpressionType::COMPARE_LESSTHAN:
+			case ExpressionType::COMPARE_LESSTHANOREQUALTO:
+			case ExpressionType::COMPARE_GREATERTHAN:
+			case ExpressionType::COMPARE_GREATERTHANOREQUALTO: {
+				auto &comparison = (BoundComparisonExpression &)*filter;
+				if (comparison.left->IsFoldable()) {
+					AddStructFilter(bind_data, get, *comparison.right, FlipComparisionExpression(comparison.type),
+					                *comparison.left);
+				} else {
+					AddStructFilter(bind_data, get, *comparison.left, comparison.type, *comparison.right);
+				}
+				break;
+			}
+			case ExpressionType::COMPARE_BETWEEN: {
+				auto &between = (BoundBetweenExpression &)*filter;
+				AddStructFilter(bind_data, get, *between.input,
+				                between.lower_inclusive ? ExpressionType::COMPARE_GREATERTHANOREQUALTO
+				                                        : ExpressionType::COMPARE_GREATERTHAN,
+				                *between.lower);
+				AddStructFilter(bind_data, get, *between.input,
+				                between.upper_inclusive ? ExpressionType::COMPARE_LESSTHANOREQUALTO
+				                                        : ExpressionType::COMPARE_LESSTHAN,
+				                *between.upper);
+				break;
+			}
+			default:
+				break;
+			}
+		}
+	}
+
+	//! Push the filters on fields of STRUCT columns into the scan, and prune the files whose hive partitions cannot
+	//! pass the filters on the partition columns before any of the files are opened
+	static void ParquetComplexFilterPushdown(ClientContext &context, LogicalGet &get, FunctionData *bind_data_p,
+	                                         vector<unique_ptr<Expression>> &filters) {
+		auto &bind_data = (ParquetReadBindData &)*bind_data_p;
+		PushdownStructFilters(bind_data, get, filters);
+		if (bind_data.partition_names.empty() || bind_data.files.empty()) {
+			return;
+		}
+		vector<unique_ptr<Expression>> partition_filters;
+		for (idx_t i = 0; i < filters.size(); i++) {
+			auto filter = filters[i]->Copy();
+			if (filters[i]->HasSideEffects() || !RewritePartitionExpression(bind_data, get, filter)) {
+				continue;
+			}
+			partition_filters.push_back(move(filter));
+			filters.erase(filters.begin() + i);
+			i--;
+		}
+		if (partition_filters.empty()) {
+			return;
+		}
+		// evaluate the filters on the partition values with a row for every file, the last column is the file index
+		vector<LogicalType> types(bind_data.partition_names.size(), LogicalType::VARCHAR);
+		types.push_back(LogicalType::BIGINT);
+		vector<string> files;
+		vector<FileInfo> file_info;
+		vector<vector<Value>> partition_values;
+		DataChunk chunk;
+		chunk.Initialize(types);
+		for (idx_t base_idx = 0; base_idx < bind_data.files.size(); base_idx += STANDARD_VECTOR_SIZE) {
+			idx_t count = MinValue<idx_t>(STANDARD_VECTOR_SIZE, bind_data.files.size() - base_idx);
+			chunk.Reset();
+			for (idx_t row_idx = 0; row_idx < count; row_idx++) {
+				auto &values = bind_data.partition_values[base_idx + row_idx];
+				for (idx_t col_idx = 0; col_idx < values.size(); col_idx++) {
+					chunk.SetValue(col_idx, row_idx, values[col_idx]);
+				}
+				chunk.SetValue(values.size(), row_idx, Value::BIGINT(base_idx + row_idx));
+			}
+			chunk.SetCardinality(count);
+			for (auto &filter : partition_filters) {
+				SelectionVector sel(STANDARD_VECTOR_SIZE);
+				ExpressionExecutor executor(*filter);
+				auto result_count = executor.SelectExpression(chunk, sel);
+				if (result_count < chunk.size()) {
+					chunk.Slice(sel, result_count);
+				}
+			}
+			for (idx_t row_idx = 0; row_idx < chunk.size(); row_idx++) {
+				auto file_idx = chunk.GetValue(types.size() - 1, row_idx).GetValue<int64_t>();
+				files.push_back(move(bind_data.files[file_idx]));
+				if (!bind_data.file_info.empty()) {
+					file_info.push_back(bind_data.file_info[file_idx]);
+				}
+				partition_values.push_back(move(bind_data.partition_values[file_idx]));
+			}
+		}
+		bind_data.files = move(files);
+		bind_data.file_info = move(file_info);
+		bind_data.partition_values = move(partition_values);
+	}
+
+	//! Returns a reader for the file at the given index, the initial reader is reused if its file was not pruned
+	static shared_ptr<ParquetReader> OpenFileReader(ClientContext &context, const ParquetReadBindData &bind_data,
+	                                                idx_t file_idx) {
+		auto &file_name = bind_data.files[file_idx];
+		if (file_name == bind_data.initial_reader->file_name) {
+			return bind_data.initial_reader;
+		}
+		auto reader = make_shared<ParquetReader>(context, file_name, bind_data.initial_reader->return_types,
+		                                         bind_data.initial_reader->file_name);
+		if (!bind_data.partition_values.empty()) {
+			reader->partition_values = bind_data.partition_values[file_idx];
+		}
+		return reader;
+	}
+
 	static unique_ptr<FunctionOperatorData> ParquetScanInit(ClientContext &context, const FunctionData *bind_data_p,
 	                                                        vector<column_t> &column_ids,
 	                                                        TableFilterCollection *filters) {
@@ -156,13 +478,18 @@ public:
 		result->is_parallel = false;
 		result->file_index = 0;
 		result->table_filters = filters->table_filters;
+		if (bind_data.files.empty()) {
+			// all files were pruned
+			return move(result);
+		}
 		// single-threaded: one thread has to read all groups
+		result->reader = OpenFileReader(context, bind_data, 0);
 		vector<idx_t> group_ids;
-		for (idx_t i = 0; i < bind_data.initial_reader->NumRowGroups(); i++) {
+		for (idx_t i = 0; i < result->reader->NumRowGroups(); i++) {
 			group_ids.push_back(i);
 		}
-		result->reader = bind_data.initial_reader;
-		result->reader->Initialize(result->scan_state, column_ids, move(group_ids), filters->table_filters);
+		result->reader->Initialize(result->scan_state, column_ids, move(group_ids), filters->table_filters,
+		                           &bind_data.struct_pushdown);
 		return move(result);
 	}
 
@@ -182,6 +509,9 @@ public:
 	static void ParquetScanImplementation(ClientContext &context, const FunctionData *bind_data_p,
 	                                      FunctionOperatorData *operator_state, DataChunk &output) {
 		auto &data = (ParquetReadOperatorData &)*operator_state;
+		if (!data.reader) {
+			return;
+		}
 		do {
 			data.reader->Scan(data.scan_state, output);
 			if (output.size() == 0 && !data.is_parallel) {
@@ -189,15 +519,14 @@ public:
 				// check if there is another file
 				if (data.file_index + 1 < bind_data.files.size()) {
 					data.file_index++;
-					string file = bind_data.files[data.file_index];
 					// move to the next file
-					data.reader =
-					    make_shared<ParquetReader>(context, file, data.reader->return_types, bind_data.files[0]);
+					data.reader = OpenFileReader(context, bind_data, data.file_index);
 					vector<idx_t> group_ids;
 					for (idx_t i = 0; i < data.reader->NumRowGroups(); i++) {
 						group_ids.push_back(i);
 					}
-					data.reader->Initialize(data.scan_state, data.column_ids, move(group_ids), data.table_filters);
+					data.reader->Initialize(data.scan_state, data.column_ids, move(group_ids), data.table_filters,
+					                        &bind_data.struct_pushdown);
 				} else {
 					// exhausted all the files: done
 					break;
@@ -215,13 +544,15 @@ public:
 
 	static idx_t ParquetScanMaxThreads(ClientContext &context, const FunctionData *bind_data) {
 		auto &data = (ParquetReadBindData &)*bind_data;
-		return data.initial_reader->NumRowGroups() * data.files.size();
+		return MaxValue<idx_t>(data.initial_reader->NumRowGroups() * data.files.size(), 1);
 	}
 
 	static unique_ptr<ParallelState> ParquetInitParallelState(ClientContext &context, const FunctionData *bind_data_p) {
 		auto &bind_data = (ParquetReadBindData &)*bind_data_p;
 		auto result = make_unique<ParquetReadParallelState>();
-		result->current_reader = bind_data.initial_reader;
+		if (!bind_data.files.empty()) {
+			result->current_reader = OpenFileReader(context, bind_data, 0);
+		}
 		result->row_group_index = 0;
 		result->file_index = 0;
 		return move(result);
@@ -234,21 +565,23 @@ public:
 		auto &scan_data = (ParquetReadOperatorData &)*state_p;
 
 		lock_guard<mutex> parallel_lock(parallel_state.lock);
+		if (!parallel_state.current_reader) {
+			// all files were pruned
+			return false;
+		}
 		if (parallel_state.row_group_index < parallel_state.current_reader->NumRowGroups()) {
 			// groups remain in the current parquet file: read the next group
 			scan_data.reader = parallel_state.current_reader;
 			vector<idx_t> group_indexes {parallel_state.row_group_index};
 			scan_data.reader->Initialize(scan_data.scan_state, scan_data.column_ids, group_indexes,
-			                             scan_data.table_filters);
+			                             scan_data.table_filters, &bind_data.struct_pushdown);
 			parallel_state.row_group_index++;
 			return true;
 		} else {
 			// no groups remain in the current parquet file: check if there are more files to read
 			while (parallel_state.file_index + 1 < bind_data.files.size()) {
 				// read the next file
-				string file = bind_data.files[++parallel_state.file_index];
-				parallel_state.current_reader =
-				    make_shared<ParquetReader>(context, file, parallel_state.current_reader->return_types);
+				parallel_state.current_reader = OpenFileReader(context, bind_data, ++parallel_state.file_index);
 				if (parallel_state.current_reader->NumRowGroups() == 0) {
 					// empty parquet file, move to next file
 					continue;
@@ -257,7 +590,7 @@ public:
 				scan_data.reader = parallel_state.current_reader;
 				vector<idx_t> group_indexes {0};
 				scan_data.reader->Initialize(scan_data.scan_state, scan_data.column_ids, group_indexes,
-				                             scan_data.table_filters);
+				                             scan_data.table_filters, &bind_data.struct_pushdown);
 				parallel_state.row_group_index = 1;
 				return true;
 			}
@@ -268,9 +601,10 @@ public:
 
 struct ParquetWriteBindData : public FunctionData {
 	vector<LogicalType> sql_types;
-	string file_name;
 	vector<string> column_names;
 	parquet::format::CompressionCodec::type codec = parquet::format::CompressionCodec::SNAPPY;
+	//! The amount of rows that are buffered by a thread before they are written as a row group
+	idx_t row_group_size = 100000;
 };
 
 struct ParquetWriteGlobalState : public GlobalFunctionData {
@@ -308,35 +642,46 @@ unique_ptr<FunctionData> ParquetWriteBind(ClientContext &context, CopyInfo &info
 				}
 			}
 			throw ParserException("Expected %s argument to be either [uncompressed, snappy, gzip or zstd]", loption);
+		} else if (loption == "row_group_size" || loption == "chunk_size") {
+			if (option.second.size() != 1) {
+				throw BinderException("ROW_GROUP_SIZE requires a single argument");
+			}
+			auto row_group_size = option.second[0].CastAs(LogicalType::BIGINT).GetValue<int64_t>();
+			if (row_group_size <= 0) {
+				throw BinderException("ROW_GROUP_SIZE must be a positive number of rows");
+			}
+			bind_data->row_group_size = row_group_size;
 		} else {
 			throw NotImplementedException("Unrecognized option for PARQUET: %s", option.first.c_str());
 		}
 	}
 	bind_data->sql_types = sql_types;
 	bind_data->column_names = names;
-	bind_data->file_name = info.file_path;
 	return move(bind_data);
 }
 
-unique_ptr<GlobalFunctionData> ParquetWriteInitializeGlobal(ClientContext &context, FunctionData &bind_data) {
+unique_ptr<GlobalFunctionData> ParquetWriteInitializeGlobal(ClientContext &context, FunctionData &bind_data,
+                                                            const string &file_path) {
 	auto global_state = make_unique<ParquetWriteGlobalState>();
 	auto &parquet_bind = (ParquetWriteBindData &)bind_data;
 
 	auto &fs = FileSystem::GetFileSystem(context);
-	global_state->writer = make_unique<ParquetWriter>(fs, parquet_bind.file_name, parquet_bind.sql_types,
+	global_state->writer = make_unique<ParquetWriter>(fs, file_path, parquet_bind.sql_types,
 	                                                  parquet_bind.column_names, parquet_bind.codec);
 	return move(global_state);
 }
 
-void ParquetWriteSink(ClientContext &context, FunctionData &bind_data, GlobalFunctionData &gstate,
+void ParquetWriteSink(ClientContext &context, FunctionData &bind_data_p, GlobalFunctionData &gstate,
                       LocalFunctionData &lstate, DataChunk &input) {
+	auto &bind_data = (ParquetWriteBindData &)bind_data_p;
 	auto &global_state = (ParquetWriteGlobalState &)gstate;
 	auto &local_state = (ParquetWriteLocalState &)lstate;
 
 	// append data to the local (buffered) chunk collection
 	local_state.buffer->Append(input);
-	if (local_state.buffer->Count() > 100000) {
+	if (local_state.buffer->Count() >= bind_data.row_group_size) {
 		// if the chunk collection exceeds a certain size we flush it to the parquet file
+		// the row group is encoded and compressed by this thread, only appending it to the file is serialized
 		global_state.writer->Flush(*local_state.buffer);
 		// and reset the buffer
 		local_state.buffer = make_unique<ChunkCollection>();
@@ -0,0 +1,392 @@
+#include "parquet_file_metadata_cache.hpp"
+
+#include "duckdb/common/exception.hpp"
+#include "duckdb/common/file_system.hpp"
+#include "duckdb/common/mutex.hpp"
+#include "duckdb/common/random_engine.hpp"
+#include "duckdb/common/serializer/buffered_deserializer.hpp"
+#include "duckdb/common/string_util.hpp"
+#include "duckdb/common/types/hash.hpp"
+#include "duckdb/common/unordered_map.hpp"
+#include "duckdb/main/client_context.hpp"
+#include "duckdb/main/config.hpp"
+#include "duckdb/main/database.hpp"
+
+#include "thrift/protocol/TCompactProtocol.h"
+#include "thrift/transport/TBufferTransports.h"
+
+#include <algorithm>
+#include <list>
+#include <thread>
+
+namespace duckdb {
+
+using apache::thrift::protocol::TCompactProtocolT;
+using apache::thrift::transport::TMemoryBuffer;
+
+shared_ptr<ParquetFileMetadataCache> ParquetFileMetadataCache::Get(ClientContext &context, const string &file_name,
+                                                                   idx_t file_size, time_t last_modified) {
+	bool object_cache_enabled = ObjectCache::ObjectCacheEnabled(context);
+	if (object_cache_enabled) {
+		auto metadata =
+		    std::dynamic_pointer_cast<ParquetFileMetadataCache>(ObjectCache::GetObjectCache(context).Get(file_name));
+		if (metadata && metadata->IsCurrent(file_size, last_modified)) {
+			return metadata;
+		}
+	}
+	auto directory = ParquetMetadataDiskCache::GetDirectory(context);
+	if (directory.empty()) {
+		return nullptr;
+	}
+	auto metadata = ParquetMetadataDiskCache::ReadMetadata(FileSystem::GetFileSystem(context), directory, file_name);
+	if (!metadata || !metadata->IsCurrent(file_size, last_modified)) {
+		return nullptr;
+	}
+	if (object_cache_enabled) {
+		ObjectCache::GetObjectCache(context).Put(file_name, metadata);
+	}
+	return metadata;
+}
+
+void ParquetFileMetadataCache::Put(ClientContext &context, const string &file_name,
+                                   shared_ptr<ParquetFileMetadataCache> metadata) {
+	auto directory = ParquetMetadataDiskCache::GetDirectory(context);
+	if (!directory.empty()) {
+		ParquetMetadataDiskCache::WriteMetadata(FileSystem::GetFileSystem(context), directory,
+		                                        ParquetMetadataDiskCache::GetSizeLimit(context), file_name, *metadata);
+	}
+	if (ObjectCache::ObjectCacheEnabled(context)) {
+		ObjectCache::GetObjectCache(context).Put(file_name, move(metadata));
+	}
+}
+
+string ParquetGlobStatistics::CacheKey(const vector<string> &files) {
+	hash_t hash = 0;
+	for (auto &file : files) {
+		hash = CombineHash(hash, duckdb::Hash(file.c_str(), file.size()));
+	}
+	return "parquet_glob_statistics_" + std::to_string(hash);
+}
+
+shared_ptr<ParquetGlobStatistics> ParquetGlobStatistics::Get(ClientContext &context, const vector<string> &files,
+                                                             const vector<idx_t> &file_sizes,
+                                                             const vector<time_t> &last_modified,
+                                                             const vector<LogicalType> &types) {
+	auto key = CacheKey(files);
+	bool object_cache_enabled = ObjectCache::ObjectCacheEnabled(context);
+	if (object_cache_enabled) {
+		auto statistics =
+		    std::dynamic_pointer_cast<ParquetGlobStatistics>(ObjectCache::GetObjectCache(context).Get(key));
+		if (statistics && statistics->IsCurrent(files, file_sizes, last_modified)) {
+			return statistics;
+		}
+	}
+	auto directory = ParquetMetadataDiskCache::GetDirectory(context);
+	if (directory.empty()) {
+		return nullptr;
+	}
+	auto statistics =
+	    ParquetMetadataDiskCache::ReadStatistics(FileSystem::GetFileSystem(context), directory, key, types);
+	if (!statistics || !statistics->IsCurrent(files, file_sizes, last_modified)) {
+		return nullptr;
+	}
+	if (object_cache_enabled) {
+		ObjectCache::GetObjectCache(context).Put(key, statistics);
+	}
+	return statistics;
+}
+
+void ParquetGlobStatistics::Put(ClientContext &context, shared_ptr<ParquetGlobStatistics> statistics) {
+	auto key = CacheKey(statistics->files);
+	auto directory = ParquetMetadataDiskCache::GetDirectory(context);
+	if (!directory.empty()) {
+		ParquetMetadataDiskCache::WriteStatistics(FileSystem::GetFileSystem(context), directory,
+		                                          ParquetMetadataDiskCache::GetSizeLimit(context), key, *statistics);
+	}
+	if (ObjectCache::ObjectCacheEnabled(context)) {
+		ObjectCache::GetObjectCache(context).Put(key, move(statistics));
+	}
+}
+
+string ParquetMetadataDiskCache::GetDirectory(ClientContext &context) {
+	auto &config = DBConfig::GetConfig(context);
+	auto entry = config.set_variables.find("parquet_metadata_cache_directory");
+	if (entry == config.set_variables.end() || entry->second.is_null) {
+		return string();
+	}
+	return entry->second.ToString();
+}
+
+idx_t ParquetMetadataDiskCache::GetSizeLimit(ClientContext &context) {
+	auto &config = DBConfig::GetConfig(context);
+	auto entry = config.set_variables.find("parquet_metadata_cache_size");
+	if (entry == config.set_variables.end() || entry->second.is_null) {
+		return DEFAULT_SIZE_LIMIT;
+	}
+	auto size_limit = entry->second.GetValue<int64_t>();
+	if (size_limit < 0) {
+		throw InvalidInputException("parquet_metadata_cache_size must be a positive amount of bytes");
+	}
+	return size_limit;
+}
+
+//! The files of a cache directory, ordered from most to least recently used. The state is shared by all database
+//! instances of the process, it is built from the files in the directory when the directory is first used.
+struct ParquetCacheDirectory {
+	struct Entry {
+		string file_name;
+		idx_t size;
+	};
+	std::list<Entry> lru;
+	unordered_map<string, std::list<Entry>::iterator> files;
+	idx_t total_size = 0;
+
+	void Touch(const string &file_name, idx_t size) {
+		auto entry = files.find(file_name);
+		if (entry != files.end()) {
+			total_size -= entry->second->size;
+			lru.erase(entry->second);
+		}
+		total_size += size;
+		lru.push_front(Entry {file_name, size});
+		files[file_name] = lru.begin();
+	}
+};
+
+static mutex cache_directory_lock;
+static unordered_map<string, ParquetCacheDirectory> cache_directories;
+
+static bool IsCacheFile(const string &file_name) {
+	return StringUtil::EndsWith(file_name, ".metadata") || StringUtil::EndsWith(file_name, ".statistics") ||
+	       file_name.find(".tmp") != string::npos;
+}
+
+//! Returns the state of a cache directory, the cache_directory_lock must be held
+static ParquetCacheDirectory &GetCacheDirectory(FileSystem &fs, const string &directory) {
+	auto entry = cache_directories.find(directory);
+	if (entry != cache_directories.end()) {
+		return entry->second;
+	}
+	auto &result = cache_directories[directory];
+	if (!fs.DirectoryExists(directory)) {
+		return result;
+	}
+	vector<string> file_names;
+	fs.ListFiles(directory, [&](string file_name, bool is_directory) {
+		if (!is_directory && IsCacheFile(file_name)) {
+			file_names.push_back(move(file_name));
+		}
+	});
+	vector<std::pair<time_t, ParquetCacheDirectory::Entry>> entries;
+	for (auto &file_name : file_names) {
+		try {
+			auto handle = fs.OpenFile(fs.JoinPath(directory, file_name).c_str(), FileFlags::FILE_FLAGS_READ);
+			entries.emplace_back(fs.GetLastModifiedTime(*handle),
+			                     ParquetCacheDirectory::Entry {file_name, (idx_t)fs.GetFileSize(*handle)});
+		} catch (...) {
+			// the file was removed in the meantime
+		}
+	}
+	// the least recently modified files are evicted first
+	std::sort(entries.begin(), entries.end(),
+	          [](const std::pair<time_t, ParquetCacheDirectory::Entry> &a,
+	             const std::pair<time_t, ParquetCacheDirectory::Entry> &b) { return a.first < b.first; });
+	for (auto &entry : entries) {
+		result.Touch(entry.second.file_name, entry.second.size);
+	}
+	return result;
+}
+
+void ParquetMetadataDiskCache::TouchFile(FileSystem &fs, const string &path, idx_t size) {
+	auto separator = path.find_last_of(fs.PathSeparator());
+	lock_guard<mutex> guard(cache_directory_lock);
+	auto &cache_directory = GetCacheDirectory(fs, path.substr(0, separator));
+	cache_directory.Touch(path.substr(separator + 1), size);
+}
+
+void ParquetMetadataDiskCache::EvictFiles(FileSystem &fs, const string &directory, idx_t size_limit) {
+	lock_guard<mutex> guard(cache_directory_lock);
+	auto &cache_directory = GetCacheDirectory(fs, directory);
+	while (cache_directory.total_size > size_limit && !cache_directory.lru.empty()) {
+		auto &entry = cache_directory.lru.back();
+		try {
+			fs.RemoveFile(fs.JoinPath(directory, entry.file_name));
+		} catch (...) {
+			// the file was already removed, e.g. by another process that uses the same directory
+		}
+		cache_directory.total_size -= entry.size;
+		cache_directory.files.erase(entry.file_name);
+		cache_directory.lru.pop_back();
+	}
+}
+
+string ParquetMetadataDiskCache::CachePath(FileSystem &fs, const string &directory, const string &key,
+                                           const string &extension) {
+	return fs.JoinPath(directory, std::to_string(std::hash<string>()(key)) + extension);
+}
+
+void ParquetMetadataDiskCache::WriteHeader(BufferedSerializer &serializer) {
+	serializer.Write<uint32_t>(MAGIC_NUMBER);
+	serializer.Write<uint32_t>(FORMAT_VERSION);
+}
+
+bool ParquetMetadataDiskCache::ReadHeader(BufferedDeserializer &source) {
+	if (source.Read<uint32_t>() != MAGIC_NUMBER) {
+		return false;
+	}
+	return source.Read<uint32_t>() == FORMAT_VERSION;
+}
+
+void ParquetMetadataDiskCache::WriteFile(FileSystem &fs, const string &path, idx_t size_limit,
+                                         BufferedSerializer &serializer) {
+	auto directory = path.substr(0, path.find_last_of(fs.PathSeparator()));
+	auto blob = serializer.GetData();
+	// the temporary file must be unique among all threads and processes that write to the cache directory: a random
+	// suffix is added to the thread id, as thread ids are only unique within a process
+	RandomEngine random(-1);
+	auto temp_path = path + ".tmp" + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id())) + "_" +
+	                 std::to_string(random.NextRandomInteger());
+	// writing to the cache is best-effort: a failed write (e.g. to a directory that is not writable) only means that
+	// the metadata is read from the file again next time
+	try {
+		if (!fs.DirectoryExists(directory)) {
+			fs.CreateDirectory(directory);
+		}
+		auto handle = fs.OpenFile(temp_path, FileFlags::FILE_FLAGS_WRITE | FileFlags::FILE_FLAGS_FILE_CREATE_NEW);
+		fs.Write(*handle, blob.data.get(), blob.size, 0);
+		handle.reset();
+		fs.MoveFile(temp_path, path);
+	} catch (...) {
+		try {
+			fs.RemoveFile(temp_path);
+		} catch (...) {
+		}
+		return;
+	}
+	TouchFile(fs, path, blob.size);
+	EvictFiles(fs, directory, size_limit);
+}
+
+bool ParquetMetadataDiskCache::ReadFile(FileSystem &fs, const string &path, unique_ptr<data_t[]> &data, idx_t &size) {
+	try {
+		if (!fs.FileExists(path)) {
+			return false;
+		}
+		auto handle = fs.OpenFile(path.c_str(), FileFlags::FILE_FLAGS_READ);
+		size = fs.GetFileSize(*handle);
+		data = unique_ptr<data_t[]>(new data_t[size]);
+		fs.Read(*handle, data.get(), size, 0);
+	} catch (...) {
+		// the file was evicted while it was read
+		return false;
+	}
+	TouchFile(fs, path, size);
+	return true;
+}
+
+shared_ptr<ParquetFileMetadataCache> ParquetMetadataDiskCache::ReadMetadata(FileSystem &fs, const string &directory,
+                                                                            const string &file_name) {
+	unique_ptr<data_t[]> data;
+	idx_t size;
+	if (!ReadFile(fs, CachePath(fs, directory, file_name, ".metadata"), data, size)) {
+		return nullptr;
+	}
+	try {
+		// after the header, the entry starts with the name of the file, which protects against hash collisions
+		BufferedDeserializer source(data.get(), size);
+		if (!ReadHeader(source) || source.Read<string>() != file_name) {
+			return nullptr;
+		}
+		auto file_size = source.Read<uint64_t>();
+		auto last_modified = (time_t)source.Read<int64_t>();
+		auto read_time = (time_t)source.Read<int64_t>();
+		// followed by the thrift-encoded footer
+		auto footer_size = source.endptr - source.ptr;
+		auto buffer = make_shared<TMemoryBuffer>(source.ptr, footer_size);
+		TCompactProtocolT<TMemoryBuffer> protocol(buffer);
+		auto metadata = make_unique<parquet::format::FileMetaData>();
+		metadata->read(&protocol);
+		return make_shared<ParquetFileMetadataCache>(move(metadata), read_time, file_size, last_modified);
+	} catch (std::exception &ex) {
+		// a corrupt cache entry is treated as a cache miss
+		return nullptr;
+	}
+}
+
+void ParquetMetadataDiskCache::WriteMetadata(FileSystem &fs, const string &directory, idx_t size_limit,
+                                             const string &file_name, ParquetFileMetadataCache &metadata) {
+	auto buffer = make_shared<TMemoryBuffer>();
+	TCompactProtocolT<TMemoryBuffer> protocol(buffer);
+	metadata.metadata->write(&protocol);
+	uint8_t *footer;
+	uint32_t footer_size;
+	buffer->getBuffer(&footer, &footer_size);
+
+	BufferedSerializer serializer;
+	WriteHeader(serializer);
+	serializer.WriteString(file_name);
+	serializer.Write<uint64_t>(metadata.file_size);
+	serializer.Write<int64_t>(metadata.last_modified);
+	serializer.Write<int64_t>(metadata.read_time);
+	serializer.WriteData(footer, footer_size);
+	WriteFile(fs, CachePath(fs, directory, file_name, ".metadata"), size_limit, serializer);
+}
+
+shared_ptr<ParquetGlobStatistics> ParquetMetadataDiskCache::ReadStatistics(FileSystem &fs, const string &directory,
+                                                                          const string &key,
+                                                                          const vector<LogicalType> &types) {
+	unique_ptr<data_t[]> data;
+	idx_t size;
+	if (!ReadFile(fs, CachePath(fs, directory, key, ".statistics"), data, size)) {
+		return nullptr;
+	}
+	try {
+		BufferedDeserializer source(data.get(), size);
+		if (!ReadHeader(source)) {
+			return nullptr;
+		}
+		auto statistics = make_shared<ParquetGlobStatistics>();
+		auto file_count = source.Read<uint64_t>();
+		for (idx_t i = 0; i < file_count; i++) {
+			statistics->files.push_back(source.Read<string>());
+			statistics->file_sizes.push_back(source.Read<uint64_t>());
+			statistics->last_modified.push_back((time_t)source.Read<int64_t>());
+		}
+		statistics->read_time = (time_t)source.Read<int64_t>();
+		auto column_count = source.Read<uint64_t>();
+		if (column_count != types.size()) {
+			return nullptr;
+		}
+		for (idx_t col_idx = 0; col_idx < column_count; col_idx++) {
+			auto has_statistics = source.Read<bool>();
+			statistics->column_statistics.push_back(
+			    has_statistics ? BaseStatistics::Deserialize(source, types[col_idx]) : nullptr);
+		}
+		return statistics;
+	} catch (std::exception &ex) {
+		return nullptr;
+	}
+}
+
+void ParquetMetadataDiskCache::WriteStatistics(FileSystem &fs, const string &directory, idx_t size_limit,
+                                               const string &key, ParquetGlobStatistics &statistics) {
+	BufferedSerializer serializer;
+	WriteHeader(serializer);
+	serializer.Write<uint64_t>(statistics.files.size());
+	for (idx_t i = 0; i < statistics.files.size(); i++) {
+		serializer.WriteString(statistics.files[i]);
+		serializer.Write<uint64_t>(statistics.file_sizes[i]);
+		serializer.Write<int64_t>(statistics.last_modified[i]);
+	}
+	serializer.Write<int64_t>(statistics.read_time);
+	serializer.Write<uint64_t>(statistics.column_statistics.size());
+	for (auto &column_statistics : statistics.column_statistics) {
+		serializer.Write<bool>(column_statistics ? true : false);
+		if (column_statistics) {
+			column_statistics->Serialize(serializer);
+		}
+	}
+	WriteFile(fs, CachePath(fs, directory, key, ".statistics"), size_limit, serializer);
+}
+
+} // namespace duckdb
@@ -14,8 +14,6 @@
 #include "duckdb/common/types/date.hpp"
 #include "duckdb/common/pair.hpp"
 
-#include "duckdb/storage/object_cache.hpp"
-
 #include <sstream>
 #include <cassert>
 #include <chrono>
@@ -33,12 +31,13 @@ using parquet::format::SchemaElement;
 using parquet::format::Statistics;
 using parquet::format::Type;
 
-static shared_ptr<ParquetFileMetadataCache> LoadMetaData(apache::thrift::protocol::TProtocol &proto, idx_t read_pos) {
+static shared_ptr<ParquetFileMetadataCache> LoadMetaData(apache::thrift::protocol::TProtocol &proto, idx_t read_pos,
+                                                         idx_t file_size, time_t last_modified) {
 	auto current_time = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
 	auto metadata = make_unique<FileMetaData>();
 	((ThriftFileTransport *)proto.getTransport().get())->SetLocation(read_pos);
 	metadata->read(&proto);
-	return make_shared<ParquetFileMetadataCache>(move(metadata), current_time);
+	return make_shared<ParquetFileMetadataCache>(move(metadata), current_time, file_size, last_modified);
 }
 
 static LogicalType DeriveLogicalType(const SchemaElement &s_ele) {
@@ -222,19 +221,12 @@ ParquetReader::ParquetReader(ClientContext &context, string file_name_p, vector<
 	shared_ptr<ThriftFileTransport> trans(new ThriftFileTransport(move(handle)));
 	auto thrift_file_proto = make_unique<apache::thrift::protocol::TCompactProtocolT<ThriftFileTransport>>(trans);
 
-	// If object cached is disabled
-	// or if this file has cached metadata
-	// or if the cached version already expired
+	// use the cached metadata (from the object cache or the on-disk metadata cache) if it is current for this file
 	auto metadata_pos = file_size - (footer_len + 8);
-	if (!ObjectCache::ObjectCacheEnabled(context)) {
-		metadata = LoadMetaData(*thrift_file_proto, metadata_pos);
-	} else {
-		metadata =
-		    std::dynamic_pointer_cast<ParquetFileMetadataCache>(ObjectCache::GetObjectCache(context).Get(file_name));
-		if (!metadata || (last_modify_time + 10 >= metadata->read_time)) {
-			metadata = LoadMetaData(*thrift_file_proto, metadata_pos);
-			ObjectCache::GetObjectCache(context).Put(file_name, metadata);
-		}
+	metadata = ParquetFileMetadataCache::Get(context, file_name, file_size, last_modify_time);
+	if (!metadata) {
+		metadata = LoadMetaData(*thrift_file_proto, metadata_pos, file_size, last_modify_time);
+		ParquetFileMetadataCache::Put(context, file_name, metadata);
 	}
 
 	auto file_meta_data = GetFileMetadata();
@@ -290,6 +282,10 @@ unique_ptr<BaseStatistics> ParquetReader::ReadStatistics(LogicalType &type, colu
 
 	for (auto &row_group : file_meta_data->row_groups) {
 		auto chunk_stats = column_reader->Stats(row_group.columns);
+		if (!chunk_stats) {
+			// if stats are missing from any row group we know squat
+			return nullptr;
+		}
 		if (!column_stats) {
 			column_stats = move(chunk_stats);
 		} else {
@@ -318,49 +314,38 @@ void ParquetReader::PrepareRowGroupBuffer(ParquetReaderScanState &state, idx_t o
 		// filters contain output chunk index, not file col idx!
 		auto filter_entry = state.filters->filters.find(out_col_idx);
 		if (stats && filter_entry != state.filters->filters.end()) {
-			bool skip_chunk = false;
-			switch (column_reader->Type().id()) {
-			case LogicalTypeId::UTINYINT:
-			case LogicalTypeId::USMALLINT:
-			case LogicalTypeId::UINTEGER:
-			case LogicalTypeId::UBIGINT:
-			case LogicalTypeId::INTEGER:
-			case LogicalTypeId::BIGINT:
-			case LogicalTypeId::FLOAT:
-			case LogicalTypeId::TIMESTAMP:
-			case LogicalTypeId::DOUBLE: {
-				auto num_stats = (NumericStatistics &)*stats;
-				for (auto &filter : filter_entry->second) {
-					skip_chunk = !num_stats.CheckZonemap(filter.comparison_type, filter.constant);
-					if (skip_chunk) {
-						break;
-					}
-				}
-				break;
-			}
-			case LogicalTypeId::BLOB:
-			case LogicalTypeId::VARCHAR: {
-				auto str_stats = (StringStatistics &)*stats;
-				for (auto &filter : filter_entry->second) {
-					skip_chunk = !str_stats.CheckZonemap(filter.comparison_type, filter.constant.str_value);
-					if (skip_chunk) {
-						break;
-					}
-				}
-				break;
-			}
-			default:
-				break;
-			}
+			bool skip_chunk = !ParquetCheckZonemap(*stats, filter_entry->second);
 			if (skip_chunk) {
 				state.group_offset = group.num_rows;
-				return;
 				// this effectively will skip this chunk
 			}
 		}
 	}
+}
+
+bool ParquetReader::CheckStructFilters(ParquetReaderScanState &state) {
+	auto &group = GetGroup(state);
+	auto root_reader = (StructColumnReader *)state.root_reader.get();
+	for (auto &struct_filter : state.struct_pushdown->filters) {
+		auto column_reader = root_reader->GetChildReader(struct_filter.column_id);
+		for (auto child_idx : struct_filter.child_path) {
+			D_ASSERT(column_reader->Type().id() == LogicalTypeId::STRUCT);
+			column_reader = ((StructColumnReader *)column_reader)->GetChildReader(child_idx);
+		}
+		auto stats = column_reader->Stats(group.columns);
+		if (stats && !ParquetCheckZonemap(*stats, struct_filter.filters)) {
+			return false;
+		}
+	}
+	return true;
+}
 
-	state.root_reader->IntializeRead(group.columns, *state.thrift_file_proto);
+Value ParquetReader::GetConstantColumnValue(column_t column_id) {
+	if (column_id == COLUMN_IDENTIFIER_ROW_ID) {
+		return Value::BIGINT(42);
+	}
+	D_ASSERT(column_id - return_types.size() < partition_values.size());
+	return partition_values[column_id - return_types.size()];
 }
 
 idx_t ParquetReader::NumRows() {
@@ -372,19 +357,43 @@ idx_t ParquetReader::NumRowGroups() {
 }
 
 void ParquetReader::Initialize(ParquetReaderScanState &state, vector<column_t> column_ids, vector<idx_t> groups_to_read,
-                               TableFilterSet *filters) {
+                               TableFilterSet *filters, const ParquetStructPushdown *struct_pushdown) {
 	state.current_group = -1;
 	state.finished = false;
 	state.column_ids = move(column_ids);
 	state.group_offset = 0;
 	state.group_idx_list = move(groups_to_read);
 	state.filters = filters;
+	state.struct_pushdown = struct_pushdown;
 	state.sel.Initialize(STANDARD_VECTOR_SIZE);
 
 	auto handle = FileSystem::GetFileSystem(context).OpenFile(file_name, FileFlags::FILE_FLAGS_READ);
 	shared_ptr<ThriftFileTransport> trans(new ThriftFileTransport(move(handle)));
 	state.thrift_file_proto = make_unique<apache::thrift::protocol::TCompactProtocolT<ThriftFileTransport>>(trans);
 	state.root_reader = CreateReader(GetFileMetadata());
+	auto root_reader = (StructColumnReader *)state.root_reader.get();
+	for (idx_t out_col_idx = 0; out_col_idx < state.column_ids.size(); out_col_idx++) {
+		auto file_col_idx = state.column_ids[out_col_idx];
+		if (!IsFileColumn(file_col_idx)) {
+			continue;
+		}
+		auto column_reader = root_reader->GetChildReader(file_col_idx);
+		if (struct_pushdown) {
+			// only the referenced fields of STRUCT columns are read
+			auto projection = struct_pushdown->projections.find(file_col_idx);
+			if (projection != struct_pushdown->projections.end()) {
+				D_ASSERT(column_reader->Type().id() == LogicalTypeId::STRUCT);
+				((StructColumnReader *)column_reader)->SetProjection(projection->second);
+			}
+		}
+		if (filters && filters->filters.find(out_col_idx) != filters->filters.end()) {
+			// the filtered columns skip the data pages that cannot pass their filters
+			column_reader->SetPageFilters(&filters->filters[out_col_idx]);
+		} else {
+			// the filters are evaluated on flat vectors, all other columns can be emitted as dictionary vectors
+			column_reader->EnableDictionaryVectors();
+		}
+	}
 
 	state.define_buf.resize(STANDARD_VECTOR_SIZE);
 	state.repeat_buf.resize(STANDARD_VECTOR_SIZE);
@@ -490,12 +499,30 @@ bool ParquetReader::ScanInternal(ParquetReaderScanState &state, DataChunk &resul
 
 		for (idx_t out_col_idx = 0; out_col_idx < result.ColumnCount(); out_col_idx++) {
 			// this is a special case where we are not interested in the actual contents of the file
-			if (state.column_ids[out_col_idx] == COLUMN_IDENTIFIER_ROW_ID) {
+			if (!IsFileColumn(state.column_ids[out_col_idx])) {
 				continue;
 			}
 
 			PrepareRowGroupBuffer(state, out_col_idx);
 		}
+		if (state.struct_pushdown && !state.struct_pushdown->filters.empty() && !CheckStructFilters(state)) {
+			// this effectively will skip this chunk
+			state.group_offset = GetGroup(state).num_rows;
+		}
+		if ((int64_t)state.group_offset < GetGroup(state).num_rows) {
+			state.root_reader->IntializeRead(GetGroup(state).columns, *state.thrift_file_proto);
+
+			// remote file systems can fetch the column chunks that are about to be read ahead of time
+			vector<pair<idx_t, idx_t>> prefetch_ranges;
+			auto root_reader = (StructColumnReader *)state.root_reader.get();
+			for (auto file_col_idx : state.column_ids) {
+				if (IsFileColumn(file_col_idx)) {
+					root_reader->GetChildReader(file_col_idx)->RegisterPrefetch(prefetch_ranges);
+				}
+			}
+			auto trans = (ThriftFileTransport *)state.thrift_file_proto->getTransport().get();
+			trans->Prefetch(prefetch_ranges);
+		}
 		return true;
 	}
 
@@ -526,6 +553,8 @@ bool ParquetReader::ScanInternal(ParquetReaderScanState &state, DataChunk &resul
 		// first load the columns that are used in filters
 		for (auto &filter_col : state.filters->filters) {
 			auto file_col_idx = state.column_ids[filter_col.first];
+			// filters on hive partition columns are applied when the files are pruned
+			D_ASSERT(IsFileColumn(file_col_idx));
 
 			if (filter_mask.none()) { // if no rows are left we can stop checking filters
 				break;
@@ -570,12 +599,15 @@ bool ParquetReader::ScanInternal(ParquetReaderScanState &state, DataChunk &resul
 				continue;
 			}
 			auto file_col_idx = state.column_ids[out_col_idx];
+			if (!IsFileColumn(file_col_idx)) {
+				result.data[out_col_idx].Reference(GetConstantColumnValue(file_col_idx));
+				continue;
+			}
 
 			if (filter_mask.none()) {
 				root_reader->GetChildReader(file_col_idx)->Skip(result.size());
 				continue;
 			}
-			// TODO handle ROWID here, too
 			root_reader->GetChildReader(file_col_idx)
 			    ->Read(result.size(), filter_mask, define_ptr, repeat_ptr, result.data[out_col_idx]);
 		}
@@ -594,9 +626,8 @@ bool ParquetReader::ScanInternal(ParquetReaderScanState &state, DataChunk &resul
 		for (idx_t out_col_idx = 0; out_col_idx < result.ColumnCount(); out_col_idx++) {
 			auto file_col_idx = state.column_ids[out_col_idx];
 
-			if (file_col_idx == COLUMN_IDENTIFIER_ROW_ID) {
-				Value constant_42 = Value::BIGINT(42);
-				result.data[out_col_idx].Reference(constant_42);
+			if (!IsFileColumn(file_col_idx)) {
+				result.data[out_col_idx].Reference(GetConstantColumnValue(file_col_idx));
 				continue;
 			}
 
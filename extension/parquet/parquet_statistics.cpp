@@ -2,6 +2,7 @@
 #include "parquet_timestamp.hpp"
 
 #include "duckdb/common/types/value.hpp"
+#include "duckdb/planner/table_filter.hpp"
 #include "duckdb/storage/statistics/string_statistics.hpp"
 #include "duckdb/storage/statistics/numeric_statistics.hpp"
 
@@ -13,26 +14,26 @@ using parquet::format::Type;
 template <Value (*FUNC)(const_data_ptr_t input)>
 static unique_ptr<BaseStatistics> TemplatedGetNumericStats(const LogicalType &type,
                                                            const parquet::format::Statistics &parquet_stats) {
-	auto stats = make_unique<NumericStatistics>(type);
-
 	// for reasons unknown to science, Parquet defines *both* `min` and `min_value` as well as `max` and
 	// `max_value`. All are optional. such elegance.
+	// if either is missing (e.g. because all values are NULL) we know squat
+	Value min;
 	if (parquet_stats.__isset.min) {
-		stats->min = FUNC((const_data_ptr_t)parquet_stats.min.data());
+		min = FUNC((const_data_ptr_t)parquet_stats.min.data());
 	} else if (parquet_stats.__isset.min_value) {
-		stats->min = FUNC((const_data_ptr_t)parquet_stats.min_value.data());
+		min = FUNC((const_data_ptr_t)parquet_stats.min_value.data());
 	} else {
-		stats->min.is_null = true;
+		return nullptr;
 	}
+	Value max;
 	if (parquet_stats.__isset.max) {
-		stats->max = FUNC((const_data_ptr_t)parquet_stats.max.data());
+		max = FUNC((const_data_ptr_t)parquet_stats.max.data());
 	} else if (parquet_stats.__isset.max_value) {
-		stats->max = FUNC((const_data_ptr_t)parquet_stats.max_value.data());
+		max = FUNC((const_data_ptr_t)parquet_stats.max_value.data());
 	} else {
-		stats->max.is_null = true;
+		return nullptr;
 	}
-	// GCC 4.x insists on a move() here
-	return move(stats);
+	return make_unique<NumericStatistics>(type, move(min), move(max));
 }
 
 template <class T>
@@ -74,7 +75,11 @@ unique_ptr<BaseStatistics> ParquetTransformColumnStatistics(const SchemaElement
 		// no stats present for row group
 		return nullptr;
 	}
-	auto &parquet_stats = column_chunk.meta_data.statistics;
+	return ParquetTransformStatistics(s_ele, type, column_chunk.meta_data.statistics);
+}
+
+unique_ptr<BaseStatistics> ParquetTransformStatistics(const SchemaElement &s_ele, const LogicalType &type,
+                                                      const parquet::format::Statistics &parquet_stats) {
 	unique_ptr<BaseStatistics> row_group_stats;
 
 	switch (type.id()) {
@@ -137,6 +142,9 @@ unique_ptr<BaseStatistics> ParquetTransformColumnStatistics(const SchemaElement
 	}
 	case LogicalTypeId::VARCHAR: {
 		auto string_stats = make_unique<StringStatistics>(type);
+		// we dont know better; this also skips validating the bounds, which might have been truncated in the middle
+		// of a multi-byte character
+		string_stats->has_unicode = true;
 		if (parquet_stats.__isset.min) {
 			string_stats->Update(parquet_stats.min);
 		} else if (parquet_stats.__isset.min_value) {
@@ -151,8 +159,6 @@ unique_ptr<BaseStatistics> ParquetTransformColumnStatistics(const SchemaElement
 		} else {
 			return nullptr;
 		}
-
-		string_stats->has_unicode = true; // we dont know better
 		row_group_stats = move(string_stats);
 		break;
 	}
@@ -176,4 +182,39 @@ unique_ptr<BaseStatistics> ParquetTransformColumnStatistics(const SchemaElement
 	return row_group_stats;
 }
 
+bool ParquetCheckZonemap(BaseStatistics &stats, const vector<TableFilter> &filters) {
+	switch (stats.type.id()) {
+	case LogicalTypeId::UTINYINT:
+	case LogicalTypeId::USMALLINT:
+	case LogicalTypeId::UINTEGER:
+	case LogicalTypeId::UBIGINT:
+	case LogicalTypeId::INTEGER:
+	case LogicalTypeId::BIGINT:
+	case LogicalTypeId::FLOAT:
+	case LogicalTypeId::TIMESTAMP:
+	case LogicalTypeId::DOUBLE: {
+		auto &num_stats = (NumericStatistics &)stats;
+		for (auto &filter : filters) {
+			if (!num_stats.CheckZonemap(filter.comparison_type, filter.constant)) {
+				return false;
+			}
+		}
+		break;
+	}
+	case LogicalTypeId::BLOB:
+	case LogicalTypeId::VARCHAR: {
+		auto &str_stats = (StringStatistics &)stats;
+		for (auto &filter : filters) {
+			if (!str_stats.CheckZonemap(filter.comparison_type, filter.constant.str_value)) {
+				return false;
+			}
+		}
+		break;
+	}
+	default:
+		break;
+	}
+	return true;
+}
+
 } // namespace duckdb
@@ -1,5 +1,6 @@
 #include "parquet_writer.hpp"
 #include "parquet_timestamp.hpp"
+#include "parquet_rle_bp_encoder.hpp"
 
 #include "duckdb/function/table_function.hpp"
 #include "duckdb/parser/parsed_data/create_table_function_info.hpp"
@@ -11,6 +12,8 @@
 #include "duckdb/common/types/date.hpp"
 #include "duckdb/common/types/time.hpp"
 #include "duckdb/common/types/timestamp.hpp"
+#include "duckdb/common/types/hash.hpp"
+#include "duckdb/common/operator/comparison_operators.hpp"
 #include "duckdb/common/serializer/buffered_file_writer.hpp"
 #include "duckdb/common/serializer/buffered_serializer.hpp"
 
@@ -95,40 +98,358 @@ static bool DuckDBTypeToConvertedType(const LogicalType &duckdb_type, ConvertedT
 	}
 }
 
-static void VarintEncode(uint32_t val, Serializer &ser) {
-	do {
-		uint8_t byte = val & 127;
-		val >>= 7;
-		if (val != 0) {
-			byte |= 128;
+//! Column chunks are dictionary encoded as long as the plain-encoded dictionary stays below this size (in bytes)
+static constexpr idx_t PARQUET_MAX_DICTIONARY_SIZE = 1024 * 1024;
+
+//! Column chunks are split into data pages that hold this many vectors, so readers can skip pages using their
+//! statistics
+static constexpr idx_t PARQUET_PAGE_VECTOR_COUNT = 10;
+
+//! A single data page of a column chunk
+struct ParquetDataPage {
+	//! The range of chunks of the buffer that are written to this page
+	idx_t chunk_start;
+	idx_t chunk_end;
+	idx_t row_count = 0;
+	idx_t null_count = 0;
+	//! The definition levels and the values of the page
+	BufferedSerializer data;
+	parquet::format::Statistics statistics;
+};
+
+//! The encoded pages of a single column chunk, along with the statistics of the column chunk
+struct ParquetColumnChunkPages {
+	//! The plain-encoded values of the dictionary page, if the column chunk is dictionary encoded
+	unique_ptr<BufferedSerializer> dictionary;
+	idx_t dictionary_count = 0;
+	vector<unique_ptr<ParquetDataPage>> pages;
+	Encoding::type encoding = Encoding::PLAIN;
+	parquet::format::Statistics statistics;
+};
+
+template <class T>
+struct ParquetMinMax {
+	bool has_stats = false;
+	T min = T();
+	T max = T();
+
+	void Update(const T &value) {
+		if (!has_stats) {
+			min = value;
+			max = value;
+			has_stats = true;
+		} else if (LessThan::Operation<T>(value, min)) {
+			min = value;
+		} else if (GreaterThan::Operation<T>(value, max)) {
+			max = value;
+		}
+	}
+
+	void Combine(const ParquetMinMax<T> &other) {
+		if (other.has_stats) {
+			Update(other.min);
+			Update(other.max);
+		}
+	}
+
+	template <class OP>
+	void Write(parquet::format::Statistics &statistics) {
+		if (has_stats) {
+			statistics.__set_min_value(OP::StatisticsValue(min));
+			statistics.__set_max_value(OP::StatisticsValue(max));
+		}
+	}
+};
+
+//! Computes the min/max statistics of a page or column chunk, if the operator writes statistics
+template <class SRC, class OP, bool HAS_STATISTICS = OP::HAS_STATISTICS>
+struct ParquetStatisticsState {
+	ParquetMinMax<SRC> min_max;
+
+	void Update(const SRC &value) {
+		min_max.Update(value);
+	}
+	void Combine(const ParquetStatisticsState &other) {
+		min_max.Combine(other.min_max);
+	}
+	void Write(parquet::format::Statistics &statistics) {
+		min_max.template Write<OP>(statistics);
+	}
+};
+
+template <class SRC, class OP>
+struct ParquetStatisticsState<SRC, OP, false> {
+	void Update(const SRC &value) {
+	}
+	void Combine(const ParquetStatisticsState &other) {
+	}
+	void Write(parquet::format::Statistics &statistics) {
+	}
+};
+
+template <class SRC, class TGT>
+struct ParquetCastOperator {
+	static constexpr bool HAS_STATISTICS = true;
+
+	static void WritePlain(SRC input, Serializer &ser) {
+		ser.Write<TGT>((TGT)input);
+	}
+	static idx_t PlainSize(SRC input) {
+		return sizeof(TGT);
+	}
+	static string StatisticsValue(SRC input) {
+		auto value = (TGT)input;
+		return string((char *)&value, sizeof(TGT));
+	}
+};
+
+//! The sort order of INT96 is undefined by the Parquet specification, so no min/max statistics are written for
+//! timestamps and dates
+struct ParquetTimestampOperator {
+	static constexpr bool HAS_STATISTICS = false;
+
+	static Int96 Convert(timestamp_t input) {
+		return TimestampToImpalaTimestamp(input);
+	}
+	static void WritePlain(timestamp_t input, Serializer &ser) {
+		ser.Write<Int96>(Convert(input));
+	}
+	static idx_t PlainSize(timestamp_t input) {
+		return sizeof(Int96);
+	}
+};
+
+struct ParquetDateOperator {
+	static constexpr bool HAS_STATISTICS = false;
+
+	static void WritePlain(date_t input, Serializer &ser) {
+		ParquetTimestampOperator::WritePlain(Timestamp::FromDatetime(input, 0), ser);
+	}
+	static idx_t PlainSize(date_t input) {
+		return sizeof(Int96);
+	}
+};
+
+struct ParquetStringOperator {
+	static constexpr bool HAS_STATISTICS = true;
+
+	static void WritePlain(string_t input, Serializer &ser) {
+		ser.Write<uint32_t>(input.GetSize());
+		ser.WriteData((const_data_ptr_t)input.GetDataUnsafe(), input.GetSize());
+	}
+	static idx_t PlainSize(string_t input) {
+		return sizeof(uint32_t) + input.GetSize();
+	}
+	static string StatisticsValue(string_t input) {
+		return input.GetString();
+	}
+};
+
+template <class T>
+struct ParquetDictionaryHash {
+	size_t operator()(const T &val) const {
+		return Hash<T>(val);
+	}
+};
+
+template <class T>
+struct ParquetDictionaryEquality {
+	bool operator()(const T &a, const T &b) const {
+		return Equals::Operation<T>(a, b);
+	}
+};
+
+//! Floating point values are looked up in the dictionary by their bit pattern: values that Equals considers equal
+//! (e.g. -0.0 and 0.0) must still be written as they are
+template <class T, class BITS>
+struct ParquetFloatDictionaryHash {
+	size_t operator()(const T &val) const {
+		return Hash<BITS>(Load<BITS>((const_data_ptr_t)&val));
+	}
+};
+
+template <class T, class BITS>
+struct ParquetFloatDictionaryEquality {
+	bool operator()(const T &a, const T &b) const {
+		return Load<BITS>((const_data_ptr_t)&a) == Load<BITS>((const_data_ptr_t)&b);
+	}
+};
+
+template <>
+struct ParquetDictionaryHash<float> : public ParquetFloatDictionaryHash<float, uint32_t> {};
+template <>
+struct ParquetDictionaryHash<double> : public ParquetFloatDictionaryHash<double, uint64_t> {};
+template <>
+struct ParquetDictionaryEquality<float> : public ParquetFloatDictionaryEquality<float, uint32_t> {};
+template <>
+struct ParquetDictionaryEquality<double> : public ParquetFloatDictionaryEquality<double, uint64_t> {};
+
+//! Returns the column of the chunk that is written; DECIMAL columns are written as DOUBLE (for now...)
+static Vector &GetWriteVector(DataChunk &chunk, idx_t col_idx, const LogicalType &type, Vector &cast_vector) {
+	if (type.id() != LogicalTypeId::DECIMAL) {
+		return chunk.data[col_idx];
+	}
+	VectorOperations::Cast(chunk.data[col_idx], cast_vector, chunk.size());
+	return cast_vector;
+}
+
+static uint32_t DictionaryBitWidth(idx_t dictionary_count) {
+	uint32_t bit_width = 1;
+	while (bit_width < 32 && ((idx_t)1 << bit_width) < dictionary_count) {
+		bit_width++;
+	}
+	return bit_width;
+}
+
+//! Write the definition levels (i.e. the inverse of the nullmask) of the rows of a page
+static void WriteDefinitionLevels(ChunkCollection &buffer, idx_t col_idx, ParquetDataPage &page) {
+	vector<uint8_t> levels;
+	for (idx_t chunk_idx = page.chunk_start; chunk_idx < page.chunk_end; chunk_idx++) {
+		auto &chunk = buffer.GetChunk(chunk_idx);
+		auto &mask = FlatVector::Validity(chunk.data[col_idx]);
+		for (idx_t r = 0; r < chunk.size(); r++) {
+			bool is_valid = mask.RowIsValid(r);
+			levels.push_back(is_valid ? 1 : 0);
+			page.null_count += !is_valid;
 		}
-		ser.Write<uint8_t>(byte);
-	} while (val != 0);
+	}
+	page.row_count = levels.size();
+	// the levels are prefixed with their size in bytes
+	BufferedSerializer level_writer;
+	RleBpEncoder encoder(1);
+	encoder.Encode(level_writer, levels.data(), levels.size());
+	page.data.Write<uint32_t>(level_writer.blob.size);
+	page.data.WriteData(level_writer.blob.data.get(), level_writer.blob.size);
 }
 
-static uint8_t GetVarintSize(uint32_t val) {
-	uint8_t res = 0;
-	do {
-		uint8_t byte = val & 127;
-		val >>= 7;
-		if (val != 0) {
-			byte |= 128;
+static void WriteBooleanValues(ChunkCollection &buffer, idx_t col_idx, ParquetDataPage &page) {
+	// booleans are bit-packed
+	uint8_t byte = 0;
+	uint8_t byte_pos = 0;
+	for (idx_t chunk_idx = page.chunk_start; chunk_idx < page.chunk_end; chunk_idx++) {
+		auto &chunk = buffer.GetChunk(chunk_idx);
+		auto &input_column = chunk.data[col_idx];
+		auto *ptr = FlatVector::GetData<bool>(input_column);
+		auto &mask = FlatVector::Validity(input_column);
+		for (idx_t r = 0; r < chunk.size(); r++) {
+			if (mask.RowIsValid(r)) { // only encode if non-null
+				byte |= (ptr[r] & 1) << byte_pos;
+				byte_pos++;
+				if (byte_pos == 8) {
+					page.data.Write<uint8_t>(byte);
+					byte = 0;
+					byte_pos = 0;
+				}
+			}
 		}
-		res++;
-	} while (val != 0);
-	return res;
+	}
+	// flush last byte if req
+	if (byte_pos > 0) {
+		page.data.Write<uint8_t>(byte);
+	}
 }
 
-template <class SRC, class TGT>
-static void TemplatedWritePlain(Vector &col, idx_t length, ValidityMask &mask, Serializer &ser) {
-	auto *ptr = FlatVector::GetData<SRC>(col);
-	for (idx_t r = 0; r < length; r++) {
-		if (mask.RowIsValid(r)) {
-			ser.Write<TGT>((TGT)ptr[r]);
+//! Write the values of a column, using dictionary encoding if the column has few enough distinct values
+template <class SRC, class OP>
+static void WriteValues(ChunkCollection &buffer, idx_t col_idx, const LogicalType &type,
+                        ParquetColumnChunkPages &column_chunk) {
+	unordered_map<SRC, uint32_t, ParquetDictionaryHash<SRC>, ParquetDictionaryEquality<SRC>> dictionary_map;
+	vector<SRC> dictionary;
+	vector<uint32_t> dictionary_indices;
+	idx_t dictionary_size = 0;
+	bool use_dictionary = true;
+
+	// first pass: compute the statistics of every page and try to build the dictionary
+	Vector cast_vector(LogicalType::DOUBLE);
+	idx_t valid_count = 0;
+	ParquetStatisticsState<SRC, OP> column_stats;
+	for (auto &page : column_chunk.pages) {
+		ParquetStatisticsState<SRC, OP> page_stats;
+		for (idx_t chunk_idx = page->chunk_start; chunk_idx < page->chunk_end; chunk_idx++) {
+			auto &chunk = buffer.GetChunk(chunk_idx);
+			auto &input_column = GetWriteVector(chunk, col_idx, type, cast_vector);
+			auto *ptr = FlatVector::GetData<SRC>(input_column);
+			auto &mask = FlatVector::Validity(input_column);
+			for (idx_t r = 0; r < chunk.size(); r++) {
+				if (!mask.RowIsValid(r)) {
+					continue;
+				}
+				valid_count++;
+				page_stats.Update(ptr[r]);
+				if (!use_dictionary) {
+					continue;
+				}
+				auto entry = dictionary_map.find(ptr[r]);
+				if (entry != dictionary_map.end()) {
+					dictionary_indices.push_back(entry->second);
+					continue;
+				}
+				dictionary_size += OP::PlainSize(ptr[r]);
+				if (dictionary_size > PARQUET_MAX_DICTIONARY_SIZE) {
+					// the dictionary is too large: fall back to plain encoding
+					use_dictionary = false;
+					dictionary_map.clear();
+					dictionary.clear();
+					dictionary_indices.clear();
+					continue;
+				}
+				dictionary_map[ptr[r]] = dictionary.size();
+				dictionary_indices.push_back(dictionary.size());
+				dictionary.push_back(ptr[r]);
+			}
+		}
+		page_stats.Write(page->statistics);
+		column_stats.Combine(page_stats);
+	}
+	column_stats.Write(column_chunk.statistics);
+
+	// only use the dictionary if most values are repeated
+	if (use_dictionary && dictionary.size() * 2 <= valid_count) {
+		column_chunk.dictionary = make_unique<BufferedSerializer>();
+		for (auto &value : dictionary) {
+			OP::WritePlain(value, *column_chunk.dictionary);
+		}
+		column_chunk.dictionary_count = dictionary.size();
+		column_chunk.encoding = Encoding::RLE_DICTIONARY;
+
+		// every page holds the indices of its values, prefixed with their bit width
+		auto bit_width = DictionaryBitWidth(dictionary.size());
+		RleBpEncoder encoder(bit_width);
+		idx_t index_offset = 0;
+		for (auto &page : column_chunk.pages) {
+			auto page_value_count = page->row_count - page->null_count;
+			page->data.Write<uint8_t>(bit_width);
+			encoder.Encode(page->data, dictionary_indices.data() + index_offset, page_value_count);
+			index_offset += page_value_count;
+		}
+		D_ASSERT(index_offset == dictionary_indices.size());
+		return;
+	}
+
+	// second pass: write the values as PLAIN values
+	for (auto &page : column_chunk.pages) {
+		for (idx_t chunk_idx = page->chunk_start; chunk_idx < page->chunk_end; chunk_idx++) {
+			auto &chunk = buffer.GetChunk(chunk_idx);
+			auto &input_column = GetWriteVector(chunk, col_idx, type, cast_vector);
+			auto *ptr = FlatVector::GetData<SRC>(input_column);
+			auto &mask = FlatVector::Validity(input_column);
+			for (idx_t r = 0; r < chunk.size(); r++) {
+				if (mask.RowIsValid(r)) {
+					OP::WritePlain(ptr[r], page->data);
+				}
+			}
 		}
 	}
 }
 
+//! The deprecated min/max fields use signed comparisons, which only matches the sort order of numeric types
+static void SetLegacyStatistics(parquet::format::Statistics &statistics, Type::type type) {
+	if (statistics.__isset.min_value && type != Type::BYTE_ARRAY && type != Type::INT96) {
+		statistics.__set_min(statistics.min_value);
+		statistics.__set_max(statistics.max_value);
+	}
+}
+
 ParquetWriter::ParquetWriter(FileSystem &fs, string file_name_p, vector<LogicalType> types_p, vector<string> names_p,
                              CompressionCodec::type codec)
     : file_name(move(file_name_p)), sql_types(move(types_p)), column_names(move(names_p)), codec(codec) {
@@ -160,220 +481,218 @@ ParquetWriter::ParquetWriter(FileSystem &fs, string file_name_p, vector<LogicalT
 	}
 }
 
-void ParquetWriter::Flush(ChunkCollection &buffer) {
-	if (buffer.Count() == 0) {
-		return;
+idx_t ParquetWriter::WritePage(PageHeader &hdr, BufferedSerializer &temp_writer, BufferedSerializer &target,
+                               TProtocol &target_protocol) {
+	// now that we have finished writing the data we know the uncompressed size
+	hdr.uncompressed_page_size = temp_writer.blob.size;
+
+	// compress the data based
+	size_t compressed_size;
+	data_ptr_t compressed_data;
+	unique_ptr<data_t[]> compressed_buf;
+	switch (codec) {
+	case CompressionCodec::UNCOMPRESSED:
+		compressed_size = temp_writer.blob.size;
+		compressed_data = temp_writer.blob.data.get();
+		break;
+	case CompressionCodec::SNAPPY: {
+		compressed_size = snappy::MaxCompressedLength(temp_writer.blob.size);
+		compressed_buf = unique_ptr<data_t[]>(new data_t[compressed_size]);
+		snappy::RawCompress((const char *)temp_writer.blob.data.get(), temp_writer.blob.size,
+		                    (char *)compressed_buf.get(), &compressed_size);
+		compressed_data = compressed_buf.get();
+		break;
 	}
-	std::lock_guard<std::mutex> glock(lock);
+	case CompressionCodec::GZIP: {
+		MiniZStream s;
+		compressed_size = s.MaxCompressedLength(temp_writer.blob.size);
+		compressed_buf = unique_ptr<data_t[]>(new data_t[compressed_size]);
+		s.Compress((const char *)temp_writer.blob.data.get(), temp_writer.blob.size, (char *)compressed_buf.get(),
+		           &compressed_size);
+		compressed_data = compressed_buf.get();
+		break;
+	}
+	case CompressionCodec::ZSTD: {
+		compressed_size = duckdb_zstd::ZSTD_compressBound(temp_writer.blob.size);
+		compressed_buf = unique_ptr<data_t[]>(new data_t[compressed_size]);
+		compressed_size = duckdb_zstd::ZSTD_compress((void *)compressed_buf.get(), compressed_size,
+		                                             (const void *)temp_writer.blob.data.get(),
+		                                             temp_writer.blob.size, ZSTD_CLEVEL_DEFAULT);
+		compressed_data = compressed_buf.get();
+		break;
+	}
+	default:
+		throw InternalException("Unsupported codec for Parquet Writer");
+	}
+
+	hdr.compressed_page_size = compressed_size;
+	// now finally write the data to the actual file
+	auto header_start = target.blob.size;
+	hdr.write(&target_protocol);
+	auto header_size = target.blob.size - header_start;
+	target.WriteData(compressed_data, compressed_size);
+	return header_size + hdr.uncompressed_page_size;
+}
+
+void ParquetWriter::PrepareRowGroup(ChunkCollection &buffer, PreparedRowGroup &result) {
+	// the pages of the row group are written to the buffer of the prepared row group
+	// the offsets in the meta data are relative to the start of the buffer, until the row group is flushed
+	TCompactProtocolFactoryT<MyTransport> tproto_factory;
+	auto data_protocol = tproto_factory.getProtocol(make_shared<MyTransport>(result.data));
 
 	// set up a new row group for this chunk collection
-	RowGroup row_group;
+	auto &row_group = result.row_group;
 	row_group.num_rows = 0;
-	row_group.file_offset = writer->GetTotalWritten();
+	row_group.total_byte_size = 0;
+	row_group.file_offset = 0;
 	row_group.__isset.file_offset = true;
 	row_group.columns.resize(buffer.ColumnCount());
 
 	// iterate over each of the columns of the chunk collection and write them
 	for (idx_t i = 0; i < buffer.ColumnCount(); i++) {
-		// we start off by writing everything into a temporary buffer
+		// we start off by writing everything into temporary buffers
 		// this is necessary to (1) know the total written size, and (2) to compress it afterwards
-		BufferedSerializer temp_writer;
-
-		// set up some metadata
-		PageHeader hdr;
-		hdr.compressed_page_size = 0;
-		hdr.uncompressed_page_size = 0;
-		hdr.type = PageType::DATA_PAGE;
-		hdr.__isset.data_page_header = true;
-
-		hdr.data_page_header.num_values = buffer.Count();
-		hdr.data_page_header.encoding = Encoding::PLAIN;
-		hdr.data_page_header.definition_level_encoding = Encoding::RLE;
-		hdr.data_page_header.repetition_level_encoding = Encoding::BIT_PACKED;
-
-		// record the current offset of the writer into the file
-		// this is the starting position of the current page
-		auto start_offset = writer->GetTotalWritten();
-
-		// write the definition levels (i.e. the inverse of the nullmask)
-		// we always bit pack everything
-
-		// first figure out how many bytes we need (1 byte per 8 rows, rounded up)
-		auto define_byte_count = (buffer.Count() + 7) / 8;
-		// we need to set up the count as a varint, plus an added marker for the RLE scheme
-		// for this marker we shift the count left 1 and set low bit to 1 to indicate bit packed literals
-		uint32_t define_header = (define_byte_count << 1) | 1;
-		uint32_t define_size = GetVarintSize(define_header) + define_byte_count;
-
-		// we write the actual definitions into the temp_writer for now
-		temp_writer.Write<uint32_t>(define_size);
-		VarintEncode(define_header, temp_writer);
-
-		for (auto &chunk : buffer.Chunks()) {
-			auto &validity = FlatVector::Validity(chunk->data[i]);
-			auto validity_data = validity.GetData();
-			auto chunk_define_byte_count = (chunk->size() + 7) / 8;
-			if (!validity_data) {
-				ValidityMask nop_mask(chunk->size());
-				temp_writer.WriteData((const_data_ptr_t)nop_mask.GetData(), chunk_define_byte_count);
-			} else {
-				// write the bits of the nullmask
-				temp_writer.WriteData((const_data_ptr_t)validity_data, chunk_define_byte_count);
-			}
+		ParquetColumnChunkPages column_pages;
+		idx_t null_count = 0;
+		for (idx_t chunk_idx = 0; chunk_idx < buffer.ChunkCount(); chunk_idx += PARQUET_PAGE_VECTOR_COUNT) {
+			auto page = make_unique<ParquetDataPage>();
+			page->chunk_start = chunk_idx;
+			page->chunk_end = MinValue<idx_t>(chunk_idx + PARQUET_PAGE_VECTOR_COUNT, buffer.ChunkCount());
+			// write the definition levels
+			WriteDefinitionLevels(buffer, i, *page);
+			null_count += page->null_count;
+			column_pages.pages.push_back(move(page));
 		}
 
-		// now write the actual payload: we write this as PLAIN values (for now? possibly for ever?)
-		for (auto &chunk : buffer.Chunks()) {
-			auto &input = *chunk;
-			auto &input_column = input.data[i];
-			auto &mask = FlatVector::Validity(input_column);
-
-			// write actual payload data
-			switch (sql_types[i].id()) {
-			case LogicalTypeId::BOOLEAN: {
-				auto *ptr = FlatVector::GetData<bool>(input_column);
-				uint8_t byte = 0;
-				uint8_t byte_pos = 0;
-				for (idx_t r = 0; r < input.size(); r++) {
-					if (mask.RowIsValid(r)) { // only encode if non-null
-						byte |= (ptr[r] & 1) << byte_pos;
-						byte_pos++;
-
-						temp_writer.Write<uint8_t>(byte);
-						if (byte_pos == 8) {
-							temp_writer.Write<uint8_t>(byte);
-							byte = 0;
-							byte_pos = 0;
-						}
-					}
-				}
-				// flush last byte if req
-				if (byte_pos > 0) {
-					temp_writer.Write<uint8_t>(byte);
-				}
-				break;
-			}
-			case LogicalTypeId::TINYINT:
-				TemplatedWritePlain<int8_t, int32_t>(input_column, input.size(), mask, temp_writer);
-				break;
-			case LogicalTypeId::SMALLINT:
-				TemplatedWritePlain<int16_t, int32_t>(input_column, input.size(), mask, temp_writer);
-				break;
-			case LogicalTypeId::INTEGER:
-				TemplatedWritePlain<int32_t, int32_t>(input_column, input.size(), mask, temp_writer);
-				break;
-			case LogicalTypeId::BIGINT:
-				TemplatedWritePlain<int64_t, int64_t>(input_column, input.size(), mask, temp_writer);
-				break;
-			case LogicalTypeId::FLOAT:
-				TemplatedWritePlain<float, float>(input_column, input.size(), mask, temp_writer);
-				break;
-			case LogicalTypeId::DECIMAL: {
-				// FIXME: fixed length byte array...
-				Vector double_vec(LogicalType::DOUBLE);
-				VectorOperations::Cast(input_column, double_vec, input.size());
-				TemplatedWritePlain<double, double>(double_vec, input.size(), mask, temp_writer);
-				break;
-			}
-			case LogicalTypeId::DOUBLE:
-				TemplatedWritePlain<double, double>(input_column, input.size(), mask, temp_writer);
-				break;
-			case LogicalTypeId::DATE: {
-				auto *ptr = FlatVector::GetData<date_t>(input_column);
-				for (idx_t r = 0; r < input.size(); r++) {
-					if (mask.RowIsValid(r)) {
-						auto ts = Timestamp::FromDatetime(ptr[r], 0);
-						temp_writer.Write<Int96>(TimestampToImpalaTimestamp(ts));
-					}
-				}
-				break;
+		// now write the actual payload
+		switch (sql_types[i].id()) {
+		case LogicalTypeId::BOOLEAN:
+			for (auto &page : column_pages.pages) {
+				WriteBooleanValues(buffer, i, *page);
 			}
-			case LogicalTypeId::TIMESTAMP: {
-				auto *ptr = FlatVector::GetData<timestamp_t>(input_column);
-				for (idx_t r = 0; r < input.size(); r++) {
-					if (mask.RowIsValid(r)) {
-						temp_writer.Write<Int96>(TimestampToImpalaTimestamp(ptr[r]));
-					}
-				}
-				break;
-			}
-			case LogicalTypeId::BLOB:
-			case LogicalTypeId::VARCHAR: {
-				auto *ptr = FlatVector::GetData<string_t>(input_column);
-				for (idx_t r = 0; r < input.size(); r++) {
-					if (mask.RowIsValid(r)) {
-						temp_writer.Write<uint32_t>(ptr[r].GetSize());
-						temp_writer.WriteData((const_data_ptr_t)ptr[r].GetDataUnsafe(), ptr[r].GetSize());
-					}
-				}
-				break;
-			}
-			default:
-				throw NotImplementedException((sql_types[i].ToString()));
-			}
-		}
-
-		// now that we have finished writing the data we know the uncompressed size
-		hdr.uncompressed_page_size = temp_writer.blob.size;
-
-		// compress the data based
-		size_t compressed_size;
-		data_ptr_t compressed_data;
-		unique_ptr<data_t[]> compressed_buf;
-		switch (codec) {
-		case CompressionCodec::UNCOMPRESSED:
-			compressed_size = temp_writer.blob.size;
-			compressed_data = temp_writer.blob.data.get();
 			break;
-		case CompressionCodec::SNAPPY: {
-			compressed_size = snappy::MaxCompressedLength(temp_writer.blob.size);
-			compressed_buf = unique_ptr<data_t[]>(new data_t[compressed_size]);
-			snappy::RawCompress((const char *)temp_writer.blob.data.get(), temp_writer.blob.size,
-			                    (char *)compressed_buf.get(), &compressed_size);
-			compressed_data = compressed_buf.get();
+		case LogicalTypeId::TINYINT:
+			WriteValues<int8_t, ParquetCastOperator<int8_t, int32_t>>(buffer, i, sql_types[i], column_pages);
 			break;
-		}
-		case CompressionCodec::GZIP: {
-			MiniZStream s;
-			compressed_size = s.MaxCompressedLength(temp_writer.blob.size);
-			compressed_buf = unique_ptr<data_t[]>(new data_t[compressed_size]);
-			s.Compress((const char *)temp_writer.blob.data.get(), temp_writer.blob.size, (char *)compressed_buf.get(),
-			           &compressed_size);
-			compressed_data = compressed_buf.get();
+		case LogicalTypeId::SMALLINT:
+			WriteValues<int16_t, ParquetCastOperator<int16_t, int32_t>>(buffer, i, sql_types[i], column_pages);
 			break;
-		}
-		case CompressionCodec::ZSTD: {
-			compressed_size = duckdb_zstd::ZSTD_compressBound(temp_writer.blob.size);
-			compressed_buf = unique_ptr<data_t[]>(new data_t[compressed_size]);
-			compressed_size = duckdb_zstd::ZSTD_compress((void *)compressed_buf.get(), compressed_size,
-			                                             (const void *)temp_writer.blob.data.get(),
-			                                             temp_writer.blob.size, ZSTD_CLEVEL_DEFAULT);
-			compressed_data = compressed_buf.get();
+		case LogicalTypeId::INTEGER:
+			WriteValues<int32_t, ParquetCastOperator<int32_t, int32_t>>(buffer, i, sql_types[i], column_pages);
+			break;
+		case LogicalTypeId::BIGINT:
+			WriteValues<int64_t, ParquetCastOperator<int64_t, int64_t>>(buffer, i, sql_types[i], column_pages);
+			break;
+		case LogicalTypeId::FLOAT:
+			WriteValues<float, ParquetCastOperator<float, float>>(buffer, i, sql_types[i], column_pages);
+			break;
+		case LogicalTypeId::DECIMAL:
+		case LogicalTypeId::DOUBLE:
+			WriteValues<double, ParquetCastOperator<double, double>>(buffer, i, sql_types[i], column_pages);
+			break;
+		case LogicalTypeId::DATE:
+			WriteValues<date_t, ParquetDateOperator>(buffer, i, sql_types[i], column_pages);
+			break;
+		case LogicalTypeId::TIMESTAMP:
+			WriteValues<timestamp_t, ParquetTimestampOperator>(buffer, i, sql_types[i], column_pages);
+			break;
+		case LogicalTypeId::BLOB:
+		case LogicalTypeId::VARCHAR:
+			WriteValues<string_t, ParquetStringOperator>(buffer, i, sql_types[i], column_pages);
 			break;
-		}
 		default:
-			throw InternalException("Unsupported codec for Parquet Writer");
+			throw NotImplementedException((sql_types[i].ToString()));
 		}
 
-		hdr.compressed_page_size = compressed_size;
-		// now finally write the data to the actual file
-		hdr.write(protocol.get());
-		writer->WriteData(compressed_data, compressed_size);
-
 		auto &column_chunk = row_group.columns[i];
 		column_chunk.__isset.meta_data = true;
-		column_chunk.meta_data.data_page_offset = start_offset;
-		column_chunk.meta_data.total_compressed_size = writer->GetTotalWritten() - start_offset;
-		column_chunk.meta_data.codec = codec;
-		column_chunk.meta_data.path_in_schema.push_back(file_meta_data.schema[i + 1].name);
-		column_chunk.meta_data.num_values = buffer.Count();
-		column_chunk.meta_data.type = file_meta_data.schema[i + 1].type;
+		auto &meta_data = column_chunk.meta_data;
+		meta_data.total_uncompressed_size = 0;
+		meta_data.type = file_meta_data.schema[i + 1].type;
+
+		// record the current offset of the writer into the file
+		// this is the starting position of the column chunk
+		auto start_offset = result.data.blob.size;
+		if (column_pages.dictionary) {
+			// the dictionary page precedes the data pages
+			PageHeader hdr;
+			hdr.type = PageType::DICTIONARY_PAGE;
+			hdr.__isset.dictionary_page_header = true;
+			hdr.dictionary_page_header.num_values = column_pages.dictionary_count;
+			hdr.dictionary_page_header.encoding = Encoding::PLAIN;
+
+			meta_data.dictionary_page_offset = start_offset;
+			meta_data.__isset.dictionary_page_offset = true;
+			meta_data.total_uncompressed_size +=
+			    WritePage(hdr, *column_pages.dictionary, result.data, *data_protocol);
+		}
+
+		meta_data.data_page_offset = result.data.blob.size;
+		for (auto &page : column_pages.pages) {
+			PageHeader hdr;
+			hdr.type = PageType::DATA_PAGE;
+			hdr.__isset.data_page_header = true;
+			hdr.data_page_header.num_values = page->row_count;
+			hdr.data_page_header.encoding = column_pages.encoding;
+			hdr.data_page_header.definition_level_encoding = Encoding::RLE;
+			hdr.data_page_header.repetition_level_encoding = Encoding::BIT_PACKED;
+
+			// the page statistics allow readers to skip pages
+			page->statistics.__set_null_count(page->null_count);
+			SetLegacyStatistics(page->statistics, meta_data.type);
+			hdr.data_page_header.__set_statistics(page->statistics);
+
+			meta_data.total_uncompressed_size += WritePage(hdr, page->data, result.data, *data_protocol);
+		}
+		meta_data.total_compressed_size = result.data.blob.size - start_offset;
+		meta_data.codec = codec;
+		meta_data.path_in_schema.push_back(file_meta_data.schema[i + 1].name);
+		meta_data.num_values = buffer.Count();
+		meta_data.encodings.push_back(Encoding::PLAIN);
+		meta_data.encodings.push_back(Encoding::RLE);
+		if (column_pages.dictionary) {
+			meta_data.encodings.push_back(Encoding::RLE_DICTIONARY);
+		}
+
+		auto &statistics = column_pages.statistics;
+		statistics.__set_null_count(null_count);
+		SetLegacyStatistics(statistics, meta_data.type);
+		meta_data.__set_statistics(statistics);
+
+		row_group.total_byte_size += meta_data.total_uncompressed_size;
 	}
 	row_group.num_rows += buffer.Count();
+}
+
+void ParquetWriter::FlushRowGroup(PreparedRowGroup &prepared) {
+	std::lock_guard<std::mutex> glock(lock);
+	auto &row_group = prepared.row_group;
+	if (row_group.num_rows == 0) {
+		return;
+	}
+	// now that we know where the row group is written, make its offsets absolute
+	auto start_offset = writer->GetTotalWritten();
+	row_group.file_offset += start_offset;
+	for (auto &column_chunk : row_group.columns) {
+		column_chunk.meta_data.data_page_offset += start_offset;
+		if (column_chunk.meta_data.__isset.dictionary_page_offset) {
+			column_chunk.meta_data.dictionary_page_offset += start_offset;
+		}
+	}
+	writer->WriteData(prepared.data.blob.data.get(), prepared.data.blob.size);
 
 	// append the row group to the file meta data
 	file_meta_data.row_groups.push_back(row_group);
-	file_meta_data.num_rows += buffer.Count();
+	file_meta_data.num_rows += row_group.num_rows;
+}
+
+void ParquetWriter::Flush(ChunkCollection &buffer) {
+	if (buffer.Count() == 0) {
+		return;
+	}
+	PreparedRowGroup prepared;
+	PrepareRowGroup(buffer, prepared);
+	FlushRowGroup(prepared);
 }
 
 void ParquetWriter::Finalize() {
@@ -62,10 +62,16 @@ TableCatalogEntry::TableCatalogEntry(Catalog *catalog, SchemaCatalogEntry *schem
 		name_map["rowid"] = COLUMN_IDENTIFIER_ROW_ID;
 	}
 	if (!storage) {
+		// the indexes of the table that were written to disk (if any)
+		vector<BlockPointer> index_pointers;
+		if (info->data) {
+			index_pointers = move(info->data->indexes);
+		}
 		// create the physical storage
 		storage = make_shared<DataTable>(catalog->db, schema->name, name, GetTypes(), move(info->data));
 
 		// create the unique indexes for the UNIQUE and PRIMARY KEY constraints
+		idx_t index_nr = 0;
 		for (idx_t i = 0; i < bound_constraints.size(); i++) {
 			auto &constraint = bound_constraints[i];
 			if (constraint->type == ConstraintType::UNIQUE) {
@@ -87,7 +93,14 @@ TableCatalogEntry::TableCatalogEntry(Catalog *catalog, SchemaCatalogEntry *schem
 				}
 				// create an adaptive radix tree around the expressions
 				auto art = make_unique<ART>(column_ids, move(unbound_expressions), true);
-				storage->AddIndex(move(art), bound_expressions);
+				if (index_nr < index_pointers.size()) {
+					// the index is stored on disk: read it lazily instead of rebuilding it from the table data
+					art->Deserialize(catalog->db, index_pointers[index_nr]);
+					storage->info->indexes.push_back(move(art));
+				} else {
+					storage->AddIndex(move(art), bound_expressions);
+				}
+				index_nr++;
 			}
 		}
 	}
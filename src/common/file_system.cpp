@@ -170,6 +170,67 @@ int64_t FileSystem::Write(FileHandle &handle, void *buffer, int64_t nr_bytes) {
 	return bytes_written;
 }
 
+void FileSystem::Read(FileHandle &handle, void *buffer, int64_t nr_bytes, idx_t location) {
+	auto local_handle = dynamic_cast<UnixFileHandle *>(&handle);
+	if (!local_handle) {
+		// not a local file: seek to the location and read with the (virtual) sequential read of the file system
+		SetFilePointer(handle, location);
+		int64_t bytes_read = Read(handle, buffer, nr_bytes);
+		if (bytes_read != nr_bytes) {
+			throw IOException("Could not read sufficient bytes from file \"%s\"", handle.path);
+		}
+		return;
+	}
+	int fd = local_handle->fd;
+	auto read_buffer = (char *)buffer;
+	while (nr_bytes > 0) {
+		// pread does not use (or move) the file pointer, so multiple threads can read from the same handle at once
+		int64_t bytes_read = pread(fd, read_buffer, nr_bytes, location);
+		if (bytes_read == -1) {
+			if (errno == EINTR) {
+				continue;
+			}
+			throw IOException("Could not read from file \"%s\": %s", handle.path, strerror(errno));
+		}
+		if (bytes_read == 0) {
+			throw IOException("Could not read sufficient bytes from file \"%s\"", handle.path);
+		}
+		read_buffer += bytes_read;
+		nr_bytes -= bytes_read;
+		location += bytes_read;
+	}
+}
+
+void FileSystem::Write(FileHandle &handle, void *buffer, int64_t nr_bytes, idx_t location) {
+	auto local_handle = dynamic_cast<UnixFileHandle *>(&handle);
+	if (!local_handle) {
+		// not a local file: seek to the location and write with the (virtual) sequential write of the file system
+		SetFilePointer(handle, location);
+		int64_t bytes_written = Write(handle, buffer, nr_bytes);
+		if (bytes_written != nr_bytes) {
+			throw IOException("Could not write sufficient bytes from file \"%s\"", handle.path);
+		}
+		return;
+	}
+	int fd = local_handle->fd;
+	auto write_buffer = (char *)buffer;
+	while (nr_bytes > 0) {
+		int64_t bytes_written = pwrite(fd, write_buffer, nr_bytes, location);
+		if (bytes_written == -1) {
+			if (errno == EINTR) {
+				continue;
+			}
+			throw IOException("Could not write file \"%s\": %s", handle.path, strerror(errno));
+		}
+		if (bytes_written == 0) {
+			throw IOException("Could not write sufficient bytes from file \"%s\"", handle.path);
+		}
+		write_buffer += bytes_written;
+		nr_bytes -= bytes_written;
+		location += bytes_written;
+	}
+}
+
 int64_t FileSystem::GetFileSize(FileHandle &handle) {
 	int fd = ((UnixFileHandle &)handle).fd;
 	struct stat s;
@@ -286,10 +347,9 @@ void FileSystem::RemoveFile(const string &filename) {
 	}
 }
 
-bool FileSystem::ListFiles(const string &directory, const std::function<void(string, bool)> &callback) {
-	if (!DirectoryExists(directory)) {
-		return false;
-	}
+//! List the files in a directory, invoking the callback method for each one with (filename, is_dir, file_info)
+static bool ListDirectory(FileSystem &fs, const string &directory,
+                          const std::function<void(const string &, bool, const FileInfo &)> &callback) {
 	DIR *dir = opendir(directory.c_str());
 	if (!dir) {
 		return false;
@@ -303,7 +363,7 @@ bool FileSystem::ListFiles(const string &directory, const std::function<void(str
 			continue;
 		}
 		// now stat the file to figure out if it is a regular file or directory
-		string full_path = JoinPath(directory, name);
+		string full_path = fs.JoinPath(directory, name);
 		if (access(full_path.c_str(), 0) != 0) {
 			continue;
 		}
@@ -313,13 +373,33 @@ bool FileSystem::ListFiles(const string &directory, const std::function<void(str
 			// not a file or directory: skip
 			continue;
 		}
+		FileInfo file_info;
+		file_info.file_size = status.st_size;
+		file_info.last_modified = status.st_mtime;
 		// invoke callback
-		callback(name, status.st_mode & S_IFDIR);
+		callback(name, status.st_mode & S_IFDIR, file_info);
 	}
 	closedir(dir);
 	return true;
 }
 
+bool FileSystem::ListFiles(const string &directory, const std::function<void(string, bool)> &callback) {
+	if (!DirectoryExists(directory)) {
+		return false;
+	}
+	return ListDirectory(*this, directory, [&](const string &name, bool is_directory, const FileInfo &) {
+		callback(name, is_directory);
+	});
+}
+
+bool FileSystem::ListFiles(const string &directory,
+                           const std::function<void(const string &, bool, const FileInfo &)> &callback) {
+	if (!DirectoryExists(directory)) {
+		return false;
+	}
+	return ListDirectory(*this, directory, callback);
+}
+
 string FileSystem::PathSeparator() {
 	return "/";
 }
@@ -473,6 +553,75 @@ int64_t FileSystem::Write(FileHandle &handle, void *buffer, int64_t nr_bytes) {
 	return bytes_read;
 }
 
+static OVERLAPPED SetOverlappedOffset(idx_t location) {
+	OVERLAPPED overlapped;
+	memset(&overlapped, 0, sizeof(OVERLAPPED));
+	overlapped.Offset = location & 0xFFFFFFFF;
+	overlapped.OffsetHigh = location >> 32;
+	return overlapped;
+}
+
+void FileSystem::Read(FileHandle &handle, void *buffer, int64_t nr_bytes, idx_t location) {
+	auto local_handle = dynamic_cast<WindowsFileHandle *>(&handle);
+	if (!local_handle) {
+		// not a local file: seek to the location and read with the (virtual) sequential read of the file system
+		SetFilePointer(handle, location);
+		int64_t bytes_read = Read(handle, buffer, nr_bytes);
+		if (bytes_read != nr_bytes) {
+			throw IOException("Could not read sufficient bytes from file \"%s\"", handle.path);
+		}
+		return;
+	}
+	HANDLE hFile = local_handle->fd;
+	auto read_buffer = (char *)buffer;
+	while (nr_bytes > 0) {
+		// the read location is passed in the OVERLAPPED structure instead of moving the file pointer first
+		auto overlapped = SetOverlappedOffset(location);
+		DWORD bytes_read;
+		auto rc = ReadFile(hFile, read_buffer, (DWORD)nr_bytes, &bytes_read, &overlapped);
+		if (rc == 0) {
+			auto error = GetLastErrorAsString();
+			throw IOException("Could not read file \"%s\": %s", handle.path, error);
+		}
+		if (bytes_read == 0) {
+			throw IOException("Could not read sufficient bytes from file \"%s\"", handle.path);
+		}
+		read_buffer += bytes_read;
+		nr_bytes -= bytes_read;
+		location += bytes_read;
+	}
+}
+
+void FileSystem::Write(FileHandle &handle, void *buffer, int64_t nr_bytes, idx_t location) {
+	auto local_handle = dynamic_cast<WindowsFileHandle *>(&handle);
+	if (!local_handle) {
+		// not a local file: seek to the location and write with the (virtual) sequential write of the file system
+		SetFilePointer(handle, location);
+		int64_t bytes_written = Write(handle, buffer, nr_bytes);
+		if (bytes_written != nr_bytes) {
+			throw IOException("Could not write sufficient bytes from file \"%s\"", handle.path);
+		}
+		return;
+	}
+	HANDLE hFile = local_handle->fd;
+	auto write_buffer = (char *)buffer;
+	while (nr_bytes > 0) {
+		auto overlapped = SetOverlappedOffset(location);
+		DWORD bytes_written;
+		auto rc = WriteFile(hFile, write_buffer, (DWORD)nr_bytes, &bytes_written, &overlapped);
+		if (rc == 0) {
+			auto error = GetLastErrorAsString();
+			throw IOException("Could not write file \"%s\": %s", handle.path, error);
+		}
+		if (bytes_written == 0) {
+			throw IOException("Could not write sufficient bytes from file \"%s\"", handle.path);
+		}
+		write_buffer += bytes_written;
+		nr_bytes -= bytes_written;
+		location += bytes_written;
+	}
+}
+
 int64_t FileSystem::GetFileSize(FileHandle &handle) {
 	HANDLE hFile = ((WindowsFileHandle &)handle).fd;
 	LARGE_INTEGER result;
@@ -482,19 +631,11 @@ int64_t FileSystem::GetFileSize(FileHandle &handle) {
 	return result.QuadPart;
 }
 
-time_t FileSystem::GetLastModifiedTime(FileHandle &handle) {
-	HANDLE hFile = ((WindowsFileHandle &)handle).fd;
-
-	// https://docs.microsoft.com/en-us/windows/win32/api/fileapi/nf-fileapi-getfiletime
-	FILETIME last_write;
-	if (GetFileTime(hFile, nullptr, nullptr, &last_write) == 0) {
-		return -1;
-	}
-
+static time_t FileTimeToUnixTime(const FILETIME &file_time) {
 	// https://stackoverflow.com/questions/29266743/what-is-dwlowdatetime-and-dwhighdatetime
 	ULARGE_INTEGER ul;
-	ul.LowPart = last_write.dwLowDateTime;
-	ul.HighPart = last_write.dwHighDateTime;
+	ul.LowPart = file_time.dwLowDateTime;
+	ul.HighPart = file_time.dwHighDateTime;
 	int64_t fileTime64 = ul.QuadPart;
 
 	// fileTime64 contains a 64-bit value representing the number of
@@ -508,6 +649,17 @@ time_t FileSystem::GetLastModifiedTime(FileHandle &handle) {
 	return result;
 }
 
+time_t FileSystem::GetLastModifiedTime(FileHandle &handle) {
+	HANDLE hFile = ((WindowsFileHandle &)handle).fd;
+
+	// https://docs.microsoft.com/en-us/windows/win32/api/fileapi/nf-fileapi-getfiletime
+	FILETIME last_write;
+	if (GetFileTime(hFile, nullptr, nullptr, &last_write) == 0) {
+		return -1;
+	}
+	return FileTimeToUnixTime(last_write);
+}
+
 void FileSystem::Truncate(FileHandle &handle, int64_t new_size) {
 	HANDLE hFile = ((WindowsFileHandle &)handle).fd;
 	// seek to the location
@@ -592,8 +744,9 @@ void FileSystem::RemoveFile(const string &filename) {
 	DeleteFileA(filename.c_str());
 }
 
-bool FileSystem::ListFiles(const string &directory, const std::function<void(string, bool)> &callback) {
-	string search_dir = JoinPath(directory, "*");
+static bool ListDirectory(FileSystem &fs, const string &directory,
+                          const std::function<void(const string &, bool, const FileInfo &)> &callback) {
+	string search_dir = fs.JoinPath(directory, "*");
 
 	WIN32_FIND_DATA ffd;
 	HANDLE hFind = FindFirstFile(search_dir.c_str(), &ffd);
@@ -605,7 +758,13 @@ bool FileSystem::ListFiles(const string &directory, const std::function<void(str
 		if (cFileName == "." || cFileName == "..") {
 			continue;
 		}
-		callback(cFileName, ffd.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY);
+		ULARGE_INTEGER file_size;
+		file_size.LowPart = ffd.nFileSizeLow;
+		file_size.HighPart = ffd.nFileSizeHigh;
+		FileInfo file_info;
+		file_info.file_size = file_size.QuadPart;
+		file_info.last_modified = FileTimeToUnixTime(ffd.ftLastWriteTime);
+		callback(cFileName, ffd.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY, file_info);
 	} while (FindNextFile(hFind, &ffd) != 0);
 
 	DWORD dwError = GetLastError();
@@ -618,6 +777,17 @@ bool FileSystem::ListFiles(const string &directory, const std::function<void(str
 	return true;
 }
 
+bool FileSystem::ListFiles(const string &directory, const std::function<void(string, bool)> &callback) {
+	return ListDirectory(*this, directory, [&](const string &name, bool is_directory, const FileInfo &) {
+		callback(name, is_directory);
+	});
+}
+
+bool FileSystem::ListFiles(const string &directory,
+                           const std::function<void(const string &, bool, const FileInfo &)> &callback) {
+	return ListDirectory(*this, directory, callback);
+}
+
 string FileSystem::PathSeparator() {
 	return "\\";
 }
@@ -671,26 +841,6 @@ string FileSystem::GetHomeDirectory() {
 	return homedir;
 }
 
-void FileSystem::Read(FileHandle &handle, void *buffer, int64_t nr_bytes, idx_t location) {
-	// seek to the location
-	SetFilePointer(handle, location);
-	// now read from the location
-	int64_t bytes_read = Read(handle, buffer, nr_bytes);
-	if (bytes_read != nr_bytes) {
-		throw IOException("Could not read sufficient bytes from file \"%s\"", handle.path);
-	}
-}
-
-void FileSystem::Write(FileHandle &handle, void *buffer, int64_t nr_bytes, idx_t location) {
-	// seek to the location
-	SetFilePointer(handle, location);
-	// now write to the location
-	int64_t bytes_written = Write(handle, buffer, nr_bytes);
-	if (bytes_written != nr_bytes) {
-		throw IOException("Could not write sufficient bytes from file \"%s\"", handle.path);
-	}
-}
-
 string FileSystem::JoinPath(const string &a, const string &b) {
 	// FIXME: sanitize paths
 	return a + PathSeparator() + b;
@@ -704,6 +854,10 @@ void FileHandle::Write(void *buffer, idx_t nr_bytes, idx_t location) {
 	file_system.Write(*this, buffer, nr_bytes, location);
 }
 
+void FileHandle::Prefetch(const vector<pair<idx_t, idx_t>> &ranges) {
+	file_system.Prefetch(*this, ranges);
+}
+
 void FileHandle::Sync() {
 	file_system.FileSync(*this);
 }
@@ -726,9 +880,10 @@ static bool HasGlob(const string &str) {
 	return false;
 }
 
-static void GlobFiles(FileSystem &fs, const string &path, const string &glob, bool match_directory,
-                      vector<string> &result, bool join_path) {
-	fs.ListFiles(path, [&](const string &fname, bool is_directory) {
+//! Returns false if the directory could not be listed with the info of its files, if file_info is set
+static bool GlobFiles(FileSystem &fs, const string &path, const string &glob, bool match_directory,
+                      vector<string> &result, bool join_path, vector<FileInfo> *file_info) {
+	auto callback = [&](const string &fname, bool is_directory, const FileInfo &info) {
 		if (is_directory != match_directory) {
 			return;
 		}
@@ -738,11 +893,22 @@ static void GlobFiles(FileSystem &fs, const string &path, const string &glob, bo
 			} else {
 				result.push_back(fname);
 			}
+			if (file_info) {
+				file_info->push_back(info);
+			}
 		}
-	});
+	};
+	if (file_info) {
+		return fs.ListFiles(path, callback);
+	}
+	fs.ListFiles(path, [&](const string &fname, bool is_directory) { callback(fname, is_directory, FileInfo()); });
+	return true;
 }
 
-vector<string> FileSystem::Glob(const string &path) {
+//! Runs a glob on the file system; if file_info is set, the info of the matching files is gathered as well, if they are
+//! found by listing a directory. has_file_info is set to false if a directory could not be listed with the file info.
+static vector<string> GlobInternal(FileSystem &fs, const string &path, vector<FileInfo> *file_info,
+                                   bool &has_file_info) {
 	if (path.empty()) {
 		return vector<string>();
 	}
@@ -750,7 +916,7 @@ vector<string> FileSystem::Glob(const string &path) {
 	if (!HasGlob(path)) {
 		// no glob: return only the file (if it exists)
 		vector<string> result;
-		if (FileExists(path)) {
+		if (fs.FileExists(path)) {
 			result.push_back(path);
 		}
 		return result;
@@ -784,7 +950,7 @@ vector<string> FileSystem::Glob(const string &path) {
 		absolute_path = true;
 	} else if (splits[0] == "~") {
 		// starts with home directory
-		auto home_directory = GetHomeDirectory();
+		auto home_directory = fs.GetHomeDirectory();
 		if (!home_directory.empty()) {
 			absolute_path = true;
 			splits[0] = home_directory;
@@ -807,18 +973,24 @@ vector<string> FileSystem::Glob(const string &path) {
 				result.push_back(splits[i]);
 			} else {
 				for (auto &prev_directory : previous_directories) {
-					result.push_back(JoinPath(prev_directory, splits[i]));
+					result.push_back(fs.JoinPath(prev_directory, splits[i]));
 				}
 			}
 		} else {
 			if (previous_directories.empty()) {
 				// no previous directories: list in the current path
-				GlobFiles(*this, ".", splits[i], !is_last_chunk, result, false);
+				if (!GlobFiles(fs, ".", splits[i], !is_last_chunk, result, false,
+				               is_last_chunk ? file_info : nullptr)) {
+					has_file_info = false;
+				}
 			} else {
 				// previous directories
 				// we iterate over each of the previous directories, and apply the glob of the current directory
 				for (auto &prev_directory : previous_directories) {
-					GlobFiles(*this, prev_directory, splits[i], !is_last_chunk, result, true);
+					if (!GlobFiles(fs, prev_directory, splits[i], !is_last_chunk, result, true,
+					               is_last_chunk ? file_info : nullptr)) {
+						has_file_info = false;
+					}
 				}
 			}
 		}
@@ -830,4 +1002,23 @@ vector<string> FileSystem::Glob(const string &path) {
 	return vector<string>();
 }
 
+vector<string> FileSystem::Glob(const string &path) {
+	bool has_file_info = true;
+	return GlobInternal(*this, path, nullptr, has_file_info);
+}
+
+bool FileSystem::GlobFileInfo(const string &path, vector<string> &files, vector<FileInfo> &file_info) {
+	file_info.clear();
+	bool has_file_info = true;
+	files = GlobInternal(*this, path, &file_info, has_file_info);
+	if (!has_file_info || file_info.size() != files.size()) {
+		// the files were not found by listing a directory (e.g. the path has no glob in its file name), or the file
+		// system does not report their info
+		files.clear();
+		file_info.clear();
+		return false;
+	}
+	return true;
+}
+
 } // namespace duckdb
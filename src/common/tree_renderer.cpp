@@ -405,6 +405,9 @@ unique_ptr<RenderTreeNode> TreeRenderer::CreateNode(const QueryProfiler::TreeNod
 	result->extra_text += "\n" + to_string(op.info.elements);
 	string timing = StringUtil::Format("%.2f", op.info.time);
 	result->extra_text += "\n(" + timing + "s)";
+	if (op.info.io_wait > 0) {
+		result->extra_text += "\n(I/O wait " + StringUtil::Format("%.2f", op.info.io_wait) + "s)";
+	}
 	return result;
 }
 
@@ -218,6 +218,10 @@ static int CompareTuple(ChunkCollection *sort_by, vector<OrderType> &desc, vecto
 		if (comp_res == 0) {
 			continue;
 		}
+		if (FlatVector::IsNull(left_vec, vector_idx_left) || FlatVector::IsNull(right_vec, vector_idx_right)) {
+			// the NULL order does not depend on the sort order
+			return comp_res;
+		}
 		return comp_res < 0 ? (order_type == OrderType::ASCENDING ? -1 : 1)
 		                    : (order_type == OrderType::ASCENDING ? 1 : -1);
 	}
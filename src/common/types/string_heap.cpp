@@ -62,7 +62,8 @@ void StringHeap::MergeHeap(StringHeap &other) {
 	other.tail->prev = move(chunk);
 	this->chunk = move(other.chunk);
 	if (!tail) {
-		tail = this->chunk.get();
+		// the chunks of the other heap are the only chunks of this heap: its last chunk is the new tail
+		tail = other.tail;
 	}
 	other.tail = nullptr;
 }
@@ -1,14 +1,20 @@
 #include "duckdb/execution/index/art/art.hpp"
 #include "duckdb/execution/expression_executor.hpp"
 #include "duckdb/common/vector_operations/vector_operations.hpp"
+#include "duckdb/storage/block_manager.hpp"
+#include "duckdb/storage/buffer_manager.hpp"
+#include "duckdb/storage/meta_block_reader.hpp"
+#include "duckdb/storage/meta_block_writer.hpp"
 #include <algorithm>
 #include <ctgmath>
 #include <cstring>
+#include <thread>
 
 namespace duckdb {
 
 ART::ART(vector<column_t> column_ids, vector<unique_ptr<Expression>> unbound_expressions, bool is_unique)
-    : Index(IndexType::ART, move(column_ids), move(unbound_expressions)), is_unique(is_unique) {
+    : Index(IndexType::ART, move(column_ids), move(unbound_expressions)), is_unique(is_unique), db(nullptr),
+      loaded_memory(0), epoch(0) {
 	tree = nullptr;
 	expression_result.Initialize(logical_types);
 	int n = 1;
@@ -220,7 +226,7 @@ bool ART::Insert(IndexLock &lock, DataChunk &input, Vector &row_ids) {
 		}
 
 		row_t row_id = row_identifiers[i];
-		if (!Insert(tree, move(keys[i]), 0, row_id)) {
+		if (!Insert(tree, root_version, move(keys[i]), 0, row_id)) {
 			// failed to insert because of constraint violation
 			failed_index = i;
 			break;
@@ -239,10 +245,14 @@ bool ART::Insert(IndexLock &lock, DataChunk &input, Vector &row_ids) {
 				continue;
 			}
 			row_t row_id = row_identifiers[i];
-			Erase(tree, *keys[i], 0, row_id);
+			Erase(tree, root_version, *keys[i], 0, row_id);
 		}
+		UnloadIfNeeded();
+		ReclaimRetired();
 		return false;
 	}
+	UnloadIfNeeded();
+	ReclaimRetired();
 	return true;
 }
 
@@ -266,19 +276,19 @@ void ART::VerifyAppend(DataChunk &chunk) {
 	expression_result.Initialize(logical_types);
 
 	// unique index, check
-	lock_guard<mutex> l(lock);
 	// first resolve the expressions for the index
-	ExecuteExpressions(chunk, expression_result);
+	// this runs without the index lock, so it cannot use the shared executor of the index
+	ExpressionExecutor executor(bound_expressions);
+	executor.Execute(chunk, expression_result);
 
 	// generate the keys for the given input
 	vector<unique_ptr<Key>> keys;
 	GenerateKeys(expression_result, keys);
 
+	idx_t result_sizes[STANDARD_VECTOR_SIZE];
+	LookupKeys(keys, result_sizes, nullptr);
 	for (idx_t i = 0; i < chunk.size(); i++) {
-		if (!keys[i]) {
-			continue;
-		}
-		if (Lookup(tree, *keys[i], 0) != nullptr) {
+		if (result_sizes[i] != 0) {
 			// node already exists in tree
 			throw ConstraintException("duplicate key value violates primary key or unique constraint");
 		}
@@ -289,17 +299,22 @@ bool ART::InsertToLeaf(Leaf &leaf, row_t row_id) {
 	if (is_unique && leaf.num_elements != 0) {
 		return false;
 	}
-	leaf.Insert(row_id);
+	NodeWriteLock leaf_lock(leaf.version);
+	leaf.Insert(*this, row_id);
 	return true;
 }
 
-bool ART::Insert(unique_ptr<Node> &node, unique_ptr<Key> value, unsigned depth, row_t row_id) {
+bool ART::Insert(unique_ptr<Node> &node, NodeVersion &parent_version, unique_ptr<Key> value, unsigned depth,
+                 row_t row_id) {
 	Key &key = *value;
 	if (!node) {
 		// node is currently empty, create a leaf here with the key
+		NodeWriteLock parent_lock(parent_version);
 		node = make_unique<Leaf>(*this, move(value), row_id);
 		return true;
 	}
+	// the node (or one of its children) changes: it has to be written again
+	ReleaseNode(*node);
 
 	if (node->type == NodeType::NLeaf) {
 		// Replace leaf with Node4 and store both leaves in it
@@ -319,6 +334,7 @@ bool ART::Insert(unique_ptr<Node> &node, unique_ptr<Key> value, unsigned depth,
 			}
 		}
 
+		NodeWriteLock parent_lock(parent_version);
 		unique_ptr<Node> new_node = make_unique<Node4>(*this, new_prefix_length);
 		new_node->prefix_length = new_prefix_length;
 		memcpy(new_node->prefix.get(), &key[depth], new_prefix_length);
@@ -334,6 +350,8 @@ bool ART::Insert(unique_ptr<Node> &node, unique_ptr<Key> value, unsigned depth,
 		uint32_t mismatch_pos = Node::PrefixMismatch(*this, node.get(), key, depth);
 		if (mismatch_pos != node->prefix_length) {
 			// Prefix differs, create new node
+			NodeWriteLock parent_lock(parent_version);
+			NodeWriteLock node_lock(node->version);
 			unique_ptr<Node> new_node = make_unique<Node4>(*this, mismatch_pos);
 			new_node->prefix_length = mismatch_pos;
 			memcpy(new_node->prefix.get(), node->prefix.get(), mismatch_pos);
@@ -353,14 +371,243 @@ bool ART::Insert(unique_ptr<Node> &node, unique_ptr<Key> value, unsigned depth,
 	// Recurse
 	idx_t pos = node->GetChildPos(key[depth]);
 	if (pos != INVALID_INDEX) {
-		auto child = node->GetChild(pos);
-		return Insert(*child, move(value), depth + 1, row_id);
+		auto child = node->GetChild(*this, pos);
+		return Insert(*child, node->version, move(value), depth + 1, row_id);
 	}
+	// the node might grow, in which case it is replaced in its parent
+	NodeWriteLock parent_lock(parent_version);
+	NodeWriteLock node_lock(node->version);
 	unique_ptr<Node> new_node = make_unique<Leaf>(*this, move(value), row_id);
 	Node::InsertLeaf(*this, node, key[depth], new_node);
 	return true;
 }
 
+//===--------------------------------------------------------------------===//
+// Bulk Loading
+//===--------------------------------------------------------------------===//
+ARTBuildEntry::ARTBuildEntry(unique_ptr<Key> key_p, row_t row_id) : prefix(0), key(move(key_p)), row_id(row_id) {
+	for (idx_t i = 0; i < sizeof(uint64_t); i++) {
+		prefix = (prefix << 8) | (i < key->len ? key->data[i] : 0);
+	}
+}
+
+bool ARTBuildEntry::operator<(const ARTBuildEntry &other) const {
+	if (prefix != other.prefix) {
+		return prefix < other.prefix;
+	}
+	auto compare_length = MinValue<idx_t>(key->len, other.key->len);
+	auto result = memcmp(key->data.get(), other.key->data.get(), compare_length);
+	if (result != 0) {
+		return result < 0;
+	}
+	if (key->len != other.key->len) {
+		return key->len < other.key->len;
+	}
+	// equal keys are ordered by their row ids
+	return row_id < other.row_id;
+}
+
+unique_ptr<IndexBuildState> ART::InitializeBuild() {
+	return make_unique<ARTBuildState>();
+}
+
+void ART::BuildAppend(IndexBuildState &state_p, DataChunk &input, Vector &row_ids) {
+	auto &state = (ARTBuildState &)state_p;
+	D_ASSERT(row_ids.GetType().InternalType() == ROW_TYPE);
+	D_ASSERT(logical_types[0] == input.data[0].GetType());
+
+	// generate the keys for the given input
+	vector<unique_ptr<Key>> keys;
+	GenerateKeys(input, keys);
+
+	row_ids.Normalify(input.size());
+	auto row_identifiers = FlatVector::GetData<row_t>(row_ids);
+	for (idx_t i = 0; i < input.size(); i++) {
+		if (!keys[i]) {
+			continue;
+		}
+		state.entries.emplace_back(move(keys[i]), row_identifiers[i]);
+	}
+}
+
+bool ART::BuildCombine(IndexBuildState &state_p) {
+	auto &state = (ARTBuildState &)state_p;
+	// sort the run of this thread
+	std::sort(state.entries.begin(), state.entries.end());
+	// construct the sub-tree of the run bottom-up
+	unique_ptr<Node> node;
+	if (!state.entries.empty() && !Construct(node, state.entries, 0, state.entries.size(), 0)) {
+		return false;
+	}
+	state.entries.clear();
+
+	// merge the sub-trees of the threads pairwise: a thread that finds the tree of another thread merges it into its own
+	// sub-tree outside of the lock, until its tree is the only one that is left
+	while (node) {
+		unique_ptr<Node> other;
+		{
+			lock_guard<mutex> l(lock);
+			if (!tree) {
+				tree = move(node);
+				break;
+			}
+			other = move(tree);
+		}
+		if (!Merge(node, other, 0)) {
+			return false;
+		}
+	}
+	// free the nodes replaced while merging
+	ReclaimRetired();
+	return true;
+}
+
+bool ART::Construct(unique_ptr<Node> &node, vector<ARTBuildEntry> &entries, idx_t start, idx_t end, idx_t depth) {
+	auto &first = entries[start];
+	auto &last = entries[end - 1];
+	// (a single key is not compared, its data is not in the cache after the sort)
+	if (start + 1 == end || (first.prefix == last.prefix && *first.key == *last.key)) {
+		// all keys of the range are equal: they share a single leaf
+		if (is_unique && end - start > 1) {
+			return false;
+		}
+		auto leaf = make_unique<Leaf>(*this, move(first.key), first.row_id);
+		for (idx_t i = start + 1; i < end; i++) {
+			leaf->Insert(*this, entries[i].row_id);
+		}
+		node = move(leaf);
+		return true;
+	}
+	// the keys are sorted: all keys share the bytes in which the smallest and the largest key are equal
+	auto max_length = MinValue<idx_t>(first.key->len, last.key->len);
+	idx_t prefix_end = depth;
+	while (prefix_end < max_length && first.GetByte(prefix_end) == last.GetByte(prefix_end)) {
+		prefix_end++;
+	}
+	D_ASSERT(prefix_end < max_length);
+
+	// every run of keys with the same byte after the prefix becomes a child of the node
+	vector<idx_t> run_starts;
+	run_starts.push_back(start);
+	for (idx_t i = start + 1; i < end; i++) {
+		if (entries[i].GetByte(prefix_end) != entries[i - 1].GetByte(prefix_end)) {
+			run_starts.push_back(i);
+		}
+	}
+	// create a node that fits all children
+	uint32_t prefix_length = prefix_end - depth;
+	unique_ptr<Node> new_node;
+	if (run_starts.size() <= 4) {
+		new_node = make_unique<Node4>(*this, prefix_length);
+	} else if (run_starts.size() <= 16) {
+		new_node = make_unique<Node16>(*this, prefix_length);
+	} else if (run_starts.size() <= 48) {
+		new_node = make_unique<Node48>(*this, prefix_length);
+	} else {
+		new_node = make_unique<Node256>(*this, prefix_length);
+	}
+	new_node->prefix_length = prefix_length;
+	for (idx_t i = 0; i < prefix_length; i++) {
+		new_node->prefix[i] = first.GetByte(depth + i);
+	}
+
+	for (idx_t run_idx = 0; run_idx < run_starts.size(); run_idx++) {
+		auto run_start = run_starts[run_idx];
+		auto run_end = run_idx + 1 < run_starts.size() ? run_starts[run_idx + 1] : end;
+		// read the key byte before constructing the child, which moves the keys into its leaves
+		auto key_byte = entries[run_start].GetByte(prefix_end);
+		unique_ptr<Node> child;
+		if (!Construct(child, entries, run_start, run_end, prefix_end + 1)) {
+			return false;
+		}
+		Node::InsertLeaf(*this, new_node, key_byte, child);
+	}
+	node = move(new_node);
+	return true;
+}
+
+static void TrimPrefix(Node &node, uint32_t length) {
+	node.prefix_length -= length;
+	memmove(node.prefix.get(), node.prefix.get() + length, node.prefix_length);
+}
+
+bool ART::Merge(unique_ptr<Node> &node, unique_ptr<Node> &other, idx_t depth) {
+	if (!other) {
+		return true;
+	}
+	if (!node) {
+		node = move(other);
+		return true;
+	}
+	ReleaseNode(*node);
+	ReleaseNode(*other);
+	if (node->type == NodeType::NLeaf) {
+		std::swap(node, other);
+	}
+	if (other->type == NodeType::NLeaf) {
+		// insert the row ids of the leaf into the tree of the node
+		auto &leaf = (Leaf &)*other;
+		auto &key = *leaf.value;
+		// the sub-trees are not visible to lookups yet
+		NodeVersion parent_version;
+		for (idx_t i = 0; i < leaf.num_elements; i++) {
+			auto key_copy = make_unique<Key>(unique_ptr<data_t[]>(new data_t[key.len]), key.len);
+			memcpy(key_copy->data.get(), key.data.get(), key.len);
+			if (!Insert(node, parent_version, move(key_copy), depth, leaf.GetRowId(i))) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	// both are inner nodes: make sure that the node has the shorter prefix
+	if (other->prefix_length < node->prefix_length) {
+		std::swap(node, other);
+	}
+	uint32_t mismatch_pos = 0;
+	while (mismatch_pos < node->prefix_length && node->prefix[mismatch_pos] == other->prefix[mismatch_pos]) {
+		mismatch_pos++;
+	}
+	if (mismatch_pos < node->prefix_length) {
+		// the prefixes differ: both nodes become children of a new node that holds the common part of the prefixes
+		unique_ptr<Node> new_node = make_unique<Node4>(*this, mismatch_pos);
+		new_node->prefix_length = mismatch_pos;
+		memcpy(new_node->prefix.get(), node->prefix.get(), mismatch_pos);
+		auto node_byte = node->prefix[mismatch_pos];
+		auto other_byte = other->prefix[mismatch_pos];
+		TrimPrefix(*node, mismatch_pos + 1);
+		TrimPrefix(*other, mismatch_pos + 1);
+		Node4::Insert(*this, new_node, node_byte, node);
+		Node4::Insert(*this, new_node, other_byte, other);
+		node = move(new_node);
+		return true;
+	}
+	depth += node->prefix_length;
+	if (node->prefix_length < other->prefix_length) {
+		// the prefix of the node is a part of the prefix of the other node: the other node belongs below a child
+		auto key_byte = other->prefix[node->prefix_length];
+		TrimPrefix(*other, node->prefix_length + 1);
+		return MergeChild(node, key_byte, other, depth);
+	}
+	// equal prefixes: merge the children of the other node into the children of the node
+	for (auto pos = other->GetNextPos(INVALID_INDEX); pos != INVALID_INDEX; pos = other->GetNextPos(pos)) {
+		auto key_byte = other->GetKeyByte(pos);
+		if (!MergeChild(node, key_byte, *other->GetChild(*this, pos), depth)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+bool ART::MergeChild(unique_ptr<Node> &node, uint8_t key_byte, unique_ptr<Node> &other, idx_t depth) {
+	auto pos = node->GetChildPos(key_byte);
+	if (pos == INVALID_INDEX) {
+		Node::InsertLeaf(*this, node, key_byte, other);
+		return true;
+	}
+	return Merge(*node->GetChild(*this, pos), other, depth + 1);
+}
+
 //===--------------------------------------------------------------------===//
 // Delete
 //===--------------------------------------------------------------------===//
@@ -383,22 +630,29 @@ void ART::Delete(IndexLock &state, DataChunk &input, Vector &row_ids) {
 		if (!keys[i]) {
 			continue;
 		}
-		Erase(tree, *keys[i], 0, row_identifiers[i]);
+		Erase(tree, root_version, *keys[i], 0, row_identifiers[i]);
 	}
+	UnloadIfNeeded();
+	ReclaimRetired();
 }
 
-void ART::Erase(unique_ptr<Node> &node, Key &key, unsigned depth, row_t row_id) {
+void ART::Erase(unique_ptr<Node> &node, NodeVersion &parent_version, Key &key, unsigned depth, row_t row_id) {
 	if (!node) {
 		return;
 	}
+	ReleaseNode(*node);
 	// Delete a leaf from a tree
 	if (node->type == NodeType::NLeaf) {
 		// Make sure we have the right leaf
 		if (ART::LeafMatches(node.get(), key, depth)) {
 			auto leaf = static_cast<Leaf *>(node.get());
-			leaf->Remove(row_id);
+			{
+				NodeWriteLock leaf_lock(leaf->version);
+				leaf->Remove(row_id);
+			}
 			if (leaf->num_elements == 0) {
-				node.reset();
+				NodeWriteLock parent_lock(parent_version);
+				Retire(move(node));
 			}
 		}
 		return;
@@ -413,21 +667,27 @@ void ART::Erase(unique_ptr<Node> &node, Key &key, unsigned depth, row_t row_id)
 	}
 	idx_t pos = node->GetChildPos(key[depth]);
 	if (pos != INVALID_INDEX) {
-		auto child = node->GetChild(pos);
+		auto child = node->GetChild(*this, pos);
 		D_ASSERT(child);
 
 		unique_ptr<Node> &child_ref = *child;
 		if (child_ref->type == NodeType::NLeaf && LeafMatches(child_ref.get(), key, depth)) {
 			// Leaf found, remove entry
 			auto leaf = static_cast<Leaf *>(child_ref.get());
-			leaf->Remove(row_id);
+			ReleaseNode(*leaf);
+			{
+				NodeWriteLock leaf_lock(leaf->version);
+				leaf->Remove(row_id);
+			}
 			if (leaf->num_elements == 0) {
 				// Leaf is empty, delete leaf, decrement node counter and maybe shrink node
+				NodeWriteLock parent_lock(parent_version);
+				NodeWriteLock node_lock(node->version);
 				Node::Erase(*this, node, pos);
 			}
 		} else {
 			// Recurse
-			Erase(*child, key, depth + 1, row_id);
+			Erase(*child, node->version, key, depth + 1, row_id);
 		}
 	}
 }
@@ -470,28 +730,227 @@ static unique_ptr<Key> CreateKey(ART &art, PhysicalType type, Value &value) {
 
 bool ART::SearchEqual(ARTIndexScanState *state, idx_t max_count, vector<row_t> &result_ids) {
 	auto key = CreateKey(*this, types[0], state->values[0]);
-	auto leaf = static_cast<Leaf *>(Lookup(tree, *key, 0));
-	if (!leaf) {
-		return true;
-	}
-	if (leaf->num_elements > max_count) {
+	auto result_count = result_ids.size();
+	if (LookupKey(*key, &result_ids) > max_count) {
+		result_ids.resize(result_count);
 		return false;
 	}
-	for (idx_t i = 0; i < leaf->num_elements; i++) {
-		row_t row_id = leaf->GetRowId(i);
-		result_ids.push_back(row_id);
-	}
 	return true;
 }
 
 void ART::SearchEqualJoinNoFetch(Value &equal_value, idx_t &result_size) {
 	//! We need to look for a leaf
 	auto key = CreateKey(*this, types[0], equal_value);
-	auto leaf = static_cast<Leaf *>(Lookup(tree, *key, 0));
-	if (!leaf) {
+	auto count = LookupKey(*key, nullptr);
+	if (count == 0) {
 		return;
 	}
-	result_size = leaf->num_elements;
+	result_size = count;
+}
+
+void ART::SearchEqualBatch(DataChunk &input, idx_t result_sizes[], vector<row_t> result_ids[]) {
+	D_ASSERT(input.ColumnCount() == 1 && input.data[0].GetType().InternalType() == types[0]);
+	vector<unique_ptr<Key>> keys;
+	GenerateKeys(input, keys);
+	LookupKeys(keys, result_sizes, result_ids);
+}
+
+//! Registers a lookup that traverses the tree without holding the index lock for as long as it is alive
+class OptimisticReadGuard {
+public:
+	explicit OptimisticReadGuard(ART &art) : art(art), reader(art.BeginOptimisticRead()) {
+	}
+	~OptimisticReadGuard() {
+		art.EndOptimisticRead(reader);
+	}
+
+private:
+	ART &art;
+	idx_t reader;
+};
+
+idx_t ART::LookupKey(Key &key, vector<row_t> *result_ids) {
+	{
+		OptimisticReadGuard guard(*this);
+		for (idx_t attempt = 0; attempt < OPTIMISTIC_LOOKUP_ATTEMPTS; attempt++) {
+			idx_t count;
+			auto result = OptimisticLookup(key, result_ids, count);
+			if (result == OptimisticLookupResult::SUCCESS) {
+				return count;
+			}
+			if (result == OptimisticLookupResult::NOT_LOADED) {
+				break;
+			}
+		}
+	}
+	// the path keeps changing, or has not been read from disk yet: look up the key while holding the index lock
+	lock_guard<mutex> l(lock);
+	auto leaf = static_cast<Leaf *>(Lookup(tree, key, 0));
+	idx_t count = 0;
+	if (leaf) {
+		if (result_ids) {
+			for (idx_t i = 0; i < leaf->num_elements; i++) {
+				result_ids->push_back(leaf->GetRowId(i));
+			}
+		}
+		count = leaf->num_elements;
+	}
+	UnloadIfNeeded();
+	ReclaimRetired();
+	return count;
+}
+
+//! Prefetch the header of a node that is read after the nodes of the other lookups in the batch
+static inline void PrefetchNode(Node *node) {
+#if defined(__GNUC__) || defined(__clang__)
+	__builtin_prefetch(node);
+#endif
+}
+
+void ART::LookupKeys(vector<unique_ptr<Key>> &keys, idx_t result_sizes[], vector<row_t> result_ids[]) {
+	auto count = keys.size();
+	// the lookups that are still descending the tree, and the ones that have to be repeated on their own
+	vector<ARTLookupState> states(count);
+	vector<idx_t> active;
+	vector<idx_t> repeat;
+	active.reserve(count);
+	{
+		OptimisticReadGuard guard(*this);
+		for (idx_t i = 0; i < count; i++) {
+			result_sizes[i] = 0;
+			if (!keys[i]) {
+				continue;
+			}
+			if (StartOptimisticLookup(states[i])) {
+				active.push_back(i);
+			} else {
+				repeat.push_back(i);
+			}
+		}
+		// process one level of the tree for all lookups at a time: the node a lookup descends into is prefetched,
+		// and only read when the lookup is processed in the next round
+		while (!active.empty()) {
+			idx_t remaining = 0;
+			for (idx_t active_idx = 0; active_idx < active.size(); active_idx++) {
+				auto i = active[active_idx];
+				auto result =
+				    OptimisticLookupStep(states[i], *keys[i], result_ids ? &result_ids[i] : nullptr, result_sizes[i]);
+				switch (result) {
+				case OptimisticLookupResult::DESCEND:
+					PrefetchNode(states[i].node);
+					active[remaining++] = i;
+					break;
+				case OptimisticLookupResult::SUCCESS:
+					break;
+				default:
+					repeat.push_back(i);
+					break;
+				}
+			}
+			active.resize(remaining);
+		}
+	}
+	// lookups that ran into a change or into a node that is not loaded yet are repeated one by one
+	for (auto i : repeat) {
+		result_sizes[i] = LookupKey(*keys[i], result_ids ? &result_ids[i] : nullptr);
+	}
+}
+
+//! Restart the optimistic lookup if the node changed since its version was read
+#define VALIDATE_OR_RESTART(NODE_VERSION, VERSION)                                                                    \
+	if (!(NODE_VERSION).Validate(VERSION)) {                                                                           \
+		return OptimisticLookupResult::RESTART;                                                                        \
+	}
+
+OptimisticLookupResult ART::OptimisticLookup(Key &key, vector<row_t> *result_ids, idx_t &count) {
+	ARTLookupState state;
+	if (!StartOptimisticLookup(state)) {
+		return OptimisticLookupResult::RESTART;
+	}
+	while (true) {
+		auto result = OptimisticLookupStep(state, key, result_ids, count);
+		if (result != OptimisticLookupResult::DESCEND) {
+			return result;
+		}
+	}
+}
+
+bool ART::StartOptimisticLookup(ARTLookupState &state) {
+	// the parent of the root is the lock on the root pointer
+	state.parent = &root_version;
+	if (!state.parent->ReadLock(state.parent_version)) {
+		return false;
+	}
+	state.node = tree.get();
+	state.depth = 0;
+	return true;
+}
+
+OptimisticLookupResult ART::OptimisticLookupStep(ARTLookupState &state, Key &key, vector<row_t> *result_ids,
+                                                 idx_t &count) {
+	// the node pointer is only valid if the parent did not change while it was read. Nodes that are removed from
+	// the tree are kept alive until the lookup is done, so reading a stale node is safe until it is validated.
+	VALIDATE_OR_RESTART(*state.parent, state.parent_version);
+	auto node = state.node;
+	auto depth = state.depth;
+	if (!node) {
+		count = 0;
+		return OptimisticLookupResult::SUCCESS;
+	}
+	if (node->type == NodeType::NPersistent) {
+		return OptimisticLookupResult::NOT_LOADED;
+	}
+	uint64_t version;
+	if (!node->version.ReadLock(version)) {
+		return OptimisticLookupResult::RESTART;
+	}
+	if (node->type == NodeType::NLeaf) {
+		// the key of a leaf never changes
+		auto leaf = static_cast<Leaf *>(node);
+		Key &leaf_key = *leaf->value;
+		for (idx_t i = depth; i < leaf_key.len; i++) {
+			if (i >= key.len || leaf_key[i] != key[i]) {
+				count = 0;
+				return OptimisticLookupResult::SUCCESS;
+			}
+		}
+		// the row ids are read in two steps: the array is only valid if the leaf did not change while the count
+		// and the pointer to it were read, and its content only if the leaf did not change while it was copied
+		auto leaf_count = leaf->num_elements;
+		auto row_ids = leaf->GetRowIds();
+		VALIDATE_OR_RESTART(node->version, version);
+		if (result_ids) {
+			auto result_count = result_ids->size();
+			result_ids->insert(result_ids->end(), row_ids, row_ids + leaf_count);
+			if (!node->version.Validate(version)) {
+				result_ids->resize(result_count);
+				return OptimisticLookupResult::RESTART;
+			}
+		}
+		count = leaf_count;
+		return OptimisticLookupResult::SUCCESS;
+	}
+	auto prefix_length = node->prefix_length;
+	auto prefix = node->prefix.get();
+	VALIDATE_OR_RESTART(node->version, version);
+	if (depth + prefix_length >= key.len) {
+		// the key ends within the prefix: it does not match any of the keys below the node
+		count = 0;
+		return OptimisticLookupResult::SUCCESS;
+	}
+	for (idx_t pos = 0; pos < prefix_length; pos++) {
+		if (key[depth + pos] != prefix[pos]) {
+			VALIDATE_OR_RESTART(node->version, version);
+			count = 0;
+			return OptimisticLookupResult::SUCCESS;
+		}
+	}
+	depth += prefix_length;
+	state.node = node->FindChild(key[depth]);
+	state.parent = &node->version;
+	state.parent_version = version;
+	state.depth = depth + 1;
+	return OptimisticLookupResult::DESCEND;
 }
 
 Node *ART::Lookup(unique_ptr<Node> &node, Key &key, unsigned depth) {
@@ -521,7 +980,7 @@ Node *ART::Lookup(unique_ptr<Node> &node, Key &key, unsigned depth) {
 		if (pos == INVALID_INDEX) {
 			return nullptr;
 		}
-		node_val = node_val->GetChild(pos)->get();
+		node_val = node_val->GetChild(*this, pos)->get();
 		D_ASSERT(node_val);
 
 		depth++;
@@ -590,7 +1049,7 @@ bool ART::IteratorNext(Iterator &it) {
 		top.pos = node->GetNextPos(top.pos);
 		if (top.pos != INVALID_INDEX) {
 			// next node found: go there
-			it.SetEntry(it.depth, IteratorEntry(node->GetChild(top.pos)->get(), INVALID_INDEX));
+			it.SetEntry(it.depth, IteratorEntry(node->GetChild(*this, top.pos)->get(), INVALID_INDEX));
 			it.depth++;
 		} else {
 			// no node found: move up the tree
@@ -620,7 +1079,7 @@ bool ART::Bound(unique_ptr<Node> &n, Key &key, Iterator &it, bool inclusive) {
 		it.depth++;
 		if (!equal) {
 			while (node->type != NodeType::NLeaf) {
-				node = node->GetChild(node->GetMin())->get();
+				node = node->GetChild(*this, node->GetMin())->get();
 				auto &c_top = it.stack[it.depth];
 				c_top.node = node;
 				it.depth++;
@@ -681,7 +1140,7 @@ bool ART::Bound(unique_ptr<Node> &n, Key &key, Iterator &it, bool inclusive) {
 			// Find min leaf
 			top.pos = node->GetMin();
 		}
-		node = node->GetChild(top.pos)->get();
+		node = node->GetChild(*this, top.pos)->get();
 		//! This means all children of this node qualify as geq
 
 		depth++;
@@ -709,39 +1168,16 @@ bool ART::SearchGreater(ARTIndexScanState *state, bool inclusive, idx_t max_coun
 //===--------------------------------------------------------------------===//
 // Less Than
 //===--------------------------------------------------------------------===//
-static Leaf &FindMinimum(Iterator &it, Node &node) {
-	Node *next = nullptr;
-	idx_t pos = 0;
-	switch (node.type) {
-	case NodeType::NLeaf:
+static Leaf &FindMinimum(ART &art, Iterator &it, Node &node) {
+	if (node.type == NodeType::NLeaf) {
 		it.node = (Leaf *)&node;
 		return (Leaf &)node;
-	case NodeType::N4:
-		next = ((Node4 &)node).child[0].get();
-		break;
-	case NodeType::N16:
-		next = ((Node16 &)node).child[0].get();
-		break;
-	case NodeType::N48: {
-		auto &n48 = (Node48 &)node;
-		while (n48.child_index[pos] == Node::EMPTY_MARKER) {
-			pos++;
-		}
-		next = n48.child[n48.child_index[pos]].get();
-		break;
-	}
-	case NodeType::N256: {
-		auto &n256 = (Node256 &)node;
-		while (!n256.child[pos]) {
-			pos++;
-		}
-		next = n256.child[pos].get();
-		break;
-	}
 	}
+	auto pos = node.GetMin();
+	auto next = node.GetChild(art, pos)->get();
 	it.SetEntry(it.depth, IteratorEntry(&node, pos));
 	it.depth++;
-	return FindMinimum(it, *next);
+	return FindMinimum(art, it, *next);
 }
 
 bool ART::SearchLess(ARTIndexScanState *state, bool inclusive, idx_t max_count, vector<row_t> &result_ids) {
@@ -754,7 +1190,7 @@ bool ART::SearchLess(ARTIndexScanState *state, bool inclusive, idx_t max_count,
 
 	if (!it->start) {
 		// first find the minimum value in the ART: we start scanning from this value
-		auto &minimum = FindMinimum(state->iterator, *tree);
+		auto &minimum = FindMinimum(*this, state->iterator, *tree);
 		// early out min value higher than upper bound query
 		if (*minimum.value > *upper_bound) {
 			return true;
@@ -801,13 +1237,13 @@ bool ART::Scan(Transaction &transaction, DataTable &table, IndexScanState &table
 
 	vector<row_t> row_ids;
 	bool success = true;
-	if (state->values[1].is_null) {
+	if (state->values[1].is_null && state->expressions[0] == ExpressionType::COMPARE_EQUAL) {
+		// point lookups do not need the index lock
+		success = SearchEqual(state, max_count, row_ids);
+	} else if (state->values[1].is_null) {
 		lock_guard<mutex> l(lock);
 		// single predicate
 		switch (state->expressions[0]) {
-		case ExpressionType::COMPARE_EQUAL:
-			success = SearchEqual(state, max_count, row_ids);
-			break;
 		case ExpressionType::COMPARE_GREATERTHANOREQUALTO:
 			success = SearchGreater(state, true, max_count, row_ids);
 			break;
@@ -823,6 +1259,7 @@ bool ART::Scan(Transaction &transaction, DataTable &table, IndexScanState &table
 		default:
 			throw NotImplementedException("Operation not implemented");
 		}
+		UnloadIfNeeded();
 	} else {
 		lock_guard<mutex> l(lock);
 		// two predicates
@@ -830,6 +1267,7 @@ bool ART::Scan(Transaction &transaction, DataTable &table, IndexScanState &table
 		bool left_inclusive = state->expressions[0] == ExpressionType ::COMPARE_GREATERTHANOREQUALTO;
 		bool right_inclusive = state->expressions[1] == ExpressionType ::COMPARE_LESSTHANOREQUALTO;
 		success = SearchCloseRange(state, left_inclusive, right_inclusive, max_count, row_ids);
+		UnloadIfNeeded();
 	}
 	if (!success) {
 		return false;
@@ -851,4 +1289,218 @@ bool ART::Scan(Transaction &transaction, DataTable &table, IndexScanState &table
 	return true;
 }
 
+//===--------------------------------------------------------------------===//
+// Serialization
+//===--------------------------------------------------------------------===//
+BlockPointer ART::Serialize(MetaBlockWriter &writer) {
+	lock_guard<mutex> l(lock);
+	db = &writer.db;
+	BlockPointer root;
+	if (tree) {
+		if (tree->pointer.block_id == INVALID_BLOCK) {
+			// the nodes are written to blocks of the index, so that nodes that do not change are not written again
+			MetaBlockWriter node_writer(*db);
+			root = tree->Serialize(*this, node_writer);
+		} else {
+			root = tree->pointer;
+		}
+		// the tree is on disk now: release its memory, the nodes are read back from disk as they are accessed
+		tree->Unload(*this);
+		loaded_memory = 0;
+	}
+	// the blocks that no longer contain nodes of the tree are not part of this checkpoint
+	auto &block_manager = BlockManager::GetBlockManager(*db);
+	for (auto &block_id : free_blocks) {
+		block_manager.MarkBlockAsModified(block_id);
+	}
+	free_blocks.clear();
+
+	// write the location of the root and the blocks of the index
+	BlockPointer pointer(writer.block->id, writer.offset);
+	writer.Write<block_id_t>(root.block_id);
+	writer.Write<uint32_t>(root.offset);
+	writer.Write<uint64_t>(index_blocks.size());
+	for (auto &entry : index_blocks) {
+		writer.Write<block_id_t>(entry.first);
+		writer.Write<uint64_t>(entry.second.references);
+		writer.Write<block_id_t>(entry.second.next_block);
+	}
+	ReclaimRetired();
+	return pointer;
+}
+
+void ART::Deserialize(DatabaseInstance &db, BlockPointer pointer) {
+	lock_guard<mutex> l(lock);
+	this->db = &db;
+	blocks.clear();
+	BlockPointer root;
+	unordered_map<block_id_t, ARTBlock> new_blocks;
+	if (pointer.block_id != INVALID_BLOCK) {
+		// read the location of the root and the blocks of the index
+		MetaBlockReader reader(db, pointer.block_id);
+		reader.offset = pointer.offset;
+		root.block_id = reader.Read<block_id_t>();
+		root.offset = reader.Read<uint32_t>();
+		auto block_count = reader.Read<uint64_t>();
+		for (idx_t i = 0; i < block_count; i++) {
+			auto block_id = reader.Read<block_id_t>();
+			auto &block = new_blocks[block_id];
+			block.references = reader.Read<uint64_t>();
+			block.next_block = reader.Read<block_id_t>();
+		}
+	}
+	unique_ptr<Node> new_tree;
+	if (root.block_id != INVALID_BLOCK) {
+		// only read the root node: the rest of the tree is read when it is accessed
+		new_tree = Node::Deserialize(*this, root);
+	}
+	{
+		NodeWriteLock root_lock(root_version);
+		tree.swap(new_tree);
+		if (new_tree) {
+			Retire(move(new_tree));
+		}
+	}
+	ReclaimRetired();
+	index_blocks = move(new_blocks);
+	free_blocks.clear();
+	loaded_memory = 0;
+}
+
+void ART::CommitDrop() {
+	lock_guard<mutex> l(lock);
+	if (!db) {
+		return;
+	}
+	auto &block_manager = BlockManager::GetBlockManager(*db);
+	for (auto &entry : index_blocks) {
+		block_manager.MarkBlockAsModified(entry.first);
+	}
+	for (auto &block_id : free_blocks) {
+		block_manager.MarkBlockAsModified(block_id);
+	}
+	index_blocks.clear();
+	free_blocks.clear();
+}
+
+void ART::AddNode(const vector<block_id_t> &node_blocks) {
+	D_ASSERT(!node_blocks.empty());
+	index_blocks[node_blocks[0]].references++;
+	// a node that does not fit in the rest of its block continues in the next block(s) of the writer
+	for (idx_t i = 1; i < node_blocks.size(); i++) {
+		auto &previous = index_blocks[node_blocks[i - 1]];
+		if (previous.next_block == INVALID_BLOCK) {
+			previous.next_block = node_blocks[i];
+			index_blocks[node_blocks[i]].references++;
+		}
+		D_ASSERT(previous.next_block == node_blocks[i]);
+	}
+}
+
+void ART::ReleaseNode(Node &node) {
+	if (node.pointer.block_id == INVALID_BLOCK) {
+		return;
+	}
+	ReleaseBlock(node.pointer.block_id);
+	node.pointer = BlockPointer();
+}
+
+void ART::ReleaseBlock(block_id_t block_id) {
+	while (block_id != INVALID_BLOCK) {
+		auto entry = index_blocks.find(block_id);
+		D_ASSERT(entry != index_blocks.end());
+		if (entry == index_blocks.end() || --entry->second.references > 0) {
+			return;
+		}
+		// the block is empty: the next block is no longer needed by the last node of this block either
+		auto next_block = entry->second.next_block;
+		index_blocks.erase(entry);
+		blocks.erase(block_id);
+		free_blocks.push_back(block_id);
+		block_id = next_block;
+	}
+}
+
+void ART::UnloadIfNeeded() {
+	if (!db || !tree) {
+		return;
+	}
+	auto &buffer_manager = BufferManager::GetBufferManager(*db);
+	if (loaded_memory <= buffer_manager.GetMaxMemory() / LOADED_MEMORY_FRACTION) {
+		return;
+	}
+	tree->Unload(*this);
+	loaded_memory = 0;
+}
+
+//===--------------------------------------------------------------------===//
+// Optimistic Lock Coupling
+//===--------------------------------------------------------------------===//
+void ART::Retire(unique_ptr<Node> node) {
+	if (node->type != NodeType::NPersistent) {
+		// the node is removed from the tree, and with it its location on disk
+		ReleaseNode(*node);
+	}
+	node->version.MarkObsolete();
+	lock_guard<mutex> l(retired_lock);
+	retired.nodes.push_back(move(node));
+}
+
+void ART::Retire(unique_ptr<uint8_t[]> prefix) {
+	lock_guard<mutex> l(retired_lock);
+	retired.prefixes.push_back(move(prefix));
+}
+
+void ART::Retire(unique_ptr<row_t[]> row_ids) {
+	lock_guard<mutex> l(retired_lock);
+	retired.row_ids.push_back(move(row_ids));
+}
+
+idx_t ART::BeginOptimisticRead() {
+	auto &readers = reader_counts[std::hash<std::thread::id>()(std::this_thread::get_id()) % READER_COUNT_STRIPES];
+	while (true) {
+		// the lookup is registered in the epoch it observed: if the epoch changed in the meantime, the writer that
+		// changed it might not have seen the lookup, so try again in the new epoch
+		auto current_epoch = epoch.load();
+		readers.count[current_epoch & 1]++;
+		if (epoch.load() == current_epoch) {
+			return (&readers - reader_counts) * 2 + (current_epoch & 1);
+		}
+		readers.count[current_epoch & 1]--;
+	}
+}
+
+void ART::EndOptimisticRead(idx_t reader) {
+	reader_counts[reader / 2].count[reader % 2]--;
+}
+
+bool ART::HasOptimisticReaders(idx_t epoch_parity) {
+	for (idx_t i = 0; i < READER_COUNT_STRIPES; i++) {
+		if (reader_counts[i].count[epoch_parity] != 0) {
+			return true;
+		}
+	}
+	return false;
+}
+
+void ART::ReclaimRetired() {
+	lock_guard<mutex> l(retired_lock);
+	if (!retired_previous.Empty()) {
+		// the entries retired before the last epoch change can be freed once the lookups that started in the epoch
+		// before it are done: later lookups can not reach them anymore
+		if (HasOptimisticReaders((epoch - 1) & 1)) {
+			return;
+		}
+		retired_previous.Clear();
+	}
+	if (retired.Empty()) {
+		return;
+	}
+	std::swap(retired, retired_previous);
+	auto previous_epoch = epoch++;
+	if (!HasOptimisticReaders(previous_epoch & 1)) {
+		retired_previous.Clear();
+	}
+}
+
 } // namespace duckdb
@@ -1,5 +1,7 @@
 #include "duckdb/execution/index/art/node.hpp"
 #include "duckdb/execution/index/art/leaf.hpp"
+#include "duckdb/execution/index/art/art.hpp"
+#include "duckdb/common/serializer.hpp"
 
 #include <cstring>
 
@@ -13,13 +15,22 @@ Leaf::Leaf(ART &art, unique_ptr<Key> value, row_t row_id) : Node(art, NodeType::
 	this->num_elements = 1;
 }
 
-void Leaf::Insert(row_t row_id) {
+Leaf::Leaf(ART &art, unique_ptr<Key> value, unique_ptr<row_t[]> row_ids, idx_t num_elements)
+    : Node(art, NodeType::NLeaf, 0) {
+	this->value = move(value);
+	this->capacity = num_elements;
+	this->row_ids = move(row_ids);
+	this->num_elements = num_elements;
+}
+
+void Leaf::Insert(ART &art, row_t row_id) {
 	// Grow array
 	if (num_elements == capacity) {
 		auto new_row_id = unique_ptr<row_t[]>(new row_t[capacity * 2]);
 		memcpy(new_row_id.get(), row_ids.get(), capacity * sizeof(row_t));
 		capacity *= 2;
-		row_ids = move(new_row_id);
+		row_ids.swap(new_row_id);
+		art.Retire(move(new_row_id));
 	}
 	row_ids[num_elements++] = row_id;
 }
@@ -42,4 +53,21 @@ void Leaf::Remove(row_t row_id) {
 	}
 }
 
+void Leaf::SerializeValues(Serializer &serializer) {
+	serializer.Write<uint32_t>(value->len);
+	serializer.WriteData(value->data.get(), value->len);
+	serializer.Write<uint32_t>(num_elements);
+	serializer.WriteData((const_data_ptr_t)row_ids.get(), num_elements * sizeof(row_t));
+}
+
+unique_ptr<Leaf> Leaf::DeserializeValues(ART &art, Deserializer &source) {
+	auto key_length = source.Read<uint32_t>();
+	auto key_data = unique_ptr<data_t[]>(new data_t[key_length]);
+	source.ReadData(key_data.get(), key_length);
+	auto num_elements = source.Read<uint32_t>();
+	auto row_ids = unique_ptr<row_t[]>(new row_t[num_elements]);
+	source.ReadData((data_ptr_t)row_ids.get(), num_elements * sizeof(row_t));
+	return make_unique<Leaf>(art, make_unique<Key>(move(key_data), key_length), move(row_ids), num_elements);
+}
+
 } // namespace duckdb
@@ -1,6 +1,8 @@
 #include "duckdb/execution/index/art/node.hpp"
 #include "duckdb/execution/index/art/art.hpp"
 #include "duckdb/common/exception.hpp"
+#include "duckdb/storage/meta_block_reader.hpp"
+#include "duckdb/storage/meta_block_writer.hpp"
 
 namespace duckdb {
 
@@ -13,16 +15,41 @@ void Node::CopyPrefix(ART &art, Node *src, Node *dst) {
 	memcpy(dst->prefix.get(), src->prefix.get(), src->prefix_length);
 }
 
-unique_ptr<Node> *Node::GetChild(idx_t pos) {
+void Node::Replace(ART &art, unique_ptr<Node> &node, unique_ptr<Node> new_node) {
+	node.swap(new_node);
+	art.Retire(move(new_node));
+}
+
+unique_ptr<Node> *Node::GetChild(ART &art, idx_t pos) {
+	auto child = GetChildSlot(pos);
+	Load(art, *child);
+	return child;
+}
+
+unique_ptr<Node> *Node::GetChildSlot(idx_t pos) {
 	D_ASSERT(0);
 	return nullptr;
 }
 
+uint8_t Node::GetKeyByte(idx_t pos) {
+	D_ASSERT(0);
+	return 0;
+}
+
 idx_t Node::GetMin() {
 	D_ASSERT(0);
 	return 0;
 }
 
+void Node::Load(ART &art, unique_ptr<Node> &child) {
+	if (child && child->type == NodeType::NPersistent) {
+		auto loaded = Deserialize(art, ((PersistentNode &)*child).pointer);
+		// lookups that do not hold the index lock might still be looking at the persistent node
+		NodeWriteLock lock(version);
+		Replace(art, child, move(loaded));
+	}
+}
+
 uint32_t Node::PrefixMismatch(ART &art, Node *node, Key &key, uint64_t depth) {
 	uint64_t pos;
 	for (pos = 0; pos < node->prefix_length; pos++) {
@@ -75,4 +102,155 @@ void Node::Erase(ART &art, unique_ptr<Node> &node, idx_t pos) {
 	}
 }
 
+//===--------------------------------------------------------------------===//
+// Serialization
+//===--------------------------------------------------------------------===//
+BlockPointer Node::Serialize(ART &art, MetaBlockWriter &writer) {
+	if (pointer.block_id != INVALID_BLOCK) {
+		// neither the node nor its children changed since the node was written
+		return pointer;
+	}
+	// write the children first, the node stores the pointers to them
+	vector<uint8_t> key_bytes;
+	vector<BlockPointer> children;
+	if (type != NodeType::NLeaf) {
+		for (idx_t pos = GetNextPos(INVALID_INDEX); pos != INVALID_INDEX; pos = GetNextPos(pos)) {
+			auto &child = *GetChildSlot(pos);
+			key_bytes.push_back(GetKeyByte(pos));
+			children.push_back(child->Serialize(art, writer));
+		}
+	}
+	BlockPointer result(writer.block->id, writer.offset);
+	auto written_blocks = writer.written_blocks.size();
+	writer.Write<uint8_t>((uint8_t)type);
+	writer.Write<uint32_t>(prefix_length);
+	writer.WriteData(prefix.get(), prefix_length);
+	if (type == NodeType::NLeaf) {
+		((Leaf *)this)->SerializeValues(writer);
+	} else {
+		writer.Write<uint16_t>(children.size());
+		for (idx_t i = 0; i < children.size(); i++) {
+			writer.Write<uint8_t>(key_bytes[i]);
+			writer.Write<block_id_t>(children[i].block_id);
+			writer.Write<uint32_t>(children[i].offset);
+		}
+	}
+	// the blocks the node was written to: the writer flushed every block it filled while writing the node
+	vector<block_id_t> blocks(writer.written_blocks.begin() + written_blocks, writer.written_blocks.end());
+	if (blocks.empty() || blocks.back() != writer.block->id) {
+		blocks.push_back(writer.block->id);
+	}
+	D_ASSERT(blocks[0] == result.block_id);
+	art.AddNode(blocks);
+	pointer = result;
+	return result;
+}
+
+static unique_ptr<Node> ReadChild(ART &art, Deserializer &source) {
+	BlockPointer pointer;
+	pointer.block_id = source.Read<block_id_t>();
+	pointer.offset = source.Read<uint32_t>();
+	return make_unique<PersistentNode>(art, pointer);
+}
+
+unique_ptr<Node> Node::Deserialize(ART &art, BlockPointer pointer) {
+	D_ASSERT(art.db);
+	// the blocks of the index are freed by the index itself, once the nodes in them have changed
+	MetaBlockReader reader(*art.db, pointer.block_id, false);
+	reader.offset = pointer.offset;
+	art.blocks[pointer.block_id] = reader.block;
+
+	auto type = (NodeType)reader.Read<uint8_t>();
+	auto prefix_length = reader.Read<uint32_t>();
+	auto prefix = unique_ptr<uint8_t[]>(new uint8_t[prefix_length]);
+	reader.ReadData(prefix.get(), prefix_length);
+
+	unique_ptr<Node> result;
+	idx_t memory_usage = prefix_length;
+	if (type == NodeType::NLeaf) {
+		auto leaf = Leaf::DeserializeValues(art, reader);
+		memory_usage += sizeof(Leaf) + leaf->value->len + leaf->num_elements * sizeof(row_t);
+		result = move(leaf);
+	} else {
+		auto count = reader.Read<uint16_t>();
+		switch (type) {
+		case NodeType::N4: {
+			auto node = make_unique<Node4>(art, prefix_length);
+			memory_usage += sizeof(Node4);
+			for (idx_t i = 0; i < count; i++) {
+				node->key[i] = reader.Read<uint8_t>();
+				node->child[i] = ReadChild(art, reader);
+			}
+			result = move(node);
+			break;
+		}
+		case NodeType::N16: {
+			auto node = make_unique<Node16>(art, prefix_length);
+			memory_usage += sizeof(Node16);
+			for (idx_t i = 0; i < count; i++) {
+				node->key[i] = reader.Read<uint8_t>();
+				node->child[i] = ReadChild(art, reader);
+			}
+			result = move(node);
+			break;
+		}
+		case NodeType::N48: {
+			auto node = make_unique<Node48>(art, prefix_length);
+			memory_usage += sizeof(Node48);
+			for (idx_t i = 0; i < count; i++) {
+				auto key_byte = reader.Read<uint8_t>();
+				node->child_index[key_byte] = i;
+				node->child[i] = ReadChild(art, reader);
+			}
+			result = move(node);
+			break;
+		}
+		case NodeType::N256: {
+			auto node = make_unique<Node256>(art, prefix_length);
+			memory_usage += sizeof(Node256);
+			for (idx_t i = 0; i < count; i++) {
+				auto key_byte = reader.Read<uint8_t>();
+				node->child[key_byte] = ReadChild(art, reader);
+			}
+			result = move(node);
+			break;
+		}
+		default:
+			throw InternalException("Unrecognized node type in ART deserialization");
+		}
+		result->count = count;
+		memory_usage += count * sizeof(PersistentNode);
+	}
+	result->prefix_length = prefix_length;
+	result->prefix = move(prefix);
+	result->pointer = pointer;
+	art.loaded_memory += memory_usage;
+	return result;
+}
+
+void Node::Unload(ART &art) {
+	for (idx_t pos = GetNextPos(INVALID_INDEX); pos != INVALID_INDEX; pos = GetNextPos(pos)) {
+		auto &child = *GetChildSlot(pos);
+		if (child->type == NodeType::NPersistent) {
+			continue;
+		}
+		if (child->pointer.block_id == INVALID_BLOCK) {
+			// the child changed: it has to stay in memory, but its children might not have
+			if (child->type != NodeType::NLeaf) {
+				child->Unload(art);
+			}
+			continue;
+		}
+		// the child and its sub-tree are unchanged on disk: the reference takes over the location of the child
+		auto persistent = make_unique<PersistentNode>(art, child->pointer);
+		child->pointer = BlockPointer();
+		NodeWriteLock lock(version);
+		Replace(art, child, move(persistent));
+	}
+}
+
+PersistentNode::PersistentNode(ART &art, BlockPointer pointer) : Node(art, NodeType::NPersistent, 0) {
+	this->pointer = pointer;
+}
+
 } // namespace duckdb
@@ -43,11 +43,26 @@ idx_t Node16::GetNextPos(idx_t pos) {
 	return pos < count ? pos : INVALID_INDEX;
 }
 
-unique_ptr<Node> *Node16::GetChild(idx_t pos) {
+unique_ptr<Node> *Node16::GetChildSlot(idx_t pos) {
 	D_ASSERT(pos < count);
 	return &child[pos];
 }
 
+uint8_t Node16::GetKeyByte(idx_t pos) {
+	D_ASSERT(pos < count);
+	return key[pos];
+}
+
+Node *Node16::FindChild(uint8_t k) {
+	auto child_count = MinValue<idx_t>(count, 16);
+	for (idx_t pos = 0; pos < child_count; pos++) {
+		if (key[pos] == k) {
+			return child[pos].get();
+		}
+	}
+	return nullptr;
+}
+
 idx_t Node16::GetMin() {
 	return 0;
 }
@@ -79,7 +94,7 @@ void Node16::Insert(ART &art, unique_ptr<Node> &node, uint8_t key_byte, unique_p
 		}
 		CopyPrefix(art, n, new_node.get());
 		new_node->count = node->count;
-		node = move(new_node);
+		Replace(art, node, move(new_node));
 
 		Node48::Insert(art, node, key_byte, child);
 	}
@@ -88,7 +103,7 @@ void Node16::Insert(ART &art, unique_ptr<Node> &node, uint8_t key_byte, unique_p
 void Node16::Erase(ART &art, unique_ptr<Node> &node, int pos) {
 	Node16 *n = static_cast<Node16 *>(node.get());
 	// erase the child and decrease the count
-	n->child[pos].reset();
+	art.Retire(move(n->child[pos]));
 	n->count--;
 	// potentially move any children backwards
 	for (; pos < n->count; pos++) {
@@ -103,7 +118,7 @@ void Node16::Erase(ART &art, unique_ptr<Node> &node, int pos) {
 			new_node->child[new_node->count++] = move(n->child[i]);
 		}
 		CopyPrefix(art, n, new_node.get());
-		node = move(new_node);
+		Replace(art, node, move(new_node));
 	}
 }
 
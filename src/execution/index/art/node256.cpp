@@ -46,11 +46,20 @@ idx_t Node256::GetNextPos(idx_t pos) {
 	return Node::GetNextPos(pos);
 }
 
-unique_ptr<Node> *Node256::GetChild(idx_t pos) {
+unique_ptr<Node> *Node256::GetChildSlot(idx_t pos) {
 	D_ASSERT(child[pos]);
 	return &child[pos];
 }
 
+uint8_t Node256::GetKeyByte(idx_t pos) {
+	D_ASSERT(pos < 256);
+	return pos;
+}
+
+Node *Node256::FindChild(uint8_t k) {
+	return child[k].get();
+}
+
 void Node256::Insert(ART &art, unique_ptr<Node> &node, uint8_t key_byte, unique_ptr<Node> &child) {
 	Node256 *n = static_cast<Node256 *>(node.get());
 
@@ -61,7 +70,7 @@ void Node256::Insert(ART &art, unique_ptr<Node> &node, uint8_t key_byte, unique_
 void Node256::Erase(ART &art, unique_ptr<Node> &node, int pos) {
 	Node256 *n = static_cast<Node256 *>(node.get());
 
-	n->child[pos].reset();
+	art.Retire(move(n->child[pos]));
 	n->count--;
 	if (node->count <= 36) {
 		auto new_node = make_unique<Node48>(art, n->prefix_length);
@@ -73,7 +82,7 @@ void Node256::Erase(ART &art, unique_ptr<Node> &node, int pos) {
 				new_node->count++;
 			}
 		}
-		node = move(new_node);
+		Replace(art, node, move(new_node));
 	}
 }
 
@@ -43,11 +43,26 @@ idx_t Node4::GetNextPos(idx_t pos) {
 	return pos < count ? pos : INVALID_INDEX;
 }
 
-unique_ptr<Node> *Node4::GetChild(idx_t pos) {
+unique_ptr<Node> *Node4::GetChildSlot(idx_t pos) {
 	D_ASSERT(pos < count);
 	return &child[pos];
 }
 
+uint8_t Node4::GetKeyByte(idx_t pos) {
+	D_ASSERT(pos < count);
+	return key[pos];
+}
+
+Node *Node4::FindChild(uint8_t k) {
+	auto child_count = MinValue<idx_t>(count, 4);
+	for (idx_t pos = 0; pos < child_count; pos++) {
+		if (key[pos] == k) {
+			return child[pos].get();
+		}
+	}
+	return nullptr;
+}
+
 void Node4::Insert(ART &art, unique_ptr<Node> &node, uint8_t key_byte, unique_ptr<Node> &child) {
 	Node4 *n = static_cast<Node4 *>(node.get());
 
@@ -76,7 +91,7 @@ void Node4::Insert(ART &art, unique_ptr<Node> &node, uint8_t key_byte, unique_pt
 			new_node->key[i] = n->key[i];
 			new_node->child[i] = move(n->child[i]);
 		}
-		node = move(new_node);
+		Replace(art, node, move(new_node));
 		Node16::Insert(art, node, key_byte, child);
 	}
 }
@@ -86,7 +101,7 @@ void Node4::Erase(ART &art, unique_ptr<Node> &node, int pos) {
 	D_ASSERT(pos < n->count);
 
 	// erase the child and decrease the count
-	n->child[pos].reset();
+	art.Retire(move(n->child[pos]));
 	n->count--;
 	// potentially move any children backwards
 	for (; pos < n->count; pos++) {
@@ -96,7 +111,8 @@ void Node4::Erase(ART &art, unique_ptr<Node> &node, int pos) {
 
 	// This is a one way node
 	if (n->count == 1) {
-		auto childref = n->child[0].get();
+		// the prefix of the child is extended: make sure it is loaded
+		auto childref = n->GetChild(art, 0)->get();
 		//! concatenate prefixes
 		auto new_length = node->prefix_length + childref->prefix_length + 1;
 		//! have to allocate space in our prefix array
@@ -114,9 +130,15 @@ void Node4::Erase(ART &art, unique_ptr<Node> &node, int pos) {
 			new_prefix[i] = node->prefix[i];
 		}
 		//! set new prefix and move the child
-		childref->prefix = move(new_prefix);
-		childref->prefix_length = new_length;
-		node = move(n->child[0]);
+		art.ReleaseNode(*childref);
+		{
+			NodeWriteLock child_lock(childref->version);
+			childref->prefix.swap(new_prefix);
+			childref->prefix_length = new_length;
+			art.Retire(move(new_prefix));
+		}
+		auto child = move(n->child[0]);
+		Replace(art, node, move(child));
 	}
 }
 
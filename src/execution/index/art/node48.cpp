@@ -41,11 +41,25 @@ idx_t Node48::GetNextPos(idx_t pos) {
 	return Node::GetNextPos(pos);
 }
 
-unique_ptr<Node> *Node48::GetChild(idx_t pos) {
+unique_ptr<Node> *Node48::GetChildSlot(idx_t pos) {
 	D_ASSERT(child_index[pos] != Node::EMPTY_MARKER);
 	return &child[child_index[pos]];
 }
 
+uint8_t Node48::GetKeyByte(idx_t pos) {
+	D_ASSERT(pos < 256);
+	return pos;
+}
+
+Node *Node48::FindChild(uint8_t k) {
+	// read the index only once: it might be changed concurrently
+	auto index = child_index[k];
+	if (index >= 48) {
+		return nullptr;
+	}
+	return child[index].get();
+}
+
 idx_t Node48::GetMin() {
 	for (idx_t i = 0; i < 256; i++) {
 		if (child_index[i] != Node::EMPTY_MARKER) {
@@ -82,7 +96,7 @@ void Node48::Insert(ART &art, unique_ptr<Node> &node, uint8_t key_byte, unique_p
 		}
 		new_node->count = n->count;
 		CopyPrefix(art, n, new_node.get());
-		node = move(new_node);
+		Replace(art, node, move(new_node));
 		Node256::Insert(art, node, key_byte, child);
 	}
 }
@@ -90,7 +104,7 @@ void Node48::Insert(ART &art, unique_ptr<Node> &node, uint8_t key_byte, unique_p
 void Node48::Erase(ART &art, unique_ptr<Node> &node, int pos) {
 	Node48 *n = static_cast<Node48 *>(node.get());
 
-	n->child[n->child_index[pos]].reset();
+	art.Retire(move(n->child[n->child_index[pos]]));
 	n->child_index[pos] = Node::EMPTY_MARKER;
 	n->count--;
 	if (node->count <= 12) {
@@ -102,7 +116,7 @@ void Node48::Erase(ART &art, unique_ptr<Node> &node, int pos) {
 				new_node->child[new_node->count++] = move(n->child[n->child_index[i]]);
 			}
 		}
-		node = move(new_node);
+		Replace(art, node, move(new_node));
 	}
 }
 
@@ -3,10 +3,16 @@
 #include "duckdb/storage/buffer_manager.hpp"
 
 #include "duckdb/common/exception.hpp"
+#include "duckdb/common/types/hash.hpp"
 #include "duckdb/common/types/null_value.hpp"
 #include "duckdb/common/vector_operations/vector_operations.hpp"
 #include "duckdb/common/vector_operations/unary_executor.hpp"
 #include "duckdb/common/operator/comparison_operators.hpp"
+#include "duckdb/execution/operator/join/physical_comparison_join.hpp"
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
 
 namespace duckdb {
 
@@ -14,8 +20,9 @@ using ScanStructure = JoinHashTable::ScanStructure;
 
 JoinHashTable::JoinHashTable(BufferManager &buffer_manager, vector<JoinCondition> &conditions,
                              vector<LogicalType> btypes, JoinType type)
-    : buffer_manager(buffer_manager), build_types(move(btypes)), equality_size(0), condition_size(0), build_size(0),
-      entry_size(0), tuple_size(0), join_type(type), finalized(false), has_null(false), count(0) {
+    : string_heap_size(0), buffer_manager(buffer_manager), build_types(move(btypes)), equality_size(0),
+      condition_size(0), build_size(0), entry_size(0), tuple_size(0), string_location_offset(INVALID_INDEX),
+      join_type(type), finalized(false), has_null(false), count(0), string_block_used(0), radix_bits(0) {
 	for (auto &condition : conditions) {
 		D_ASSERT(condition.left->return_type == condition.right->return_type);
 		auto type = condition.left->return_type;
@@ -34,12 +41,18 @@ JoinHashTable::JoinHashTable(BufferManager &buffer_manager, vector<JoinCondition
 		         (condition.null_values_are_equal && condition.comparison == ExpressionType::COMPARE_EQUAL));
 
 		condition_types.push_back(type);
+		if (type.InternalType() == PhysicalType::VARCHAR) {
+			string_offsets.push_back(condition_size);
+		}
 		condition_size += type_size;
 	}
 	// at least one equality is necessary
 	D_ASSERT(equality_types.size() > 0);
 
 	for (idx_t i = 0; i < build_types.size(); i++) {
+		if (build_types[i].InternalType() == PhysicalType::VARCHAR) {
+			string_offsets.push_back(condition_size + build_size);
+		}
 		build_size += GetTypeIdSize(build_types[i].InternalType());
 	}
 	tuple_size = condition_size + build_size;
@@ -52,10 +65,30 @@ JoinHashTable::JoinHashTable(BufferManager &buffer_manager, vector<JoinCondition
 		entry_size += sizeof(bool);
 		pointer_offset += sizeof(bool);
 	}
+	hash_offset = pointer_offset;
 	// compute the per-block capacity of this HT
 	block_capacity = MaxValue<idx_t>(STANDARD_VECTOR_SIZE, (Storage::BLOCK_ALLOC_SIZE / entry_size) + 1);
 }
 
+JoinHashTable::JoinHashTable(JoinHashTable *parent)
+    : string_heap_size(0), buffer_manager(parent->buffer_manager), equality_types(parent->equality_types),
+      condition_types(parent->condition_types), build_types(parent->build_types), predicates(parent->predicates),
+      equality_size(parent->equality_size), condition_size(parent->condition_size), build_size(parent->build_size),
+      entry_size(parent->entry_size), tuple_size(parent->tuple_size), pointer_offset(parent->pointer_offset),
+      string_offsets(parent->string_offsets), join_type(parent->join_type), finalized(false),
+      has_null(parent->has_null), count(0), string_block_used(0), null_values_are_equal(parent->null_values_are_equal),
+      radix_bits(0) {
+	// partitions store the hash separately after the entry, as the hash is overwritten by the next pointer when the
+	// partition is finalized
+	hash_offset = entry_size;
+	entry_size += sizeof(hash_t);
+	// the string data of the entries is copied into the string blocks of the partition, so that it is spilled and
+	// reloaded together with the entries; the location of every string is stored after the hash
+	string_location_offset = entry_size;
+	entry_size += string_offsets.size() * sizeof(uint64_t);
+	block_capacity = MaxValue<idx_t>(STANDARD_VECTOR_SIZE, (Storage::BLOCK_ALLOC_SIZE / entry_size) + 1);
+}
+
 JoinHashTable::~JoinHashTable() {
 }
 
@@ -182,6 +215,7 @@ void JoinHashTable::SerializeVectorData(VectorData &vdata, PhysicalType type, co
 		break;
 	case PhysicalType::VARCHAR: {
 		StringHeap local_heap;
+		idx_t local_heap_size = 0;
 		auto source = (string_t *)vdata.data;
 		for (idx_t i = 0; i < count; i++) {
 			auto idx = sel.get_index(i);
@@ -194,12 +228,14 @@ void JoinHashTable::SerializeVectorData(VectorData &vdata, PhysicalType type, co
 				new_val = source[source_idx];
 			} else {
 				new_val = local_heap.AddBlob(source[source_idx].GetDataUnsafe(), source[source_idx].GetSize());
+				local_heap_size += new_val.GetSize();
 			}
 			Store<string_t>(new_val, key_locations[i]);
 			key_locations[i] += sizeof(string_t);
 		}
 		lock_guard<mutex> append_lock(ht_lock);
 		string_heap.MergeHeap(local_heap);
+		string_heap_size += local_heap_size;
 		break;
 	}
 	default:
@@ -364,7 +400,54 @@ void JoinHashTable::Build(DataChunk &keys, DataChunk &payload) {
 	SerializeVector(hash_values, payload.size(), *current_sel, added_count, key_locations);
 }
 
-void JoinHashTable::InsertHashes(Vector &hashes, idx_t count, data_ptr_t key_locations[]) {
+//! Load the pointer at target while other threads may be swapping it with CompareExchangePointer
+static inline data_ptr_t LoadPointer(data_ptr_t *target) {
+#ifdef _MSC_VER
+	return *(data_ptr_t volatile *)target;
+#else
+	return __atomic_load_n(target, __ATOMIC_RELAXED);
+#endif
+}
+
+//! Atomically replace the pointer at target with desired if it still equals expected, otherwise load the current
+//! pointer into expected. The pointer table is a plain array of pointers, so this uses the compiler intrinsics
+//! instead of casting the entries to std::atomic.
+static inline bool CompareExchangePointer(data_ptr_t *target, data_ptr_t &expected, data_ptr_t desired) {
+#ifdef _MSC_VER
+	auto current = (data_ptr_t)_InterlockedCompareExchangePointer((void *volatile *)target, desired, expected);
+	if (current == expected) {
+		return true;
+	}
+	expected = current;
+	return false;
+#else
+	return __atomic_compare_exchange_n(target, &expected, desired, true, __ATOMIC_RELEASE, __ATOMIC_RELAXED);
+#endif
+}
+
+template <bool PARALLEL>
+static inline void InsertHashesLoop(data_ptr_t pointers[], const hash_t indices[], idx_t count,
+                                    const data_ptr_t key_locations[], idx_t pointer_offset) {
+	for (idx_t i = 0; i < count; i++) {
+		auto index = indices[i];
+		if (PARALLEL) {
+			// other threads are inserting into the same pointer table: atomically swap the head of the chain
+			auto prev_pointer = LoadPointer(&pointers[index]);
+			do {
+				Store<data_ptr_t>(prev_pointer, key_locations[i] + pointer_offset);
+			} while (!CompareExchangePointer(&pointers[index], prev_pointer, key_locations[i]));
+		} else {
+			// set prev in current key to the value (NOTE: this will be nullptr if
+			// there is none)
+			Store<data_ptr_t>(pointers[index], key_locations[i] + pointer_offset);
+
+			// set pointer to current tuple
+			pointers[index] = key_locations[i];
+		}
+	}
+}
+
+void JoinHashTable::InsertHashes(Vector &hashes, idx_t count, data_ptr_t key_locations[], bool parallel) {
 	D_ASSERT(hashes.GetType().id() == LogicalTypeId::HASH);
 
 	// use bitmask to get position in array
@@ -375,22 +458,44 @@ void JoinHashTable::InsertHashes(Vector &hashes, idx_t count, data_ptr_t key_loc
 	D_ASSERT(hashes.GetVectorType() == VectorType::FLAT_VECTOR);
 	auto pointers = (data_ptr_t *)hash_map->node->buffer;
 	auto indices = FlatVector::GetData<hash_t>(hashes);
-	for (idx_t i = 0; i < count; i++) {
-		auto index = indices[i];
-		// set prev in current key to the value (NOTE: this will be nullptr if
-		// there is none)
-		auto prev_pointer = (data_ptr_t *)(key_locations[i] + pointer_offset);
-		Store<data_ptr_t>(pointers[index], (data_ptr_t)prev_pointer);
-
-		// set pointer to current tuple
-		pointers[index] = key_locations[i];
+	if (parallel) {
+		InsertHashesLoop<true>(pointers, indices, count, key_locations, pointer_offset);
+	} else {
+		InsertHashesLoop<false>(pointers, indices, count, key_locations, pointer_offset);
 	}
 }
 
-void JoinHashTable::Finalize() {
-	// the build has finished, now iterate over all the nodes and construct the final hash table
+idx_t JoinHashTable::PointerTableCapacity(idx_t count) {
 	// select a HT that has at least 50% empty space
-	idx_t capacity = NextPowerOfTwo(MaxValue<idx_t>(count * 2, (Storage::BLOCK_ALLOC_SIZE / sizeof(data_ptr_t)) + 1));
+	return NextPowerOfTwo(MaxValue<idx_t>(count * 2, (Storage::BLOCK_ALLOC_SIZE / sizeof(data_ptr_t)) + 1));
+}
+
+idx_t JoinHashTable::SizeInBytes() {
+	return blocks.size() * block_capacity * entry_size + PointerTableCapacity(count) * sizeof(data_ptr_t) +
+	       string_heap_size;
+}
+
+void JoinHashTable::Merge(JoinHashTable &other) {
+	D_ASSERT(!finalized && !other.finalized);
+	lock_guard<mutex> append_lock(ht_lock);
+	for (auto &block : other.blocks) {
+		blocks.push_back(move(block));
+	}
+	other.blocks.clear();
+	count += other.count;
+	other.count = 0;
+	if (other.has_null) {
+		has_null = true;
+	}
+	// the entries of the other HT point into its string heap, so we take over the string heap as well
+	string_heap.MergeHeap(other.string_heap);
+	string_heap_size += other.string_heap_size;
+	other.string_heap_size = 0;
+}
+
+void JoinHashTable::InitializePointerTable() {
+	D_ASSERT(!IsPartitioned());
+	idx_t capacity = PointerTableCapacity(count);
 	// size needs to be a power of 2
 	D_ASSERT((capacity & (capacity - 1)) == 0);
 	bitmask = capacity - 1;
@@ -399,14 +504,21 @@ void JoinHashTable::Finalize() {
 	hash_map = buffer_manager.Allocate(capacity * sizeof(data_ptr_t));
 	memset(hash_map->node->buffer, 0, capacity * sizeof(data_ptr_t));
 
+	pinned_handles.resize(blocks.size());
+	finalized = true;
+}
+
+void JoinHashTable::Finalize(idx_t block_idx_start, idx_t block_idx_end, bool parallel) {
+	D_ASSERT(finalized && hash_map);
+	D_ASSERT(block_idx_end <= blocks.size());
 	Vector hashes(LogicalType::HASH);
 	auto hash_data = FlatVector::GetData<hash_t>(hashes);
 	data_ptr_t key_locations[STANDARD_VECTOR_SIZE];
 	// now construct the actual hash table; scan the nodes
 	// as we can the nodes we pin all the blocks of the HT and keep them pinned until the HT is destroyed
 	// this is so that we can keep pointers around to the blocks
-	// FIXME: if we cannot keep everything pinned in memory, we could switch to an out-of-memory merge join or so
-	for (auto &block : blocks) {
+	for (idx_t block_idx = block_idx_start; block_idx < block_idx_end; block_idx++) {
+		auto &block = blocks[block_idx];
 		auto handle = buffer_manager.Pin(block.block);
 		data_ptr_t dataptr = handle->node->buffer;
 		idx_t entry = 0;
@@ -414,19 +526,199 @@ void JoinHashTable::Finalize() {
 			// fetch the next vector of entries from the blocks
 			idx_t next = MinValue<idx_t>(STANDARD_VECTOR_SIZE, block.count - entry);
 			for (idx_t i = 0; i < next; i++) {
-				hash_data[i] = Load<hash_t>((data_ptr_t)(dataptr + pointer_offset));
+				hash_data[i] = Load<hash_t>((data_ptr_t)(dataptr + hash_offset));
 				key_locations[i] = dataptr;
+				if (!pinned_string_handles.empty()) {
+					LoadStrings(dataptr);
+				}
 				dataptr += entry_size;
 			}
 			// now insert into the hash table
-			InsertHashes(hashes, next, key_locations);
+			InsertHashes(hashes, next, key_locations, parallel);
 
 			entry += next;
 		}
-		pinned_handles.push_back(move(handle));
+		pinned_handles[block_idx] = move(handle);
 	}
+}
 
-	finalized = true;
+void JoinHashTable::Finalize() {
+	// the build has finished, now iterate over all the nodes and construct the final hash table
+	InitializePointerTable();
+	// the string blocks of a partition stay pinned while the partition is finalized, the strings of the entries are
+	// pointed to their (possibly reloaded) data while the entries are inserted
+	for (auto &string_block : string_blocks) {
+		pinned_string_handles.push_back(buffer_manager.Pin(string_block));
+	}
+	Finalize(0, blocks.size(), false);
+}
+
+void JoinHashTable::Unload() {
+	D_ASSERT(finalized);
+	hash_map.reset();
+	pinned_handles.clear();
+	pinned_string_handles.clear();
+	finalized = false;
+}
+
+data_ptr_t JoinHashTable::AllocateEntry(unique_ptr<BufferHandle> &handle) {
+	if (blocks.empty() || blocks.back().count == blocks.back().capacity) {
+		HTDataBlock new_block;
+		new_block.count = 0;
+		new_block.capacity = block_capacity;
+		new_block.block = buffer_manager.RegisterMemory(block_capacity * entry_size, false);
+		handle = buffer_manager.Pin(new_block.block);
+		blocks.push_back(move(new_block));
+	}
+	D_ASSERT(handle);
+	auto &block = blocks.back();
+	auto entry = handle->node->buffer + block.count * entry_size;
+	block.count++;
+	count++;
+	return entry;
+}
+
+uint64_t JoinHashTable::AllocateString(string_t string, unique_ptr<BufferHandle> &handle) {
+	auto size = string.GetSize();
+	if (string_blocks.empty() || string_block_used + size > handle->node->size) {
+		// strings are never split over blocks, strings that are bigger than a block get a block of their own
+		handle.reset();
+		string_blocks.push_back(buffer_manager.RegisterMemory(MaxValue<idx_t>(Storage::BLOCK_ALLOC_SIZE, size), false));
+		handle = buffer_manager.Pin(string_blocks.back());
+		string_block_used = 0;
+	}
+	memcpy(handle->node->buffer + string_block_used, string.GetDataUnsafe(), size);
+	uint64_t location = (uint64_t(string_blocks.size() - 1) << 32) | string_block_used;
+	string_block_used += size;
+	return location;
+}
+
+void JoinHashTable::LoadStrings(data_ptr_t entry) {
+	for (idx_t i = 0; i < string_offsets.size(); i++) {
+		auto string_ptr = entry + string_offsets[i];
+		auto string = Load<string_t>(string_ptr);
+		if (string.IsInlined()) {
+			continue;
+		}
+		auto location = Load<uint64_t>(entry + string_location_offset + i * sizeof(uint64_t));
+		auto &handle = pinned_string_handles[location >> 32];
+		auto data = (const char *)handle->node->buffer + (location & 0xFFFFFFFF);
+		Store<string_t>(string_t(data, string.GetSize()), string_ptr);
+	}
+}
+
+//! The partition index is taken from the upper bits of the hash, as the lower bits are used for the bucket index. The
+//! hash is mixed first: the upper bits of the hashes of short strings are always zero.
+static inline idx_t PartitionIndex(hash_t hash, idx_t shift) {
+	return murmurhash64(hash) >> shift;
+}
+
+void JoinHashTable::Partition(idx_t radix_bits_p) {
+	D_ASSERT(!finalized && !IsPartitioned());
+	D_ASSERT(radix_bits_p > 0 && radix_bits_p < sizeof(hash_t) * 8);
+	radix_bits = radix_bits_p;
+	idx_t partition_count = idx_t(1) << radix_bits;
+	idx_t shift = sizeof(hash_t) * 8 - radix_bits;
+
+	vector<unique_ptr<BufferHandle>> partition_handles;
+	vector<unique_ptr<BufferHandle>> string_handles;
+	for (idx_t i = 0; i < partition_count; i++) {
+		partitions.push_back(unique_ptr<JoinHashTable>(new JoinHashTable(this)));
+		partition_handles.push_back(nullptr);
+		string_handles.push_back(nullptr);
+	}
+	partition_pins.resize(partition_count, 0);
+
+	// scatter the entries of the HT over the partitions, releasing the blocks of the HT as we go
+	for (auto &block : blocks) {
+		auto handle = buffer_manager.Pin(block.block);
+		data_ptr_t dataptr = handle->node->buffer;
+		for (idx_t i = 0; i < block.count; i++) {
+			auto hash = Load<hash_t>(dataptr + pointer_offset);
+			auto partition_idx = PartitionIndex(hash, shift);
+			auto &partition = *partitions[partition_idx];
+			auto entry = partition.AllocateEntry(partition_handles[partition_idx]);
+			memcpy(entry, dataptr, pointer_offset);
+			Store<hash_t>(hash, entry + partition.hash_offset);
+			for (idx_t str_idx = 0; str_idx < string_offsets.size(); str_idx++) {
+				auto string = Load<string_t>(dataptr + string_offsets[str_idx]);
+				if (string.IsInlined()) {
+					continue;
+				}
+				auto location = partition.AllocateString(string, string_handles[partition_idx]);
+				Store<uint64_t>(location, entry + partition.string_location_offset + str_idx * sizeof(uint64_t));
+			}
+			dataptr += entry_size;
+		}
+		handle.reset();
+		block.block.reset();
+	}
+	blocks.clear();
+	// all strings have been copied into the partitions
+	string_heap.Destroy();
+	string_heap_size = 0;
+}
+
+void JoinHashTable::ProbeEmptyPartition(DataChunk &keys, DataChunk &input, DataChunk &result) {
+	D_ASSERT(count == 0);
+	// no row can find a match: this is the same result as for an empty build side
+	PhysicalComparisonJoin::ConstructEmptyJoinResult(join_type, has_null, input, result);
+	if (join_type != JoinType::MARK || has_null) {
+		return;
+	}
+	// however, the build side is not empty: the mark of a row with a NULL key is NULL rather than false
+	auto &mask = FlatVector::Validity(result.data.back());
+	for (idx_t col_idx = 0; col_idx < keys.ColumnCount(); col_idx++) {
+		if (null_values_are_equal[col_idx]) {
+			continue;
+		}
+		VectorData kdata;
+		keys.data[col_idx].Orrify(keys.size(), kdata);
+		if (kdata.validity.AllValid()) {
+			continue;
+		}
+		for (idx_t i = 0; i < keys.size(); i++) {
+			if (!kdata.validity.RowIsValid(kdata.sel->get_index(i))) {
+				mask.SetInvalid(i);
+			}
+		}
+	}
+}
+
+void JoinHashTable::GetPartitionIndices(DataChunk &keys, idx_t partition_indices[]) {
+	D_ASSERT(IsPartitioned());
+	Vector hashes(LogicalType::HASH);
+	Hash(keys, FlatVector::INCREMENTAL_SELECTION_VECTOR, keys.size(), hashes);
+
+	VectorData hdata;
+	hashes.Orrify(keys.size(), hdata);
+	auto hash_data = (hash_t *)hdata.data;
+	idx_t shift = sizeof(hash_t) * 8 - radix_bits;
+	for (idx_t i = 0; i < keys.size(); i++) {
+		partition_indices[i] = PartitionIndex(hash_data[hdata.sel->get_index(i)], shift);
+	}
+}
+
+JoinHashTable &JoinHashTable::PinPartition(idx_t partition_idx) {
+	D_ASSERT(partition_idx < partitions.size());
+	lock_guard<mutex> plock(partition_lock);
+	auto &partition = *partitions[partition_idx];
+	if (!partition.finalized) {
+		partition.Finalize();
+	}
+	partition_pins[partition_idx]++;
+	return partition;
+}
+
+void JoinHashTable::UnpinPartition(idx_t partition_idx) {
+	D_ASSERT(partition_idx < partitions.size());
+	lock_guard<mutex> plock(partition_lock);
+	D_ASSERT(partition_pins[partition_idx] > 0);
+	partition_pins[partition_idx]--;
+	if (partition_pins[partition_idx] == 0) {
+		// no thread is probing this partition anymore: release it so its blocks can be evicted
+		partitions[partition_idx]->Unload();
+	}
 }
 
 unique_ptr<ScanStructure> JoinHashTable::Probe(DataChunk &keys) {
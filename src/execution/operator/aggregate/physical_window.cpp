@@ -1,44 +1,123 @@
 #include "duckdb/execution/operator/aggregate/physical_window.hpp"
 
 #include "duckdb/common/types/chunk_collection.hpp"
+#include "duckdb/common/types/hash.hpp"
 #include "duckdb/common/vector_operations/vector_operations.hpp"
+#include "duckdb/execution/executor.hpp"
 #include "duckdb/execution/expression_executor.hpp"
+#include "duckdb/execution/operator/order/sorted_run.hpp"
 #include "duckdb/execution/window_segment_tree.hpp"
+#include "duckdb/parallel/pipeline.hpp"
+#include "duckdb/parallel/task_scheduler.hpp"
 #include "duckdb/planner/expression/bound_reference_expression.hpp"
 #include "duckdb/planner/expression/bound_window_expression.hpp"
+#include "duckdb/storage/buffer_manager.hpp"
 
 #include <cmath>
 
 namespace duckdb {
 
+//! The input is hash partitioned into 2^WINDOW_PARTITION_RADIX_BITS partitions, which are evaluated in parallel
+static constexpr idx_t WINDOW_PARTITION_RADIX_BITS = 5;
+//! The amount of encoded rows a thread buffers per partition before it sorts them and writes them to a sorted run
+static constexpr idx_t WINDOW_PARTITION_BUFFER_SIZE = 2 * Storage::BLOCK_ALLOC_SIZE;
+//! Smaller inputs are evaluated in a single sort, which keeps the order of their result stable. The input is only
+//! partitioned once this many rows have actually been collected, so an under-estimated input is still partitioned.
+static constexpr idx_t WINDOW_PARTITION_MIN_CARDINALITY = 100000;
+
 class WindowGlobalState : public GlobalOperatorState {
 public:
-	WindowGlobalState(PhysicalWindow &op_p, ClientContext &context) : op(op_p) {
+	WindowGlobalState(PhysicalWindow &op_p, ClientContext &context)
+	    : op(op_p), buffer_manager(BufferManager::GetBufferManager(context)), can_partition(false), sink_count(0),
+	      partitioned(false) {
 	}
 
 	PhysicalWindow &op;
+	BufferManager &buffer_manager;
 	std::mutex lock;
 	ChunkCollection chunks;
 	ChunkCollection window_results;
+
+	//! Whether or not the window expressions allow the input to be hash partitioned on the PARTITION BY keys
+	bool can_partition;
+	//! The amount of rows that the threads have collected so far
+	std::atomic<idx_t> sink_count;
+	//! Whether or not the input is hash partitioned on the PARTITION BY keys; if this is false the input is collected
+	//! in chunks and sorted in memory. This is set by the first thread that sees the input grow beyond
+	//! WINDOW_PARTITION_MIN_CARDINALITY, the other threads switch to partitioning on their next chunk.
+	std::atomic<bool> partitioned;
+	//! The row format of the input rows, sorted on the PARTITION BY and ORDER BY keys of the first window expression
+	unique_ptr<SortRowFormat> input_format;
+	//! The row format of the result rows (the input columns followed by the window results), which are not sorted
+	unique_ptr<SortRowFormat> result_format;
+	//! The sorted runs of every partition
+	vector<vector<unique_ptr<SortedRun>>> partition_runs;
+	//! The result rows of every partition
+	vector<unique_ptr<SortedRun>> partition_results;
+};
+
+//! The rows of a single partition that a thread has not written to a sorted run yet
+struct WindowPartitionBuffer {
+	BufferedSerializer rows;
+	vector<idx_t> row_offsets;
+	vector<unique_ptr<SortedRun>> sorted_runs;
+
+	void FlushRun(BufferManager &buffer_manager) {
+		if (row_offsets.empty()) {
+			return;
+		}
+		sorted_runs.push_back(CreateSortedRun(buffer_manager, rows, row_offsets));
+		rows.Reset();
+		row_offsets.clear();
+	}
 };
 
 class WindowLocalState : public LocalSinkState {
 public:
-	explicit WindowLocalState(PhysicalWindow &op_p) : op(op_p) {
+	explicit WindowLocalState(PhysicalWindow &op_p) : op(op_p), hashes(LogicalType::HASH) {
+	}
+
+	//! Set up the executor that computes the PARTITION BY and ORDER BY keys of the first window expression
+	void InitializeKeys() {
+		auto &first = (BoundWindowExpression &)*op.select_list[0];
+		vector<LogicalType> key_types;
+		for (auto &pexpr : first.partitions) {
+			key_types.push_back(pexpr->return_type);
+			executor.AddExpression(*pexpr);
+		}
+		for (auto &order : first.orders) {
+			key_types.push_back(order.expression->return_type);
+			executor.AddExpression(*order.expression);
+		}
+		keys.Initialize(key_types);
 	}
 
 	PhysicalWindow &op;
+	//! The rows that the thread collected before the input was partitioned
 	ChunkCollection chunks;
+
+	//! The executor that computes the PARTITION BY and ORDER BY keys of the first window expression
+	ExpressionExecutor executor;
+	DataChunk keys;
+	Vector hashes;
+	//! The encoded rows of the current input chunk, before they are distributed over the partitions
+	BufferedSerializer encoded_rows;
+	vector<idx_t> row_offsets;
+	//! The partition buffers of the thread, empty until the thread starts partitioning its input
+	vector<unique_ptr<WindowPartitionBuffer>> partitions;
 };
 
 //! The operator state of the window
 class PhysicalWindowOperatorState : public PhysicalOperatorState {
 public:
 	PhysicalWindowOperatorState(PhysicalOperator &op, PhysicalOperator *child)
-	    : PhysicalOperatorState(op, child), position(0) {
+	    : PhysicalOperatorState(op, child), position(0), partition_idx(0) {
 	}
 
 	idx_t position;
+	//! The partition that is currently read, and its reader
+	idx_t partition_idx;
+	unique_ptr<SortedRunReader> reader;
 };
 
 // this implements a sorted window functions variant
@@ -112,8 +191,10 @@ static void MaterializeExpression(Expression *expr, ChunkCollection &input, Chun
 	MaterializeExpressions(&expr, 1, input, output, scalar);
 }
 
+//! Sort the input (and the output) by the PARTITION BY and ORDER BY keys of the window expression, the keys are
+//! materialized into the sort collection. If the input is already sorted by these keys only the keys are materialized.
 static void SortCollectionForWindow(BoundWindowExpression *wexpr, ChunkCollection &input, ChunkCollection &output,
-                                    ChunkCollection &sort_collection) {
+                                    ChunkCollection &sort_collection, bool is_sorted) {
 	vector<LogicalType> sort_types;
 	vector<OrderType> orders;
 	vector<OrderByNullType> null_order_types;
@@ -150,6 +231,9 @@ static void SortCollectionForWindow(BoundWindowExpression *wexpr, ChunkCollectio
 	}
 
 	D_ASSERT(input.Count() == sort_collection.Count());
+	if (is_sorted) {
+		return;
+	}
 
 	auto sorted_vector = unique_ptr<idx_t[]>(new idx_t[input.Count()]);
 	sort_collection.Sort(orders, null_order_types, sorted_vector.get());
@@ -294,12 +378,12 @@ static void UpdateWindowBoundaries(BoundWindowExpression *wexpr, ChunkCollection
 }
 
 static void ComputeWindowExpression(BoundWindowExpression *wexpr, ChunkCollection &input, ChunkCollection &output,
-                                    idx_t output_idx) {
+                                    idx_t output_idx, bool is_sorted = false) {
 
 	ChunkCollection sort_collection;
 	bool needs_sorting = wexpr->partitions.size() + wexpr->orders.size() > 0;
 	if (needs_sorting) {
-		SortCollectionForWindow(wexpr, input, output, sort_collection);
+		SortCollectionForWindow(wexpr, input, output, sort_collection, is_sorted);
 	}
 
 	// TODO we could evaluate those expressions in parallel
@@ -487,10 +571,81 @@ static void ComputeWindowExpression(BoundWindowExpression *wexpr, ChunkCollectio
 	}
 }
 
+//! Whether or not the two window expressions sort their input on the same keys
+static bool SameWindowOrder(BoundWindowExpression &a, BoundWindowExpression &b) {
+	if (a.partitions.size() != b.partitions.size() || a.orders.size() != b.orders.size()) {
+		return false;
+	}
+	for (idx_t prt_idx = 0; prt_idx < a.partitions.size(); prt_idx++) {
+		if (!Expression::Equals(a.partitions[prt_idx].get(), b.partitions[prt_idx].get())) {
+			return false;
+		}
+	}
+	for (idx_t ord_idx = 0; ord_idx < a.orders.size(); ord_idx++) {
+		auto &a_order = a.orders[ord_idx];
+		auto &b_order = b.orders[ord_idx];
+		if (a_order.type != b_order.type || a_order.null_order != b_order.null_order ||
+		    !Expression::Equals(a_order.expression.get(), b_order.expression.get())) {
+			return false;
+		}
+	}
+	return true;
+}
+
+//! Create the (NULL) window results for every chunk of the input
+static void InitializeWindowResults(vector<unique_ptr<Expression>> &select_list, ChunkCollection &input,
+                                    ChunkCollection &window_results) {
+	vector<LogicalType> window_types;
+	for (idx_t expr_idx = 0; expr_idx < select_list.size(); expr_idx++) {
+		window_types.push_back(select_list[expr_idx]->return_type);
+	}
+
+	for (idx_t i = 0; i < input.ChunkCount(); i++) {
+		DataChunk window_chunk;
+		window_chunk.Initialize(window_types);
+		window_chunk.SetCardinality(input.GetChunk(i).size());
+		for (idx_t col_idx = 0; col_idx < window_chunk.ColumnCount(); col_idx++) {
+			window_chunk.data[col_idx].SetVectorType(VectorType::CONSTANT_VECTOR);
+			ConstantVector::SetNull(window_chunk.data[col_idx], true);
+		}
+
+		window_chunk.Verify();
+		window_results.Append(window_chunk);
+	}
+	D_ASSERT(window_results.ColumnCount() == select_list.size());
+}
+
 void PhysicalWindow::GetChunkInternal(ExecutionContext &context, DataChunk &chunk, PhysicalOperatorState *state_p) {
 	auto state = reinterpret_cast<PhysicalWindowOperatorState *>(state_p);
 
 	auto &gstate = (WindowGlobalState &)*sink_state;
+	if (gstate.partitioned) {
+		// return the result rows partition by partition
+		idx_t count = 0;
+		while (count < STANDARD_VECTOR_SIZE) {
+			if (!state->reader) {
+				// move to the next partition that has any rows
+				while (state->partition_idx < gstate.partition_results.size() &&
+				       !gstate.partition_results[state->partition_idx]) {
+					state->partition_idx++;
+				}
+				if (state->partition_idx >= gstate.partition_results.size()) {
+					break;
+				}
+				state->reader = make_unique<SortedRunReader>(gstate.buffer_manager,
+				                                             *gstate.partition_results[state->partition_idx], false);
+			}
+			if (state->reader->Done()) {
+				state->reader.reset();
+				state->partition_idx++;
+				continue;
+			}
+			gstate.result_format->DecodeRow(state->reader->Current(), chunk, count++);
+			state->reader->Advance();
+		}
+		chunk.SetCardinality(count);
+		return;
+	}
 
 	ChunkCollection &big_data = gstate.chunks;
 	ChunkCollection &window_results = gstate.window_results;
@@ -523,49 +678,281 @@ unique_ptr<PhysicalOperatorState> PhysicalWindow::GetOperatorState() {
 	return make_unique<PhysicalWindowOperatorState>(*this, children[0].get());
 }
 
+bool PhysicalWindow::CanPartition() {
+	auto &first = (BoundWindowExpression &)*select_list[0];
+	if (first.partitions.empty()) {
+		// without PARTITION BY the entire input is a single partition
+		return false;
+	}
+	for (auto &expr : select_list) {
+		D_ASSERT(expr->GetExpressionClass() == ExpressionClass::BOUND_WINDOW);
+		auto &wexpr = (BoundWindowExpression &)*expr;
+		// all window expressions have to be partitioned on the same keys
+		if (wexpr.partitions.size() != first.partitions.size()) {
+			return false;
+		}
+		for (idx_t prt_idx = 0; prt_idx < wexpr.partitions.size(); prt_idx++) {
+			if (!Expression::Equals(wexpr.partitions[prt_idx].get(), first.partitions[prt_idx].get())) {
+				return false;
+			}
+		}
+		// the window results are stored in the row format until they are read
+		if (!SortRowFormat::SupportsPayloadType(wexpr.return_type)) {
+			return false;
+		}
+	}
+	// the input rows are sorted in the row format
+	for (auto &pexpr : first.partitions) {
+		if (!SortRowFormat::SupportsKeyType(pexpr->return_type)) {
+			return false;
+		}
+	}
+	for (auto &order : first.orders) {
+		if (!SortRowFormat::SupportsKeyType(order.expression->return_type)) {
+			return false;
+		}
+	}
+	for (auto &type : children[0]->types) {
+		if (!SortRowFormat::SupportsPayloadType(type)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+//! Distribute the rows of the input chunk over the partition buffers of the thread
+static void PartitionChunk(PhysicalWindow &op, WindowGlobalState &gstate, WindowLocalState &lstate,
+                           DataChunk &input) {
+	// compute the sort keys and encode the rows
+	lstate.keys.Reset();
+	lstate.executor.Execute(input, lstate.keys);
+	lstate.encoded_rows.Reset();
+	lstate.row_offsets.clear();
+	gstate.input_format->EncodeRows(lstate.keys, input, lstate.encoded_rows, lstate.row_offsets);
+
+	// the PARTITION BY keys are the first sort keys, their hash determines the partition of a row
+	auto &first = (BoundWindowExpression &)*op.select_list[0];
+	VectorOperations::Hash(lstate.keys.data[0], lstate.hashes, input.size());
+	for (idx_t prt_idx = 1; prt_idx < first.partitions.size(); prt_idx++) {
+		VectorOperations::CombineHash(lstate.hashes, lstate.keys.data[prt_idx], input.size());
+	}
+	VectorData hdata;
+	lstate.hashes.Orrify(input.size(), hdata);
+	auto hash_data = (hash_t *)hdata.data;
+	idx_t shift = sizeof(hash_t) * 8 - WINDOW_PARTITION_RADIX_BITS;
+	for (idx_t i = 0; i < input.size(); i++) {
+		// the hash is mixed first: the upper bits of the hashes of short strings are always zero
+		auto partition_idx = murmurhash64(hash_data[hdata.sel->get_index(i)]) >> shift;
+		auto &partition = *lstate.partitions[partition_idx];
+		auto row = lstate.encoded_rows.data + lstate.row_offsets[i];
+		partition.row_offsets.push_back(partition.rows.blob.size);
+		partition.rows.WriteData(row, SortRowFormat::RowSize(row));
+		if (partition.rows.blob.size >= WINDOW_PARTITION_BUFFER_SIZE) {
+			// the buffer of the partition is full: sort it and write it to a sorted run
+			partition.FlushRun(gstate.buffer_manager);
+		}
+	}
+}
+
+//! Switch the thread to partitioning its input, partitioning the rows that were collected so far
+static void StartPartitioning(PhysicalWindow &op, WindowGlobalState &gstate, WindowLocalState &lstate,
+                              ChunkCollection &collected) {
+	D_ASSERT(lstate.partitions.empty());
+	for (idx_t partition_idx = 0; partition_idx < (idx_t(1) << WINDOW_PARTITION_RADIX_BITS); partition_idx++) {
+		lstate.partitions.push_back(make_unique<WindowPartitionBuffer>());
+	}
+	for (idx_t chunk_idx = 0; chunk_idx < collected.ChunkCount(); chunk_idx++) {
+		PartitionChunk(op, gstate, lstate, collected.GetChunk(chunk_idx));
+	}
+	collected.Reset();
+}
+
+//! Write the remaining rows of the partition buffers of a thread to sorted runs and add them to the global state
+static void CombinePartitions(WindowGlobalState &gstate, WindowLocalState &lstate) {
+	for (auto &partition : lstate.partitions) {
+		partition->FlushRun(gstate.buffer_manager);
+	}
+
+	lock_guard<mutex> glock(gstate.lock);
+	for (idx_t partition_idx = 0; partition_idx < lstate.partitions.size(); partition_idx++) {
+		for (auto &run : lstate.partitions[partition_idx]->sorted_runs) {
+			gstate.partition_runs[partition_idx].push_back(move(run));
+		}
+	}
+	lstate.partitions.clear();
+}
+
 void PhysicalWindow::Sink(ExecutionContext &context, GlobalOperatorState &state, LocalSinkState &lstate_p,
                           DataChunk &input) {
+	auto &gstate = (WindowGlobalState &)state;
 	auto &lstate = (WindowLocalState &)lstate_p;
-	lstate.chunks.Append(input);
+	if (lstate.partitions.empty()) {
+		lstate.chunks.Append(input);
+		if (!gstate.can_partition) {
+			return;
+		}
+		// partitioning is decided on the amount of rows that is actually collected, not on the estimate
+		gstate.sink_count += input.size();
+		if (!gstate.partitioned && gstate.sink_count < WINDOW_PARTITION_MIN_CARDINALITY) {
+			return;
+		}
+		gstate.partitioned = true;
+		StartPartitioning(*this, gstate, lstate, lstate.chunks);
+		return;
+	}
+	PartitionChunk(*this, gstate, lstate, input);
 }
 
 void PhysicalWindow::Combine(ExecutionContext &context, GlobalOperatorState &gstate_p, LocalSinkState &lstate_p) {
 	auto &gstate = (WindowGlobalState &)gstate_p;
 	auto &lstate = (WindowLocalState &)lstate_p;
-	lock_guard<mutex> glock(gstate.lock);
-	gstate.chunks.Merge(lstate.chunks);
+	if (lstate.partitions.empty()) {
+		lock_guard<mutex> glock(gstate.lock);
+		gstate.chunks.Merge(lstate.chunks);
+		return;
+	}
+	CombinePartitions(gstate, lstate);
 }
 
-void PhysicalWindow::Finalize(Pipeline &pipeline, ClientContext &context, unique_ptr<GlobalOperatorState> gstate_p) {
-	this->sink_state = move(gstate_p);
-	auto &gstate = (WindowGlobalState &)*this->sink_state;
+//! Merge the sorted runs of a partition, evaluate the window expressions over it and write the result rows to a run
+//! The rows of a partition (all rows with PARTITION BY keys that hash to it) are evaluated in memory, so a partition
+//! has to fit in memory: this is what limits the input size for a skewed or low-cardinality PARTITION BY.
+static void EvaluatePartition(WindowGlobalState &state, idx_t partition_idx) {
+	auto &op = state.op;
+	auto &buffer_manager = state.buffer_manager;
+	auto &runs = state.partition_runs[partition_idx];
+	D_ASSERT(!runs.empty());
+	// merge the sorted runs of all threads into a single run
+	if (runs.size() > 1) {
+		auto merged_run = MergeSortedRuns(buffer_manager, runs);
+		runs.clear();
+		runs.push_back(move(merged_run));
+	}
+
+	// read the sorted partition
+	ChunkCollection input;
+	DataChunk chunk;
+	chunk.Initialize(op.children[0]->types);
+	SortedRunReader reader(buffer_manager, *runs[0], true);
+	while (!reader.Done()) {
+		chunk.Reset();
+		idx_t count = 0;
+		for (; count < STANDARD_VECTOR_SIZE && !reader.Done(); count++) {
+			state.input_format->DecodeRow(reader.Current(), chunk, count);
+			reader.Advance();
+		}
+		chunk.SetCardinality(count);
+		input.Append(chunk);
+	}
+	runs.clear();
 
-	ChunkCollection &big_data = gstate.chunks;
-	ChunkCollection &window_results = gstate.window_results;
+	// evaluate the window expressions; the partition is sorted on the keys of the first window expression, and a
+	// window expression only sorts the partition again if it orders it differently than the previous one
+	ChunkCollection window_results;
+	InitializeWindowResults(op.select_list, input, window_results);
+	auto sorted_by = (BoundWindowExpression *)op.select_list[0].get();
+	for (idx_t expr_idx = 0; expr_idx < op.select_list.size(); expr_idx++) {
+		auto wexpr = (BoundWindowExpression *)op.select_list[expr_idx].get();
+		ComputeWindowExpression(wexpr, input, window_results, expr_idx, SameWindowOrder(*sorted_by, *wexpr));
+		sorted_by = wexpr;
+	}
+
+	// write the result rows to a run, so that the partition can be evicted until it is read
+	auto result = make_unique<SortedRun>();
+	SortedRunWriter writer(buffer_manager, *result);
+	// the result rows are returned in the order of the partition, so they have no sort keys
+	DataChunk keys;
+	DataChunk result_chunk;
+	result_chunk.InitializeEmpty(op.types);
+	BufferedSerializer encoded_rows;
+	vector<idx_t> row_offsets;
+	for (idx_t i = 0; i < input.ChunkCount(); i++) {
+		auto &input_chunk = input.GetChunk(i);
+		auto &window_chunk = window_results.GetChunk(i);
+		D_ASSERT(input_chunk.size() == window_chunk.size());
+		idx_t out_idx = 0;
+		for (idx_t col_idx = 0; col_idx < input_chunk.ColumnCount(); col_idx++) {
+			result_chunk.data[out_idx++].Reference(input_chunk.data[col_idx]);
+		}
+		for (idx_t col_idx = 0; col_idx < window_chunk.ColumnCount(); col_idx++) {
+			result_chunk.data[out_idx++].Reference(window_chunk.data[col_idx]);
+		}
+		result_chunk.SetCardinality(input_chunk);
+		keys.SetCardinality(input_chunk);
+
+		encoded_rows.Reset();
+		row_offsets.clear();
+		state.result_format->EncodeRows(keys, result_chunk, encoded_rows, row_offsets);
+		for (auto &row_offset : row_offsets) {
+			writer.Append(encoded_rows.data + row_offset);
+		}
+	}
+	writer.Finalize();
+	state.partition_results[partition_idx] = move(result);
+}
 
-	if (big_data.Count() == 0) {
-		return;
+//! Sorts and evaluates a single partition of the input
+class WindowPartitionTask : public Task {
+public:
+	WindowPartitionTask(Pipeline &parent_p, WindowGlobalState &state_p, idx_t partition_idx_p)
+	    : parent(parent_p), state(state_p), partition_idx(partition_idx_p) {
 	}
 
-	vector<LogicalType> window_types;
-	for (idx_t expr_idx = 0; expr_idx < select_list.size(); expr_idx++) {
-		window_types.push_back(select_list[expr_idx]->return_type);
+	void Execute() override {
+		try {
+			EvaluatePartition(state, partition_idx);
+		} catch (std::exception &ex) {
+			parent.executor.PushError(ex.what());
+		} catch (...) {
+			parent.executor.PushError("Unknown exception in window partition evaluation!");
+		}
+		lock_guard<mutex> glock(state.lock);
+		parent.finished_tasks++;
+		// finish the whole pipeline
+		if (parent.total_tasks == parent.finished_tasks) {
+			parent.Finish();
+		}
 	}
 
-	for (idx_t i = 0; i < big_data.ChunkCount(); i++) {
-		DataChunk window_chunk;
-		window_chunk.Initialize(window_types);
-		window_chunk.SetCardinality(big_data.GetChunk(i).size());
-		for (idx_t col_idx = 0; col_idx < window_chunk.ColumnCount(); col_idx++) {
-			window_chunk.data[col_idx].SetVectorType(VectorType::CONSTANT_VECTOR);
-			ConstantVector::SetNull(window_chunk.data[col_idx], true);
+private:
+	Pipeline &parent;
+	WindowGlobalState &state;
+	idx_t partition_idx;
+};
+
+void PhysicalWindow::Finalize(Pipeline &pipeline, ClientContext &context, unique_ptr<GlobalOperatorState> gstate_p) {
+	auto &gstate = (WindowGlobalState &)*gstate_p;
+	if (gstate.partitioned) {
+		if (gstate.chunks.Count() > 0) {
+			// partition the rows of the threads that finished collecting before the input was partitioned
+			WindowLocalState lstate(*this);
+			lstate.InitializeKeys();
+			StartPartitioning(*this, gstate, lstate, gstate.chunks);
+			CombinePartitions(gstate, lstate);
 		}
+		PhysicalSink::Finalize(pipeline, context, move(gstate_p));
+		// every partition is sorted and evaluated by a separate task
+		lock_guard<mutex> glock(gstate.lock);
+		for (idx_t partition_idx = 0; partition_idx < gstate.partition_runs.size(); partition_idx++) {
+			if (gstate.partition_runs[partition_idx].empty()) {
+				continue;
+			}
+			pipeline.total_tasks++;
+			auto new_task = make_unique<WindowPartitionTask>(pipeline, gstate, partition_idx);
+			TaskScheduler::GetScheduler(context).ScheduleTask(pipeline.token, move(new_task));
+		}
+		return;
+	}
+	this->sink_state = move(gstate_p);
 
-		window_chunk.Verify();
-		window_results.Append(window_chunk);
+	ChunkCollection &big_data = gstate.chunks;
+	ChunkCollection &window_results = gstate.window_results;
+
+	if (big_data.Count() == 0) {
+		return;
 	}
 
-	D_ASSERT(window_results.ColumnCount() == select_list.size());
+	InitializeWindowResults(select_list, big_data, window_results);
 	idx_t window_output_idx = 0;
 	// we can have multiple window functions
 	for (idx_t expr_idx = 0; expr_idx < select_list.size(); expr_idx++) {
@@ -577,11 +964,36 @@ void PhysicalWindow::Finalize(Pipeline &pipeline, ClientContext &context, unique
 }
 
 unique_ptr<LocalSinkState> PhysicalWindow::GetLocalSinkState(ExecutionContext &context) {
-	return make_unique<WindowLocalState>(*this);
+	auto state = make_unique<WindowLocalState>(*this);
+	if (CanPartition()) {
+		state->InitializeKeys();
+	}
+	return move(state);
 }
 
 unique_ptr<GlobalOperatorState> PhysicalWindow::GetGlobalState(ClientContext &context) {
-	return make_unique<WindowGlobalState>(*this, context);
+	auto state = make_unique<WindowGlobalState>(*this, context);
+	if (CanPartition()) {
+		state->can_partition = true;
+		// the rows are sorted the same way SortCollectionForWindow sorts them for the first window expression
+		auto &first = (BoundWindowExpression &)*select_list[0];
+		vector<OrderType> order_types;
+		vector<OrderByNullType> null_orders;
+		for (idx_t prt_idx = 0; prt_idx < first.partitions.size(); prt_idx++) {
+			order_types.push_back(OrderType::ASCENDING);
+			null_orders.push_back(OrderByNullType::NULLS_FIRST);
+		}
+		for (auto &order : first.orders) {
+			order_types.push_back(order.type);
+			null_orders.push_back(order.null_order);
+		}
+		state->input_format = make_unique<SortRowFormat>(move(order_types), move(null_orders), children[0]->types);
+		state->result_format = make_unique<SortRowFormat>(vector<OrderType>(), vector<OrderByNullType>(), types);
+		idx_t partition_count = idx_t(1) << WINDOW_PARTITION_RADIX_BITS;
+		state->partition_runs.resize(partition_count);
+		state->partition_results.resize(partition_count);
+	}
+	return move(state);
 }
 
 string PhysicalWindow::ParamsToString() const {
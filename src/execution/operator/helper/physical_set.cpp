@@ -7,6 +7,7 @@ namespace duckdb {
 void PhysicalSet::GetChunkInternal(ExecutionContext &context, DataChunk &chunk, PhysicalOperatorState *state) {
 	auto &db = context.client.db;
 	db->config.set_variables[name] = value; // woop
+	db->config.set_variables_version++;
 	state->finished = true;
 }
 
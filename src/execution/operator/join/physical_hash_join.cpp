@@ -1,13 +1,24 @@
 #include "duckdb/execution/operator/join/physical_hash_join.hpp"
 
 #include "duckdb/storage/storage_manager.hpp"
+#include "duckdb/common/serializer/buffered_deserializer.hpp"
+#include "duckdb/common/serializer/buffered_serializer.hpp"
 #include "duckdb/common/vector_operations/vector_operations.hpp"
 #include "duckdb/execution/expression_executor.hpp"
+#include "duckdb/execution/executor.hpp"
+#include "duckdb/main/client_context.hpp"
+#include "duckdb/parallel/pipeline.hpp"
+#include "duckdb/parallel/task_scheduler.hpp"
 #include "duckdb/storage/buffer_manager.hpp"
 #include "duckdb/function/aggregate/distributive_functions.hpp"
 
 namespace duckdb {
 
+//! The maximum amount of radix bits used to partition a hash table that does not fit in memory
+static constexpr idx_t HASH_JOIN_MAX_RADIX_BITS = 6;
+//! The minimum amount of blocks of the HT that are inserted into the pointer table by a single finalize task
+static constexpr idx_t HASH_JOIN_FINALIZE_BLOCKS_PER_TASK = 16;
+
 PhysicalHashJoin::PhysicalHashJoin(LogicalOperator &op, unique_ptr<PhysicalOperator> left,
                                    unique_ptr<PhysicalOperator> right, vector<JoinCondition> cond, JoinType join_type,
                                    const vector<idx_t> &left_projection_map,
@@ -43,6 +54,8 @@ public:
 	DataChunk build_chunk;
 	DataChunk join_keys;
 	ExpressionExecutor build_executor;
+	//! The thread-local HT, merged into the global HT in Combine
+	unique_ptr<JoinHashTable> hash_table;
 };
 
 class HashJoinGlobalState : public GlobalOperatorState {
@@ -50,10 +63,16 @@ public:
 	HashJoinGlobalState() {
 	}
 
+	//! The lock for finishing the finalize tasks and for releasing the resident partition
+	mutex lock;
 	//! The HT used by the join
 	unique_ptr<JoinHashTable> hash_table;
 	//! Only used for FULL OUTER JOIN: scan state of the final scan to find unmatched tuples in the build-side
 	JoinHTScanState ht_scan_state;
+	//! Only used if the HT is partitioned: whether or not the pin that Finalize holds on the partition that is probed
+	//! while streaming (partition 0) is still held. It is released by the first thread that exhausts the probe side,
+	//! the other threads hold their own pin until they exhaust the probe side.
+	bool resident_pinned = false;
 };
 
 unique_ptr<GlobalOperatorState> PhysicalHashJoin::GetGlobalState(ClientContext &context) {
@@ -114,6 +133,12 @@ unique_ptr<LocalSinkState> PhysicalHashJoin::GetLocalSinkState(ExecutionContext
 		state->build_executor.AddExpression(*cond.right);
 	}
 	state->join_keys.Initialize(condition_types);
+	if (join_type != JoinType::MARK || delim_types.empty()) {
+		// every thread builds a local HT without synchronization, these are merged in Combine
+		// the correlated MARK join is built directly into the global HT, as it also maintains the correlated counts
+		state->hash_table = make_unique<JoinHashTable>(BufferManager::GetBufferManager(context.client), conditions,
+		                                               build_types, join_type);
+	}
 	return move(state);
 }
 
@@ -121,6 +146,7 @@ void PhysicalHashJoin::Sink(ExecutionContext &context, GlobalOperatorState &stat
                             DataChunk &input) {
 	auto &sink = (HashJoinGlobalState &)state;
 	auto &lstate = (HashJoinLocalState &)lstate_p;
+	auto &hash_table = lstate.hash_table ? *lstate.hash_table : *sink.hash_table;
 	// resolve the join keys for the right chunk
 	lstate.build_executor.Execute(input, lstate.join_keys);
 	// build the HT
@@ -131,19 +157,129 @@ void PhysicalHashJoin::Sink(ExecutionContext &context, GlobalOperatorState &stat
 		for (idx_t i = 0; i < right_projection_map.size(); i++) {
 			lstate.build_chunk.data[i].Reference(input.data[right_projection_map[i]]);
 		}
-		sink.hash_table->Build(lstate.join_keys, lstate.build_chunk);
+		hash_table.Build(lstate.join_keys, lstate.build_chunk);
 	} else {
 		// there is not a projected map: place the entire right chunk in the HT
-		sink.hash_table->Build(lstate.join_keys, input);
+		hash_table.Build(lstate.join_keys, input);
+	}
+}
+
+void PhysicalHashJoin::Combine(ExecutionContext &context, GlobalOperatorState &state, LocalSinkState &lstate_p) {
+	auto &sink = (HashJoinGlobalState &)state;
+	auto &lstate = (HashJoinLocalState &)lstate_p;
+	if (lstate.hash_table) {
+		sink.hash_table->Merge(*lstate.hash_table);
 	}
 }
 
 //===--------------------------------------------------------------------===//
 // Finalize
 //===--------------------------------------------------------------------===//
+//! Inserts a range of blocks of the HT into the pointer table
+class PhysicalHashJoinFinalizeTask : public Task {
+public:
+	PhysicalHashJoinFinalizeTask(Pipeline &parent_p, HashJoinGlobalState &state_p, idx_t block_idx_start_p,
+	                             idx_t block_idx_end_p)
+	    : parent(parent_p), state(state_p), block_idx_start(block_idx_start_p), block_idx_end(block_idx_end_p) {
+	}
+
+	void Execute() override {
+		try {
+			state.hash_table->Finalize(block_idx_start, block_idx_end, true);
+		} catch (std::exception &ex) {
+			parent.executor.PushError(ex.what());
+		} catch (...) {
+			parent.executor.PushError("Unknown exception in hash join finalize!");
+		}
+		lock_guard<mutex> glock(state.lock);
+		parent.finished_tasks++;
+		// finish the whole pipeline
+		if (parent.total_tasks == parent.finished_tasks) {
+			parent.Finish();
+		}
+	}
+
+private:
+	Pipeline &parent;
+	HashJoinGlobalState &state;
+	idx_t block_idx_start;
+	idx_t block_idx_end;
+};
+
+bool PhysicalHashJoin::CanPartition() {
+	if (IsRightOuterJoin(join_type)) {
+		// the unmatched tuples of the build side are found by scanning the entire HT after the probe
+		return false;
+	}
+	if (join_type == JoinType::MARK && !delim_types.empty()) {
+		// the correlated MARK join keeps additional (unpartitioned) counts
+		return false;
+	}
+	// the rows of the probe side are serialized when they are spilled
+	for (auto &type : children[0]->types) {
+		switch (type.InternalType()) {
+		case PhysicalType::BOOL:
+		case PhysicalType::INT8:
+		case PhysicalType::INT16:
+		case PhysicalType::INT32:
+		case PhysicalType::INT64:
+		case PhysicalType::UINT8:
+		case PhysicalType::UINT16:
+		case PhysicalType::UINT32:
+		case PhysicalType::UINT64:
+		case PhysicalType::INT128:
+		case PhysicalType::FLOAT:
+		case PhysicalType::DOUBLE:
+		case PhysicalType::VARCHAR:
+			break;
+		default:
+			return false;
+		}
+	}
+	return true;
+}
+
 void PhysicalHashJoin::Finalize(Pipeline &pipeline, ClientContext &context, unique_ptr<GlobalOperatorState> state) {
 	auto &sink = (HashJoinGlobalState &)*state;
-	sink.hash_table->Finalize();
+	auto &ht = *sink.hash_table;
+	// we keep at most half of the available memory pinned for the HT
+	auto memory_limit = BufferManager::GetBufferManager(context).GetMaxMemory();
+	auto memory_budget = MinValue<idx_t>(memory_limit, context.query_memory_limit) / 2;
+	auto ht_size = ht.SizeInBytes();
+	if (ht_size > memory_budget && CanPartition()) {
+		// the HT does not fit in memory: switch to partitioned mode
+		// we choose the partition count so that every thread can probe a separate partition at the same time
+		idx_t thread_count = TaskScheduler::GetScheduler(context).NumberOfThreads();
+		idx_t partition_budget = MaxValue<idx_t>(memory_budget / (thread_count + 1), Storage::BLOCK_ALLOC_SIZE);
+		idx_t radix_bits = 1;
+		while (radix_bits < HASH_JOIN_MAX_RADIX_BITS && (ht_size >> radix_bits) > partition_budget) {
+			radix_bits++;
+		}
+		ht.Partition(radix_bits);
+		// the first partition stays pinned and is probed directly, the probe-side rows of the other partitions are
+		// spilled and probed partition-by-partition after the probe side has been exhausted
+		ht.PinPartition(0);
+		sink.resident_pinned = true;
+	} else {
+		idx_t thread_count = TaskScheduler::GetScheduler(context).NumberOfThreads();
+		idx_t task_count = MinValue<idx_t>(thread_count, ht.BlockCount() / HASH_JOIN_FINALIZE_BLOCKS_PER_TASK);
+		if (task_count > 1) {
+			// large HT: insert the blocks into the pointer table in parallel
+			ht.InitializePointerTable();
+			PhysicalSink::Finalize(pipeline, context, move(state));
+
+			idx_t blocks_per_task = (ht.BlockCount() + task_count - 1) / task_count;
+			pipeline.total_tasks += task_count;
+			for (idx_t task_idx = 0; task_idx < task_count; task_idx++) {
+				idx_t block_idx_start = task_idx * blocks_per_task;
+				idx_t block_idx_end = MinValue<idx_t>(block_idx_start + blocks_per_task, ht.BlockCount());
+				auto new_task = make_unique<PhysicalHashJoinFinalizeTask>(pipeline, sink, block_idx_start, block_idx_end);
+				TaskScheduler::GetScheduler(context).ScheduleTask(pipeline.token, move(new_task));
+			}
+			return;
+		}
+		ht.Finalize();
+	}
 
 	PhysicalSink::Finalize(pipeline, context, move(state));
 }
@@ -151,17 +287,86 @@ void PhysicalHashJoin::Finalize(Pipeline &pipeline, ClientContext &context, uniq
 //===--------------------------------------------------------------------===//
 // GetChunkInternal
 //===--------------------------------------------------------------------===//
+//! The spilled probe-side rows of a single partition of a partitioned HT
+class HashJoinSpilledPartition {
+public:
+	struct SpillBlock {
+		shared_ptr<BlockHandle> block;
+		idx_t size;
+		idx_t capacity;
+	};
+	vector<SpillBlock> blocks;
+
+public:
+	//! Serialize the chunk and append it to the spilled rows
+	void Append(BufferManager &buffer_manager, DataChunk &chunk, BufferedSerializer &serializer) {
+		serializer.Reset();
+		chunk.Serialize(serializer);
+		idx_t chunk_size = serializer.blob.size;
+		idx_t required_size = sizeof(uint32_t) + chunk_size;
+
+		unique_ptr<BufferHandle> handle;
+		if (blocks.empty() || blocks.back().size + required_size > blocks.back().capacity) {
+			// allocate a new block, these blocks are written to the temporary directory when memory runs low
+			SpillBlock new_block;
+			new_block.block = buffer_manager.RegisterMemory(
+			    MaxValue<idx_t>(Storage::BLOCK_ALLOC_SIZE, required_size + Storage::BLOCK_HEADER_SIZE), false);
+			handle = buffer_manager.Pin(new_block.block);
+			new_block.size = 0;
+			new_block.capacity = handle->node->size;
+			blocks.push_back(move(new_block));
+		} else {
+			handle = buffer_manager.Pin(blocks.back().block);
+		}
+		auto &block = blocks.back();
+		auto dataptr = handle->node->buffer + block.size;
+		Store<uint32_t>(chunk_size, dataptr);
+		memcpy(dataptr + sizeof(uint32_t), serializer.blob.data.get(), chunk_size);
+		block.size += required_size;
+	}
+};
+
 class PhysicalHashJoinState : public PhysicalOperatorState {
 public:
 	PhysicalHashJoinState(PhysicalOperator &op, PhysicalOperator *left, PhysicalOperator *right,
 	                      vector<JoinCondition> &conditions)
-	    : PhysicalOperatorState(op, left) {
+	    : PhysicalOperatorState(op, left), partitioned_ht(nullptr), resident_partition(nullptr),
+	      probe_partition(nullptr), partition_idx(0), probe_finished(false), spill_block_idx(0), spill_offset(0) {
+	}
+	~PhysicalHashJoinState() override {
+		if (resident_partition) {
+			partitioned_ht->UnpinPartition(0);
+		}
+		if (probe_partition) {
+			partitioned_ht->UnpinPartition(partition_idx);
+		}
 	}
 
 	DataChunk cached_chunk;
 	DataChunk join_keys;
 	ExpressionExecutor probe_executor;
 	unique_ptr<JoinHashTable::ScanStructure> scan_structure;
+
+	//! Only used if the HT is partitioned
+	JoinHashTable *partitioned_ht;
+	//! The partition that is probed while streaming the probe side, pinned until the probe side is exhausted
+	JoinHashTable *resident_partition;
+	//! The partition of the HT that the spilled rows of the current partition are probed with
+	JoinHashTable *probe_partition;
+	//! The partition of which the spilled rows are probed
+	idx_t partition_idx;
+	//! Whether or not the probe side has been exhausted
+	bool probe_finished;
+	//! The probe-side rows of every partition that were spilled because the partition was not in memory
+	vector<HashJoinSpilledPartition> spilled_partitions;
+	//! The read position within the spilled rows of the current partition
+	idx_t spill_block_idx;
+	idx_t spill_offset;
+	//! Intermediate structures used for spilling the probe side
+	DataChunk partition_chunk;
+	BufferedSerializer spill_serializer;
+	vector<idx_t> partition_offsets;
+	SelectionVector partition_sel;
 };
 
 unique_ptr<PhysicalOperatorState> PhysicalHashJoin::GetOperatorState() {
@@ -224,6 +429,10 @@ void PhysicalHashJoin::GetChunkInternal(ExecutionContext &context, DataChunk &ch
 void PhysicalHashJoin::ProbeHashTable(ExecutionContext &context, DataChunk &chunk, PhysicalOperatorState *state_p) {
 	auto state = reinterpret_cast<PhysicalHashJoinState *>(state_p);
 	auto &sink = (HashJoinGlobalState &)*sink_state;
+	if (sink.hash_table->IsPartitioned()) {
+		ProbePartitionedHashTable(context, chunk, *state);
+		return;
+	}
 
 	if (state->child_chunk.size() > 0 && state->scan_structure) {
 		// still have elements remaining from the previous probe (i.e. we got
@@ -255,4 +464,164 @@ void PhysicalHashJoin::ProbeHashTable(ExecutionContext &context, DataChunk &chun
 	} while (chunk.size() == 0);
 }
 
+//! Spill the rows of the probe chunk that do not belong to the resident partition, and slice the probe chunk so only the
+//! rows of the resident partition remain. Returns the amount of remaining rows.
+static idx_t SpillProbeRows(BufferManager &buffer_manager, JoinHashTable &ht, PhysicalHashJoinState &state) {
+	auto &probe_chunk = state.child_chunk;
+	idx_t count = probe_chunk.size();
+	idx_t partition_count = ht.PartitionCount();
+	if (state.spilled_partitions.empty()) {
+		state.spilled_partitions.resize(partition_count);
+		state.partition_offsets.resize(partition_count + 1);
+		state.partition_sel.Initialize(STANDARD_VECTOR_SIZE);
+		auto types = probe_chunk.GetTypes();
+		state.partition_chunk.InitializeEmpty(types);
+	}
+	idx_t partition_indices[STANDARD_VECTOR_SIZE];
+	ht.GetPartitionIndices(state.join_keys, partition_indices);
+
+	// radix-sort the rows of the chunk by partition
+	auto &offsets = state.partition_offsets;
+	std::fill(offsets.begin(), offsets.end(), 0);
+	for (idx_t i = 0; i < count; i++) {
+		offsets[partition_indices[i] + 1]++;
+	}
+	if (offsets[1] == count) {
+		// all rows belong to the resident partition
+		return count;
+	}
+	for (idx_t partition_idx = 0; partition_idx < partition_count; partition_idx++) {
+		offsets[partition_idx + 1] += offsets[partition_idx];
+	}
+	for (idx_t i = 0; i < count; i++) {
+		state.partition_sel.set_index(offsets[partition_indices[i]]++, i);
+	}
+	// after the scatter the offsets point to the end of every partition
+	for (idx_t partition_idx = 1; partition_idx < partition_count; partition_idx++) {
+		idx_t partition_start = offsets[partition_idx - 1];
+		idx_t partition_size = offsets[partition_idx] - partition_start;
+		if (partition_size == 0) {
+			continue;
+		}
+		SelectionVector sel(state.partition_sel.data() + partition_start);
+		state.partition_chunk.Slice(probe_chunk, sel, partition_size);
+		state.spilled_partitions[partition_idx].Append(buffer_manager, state.partition_chunk, state.spill_serializer);
+	}
+	// only keep the rows of the resident partition
+	idx_t resident_count = offsets[0];
+	if (resident_count > 0) {
+		SelectionVector resident_sel(STANDARD_VECTOR_SIZE);
+		for (idx_t i = 0; i < resident_count; i++) {
+			resident_sel.set_index(i, state.partition_sel.get_index(i));
+		}
+		probe_chunk.Slice(resident_sel, resident_count);
+		state.join_keys.Slice(resident_sel, resident_count);
+	}
+	return resident_count;
+}
+
+//! Read the next chunk of spilled probe-side rows into the probe chunk, pinning the partition it belongs to. Returns
+//! false if all the spilled rows have been read.
+static bool ReadSpilledRows(BufferManager &buffer_manager, JoinHashTable &ht, PhysicalHashJoinState &state) {
+	if (state.partition_idx == 0) {
+		// the resident partition is never spilled
+		state.partition_idx = 1;
+	}
+	for (; state.partition_idx < state.spilled_partitions.size();
+	     state.partition_idx++, state.spill_block_idx = 0, state.spill_offset = 0) {
+		auto &spilled = state.spilled_partitions[state.partition_idx];
+		if (state.spill_block_idx < spilled.blocks.size()) {
+			if (!state.probe_partition) {
+				state.probe_partition = &ht.PinPartition(state.partition_idx);
+			}
+			auto &block = spilled.blocks[state.spill_block_idx];
+			auto handle = buffer_manager.Pin(block.block);
+			auto dataptr = handle->node->buffer + state.spill_offset;
+			auto chunk_size = Load<uint32_t>(dataptr);
+			BufferedDeserializer source(dataptr + sizeof(uint32_t), chunk_size);
+			state.child_chunk.Destroy();
+			state.child_chunk.Deserialize(source);
+
+			state.spill_offset += sizeof(uint32_t) + chunk_size;
+			if (state.spill_offset >= block.size) {
+				// finished reading this block: release it
+				handle.reset();
+				block.block.reset();
+				state.spill_block_idx++;
+				state.spill_offset = 0;
+			}
+			return true;
+		}
+		// finished probing this partition: unpin it
+		if (state.probe_partition) {
+			ht.UnpinPartition(state.partition_idx);
+			state.probe_partition = nullptr;
+		}
+	}
+	return false;
+}
+
+void PhysicalHashJoin::ProbePartitionedHashTable(ExecutionContext &context, DataChunk &chunk,
+                                                 PhysicalHashJoinState &state) {
+	auto &sink = (HashJoinGlobalState &)*sink_state;
+	auto &ht = *sink.hash_table;
+	auto &buffer_manager = BufferManager::GetBufferManager(context.client);
+	state.partitioned_ht = &ht;
+	while (true) {
+		if (state.scan_structure) {
+			// still have elements remaining from the previous probe
+			state.scan_structure->Next(state.join_keys, state.child_chunk, chunk);
+			if (chunk.size() > 0) {
+				return;
+			}
+			state.scan_structure = nullptr;
+		}
+		JoinHashTable *partition;
+		if (!state.probe_finished) {
+			// fetch the chunk from the left side
+			children[0]->GetChunk(context, state.child_chunk, state.child_state.get());
+			if (state.child_chunk.size() == 0) {
+				// unpin the resident partition before the spilled partitions are pinned
+				state.probe_finished = true;
+				if (state.resident_partition) {
+					ht.UnpinPartition(0);
+					state.resident_partition = nullptr;
+				}
+				lock_guard<mutex> glock(sink.lock);
+				if (sink.resident_pinned) {
+					ht.UnpinPartition(0);
+					sink.resident_pinned = false;
+				}
+				continue;
+			}
+			state.join_keys.Reset();
+			state.probe_executor.Execute(state.child_chunk, state.join_keys);
+			if (SpillProbeRows(buffer_manager, ht, state) == 0) {
+				continue;
+			}
+			if (!state.resident_partition) {
+				state.resident_partition = &ht.PinPartition(0);
+			}
+			partition = state.resident_partition;
+		} else {
+			// the probe side has been exhausted: probe the spilled rows partition-by-partition
+			if (!ReadSpilledRows(buffer_manager, ht, state)) {
+				return;
+			}
+			state.join_keys.Reset();
+			state.probe_executor.Execute(state.child_chunk, state.join_keys);
+			partition = state.probe_partition;
+		}
+		if (partition->size() == 0) {
+			partition->ProbeEmptyPartition(state.join_keys, state.child_chunk, chunk);
+			if (chunk.size() > 0) {
+				return;
+			}
+			continue;
+		}
+		// perform the actual probe
+		state.scan_structure = partition->Probe(state.join_keys);
+	}
+}
+
 } // namespace duckdb
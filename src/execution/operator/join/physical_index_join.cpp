@@ -33,7 +33,6 @@ public:
 	//! Vector of rows that mush be fetched for every LHS key
 	vector<vector<row_t>> rhs_rows;
 	ExpressionExecutor probe_executor;
-	IndexLock lock;
 };
 
 PhysicalIndexJoin::PhysicalIndexJoin(LogicalOperator &op, unique_ptr<PhysicalOperator> left,
@@ -126,23 +125,15 @@ void PhysicalIndexJoin::Output(ExecutionContext &context, DataChunk &chunk, Phys
 void PhysicalIndexJoin::GetRHSMatches(ExecutionContext &context, PhysicalOperatorState *state_p) const {
 	auto state = reinterpret_cast<PhysicalIndexJoinOperatorState *>(state_p);
 	auto &art = (ART &)*index;
-	auto &transaction = Transaction::GetTransaction(context.client);
-	for (idx_t i = 0; i < state->child_chunk.size(); i++) {
-		auto equal_value = state->join_keys.GetValue(0, i);
-		auto index_state = art.InitializeScanSinglePredicate(transaction, equal_value, ExpressionType::COMPARE_EQUAL);
-		state->rhs_rows[i].clear();
-		if (!equal_value.is_null) {
-			if (fetch_types.empty()) {
-				//! Nothing to materialize
-				art.SearchEqualJoinNoFetch(equal_value, state->result_sizes[i]);
-			} else {
-				art.SearchEqual((ARTIndexScanState *)index_state.get(), (idx_t)-1, state->rhs_rows[i]);
-				state->result_sizes[i] = state->rhs_rows[i].size();
-			}
-		} else {
-			//! This is null so no matches
-			state->result_sizes[i] = 0;
+	//! Probe the index with all keys of the LHS chunk at once, NULL keys have no matches
+	if (fetch_types.empty()) {
+		//! Nothing to materialize
+		art.SearchEqualBatch(state->join_keys, state->result_sizes.data(), nullptr);
+	} else {
+		for (idx_t i = 0; i < state->child_chunk.size(); i++) {
+			state->rhs_rows[i].clear();
 		}
+		art.SearchEqualBatch(state->join_keys, state->result_sizes.data(), state->rhs_rows.data());
 	}
 	for (idx_t i = state->child_chunk.size(); i < STANDARD_VECTOR_SIZE; i++) {
 		//! No LHS chunk value so result size is empty
@@ -152,9 +143,7 @@ void PhysicalIndexJoin::GetRHSMatches(ExecutionContext &context, PhysicalOperato
 
 void PhysicalIndexJoin::GetChunkInternal(ExecutionContext &context, DataChunk &chunk, PhysicalOperatorState *state_p) {
 	auto state = reinterpret_cast<PhysicalIndexJoinOperatorState *>(state_p);
-	if (!state->lock.index_lock) {
-		index->InitializeLock(state->lock);
-	}
+	// the probes do not lock the index: point lookups in the ART can run concurrently with appends
 	state->result_size = 0;
 	while (state->result_size == 0) {
 		//! Check if we need to get a new LHS chunk
@@ -3,18 +3,43 @@
 #include "duckdb/common/assert.hpp"
 #include "duckdb/common/value_operations/value_operations.hpp"
 #include "duckdb/common/vector_operations/vector_operations.hpp"
+#include "duckdb/execution/executor.hpp"
 #include "duckdb/execution/expression_executor.hpp"
+#include "duckdb/execution/operator/order/sorted_run.hpp"
+#include "duckdb/main/client_context.hpp"
+#include "duckdb/parallel/pipeline.hpp"
+#include "duckdb/parallel/task_scheduler.hpp"
+#include "duckdb/storage/buffer_manager.hpp"
 #include "duckdb/storage/data_table.hpp"
 
 namespace duckdb {
 
+//! The maximum amount of encoded data a thread buffers before it sorts the data and writes it out as a sorted run
+static constexpr idx_t SORT_RUN_BUFFER_SIZE = 64 * Storage::BLOCK_ALLOC_SIZE;
+
+static idx_t GetMemoryLimit(ClientContext &context) {
+	return MinValue<idx_t>(BufferManager::GetBufferManager(context).GetMaxMemory(), context.query_memory_limit);
+}
+
+//! Returns the amount of encoded data a thread buffers before it writes a sorted run. The buffers of all threads take
+//! at most a quarter of the memory limit, the rest is left for writing the runs (which copies the rows) and merging
+static idx_t GetRunBufferSize(ClientContext &context) {
+	auto memory_limit = GetMemoryLimit(context);
+	idx_t thread_count = TaskScheduler::GetScheduler(context).NumberOfThreads();
+	auto buffer_size = MinValue<idx_t>(memory_limit / (4 * thread_count), SORT_RUN_BUFFER_SIZE);
+	return MaxValue<idx_t>(buffer_size, Storage::BLOCK_ALLOC_SIZE);
+}
+
 class PhysicalOrderOperatorState : public PhysicalOperatorState {
 public:
 	PhysicalOrderOperatorState(PhysicalOperator &op, PhysicalOperator *child)
 	    : PhysicalOperatorState(op, child), position(0) {
 	}
 
+	//! The position in the sorted data, or the index of the next merged partition to read if sorted externally
 	idx_t position;
+	//! The reader of the current merged partition
+	unique_ptr<SortedRunReader> reader;
 };
 
 //===--------------------------------------------------------------------===//
@@ -22,32 +47,248 @@ public:
 //===--------------------------------------------------------------------===//
 class OrderByGlobalOperatorState : public GlobalOperatorState {
 public:
+	explicit OrderByGlobalOperatorState(BufferManager &buffer_manager)
+	    : buffer_manager(buffer_manager), external(true), pending_merges(0), final_merge(false), merge_failed(false) {
+	}
+
+	BufferManager &buffer_manager;
 	//! The lock for updating the global aggregate state
 	mutex lock;
-	//! The sorted data
+	//! Whether or not the data is sorted using the (external) row format; if this is false the types are not supported
+	//! by the row format and the data is collected in sorted_data and sorted in memory
+	bool external;
+	//! The row format of the sort
+	unique_ptr<SortRowFormat> format;
+	//! The sorted runs; after the merge these are the merged partitions, which together form the sorted result
+	vector<unique_ptr<SortedRun>> sorted_runs;
+	//! The groups of sorted runs that are merged; the final merge has a single group that contains all runs
+	vector<vector<unique_ptr<SortedRun>>> merge_groups;
+	//! The sort keys that split the sorted runs into the partitions that are merged in parallel in the final merge
+	vector<vector<data_t>> splitters;
+	//! The merged groups or partitions
+	vector<unique_ptr<SortedRun>> merged_runs;
+	//! The amount of groups or partitions that still have to be merged
+	idx_t pending_merges;
+	//! Whether the merge that is scheduled produces the sorted result
+	bool final_merge;
+	//! Whether one of the merge tasks failed
+	bool merge_failed;
+
+	//! The data, if sorted in memory
 	ChunkCollection sorted_data;
-	//! The sorted vector
+	//! The sorted vector, if sorted in memory
 	unique_ptr<idx_t[]> sorted_vector;
 };
 
+class OrderByLocalSinkState : public LocalSinkState {
+public:
+	OrderByLocalSinkState(BufferManager &buffer_manager, idx_t run_buffer_size)
+	    : run_buffer_size(run_buffer_size), row_buffer(buffer_manager, run_buffer_size) {
+	}
+
+	//! The executor that computes the sort keys
+	ExpressionExecutor executor;
+	//! The computed sort keys
+	DataChunk keys;
+	//! The amount of encoded data that is buffered before it is written to a sorted run
+	idx_t run_buffer_size;
+	//! The encoded rows that have not been written to a sorted run yet
+	SortedRunBuffer row_buffer;
+	vector<idx_t> row_offsets;
+	//! The sorted runs created by this thread
+	vector<unique_ptr<SortedRun>> sorted_runs;
+
+	void FlushRun(BufferManager &buffer_manager) {
+		if (row_offsets.empty()) {
+			return;
+		}
+		sorted_runs.push_back(CreateSortedRun(buffer_manager, row_buffer, row_offsets));
+		row_buffer.Reset();
+		row_offsets.clear();
+	}
+};
+
 unique_ptr<GlobalOperatorState> PhysicalOrder::GetGlobalState(ClientContext &context) {
-	return make_unique<OrderByGlobalOperatorState>();
+	auto state = make_unique<OrderByGlobalOperatorState>(BufferManager::GetBufferManager(context));
+	vector<OrderType> order_types;
+	vector<OrderByNullType> null_orders;
+	for (auto &order : orders) {
+		if (!SortRowFormat::SupportsKeyType(order.expression->return_type)) {
+			state->external = false;
+		}
+		order_types.push_back(order.type);
+		null_orders.push_back(order.null_order);
+	}
+	for (auto &type : types) {
+		if (!SortRowFormat::SupportsPayloadType(type)) {
+			state->external = false;
+		}
+	}
+	state->format = make_unique<SortRowFormat>(move(order_types), move(null_orders), types);
+	return move(state);
+}
+
+unique_ptr<LocalSinkState> PhysicalOrder::GetLocalSinkState(ExecutionContext &context) {
+	auto state = make_unique<OrderByLocalSinkState>(BufferManager::GetBufferManager(context.client),
+	                                                GetRunBufferSize(context.client));
+	vector<LogicalType> key_types;
+	for (auto &order : orders) {
+		key_types.push_back(order.expression->return_type);
+		state->executor.AddExpression(*order.expression);
+	}
+	state->keys.Initialize(key_types);
+	return move(state);
 }
 
-void PhysicalOrder::Sink(ExecutionContext &context, GlobalOperatorState &state, LocalSinkState &lstate,
+void PhysicalOrder::Sink(ExecutionContext &context, GlobalOperatorState &state, LocalSinkState &lstate_p,
                          DataChunk &input) {
-	// concatenate all the data of the child chunks
 	auto &gstate = (OrderByGlobalOperatorState &)state;
+	if (!gstate.external) {
+		// concatenate all the data of the child chunks
+		lock_guard<mutex> glock(gstate.lock);
+		gstate.sorted_data.Append(input);
+		return;
+	}
+	auto &lstate = (OrderByLocalSinkState &)lstate_p;
+	// compute the sort keys and encode the rows
+	lstate.keys.Reset();
+	lstate.executor.Execute(input, lstate.keys);
+	auto previous_size = lstate.row_buffer.blob.size;
+	gstate.format->EncodeRows(lstate.keys, input, lstate.row_buffer, lstate.row_offsets);
+	auto chunk_size = lstate.row_buffer.blob.size - previous_size;
+	if (lstate.row_buffer.blob.size + chunk_size > lstate.run_buffer_size) {
+		// the buffer is (almost) full: sort it and write it to a sorted run
+		// the run is written before another chunk of the same size would overflow the buffer, so the buffer normally
+		// does not have to grow beyond run_buffer_size
+		lstate.FlushRun(gstate.buffer_manager);
+	}
+}
+
+void PhysicalOrder::Combine(ExecutionContext &context, GlobalOperatorState &state, LocalSinkState &lstate_p) {
+	auto &gstate = (OrderByGlobalOperatorState &)state;
+	auto &lstate = (OrderByLocalSinkState &)lstate_p;
+	if (!gstate.external) {
+		return;
+	}
+	lstate.FlushRun(gstate.buffer_manager);
+	lstate.row_buffer.Release();
+
 	lock_guard<mutex> glock(gstate.lock);
-	gstate.sorted_data.Append(input);
+	for (auto &run : lstate.sorted_runs) {
+		gstate.sorted_runs.push_back(move(run));
+	}
+	lstate.sorted_runs.clear();
 }
 
 //===--------------------------------------------------------------------===//
 // Finalize
 //===--------------------------------------------------------------------===//
+static void ScheduleMerge(Pipeline &pipeline, ClientContext &context, OrderByGlobalOperatorState &state);
+
+//! Merges a group of sorted runs into a single run, or, in the final merge, a partition of the key range of all sorted
+//! runs; the last task replaces the sorted runs with the merged runs and schedules the next merge
+class PhysicalOrderMergeTask : public Task {
+public:
+	PhysicalOrderMergeTask(Pipeline &parent_p, OrderByGlobalOperatorState &state_p, idx_t merge_idx_p)
+	    : parent(parent_p), state(state_p), merge_idx(merge_idx_p) {
+	}
+
+	void Execute() override {
+		bool failed = false;
+		try {
+			// the final merge has a single group, partition i contains the rows with a key in
+			// (splitters[i - 1], splitters[i]]
+			auto &runs = state.merge_groups.size() == 1 ? state.merge_groups[0] : state.merge_groups[merge_idx];
+			vector<data_t> unbounded;
+			auto &lower = merge_idx == 0 || state.splitters.empty() ? unbounded : state.splitters[merge_idx - 1];
+			auto &upper = merge_idx >= state.splitters.size() ? unbounded : state.splitters[merge_idx];
+			state.merged_runs[merge_idx] = MergeSortedRunRange(state.buffer_manager, runs, lower, upper);
+		} catch (std::exception &ex) {
+			failed = true;
+			parent.executor.PushError(ex.what());
+		} catch (...) {
+			failed = true;
+			parent.executor.PushError("Unknown exception in ORDER BY merge!");
+		}
+
+		lock_guard<mutex> glock(state.lock);
+		state.merge_failed = state.merge_failed || failed;
+		D_ASSERT(state.pending_merges > 0);
+		state.pending_merges--;
+		if (state.pending_merges == 0) {
+			// all runs are merged: release the blocks of the input runs
+			state.sorted_runs = move(state.merged_runs);
+			state.merged_runs.clear();
+			state.merge_groups.clear();
+			state.splitters.clear();
+			if (!state.merge_failed) {
+				// merge the merged runs of the groups; this schedules nothing after the final merge
+				ScheduleMerge(parent, parent.executor.context, state);
+			}
+		}
+		parent.finished_tasks++;
+		// finish the whole pipeline
+		if (parent.total_tasks == parent.finished_tasks) {
+			parent.Finish();
+		}
+	}
+
+private:
+	Pipeline &parent;
+	OrderByGlobalOperatorState &state;
+	idx_t merge_idx;
+};
+
+//! Merge the sorted runs in parallel. Every merge pins a block of each of its runs, so if there are more runs than fit
+//! in the memory limit, groups of runs are merged into longer runs first. The final merge splits the key range into
+//! one partition per thread, and every partition is merged from all runs with a k-way merge.
+static void ScheduleMerge(Pipeline &pipeline, ClientContext &context, OrderByGlobalOperatorState &state) {
+	if (state.sorted_runs.size() <= 1 || state.final_merge) {
+		return;
+	}
+	auto &scheduler = TaskScheduler::GetScheduler(context);
+	idx_t thread_count = scheduler.NumberOfThreads();
+	// every thread pins a block of each run it merges and of the run it writes, the pinned blocks of all threads take
+	// at most half of the memory limit so that blocks can be loaded while others are still being evicted
+	idx_t max_merge_runs =
+	    MaxValue<idx_t>(GetMemoryLimit(context) / (2 * thread_count * Storage::BLOCK_ALLOC_SIZE), 3) - 1;
+	idx_t merge_count;
+	if (state.sorted_runs.size() <= max_merge_runs) {
+		state.final_merge = true;
+		state.splitters = SelectMergeSplitters(state.sorted_runs, thread_count);
+		state.merge_groups.push_back(move(state.sorted_runs));
+		merge_count = state.splitters.size() + 1;
+	} else {
+		// the groups are consecutive runs, so that rows with equal keys stay in the order of the runs
+		idx_t run_count = state.sorted_runs.size();
+		idx_t group_count = (run_count + max_merge_runs - 1) / max_merge_runs;
+		state.merge_groups.resize(group_count);
+		for (idx_t run_idx = 0; run_idx < run_count; run_idx++) {
+			state.merge_groups[run_idx * group_count / run_count].push_back(move(state.sorted_runs[run_idx]));
+		}
+		merge_count = group_count;
+	}
+	state.sorted_runs.clear();
+	state.merged_runs.resize(merge_count);
+	state.pending_merges = merge_count;
+	pipeline.total_tasks += merge_count;
+	for (idx_t merge_idx = 0; merge_idx < merge_count; merge_idx++) {
+		auto new_task = make_unique<PhysicalOrderMergeTask>(pipeline, state, merge_idx);
+		scheduler.ScheduleTask(pipeline.token, move(new_task));
+	}
+}
+
 void PhysicalOrder::Finalize(Pipeline &pipeline, ClientContext &context, unique_ptr<GlobalOperatorState> state) {
-	// finalize: perform the actual sorting
 	auto &sink = (OrderByGlobalOperatorState &)*state;
+	if (sink.external) {
+		PhysicalSink::Finalize(pipeline, context, move(state));
+		// merge the sorted runs of all threads
+		lock_guard<mutex> glock(sink.lock);
+		ScheduleMerge(pipeline, context, sink);
+		return;
+	}
+
+	// finalize: perform the actual sorting
 	ChunkCollection &big_data = sink.sorted_data;
 
 	// compute the sorting columns from the input data
@@ -87,6 +328,25 @@ void PhysicalOrder::Finalize(Pipeline &pipeline, ClientContext &context, unique_
 void PhysicalOrder::GetChunkInternal(ExecutionContext &context, DataChunk &chunk, PhysicalOperatorState *state_p) {
 	auto state = reinterpret_cast<PhysicalOrderOperatorState *>(state_p);
 	auto &sink = (OrderByGlobalOperatorState &)*this->sink_state;
+	if (sink.external) {
+		// read the merged partitions in order
+		idx_t count = 0;
+		while (count < STANDARD_VECTOR_SIZE) {
+			if (!state->reader || state->reader->Done()) {
+				if (state->position >= sink.sorted_runs.size()) {
+					break;
+				}
+				state->reader =
+				    make_unique<SortedRunReader>(sink.buffer_manager, *sink.sorted_runs[state->position++], false);
+				continue;
+			}
+			sink.format->DecodeRow(state->reader->Current(), chunk, count++);
+			state->reader->Advance();
+		}
+		chunk.SetCardinality(count);
+		return;
+	}
+
 	ChunkCollection &big_data = sink.sorted_data;
 	if (state->position >= big_data.Count()) {
 		return;
@@ -0,0 +1,559 @@
+#include "duckdb/execution/operator/order/sorted_run.hpp"
+
+#include "duckdb/common/exception.hpp"
+#include "duckdb/common/types/hugeint.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace duckdb {
+
+static constexpr idx_t ROW_HEADER_SIZE = 2 * sizeof(uint32_t);
+
+SortRowFormat::SortRowFormat(vector<OrderType> order_types_p, vector<OrderByNullType> null_orders_p,
+                             vector<LogicalType> payload_types_p)
+    : order_types(move(order_types_p)), null_orders(move(null_orders_p)), payload_types(move(payload_types_p)) {
+	D_ASSERT(order_types.size() == null_orders.size());
+}
+
+bool SortRowFormat::SupportsKeyType(const LogicalType &type) {
+	switch (type.InternalType()) {
+	case PhysicalType::BOOL:
+	case PhysicalType::INT8:
+	case PhysicalType::INT16:
+	case PhysicalType::INT32:
+	case PhysicalType::INT64:
+	case PhysicalType::UINT8:
+	case PhysicalType::UINT16:
+	case PhysicalType::UINT32:
+	case PhysicalType::UINT64:
+	case PhysicalType::INT128:
+	case PhysicalType::FLOAT:
+	case PhysicalType::DOUBLE:
+	case PhysicalType::VARCHAR:
+		return true;
+	default:
+		return false;
+	}
+}
+
+bool SortRowFormat::SupportsPayloadType(const LogicalType &type) {
+	switch (type.InternalType()) {
+	case PhysicalType::BOOL:
+	case PhysicalType::INT8:
+	case PhysicalType::INT16:
+	case PhysicalType::INT32:
+	case PhysicalType::INT64:
+	case PhysicalType::UINT8:
+	case PhysicalType::UINT16:
+	case PhysicalType::UINT32:
+	case PhysicalType::UINT64:
+	case PhysicalType::INT128:
+	case PhysicalType::FLOAT:
+	case PhysicalType::DOUBLE:
+	case PhysicalType::INTERVAL:
+	case PhysicalType::VARCHAR:
+		return true;
+	default:
+		return false;
+	}
+}
+
+//===--------------------------------------------------------------------===//
+// Key Encoding
+//===--------------------------------------------------------------------===//
+//! Write an unsigned value in big-endian order, so that memcmp on the result orders the values
+template <class T>
+static inline void EncodeBigEndian(T value, vector<data_t> &target) {
+	for (idx_t i = sizeof(T); i > 0; i--) {
+		target.push_back(data_t(value >> ((i - 1) * 8)));
+	}
+}
+
+template <class T>
+struct KeyEncoder {
+	// unsigned integers
+	static inline void Encode(T value, vector<data_t> &target) {
+		EncodeBigEndian<T>(value, target);
+	}
+};
+
+template <class T, class UNSIGNED>
+static inline void EncodeSigned(T value, vector<data_t> &target) {
+	// flip the sign bit so negative values sort before positive values
+	EncodeBigEndian<UNSIGNED>(UNSIGNED(value) ^ (UNSIGNED(1) << (sizeof(T) * 8 - 1)), target);
+}
+
+template <>
+struct KeyEncoder<bool> {
+	static inline void Encode(bool value, vector<data_t> &target) {
+		target.push_back(value ? 1 : 0);
+	}
+};
+
+template <>
+struct KeyEncoder<int8_t> {
+	static inline void Encode(int8_t value, vector<data_t> &target) {
+		EncodeSigned<int8_t, uint8_t>(value, target);
+	}
+};
+
+template <>
+struct KeyEncoder<int16_t> {
+	static inline void Encode(int16_t value, vector<data_t> &target) {
+		EncodeSigned<int16_t, uint16_t>(value, target);
+	}
+};
+
+template <>
+struct KeyEncoder<int32_t> {
+	static inline void Encode(int32_t value, vector<data_t> &target) {
+		EncodeSigned<int32_t, uint32_t>(value, target);
+	}
+};
+
+template <>
+struct KeyEncoder<int64_t> {
+	static inline void Encode(int64_t value, vector<data_t> &target) {
+		EncodeSigned<int64_t, uint64_t>(value, target);
+	}
+};
+
+template <>
+struct KeyEncoder<hugeint_t> {
+	static inline void Encode(hugeint_t value, vector<data_t> &target) {
+		EncodeSigned<int64_t, uint64_t>(value.upper, target);
+		EncodeBigEndian<uint64_t>(value.lower, target);
+	}
+};
+
+template <class T, class BITS>
+static inline void EncodeFloatingPoint(T value, vector<data_t> &target) {
+	BITS bits;
+	if (value == 0) {
+		// -0 and 0 compare equal
+		value = 0;
+	}
+	memcpy(&bits, &value, sizeof(T));
+	if (std::isnan(value)) {
+		// all NaN values are equal and sort after all other values
+		bits = ~(BITS(1) << (sizeof(T) * 8 - 1));
+	}
+	const BITS sign_bit = BITS(1) << (sizeof(T) * 8 - 1);
+	if (bits & sign_bit) {
+		// negative value: flip all the bits
+		bits = ~bits;
+	} else {
+		// positive value: flip only the sign bit
+		bits |= sign_bit;
+	}
+	EncodeBigEndian<BITS>(bits, target);
+}
+
+template <>
+struct KeyEncoder<float> {
+	static inline void Encode(float value, vector<data_t> &target) {
+		EncodeFloatingPoint<float, uint32_t>(value, target);
+	}
+};
+
+template <>
+struct KeyEncoder<double> {
+	static inline void Encode(double value, vector<data_t> &target) {
+		EncodeFloatingPoint<double, uint64_t>(value, target);
+	}
+};
+
+template <>
+struct KeyEncoder<string_t> {
+	static inline void Encode(string_t value, vector<data_t> &target) {
+		// strings are escaped so that the encoding is prefix-free: every 0 byte is written as (0, 255), and the string
+		// is terminated with (0, 0)
+		auto data = (const_data_ptr_t)value.GetDataUnsafe();
+		auto size = value.GetSize();
+		for (idx_t i = 0; i < size; i++) {
+			target.push_back(data[i]);
+			if (data[i] == 0) {
+				target.push_back(255);
+			}
+		}
+		target.push_back(0);
+		target.push_back(0);
+	}
+};
+
+template <class T>
+static void TemplatedEncodeKey(VectorData &vdata, idx_t row_idx, vector<data_t> &target) {
+	auto idx = vdata.sel->get_index(row_idx);
+	KeyEncoder<T>::Encode(((T *)vdata.data)[idx], target);
+}
+
+static void EncodeKey(PhysicalType type, VectorData &vdata, idx_t row_idx, vector<data_t> &target) {
+	switch (type) {
+	case PhysicalType::BOOL:
+		TemplatedEncodeKey<bool>(vdata, row_idx, target);
+		break;
+	case PhysicalType::INT8:
+		TemplatedEncodeKey<int8_t>(vdata, row_idx, target);
+		break;
+	case PhysicalType::INT16:
+		TemplatedEncodeKey<int16_t>(vdata, row_idx, target);
+		break;
+	case PhysicalType::INT32:
+		TemplatedEncodeKey<int32_t>(vdata, row_idx, target);
+		break;
+	case PhysicalType::INT64:
+		TemplatedEncodeKey<int64_t>(vdata, row_idx, target);
+		break;
+	case PhysicalType::UINT8:
+		TemplatedEncodeKey<uint8_t>(vdata, row_idx, target);
+		break;
+	case PhysicalType::UINT16:
+		TemplatedEncodeKey<uint16_t>(vdata, row_idx, target);
+		break;
+	case PhysicalType::UINT32:
+		TemplatedEncodeKey<uint32_t>(vdata, row_idx, target);
+		break;
+	case PhysicalType::UINT64:
+		TemplatedEncodeKey<uint64_t>(vdata, row_idx, target);
+		break;
+	case PhysicalType::INT128:
+		TemplatedEncodeKey<hugeint_t>(vdata, row_idx, target);
+		break;
+	case PhysicalType::FLOAT:
+		TemplatedEncodeKey<float>(vdata, row_idx, target);
+		break;
+	case PhysicalType::DOUBLE:
+		TemplatedEncodeKey<double>(vdata, row_idx, target);
+		break;
+	case PhysicalType::VARCHAR:
+		TemplatedEncodeKey<string_t>(vdata, row_idx, target);
+		break;
+	default:
+		throw InternalException("Unsupported type for sort key");
+	}
+}
+
+//===--------------------------------------------------------------------===//
+// Payload Encoding
+//===--------------------------------------------------------------------===//
+static void EncodePayload(PhysicalType type, VectorData &vdata, idx_t row_idx, vector<data_t> &target) {
+	auto idx = vdata.sel->get_index(row_idx);
+	if (!vdata.validity.RowIsValid(idx)) {
+		target.push_back(0);
+		return;
+	}
+	target.push_back(1);
+	if (type == PhysicalType::VARCHAR) {
+		auto value = ((string_t *)vdata.data)[idx];
+		uint32_t size = value.GetSize();
+		auto data = (const_data_ptr_t)value.GetDataUnsafe();
+		target.insert(target.end(), (const_data_ptr_t)&size, (const_data_ptr_t)&size + sizeof(uint32_t));
+		target.insert(target.end(), data, data + size);
+	} else {
+		auto type_size = GetTypeIdSize(type);
+		auto data = vdata.data + idx * type_size;
+		target.insert(target.end(), data, data + type_size);
+	}
+}
+
+void SortRowFormat::EncodeRows(DataChunk &keys, DataChunk &payload, BufferedSerializer &buffer,
+                               vector<idx_t> &row_offsets) {
+	D_ASSERT(keys.ColumnCount() == order_types.size());
+	D_ASSERT(payload.ColumnCount() == payload_types.size());
+	D_ASSERT(keys.size() == payload.size());
+	auto count = payload.size();
+
+	auto key_data = unique_ptr<VectorData[]>(new VectorData[keys.ColumnCount()]);
+	for (idx_t col_idx = 0; col_idx < keys.ColumnCount(); col_idx++) {
+		keys.data[col_idx].Orrify(count, key_data[col_idx]);
+	}
+	auto payload_data = unique_ptr<VectorData[]>(new VectorData[payload.ColumnCount()]);
+	for (idx_t col_idx = 0; col_idx < payload.ColumnCount(); col_idx++) {
+		payload.data[col_idx].Orrify(count, payload_data[col_idx]);
+	}
+
+	vector<data_t> row;
+	for (idx_t i = 0; i < count; i++) {
+		row.clear();
+		row.resize(ROW_HEADER_SIZE);
+		// first encode the key
+		for (idx_t col_idx = 0; col_idx < keys.ColumnCount(); col_idx++) {
+			auto &vdata = key_data[col_idx];
+			bool nulls_first = null_orders[col_idx] == OrderByNullType::NULLS_FIRST;
+			if (!vdata.validity.RowIsValid(vdata.sel->get_index(i))) {
+				row.push_back(nulls_first ? 0 : 1);
+				continue;
+			}
+			row.push_back(nulls_first ? 1 : 0);
+			// the NULL marker is not flipped for descending keys: the NULL order does not depend on the sort order
+			idx_t value_start = row.size();
+			EncodeKey(keys.data[col_idx].GetType().InternalType(), vdata, i, row);
+			if (order_types[col_idx] == OrderType::DESCENDING) {
+				// the encodings are prefix-free, so flipping all the bits reverses the order
+				for (idx_t k = value_start; k < row.size(); k++) {
+					row[k] = ~row[k];
+				}
+			}
+		}
+		uint32_t key_size = row.size() - ROW_HEADER_SIZE;
+		// now encode the payload
+		for (idx_t col_idx = 0; col_idx < payload.ColumnCount(); col_idx++) {
+			EncodePayload(payload_types[col_idx].InternalType(), payload_data[col_idx], i, row);
+		}
+		Store<uint32_t>(row.size(), row.data());
+		Store<uint32_t>(key_size, row.data() + sizeof(uint32_t));
+
+		row_offsets.push_back(buffer.blob.size);
+		buffer.WriteData(row.data(), row.size());
+	}
+}
+
+SortedRunBuffer::SortedRunBuffer(BufferManager &buffer_manager, idx_t capacity)
+    : BufferedSerializer(nullptr, capacity), buffer_manager(buffer_manager) {
+}
+
+void SortedRunBuffer::WriteData(const_data_ptr_t buffer, idx_t write_size) {
+	if (!handle || blob.size + write_size > maximum_size) {
+		auto new_size = maximum_size;
+		while (blob.size + write_size > new_size) {
+			new_size *= 2;
+		}
+		auto new_handle = buffer_manager.Allocate(new_size);
+		if (handle) {
+			memcpy(new_handle->node->buffer, data, blob.size);
+		}
+		handle = move(new_handle);
+		data = handle->node->buffer;
+		maximum_size = new_size;
+	}
+	memcpy(data + blob.size, buffer, write_size);
+	blob.size += write_size;
+}
+
+void SortedRunBuffer::Release() {
+	handle.reset();
+	data = nullptr;
+	blob.size = 0;
+}
+
+void SortRowFormat::DecodeRow(const_data_ptr_t row, DataChunk &result, idx_t result_idx) {
+	auto key_size = Load<uint32_t>(row + sizeof(uint32_t));
+	auto payload = row + ROW_HEADER_SIZE + key_size;
+	for (idx_t col_idx = 0; col_idx < result.ColumnCount(); col_idx++) {
+		auto &vector = result.data[col_idx];
+		bool is_valid = *payload++;
+		if (!is_valid) {
+			FlatVector::SetNull(vector, result_idx, true);
+			continue;
+		}
+		auto type = vector.GetType().InternalType();
+		if (type == PhysicalType::VARCHAR) {
+			auto size = Load<uint32_t>(payload);
+			payload += sizeof(uint32_t);
+			FlatVector::GetData<string_t>(vector)[result_idx] =
+			    StringVector::AddStringOrBlob(vector, string_t((const char *)payload, size));
+			payload += size;
+		} else {
+			auto type_size = GetTypeIdSize(type);
+			memcpy(FlatVector::GetData(vector) + result_idx * type_size, payload, type_size);
+			payload += type_size;
+		}
+	}
+}
+
+//===--------------------------------------------------------------------===//
+// Sorted Runs
+//===--------------------------------------------------------------------===//
+SortedRunWriter::SortedRunWriter(BufferManager &buffer_manager, SortedRun &run)
+    : buffer_manager(buffer_manager), run(run), offset(0) {
+}
+
+void SortedRunWriter::Append(const_data_ptr_t row) {
+	auto row_size = SortRowFormat::RowSize(row);
+	if (!handle || offset + row_size > handle->node->size) {
+		// the row does not fit in the current block: start a new one
+		// rows are never split over blocks, if a single row is bigger than a block we allocate a bigger block
+		handle.reset();
+		SortedRunBlock new_block;
+		new_block.block = buffer_manager.RegisterMemory(
+		    MaxValue<idx_t>(Storage::BLOCK_ALLOC_SIZE, row_size + Storage::BLOCK_HEADER_SIZE), false);
+		new_block.count = 0;
+		auto key_size = Load<uint32_t>(row + sizeof(uint32_t));
+		new_block.first_key.assign(row, row + ROW_HEADER_SIZE + key_size);
+		handle = buffer_manager.Pin(new_block.block);
+		run.blocks.push_back(move(new_block));
+		offset = 0;
+	}
+	memcpy(handle->node->buffer + offset, row, row_size);
+	offset += row_size;
+	run.blocks.back().count++;
+	run.count++;
+}
+
+void SortedRunWriter::Finalize() {
+	// unpin the final block so it can be evicted
+	handle.reset();
+}
+
+SortedRunReader::SortedRunReader(BufferManager &buffer_manager, SortedRun &run, bool destroy_after_read,
+                                 idx_t block_idx)
+    : buffer_manager(buffer_manager), run(run), destroy_after_read(destroy_after_read), block_idx(block_idx),
+      row_idx(0), offset(0) {
+	PinBlock();
+}
+
+void SortedRunReader::PinBlock() {
+	// skip any empty blocks
+	while (block_idx < run.blocks.size() && run.blocks[block_idx].count == 0) {
+		block_idx++;
+	}
+	if (block_idx < run.blocks.size()) {
+		handle = buffer_manager.Pin(run.blocks[block_idx].block);
+	}
+	row_idx = 0;
+	offset = 0;
+}
+
+void SortedRunReader::Advance() {
+	D_ASSERT(!Done());
+	offset += SortRowFormat::RowSize(Current());
+	row_idx++;
+	if (row_idx >= run.blocks[block_idx].count) {
+		// finished with this block: move to the next one
+		handle.reset();
+		if (destroy_after_read) {
+			run.blocks[block_idx].block.reset();
+		}
+		block_idx++;
+		PinBlock();
+	}
+}
+
+unique_ptr<SortedRun> CreateSortedRun(BufferManager &buffer_manager, BufferedSerializer &buffer,
+                                      vector<idx_t> &row_offsets) {
+	auto data = buffer.data;
+	// the sort is stable, so rows with equal keys keep the order in which they were added to the run
+	std::stable_sort(row_offsets.begin(), row_offsets.end(), [&](const idx_t &left, const idx_t &right) {
+		return SortRowFormat::CompareRows(data + left, data + right) < 0;
+	});
+	auto result = make_unique<SortedRun>();
+	SortedRunWriter writer(buffer_manager, *result);
+	for (auto &row_offset : row_offsets) {
+		writer.Append(data + row_offset);
+	}
+	writer.Finalize();
+	return result;
+}
+
+//! Merge the rows of the readers into the writer with a k-way merge. Every reader stops at its first row with a key
+//! bigger than upper (if upper is not empty).
+static void MergeReaders(vector<unique_ptr<SortedRunReader>> &readers, const vector<data_t> &upper,
+                         SortedRunWriter &writer) {
+	auto has_rows = [&](idx_t reader_idx) {
+		auto &reader = *readers[reader_idx];
+		return !reader.Done() && (upper.empty() || SortRowFormat::CompareRows(reader.Current(), upper.data()) <= 0);
+	};
+	// a binary heap of the readers that have rows left, with the reader of the smallest row on top
+	// equal rows are taken from the earlier run first, so rows with equal keys keep the order of the runs
+	auto heap_order = [&](const idx_t &left, const idx_t &right) {
+		auto cmp = SortRowFormat::CompareRows(readers[left]->Current(), readers[right]->Current());
+		return cmp > 0 || (cmp == 0 && left > right);
+	};
+	vector<idx_t> heap;
+	for (idx_t reader_idx = 0; reader_idx < readers.size(); reader_idx++) {
+		if (has_rows(reader_idx)) {
+			heap.push_back(reader_idx);
+		}
+	}
+	std::make_heap(heap.begin(), heap.end(), heap_order);
+	while (!heap.empty()) {
+		std::pop_heap(heap.begin(), heap.end(), heap_order);
+		auto reader_idx = heap.back();
+		auto &reader = *readers[reader_idx];
+		writer.Append(reader.Current());
+		reader.Advance();
+		if (has_rows(reader_idx)) {
+			std::push_heap(heap.begin(), heap.end(), heap_order);
+		} else {
+			heap.pop_back();
+		}
+	}
+}
+
+unique_ptr<SortedRun> MergeSortedRuns(BufferManager &buffer_manager, vector<unique_ptr<SortedRun>> &runs) {
+	auto result = make_unique<SortedRun>();
+	SortedRunWriter writer(buffer_manager, *result);
+	vector<unique_ptr<SortedRunReader>> readers;
+	for (auto &run : runs) {
+		readers.push_back(make_unique<SortedRunReader>(buffer_manager, *run, true));
+	}
+	MergeReaders(readers, vector<data_t>(), writer);
+	writer.Finalize();
+	for (auto &run : runs) {
+		run->blocks.clear();
+	}
+	return result;
+}
+
+vector<vector<data_t>> SelectMergeSplitters(vector<unique_ptr<SortedRun>> &runs, idx_t partition_count) {
+	// order the first rows of all blocks, every block contributes its row count to the rows before the next block
+	vector<const SortedRunBlock *> blocks;
+	idx_t total_count = 0;
+	for (auto &run : runs) {
+		for (auto &block : run->blocks) {
+			blocks.push_back(&block);
+		}
+		total_count += run->count;
+	}
+	std::sort(blocks.begin(), blocks.end(), [&](const SortedRunBlock *left, const SortedRunBlock *right) {
+		return SortRowFormat::CompareRows(left->first_key.data(), right->first_key.data()) < 0;
+	});
+	vector<vector<data_t>> result;
+	idx_t rows_before = 0;
+	for (auto &block : blocks) {
+		if (result.size() + 1 >= partition_count) {
+			break;
+		}
+		// the rows before this block in the merged order are roughly the rows of the blocks before it
+		if (rows_before >= total_count * (result.size() + 1) / partition_count) {
+			if (result.empty() || SortRowFormat::CompareRows(result.back().data(), block->first_key.data()) != 0) {
+				result.push_back(block->first_key);
+			}
+		}
+		rows_before += block->count;
+	}
+	return result;
+}
+
+unique_ptr<SortedRun> MergeSortedRunRange(BufferManager &buffer_manager, vector<unique_ptr<SortedRun>> &runs,
+                                          const vector<data_t> &lower, const vector<data_t> &upper) {
+	auto result = make_unique<SortedRun>();
+	SortedRunWriter writer(buffer_manager, *result);
+	auto block_order = [&](const vector<data_t> &key, const SortedRunBlock &block) {
+		return SortRowFormat::CompareRows(key.data(), block.first_key.data()) < 0;
+	};
+	vector<unique_ptr<SortedRunReader>> readers;
+	for (auto &run : runs) {
+		idx_t block_idx = 0;
+		if (!lower.empty()) {
+			// the first row bigger than lower is in the block before the first block that starts after lower
+			auto entry = std::upper_bound(run->blocks.begin(), run->blocks.end(), lower, block_order);
+			block_idx = entry - run->blocks.begin();
+			block_idx = block_idx > 0 ? block_idx - 1 : 0;
+		}
+		auto reader = make_unique<SortedRunReader>(buffer_manager, *run, false, block_idx);
+		if (!lower.empty()) {
+			while (!reader->Done() && SortRowFormat::CompareRows(reader->Current(), lower.data()) <= 0) {
+				reader->Advance();
+			}
+		}
+		readers.push_back(move(reader));
+	}
+	MergeReaders(readers, upper, writer);
+	writer.Finalize();
+	return result;
+}
+
+} // namespace duckdb
@@ -1054,6 +1054,7 @@ void BufferedCSVReader::ParseSimpleCSV(DataChunk &insert_chunk) {
 	// read values into the buffer (if any)
 	if (position >= buffer_size) {
 		if (!ReadBuffer(start)) {
+			FinishRange();
 			return;
 		}
 	}
@@ -1061,6 +1062,10 @@ void BufferedCSVReader::ParseSimpleCSV(DataChunk &insert_chunk) {
 	goto value_start;
 value_start:
 	offset = 0;
+	if (column == 0 && buffer_offset + position >= range_end) {
+		// the next row starts after the byte range of this reader: it is read by the reader of the next range
+		goto range_end_state;
+	}
 	/* state: value_start */
 	// this state parses the first character of a value
 	if (buffer[position] == options.quote[0]) {
@@ -1219,6 +1224,14 @@ final_state:
 	}
 
 	end_of_file_reached = true;
+	FinishRange();
+	return;
+range_end_state:
+	// the byte range of this reader is finished: flush the parsed chunk
+	if (mode == ParserMode::PARSING) {
+		Flush(insert_chunk);
+	}
+	FinishRange();
 }
 
 bool BufferedCSVReader::ReadBuffer(idx_t &start) {
@@ -1233,6 +1246,12 @@ bool BufferedCSVReader::ReadBuffer(idx_t &start) {
 	if (remaining + buffer_read_size > MAXIMUM_CSV_LINE_SIZE) {
 		throw InvalidInputException("Maximum line size of %llu bytes exceeded!", MAXIMUM_CSV_LINE_SIZE);
 	}
+	if (!old_buffer && plain_file_source) {
+		// first buffer of the stream: determine the offset in the file
+		auto stream_offset = source->tellg();
+		buffer_offset = stream_offset < 0 ? 0 : (idx_t)stream_offset;
+		start = 0;
+	}
 	buffer = unique_ptr<char[]>(new char[buffer_read_size + remaining + 1]);
 	buffer_size = remaining + buffer_read_size;
 	if (remaining > 0) {
@@ -1248,6 +1267,7 @@ bool BufferedCSVReader::ReadBuffer(idx_t &start) {
 	if (old_buffer) {
 		cached_buffers.push_back(move(old_buffer));
 	}
+	buffer_offset += start;
 	start = 0;
 	position = remaining;
 
@@ -1255,6 +1275,10 @@ bool BufferedCSVReader::ReadBuffer(idx_t &start) {
 }
 
 void BufferedCSVReader::ParseCSV(DataChunk &insert_chunk) {
+	if (range_row_end != INVALID_INDEX) {
+		// finished reading the byte range of this reader
+		return;
+	}
 	// if no auto-detect or auto-detect with jumping samples, we have nothing cached and start from the beginning
 	if (cached_chunks.empty()) {
 		cached_buffers.clear();
@@ -1269,6 +1293,69 @@ void BufferedCSVReader::ParseCSV(DataChunk &insert_chunk) {
 	ParseCSV(ParserMode::PARSING, insert_chunk);
 }
 
+bool BufferedCSVReader::SupportsRanges() {
+	// only the simple parser can stop at the end of a range
+	return plain_file_source && options.delimiter.size() == 1 && options.quote.size() <= 1 &&
+	       options.escape.size() <= 1;
+}
+
+void BufferedCSVReader::SetRange(idx_t range_start, idx_t range_end_p, bool starts_row) {
+	D_ASSERT(SupportsRanges() && cached_chunks.empty());
+	range_end = range_end_p;
+	range_row_end = INVALID_INDEX;
+	if (range_start == 0) {
+		// the first range starts after the skipped rows and the header, which have already been read
+		range_row_start = buffer_offset + position;
+		return;
+	}
+	ResetBuffer();
+	source->clear();
+	linenr = 0;
+	linenr_estimated = true;
+	if (starts_row) {
+		source->seekg(range_start, source->beg);
+		range_row_start = range_start;
+		return;
+	}
+	source->seekg(range_start - 1, source->beg);
+	// the row preceding the range ends at the first newline at or after range_start - 1
+	while (true) {
+		for (; position < buffer_size; position++) {
+			if (StringUtil::CharacterIsNewline(buffer[position])) {
+				break;
+			}
+		}
+		if (position < buffer_size) {
+			break;
+		}
+		start = position;
+		if (!ReadBuffer(start)) {
+			// no row starts within the range
+			range_row_start = buffer_offset + position;
+			FinishRange();
+			return;
+		}
+	}
+	bool carriage_return = buffer[position] == '\r';
+	start = ++position;
+	if (carriage_return) {
+		// \r\n is interpreted as a single newline
+		if (position >= buffer_size) {
+			ReadBuffer(start);
+		}
+		if (position < buffer_size && buffer[position] == '\n') {
+			start = ++position;
+		}
+	}
+	range_row_start = buffer_offset + position;
+}
+
+void BufferedCSVReader::FinishRange() {
+	if (range_end != INVALID_INDEX) {
+		range_row_end = buffer_offset + position;
+	}
+}
+
 void BufferedCSVReader::ParseCSV(ParserMode parser_mode, DataChunk &insert_chunk) {
 	mode = parser_mode;
 
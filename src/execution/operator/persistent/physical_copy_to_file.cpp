@@ -1,32 +1,72 @@
 #include "duckdb/execution/operator/persistent/physical_copy_to_file.hpp"
+#include "duckdb/common/file_system.hpp"
 #include "duckdb/common/vector_operations/vector_operations.hpp"
 
 #include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
 
 namespace duckdb {
 
+constexpr const char *PhysicalCopyToFile::HIVE_DEFAULT_PARTITION;
+
+//! The file that is written for a partition
+struct CopyToPartitionWriter {
+	unique_ptr<GlobalFunctionData> global_state;
+	//! The amount of thread-local states that write to this file, the file can only be closed when there are none
+	idx_t local_states = 0;
+};
+
 class CopyToFunctionGlobalState : public GlobalOperatorState {
 public:
 	explicit CopyToFunctionGlobalState(unique_ptr<GlobalFunctionData> global_state)
 	    : rows_copied(0), global_state(move(global_state)) {
 	}
 
-	idx_t rows_copied;
+	//! The sink is called by many threads concurrently
+	std::atomic<idx_t> rows_copied;
 	unique_ptr<GlobalFunctionData> global_state;
+
+	//! Partitioned writes: the lock protecting the partition files
+	mutex lock;
+	//! Signalled when a thread detaches from a partition file, which might allow the file to be closed
+	std::condition_variable writer_released;
+	//! The open partition files, by the directory of their partition (e.g. "year=2021/month=3"). At most
+	//! max_open_files files are open at the same time.
+	unordered_map<string, unique_ptr<CopyToPartitionWriter>> writers;
+	//! The amount of files that were removed from the open files and are being finalized, which still count towards
+	//! max_open_files
+	idx_t closing_files = 0;
+	//! The amount of files that have been written for every partition
+	unordered_map<string, idx_t> file_counts;
+};
+
+//! The rows of a partition that a thread has buffered for its file
+struct CopyToPartitionLocalState {
+	CopyToPartitionWriter *writer;
+	unique_ptr<LocalFunctionData> local_state;
+	//! The chunk in which the partition was last written to, to release the least recently used partition
+	idx_t last_used;
 };
 
 class CopyToFunctionLocalState : public LocalSinkState {
 public:
-	explicit CopyToFunctionLocalState(unique_ptr<LocalFunctionData> local_state) : local_state(move(local_state)) {
+	explicit CopyToFunctionLocalState(unique_ptr<LocalFunctionData> local_state)
+	    : local_state(move(local_state)), chunk_count(0) {
 	}
 	unique_ptr<LocalFunctionData> local_state;
+
+	//! Partitioned writes: the partitions this thread writes to
+	unordered_map<string, CopyToPartitionLocalState> partitions;
+	idx_t chunk_count;
 };
 
 void PhysicalCopyToFile::GetChunkInternal(ExecutionContext &context, DataChunk &chunk, PhysicalOperatorState *state) {
 	auto &g = (CopyToFunctionGlobalState &)*sink_state;
 
 	chunk.SetCardinality(1);
-	chunk.SetValue(0, 0, Value::BIGINT(g.rows_copied));
+	chunk.SetValue(0, 0, Value::BIGINT(g.rows_copied.load()));
 
 	state->finished = true;
 }
@@ -37,30 +77,286 @@ void PhysicalCopyToFile::Sink(ExecutionContext &context, GlobalOperatorState &gs
 	auto &l = (CopyToFunctionLocalState &)lstate;
 
 	g.rows_copied += input.size();
+	if (!partition_columns.empty()) {
+		SinkPartitions(context, g, l, input);
+		return;
+	}
 	function.copy_to_sink(context.client, *bind_data, *g.global_state, *l.local_state, input);
 }
 
+void PhysicalCopyToFile::SinkPartitions(ExecutionContext &context, CopyToFunctionGlobalState &g,
+                                        CopyToFunctionLocalState &l, DataChunk &input) {
+	l.chunk_count++;
+	// hash the partition columns and order the rows by their hash, the rows of a partition then form a run
+	Vector hashes(LogicalType::HASH);
+	VectorOperations::Hash(input.data[partition_columns[0]], hashes, input.size());
+	for (idx_t i = 1; i < partition_columns.size(); i++) {
+		VectorOperations::CombineHash(hashes, input.data[partition_columns[i]], input.size());
+	}
+	hashes.Normalify(input.size());
+	auto hash_data = FlatVector::GetData<hash_t>(hashes);
+	SelectionVector sorted(STANDARD_VECTOR_SIZE);
+	for (idx_t i = 0; i < input.size(); i++) {
+		sorted.set_index(i, i);
+	}
+	std::stable_sort(sorted.data(), sorted.data() + input.size(),
+	                 [&](sel_t a, sel_t b) { return hash_data[a] < hash_data[b]; });
+
+	// the columns that are written to the files
+	vector<LogicalType> write_types;
+	DataChunk write_chunk;
+	for (auto col_idx : write_columns) {
+		write_types.push_back(input.data[col_idx].GetType());
+	}
+	write_chunk.InitializeEmpty(write_types);
+	for (idx_t i = 0; i < write_columns.size(); i++) {
+		write_chunk.data[i].Reference(input.data[write_columns[i]]);
+	}
+	write_chunk.SetCardinality(input);
+
+	idx_t run_start = 0;
+	while (run_start < input.size()) {
+		auto run_hash = hash_data[sorted.get_index(run_start)];
+		idx_t run_end = run_start + 1;
+		while (run_end < input.size() && hash_data[sorted.get_index(run_end)] == run_hash) {
+			run_end++;
+		}
+		// the rows of a run have the same hash, split them by their partition values in case of hash collisions
+		SelectionVector remaining(STANDARD_VECTOR_SIZE);
+		idx_t remaining_count = run_end - run_start;
+		for (idx_t i = 0; i < remaining_count; i++) {
+			remaining.set_index(i, sorted.get_index(run_start + i));
+		}
+		while (remaining_count > 0) {
+			auto row_idx = remaining.get_index(0);
+			SelectionVector match(STANDARD_VECTOR_SIZE), no_match(STANDARD_VECTOR_SIZE);
+			idx_t match_count = remaining_count, no_match_count = 0;
+			for (idx_t i = 0; i < remaining_count; i++) {
+				match.set_index(i, remaining.get_index(i));
+			}
+			for (auto col_idx : partition_columns) {
+				auto &column = input.data[col_idx];
+				Vector sliced(column.GetType());
+				sliced.Slice(column, match, match_count);
+				Vector partition_value(column.GetValue(row_idx));
+				Vector equal(LogicalType::BOOLEAN);
+				VectorOperations::NotDistinctFrom(sliced, partition_value, equal, match_count);
+				equal.Normalify(match_count);
+				auto equal_data = FlatVector::GetData<bool>(equal);
+				SelectionVector new_match(STANDARD_VECTOR_SIZE);
+				idx_t new_match_count = 0;
+				for (idx_t i = 0; i < match_count; i++) {
+					if (equal_data[i]) {
+						new_match.set_index(new_match_count++, match.get_index(i));
+					} else {
+						no_match.set_index(no_match_count++, match.get_index(i));
+					}
+				}
+				match.Initialize(new_match);
+				match_count = new_match_count;
+			}
+
+			auto &partition = GetPartition(context, g, l, input, row_idx);
+			DataChunk partition_chunk;
+			partition_chunk.InitializeEmpty(write_types);
+			partition_chunk.Slice(write_chunk, match, match_count);
+			function.copy_to_sink(context.client, *bind_data, *partition.writer->global_state, *partition.local_state,
+			                      partition_chunk);
+
+			remaining.Initialize(no_match);
+			remaining_count = no_match_count;
+		}
+		run_start = run_end;
+	}
+}
+
+CopyToPartitionLocalState &PhysicalCopyToFile::GetPartition(ExecutionContext &context, CopyToFunctionGlobalState &g,
+                                                            CopyToFunctionLocalState &l, DataChunk &input,
+                                                            idx_t row_idx) {
+	auto &fs = FileSystem::GetFileSystem(context.client);
+	// the partition is written to the hive-style directory "column=value/..."
+	string partition;
+	for (auto col_idx : partition_columns) {
+		auto partition_value = input.data[col_idx].GetValue(row_idx);
+		// like Hive, NULL values are written to the default partition, which is read back as NULL
+		auto value = partition_value.is_null ? HIVE_DEFAULT_PARTITION : partition_value.ToString();
+		if (value.find('/') != string::npos || value.find('\\') != string::npos) {
+			throw InvalidInputException("Cannot write partition with value \"%s\" that contains a path separator",
+			                            value);
+		}
+		partition += (partition.empty() ? "" : "/") + names[col_idx] + "=" + value;
+	}
+	auto entry = l.partitions.find(partition);
+	if (entry != l.partitions.end()) {
+		entry->second.last_used = l.chunk_count;
+		return entry->second;
+	}
+	if (l.partitions.size() >= max_open_files) {
+		ReleaseLeastRecentlyUsed(context.client, g, l);
+	}
+
+	CopyToPartitionLocalState result;
+	{
+		std::unique_lock<mutex> glock(g.lock);
+		while (g.writers.find(partition) == g.writers.end() &&
+		       g.writers.size() + g.closing_files >= max_open_files) {
+			// the limit of open files is reached: close the files that no thread is attached to, which are finalized
+			// without holding the lock
+			auto idle_writers = TakeIdleWriters(g);
+			if (!idle_writers.empty()) {
+				glock.unlock();
+				CloseWriters(context.client, g, idle_writers);
+				glock.lock();
+			} else if (!l.partitions.empty()) {
+				// detach from a partition of this thread, so its file can be closed
+				glock.unlock();
+				ReleaseLeastRecentlyUsed(context.client, g, l);
+				glock.lock();
+			} else {
+				// all files are in use by other threads: wait until one of them detaches from or closes a file
+				g.writer_released.wait(glock);
+			}
+		}
+		auto &writer = g.writers[partition];
+		if (!writer) {
+			// create the directories of the partition
+			string directory = file_path;
+			if (!fs.DirectoryExists(directory)) {
+				fs.CreateDirectory(directory);
+			}
+			for (auto &partition_directory : StringUtil::Split(partition, '/')) {
+				directory = fs.JoinPath(directory, partition_directory);
+				if (!fs.DirectoryExists(directory)) {
+					fs.CreateDirectory(directory);
+				}
+			}
+			auto file_name = "data_" + to_string(g.file_counts[partition]++) + "." + function.name;
+			writer = make_unique<CopyToPartitionWriter>();
+			writer->global_state =
+			    function.copy_to_initialize_global(context.client, *bind_data, fs.JoinPath(directory, file_name));
+		}
+		writer->local_states++;
+		result.writer = writer.get();
+	}
+	result.local_state = function.copy_to_initialize_local(context.client, *bind_data);
+	result.last_used = l.chunk_count;
+	return l.partitions[partition] = move(result);
+}
+
+void PhysicalCopyToFile::ReleasePartition(ClientContext &context, CopyToFunctionGlobalState &g,
+                                          CopyToPartitionLocalState &partition) {
+	// the writer cannot be closed while this thread is attached to it, so we can combine without holding the lock
+	if (function.copy_to_combine) {
+		function.copy_to_combine(context, *bind_data, *partition.writer->global_state, *partition.local_state);
+	}
+	lock_guard<mutex> glock(g.lock);
+	partition.writer->local_states--;
+	if (partition.writer->local_states == 0) {
+		g.writer_released.notify_all();
+	}
+}
+
+void PhysicalCopyToFile::ReleaseLeastRecentlyUsed(ClientContext &context, CopyToFunctionGlobalState &g,
+                                                  CopyToFunctionLocalState &l) {
+	D_ASSERT(!l.partitions.empty());
+	auto lru = l.partitions.begin();
+	for (auto it = l.partitions.begin(); it != l.partitions.end(); it++) {
+		if (it->second.last_used < lru->second.last_used) {
+			lru = it;
+		}
+	}
+	ReleasePartition(context, g, lru->second);
+	l.partitions.erase(lru);
+}
+
+vector<unique_ptr<CopyToPartitionWriter>> PhysicalCopyToFile::TakeIdleWriters(CopyToFunctionGlobalState &g) {
+	vector<unique_ptr<CopyToPartitionWriter>> result;
+	for (auto it = g.writers.begin(); it != g.writers.end();) {
+		if (!it->second || it->second->local_states > 0) {
+			it++;
+			continue;
+		}
+		result.push_back(move(it->second));
+		it = g.writers.erase(it);
+	}
+	g.closing_files += result.size();
+	return result;
+}
+
+void PhysicalCopyToFile::CloseWriters(ClientContext &context, CopyToFunctionGlobalState &g,
+                                      vector<unique_ptr<CopyToPartitionWriter>> &writers) {
+	// the files count towards the open files until they are closed, also if finalizing one of them fails
+	std::exception_ptr exception;
+	for (auto &writer : writers) {
+		try {
+			if (function.copy_to_finalize) {
+				function.copy_to_finalize(context, *bind_data, *writer->global_state);
+			}
+		} catch (...) {
+			if (!exception) {
+				exception = std::current_exception();
+			}
+		}
+		writer.reset();
+	}
+	{
+		lock_guard<mutex> glock(g.lock);
+		g.closing_files -= writers.size();
+		g.writer_released.notify_all();
+	}
+	writers.clear();
+	if (exception) {
+		std::rethrow_exception(exception);
+	}
+}
+
 void PhysicalCopyToFile::Combine(ExecutionContext &context, GlobalOperatorState &gstate, LocalSinkState &lstate) {
 	auto &g = (CopyToFunctionGlobalState &)gstate;
 	auto &l = (CopyToFunctionLocalState &)lstate;
 
-	if (function.copy_to_combine) {
+	for (auto &partition : l.partitions) {
+		ReleasePartition(context.client, g, partition.second);
+	}
+	l.partitions.clear();
+	if (function.copy_to_combine && l.local_state) {
 		function.copy_to_combine(context.client, *bind_data, *g.global_state, *l.local_state);
 	}
 }
 void PhysicalCopyToFile::Finalize(Pipeline &pipeline, ClientContext &context, unique_ptr<GlobalOperatorState> gstate) {
 	auto g = (CopyToFunctionGlobalState *)gstate.get();
-	if (function.copy_to_finalize) {
+	if (!partition_columns.empty()) {
+		auto idle_writers = TakeIdleWriters(*g);
+		D_ASSERT(g->writers.empty());
+		CloseWriters(context, *g, idle_writers);
+	} else if (function.copy_to_finalize) {
 		function.copy_to_finalize(context, *bind_data, *g->global_state);
 	}
 	PhysicalSink::Finalize(pipeline, context, move(gstate));
 }
 
 unique_ptr<LocalSinkState> PhysicalCopyToFile::GetLocalSinkState(ExecutionContext &context) {
+	if (!partition_columns.empty()) {
+		// the partitions create their own local states
+		return make_unique<CopyToFunctionLocalState>(nullptr);
+	}
 	return make_unique<CopyToFunctionLocalState>(function.copy_to_initialize_local(context.client, *bind_data));
 }
 unique_ptr<GlobalOperatorState> PhysicalCopyToFile::GetGlobalState(ClientContext &context) {
-	return make_unique<CopyToFunctionGlobalState>(function.copy_to_initialize_global(context, *bind_data));
+	if (!partition_columns.empty()) {
+		// the partition files are created when their first rows arrive. Files of an earlier COPY in the same directory
+		// would be mixed up with the new files, so the directory has to be empty
+		auto &fs = FileSystem::GetFileSystem(context);
+		if (fs.DirectoryExists(file_path)) {
+			bool empty = true;
+			fs.ListFiles(file_path, [&](const string &, bool) { empty = false; });
+			if (!empty) {
+				throw IOException("Cannot write partitioned files to directory \"%s\": the directory is not empty",
+				                  file_path);
+			}
+		}
+		return make_unique<CopyToFunctionGlobalState>(nullptr);
+	}
+	return make_unique<CopyToFunctionGlobalState>(function.copy_to_initialize_global(context, *bind_data, file_path));
 }
 
 } // namespace duckdb
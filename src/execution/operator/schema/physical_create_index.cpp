@@ -31,7 +31,7 @@ void PhysicalCreateIndex::GetChunkInternal(ExecutionContext &context, DataChunk
 	}
 	index_entry->index = index.get();
 	index_entry->info = table.storage->info;
-	table.storage->AddIndex(move(index), expressions);
+	table.storage->AddIndex(context.client, move(index), expressions);
 
 	chunk.SetCardinality(0);
 	state->finished = true;
@@ -2,12 +2,26 @@
 #include "duckdb/execution/operator/persistent/physical_copy_to_file.hpp"
 #include "duckdb/planner/operator/logical_copy_to_file.hpp"
 
+#include <algorithm>
+
 namespace duckdb {
 
 unique_ptr<PhysicalOperator> PhysicalPlanGenerator::CreatePlan(LogicalCopyToFile &op) {
 	auto plan = CreatePlan(*op.children[0]);
 	// COPY from select statement to file
-	auto copy = make_unique<PhysicalCopyToFile>(op.types, op.function, move(op.bind_data), op.estimated_cardinality);
+	auto copy = make_unique<PhysicalCopyToFile>(op.types, op.function, move(op.bind_data), op.file_path,
+	                                            op.estimated_cardinality);
+	if (!op.partition_columns.empty()) {
+		copy->names = op.names;
+		copy->partition_columns = op.partition_columns;
+		for (idx_t col_idx = 0; col_idx < plan->types.size(); col_idx++) {
+			if (std::find(op.partition_columns.begin(), op.partition_columns.end(), col_idx) ==
+			    op.partition_columns.end()) {
+				copy->write_columns.push_back(col_idx);
+			}
+		}
+		copy->max_open_files = op.max_open_files;
+	}
 
 	copy->children.push_back(move(plan));
 	return move(copy);
@@ -8,6 +8,7 @@
 #include "duckdb/storage/buffer_manager.hpp"
 #include "duckdb/storage/storage_manager.hpp"
 #include "duckdb/common/enums/output_type.hpp"
+#include "duckdb/common/enums/compression_type.hpp"
 #include <cctype>
 
 namespace duckdb {
@@ -93,6 +94,37 @@ static void PragmaDefaultOrder(ClientContext &context, const FunctionParameters
 	}
 }
 
+static void PragmaNUMAAffinity(ClientContext &context, const FunctionParameters &parameters) {
+	// PRAGMA assignments are parsed as strings
+	auto enable = parameters.values[0].CastAs(LogicalType::BOOLEAN).GetValue<bool>();
+	TaskScheduler::GetScheduler(context).SetNUMAAffinity(enable);
+}
+
+static void PragmaQueryPriority(ClientContext &context, const FunctionParameters &parameters) {
+	auto priority = StringUtil::Lower(parameters.values[0].ToString());
+	if (priority == "low") {
+		context.query_priority = TaskGroup::LOW_PRIORITY_WEIGHT;
+	} else if (priority == "normal") {
+		context.query_priority = TaskGroup::NORMAL_PRIORITY_WEIGHT;
+	} else if (priority == "high") {
+		context.query_priority = TaskGroup::HIGH_PRIORITY_WEIGHT;
+	} else {
+		throw ParserException("Unrecognized query priority '%s', expected either LOW, NORMAL or HIGH", priority);
+	}
+}
+
+static void PragmaQueryThreads(ClientContext &context, const FunctionParameters &parameters) {
+	auto query_threads = parameters.values[0].GetValue<int64_t>();
+	if (query_threads < 0) {
+		throw ParserException("Query threads out of range: should be 0 (no limit) or more");
+	}
+	context.query_threads = query_threads;
+}
+
+static void PragmaQueryMemoryLimit(ClientContext &context, const FunctionParameters &parameters) {
+	context.query_memory_limit = ParseMemoryLimit(parameters.values[0].ToString());
+}
+
 static void PragmaSetThreads(ClientContext &context, const FunctionParameters &parameters) {
 	auto nr_threads = parameters.values[0].GetValue<int64_t>();
 	TaskScheduler::GetScheduler(context).SetThreads(nr_threads);
@@ -126,6 +158,14 @@ static void PragmaEnableForceIndexJoin(ClientContext &context, const FunctionPar
 	context.force_index_join = true;
 }
 
+static void PragmaEnableParallelIndexCreation(ClientContext &context, const FunctionParameters &parameters) {
+	context.parallel_index_creation = true;
+}
+
+static void PragmaDisableParallelIndexCreation(ClientContext &context, const FunctionParameters &parameters) {
+	context.parallel_index_creation = false;
+}
+
 static void PragmaForceCheckpoint(ClientContext &context, const FunctionParameters &parameters) {
 	DBConfig::GetConfig(context).force_checkpoint = true;
 }
@@ -211,6 +251,19 @@ static void PragmaDebugCheckpointAbort(ClientContext &context, const FunctionPar
 	}
 }
 
+static void PragmaForceCompression(ClientContext &context, const FunctionParameters &parameters) {
+	auto compression = StringUtil::Lower(parameters.values[0].ToString());
+	DBConfig::GetConfig(context).force_compression = CompressionTypeFromString(compression);
+}
+
+static void PragmaPrefetchBlocks(ClientContext &context, const FunctionParameters &parameters) {
+	auto prefetch_blocks = parameters.values[0].GetValue<int64_t>();
+	if (prefetch_blocks < 0) {
+		throw ParserException("Prefetch blocks out of range: should be 0 or more");
+	}
+	DBConfig::GetConfig(context).prefetch_blocks = prefetch_blocks;
+}
+
 void PragmaFunctions::RegisterFunction(BuiltinFunctions &set) {
 	RegisterEnableProfiling(set);
 
@@ -233,6 +286,12 @@ void PragmaFunctions::RegisterFunction(BuiltinFunctions &set) {
 
 	set.AddFunction(PragmaFunction::PragmaAssignment("threads", PragmaSetThreads, LogicalType::BIGINT));
 	set.AddFunction(PragmaFunction::PragmaAssignment("worker_threads", PragmaSetThreads, LogicalType::BIGINT));
+	set.AddFunction(PragmaFunction::PragmaAssignment("numa_affinity", PragmaNUMAAffinity, LogicalType::VARCHAR));
+
+	set.AddFunction(PragmaFunction::PragmaAssignment("query_priority", PragmaQueryPriority, LogicalType::VARCHAR));
+	set.AddFunction(PragmaFunction::PragmaAssignment("query_threads", PragmaQueryThreads, LogicalType::BIGINT));
+	set.AddFunction(
+	    PragmaFunction::PragmaAssignment("query_memory_limit", PragmaQueryMemoryLimit, LogicalType::VARCHAR));
 
 	set.AddFunction(PragmaFunction::PragmaStatement("enable_verification", PragmaEnableVerification));
 	set.AddFunction(PragmaFunction::PragmaStatement("disable_verification", PragmaDisableVerification));
@@ -252,6 +311,11 @@ void PragmaFunctions::RegisterFunction(BuiltinFunctions &set) {
 	set.AddFunction(PragmaFunction::PragmaStatement("force_index_join", PragmaEnableForceIndexJoin));
 	set.AddFunction(PragmaFunction::PragmaStatement("force_checkpoint", PragmaForceCheckpoint));
 
+	set.AddFunction(
+	    PragmaFunction::PragmaStatement("enable_parallel_index_creation", PragmaEnableParallelIndexCreation));
+	set.AddFunction(
+	    PragmaFunction::PragmaStatement("disable_parallel_index_creation", PragmaDisableParallelIndexCreation));
+
 	set.AddFunction(PragmaFunction::PragmaStatement("enable_progress_bar", PragmaEnableProgressBar));
 	set.AddFunction(
 	    PragmaFunction::PragmaAssignment("set_progress_bar_time", PragmaSetProgressBarWaitTime, LogicalType::INTEGER));
@@ -271,6 +335,11 @@ void PragmaFunctions::RegisterFunction(BuiltinFunctions &set) {
 
 	set.AddFunction(
 	    PragmaFunction::PragmaAssignment("debug_checkpoint_abort", PragmaDebugCheckpointAbort, LogicalType::VARCHAR));
+
+	set.AddFunction(
+	    PragmaFunction::PragmaAssignment("force_compression", PragmaForceCompression, LogicalType::VARCHAR));
+
+	set.AddFunction(PragmaFunction::PragmaAssignment("prefetch_blocks", PragmaPrefetchBlocks, LogicalType::BIGINT));
 }
 
 idx_t ParseMemoryLimit(string arg) {
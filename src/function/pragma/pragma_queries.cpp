@@ -8,6 +8,10 @@ string PragmaTableInfo(ClientContext &context, const FunctionParameters &paramet
 	return StringUtil::Format("SELECT * FROM pragma_table_info('%s')", parameters.values[0].ToString());
 }
 
+string PragmaStorageInfo(ClientContext &context, const FunctionParameters &parameters) {
+	return StringUtil::Format("SELECT * FROM pragma_storage_info('%s')", parameters.values[0].ToString());
+}
+
 string PragmaShowTables(ClientContext &context, const FunctionParameters &parameters) {
 	return "SELECT name FROM sqlite_master() ORDER BY name";
 }
@@ -57,14 +61,25 @@ string PragmaDatabaseSize(ClientContext &context, const FunctionParameters &para
 	return "SELECT * FROM pragma_database_size()";
 }
 
+string PragmaBufferStatistics(ClientContext &context, const FunctionParameters &parameters) {
+	return "SELECT * FROM pragma_buffer_statistics()";
+}
+
+string PragmaSchedulerStatistics(ClientContext &context, const FunctionParameters &parameters) {
+	return "SELECT * FROM pragma_scheduler_statistics()";
+}
+
 void PragmaQueries::RegisterFunction(BuiltinFunctions &set) {
 	set.AddFunction(PragmaFunction::PragmaCall("table_info", PragmaTableInfo, {LogicalType::VARCHAR}));
+	set.AddFunction(PragmaFunction::PragmaCall("storage_info", PragmaStorageInfo, {LogicalType::VARCHAR}));
 	set.AddFunction(PragmaFunction::PragmaStatement("show_tables", PragmaShowTables));
 	set.AddFunction(PragmaFunction::PragmaStatement("database_list", PragmaDatabaseList));
 	set.AddFunction(PragmaFunction::PragmaStatement("collations", PragmaCollations));
 	set.AddFunction(PragmaFunction::PragmaCall("show", PragmaShow, {LogicalType::VARCHAR}));
 	set.AddFunction(PragmaFunction::PragmaStatement("version", PragmaVersion));
 	set.AddFunction(PragmaFunction::PragmaStatement("database_size", PragmaDatabaseSize));
+	set.AddFunction(PragmaFunction::PragmaStatement("buffer_statistics", PragmaBufferStatistics));
+	set.AddFunction(PragmaFunction::PragmaStatement("scheduler_statistics", PragmaSchedulerStatistics));
 	set.AddFunction(PragmaFunction::PragmaStatement("functions", PragmaFunctionsQuery));
 	set.AddFunction(PragmaFunction::PragmaCall("import_database", PragmaImportDatabase, {LogicalType::VARCHAR}));
 }
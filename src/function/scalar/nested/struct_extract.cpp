@@ -1,28 +1,11 @@
 #include "duckdb/function/scalar/nested_functions.hpp"
 #include "duckdb/execution/expression_executor.hpp"
+#include "duckdb/planner/expression/bound_columnref_expression.hpp"
 #include "duckdb/planner/expression/bound_function_expression.hpp"
 #include "duckdb/common/string_util.hpp"
 
 namespace duckdb {
 
-struct StructExtractBindData : public FunctionData {
-	StructExtractBindData(string key, idx_t index, LogicalType type) : key(move(key)), index(index), type(move(type)) {
-	}
-
-	string key;
-	idx_t index;
-	LogicalType type;
-
-public:
-	unique_ptr<FunctionData> Copy() override {
-		return make_unique<StructExtractBindData>(key, index, type);
-	}
-	bool Equals(FunctionData &other_p) override {
-		auto &other = (StructExtractBindData &)other_p;
-		return key == other.key && index == other.index && type == other.type;
-	}
-};
-
 static void StructExtractFunction(DataChunk &args, ExpressionState &state, Vector &result) {
 	auto &func_expr = (BoundFunctionExpression &)state.expr;
 	auto &info = (StructExtractBindData &)*func_expr.bind_info;
@@ -106,4 +89,22 @@ void StructExtractFun::RegisterFunction(BuiltinFunctions &set) {
 	set.AddFunction(fun);
 }
 
+BoundColumnRefExpression *StructExtractFun::GetFieldPath(Expression &expr, vector<idx_t> &child_path) {
+	vector<idx_t> reverse_path;
+	auto current = &expr;
+	while (current->expression_class == ExpressionClass::BOUND_FUNCTION) {
+		auto &func = (BoundFunctionExpression &)*current;
+		if (func.function.name != "struct_extract" || !func.bind_info) {
+			return nullptr;
+		}
+		reverse_path.push_back(((StructExtractBindData &)*func.bind_info).index);
+		current = func.children[0].get();
+	}
+	if (reverse_path.empty() || current->expression_class != ExpressionClass::BOUND_COLUMN_REF) {
+		return nullptr;
+	}
+	child_path.assign(reverse_path.rbegin(), reverse_path.rend());
+	return (BoundColumnRefExpression *)current;
+}
+
 } // namespace duckdb
@@ -1,10 +1,13 @@
 #include "duckdb/function/table/read_csv.hpp"
 
+#include "duckdb/common/types/chunk_collection.hpp"
 #include "duckdb/execution/operator/persistent/buffered_csv_reader.hpp"
 #include "duckdb/function/function_set.hpp"
 #include "duckdb/main/client_context.hpp"
 #include "duckdb/main/database.hpp"
+#include "duckdb/parallel/parallel_state.hpp"
 
+#include <condition_variable>
 #include <limits>
 
 namespace duckdb {
@@ -105,6 +108,8 @@ static unique_ptr<FunctionData> ReadCSVBind(ClientContext &context, vector<Value
 			options.compression = kv.second.str_value;
 		} else if (kv.first == "filename") {
 			result->include_file_name = kv.second.value_.boolean;
+		} else if (kv.first == "parallel") {
+			options.parallel = kv.second.value_.boolean;
 		}
 	}
 	if (!options.auto_detect && return_types.empty()) {
@@ -133,11 +138,81 @@ static unique_ptr<FunctionData> ReadCSVBind(ClientContext &context, vector<Value
 	return move(result);
 }
 
+//! The size of the byte ranges that CSV files are split into when they are read in parallel
+static constexpr idx_t CSV_PARALLEL_RANGE_SIZE = 8 * 1024 * 1024;
+
 struct ReadCSVOperatorData : public FunctionOperatorData {
 	//! The CSV reader
 	unique_ptr<BufferedCSVReader> csv_reader;
-	//! The index of the next file to read (i.e. current file + 1)
+	//! The index of the next file to read (i.e. current file + 1), or the index of the current file in a parallel read
 	idx_t file_index;
+	//! Whether or not this is a parallel read
+	bool is_parallel = false;
+	//! The index of the byte range of the file that is read by the csv_reader (parallel reads only)
+	idx_t range_index = 0;
+	//! Whether or not the csv_reader reads the rest of a file sequentially after a range was not resynchronized
+	//! correctly (parallel reads only)
+	bool sequential_read = false;
+	//! Whether or not the rows of the range are buffered until it is known that the range starts at a row boundary
+	bool buffer_rows = false;
+	//! The buffered rows of the range, and the error that occurred while reading the range (if any)
+	unique_ptr<ChunkCollection> range_rows;
+	std::exception_ptr range_error;
+	//! The buffered rows of a range that have been verified and are returned by this thread, and the next chunk of
+	//! them to return
+	unique_ptr<ChunkCollection> verified_rows;
+	idx_t verified_chunk = 0;
+};
+
+//! A byte range of a file that is read in parallel
+struct ReadCSVRange {
+	//! The offset of the first row that was read by the reader of the range
+	idx_t row_start = INVALID_INDEX;
+	//! The offset of the first row after the range, set once the range has been read
+	idx_t row_end = INVALID_INDEX;
+	//! Whether or not the range has been read
+	bool finished = false;
+	//! Whether or not the range is known to start at a row boundary: i.e. the range before it is verified and ended
+	//! where this range starts. If the reader skipped to a newline within a quoted value this is never the case.
+	bool verified = false;
+	//! The rows of the range, buffered until the range is verified
+	unique_ptr<ChunkCollection> rows;
+	//! The error that occurred while reading the range (if any), raised once the range is verified
+	std::exception_ptr error;
+};
+
+struct ReadCSVFileRanges {
+	//! The byte ranges of the file that have been handed out
+	vector<ReadCSVRange> ranges;
+	//! The amount of ranges (from the start of the file) that have been verified
+	idx_t verified_count = 0;
+	//! Whether or not a range was not resynchronized correctly; the rest of the file is then read sequentially from the
+	//! end of the last verified range, and the rows of the later ranges are discarded
+	bool sequential = false;
+};
+
+struct ReadCSVParallelState : public ParallelState {
+	mutex lock;
+	//! The types of the columns of the files
+	vector<LogicalType> sql_types;
+	//! The index of the file that is currently being split into byte ranges
+	idx_t file_index = 0;
+	//! The options to read every file with (once it has been opened); the dialect of the file is already known
+	vector<BufferedCSVReaderOptions> file_options;
+	//! Whether or not a thread is detecting the dialect of the next file, which is done without holding the lock
+	bool sniffing = false;
+	//! Signaled once the dialect of the next file has been detected
+	std::condition_variable sniffed;
+	//! The size of the current file, or INVALID_INDEX if the file cannot be split into byte ranges
+	idx_t file_size = 0;
+	//! The index of the next byte range of the current file
+	idx_t range_index = 0;
+	//! The byte ranges of every file that has been opened
+	vector<ReadCSVFileRanges> files;
+	//! The buffered rows of verified ranges, waiting for a thread to return them
+	vector<unique_ptr<ChunkCollection>> verified_rows;
+	//! The files that have to be read sequentially, and the offset of the row to start reading at
+	vector<pair<idx_t, idx_t>> sequential_reads;
 };
 
 static unique_ptr<FunctionOperatorData> ReadCSVInit(ClientContext &context, const FunctionData *bind_data_p,
@@ -154,6 +229,226 @@ static unique_ptr<FunctionOperatorData> ReadCSVInit(ClientContext &context, cons
 	return move(result);
 }
 
+static idx_t ReadCSVMaxThreads(ClientContext &context, const FunctionData *bind_data_p) {
+	auto &bind_data = (ReadCSVData &)*bind_data_p;
+	if (!bind_data.options.parallel) {
+		return 1;
+	}
+	// small inputs are read by a single thread, which also returns the rows in order
+	// the input size is estimated from the first file only: the other files are not opened during planning
+	idx_t file_size;
+	if (bind_data.initial_reader) {
+		file_size = bind_data.initial_reader->file_size;
+	} else {
+		auto &fs = FileSystem::GetFileSystem(context);
+		auto handle = fs.OpenFile(bind_data.files[0].c_str(), FileFlags::FILE_FLAGS_READ);
+		file_size = fs.GetFileSize(*handle);
+	}
+	return file_size * bind_data.files.size() / CSV_PARALLEL_RANGE_SIZE + 1;
+}
+
+static unique_ptr<ParallelState> ReadCSVInitParallelState(ClientContext &context, const FunctionData *bind_data_p) {
+	auto &bind_data = (ReadCSVData &)*bind_data_p;
+	auto result = make_unique<ReadCSVParallelState>();
+	result->sql_types = bind_data.initial_reader ? bind_data.initial_reader->sql_types : bind_data.sql_types;
+	return move(result);
+}
+
+//! Determine the options to read the given file with: the dialect of every file is detected up front, as the readers
+//! of the byte ranges of a file do not see the beginning of the file. If no column types are known yet the detected
+//! types are stored in sql_types.
+static BufferedCSVReaderOptions ReadCSVGetFileOptions(ClientContext &context, ReadCSVData &bind_data,
+                                                      vector<LogicalType> &sql_types, idx_t file_index) {
+	BufferedCSVReaderOptions result;
+	if (file_index == 0 && bind_data.initial_reader) {
+		result = bind_data.initial_reader->options;
+	} else if (bind_data.options.auto_detect) {
+		result = bind_data.options;
+		result.file_path = bind_data.files[file_index];
+		BufferedCSVReader sniffer(context, result, sql_types);
+		if (sql_types.empty()) {
+			sql_types = sniffer.sql_types;
+		}
+		result = sniffer.options;
+	} else {
+		result = bind_data.options;
+	}
+	result.file_path = bind_data.files[file_index];
+	result.auto_detect = false;
+	return result;
+}
+
+//! Verify the ranges of a file in order: a range starts at a row boundary if the range before it does, and ended
+//! where the range starts. The buffered rows of verified ranges are handed out to be returned, if a range does not
+//! start at a row boundary the rest of the file is read sequentially instead.
+static void ReadCSVVerifyRanges(ReadCSVParallelState &state, idx_t file_index) {
+	auto &file = state.files[file_index];
+	while (!file.sequential && file.verified_count < file.ranges.size()) {
+		auto &range = file.ranges[file.verified_count];
+		if (!range.verified) {
+			D_ASSERT(file.verified_count > 0);
+			auto &previous = file.ranges[file.verified_count - 1];
+			if (!previous.finished) {
+				// the previous range has not been read yet
+				return;
+			}
+			if (previous.row_end != range.row_start) {
+				// the reader of the range skipped to a newline within a quoted value
+				file.sequential = true;
+				for (idx_t range_idx = file.verified_count; range_idx < file.ranges.size(); range_idx++) {
+					file.ranges[range_idx].rows.reset();
+					file.ranges[range_idx].error = nullptr;
+				}
+				state.sequential_reads.emplace_back(file_index, previous.row_end);
+				return;
+			}
+			range.verified = true;
+		}
+		if (!range.finished) {
+			// the range is verified but has not been read yet: its rows are handed out once it has been read
+			return;
+		}
+		if (range.error) {
+			std::rethrow_exception(range.error);
+		}
+		if (range.rows) {
+			state.verified_rows.push_back(move(range.rows));
+		}
+		file.verified_count++;
+	}
+}
+
+static bool ReadCSVParallelStateNext(ClientContext &context, const FunctionData *bind_data_p,
+                                     FunctionOperatorData *operator_state, ParallelState *parallel_state_p) {
+	auto &bind_data = (ReadCSVData &)*bind_data_p;
+	auto &data = (ReadCSVOperatorData &)*operator_state;
+	auto &state = (ReadCSVParallelState &)*parallel_state_p;
+
+	std::unique_lock<mutex> parallel_lock(state.lock);
+	if (data.csv_reader && !data.sequential_read) {
+		// the reader finished its range: it can be verified once the range before it has been verified
+		auto &file = state.files[data.file_index];
+		auto &range = file.ranges[data.range_index];
+		range.row_end = data.csv_reader->range_row_end;
+		range.finished = true;
+		if (!file.sequential) {
+			// if the file is read sequentially the rows of the range are discarded
+			range.rows = move(data.range_rows);
+			range.error = data.range_error;
+		}
+		ReadCSVVerifyRanges(state, data.file_index);
+	}
+	data.csv_reader.reset();
+	data.range_rows.reset();
+	data.range_error = nullptr;
+	data.verified_rows.reset();
+	data.sequential_read = false;
+	data.buffer_rows = false;
+
+	// first return the rows of the ranges that have been verified
+	if (!state.verified_rows.empty()) {
+		data.verified_rows = move(state.verified_rows.back());
+		data.verified_chunk = 0;
+		state.verified_rows.pop_back();
+		return true;
+	}
+	// then read the files that could not be split sequentially from their last verified row boundary
+	if (!state.sequential_reads.empty()) {
+		auto sequential_read = state.sequential_reads.back();
+		state.sequential_reads.pop_back();
+		auto reader = make_unique<BufferedCSVReader>(context, state.file_options[sequential_read.first],
+		                                             state.sql_types);
+		reader->SetRange(sequential_read.second, INVALID_INDEX, true);
+		data.csv_reader = move(reader);
+		data.file_index = sequential_read.first;
+		data.sequential_read = true;
+		return true;
+	}
+	while (state.file_index < bind_data.files.size()) {
+		if (state.files.size() <= state.file_index) {
+			if (state.sniffing) {
+				// another thread is detecting the dialect of the next file
+				state.sniffed.wait(parallel_lock);
+				continue;
+			}
+			// detect the dialect of the next file without holding the lock
+			state.sniffing = true;
+			auto file_index = state.file_index;
+			auto sql_types = state.sql_types;
+			BufferedCSVReaderOptions file_options;
+			parallel_lock.unlock();
+			try {
+				file_options = ReadCSVGetFileOptions(context, bind_data, sql_types, file_index);
+			} catch (...) {
+				parallel_lock.lock();
+				state.sniffing = false;
+				state.sniffed.notify_all();
+				throw;
+			}
+			parallel_lock.lock();
+			if (state.sql_types.empty()) {
+				state.sql_types = move(sql_types);
+			}
+			state.file_options.push_back(move(file_options));
+			state.files.emplace_back();
+			state.range_index = 0;
+			state.sniffing = false;
+			state.sniffed.notify_all();
+		}
+		auto &file = state.files[state.file_index];
+		idx_t range_start = state.range_index * CSV_PARALLEL_RANGE_SIZE;
+		if (file.sequential ||
+		    (state.range_index > 0 && (state.file_size == INVALID_INDEX || range_start >= state.file_size))) {
+			// all ranges of this file have been handed out: move to the next file
+			state.file_index++;
+			continue;
+		}
+		auto reader = make_unique<BufferedCSVReader>(context, state.file_options[state.file_index], state.sql_types);
+		if (state.range_index == 0) {
+			state.file_size = reader->SupportsRanges() ? reader->file_size : INVALID_INDEX;
+		}
+		if (state.file_size != INVALID_INDEX) {
+			reader->SetRange(range_start, range_start + CSV_PARALLEL_RANGE_SIZE);
+		}
+		ReadCSVRange range;
+		range.row_start = reader->range_row_start;
+		if (state.range_index == 0) {
+			// the first range starts at the beginning of the file
+			range.verified = true;
+		} else if (file.verified_count == state.range_index) {
+			// the ranges before this one have been verified and read: this range can be verified right away
+			range.verified = file.ranges.back().row_end == range.row_start;
+		}
+		file.ranges.push_back(move(range));
+		ReadCSVVerifyRanges(state, state.file_index);
+		if (file.sequential) {
+			// this range did not start at a row boundary: the rest of the file is read sequentially instead
+			continue;
+		}
+
+		data.csv_reader = move(reader);
+		data.file_index = state.file_index;
+		data.range_index = state.range_index;
+		// the rows of a range that is not known to start at a row boundary yet are buffered until it is verified
+		data.buffer_rows = !file.ranges.back().verified;
+		state.range_index++;
+		return true;
+	}
+	return false;
+}
+
+static unique_ptr<FunctionOperatorData> ReadCSVParallelInit(ClientContext &context, const FunctionData *bind_data_p,
+                                                            ParallelState *parallel_state_p,
+                                                            vector<column_t> &column_ids,
+                                                            TableFilterCollection *filters) {
+	auto result = make_unique<ReadCSVOperatorData>();
+	result->is_parallel = true;
+	if (!ReadCSVParallelStateNext(context, bind_data_p, result.get(), parallel_state_p)) {
+		return nullptr;
+	}
+	return move(result);
+}
+
 static unique_ptr<FunctionData> ReadCSVAutoBind(ClientContext &context, vector<Value> &inputs,
                                                 unordered_map<string, Value> &named_parameters,
                                                 vector<LogicalType> &return_types, vector<string> &names) {
@@ -161,10 +456,54 @@ static unique_ptr<FunctionData> ReadCSVAutoBind(ClientContext &context, vector<V
 	return ReadCSVBind(context, inputs, named_parameters, return_types, names);
 }
 
+static void ReadCSVParseChunk(ReadCSVData &bind_data, ReadCSVOperatorData &data, DataChunk &output) {
+	data.csv_reader->ParseCSV(output);
+	if (bind_data.include_file_name) {
+		auto &col = output.data.back();
+		col.SetValue(0, Value(data.csv_reader->options.file_path));
+		col.SetVectorType(VectorType::CONSTANT_VECTOR);
+	}
+}
+
+//! Read the entire range of the reader into a buffer, the range might not start at a row boundary. Errors are only
+//! raised once it is known that the range starts at a row boundary, as they might be caused by a wrong start.
+static void ReadCSVBufferRange(ReadCSVData &bind_data, ReadCSVOperatorData &data, DataChunk &output) {
+	data.range_rows = make_unique<ChunkCollection>();
+	auto types = output.GetTypes();
+	DataChunk chunk;
+	chunk.Initialize(types);
+	try {
+		while (true) {
+			chunk.Reset();
+			ReadCSVParseChunk(bind_data, data, chunk);
+			if (chunk.size() == 0) {
+				break;
+			}
+			data.range_rows->Append(chunk);
+		}
+	} catch (...) {
+		data.range_error = std::current_exception();
+	}
+}
+
 static void ReadCSVFunction(ClientContext &context, const FunctionData *bind_data_p,
                             FunctionOperatorData *operator_state, DataChunk &output) {
 	auto &bind_data = (ReadCSVData &)*bind_data_p;
 	auto &data = (ReadCSVOperatorData &)*operator_state;
+	if (data.is_parallel) {
+		if (data.verified_rows) {
+			// return the buffered rows of a verified range
+			if (data.verified_chunk < data.verified_rows->ChunkCount()) {
+				output.Reference(data.verified_rows->GetChunk(data.verified_chunk++));
+			}
+		} else if (data.buffer_rows) {
+			// the range is read in one go, its rows are returned once it has been verified
+			ReadCSVBufferRange(bind_data, data, output);
+		} else {
+			ReadCSVParseChunk(bind_data, data, output);
+		}
+		return;
+	}
 	do {
 		data.csv_reader->ParseCSV(output);
 		if (output.size() == 0 && data.file_index < bind_data.files.size()) {
@@ -201,11 +540,20 @@ static void ReadCSVAddNamedParameters(TableFunction &table_function) {
 	table_function.named_parameters["timestampformat"] = LogicalType::VARCHAR;
 	table_function.named_parameters["compression"] = LogicalType::VARCHAR;
 	table_function.named_parameters["filename"] = LogicalType::BOOLEAN;
+	table_function.named_parameters["parallel"] = LogicalType::BOOLEAN;
+}
+
+static void ReadCSVSetParallelFunctions(TableFunction &table_function) {
+	table_function.max_threads = ReadCSVMaxThreads;
+	table_function.init_parallel_state = ReadCSVInitParallelState;
+	table_function.parallel_init = ReadCSVParallelInit;
+	table_function.parallel_state_next = ReadCSVParallelStateNext;
 }
 
 TableFunction ReadCSVTableFunction::GetFunction() {
 	TableFunction read_csv("read_csv", {LogicalType::VARCHAR}, ReadCSVFunction, ReadCSVBind, ReadCSVInit);
 	ReadCSVAddNamedParameters(read_csv);
+	ReadCSVSetParallelFunctions(read_csv);
 	return read_csv;
 }
 
@@ -214,6 +562,7 @@ void ReadCSVTableFunction::RegisterFunction(BuiltinFunctions &set) {
 
 	TableFunction read_csv_auto("read_csv_auto", {LogicalType::VARCHAR}, ReadCSVFunction, ReadCSVAutoBind, ReadCSVInit);
 	ReadCSVAddNamedParameters(read_csv_auto);
+	ReadCSVSetParallelFunctions(read_csv_auto);
 	set.AddFunction(read_csv_auto);
 }
 
@@ -0,0 +1,75 @@
+#include "duckdb/function/table/sqlite_functions.hpp"
+
+#include "duckdb/storage/buffer_manager.hpp"
+
+namespace duckdb {
+
+struct PragmaBufferStatisticsData : public FunctionOperatorData {
+	PragmaBufferStatisticsData() : finished(false) {
+	}
+
+	bool finished;
+};
+
+static unique_ptr<FunctionData> PragmaBufferStatisticsBind(ClientContext &context, vector<Value> &inputs,
+                                                           unordered_map<string, Value> &named_parameters,
+                                                           vector<LogicalType> &return_types, vector<string> &names) {
+	names.emplace_back("memory_usage");
+	return_types.push_back(LogicalType::BIGINT);
+
+	names.emplace_back("memory_limit");
+	return_types.push_back(LogicalType::BIGINT);
+
+	names.emplace_back("hits");
+	return_types.push_back(LogicalType::BIGINT);
+
+	names.emplace_back("misses");
+	return_types.push_back(LogicalType::BIGINT);
+
+	names.emplace_back("evictions");
+	return_types.push_back(LogicalType::BIGINT);
+
+	names.emplace_back("hit_ratio");
+	return_types.push_back(LogicalType::DOUBLE);
+
+	names.emplace_back("io_wait");
+	return_types.push_back(LogicalType::DOUBLE);
+
+	return nullptr;
+}
+
+unique_ptr<FunctionOperatorData> PragmaBufferStatisticsInit(ClientContext &context, const FunctionData *bind_data,
+                                                            vector<column_t> &column_ids,
+                                                            TableFilterCollection *filters) {
+	return make_unique<PragmaBufferStatisticsData>();
+}
+
+void PragmaBufferStatisticsFunction(ClientContext &context, const FunctionData *bind_data,
+                                    FunctionOperatorData *operator_state, DataChunk &output) {
+	auto &data = (PragmaBufferStatisticsData &)*operator_state;
+	if (data.finished) {
+		return;
+	}
+	auto &buffer_manager = BufferManager::GetBufferManager(context);
+	auto hits = buffer_manager.GetBlockHits();
+	auto misses = buffer_manager.GetBlockMisses();
+	auto max_memory = buffer_manager.GetMaxMemory();
+
+	output.SetCardinality(1);
+	output.data[0].SetValue(0, Value::BIGINT(buffer_manager.GetUsedMemory()));
+	output.data[1].SetValue(0, max_memory == (idx_t)-1 ? Value() : Value::BIGINT(max_memory));
+	output.data[2].SetValue(0, Value::BIGINT(hits));
+	output.data[3].SetValue(0, Value::BIGINT(misses));
+	output.data[4].SetValue(0, Value::BIGINT(buffer_manager.GetBlockEvictions()));
+	output.data[5].SetValue(0, hits + misses == 0 ? Value() : Value::DOUBLE((double)hits / (hits + misses)));
+	output.data[6].SetValue(0, Value::DOUBLE(buffer_manager.GetReadWaitTime()));
+
+	data.finished = true;
+}
+
+void PragmaBufferStatistics::RegisterFunction(BuiltinFunctions &set) {
+	set.AddFunction(TableFunction("pragma_buffer_statistics", {}, PragmaBufferStatisticsFunction,
+	                              PragmaBufferStatisticsBind, PragmaBufferStatisticsInit));
+}
+
+} // namespace duckdb
@@ -0,0 +1,66 @@
+#include "duckdb/function/table/sqlite_functions.hpp"
+
+#include "duckdb/parallel/task_scheduler.hpp"
+
+namespace duckdb {
+
+struct PragmaSchedulerStatisticsData : public FunctionOperatorData {
+	PragmaSchedulerStatisticsData() : finished(false) {
+	}
+
+	bool finished;
+};
+
+static unique_ptr<FunctionData> PragmaSchedulerStatisticsBind(ClientContext &context, vector<Value> &inputs,
+                                                              unordered_map<string, Value> &named_parameters,
+                                                              vector<LogicalType> &return_types,
+                                                              vector<string> &names) {
+	names.emplace_back("threads");
+	return_types.push_back(LogicalType::BIGINT);
+
+	names.emplace_back("tasks_executed");
+	return_types.push_back(LogicalType::BIGINT);
+
+	names.emplace_back("steals");
+	return_types.push_back(LogicalType::BIGINT);
+
+	names.emplace_back("idle_time");
+	return_types.push_back(LogicalType::DOUBLE);
+
+	names.emplace_back("queue_depth");
+	return_types.push_back(LogicalType::BIGINT);
+
+	return nullptr;
+}
+
+unique_ptr<FunctionOperatorData> PragmaSchedulerStatisticsInit(ClientContext &context, const FunctionData *bind_data,
+                                                               vector<column_t> &column_ids,
+                                                               TableFilterCollection *filters) {
+	return make_unique<PragmaSchedulerStatisticsData>();
+}
+
+void PragmaSchedulerStatisticsFunction(ClientContext &context, const FunctionData *bind_data,
+                                       FunctionOperatorData *operator_state, DataChunk &output) {
+	auto &data = (PragmaSchedulerStatisticsData &)*operator_state;
+	if (data.finished) {
+		return;
+	}
+	auto &scheduler = TaskScheduler::GetScheduler(context);
+	auto statistics = scheduler.GetStatistics();
+
+	output.SetCardinality(1);
+	output.data[0].SetValue(0, Value::BIGINT(scheduler.NumberOfThreads()));
+	output.data[1].SetValue(0, Value::BIGINT(statistics.tasks_executed));
+	output.data[2].SetValue(0, Value::BIGINT(statistics.steals));
+	output.data[3].SetValue(0, Value::DOUBLE(statistics.idle_time));
+	output.data[4].SetValue(0, Value::BIGINT(statistics.queue_depth));
+
+	data.finished = true;
+}
+
+void PragmaSchedulerStatistics::RegisterFunction(BuiltinFunctions &set) {
+	set.AddFunction(TableFunction("pragma_scheduler_statistics", {}, PragmaSchedulerStatisticsFunction,
+	                              PragmaSchedulerStatisticsBind, PragmaSchedulerStatisticsInit));
+}
+
+} // namespace duckdb
@@ -0,0 +1,103 @@
+#include "duckdb/function/table/sqlite_functions.hpp"
+
+#include "duckdb/catalog/catalog.hpp"
+#include "duckdb/catalog/catalog_entry/table_catalog_entry.hpp"
+#include "duckdb/parser/qualified_name.hpp"
+#include "duckdb/storage/data_table.hpp"
+
+namespace duckdb {
+
+struct PragmaStorageFunctionData : public TableFunctionData {
+	explicit PragmaStorageFunctionData(TableCatalogEntry *table_entry) : table_entry(table_entry) {
+	}
+
+	TableCatalogEntry *table_entry;
+	vector<vector<Value>> storage_info;
+};
+
+struct PragmaStorageOperatorData : public FunctionOperatorData {
+	PragmaStorageOperatorData() : offset(0) {
+	}
+
+	idx_t offset;
+};
+
+static unique_ptr<FunctionData> PragmaStorageInfoBind(ClientContext &context, vector<Value> &inputs,
+                                                      unordered_map<string, Value> &named_parameters,
+                                                      vector<LogicalType> &return_types, vector<string> &names) {
+	names.emplace_back("column_name");
+	return_types.push_back(LogicalType::VARCHAR);
+
+	names.emplace_back("column_id");
+	return_types.push_back(LogicalType::BIGINT);
+
+	names.emplace_back("segment_id");
+	return_types.push_back(LogicalType::BIGINT);
+
+	names.emplace_back("segment_type");
+	return_types.push_back(LogicalType::VARCHAR);
+
+	names.emplace_back("start");
+	return_types.push_back(LogicalType::BIGINT);
+
+	names.emplace_back("count");
+	return_types.push_back(LogicalType::BIGINT);
+
+	names.emplace_back("compression");
+	return_types.push_back(LogicalType::VARCHAR);
+
+	names.emplace_back("persistent");
+	return_types.push_back(LogicalType::BOOLEAN);
+
+	names.emplace_back("block_id");
+	return_types.push_back(LogicalType::BIGINT);
+
+	names.emplace_back("compressed_size");
+	return_types.push_back(LogicalType::BIGINT);
+
+	names.emplace_back("uncompressed_size");
+	return_types.push_back(LogicalType::BIGINT);
+
+	names.emplace_back("compression_ratio");
+	return_types.push_back(LogicalType::DOUBLE);
+
+	auto qname = QualifiedName::Parse(inputs[0].GetValue<string>());
+
+	// look up the table name in the catalog
+	auto &catalog = Catalog::GetCatalog(context);
+	auto table_entry = catalog.GetEntry<TableCatalogEntry>(context, qname.schema, qname.name);
+	auto result = make_unique<PragmaStorageFunctionData>(table_entry);
+	result->storage_info = table_entry->storage->GetStorageInfo();
+	return move(result);
+}
+
+unique_ptr<FunctionOperatorData> PragmaStorageInfoInit(ClientContext &context, const FunctionData *bind_data,
+                                                       vector<column_t> &column_ids, TableFilterCollection *filters) {
+	return make_unique<PragmaStorageOperatorData>();
+}
+
+static void PragmaStorageInfoFunction(ClientContext &context, const FunctionData *bind_data_p,
+                                      FunctionOperatorData *operator_state, DataChunk &output) {
+	auto &bind_data = (PragmaStorageFunctionData &)*bind_data_p;
+	auto &data = (PragmaStorageOperatorData &)*operator_state;
+	idx_t count = 0;
+	while (data.offset < bind_data.storage_info.size() && count < STANDARD_VECTOR_SIZE) {
+		auto &entry = bind_data.storage_info[data.offset++];
+		D_ASSERT(entry.size() + 1 == output.ColumnCount());
+		// the first column is the column name
+		auto column_id = entry[0].GetValue<int64_t>();
+		output.SetValue(0, count, Value(bind_data.table_entry->columns[column_id].name));
+		for (idx_t col_idx = 0; col_idx < entry.size(); col_idx++) {
+			output.SetValue(col_idx + 1, count, entry[col_idx]);
+		}
+		count++;
+	}
+	output.SetCardinality(count);
+}
+
+void PragmaStorageInfo::RegisterFunction(BuiltinFunctions &set) {
+	set.AddFunction(TableFunction("pragma_storage_info", {LogicalType::VARCHAR}, PragmaStorageInfoFunction,
+	                              PragmaStorageInfoBind, PragmaStorageInfoInit));
+}
+
+} // namespace duckdb
@@ -13,9 +13,12 @@ void BuiltinFunctions::RegisterSQLiteFunctions() {
 	PragmaFunctionPragma::RegisterFunction(*this);
 	PragmaCollations::RegisterFunction(*this);
 	PragmaTableInfo::RegisterFunction(*this);
+	PragmaStorageInfo::RegisterFunction(*this);
 	SQLiteMaster::RegisterFunction(*this);
 	PragmaDatabaseSize::RegisterFunction(*this);
 	PragmaDatabaseList::RegisterFunction(*this);
+	PragmaBufferStatistics::RegisterFunction(*this);
+	PragmaSchedulerStatistics::RegisterFunction(*this);
 
 	// CreateViewInfo info;
 	// info.schema = DEFAULT_SCHEMA;
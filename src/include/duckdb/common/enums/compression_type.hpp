@@ -0,0 +1,31 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// duckdb/common/enums/compression_type.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/common/constants.hpp"
+
+namespace duckdb {
+
+//===--------------------------------------------------------------------===//
+// Compression Types
+//===--------------------------------------------------------------------===//
+enum class CompressionType : uint8_t {
+	COMPRESSION_AUTO = 0,         // pick the compression type at checkpoint time (only used as a setting)
+	COMPRESSION_UNCOMPRESSED = 1, // the data is stored as-is
+	COMPRESSION_RLE = 2,          // run-length encoding: (value, run length) pairs
+	COMPRESSION_BITPACKING = 3,   // frame-of-reference: a per-vector minimum followed by bit-packed deltas
+	COMPRESSION_DICTIONARY = 4    // a per-vector dictionary of distinct values followed by bit-packed codes
+};
+
+//! Convert a compression type to a string
+string CompressionTypeToString(CompressionType type);
+//! Convert a string to a compression type, throws an exception if the string is not a valid compression type
+CompressionType CompressionTypeFromString(const string &str);
+
+} // namespace duckdb
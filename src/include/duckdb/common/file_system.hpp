@@ -11,6 +11,7 @@
 #include "duckdb/common/constants.hpp"
 #include "duckdb/common/file_buffer.hpp"
 #include "duckdb/common/vector.hpp"
+#include "duckdb/common/pair.hpp"
 #include "duckdb/common/unordered_map.hpp"
 #include "duckdb/common/exception.hpp"
 
@@ -35,6 +36,7 @@ public:
 
 	void Read(void *buffer, idx_t nr_bytes, idx_t location);
 	void Write(void *buffer, idx_t nr_bytes, idx_t location);
+	void Prefetch(const vector<pair<idx_t, idx_t>> &ranges);
 	void Sync();
 	void Truncate(int64_t new_size);
 
@@ -46,6 +48,12 @@ public:
 	string path;
 };
 
+//! The size and the last modification time of a file, as found when listing its directory
+struct FileInfo {
+	idx_t file_size = 0;
+	time_t last_modified = 0;
+};
+
 enum class FileLockType : uint8_t { NO_LOCK = 0, READ_LOCK = 1, WRITE_LOCK = 2 };
 
 class FileFlags {
@@ -77,17 +85,21 @@ public:
 	unique_ptr<FileHandle> OpenFile(string &path, uint8_t flags, FileLockType lock = FileLockType::NO_LOCK) {
 		return OpenFile(path.c_str(), flags, lock);
 	}
-	//! Read exactly nr_bytes from the specified location in the file. Fails if nr_bytes could not be read. This is
-	//! equivalent to calling SetFilePointer(location) followed by calling Read().
+	//! Read exactly nr_bytes from the specified location in the file. Fails if nr_bytes could not be read. This uses
+	//! positional I/O: the file pointer is not used, so multiple threads can read from the same handle concurrently.
 	virtual void Read(FileHandle &handle, void *buffer, int64_t nr_bytes, idx_t location);
-	//! Write exactly nr_bytes to the specified location in the file. Fails if nr_bytes could not be read. This is
-	//! equivalent to calling SetFilePointer(location) followed by calling Write().
+	//! Write exactly nr_bytes to the specified location in the file. Fails if nr_bytes could not be written. This uses
+	//! positional I/O: the file pointer is not used, so multiple threads can write to the same handle concurrently.
 	virtual void Write(FileHandle &handle, void *buffer, int64_t nr_bytes, idx_t location);
 	//! Read nr_bytes from the specified file into the buffer, moving the file pointer forward by nr_bytes. Returns the
 	//! amount of bytes read.
 	virtual int64_t Read(FileHandle &handle, void *buffer, int64_t nr_bytes);
 	//! Write nr_bytes from the buffer into the file, moving the file pointer forward by nr_bytes.
 	virtual int64_t Write(FileHandle &handle, void *buffer, int64_t nr_bytes);
+	//! Hint that the specified (location, nr_bytes) ranges of the file are about to be read. File systems for remote
+	//! files can use this to fetch the ranges ahead of time, local file systems ignore it.
+	virtual void Prefetch(FileHandle &handle, const vector<pair<idx_t, idx_t>> &ranges) {
+	}
 
 	//! Returns the file size of a file handle, returns -1 on error
 	virtual int64_t GetFileSize(FileHandle &handle);
@@ -105,6 +117,10 @@ public:
 	virtual void RemoveDirectory(const string &directory);
 	//! List files in a directory, invoking the callback method for each one with (filename, is_dir)
 	virtual bool ListFiles(const string &directory, const std::function<void(string, bool)> &callback);
+	//! List files in a directory like ListFiles, passing the size and the last modification time of every file to the
+	//! callback as well. Returns false if the directory could not be listed or the file system does not report them.
+	virtual bool ListFiles(const string &directory,
+	                       const std::function<void(const string &, bool, const FileInfo &)> &callback);
 	//! Move a file from source path to the target, StorageManager relies on this being an atomic action for ACID
 	//! properties
 	virtual void MoveFile(const string &source, const string &target);
@@ -128,6 +144,11 @@ public:
 
 	//! Runs a glob on the file system, returning a list of matching files
 	virtual vector<string> Glob(const string &path);
+	//! Runs a glob on the file system like Glob, and returns the size and the last modification time of the matching
+	//! files as they were found when listing their directory, so they do not have to be opened to find out whether
+	//! they changed. Returns false (and no files) if the file system does not report them for this path, in which case
+	//! the caller should fall back to Glob.
+	virtual bool GlobFileInfo(const string &path, vector<string> &files, vector<FileInfo> &file_info);
 
 	//! Returns the system-available memory in bytes
 	virtual idx_t GetAvailableMemory();
@@ -137,9 +158,10 @@ public:
 		throw NotImplementedException("Can't register a protocol handler on a non-virtual file system");
 	}
 
-private:
-	//! Set the file pointer of a file handle to a specified location. Reads and writes will happen from this location
-	void SetFilePointer(FileHandle &handle, idx_t location);
+protected:
+	//! Set the file pointer of a file handle to a specified location. Reads and writes will happen from this location.
+	//! File systems that do not override the positional Read/Write use this to read or write at a location.
+	virtual void SetFilePointer(FileHandle &handle, idx_t location);
 };
 
 // bunch of wrappers to allow registering protocol handlers
@@ -166,6 +188,10 @@ public:
 		return handle.file_system.Write(handle, buffer, nr_bytes);
 	}
 
+	void Prefetch(FileHandle &handle, const vector<pair<idx_t, idx_t>> &ranges) override {
+		handle.file_system.Prefetch(handle, ranges);
+	}
+
 	int64_t GetFileSize(FileHandle &handle) override {
 		return handle.file_system.GetFileSize(handle);
 	}
@@ -196,6 +222,10 @@ public:
 	bool ListFiles(const string &directory, const std::function<void(string, bool)> &callback) override {
 		return FindFileSystem(directory)->ListFiles(directory, callback);
 	}
+	bool ListFiles(const string &directory,
+	               const std::function<void(const string &, bool, const FileInfo &)> &callback) override {
+		return FindFileSystem(directory)->ListFiles(directory, callback);
+	}
 
 	void MoveFile(const string &source, const string &target) override {
 		FindFileSystem(source)->MoveFile(source, target);
@@ -213,6 +243,10 @@ public:
 		return FindFileSystem(path)->Glob(path);
 	}
 
+	bool GlobFileInfo(const string &path, vector<string> &files, vector<FileInfo> &file_info) override {
+		return FindFileSystem(path)->GlobFileInfo(path, files, file_info);
+	}
+
 	// these goes to the default fs
 	void SetWorkingDirectory(const string &path) override {
 		default_fs.SetWorkingDirectory(path);
@@ -11,6 +11,7 @@
 #include "duckdb/common/common.hpp"
 #include "duckdb/common/types/data_chunk.hpp"
 #include "duckdb/common/types/vector.hpp"
+#include "duckdb/common/unordered_map.hpp"
 #include "duckdb/parser/parsed_expression.hpp"
 #include "duckdb/storage/data_table.hpp"
 #include "duckdb/storage/index.hpp"
@@ -23,7 +24,11 @@
 #include "duckdb/execution/index/art/node48.hpp"
 #include "duckdb/execution/index/art/node256.hpp"
 
+#include <atomic>
+
 namespace duckdb {
+class BlockHandle;
+
 struct IteratorEntry {
 	IteratorEntry() {
 	}
@@ -62,6 +67,88 @@ struct ARTIndexScanState : public IndexScanState {
 	idx_t result_index = 0;
 };
 
+//! A key of a bulk-loaded index build, and the row it belongs to
+struct ARTBuildEntry {
+	ARTBuildEntry(unique_ptr<Key> key, row_t row_id);
+
+	//! The first (up to) eight bytes of the key as a big-endian integer, which decides most comparisons without
+	//! touching the key itself
+	uint64_t prefix;
+	unique_ptr<Key> key;
+	row_t row_id;
+
+public:
+	//! Returns the byte of the key at the given position
+	uint8_t GetByte(idx_t pos) const {
+		return pos < sizeof(uint64_t) ? (uint8_t)(prefix >> (8 * (sizeof(uint64_t) - 1 - pos))) : key->data[pos];
+	}
+	bool operator<(const ARTBuildEntry &other) const;
+};
+
+struct ARTBuildState : public IndexBuildState {
+	//! The entries collected by the thread, sorted by key when the thread combines them
+	vector<ARTBuildEntry> entries;
+};
+
+enum class OptimisticLookupResult : uint8_t {
+	SUCCESS,
+	//! A node on the path changed while it was read
+	RESTART,
+	//! A node on the path has not been read from disk yet
+	NOT_LOADED,
+	//! The lookup moved on to the next node on the path
+	DESCEND
+};
+
+//! The position of an optimistic lookup in the tree
+struct ARTLookupState {
+	//! The version of the parent of the node, and its value when the pointer to the node was read
+	NodeVersion *parent;
+	uint64_t parent_version;
+	Node *node;
+	idx_t depth;
+};
+
+//! The number of optimistic lookups per epoch parity, padded to a cache line so that lookups in different threads do
+//! not contend on the same counter
+struct ARTReaderCount {
+	ARTReaderCount() {
+		count[0] = 0;
+		count[1] = 0;
+	}
+
+	std::atomic<idx_t> count[2];
+	char padding[64 - 2 * sizeof(std::atomic<idx_t>)];
+};
+
+//! The nodes and buffers that were removed from the tree, but might still be read by optimistic lookups
+struct ARTRetiredEntries {
+	vector<unique_ptr<Node>> nodes;
+	vector<unique_ptr<uint8_t[]>> prefixes;
+	vector<unique_ptr<row_t[]>> row_ids;
+
+	bool Empty() {
+		return nodes.empty() && prefixes.empty() && row_ids.empty();
+	}
+	void Clear() {
+		nodes.clear();
+		prefixes.clear();
+		row_ids.clear();
+	}
+};
+
+//! A block the nodes of the index were written to
+struct ARTBlock {
+	ARTBlock() : references(0), next_block(INVALID_BLOCK) {
+	}
+
+	//! The number of nodes in the tree that start in the block, plus one if the last node of the previous block
+	//! continues in it. The block is freed when there are no references left.
+	idx_t references;
+	//! The block the last node of the block continues in (if any)
+	block_id_t next_block;
+};
+
 class ART : public Index {
 public:
 	ART(vector<column_t> column_ids, vector<unique_ptr<Expression>> unbound_expressions, bool is_unique = false);
@@ -73,6 +160,13 @@ public:
 	bool is_little_endian;
 	//! Whether or not the ART is an index built to enforce a UNIQUE constraint
 	bool is_unique;
+	//! The database the nodes of the tree are read from, set if the tree was read from disk
+	DatabaseInstance *db;
+	//! The blocks nodes were read from. They are kept registered, so the buffer manager keeps them cached until it
+	//! needs the memory for something else.
+	unordered_map<block_id_t, shared_ptr<BlockHandle>> blocks;
+	//! The memory used by the nodes that were read from disk since the tree was last unloaded
+	idx_t loaded_memory;
 
 public:
 	//! Initialize a scan on the index with the given expression and column ids
@@ -98,27 +192,108 @@ public:
 	//! Insert data into the index.
 	bool Insert(IndexLock &lock, DataChunk &data, Vector &row_ids) override;
 
+	//! Bulk loading: every thread collects and sorts the keys of its rows, constructs a sub-tree bottom-up from the
+	//! sorted run and merges it with the sub-trees of the other threads
+	unique_ptr<IndexBuildState> InitializeBuild() override;
+	void BuildAppend(IndexBuildState &state, DataChunk &input, Vector &row_ids) override;
+	bool BuildCombine(IndexBuildState &state) override;
+
+	//! Write the nodes that changed since the last checkpoint to the blocks of the index, and the location of the
+	//! tree and of its blocks to the writer. Afterwards the nodes that were written are unloaded.
+	BlockPointer Serialize(MetaBlockWriter &writer) override;
+	void Deserialize(DatabaseInstance &db, BlockPointer pointer) override;
+	//! Free the blocks of the index
+	void CommitDrop() override;
+
+	//! Register a node that was written to the given blocks (the block it starts in first)
+	void AddNode(const vector<block_id_t> &node_blocks);
+	//! Mark a node as changed: its location on disk is no longer part of the tree
+	void ReleaseNode(Node &node);
+
+	//! Point lookups do not take the index lock (see OptimisticLookup), they can run concurrently with each other and
+	//! with writers
 	bool SearchEqual(ARTIndexScanState *state, idx_t max_count, vector<row_t> &result_ids);
 	//! Search Equal used for Joins that do not need to fetch data
 	void SearchEqualJoinNoFetch(Value &equal_value, idx_t &result_size);
+	//! Look up all keys of the input at once. The lookups descend the tree level by level, so that the next node of
+	//! every key is prefetched while the other keys are processed. The number of row ids of every key is written to
+	//! result_sizes, the row ids are appended to result_ids (if any).
+	void SearchEqualBatch(DataChunk &input, idx_t result_sizes[], vector<row_t> result_ids[]);
+
+	//! Free a node (with its children) or buffer removed from the tree once no optimistic lookup can still read it
+	void Retire(unique_ptr<Node> node);
+	void Retire(unique_ptr<uint8_t[]> prefix);
+	void Retire(unique_ptr<row_t[]> row_ids);
+	//! Register an optimistic lookup, returns the counter it was registered in
+	idx_t BeginOptimisticRead();
+	void EndOptimisticRead(idx_t reader);
 
 private:
+	static constexpr idx_t READER_COUNT_STRIPES = 16;
+	//! The number of times an optimistic lookup is restarted before it takes the index lock
+	static constexpr idx_t OPTIMISTIC_LOOKUP_ATTEMPTS = 32;
+	//! The nodes that were read from disk are unloaded once they use more than this fraction of the memory limit
+	static constexpr idx_t LOADED_MEMORY_FRACTION = 8;
+
 	DataChunk expression_result;
+	//! The version of the root pointer
+	NodeVersion root_version;
+	//! Nodes are retired in epochs: entries retired in an epoch are freed once the lookups that started in or before
+	//! it are done
+	std::atomic<idx_t> epoch;
+	ARTReaderCount reader_counts[READER_COUNT_STRIPES];
+	mutex retired_lock;
+	//! The entries retired in the current epoch, and the entries retired in the previous epoch
+	ARTRetiredEntries retired;
+	ARTRetiredEntries retired_previous;
+	//! The blocks that contain nodes of the tree on disk
+	unordered_map<block_id_t, ARTBlock> index_blocks;
+	//! The blocks that no longer contain nodes of the tree, they are freed at the next checkpoint
+	vector<block_id_t> free_blocks;
 
 private:
 	//! Insert a row id into a leaf node
 	bool InsertToLeaf(Leaf &leaf, row_t row_id);
-	//! Insert the leaf value into the tree
-	bool Insert(unique_ptr<Node> &node, unique_ptr<Key> key, unsigned depth, row_t row_id);
+	//! Insert the leaf value into the tree. The version of the parent is locked if the node is replaced.
+	bool Insert(unique_ptr<Node> &node, NodeVersion &parent_version, unique_ptr<Key> key, unsigned depth,
+	            row_t row_id);
+
+	//! Construct the tree of the entries [start, end) of a sorted run bottom-up
+	bool Construct(unique_ptr<Node> &node, vector<ARTBuildEntry> &entries, idx_t start, idx_t end, idx_t depth);
+	//! Merge the other tree into the node, both trees start at the same depth
+	bool Merge(unique_ptr<Node> &node, unique_ptr<Node> &other, idx_t depth);
+	//! Merge the other tree into the child of the node with the given key byte
+	bool MergeChild(unique_ptr<Node> &node, uint8_t key_byte, unique_ptr<Node> &other, idx_t depth);
 
 	//! Erase element from leaf (if leaf has more than one value) or eliminate the leaf itself
-	void Erase(unique_ptr<Node> &node, Key &key, unsigned depth, row_t row_id);
+	void Erase(unique_ptr<Node> &node, NodeVersion &parent_version, Key &key, unsigned depth, row_t row_id);
 
 	//! Check if the key of the leaf is equal to the searched key
 	bool LeafMatches(Node *node, Key &key, unsigned depth);
 
-	//! Find the node with a matching key, optimistic version
+	//! Find the node with a matching key, the index lock must be held
 	Node *Lookup(unique_ptr<Node> &node, Key &key, unsigned depth);
+	//! Look up the row ids of the key, append them to result_ids (if any) and return their number. Tries an
+	//! optimistic lookup first, and takes the index lock if that does not succeed.
+	idx_t LookupKey(Key &key, vector<row_t> *result_ids);
+	//! Look up a batch of keys (see SearchEqualBatch), NULL keys have no row ids
+	void LookupKeys(vector<unique_ptr<Key>> &keys, idx_t result_sizes[], vector<row_t> result_ids[]);
+	//! Look up the key without holding the index lock (optimistic lock coupling). Nodes are read without locking
+	//! them, the lookup restarts if a node changed while it was read.
+	OptimisticLookupResult OptimisticLookup(Key &key, vector<row_t> *result_ids, idx_t &count);
+	//! Start an optimistic lookup at the root, returns false if it has to be restarted
+	bool StartOptimisticLookup(ARTLookupState &state);
+	//! Process the current node of an optimistic lookup. Returns DESCEND if the lookup moved on to the next node.
+	OptimisticLookupResult OptimisticLookupStep(ARTLookupState &state, Key &key, vector<row_t> *result_ids,
+	                                            idx_t &count);
+	//! Free the retired entries that can no longer be read by optimistic lookups
+	void ReclaimRetired();
+	//! Release a reference to a block of the index
+	void ReleaseBlock(block_id_t block_id);
+	//! Unload the nodes that did not change since they were read from disk if they use too much memory, the index
+	//! lock must be held and no nodes of the tree may be referenced
+	void UnloadIfNeeded();
+	bool HasOptimisticReaders(idx_t epoch_parity);
 
 	//! Find the first node that is bigger (or equal to) a specific key
 	bool Bound(unique_ptr<Node> &node, Key &key, Iterator &iterator, bool inclusive);
@@ -11,10 +11,13 @@
 #include "duckdb/execution/index/art/node.hpp"
 
 namespace duckdb {
+class Deserializer;
+class Serializer;
 
 class Leaf : public Node {
 public:
 	Leaf(ART &art, unique_ptr<Key> value, row_t row_id);
+	Leaf(ART &art, unique_ptr<Key> value, unique_ptr<row_t[]> row_ids, idx_t num_elements);
 
 	unique_ptr<Key> value;
 	idx_t capacity;
@@ -23,11 +26,19 @@ public:
 	row_t GetRowId(idx_t index) {
 		return row_ids[index];
 	}
+	row_t *GetRowIds() {
+		return row_ids.get();
+	}
 
 public:
-	void Insert(row_t row_id);
+	void Insert(ART &art, row_t row_id);
 	void Remove(row_t row_id);
 
+	//! Write the key and the row ids of the leaf
+	void SerializeValues(Serializer &serializer);
+	//! Read a leaf written by SerializeValues
+	static unique_ptr<Leaf> DeserializeValues(ART &art, Deserializer &source);
+
 private:
 	unique_ptr<row_t[]> row_ids;
 };
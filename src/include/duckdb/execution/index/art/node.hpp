@@ -10,11 +10,75 @@
 
 #include "duckdb/execution/index/art/art_key.hpp"
 #include "duckdb/common/common.hpp"
+#include "duckdb/storage/block.hpp"
+
+#include <atomic>
 
 namespace duckdb {
-enum class NodeType : uint8_t { N4 = 0, N16 = 1, N48 = 2, N256 = 3, NLeaf = 4 };
+enum class NodeType : uint8_t { N4 = 0, N16 = 1, N48 = 2, N256 = 3, NLeaf = 4, NPersistent = 5 };
 
 class ART;
+class MetaBlockWriter;
+
+//! The version of a node, used for optimistic lock coupling: lookups traverse the tree without taking the index lock,
+//! and restart if a node they read was changed in the meantime. Writers are serialized by the index lock. They lock a
+//! node while they modify it, and mark it as obsolete once it has been removed from the tree.
+class NodeVersion {
+public:
+	NodeVersion() : version(0) {
+	}
+
+	//! Read the version before reading the node, returns false if the node is being modified or has been removed
+	bool ReadLock(uint64_t &result) const {
+		result = version.load();
+		return (result & (LOCKED | OBSOLETE)) == 0;
+	}
+	//! Returns true if the node has not changed since ReadLock returned the given version
+	bool Validate(uint64_t expected) const {
+		return version.load() == expected;
+	}
+	bool IsLocked() const {
+		return (version.load() & LOCKED) != 0;
+	}
+	void WriteLock() {
+		D_ASSERT(!IsLocked());
+		version += LOCKED;
+	}
+	//! Unlock the node, which increments its version
+	void WriteUnlock() {
+		D_ASSERT(IsLocked());
+		version += LOCKED;
+	}
+	void MarkObsolete() {
+		version |= OBSOLETE;
+	}
+
+private:
+	static constexpr uint64_t OBSOLETE = 1;
+	static constexpr uint64_t LOCKED = 2;
+
+	std::atomic<uint64_t> version;
+};
+
+//! Holds the write lock of a node version while the node is modified. A writer that already holds the lock of the
+//! node (e.g. a node that loads its child from disk while an entry is erased from it) keeps holding it.
+class NodeWriteLock {
+public:
+	explicit NodeWriteLock(NodeVersion &version) : version(version), owns_lock(!version.IsLocked()) {
+		if (owns_lock) {
+			version.WriteLock();
+		}
+	}
+	~NodeWriteLock() {
+		if (owns_lock) {
+			version.WriteUnlock();
+		}
+	}
+
+private:
+	NodeVersion &version;
+	bool owns_lock;
+};
 
 class Node {
 public:
@@ -33,6 +97,10 @@ public:
 	NodeType type;
 	//! compressed path (prefix)
 	unique_ptr<uint8_t[]> prefix;
+	//! version of the node for lookups that do not hold the index lock
+	NodeVersion version;
+	//! The location of the node on disk. Invalid if the node was not written yet, or changed since it was written.
+	BlockPointer pointer;
 
 public:
 	//! Get the position of a child corresponding exactly to the specific byte, returns INVALID_INDEX if not exists
@@ -52,8 +120,18 @@ public:
 		return INVALID_INDEX;
 	}
 	//! Get the child at the specified position in the node. pos should be between [0, count). Throws an assertion if
-	//! the element is not found.
-	virtual unique_ptr<Node> *GetChild(idx_t pos);
+	//! the element is not found. A child that is still on disk is loaded first.
+	unique_ptr<Node> *GetChild(ART &art, idx_t pos);
+	//! Get the child at the specified position in the node without loading it from disk
+	virtual unique_ptr<Node> *GetChildSlot(idx_t pos);
+	//! Get the key byte of the child at the specified position in the node
+	virtual uint8_t GetKeyByte(idx_t pos);
+	//! Get the child corresponding to the specific byte without loading it from disk, or nullptr if it does not exist.
+	//! Used by lookups that do not hold the index lock: the result is only valid if the version of the node did not
+	//! change while it was read.
+	virtual Node *FindChild(uint8_t k) {
+		return nullptr;
+	}
 
 	//! Compare the key with the prefix of the node, return the number matching bytes
 	static uint32_t PrefixMismatch(ART &art, Node *node, Key &key, uint64_t depth);
@@ -62,9 +140,28 @@ public:
 	//! Erase entry from node
 	static void Erase(ART &art, unique_ptr<Node> &node, idx_t pos);
 
+	//! Write the node and the children that changed since they were last written to disk, children first, and return
+	//! a pointer to the node. Children that did not change keep their location on disk.
+	BlockPointer Serialize(ART &art, MetaBlockWriter &writer);
+	//! Read the node at the given pointer, its children are read lazily when they are first accessed
+	static unique_ptr<Node> Deserialize(ART &art, BlockPointer pointer);
+	//! Replace the children that did not change since they were read or written by references to their location on
+	//! disk, which frees their memory
+	void Unload(ART &art);
+
 protected:
 	//! Copies the prefix from the source to the destination node
 	static void CopyPrefix(ART &art, Node *src, Node *dst);
+	//! Replaces the node with the new node, the replaced node is freed once no lookup can still be reading it
+	static void Replace(ART &art, unique_ptr<Node> &node, unique_ptr<Node> new_node);
+	//! Replaces the child by the node it points to on disk if it has not been loaded yet
+	void Load(ART &art, unique_ptr<Node> &child);
+};
+
+//! A child that has been written to disk but not been loaded yet
+class PersistentNode : public Node {
+public:
+	PersistentNode(ART &art, BlockPointer pointer);
 };
 
 } // namespace duckdb
@@ -27,7 +27,11 @@ public:
 	//! Get the next position in the node, or INVALID_INDEX if there is no next position
 	idx_t GetNextPos(idx_t pos) override;
 	//! Get Node16 Child
-	unique_ptr<Node> *GetChild(idx_t pos) override;
+	unique_ptr<Node> *GetChildSlot(idx_t pos) override;
+	//! Get the key byte of the Node16 child at the given position
+	uint8_t GetKeyByte(idx_t pos) override;
+	//! Get the Node16 child of the given byte without loading it from disk
+	Node *FindChild(uint8_t k) override;
 
 	idx_t GetMin() override;
 
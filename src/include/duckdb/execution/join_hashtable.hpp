@@ -117,6 +117,12 @@ private:
 
 	idx_t AppendToBlock(HTDataBlock &block, BufferHandle &handle, vector<BlockAppendEntry> &append_entries,
 	                    idx_t remaining);
+	//! Allocate space for a single entry in the HT, used when partitioning the HT
+	data_ptr_t AllocateEntry(unique_ptr<BufferHandle> &handle);
+	//! Copy the data of a string into the string blocks of a partition, returning the location of the string
+	uint64_t AllocateString(string_t string, unique_ptr<BufferHandle> &handle);
+	//! Point the strings of an entry of a partition to their data in the pinned string blocks
+	void LoadStrings(data_ptr_t entry);
 
 	void Hash(DataChunk &keys, const SelectionVector &sel, idx_t count, Vector &hashes);
 
@@ -130,17 +136,51 @@ public:
 	//! Finalize the build of the HT, constructing the actual hash table and making the HT ready for probing. Finalize
 	//! must be called before any call to Probe, and after Finalize is called Build should no longer be ever called.
 	void Finalize();
+	//! Allocate the (empty) pointer table of the HT; afterwards Finalize must be called for every block of the HT
+	void InitializePointerTable();
+	//! Insert the entries of the blocks [block_idx_start, block_idx_end) into the pointer table. If parallel is set,
+	//! the pointer table is updated atomically so that multiple threads can insert disjoint ranges of blocks.
+	void Finalize(idx_t block_idx_start, idx_t block_idx_end, bool parallel);
+	//! Move the data of a thread-local HT into this HT (before finalizing)
+	void Merge(JoinHashTable &other);
 	//! Probe the HT with the given input chunk, resulting in the given result
 	unique_ptr<ScanStructure> Probe(DataChunk &keys);
 	//! Scan the HT to construct the final full outer join result after
 	void ScanFullOuter(DataChunk &result, JoinHTScanState &state);
 
+	//! The amount of memory required to keep the finalized HT in memory
+	idx_t SizeInBytes();
+	//! Radix-partition the (not yet finalized) HT into 2^radix_bits partitions, instead of finalizing it. Every
+	//! partition is a separate HT that can be pinned (finalized) and unpinned independently, which allows a build side
+	//! that does not fit in memory to be probed partition-by-partition. Unpinned partitions are written to the
+	//! temporary directory by the buffer manager when memory runs low.
+	void Partition(idx_t radix_bits);
+	bool IsPartitioned() {
+		return !partitions.empty();
+	}
+	idx_t PartitionCount() {
+		return partitions.size();
+	}
+	//! Compute the partition index of every row of the given keys (partitioned HT only)
+	void GetPartitionIndices(DataChunk &keys, idx_t partition_indices[]);
+	//! Pin the given partition for probing, finalizing the partition if it is not in memory yet
+	JoinHashTable &PinPartition(idx_t partition_idx);
+	//! Unpin the given partition, the partition is unloaded when it is no longer pinned by any thread
+	void UnpinPartition(idx_t partition_idx);
+	//! Construct the result of probing an empty partition of a (non-empty) partitioned HT
+	void ProbeEmptyPartition(DataChunk &keys, DataChunk &input, DataChunk &result);
+
 	idx_t size() {
 		return count;
 	}
+	idx_t BlockCount() {
+		return blocks.size();
+	}
 
 	//! The stringheap of the JoinHashTable
 	StringHeap string_heap;
+	//! The amount of string data stored in the string heap
+	idx_t string_heap_size;
 	//! BufferManager
 	BufferManager &buffer_manager;
 	//! The types of the keys used in equality comparison
@@ -163,6 +203,15 @@ public:
 	idx_t tuple_size;
 	//! Next pointer offset in tuple
 	idx_t pointer_offset;
+	//! Hash offset in tuple; this is equal to the pointer offset except in partitions, which keep the hash around so
+	//! they can be finalized again after they have been unloaded
+	idx_t hash_offset;
+	//! The offsets of the VARCHAR keys and payload columns in a tuple
+	vector<idx_t> string_offsets;
+	//! The offset of the string locations in an entry of a partition (INVALID_INDEX if this is not a partition):
+	//! partitions store the string data of their entries in string_blocks, and the block index and offset of every
+	//! string after the entry, so that the strings can be found again after the string blocks have been reloaded
+	idx_t string_location_offset;
 	//! The join type of the HT
 	JoinType join_type;
 	//! Whether or not the HT has been finalized
@@ -192,12 +241,19 @@ public:
 	} correlated_mark_join_info;
 
 private:
+	//! Create an empty partition of the given HT
+	explicit JoinHashTable(JoinHashTable *parent);
+
+	static idx_t PointerTableCapacity(idx_t count);
+	//! Release the pointer table and the pinned blocks of a finalized partition
+	void Unload();
+
 	//! Apply a bitmask to the hashes
 	void ApplyBitmask(Vector &hashes, idx_t count);
 	void ApplyBitmask(Vector &hashes, const SelectionVector &sel, idx_t count, Vector &pointers);
 	//! Insert the given set of locations into the HT with the given set of
-	//! hashes. Caller should hold lock in parallel HT.
-	void InsertHashes(Vector &hashes, idx_t count, data_ptr_t key_locations[]);
+	//! hashes. If parallel is set, the pointer table is updated with atomic compare-and-swap operations.
+	void InsertHashes(Vector &hashes, idx_t count, data_ptr_t key_locations[], bool parallel);
 
 	idx_t PrepareKeys(DataChunk &keys, unique_ptr<VectorData[]> &key_data, const SelectionVector *&current_sel,
 	                  SelectionVector &sel, bool build_side);
@@ -211,11 +267,25 @@ private:
 	vector<HTDataBlock> blocks;
 	//! Pinned handles, these are pinned during finalization only
 	vector<unique_ptr<BufferHandle>> pinned_handles;
+	//! The blocks holding the string data of a partition, and the amount of bytes used in the last block
+	vector<shared_ptr<BlockHandle>> string_blocks;
+	idx_t string_block_used;
+	//! The pinned string blocks of a finalized partition
+	vector<unique_ptr<BufferHandle>> pinned_string_handles;
 	//! The hash map of the HT, created after finalization
 	unique_ptr<BufferHandle> hash_map;
 	//! Whether or not NULL values are considered equal in each of the comparisons
 	vector<bool> null_values_are_equal;
 
+	//! The amount of radix bits used to partition the HT (if partitioned)
+	idx_t radix_bits;
+	//! The partitions of the HT (if partitioned)
+	vector<unique_ptr<JoinHashTable>> partitions;
+	//! The amount of threads that have pinned each partition
+	vector<idx_t> partition_pins;
+	//! The lock for pinning and unpinning partitions
+	std::mutex partition_lock;
+
 	//! Copying not allowed
 	JoinHashTable(const JoinHashTable &) = delete;
 };
@@ -13,7 +13,12 @@
 
 namespace duckdb {
 
-//! PhysicalWindow implements window functions
+//! PhysicalWindow implements window functions. If all window expressions share the same PARTITION BY keys and the
+//! collected input turns out to be large, the input is hash partitioned on these keys while it is collected, and every
+//! partition is sorted and evaluated as a separate parallel task. The partitions are kept in buffer-managed blocks, so
+//! they can be evicted to disk until they are evaluated and read. A partition is evaluated in memory, so all rows of a
+//! single PARTITION BY value have to fit in memory, and a skewed or low-cardinality PARTITION BY gives little
+//! parallelism.
 class PhysicalWindow : public PhysicalSink {
 public:
 	PhysicalWindow(vector<LogicalType> types, vector<unique_ptr<Expression>> select_list, idx_t estimated_cardinality,
@@ -32,6 +37,9 @@ public:
 
 	string ParamsToString() const override;
 
+	//! Whether or not the input can be hash partitioned on the PARTITION BY keys and evaluated in parallel
+	bool CanPartition();
+
 public:
 	//! The projection list of the WINDOW statement (may contain aggregates)
 	vector<unique_ptr<Expression>> select_list;
@@ -15,8 +15,10 @@
 #include "duckdb/planner/operator/logical_join.hpp"
 
 namespace duckdb {
+class PhysicalHashJoinState;
 
-//! PhysicalHashJoin represents a hash loop join between two tables
+//! PhysicalHashJoin represents a hash loop join between two tables. If the build side does not fit in memory, the HT
+//! is radix-partitioned and the join is evaluated partition-by-partition (see JoinHashTable::Partition)
 class PhysicalHashJoin : public PhysicalComparisonJoin {
 public:
 	PhysicalHashJoin(LogicalOperator &op, unique_ptr<PhysicalOperator> left, unique_ptr<PhysicalOperator> right,
@@ -39,13 +41,17 @@ public:
 
 	unique_ptr<LocalSinkState> GetLocalSinkState(ExecutionContext &context) override;
 	void Sink(ExecutionContext &context, GlobalOperatorState &state, LocalSinkState &lstate, DataChunk &input) override;
+	void Combine(ExecutionContext &context, GlobalOperatorState &gstate, LocalSinkState &lstate) override;
 	void Finalize(Pipeline &pipeline, ClientContext &context, unique_ptr<GlobalOperatorState> gstate) override;
 
 	void GetChunkInternal(ExecutionContext &context, DataChunk &chunk, PhysicalOperatorState *state) override;
 	unique_ptr<PhysicalOperatorState> GetOperatorState() override;
 
 private:
+	//! Whether or not the HT can be partitioned if it does not fit in memory
+	bool CanPartition();
 	void ProbeHashTable(ExecutionContext &context, DataChunk &chunk, PhysicalOperatorState *state_p);
+	void ProbePartitionedHashTable(ExecutionContext &context, DataChunk &chunk, PhysicalHashJoinState &state);
 };
 
 } // namespace duckdb
@@ -0,0 +1,158 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// duckdb/execution/operator/order/sorted_run.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/common/common.hpp"
+#include "duckdb/common/enums/order_type.hpp"
+#include "duckdb/common/serializer/buffered_serializer.hpp"
+#include "duckdb/common/types/data_chunk.hpp"
+#include "duckdb/storage/buffer_manager.hpp"
+
+namespace duckdb {
+
+//! The SortRowFormat converts rows into the binary row format used by the external sort. Every row is stored as
+//! [uint32 row_size][uint32 key_size][key][payload]. The key is a normalized binary sort key: comparing the keys of two
+//! rows with memcmp gives the order of the rows, so no type-specific comparisons are required while sorting or merging.
+//! The payload holds the values of all the columns that are returned by the sort.
+class SortRowFormat {
+public:
+	SortRowFormat(vector<OrderType> order_types, vector<OrderByNullType> null_orders, vector<LogicalType> payload_types);
+
+	vector<OrderType> order_types;
+	vector<OrderByNullType> null_orders;
+	vector<LogicalType> payload_types;
+
+public:
+	//! Whether or not the row format supports sorting on a key of the given type
+	static bool SupportsKeyType(const LogicalType &type);
+	//! Whether or not the row format supports storing a payload of the given type
+	static bool SupportsPayloadType(const LogicalType &type);
+
+	//! Encode the rows of the (key, payload) chunks and append them to the buffer, storing the offset of every row
+	void EncodeRows(DataChunk &keys, DataChunk &payload, BufferedSerializer &buffer, vector<idx_t> &row_offsets);
+	//! Decode the payload of a row into the given row of the result chunk
+	void DecodeRow(const_data_ptr_t row, DataChunk &result, idx_t result_idx);
+
+	static inline uint32_t RowSize(const_data_ptr_t row) {
+		return Load<uint32_t>(row);
+	}
+	//! Compare the sort keys of two encoded rows
+	static inline int CompareRows(const_data_ptr_t left, const_data_ptr_t right) {
+		auto left_size = Load<uint32_t>(left + sizeof(uint32_t));
+		auto right_size = Load<uint32_t>(right + sizeof(uint32_t));
+		auto result = memcmp(left + 2 * sizeof(uint32_t), right + 2 * sizeof(uint32_t), MinValue(left_size, right_size));
+		if (result != 0) {
+			return result;
+		}
+		return left_size < right_size ? -1 : (left_size == right_size ? 0 : 1);
+	}
+};
+
+//! A BufferedSerializer for the encoded rows that are buffered before they are sorted into a sorted run. The buffer is
+//! allocated through the buffer manager (when the first row is written), so the buffered rows count towards the memory
+//! limit. The buffer grows by allocating a bigger buffer and copying the rows.
+class SortedRunBuffer : public BufferedSerializer {
+public:
+	SortedRunBuffer(BufferManager &buffer_manager, idx_t capacity);
+
+	void WriteData(const_data_ptr_t buffer, idx_t write_size) override;
+	//! Clears the buffer and releases its memory
+	void Release();
+
+private:
+	BufferManager &buffer_manager;
+	//! The pinned buffer, or nullptr if nothing has been written yet
+	unique_ptr<BufferHandle> handle;
+};
+
+//! A block of a sorted run
+struct SortedRunBlock {
+	shared_ptr<BlockHandle> block;
+	//! The amount of rows stored in the block
+	idx_t count;
+	//! The header and sort key of the first row of the block, kept in memory so that a merge can find the block that
+	//! contains a key without reading the run
+	vector<data_t> first_key;
+};
+
+//! A SortedRun is a sequence of encoded rows in sorted order. The rows are stored in blocks that are managed by the
+//! buffer manager, which means that unpinned blocks are written to the temporary directory under memory pressure.
+struct SortedRun {
+	SortedRun() : count(0) {
+	}
+
+	vector<SortedRunBlock> blocks;
+	//! The total amount of rows in the run
+	idx_t count;
+};
+
+//! Appends encoded rows to a sorted run
+class SortedRunWriter {
+public:
+	SortedRunWriter(BufferManager &buffer_manager, SortedRun &run);
+
+	//! Append an encoded row to the run
+	void Append(const_data_ptr_t row);
+	//! Flush the final block of the run
+	void Finalize();
+
+private:
+	BufferManager &buffer_manager;
+	SortedRun &run;
+	//! The currently pinned block
+	unique_ptr<BufferHandle> handle;
+	//! The offset within the current block
+	idx_t offset;
+};
+
+//! Reads the encoded rows of a sorted run in order, keeping only a single block of the run pinned at a time
+class SortedRunReader {
+public:
+	//! If destroy_after_read is set, the blocks of the run are released once they have been read
+	SortedRunReader(BufferManager &buffer_manager, SortedRun &run, bool destroy_after_read, idx_t block_idx = 0);
+
+	bool Done() {
+		return block_idx >= run.blocks.size();
+	}
+	//! Returns a pointer to the current row
+	const_data_ptr_t Current() {
+		D_ASSERT(!Done());
+		return handle->node->buffer + offset;
+	}
+	//! Move to the next row
+	void Advance();
+
+private:
+	void PinBlock();
+
+private:
+	BufferManager &buffer_manager;
+	SortedRun &run;
+	bool destroy_after_read;
+	unique_ptr<BufferHandle> handle;
+	idx_t block_idx;
+	idx_t row_idx;
+	idx_t offset;
+};
+
+//! Sort the encoded rows that are stored in the buffer and write them to a new sorted run
+unique_ptr<SortedRun> CreateSortedRun(BufferManager &buffer_manager, BufferedSerializer &buffer,
+                                      vector<idx_t> &row_offsets);
+//! Merge the sorted runs into a single sorted run with a k-way merge, the blocks of the input runs are released while
+//! merging
+unique_ptr<SortedRun> MergeSortedRuns(BufferManager &buffer_manager, vector<unique_ptr<SortedRun>> &runs);
+//! Select up to (partition_count - 1) sort keys that split the rows of the runs into partitions of roughly equal size.
+//! The keys are taken from the first rows of the blocks of the runs.
+vector<vector<data_t>> SelectMergeSplitters(vector<unique_ptr<SortedRun>> &runs, idx_t partition_count);
+//! Merge the rows of the sorted runs with a sort key in the range (lower, upper] into a single sorted run; an empty
+//! bound is unbounded. The input runs are not modified, so the partitions of a merge can be merged in parallel.
+unique_ptr<SortedRun> MergeSortedRunRange(BufferManager &buffer_manager, vector<unique_ptr<SortedRun>> &runs,
+                                          const vector<data_t> &lower, const vector<data_t> &upper);
+
+} // namespace duckdb
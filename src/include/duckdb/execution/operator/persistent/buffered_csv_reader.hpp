@@ -91,6 +91,9 @@ struct BufferedCSVReaderOptions {
 	std::map<LogicalTypeId, StrpTimeFormat> date_format = {{LogicalTypeId::DATE, {}}, {LogicalTypeId::TIMESTAMP, {}}};
 	//! Whether or not a type format is specified
 	std::map<LogicalTypeId, bool> has_format = {{LogicalTypeId::DATE, false}, {LogicalTypeId::TIMESTAMP, false}};
+	//! Whether or not large files may be split into byte ranges that are parsed in parallel. The rows of a file that is
+	//! read in parallel are not returned in the order in which they appear in the file, so this is off by default.
+	bool parallel = false;
 
 	std::string toString() const {
 		return "DELIMITER='" + delimiter + (has_delimiter ? "'" : (auto_detect ? "' (auto detected)" : "' (default)")) +
@@ -144,6 +147,16 @@ public:
 	idx_t buffer_size;
 	idx_t position;
 	idx_t start = 0;
+	//! The offset in the file of the first byte of the buffer (only tracked for plain file sources)
+	idx_t buffer_offset = 0;
+
+	//! The end of the byte range of the file that is read by this reader (if any): rows that start at or after this
+	//! offset are read by the reader of the next range
+	idx_t range_end = INVALID_INDEX;
+	//! The offset of the first row that is read by this reader
+	idx_t range_row_start = 0;
+	//! The offset of the first row after the range, set once the reader has finished reading its byte range
+	idx_t range_row_end = INVALID_INDEX;
 
 	idx_t linenr = 0;
 	bool linenr_estimated = false;
@@ -168,6 +181,14 @@ public:
 public:
 	//! Extract a single DataChunk from the CSV file and stores it in insert_chunk
 	void ParseCSV(DataChunk &insert_chunk);
+	//! Whether or not the reader can be restricted to a byte range of the file using SetRange
+	bool SupportsRanges();
+	//! Restrict the reader to the rows that start within the byte range [range_start, range_end) of the file. If the
+	//! range does not start at the beginning of the file, the reader skips ahead to the first row that starts after a
+	//! newline. Note that this newline might be part of a quoted value, which is why readers of consecutive ranges
+	//! have to verify that range_row_end of the one matches range_row_start of the other. If range_start is known to
+	//! be the start of a row (starts_row), the reader starts reading there without skipping ahead.
+	void SetRange(idx_t range_start, idx_t range_end, bool starts_row = false);
 
 private:
 	//! Initialize Parser
@@ -212,6 +233,8 @@ private:
 	void Flush(DataChunk &insert_chunk);
 	//! Reads a new buffer from the CSV file if the current one has been exhausted
 	bool ReadBuffer(idx_t &start);
+	//! Marks the byte range of the reader (if any) as finished at the current position
+	void FinishRange();
 
 	unique_ptr<std::istream> OpenCSV(ClientContext &context, const BufferedCSVReaderOptions &options);
 };
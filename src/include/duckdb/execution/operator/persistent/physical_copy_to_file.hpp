@@ -13,18 +13,35 @@
 #include "duckdb/function/copy_function.hpp"
 
 namespace duckdb {
+class CopyToFunctionGlobalState;
+class CopyToFunctionLocalState;
+struct CopyToPartitionLocalState;
+struct CopyToPartitionWriter;
 
-//! Copy the contents of a query into a table
+//! Copy the contents of a query into a file, or into a directory of hive partitioned files
 class PhysicalCopyToFile : public PhysicalSink {
 public:
 	PhysicalCopyToFile(vector<LogicalType> types, CopyFunction function, unique_ptr<FunctionData> bind_data,
-	                   idx_t estimated_cardinality)
+	                   string file_path, idx_t estimated_cardinality)
 	    : PhysicalSink(PhysicalOperatorType::COPY_TO_FILE, move(types), estimated_cardinality), function(function),
-	      bind_data(move(bind_data)) {
+	      bind_data(move(bind_data)), file_path(move(file_path)), max_open_files(0) {
 	}
 
 	CopyFunction function;
 	unique_ptr<FunctionData> bind_data;
+	string file_path;
+	//! The names of the columns of the input
+	vector<string> names;
+	//! The columns of the input that the written files are partitioned by
+	vector<idx_t> partition_columns;
+	//! The columns of the input that are written to the partition files
+	vector<idx_t> write_columns;
+	//! The maximum amount of partition files that are kept open (by all threads), files that are closed are continued
+	//! in a new file
+	idx_t max_open_files;
+
+	//! The directory that NULL partition values are written to, as used by Hive
+	static constexpr const char *HIVE_DEFAULT_PARTITION = "__HIVE_DEFAULT_PARTITION__";
 
 public:
 	void GetChunkInternal(ExecutionContext &context, DataChunk &chunk, PhysicalOperatorState *state) override;
@@ -35,5 +52,20 @@ public:
 	void Finalize(Pipeline &pipeline, ClientContext &context, unique_ptr<GlobalOperatorState> gstate) override;
 	unique_ptr<LocalSinkState> GetLocalSinkState(ExecutionContext &context) override;
 	unique_ptr<GlobalOperatorState> GetGlobalState(ClientContext &context) override;
+
+private:
+	void SinkPartitions(ExecutionContext &context, CopyToFunctionGlobalState &gstate,
+	                    CopyToFunctionLocalState &lstate, DataChunk &input);
+	CopyToPartitionLocalState &GetPartition(ExecutionContext &context, CopyToFunctionGlobalState &gstate,
+	                                        CopyToFunctionLocalState &lstate, DataChunk &input, idx_t row_idx);
+	void ReleasePartition(ClientContext &context, CopyToFunctionGlobalState &gstate,
+	                      CopyToPartitionLocalState &partition);
+	void ReleaseLeastRecentlyUsed(ClientContext &context, CopyToFunctionGlobalState &gstate,
+	                              CopyToFunctionLocalState &lstate);
+	//! Remove the files that no thread is attached to from the open files, must be called while holding the lock
+	vector<unique_ptr<CopyToPartitionWriter>> TakeIdleWriters(CopyToFunctionGlobalState &gstate);
+	//! Finalize the files that were removed by TakeIdleWriters, must be called without holding the lock
+	void CloseWriters(ClientContext &context, CopyToFunctionGlobalState &gstate,
+	                  vector<unique_ptr<CopyToPartitionWriter>> &writers);
 };
 } // namespace duckdb
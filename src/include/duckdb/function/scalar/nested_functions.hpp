@@ -12,6 +12,7 @@
 #include "duckdb/function/function_set.hpp"
 
 namespace duckdb {
+class BoundColumnRefExpression;
 
 struct VariableReturnBindData : public FunctionData {
 	LogicalType stype;
@@ -36,8 +37,31 @@ struct ListExtractFun {
 	static void RegisterFunction(BuiltinFunctions &set);
 };
 
+struct StructExtractBindData : public FunctionData {
+	StructExtractBindData(string key, idx_t index, LogicalType type) : key(move(key)), index(index), type(move(type)) {
+	}
+
+	string key;
+	idx_t index;
+	LogicalType type;
+
+public:
+	unique_ptr<FunctionData> Copy() override {
+		return make_unique<StructExtractBindData>(key, index, type);
+	}
+	bool Equals(FunctionData &other_p) override {
+		auto &other = (StructExtractBindData &)other_p;
+		return key == other.key && index == other.index && type == other.type;
+	}
+};
+
 struct StructExtractFun {
 	static void RegisterFunction(BuiltinFunctions &set);
+
+	//! If the expression extracts a (nested) field of a column, e.g. struct_extract(struct_extract(col, 'a'), 'b'),
+	//! returns the column reference and sets the child path to the indexes of the extracted fields (from the outermost
+	//! struct inwards). Returns nullptr otherwise.
+	static BoundColumnRefExpression *GetFieldPath(Expression &expr, vector<idx_t> &child_path);
 };
 
 } // namespace duckdb
@@ -24,6 +24,10 @@ struct PragmaTableInfo {
 	static void RegisterFunction(BuiltinFunctions &set);
 };
 
+struct PragmaStorageInfo {
+	static void RegisterFunction(BuiltinFunctions &set);
+};
+
 struct SQLiteMaster {
 	static void RegisterFunction(BuiltinFunctions &set);
 };
@@ -40,4 +44,12 @@ struct PragmaDatabaseSize {
 	static void RegisterFunction(BuiltinFunctions &set);
 };
 
+struct PragmaBufferStatistics {
+	static void RegisterFunction(BuiltinFunctions &set);
+};
+
+struct PragmaSchedulerStatistics {
+	static void RegisterFunction(BuiltinFunctions &set);
+};
+
 } // namespace duckdb
@@ -60,6 +60,9 @@ typedef unique_ptr<NodeStatistics> (*table_function_cardinality_t)(ClientContext
 typedef void (*table_function_pushdown_complex_filter_t)(ClientContext &context, LogicalGet &get,
                                                          FunctionData *bind_data,
                                                          vector<unique_ptr<Expression>> &filters);
+typedef void (*table_function_pushdown_struct_projection_t)(ClientContext &context, LogicalGet &get,
+                                                            FunctionData *bind_data, column_t column_id,
+                                                            const vector<vector<idx_t>> &child_paths);
 typedef string (*table_function_to_string_t)(const FunctionData *bind_data);
 
 class TableFunction : public SimpleNamedParameterFunction {
@@ -123,6 +126,10 @@ public:
 	//! (Optional) pushdown a set of arbitrary filter expressions, rather than only simple comparisons with a constant
 	//! Any functions remaining in the expression list will be pushed as a regular filter after the scan
 	table_function_pushdown_complex_filter_t pushdown_complex_filter;
+	//! (Optional) pushdown the fields of a STRUCT column that are referenced, for columns that are only referenced
+	//! through struct_extract. Every child path holds the indexes of an extracted (nested) field. The fields that are
+	//! not referenced do not need to be read and can be emitted as NULL.
+	table_function_pushdown_struct_projection_t pushdown_struct_projection = nullptr;
 	//! (Optional) function for rendering the operator to a string in profiling output
 	table_function_to_string_t to_string;
 	//! (Optional) function that returns the maximum amount of threads that can work on this task
@@ -74,9 +74,18 @@ public:
 	bool force_parallelism = false;
 	//! Force index join independent of table cardinality, used for testing
 	bool force_index_join = false;
+	//! Bulk load indexes in parallel in CREATE INDEX, instead of inserting the rows of the table one at a time
+	bool parallel_index_creation = true;
 	//! Maximum bits allowed for using a perfect hash table (i.e. the perfect HT can hold up to 2^perfect_ht_threshold
 	//! elements)
 	idx_t perfect_ht_threshold = 12;
+	//! The scheduling weight of the queries of this connection, relative to the queries of other connections
+	idx_t query_priority = TaskGroup::NORMAL_PRIORITY_WEIGHT;
+	//! The maximum amount of threads that execute a single query of this connection, including the thread of the
+	//! connection itself (0: no limit)
+	idx_t query_threads = 0;
+	//! The maximum amount of memory that the temporary buffers of a single query of this connection can occupy
+	idx_t query_memory_limit = INVALID_INDEX;
 	//! The writer used to log queries (if logging is enabled)
 	unique_ptr<BufferedFileWriter> log_query_writer;
 	//! The explain output type used when none is specified (default: PHYSICAL_ONLY)
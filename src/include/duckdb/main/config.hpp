@@ -9,6 +9,7 @@
 #pragma once
 
 #include "duckdb/common/common.hpp"
+#include "duckdb/common/enums/compression_type.hpp"
 #include "duckdb/common/enums/order_type.hpp"
 #include "duckdb/common/file_system.hpp"
 #include "duckdb/common/winapi.hpp"
@@ -55,16 +56,26 @@ public:
 	bool object_cache_enable = false;
 	//! Database configuration variables as controlled by SET
 	unordered_map<std::string, Value> set_variables;
+	//! Incremented whenever set_variables is changed, so components that derive their configuration from the
+	//! variables only have to parse them again when they have changed
+	idx_t set_variables_version = 0;
 	//! Force checkpoint when CHECKPOINT is called or on shutdown, even if no changes have been made
 	bool force_checkpoint = false;
 	//! Run a checkpoint on successful shutdown and delete the WAL, to leave only a single database file behind
 	bool checkpoint_on_shutdown = true;
 	//! Debug flag that decides when a checkpoing should be aborted. Only used for testing purposes.
 	CheckpointAbort checkpoint_abort = CheckpointAbort::NO_ABORT;
+	//! Force a specific compression type to be used when checkpointing (default: automatically pick the best one)
+	CompressionType force_compression = CompressionType::COMPRESSION_AUTO;
+	//! The amount of blocks that sequential table scans read ahead in the background (default: 0, no read-ahead)
+	idx_t prefetch_blocks = 0;
 
 public:
 	DUCKDB_API static DBConfig &GetConfig(ClientContext &context);
 	DUCKDB_API static DBConfig &GetConfig(DatabaseInstance &db);
+	//! Returns the NULL order of a key with the given order type for which no NULL order is specified. The default
+	//! NULL order applies to ascending keys, descending keys place the NULLs at the other end.
+	DUCKDB_API OrderByNullType GetDefaultNullOrder(OrderType type) const;
 };
 
 } // namespace duckdb
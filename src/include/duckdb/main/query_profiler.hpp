@@ -27,8 +27,11 @@ class SQLStatement;
 struct OperatorTimingInformation {
 	double time = 0;
 	idx_t elements = 0;
+	//! The part of the time that was spent waiting for blocks to be read (in seconds)
+	double io_wait = 0;
 
-	explicit OperatorTimingInformation(double time_ = 0, idx_t elements_ = 0) : time(time_), elements(elements_) {
+	explicit OperatorTimingInformation(double time_ = 0, idx_t elements_ = 0, double io_wait_ = 0)
+	    : time(time_), elements(elements_), io_wait(io_wait_) {
 	}
 };
 
@@ -43,12 +46,16 @@ public:
 	DUCKDB_API void EndOperator(DataChunk *chunk);
 
 private:
-	void AddTiming(PhysicalOperator *op, double time, idx_t elements);
+	void AddTiming(PhysicalOperator *op, double time, idx_t elements, double io_wait);
+	//! Returns the read wait time of this thread since the last call (in seconds)
+	double ElapsedReadWaitTime();
 
 	//! Whether or not the profiler is enabled
 	bool enabled;
 	//! The timer used to time the execution time of the individual Physical Operators
 	Profiler op;
+	//! The read wait time of this thread when the timer was last started (in microseconds)
+	idx_t read_wait_start = 0;
 	//! The stack of Physical Operators that are currently active
 	std::stack<PhysicalOperator *> execution_stack;
 	//! A mapping of physical operators to recorded timings
@@ -126,6 +133,8 @@ private:
 
 	//! The timer used to time the execution time of the entire query
 	Profiler main_query;
+	//! The time that the operators of the query spent waiting for blocks to be read (in seconds)
+	double io_wait_time = 0;
 	//! A map of a Physical Operator pointer to a tree node
 	unordered_map<PhysicalOperator *, TreeNode *> tree_map;
 
@@ -16,6 +16,7 @@ namespace duckdb {
 class Binder;
 class BoundColumnRefExpression;
 class ClientContext;
+class LogicalGet;
 
 //! The RemoveUnusedColumns optimizer traverses the logical operator tree and removes any columns that are not required
 class RemoveUnusedColumns : public LogicalOperatorVisitor {
@@ -25,6 +26,7 @@ public:
 	}
 
 	void VisitOperator(LogicalOperator &op) override;
+	void VisitExpression(unique_ptr<Expression> *expression) override;
 
 protected:
 	unique_ptr<Expression> VisitReplace(BoundColumnRefExpression &expr, unique_ptr<Expression> *expr_ptr) override;
@@ -38,6 +40,9 @@ private:
 	bool everything_referenced;
 	//! The map of column references
 	column_binding_map_t<vector<BoundColumnRefExpression *>> column_references;
+	//! The struct fields that are extracted from the column references, a column reference that is not wrapped in a
+	//! struct_extract has no entry here
+	column_binding_map_t<vector<vector<idx_t>>> struct_references;
 
 private:
 	template <class T>
@@ -46,5 +51,7 @@ private:
 	//! Perform a replacement of the ColumnBinding, iterating over all the currently found column references and
 	//! replacing the bindings
 	void ReplaceBinding(ColumnBinding current_binding, ColumnBinding new_binding);
+	//! Push the referenced fields of the STRUCT columns that are only referenced through struct_extract into the scan
+	void PushdownStructProjection(LogicalGet &get);
 };
 } // namespace duckdb
@@ -13,6 +13,8 @@
 #include "duckdb/common/vector.hpp"
 #include "duckdb/parallel/task.hpp"
 
+#include <atomic>
+
 namespace duckdb {
 
 struct ConcurrentQueue;
@@ -21,18 +23,86 @@ class ClientContext;
 class TaskScheduler;
 
 struct SchedulerThread;
+struct WorkerQueue;
+struct MemoryBudget;
+struct ProducerToken;
+
+//! A TaskGroup holds the scheduling state of the tasks of a single producer (i.e. of a single query). Idle workers
+//! take tasks from the shared queue of the group that has executed the fewest tasks relative to its weight, so a
+//! long-running query does not starve the queries that are started after it. All state that is read when picking a
+//! group is atomic, so workers pick a group without taking a lock.
+struct TaskGroup {
+	static constexpr idx_t LOW_PRIORITY_WEIGHT = 1;
+	static constexpr idx_t NORMAL_PRIORITY_WEIGHT = 4;
+	static constexpr idx_t HIGH_PRIORITY_WEIGHT = 16;
+
+	explicit TaskGroup(unique_ptr<QueueProducerToken> token);
+	~TaskGroup();
+
+	//! The token of the sub-queue of the group in the shared queue. The group owns the token, so workers that hold a
+	//! reference to the group can dequeue from it after the producer has been destroyed.
+	unique_ptr<QueueProducerToken> token;
+	//! Serializes enqueueing through the token (dequeueing does not require the lock)
+	std::mutex enqueue_lock;
+	//! The scheduling weight of the group: groups get a share of the worker threads proportional to their weight
+	std::atomic<idx_t> weight;
+	//! The maximum amount of worker threads that execute tasks of the group at the same time (INVALID_INDEX: no limit)
+	std::atomic<idx_t> max_threads;
+	//! The memory budget that the buffers allocated by the tasks of the group are charged to (if any)
+	shared_ptr<MemoryBudget> memory_budget;
+	//! The amount of tasks of the group in the shared queue
+	std::atomic<idx_t> pending_tasks;
+	//! The amount of tasks of the group that are being executed by worker threads
+	std::atomic<idx_t> active_tasks;
+	//! The amount of tasks of the group that have been executed by worker threads
+	std::atomic<idx_t> executed_tasks;
+
+public:
+	//! Whether or not another worker thread can execute a task of the group
+	bool CanExecute() {
+		return active_tasks < max_threads;
+	}
+	//! Reserve a slot for a worker thread to execute a task of the group, returns false if the group already has
+	//! max_threads active tasks. The slot is released by decrementing active_tasks.
+	bool TryStartTask() {
+		auto active = active_tasks.load();
+		do {
+			if (active >= max_threads) {
+				return false;
+			}
+		} while (!active_tasks.compare_exchange_weak(active, active + 1));
+		return true;
+	}
+};
+
+//! Counters of the task scheduler
+struct TaskSchedulerStatistics {
+	//! The amount of tasks that were executed by the worker threads
+	idx_t tasks_executed;
+	//! The amount of tasks that were taken from the local queue of another worker
+	idx_t steals;
+	//! The total time (in seconds) that worker threads spent waiting for tasks
+	double idle_time;
+	//! The amount of tasks that are currently waiting to be executed
+	idx_t queue_depth;
+};
 
 struct ProducerToken {
 	ProducerToken(TaskScheduler &scheduler, unique_ptr<QueueProducerToken> token);
 	~ProducerToken();
 
 	TaskScheduler &scheduler;
-	unique_ptr<QueueProducerToken> token;
-	std::mutex producer_lock;
+	//! The scheduling state and the shared queue token of the tasks of the producer
+	shared_ptr<TaskGroup> group;
 };
 
-//! The TaskScheduler is responsible for managing tasks and threads
+//! The TaskScheduler is responsible for managing tasks and threads. Tasks that are scheduled by a worker thread (e.g.
+//! the tasks that are created when a pipeline finishes) are pushed onto the local queue of that worker, other tasks
+//! are pushed onto the shared queue. Workers execute the tasks in their own queue first, then the tasks in the shared
+//! queue, and finally steal tasks from the queues of the other workers.
 class TaskScheduler {
+	friend struct ProducerToken;
+
 	// timeout for semaphore wait, default 50ms
 	constexpr static int64_t TASK_TIMEOUT_USECS = 50000;
 
@@ -49,6 +119,14 @@ public:
 	bool GetTaskFromProducer(ProducerToken &token, unique_ptr<Task> &task);
 	//! Run tasks forever until "marker" is set to false, "marker" must remain valid until the thread is joined
 	void ExecuteForever(bool *marker);
+	//! Run tasks until "marker" is set to false, worker_idx is the index of the local queue of the worker thread
+	void ExecuteTasks(bool *marker, idx_t worker_idx);
+
+	//! Returns the counters of the task scheduler
+	TaskSchedulerStatistics GetStatistics();
+	//! Sets whether or not the worker threads are pinned to the NUMA nodes of the system (Linux only). Workers are
+	//! divided evenly over the nodes, and memory is allocated on the node of the thread that first touches it.
+	void SetNUMAAffinity(bool enable);
 
 	//! Sets the amount of active threads executing tasks for the system; n-1 background threads will be launched.
 	//! The main thread will also be used for execution
@@ -58,13 +136,39 @@ public:
 
 private:
 	void SetThreadsInternal(int32_t n);
+	//! Fetch the next task for the given worker (INVALID_INDEX if the thread has no local queue)
+	bool GetTask(idx_t worker_idx, unique_ptr<Task> &task, shared_ptr<TaskGroup> &group);
+	//! Fetch a task from the shared queue, picking the group with the fewest executed tasks relative to its weight
+	bool GetTaskFromGroups(unique_ptr<Task> &task, shared_ptr<TaskGroup> &group);
+	//! Reserve a worker slot of the candidate group and dequeue one of its tasks from the shared queue
+	bool DequeueFromGroup(const shared_ptr<TaskGroup> &candidate, unique_ptr<Task> &task, shared_ptr<TaskGroup> &group);
+	//! Steal a task from the local queue of one of the workers. If producer is set, only tasks of that producer are
+	//! stolen.
+	bool StealTask(idx_t worker_idx, ProducerToken *producer, unique_ptr<Task> &task, shared_ptr<TaskGroup> &group);
+	//! Unregister the task group of a producer that is being destroyed
+	void RemoveProducer(ProducerToken &producer);
 
-	//! The task queue
+	//! The shared task queue
 	unique_ptr<ConcurrentQueue> queue;
+	//! The local task queues of the worker threads. The set of queues is replaced (not modified) when the amount of
+	//! threads changes, so threads that are not workers can access it without holding a lock. The queues are shared
+	//! between the sets, so the workers that keep running keep their queue.
+	shared_ptr<vector<shared_ptr<WorkerQueue>>> worker_queues;
 	//! The active background threads of the task scheduler
 	vector<unique_ptr<SchedulerThread>> threads;
 	//! Markers used by the various threads, if the markers are set to "false" the thread execution is stopped
 	vector<unique_ptr<bool>> markers;
+	//! The lock serializing changes to the set of task groups
+	mutex group_lock;
+	//! The task groups of all active producers. Like the worker queues, the set is replaced (not modified) when a
+	//! producer is created or destroyed, so workers read it without holding a lock.
+	shared_ptr<vector<shared_ptr<TaskGroup>>> groups;
+	//! Whether or not the worker threads are pinned to NUMA nodes
+	bool numa_affinity;
+	//! Counters of the task scheduler
+	std::atomic<idx_t> tasks_executed;
+	std::atomic<idx_t> steals;
+	std::atomic<idx_t> idle_time;
 };
 
 } // namespace duckdb
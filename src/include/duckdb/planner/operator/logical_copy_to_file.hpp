@@ -20,6 +20,16 @@ public:
 	}
 	CopyFunction function;
 	unique_ptr<FunctionData> bind_data;
+	//! The file to write to, or the directory to write the partitions to
+	string file_path;
+	//! The names of the columns of the query
+	vector<string> names;
+	//! The columns of the query that the written files are partitioned by, these are not written to the files
+	vector<idx_t> partition_columns;
+	//! The maximum amount of partition files that are open at the same time
+	idx_t max_open_files = DEFAULT_MAX_OPEN_FILES;
+
+	static constexpr idx_t DEFAULT_MAX_OPEN_FILES = 100;
 
 protected:
 	void ResolveTypes() override {
@@ -21,4 +21,15 @@ public:
 	block_id_t id;
 };
 
+//! A pointer to a position within a block on disk
+struct BlockPointer {
+	BlockPointer() : block_id(INVALID_BLOCK), offset(0) {
+	}
+	BlockPointer(block_id_t block_id, uint32_t offset) : block_id(block_id), offset(offset) {
+	}
+
+	block_id_t block_id;
+	uint32_t offset;
+};
+
 } // namespace duckdb
@@ -17,6 +17,7 @@ class BufferHandle;
 class BufferManager;
 class DatabaseInstance;
 class FileBuffer;
+struct MemoryBudget;
 
 enum class BlockState : uint8_t { BLOCK_UNLOADED = 0, BLOCK_LOADED = 1 };
 
@@ -59,6 +60,13 @@ private:
 	bool can_destroy;
 	//! The memory usage of the block
 	idx_t memory_usage;
+	//! The amount of times the block has been pinned and unpinned again, excluding use-once pins. This is kept when
+	//! the block is unloaded, so blocks that are accessed repeatedly are recognized when they are loaded again.
+	idx_t access_count;
+	//! Whether or not the current pin of the block was marked as use-once (see BufferManager::MarkUseOnce)
+	bool use_once;
+	//! The memory budget that the block is charged to while it is loaded (if any)
+	shared_ptr<MemoryBudget> budget;
 };
 
 } // namespace duckdb
@@ -22,13 +22,32 @@
 namespace duckdb {
 class DatabaseInstance;
 struct EvictionQueue;
+struct BufferEvictionNode;
+struct BlockPrefetcher;
+
+//! A MemoryBudget limits the amount of memory that the temporary buffers of a single query can occupy. Buffers are
+//! charged to the budget of the thread that registers them (see BufferManager::SetThreadMemoryBudget).
+struct MemoryBudget {
+	explicit MemoryBudget(idx_t limit);
+	~MemoryBudget();
+
+	//! The maximum amount of memory of the buffers of the budget that can be loaded at the same time
+	idx_t limit;
+	//! The memory of the currently loaded buffers of the budget
+	std::atomic<idx_t> used;
+	//! The eviction queues of the unpinned buffers of the budget. Unpinned buffers are added both to these queues
+	//! and to the queues of the buffer manager, so a query that exceeds its budget evicts its own buffers without
+	//! touching the buffers of other queries.
+	unique_ptr<EvictionQueue> queue;
+};
 
 //! The buffer manager is in charge of handling memory management for the database. It hands out memory buffers that can
 //! be used by the database internally.
 class BufferManager {
 	friend class BufferHandle;
 	friend class BlockHandle;
-	friend class BlockPointer;
+	friend struct BlockPointer;
+	friend struct BlockPrefetcher;
 
 public:
 	BufferManager(DatabaseInstance &db, string temp_directory, idx_t maximum_memory);
@@ -46,11 +65,21 @@ public:
 	//! The allocated memory is released when the buffer handle is destroyed.
 	unique_ptr<BufferHandle> Allocate(idx_t alloc_size);
 
+	//! Pin a block, loading it if it is not loaded. Returns nullptr if the block is an in-memory buffer that can be
+	//! destroyed, and was evicted since it was last unpinned.
 	unique_ptr<BufferHandle> Pin(shared_ptr<BlockHandle> &handle);
 	void Unpin(shared_ptr<BlockHandle> &handle);
+	//! Mark the pinned block as use-once: the pin is not counted as an access of the block, and once unpinned the
+	//! block is evicted before blocks that are accessed repeatedly. Used by large sequential scans, which would
+	//! otherwise flush the frequently used blocks from the buffer pool.
+	void MarkUseOnce(BufferHandle &pin);
 
 	void UnregisterBlock(block_id_t block_id, bool can_destroy);
 
+	//! Read the on-disk block with the given block id in the background, so that a subsequent Pin of the block does not
+	//! have to wait for the read. This is only a hint: blocks that are not registered are ignored.
+	void Prefetch(block_id_t block_id);
+
 	//! Set a new memory limit to the buffer manager, throws an exception if the new limit is too low and not enough
 	//! blocks can be evicted
 	void SetLimit(idx_t limit = (idx_t)-1);
@@ -58,17 +87,51 @@ public:
 	static BufferManager &GetBufferManager(ClientContext &context);
 	static BufferManager &GetBufferManager(DatabaseInstance &db);
 
+	//! Set the memory budget that the buffers registered by the current thread are charged to (nullptr for no budget),
+	//! returns the previous budget of the thread
+	static shared_ptr<MemoryBudget> SetThreadMemoryBudget(shared_ptr<MemoryBudget> budget);
+
 	idx_t GetUsedMemory() {
 		return current_memory;
 	}
 	idx_t GetMaxMemory() {
 		return maximum_memory;
 	}
+	//! Adds time (in microseconds) that a scan on the current thread spent waiting for blocks to be read
+	void AddReadWaitTime(idx_t microseconds);
+	//! Returns the total time (in microseconds) that scans on the current thread have spent waiting for blocks to be
+	//! read; the profiler attributes the difference between two calls to the operator that ran in between
+	static idx_t GetThreadReadWaitTime();
+	//! Returns the total time (in seconds) that scans have spent waiting for blocks to be read
+	double GetReadWaitTime() {
+		return read_wait_time / 1000000.0;
+	}
+	//! The amount of pins of blocks that were already loaded
+	idx_t GetBlockHits() {
+		return block_hits;
+	}
+	//! The amount of pins of blocks that had to be loaded
+	idx_t GetBlockMisses() {
+		return block_misses;
+	}
+	//! The amount of blocks that were evicted from memory
+	idx_t GetBlockEvictions() {
+		return block_evictions;
+	}
 
 private:
 	//! Evict blocks until the currently used memory + extra_memory fit, returns false if this was not possible
-	//! (i.e. not enough blocks could be evicted)
+	//! (i.e. not enough blocks could be evicted). Blocks that were accessed only once (or only by use-once pins) are
+	//! evicted before blocks that were accessed repeatedly, so a single large scan does not flush the buffer pool.
 	bool EvictBlocks(idx_t extra_memory, idx_t memory_limit);
+	//! Try to unload the block of an eviction queue node, returns true if the block was unloaded
+	bool TryEvict(BufferEvictionNode &node);
+	//! Charge memory to a memory budget. If the budget is exceeded, the unpinned blocks of the budget are evicted until
+	//! the memory fits. Returns false if this was not possible.
+	bool ReserveBudgetMemory(MemoryBudget &budget, idx_t memory);
+	//! Evict the unpinned blocks of the budget from the eviction queues of the budget until it is not exceeded. Returns
+	//! false if the budget is still exceeded when there are no blocks left to evict.
+	bool EvictBudgetBlocks(MemoryBudget &budget);
 
 	//! Write a temporary buffer to disk
 	void WriteTemporaryBuffer(ManagedBuffer &buffer);
@@ -79,6 +142,11 @@ private:
 
 	void DeleteTemporaryFile(block_id_t id);
 
+	//! Loads a block that was scheduled by Prefetch, called from the prefetch threads
+	void LoadPrefetchedBlock(weak_ptr<BlockHandle> &block);
+	//! Reserve memory only if it fits within the memory limit without evicting blocks, returns false otherwise
+	bool ReserveFreeMemory(idx_t memory);
+
 private:
 	//! The database instance
 	DatabaseInstance &db;
@@ -92,9 +160,17 @@ private:
 	std::mutex manager_lock;
 	//! A mapping of block id -> BlockPointer
 	unordered_map<block_id_t, weak_ptr<BlockHandle>> blocks;
-	//! Eviction queue
+	//! Eviction queues of unpinned blocks (see EvictBlocks)
 	unique_ptr<EvictionQueue> queue;
 	//! The temporary id used for managed buffers
 	block_id_t temporary_id;
+	//! The background threads that read prefetched blocks, created on the first call to Prefetch
+	unique_ptr<BlockPrefetcher> prefetcher;
+	//! The total time that scans have spent waiting for blocks to be read (in microseconds)
+	std::atomic<idx_t> read_wait_time;
+	//! Counters of the buffer pool usage
+	std::atomic<idx_t> block_hits;
+	std::atomic<idx_t> block_misses;
+	std::atomic<idx_t> block_evictions;
 };
 } // namespace duckdb
@@ -9,6 +9,7 @@
 #pragma once
 
 #include "duckdb/storage/checkpoint_manager.hpp"
+#include "duckdb/common/enums/compression_type.hpp"
 
 namespace duckdb {
 class ColumnData;
@@ -33,6 +34,9 @@ public:
 private:
 	void AppendData(SegmentTree &new_tree, idx_t col_idx, Vector &data, idx_t count);
 
+	//! Determine the compression type to use for the changed segments of a column
+	CompressionType AnalyzeColumn(ColumnData &col_data, idx_t col_idx);
+
 	void CreateSegment(idx_t col_idx);
 	void FlushSegment(SegmentTree &new_tree, idx_t col_idx);
 
@@ -47,6 +51,8 @@ private:
 	vector<unique_ptr<UncompressedSegment>> segments;
 	vector<unique_ptr<SegmentStatistics>> stats;
 	vector<unique_ptr<BaseStatistics>> column_stats;
+	//! The compression type used for the new segments of each column
+	vector<CompressionType> compression_types;
 
 	vector<vector<DataPointer>> data_pointers;
 };
@@ -72,7 +72,12 @@ public:
 	//! Fetch a specific row id and append it to the vector
 	void FetchRow(ColumnFetchState &state, Transaction &transaction, row_t row_id, Vector &result, idx_t result_idx);
 
+	//! Append a row describing the storage of each of the segments of the column to the result
+	void GetStorageInfo(vector<vector<Value>> &result);
+
 private:
+	//! Initialize the scan of the current segment of the scan state, if this has not happened yet
+	void InitializeSegmentScan(ColumnScanState &state);
 	//! Append a transient segment
 	void AppendTransientSegment(idx_t start_row);
 };
@@ -0,0 +1,104 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// duckdb/storage/compressed_segment.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/common/enums/compression_type.hpp"
+#include "duckdb/storage/numeric_segment.hpp"
+
+namespace duckdb {
+class DatabaseInstance;
+
+//! A compressed segment holds fixed-width data that is compressed with a lightweight compression scheme (RLE,
+//! bit-packing or dictionary encoding). Every vector is compressed separately, so that individual vectors can be
+//! decompressed directly into the result vector during a scan. A compressed segment is only ever written by the
+//! checkpoint: when an update is made to a compressed segment it is decompressed into a regular (uncompressed) in-memory
+//! buffer, after which the segment behaves exactly like a NumericSegment.
+//! The layout of a compressed block is as follows:
+//! [uint32 vector_count][uint32 data_end][vector 0][vector 1]...[free space][offset vector 1][offset vector 0]
+//! i.e. the offsets of the individual vectors are stored at the end of the block, growing towards the front.
+class CompressedSegment : public NumericSegment {
+public:
+	CompressedSegment(DatabaseInstance &db, PhysicalType type, idx_t row_start, CompressionType compression,
+	                  block_id_t block_id = INVALID_BLOCK);
+
+	//! The compression type used by the (on-disk) block of this segment
+	CompressionType compression;
+
+public:
+	//! Whether or not the given physical type can be compressed with the given compression type
+	static bool SupportsCompression(PhysicalType type, CompressionType compression);
+	//! Returns the maximum amount of vectors a single compressed segment of the given type can hold
+	static idx_t MaximumVectorCount(PhysicalType type);
+
+	//! Returns the compression type of the current data of the segment; after an update this is always
+	//! COMPRESSION_UNCOMPRESSED
+	CompressionType GetCompressionType();
+	//! Returns the amount of bytes the (compressed) data of this segment occupies in its block
+	idx_t GetCompressedSize();
+
+	void FetchRow(ColumnFetchState &state, Transaction &transaction, row_t row_id, Vector &result,
+	              idx_t result_idx) override;
+
+	//! Append a part of a vector to the segment, compressing every vector as it fills up.
+	idx_t Append(SegmentStatistics &stats, Vector &data, idx_t offset, idx_t count) override;
+	//! Compress the final (partially filled) vector and write the block header, must be called prior to writing the
+	//! block to disk
+	void FinalizeAppend();
+
+	//! Decompress the segment into an uncompressed in-memory buffer
+	void ToTemporary() override;
+
+protected:
+	void Select(ColumnScanState &state, Vector &result, SelectionVector &sel, idx_t &approved_tuple_count,
+	            vector<TableFilter> &table_filter) override;
+	void FetchBaseData(ColumnScanState &state, idx_t vector_index, Vector &result) override;
+	void FilterFetchBaseData(ColumnScanState &state, Vector &result, SelectionVector &sel,
+	                         idx_t &approved_tuple_count) override;
+
+private:
+	//! Whether or not the buffer handle points to compressed data
+	bool IsCompressed(BufferHandle &handle);
+	//! Decompress the vector at the specified index into the result vector. If allow_compressed_result is true, the
+	//! result vector can be a constant or dictionary vector.
+	void DecompressVector(data_ptr_t block_data, idx_t vector_index, Vector &result, bool allow_compressed_result);
+	//! Compress the currently buffered vector into the block
+	void CompressBufferedVector(data_ptr_t block_data);
+
+private:
+	//! The (uncompressed) vector that is currently being appended to, only used while writing the segment
+	unique_ptr<data_t[]> append_buffer;
+	//! The amount of vectors that have been compressed into the block, only used while writing the segment
+	idx_t compressed_vector_count;
+	//! The end of the compressed data within the block, only used while writing the segment
+	idx_t data_end;
+};
+
+//! The CompressionAnalyzer computes the compressed size of a column for every supported compression type, and is used
+//! by the checkpoint to decide which compression type to use for a column
+class CompressionAnalyzer {
+public:
+	explicit CompressionAnalyzer(PhysicalType type);
+
+	//! Add a vector of data to the analysis
+	void Analyze(Vector &data, idx_t count);
+	//! Returns the compression type that results in the smallest data, or COMPRESSION_UNCOMPRESSED if no compression
+	//! type is beneficial
+	CompressionType GetBestCompression();
+
+private:
+	PhysicalType type;
+	//! The size of the data if it were stored uncompressed
+	idx_t uncompressed_size;
+	//! The size of the data for each of the compression types
+	vector<std::pair<CompressionType, idx_t>> compressed_sizes;
+	//! Scratch space used to compress vectors into
+	unique_ptr<data_t[]> compress_buffer;
+};
+
+} // namespace duckdb
@@ -58,6 +58,8 @@ struct ParallelTableScanState {
 
 //! DataTable represents a physical table on disk
 class DataTable {
+	friend class CreateIndexTask;
+
 public:
 	//! Constructs a new data table from an (optional) set of persistent segments
 	DataTable(DatabaseInstance &db, const string &schema, const string &table, vector<LogicalType> types,
@@ -108,6 +110,8 @@ public:
 
 	//! Add an index to the DataTable
 	void AddIndex(unique_ptr<Index> index, vector<unique_ptr<Expression>> &expressions);
+	//! Add an index to the DataTable, the index is bulk loaded in parallel if it supports bulk loading
+	void AddIndex(ClientContext &context, unique_ptr<Index> index, vector<unique_ptr<Expression>> &expressions);
 
 	//! Begin appending structs to this table, obtaining necessary locks, etc
 	void InitializeAppend(Transaction &transaction, TableAppendState &state, idx_t append_count);
@@ -140,6 +144,9 @@ public:
 
 	unique_ptr<BaseStatistics> GetStatistics(ClientContext &context, column_t column_id);
 
+	//! Returns a row describing the storage of each of the segments of the table
+	vector<vector<Value>> GetStorageInfo();
+
 	//! Checkpoint the table to the specified table data writer
 	void Checkpoint(TableDataWriter &writer);
 	void CheckpointDeletes(TableDataWriter &writer);
@@ -169,6 +176,10 @@ private:
 	//! The CreateIndexScan is a special scan that is used to create an index on the table, it keeps locks on the table
 	void InitializeCreateIndexScan(CreateIndexScanState &state, const vector<column_t> &column_ids);
 	void CreateIndexScan(CreateIndexScanState &structure, const vector<column_t> &column_ids, DataChunk &result);
+	//! Collect the index entries of the rows [start_row, end_row) for a bulk-loaded index build
+	void BuildIndexRange(CreateIndexScanState &state, Index &index, IndexBuildState &build_state,
+	                     vector<unique_ptr<Expression>> &expressions, const vector<column_t> &column_ids,
+	                     idx_t start_row, idx_t end_row);
 
 private:
 	//! Lock for appending entries to the table
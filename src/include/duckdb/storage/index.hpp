@@ -13,23 +13,33 @@
 #include "duckdb/common/types/data_chunk.hpp"
 #include "duckdb/parser/parsed_expression.hpp"
 #include "duckdb/planner/expression.hpp"
+#include "duckdb/storage/block.hpp"
 #include "duckdb/storage/table/scan_state.hpp"
 #include "duckdb/execution/expression_executor.hpp"
 
 namespace duckdb {
 
 class ClientContext;
+class DatabaseInstance;
+class MetaBlockWriter;
 class Transaction;
 
 struct IndexLock;
 
+//! The state in which a single thread collects the entries of a bulk-loaded index build
+struct IndexBuildState {
+	virtual ~IndexBuildState() {
+	}
+};
+
 //! The index is an abstract base class that serves as the basis for indexes
 class Index {
 public:
 	Index(IndexType type, vector<column_t> column_ids, vector<unique_ptr<Expression>> unbound_expressions);
 	virtual ~Index() = default;
 
-	//! Lock used for updating the index
+	//! Lock used for updating the index. Writers are serialized by it, index types can allow lookups that do not take
+	//! it.
 	std::mutex lock;
 	//! The type of the index
 	IndexType type;
@@ -75,15 +85,40 @@ public:
 	//! Insert data into the index. Does not lock the index.
 	virtual bool Insert(IndexLock &lock, DataChunk &input, Vector &row_identifiers) = 0;
 
+	//! Bulk loading: returns the state in which a thread collects the entries of an index build, or nullptr if the index
+	//! can only be built incrementally through Insert. Bulk loading is only valid on an empty index.
+	virtual unique_ptr<IndexBuildState> InitializeBuild() {
+		return nullptr;
+	}
+	//! Collect entries for a bulk load. Does not lock the index.
+	virtual void BuildAppend(IndexBuildState &state, DataChunk &input, Vector &row_identifiers) {
+	}
+	//! Construct the entries collected by a thread and add them to the index. Can be called by many threads
+	//! concurrently. Returns false if the entries violate a constraint of the index.
+	virtual bool BuildCombine(IndexBuildState &state) {
+		return true;
+	}
+
+	//! Write the index to disk through the writer, returns a pointer to the root of the written index
+	virtual BlockPointer Serialize(MetaBlockWriter &writer);
+	//! Replace the contents of the index with the index written at the given pointer. The index is read from disk
+	//! lazily as it is accessed.
+	virtual void Deserialize(DatabaseInstance &db, BlockPointer pointer);
+	//! Called when the table of the index is dropped, frees the blocks the index was written to
+	virtual void CommitDrop() {
+	}
+
 	//! Returns true if the index is affected by updates on the specified column ids, and false otherwise
 	bool IndexIsUpdated(vector<column_t> &column_ids);
 
 protected:
+	//! Resolve the index expressions with the shared executor, requires the index lock
 	void ExecuteExpressions(DataChunk &input, DataChunk &result);
 
-private:
 	//! Bound expressions used by the index
 	vector<unique_ptr<Expression>> bound_expressions;
+
+private:
 	//! Expression executor for the index expressions
 	ExpressionExecutor executor;
 
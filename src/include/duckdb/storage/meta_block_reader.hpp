@@ -20,7 +20,9 @@ class DatabaseInstance;
 //! This struct is responsible for reading meta data from disk
 class MetaBlockReader : public Deserializer {
 public:
-	MetaBlockReader(DatabaseInstance &db, block_id_t block);
+	//! Blocks that are read are freed at the next checkpoint (as it writes the metadata again), unless
+	//! free_blocks_on_read is false
+	MetaBlockReader(DatabaseInstance &db, block_id_t block, bool free_blocks_on_read = true);
 	~MetaBlockReader() override;
 
 	DatabaseInstance &db;
@@ -28,6 +30,7 @@ public:
 	unique_ptr<BufferHandle> handle;
 	idx_t offset;
 	block_id_t next_block;
+	bool free_blocks_on_read;
 
 public:
 	//! Read content of size read_size into the buffer
@@ -58,7 +58,7 @@ public:
 	typedef void (*merge_update_function_t)(SegmentStatistics &stats, UpdateInfo *node, data_ptr_t target,
 	                                        Vector &update, row_t *ids, idx_t count, idx_t vector_offset);
 
-private:
+protected:
 	append_function_t append_function;
 	update_function_t update_function;
 	update_info_fetch_function_t fetch_from_update_info;
@@ -10,6 +10,7 @@
 
 #include "duckdb/storage/table/column_segment.hpp"
 #include "duckdb/storage/block.hpp"
+#include "duckdb/common/enums/compression_type.hpp"
 #include "duckdb/storage/uncompressed_segment.hpp"
 
 namespace duckdb {
@@ -18,7 +19,8 @@ class DatabaseInstance;
 class PersistentSegment : public ColumnSegment {
 public:
 	PersistentSegment(DatabaseInstance &db, block_id_t id, idx_t offset, const LogicalType &type, idx_t start,
-	                  idx_t count, unique_ptr<BaseStatistics> statistics);
+	                  idx_t count, unique_ptr<BaseStatistics> statistics,
+	                  CompressionType compression = CompressionType::COMPRESSION_UNCOMPRESSED);
 
 	//! The storage manager
 	DatabaseInstance &db;
@@ -26,6 +28,8 @@ public:
 	block_id_t block_id;
 	//! The offset into the block
 	idx_t offset;
+	//! The compression type of the on-disk block
+	CompressionType compression;
 	//! The uncompressed segment that the data of the persistent segment is loaded into
 	unique_ptr<UncompressedSegment> data;
 
@@ -10,6 +10,7 @@
 
 #include "duckdb/common/constants.hpp"
 #include "duckdb/common/vector.hpp"
+#include "duckdb/storage/block.hpp"
 #include "duckdb/storage/table/segment_tree.hpp"
 
 namespace duckdb {
@@ -24,6 +25,8 @@ public:
 	vector<unique_ptr<BaseStatistics>> column_stats;
 	vector<vector<unique_ptr<PersistentSegment>>> table_data;
 	shared_ptr<SegmentTree> versions;
+	//! The pointers to the indexes of the UNIQUE and PRIMARY KEY constraints of the table
+	vector<BlockPointer> indexes;
 };
 
 } // namespace duckdb
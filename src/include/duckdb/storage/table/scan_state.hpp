@@ -43,6 +43,10 @@ struct ColumnScanState {
 	bool initialized = false;
 	//! If this segment has already been checked for skipping puorposes
 	bool segment_checked = false;
+	//! The last segment for which a prefetch was issued
+	ColumnSegment *last_prefetched = nullptr;
+	//! Whether or not the blocks of the scan are pinned as use-once, i.e. the column does not fit in the buffer pool
+	bool use_once = false;
 
 public:
 	//! Move on to the next vector in the scan
@@ -186,6 +186,16 @@ DBConfig &DBConfig::GetConfig(ClientContext &context) {
 	return context.db->config;
 }
 
+OrderByNullType DBConfig::GetDefaultNullOrder(OrderType type) const {
+	if (type != OrderType::DESCENDING) {
+		return default_null_order;
+	}
+	if (default_null_order == OrderByNullType::NULLS_FIRST) {
+		return OrderByNullType::NULLS_LAST;
+	}
+	return OrderByNullType::NULLS_FIRST;
+}
+
 idx_t DatabaseInstance::NumberOfThreads() {
 	return scheduler->NumberOfThreads();
 }
@@ -11,6 +11,7 @@
 #include "duckdb/common/printer.hpp"
 #include "duckdb/common/limits.hpp"
 #include "duckdb/common/to_string.hpp"
+#include "duckdb/storage/buffer_manager.hpp"
 
 #include <utility>
 #include <algorithm>
@@ -23,6 +24,7 @@ void QueryProfiler::StartQuery(string query) {
 	}
 	this->running = true;
 	this->query = move(query);
+	this->io_wait_time = 0;
 	tree_map.clear();
 	root = nullptr;
 	phase_timings.clear();
@@ -169,12 +171,13 @@ void OperatorProfiler::StartOperator(PhysicalOperator *phys_op) {
 		// add timing for the previous element
 		op.End();
 
-		AddTiming(execution_stack.top(), op.Elapsed(), 0);
+		AddTiming(execution_stack.top(), op.Elapsed(), 0, ElapsedReadWaitTime());
 	}
 
 	execution_stack.push(phys_op);
 
 	// start timing for current element
+	read_wait_start = BufferManager::GetThreadReadWaitTime();
 	op.Start();
 }
 
@@ -186,18 +189,26 @@ void OperatorProfiler::EndOperator(DataChunk *chunk) {
 	// finish timing for the current element
 	op.End();
 
-	AddTiming(execution_stack.top(), op.Elapsed(), chunk ? chunk->size() : 0);
+	AddTiming(execution_stack.top(), op.Elapsed(), chunk ? chunk->size() : 0, ElapsedReadWaitTime());
 
 	D_ASSERT(!execution_stack.empty());
 	execution_stack.pop();
 
 	// start timing again for the previous element, if any
 	if (!execution_stack.empty()) {
+		read_wait_start = BufferManager::GetThreadReadWaitTime();
 		op.Start();
 	}
 }
 
-void OperatorProfiler::AddTiming(PhysicalOperator *op, double time, idx_t elements) {
+double OperatorProfiler::ElapsedReadWaitTime() {
+	// the read wait time is kept per thread, so reads of other threads and queries are not counted
+	auto read_wait_time = BufferManager::GetThreadReadWaitTime();
+	D_ASSERT(read_wait_time >= read_wait_start);
+	return (read_wait_time - read_wait_start) / 1000000.0;
+}
+
+void OperatorProfiler::AddTiming(PhysicalOperator *op, double time, idx_t elements, double io_wait) {
 	if (!enabled) {
 		return;
 	}
@@ -205,11 +216,12 @@ void OperatorProfiler::AddTiming(PhysicalOperator *op, double time, idx_t elemen
 	auto entry = timings.find(op);
 	if (entry == timings.end()) {
 		// add new entry
-		timings[op] = OperatorTimingInformation(time, elements);
+		timings[op] = OperatorTimingInformation(time, elements, io_wait);
 	} else {
 		// add to existing entry
 		entry->second.time += time;
 		entry->second.elements += elements;
+		entry->second.io_wait += io_wait;
 	}
 }
 
@@ -224,6 +236,8 @@ void QueryProfiler::Flush(OperatorProfiler &profiler) {
 
 		entry->second->info.time += node.second.time;
 		entry->second->info.elements += node.second.elements;
+		entry->second->info.io_wait += node.second.io_wait;
+		io_wait_time += node.second.io_wait;
 	}
 }
 
@@ -291,6 +305,10 @@ void QueryProfiler::ToStream(std::ostream &ss, bool print_optimizer_output) cons
 	ss << "│┌───────────────────────────────────┐│\n";
 	string total_time = "Total Time: " + RenderTiming(main_query.Elapsed());
 	ss << "││" + DrawPadded(total_time, TOTAL_BOX_WIDTH - 4) + "││\n";
+	if (io_wait_time > 0) {
+		string io_wait = "I/O Wait: " + RenderTiming(io_wait_time);
+		ss << "││" + DrawPadded(io_wait, TOTAL_BOX_WIDTH - 4) + "││\n";
+	}
 	ss << "│└───────────────────────────────────┘│\n";
 	ss << "└─────────────────────────────────────┘\n";
 	// print phase timings
@@ -334,6 +352,7 @@ static void ToJSONRecursive(QueryProfiler::TreeNode &node, std::ostream &ss, int
 	ss << string(depth * 3, ' ') << "\"name\": \"" + node.name + "\",\n";
 	ss << string(depth * 3, ' ') << "\"timing\":" + StringUtil::Format("%.2f", node.info.time) + ",\n";
 	ss << string(depth * 3, ' ') << "\"cardinality\":" + to_string(node.info.elements) + ",\n";
+	ss << string(depth * 3, ' ') << "\"io_wait\":" + to_string(node.info.io_wait) + ",\n";
 	ss << string(depth * 3, ' ') << "\"extra_info\": \"" + StringUtil::Replace(node.extra_info, "\n", "\\n") + "\",\n";
 	ss << string(depth * 3, ' ') << "\"children\": [";
 	if (node.children.empty()) {
@@ -365,6 +384,7 @@ string QueryProfiler::ToJSON() const {
 	std::stringstream ss;
 	ss << "{\n";
 	ss << "   \"result\": " + to_string(main_query.Elapsed()) + ",\n";
+	ss << "   \"io_wait\": " + to_string(io_wait_time) + ",\n";
 	// print the phase timings
 	ss << "   \"timings\": {\n";
 	const auto &ordered_phase_timings = GetOrderedPhaseTimings();
@@ -1,6 +1,7 @@
 #include "duckdb/optimizer/remove_unused_columns.hpp"
 
 #include "duckdb/function/aggregate/distributive_functions.hpp"
+#include "duckdb/function/scalar/nested_functions.hpp"
 #include "duckdb/planner/binder.hpp"
 #include "duckdb/planner/column_binding_map.hpp"
 #include "duckdb/planner/expression/bound_aggregate_expression.hpp"
@@ -95,6 +96,13 @@ void RemoveUnusedColumns::VisitOperator(LogicalOperator &op) {
 								column_references[lhs_col.binding].push_back(entry);
 							}
 							column_references.erase(rhs_col.binding);
+							auto struct_refs = struct_references.find(rhs_col.binding);
+							if (struct_refs != struct_references.end()) {
+								auto &lhs_struct_refs = struct_references[lhs_col.binding];
+								lhs_struct_refs.insert(lhs_struct_refs.end(), struct_refs->second.begin(),
+								                       struct_refs->second.end());
+								struct_references.erase(rhs_col.binding);
+							}
 						}
 					}
 				}
@@ -200,6 +208,9 @@ void RemoveUnusedColumns::VisitOperator(LogicalOperator &op) {
 					column_references.insert(make_pair(filter_binding, vector<BoundColumnRefExpression *>()));
 				}
 			}
+			if (get.function.pushdown_struct_projection) {
+				PushdownStructProjection(get);
+			}
 			// table scan: figure out which columns are referenced
 			ClearUnusedExpressions(get.column_ids, get.table_index);
 
@@ -233,6 +244,36 @@ void RemoveUnusedColumns::VisitOperator(LogicalOperator &op) {
 	LogicalOperatorVisitor::VisitOperatorChildren(op);
 }
 
+void RemoveUnusedColumns::PushdownStructProjection(LogicalGet &get) {
+	for (idx_t col_idx = 0; col_idx < get.column_ids.size(); col_idx++) {
+		auto column_id = get.column_ids[col_idx];
+		if (column_id == COLUMN_IDENTIFIER_ROW_ID || get.returned_types[column_id].id() != LogicalTypeId::STRUCT) {
+			continue;
+		}
+		auto binding = ColumnBinding(get.table_index, col_idx);
+		auto colrefs = column_references.find(binding);
+		auto struct_refs = struct_references.find(binding);
+		if (colrefs == column_references.end() || struct_refs == struct_references.end() ||
+		    colrefs->second.size() != struct_refs->second.size()) {
+			// the column is not referenced, or (also) referenced as a whole
+			continue;
+		}
+		get.function.pushdown_struct_projection(context, get, get.bind_data.get(), column_id, struct_refs->second);
+	}
+}
+
+void RemoveUnusedColumns::VisitExpression(unique_ptr<Expression> *expression) {
+	vector<idx_t> child_path;
+	auto colref = StructExtractFun::GetFieldPath(**expression, child_path);
+	if (colref) {
+		// only the extracted field of the column is referenced
+		column_references[colref->binding].push_back(colref);
+		struct_references[colref->binding].push_back(move(child_path));
+		return;
+	}
+	LogicalOperatorVisitor::VisitExpression(expression);
+}
+
 unique_ptr<Expression> RemoveUnusedColumns::VisitReplace(BoundColumnRefExpression &expr,
                                                          unique_ptr<Expression> *expr_ptr) {
 	// add a column reference
@@ -10,6 +10,7 @@
 #include "duckdb/parallel/task_context.hpp"
 #include "duckdb/parallel/thread_context.hpp"
 #include "duckdb/parallel/task_scheduler.hpp"
+#include "duckdb/storage/buffer_manager.hpp"
 
 #include <algorithm>
 
@@ -21,6 +22,18 @@ Executor::Executor(ClientContext &context) : context(context) {
 Executor::~Executor() {
 }
 
+//! Charges the buffers that are allocated by the thread of the connection to the memory budget of the query
+struct ThreadMemoryBudget {
+	explicit ThreadMemoryBudget(shared_ptr<MemoryBudget> budget)
+	    : previous_budget(BufferManager::SetThreadMemoryBudget(move(budget))) {
+	}
+	~ThreadMemoryBudget() {
+		BufferManager::SetThreadMemoryBudget(move(previous_budget));
+	}
+
+	shared_ptr<MemoryBudget> previous_budget;
+};
+
 void Executor::Initialize(PhysicalOperator *plan) {
 	Reset();
 
@@ -30,6 +43,17 @@ void Executor::Initialize(PhysicalOperator *plan) {
 	context.profiler.Initialize(physical_plan);
 	auto &scheduler = TaskScheduler::GetScheduler(context);
 	this->producer = scheduler.CreateProducer();
+	// set up the resource limits of the query
+	auto &group = *producer->group;
+	group.weight = context.query_priority;
+	if (context.query_threads > 0) {
+		// the thread of the connection executes tasks as well
+		group.max_threads = context.query_threads - 1;
+	}
+	if (context.query_memory_limit != INVALID_INDEX) {
+		group.memory_budget = make_shared<MemoryBudget>(context.query_memory_limit);
+	}
+	ThreadMemoryBudget budget(group.memory_budget);
 
 	BuildPipelines(physical_plan, nullptr);
 
@@ -244,6 +268,7 @@ bool Executor::GetPipelinesProgress(int &current_progress) {
 
 unique_ptr<DataChunk> Executor::FetchChunk() {
 	D_ASSERT(physical_plan);
+	ThreadMemoryBudget budget(producer->group->memory_budget);
 
 	ThreadContext thread(context);
 	TaskContext task;
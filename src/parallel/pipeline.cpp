@@ -155,6 +155,9 @@ bool Pipeline::ScheduleOperator(PhysicalOperator *op) {
 		if (max_threads > executor.context.db->NumberOfThreads()) {
 			max_threads = executor.context.db->NumberOfThreads();
 		}
+		if (executor.context.query_threads > 0 && max_threads > executor.context.query_threads) {
+			max_threads = executor.context.query_threads;
+		}
 		if (max_threads <= 1) {
 			// table is too small to parallelize
 			return false;
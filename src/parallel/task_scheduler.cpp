@@ -1,17 +1,29 @@
 #include "duckdb/parallel/task_scheduler.hpp"
 
 #include "duckdb/common/exception.hpp"
+#include "duckdb/common/string_util.hpp"
+#include "duckdb/common/to_string.hpp"
 #include "duckdb/main/client_context.hpp"
 #include "duckdb/main/database.hpp"
+#include "duckdb/storage/buffer_manager.hpp"
+
+#include <algorithm>
 
 #ifndef DUCKDB_NO_THREADS
 #include "concurrentqueue.h"
 #include "lightweightsemaphore.h"
+#include "duckdb/common/chrono.hpp"
 #include "duckdb/common/thread.hpp"
+#include <deque>
 #else
 #include <queue>
 #endif
 
+#if !defined(DUCKDB_NO_THREADS) && defined(__linux__)
+#include <fstream>
+#include <sched.h>
+#endif
+
 namespace duckdb {
 
 struct SchedulerThread {
@@ -23,6 +35,21 @@ struct SchedulerThread {
 #endif
 };
 
+struct ScheduledTask {
+	ScheduledTask(ProducerToken &producer, unique_ptr<Task> task) : group(producer.group), task(move(task)) {
+	}
+
+	shared_ptr<TaskGroup> group;
+	unique_ptr<Task> task;
+};
+
+//! The local task queue of a worker thread. The owner pushes and pops tasks at the back, other threads steal tasks from
+//! the front. The lock is only contended when a task is stolen.
+struct WorkerQueue {
+	mutex lock;
+	std::deque<ScheduledTask> tasks;
+};
+
 #ifndef DUCKDB_NO_THREADS
 typedef moodycamel::ConcurrentQueue<unique_ptr<Task>> concurrent_queue_t;
 typedef moodycamel::LightweightSemaphore lightweight_semaphore_t;
@@ -31,8 +58,8 @@ struct ConcurrentQueue {
 	concurrent_queue_t q;
 	lightweight_semaphore_t semaphore;
 
-	void Enqueue(ProducerToken &token, unique_ptr<Task> task);
-	bool DequeueFromProducer(ProducerToken &token, unique_ptr<Task> &task);
+	void Enqueue(TaskGroup &group, unique_ptr<Task> task);
+	bool DequeueFromProducer(TaskGroup &group, unique_ptr<Task> &task);
 };
 
 struct QueueProducerToken {
@@ -42,58 +69,91 @@ struct QueueProducerToken {
 	moodycamel::ProducerToken queue_token;
 };
 
-void ConcurrentQueue::Enqueue(ProducerToken &token, unique_ptr<Task> task) {
-	lock_guard<mutex> producer_lock(token.producer_lock);
-	if (q.enqueue(token.token->queue_token, move(task))) {
+void ConcurrentQueue::Enqueue(TaskGroup &group, unique_ptr<Task> task) {
+	// a producer token can only be used by one thread at a time to enqueue
+	lock_guard<mutex> enqueue_lock(group.enqueue_lock);
+	if (q.enqueue(group.token->queue_token, move(task))) {
+		group.pending_tasks++;
 		semaphore.signal();
 	} else {
 		throw InternalException("Could not schedule task!");
 	}
 }
 
-bool ConcurrentQueue::DequeueFromProducer(ProducerToken &token, unique_ptr<Task> &task) {
-	lock_guard<mutex> producer_lock(token.producer_lock);
-	return q.try_dequeue_from_producer(token.token->queue_token, task);
+bool ConcurrentQueue::DequeueFromProducer(TaskGroup &group, unique_ptr<Task> &task) {
+	// dequeueing from the sub-queue of a producer is safe for multiple consumers
+	if (!q.try_dequeue_from_producer(group.token->queue_token, task)) {
+		return false;
+	}
+	group.pending_tasks--;
+	return true;
 }
 
 #else
 struct ConcurrentQueue {
-	std::queue<std::unique_ptr<Task>> q;
+	//! The total amount of tasks in the sub-queues of the producers
+	idx_t size = 0;
 	mutex qlock;
 
-	void Enqueue(ProducerToken &token, unique_ptr<Task> task);
-	bool DequeueFromProducer(ProducerToken &token, unique_ptr<Task> &task);
+	void Enqueue(TaskGroup &group, unique_ptr<Task> task);
+	bool DequeueFromProducer(TaskGroup &group, unique_ptr<Task> &task);
 };
 
-void ConcurrentQueue::Enqueue(ProducerToken &token, unique_ptr<Task> task) {
+//! Every producer has its own sub-queue, like the producer tokens of the concurrent queue
+struct QueueProducerToken {
+	QueueProducerToken(ConcurrentQueue &queue) {
+	}
+
+	std::queue<unique_ptr<Task>> q;
+};
+
+void ConcurrentQueue::Enqueue(TaskGroup &group, unique_ptr<Task> task) {
 	lock_guard<mutex> lock(qlock);
-	q.push(move(task));
+	group.token->q.push(move(task));
+	group.pending_tasks++;
+	size++;
 }
 
-bool ConcurrentQueue::DequeueFromProducer(ProducerToken &token, unique_ptr<Task> &task) {
+bool ConcurrentQueue::DequeueFromProducer(TaskGroup &group, unique_ptr<Task> &task) {
 	lock_guard<mutex> lock(qlock);
+	auto &q = group.token->q;
 	if (q.empty()) {
 		return false;
 	}
 	task = move(q.front());
 	q.pop();
+	group.pending_tasks--;
+	size--;
 	return true;
 }
-
-struct QueueProducerToken {
-	QueueProducerToken(ConcurrentQueue &queue) {
-	}
-};
 #endif
 
+TaskGroup::TaskGroup(unique_ptr<QueueProducerToken> token)
+    : token(move(token)), weight(NORMAL_PRIORITY_WEIGHT), max_threads(INVALID_INDEX), pending_tasks(0),
+      active_tasks(0), executed_tasks(0) {
+}
+
+TaskGroup::~TaskGroup() {
+}
+
 ProducerToken::ProducerToken(TaskScheduler &scheduler, unique_ptr<QueueProducerToken> token)
-    : scheduler(scheduler), token(move(token)) {
+    : scheduler(scheduler), group(make_shared<TaskGroup>(move(token))) {
 }
 
 ProducerToken::~ProducerToken() {
+	scheduler.RemoveProducer(*this);
 }
 
-TaskScheduler::TaskScheduler() : queue(make_unique<ConcurrentQueue>()) {
+#ifndef DUCKDB_NO_THREADS
+//! The scheduler and local queue of the worker thread that is running on this thread (if any)
+static thread_local TaskScheduler *current_scheduler = nullptr;
+static thread_local WorkerQueue *current_queue = nullptr;
+#endif
+
+TaskScheduler::TaskScheduler()
+    : queue(make_unique<ConcurrentQueue>()), worker_queues(make_shared<vector<shared_ptr<WorkerQueue>>>()),
+      groups(make_shared<vector<shared_ptr<TaskGroup>>>()), numa_affinity(false), tasks_executed(0), steals(0),
+      idle_time(0) {
 }
 
 TaskScheduler::~TaskScheduler() {
@@ -108,28 +168,181 @@ TaskScheduler &TaskScheduler::GetScheduler(ClientContext &context) {
 
 unique_ptr<ProducerToken> TaskScheduler::CreateProducer() {
 	auto token = make_unique<QueueProducerToken>(*queue);
-	return make_unique<ProducerToken>(*this, move(token));
+	auto producer = make_unique<ProducerToken>(*this, move(token));
+	lock_guard<mutex> guard(group_lock);
+	auto new_groups = make_shared<vector<shared_ptr<TaskGroup>>>(*std::atomic_load(&groups));
+	new_groups->push_back(producer->group);
+	std::atomic_store(&groups, new_groups);
+	return producer;
+}
+
+void TaskScheduler::RemoveProducer(ProducerToken &producer) {
+	lock_guard<mutex> guard(group_lock);
+	auto new_groups = make_shared<vector<shared_ptr<TaskGroup>>>(*std::atomic_load(&groups));
+	new_groups->erase(std::remove(new_groups->begin(), new_groups->end(), producer.group), new_groups->end());
+	std::atomic_store(&groups, new_groups);
 }
 
 void TaskScheduler::ScheduleTask(ProducerToken &token, unique_ptr<Task> task) {
+#ifndef DUCKDB_NO_THREADS
+	if (current_scheduler == this && current_queue) {
+		// scheduled from one of our worker threads: push the task onto the local queue of the worker
+		{
+			lock_guard<mutex> guard(current_queue->lock);
+			current_queue->tasks.emplace_back(token, move(task));
+		}
+		queue->semaphore.signal();
+		return;
+	}
+#endif
 	// Enqueue a task for the given producer token and signal any sleeping threads
-	queue->Enqueue(token, move(task));
+	queue->Enqueue(*token.group, move(task));
 }
 
 bool TaskScheduler::GetTaskFromProducer(ProducerToken &token, unique_ptr<Task> &task) {
-	return queue->DequeueFromProducer(token, task);
+	if (queue->DequeueFromProducer(*token.group, task)) {
+		return true;
+	}
+#ifndef DUCKDB_NO_THREADS
+	// the task might have been scheduled by a worker thread
+	shared_ptr<TaskGroup> group;
+	return StealTask(INVALID_INDEX, &token, task, group);
+#else
+	return false;
+#endif
+}
+
+bool TaskScheduler::GetTaskFromGroups(unique_ptr<Task> &task, shared_ptr<TaskGroup> &group) {
+	// the snapshot keeps the groups (and their queue tokens) alive while we dequeue from them
+	auto snapshot = std::atomic_load(&groups);
+	auto &candidates = *snapshot;
+	// pick the group with pending tasks that has executed the fewest tasks relative to its weight
+	idx_t best_idx = INVALID_INDEX;
+	double best_score = 0;
+	for (idx_t group_idx = 0; group_idx < candidates.size(); group_idx++) {
+		auto &candidate = *candidates[group_idx];
+		if (candidate.pending_tasks == 0 || !candidate.CanExecute()) {
+			continue;
+		}
+		double score = double(candidate.executed_tasks + candidate.active_tasks) / candidate.weight;
+		if (best_idx == INVALID_INDEX || score < best_score) {
+			best_idx = group_idx;
+			best_score = score;
+		}
+	}
+	if (best_idx == INVALID_INDEX) {
+		return false;
+	}
+	if (DequeueFromGroup(candidates[best_idx], task, group)) {
+		return true;
+	}
+	// another worker took the last task (or the last free slot) of the group in the meantime: take a task from any
+	// other group
+	for (idx_t group_idx = 0; group_idx < candidates.size(); group_idx++) {
+		auto &candidate = candidates[group_idx];
+		if (group_idx == best_idx || candidate->pending_tasks == 0 || !candidate->CanExecute()) {
+			continue;
+		}
+		if (DequeueFromGroup(candidate, task, group)) {
+			return true;
+		}
+	}
+	return false;
+}
+
+bool TaskScheduler::DequeueFromGroup(const shared_ptr<TaskGroup> &candidate, unique_ptr<Task> &task,
+                                     shared_ptr<TaskGroup> &group) {
+	// the slot of the worker is reserved before the task is dequeued, so concurrent workers cannot exceed the thread
+	// limit of the group
+	if (!candidate->TryStartTask()) {
+		return false;
+	}
+	if (!queue->DequeueFromProducer(*candidate, task)) {
+		candidate->active_tasks--;
+		return false;
+	}
+	group = candidate;
+	return true;
+}
+
+bool TaskScheduler::StealTask(idx_t worker_idx, ProducerToken *producer, unique_ptr<Task> &task,
+                              shared_ptr<TaskGroup> &group) {
+#ifndef DUCKDB_NO_THREADS
+	auto queues = std::atomic_load(&worker_queues);
+	auto queue_count = queues->size();
+	// start with the neighbouring workers: workers with adjacent indexes share a NUMA node
+	for (idx_t i = 0; i < queue_count; i++) {
+		auto victim_idx = worker_idx == INVALID_INDEX ? i : (worker_idx + 1 + i) % queue_count;
+		if (victim_idx == worker_idx) {
+			continue;
+		}
+		auto &victim = *(*queues)[victim_idx];
+		lock_guard<mutex> guard(victim.lock);
+		for (auto entry = victim.tasks.begin(); entry != victim.tasks.end(); entry++) {
+			// the task is taken while the lock is held, so the slot that is reserved by TryStartTask is always used
+			if (producer ? entry->group != producer->group : !entry->group->TryStartTask()) {
+				continue;
+			}
+			task = move(entry->task);
+			group = move(entry->group);
+			victim.tasks.erase(entry);
+			steals++;
+			return true;
+		}
+	}
+#endif
+	return false;
+}
+
+bool TaskScheduler::GetTask(idx_t worker_idx, unique_ptr<Task> &task, shared_ptr<TaskGroup> &group) {
+#ifndef DUCKDB_NO_THREADS
+	if (worker_idx != INVALID_INDEX) {
+		// first try the local queue of the worker
+		auto &local = *current_queue;
+		lock_guard<mutex> guard(local.lock);
+		if (!local.tasks.empty() && local.tasks.back().group->TryStartTask()) {
+			task = move(local.tasks.back().task);
+			group = move(local.tasks.back().group);
+			local.tasks.pop_back();
+			return true;
+		}
+	}
+	// then the shared queue
+	if (GetTaskFromGroups(task, group)) {
+		return true;
+	}
+	// finally try to steal a task from one of the other workers
+	return StealTask(worker_idx, nullptr, task, group);
+#else
+	return false;
+#endif
 }
 
 void TaskScheduler::ExecuteForever(bool *marker) {
+	ExecuteTasks(marker, INVALID_INDEX);
+}
+
+void TaskScheduler::ExecuteTasks(bool *marker, idx_t worker_idx) {
 #ifndef DUCKDB_NO_THREADS
 	unique_ptr<Task> task;
+	shared_ptr<TaskGroup> group;
 	// loop until the marker is set to false
 	while (*marker) {
 		// wait for a signal with a timeout; the timeout allows us to periodically check
+		auto wait_start = high_resolution_clock::now();
 		queue->semaphore.wait(TASK_TIMEOUT_USECS);
-		if (queue->q.try_dequeue(task)) {
+		idle_time += duration_cast<std::chrono::microseconds>(high_resolution_clock::now() - wait_start).count();
+		while (*marker && GetTask(worker_idx, task, group)) {
+			// the task was counted in the active tasks of its group when it was taken from a queue
+			// buffers allocated by the task are charged to the memory budget of its query
+			auto previous_budget = BufferManager::SetThreadMemoryBudget(group->memory_budget);
 			task->Execute();
 			task.reset();
+			BufferManager::SetThreadMemoryBudget(move(previous_budget));
+			group->active_tasks--;
+			group->executed_tasks++;
+			group.reset();
+			tasks_executed++;
 		}
 	}
 #else
@@ -137,9 +350,80 @@ void TaskScheduler::ExecuteForever(bool *marker) {
 #endif
 }
 
+TaskSchedulerStatistics TaskScheduler::GetStatistics() {
+	TaskSchedulerStatistics result;
+	result.tasks_executed = tasks_executed;
+	result.steals = steals;
+	result.idle_time = idle_time / 1000000.0;
 #ifndef DUCKDB_NO_THREADS
-static void ThreadExecuteTasks(TaskScheduler *scheduler, bool *marker) {
-	scheduler->ExecuteForever(marker);
+	result.queue_depth = queue->q.size_approx();
+	auto queues = std::atomic_load(&worker_queues);
+	for (auto &worker_queue : *queues) {
+		lock_guard<mutex> guard(worker_queue->lock);
+		result.queue_depth += worker_queue->tasks.size();
+	}
+#else
+	result.queue_depth = queue->size;
+#endif
+	return result;
+}
+
+#if !defined(DUCKDB_NO_THREADS) && defined(__linux__)
+//! Parse a list of CPUs as used by sysfs, e.g. "0-23,48-71"
+static vector<idx_t> ParseCPUList(const string &cpu_list) {
+	vector<idx_t> result;
+	for (auto &range : StringUtil::Split(cpu_list, ',')) {
+		auto bounds = StringUtil::Split(range, '-');
+		if (bounds.empty()) {
+			continue;
+		}
+		idx_t start = std::stoull(bounds[0]);
+		idx_t end = bounds.size() > 1 ? std::stoull(bounds[1]) : start;
+		for (idx_t cpu = start; cpu <= end; cpu++) {
+			result.push_back(cpu);
+		}
+	}
+	return result;
+}
+
+//! Returns the CPUs of every NUMA node of the system
+static vector<vector<idx_t>> GetNUMANodes() {
+	vector<vector<idx_t>> nodes;
+	while (true) {
+		std::ifstream cpu_list_file("/sys/devices/system/node/node" + to_string(nodes.size()) + "/cpulist");
+		string cpu_list;
+		if (!cpu_list_file || !std::getline(cpu_list_file, cpu_list)) {
+			break;
+		}
+		nodes.push_back(ParseCPUList(StringUtil::Replace(cpu_list, "\n", "")));
+	}
+	return nodes;
+}
+
+static void SetThreadAffinity(const vector<idx_t> &cpus) {
+	cpu_set_t cpu_set;
+	CPU_ZERO(&cpu_set);
+	for (auto &cpu : cpus) {
+		if (cpu < CPU_SETSIZE) {
+			CPU_SET(cpu, &cpu_set);
+		}
+	}
+	// pinning the thread is a hint: ignore failures
+	(void)sched_setaffinity(0, sizeof(cpu_set), &cpu_set);
+}
+#endif
+
+#ifndef DUCKDB_NO_THREADS
+static void ThreadExecuteTasks(TaskScheduler *scheduler, WorkerQueue *worker_queue, bool *marker, idx_t worker_idx,
+                               vector<idx_t> cpus) {
+#ifdef __linux__
+	if (!cpus.empty()) {
+		SetThreadAffinity(cpus);
+	}
+#endif
+	current_scheduler = scheduler;
+	current_queue = worker_queue;
+	scheduler->ExecuteTasks(marker, worker_idx);
 }
 #endif
 
@@ -158,36 +442,78 @@ void TaskScheduler::SetThreads(int32_t n) {
 #endif
 }
 
+void TaskScheduler::SetNUMAAffinity(bool enable) {
+#ifndef DUCKDB_NO_THREADS
+	if (numa_affinity == enable) {
+		return;
+	}
+	numa_affinity = enable;
+	// restart the worker threads so they are (un)pinned
+	auto thread_count = NumberOfThreads();
+	SetThreadsInternal(1);
+	SetThreadsInternal(thread_count);
+#endif
+}
+
 void TaskScheduler::SetThreadsInternal(int32_t n) {
 #ifndef DUCKDB_NO_THREADS
 	if (threads.size() == idx_t(n - 1)) {
 		return;
 	}
 	idx_t new_thread_count = n - 1;
-	if (threads.size() < new_thread_count) {
-		// we are increasing the number of threads: launch them and run tasks on them
-		idx_t create_new_threads = new_thread_count - threads.size();
-		for (idx_t i = 0; i < create_new_threads; i++) {
-			// launch a thread and assign it a cancellation marker
-			auto marker = unique_ptr<bool>(new bool(true));
-			auto worker_thread = make_unique<thread>(ThreadExecuteTasks, this, marker.get());
-			auto thread_wrapper = make_unique<SchedulerThread>(move(worker_thread));
-
-			threads.push_back(move(thread_wrapper));
-			markers.push_back(move(marker));
-		}
-	} else if (threads.size() > new_thread_count) {
-		// we are reducing the number of threads: cancel any threads exceeding new_thread_count
+	auto old_queues = std::atomic_load(&worker_queues);
+	if (new_thread_count < threads.size()) {
+		// shrinking: only the surplus workers are retired, the other workers keep running their tasks
+		auto new_queues = make_shared<vector<shared_ptr<WorkerQueue>>>(old_queues->begin(),
+		                                                               old_queues->begin() + new_thread_count);
+		std::atomic_store(&worker_queues, new_queues);
 		for (idx_t i = new_thread_count; i < threads.size(); i++) {
 			*markers[i] = false;
 		}
-		// now join the threads to ensure they are fully stopped before erasing them
+		// join the retired threads to ensure they are fully stopped before erasing them
 		for (idx_t i = new_thread_count; i < threads.size(); i++) {
 			threads[i]->internal_thread->join();
 		}
-		// erase the threads/markers
-		threads.resize(new_thread_count);
-		markers.resize(new_thread_count);
+		threads.erase(threads.begin() + new_thread_count, threads.end());
+		markers.erase(markers.begin() + new_thread_count, markers.end());
+		// move any tasks that are left in the local queues of the retired workers to the shared queue
+		for (idx_t i = new_thread_count; i < old_queues->size(); i++) {
+			auto &worker_queue = *(*old_queues)[i];
+			lock_guard<mutex> guard(worker_queue.lock);
+			for (auto &entry : worker_queue.tasks) {
+				queue->Enqueue(*entry.group, move(entry.task));
+			}
+			worker_queue.tasks.clear();
+		}
+		return;
+	}
+	// growing: add the new workers and their local queues, the running workers are not interrupted
+	auto new_queues = make_shared<vector<shared_ptr<WorkerQueue>>>(*old_queues);
+	for (idx_t i = threads.size(); i < new_thread_count; i++) {
+		new_queues->push_back(make_shared<WorkerQueue>());
+	}
+	std::atomic_store(&worker_queues, new_queues);
+
+	vector<vector<idx_t>> numa_nodes;
+#ifdef __linux__
+	if (numa_affinity) {
+		numa_nodes = GetNUMANodes();
+	}
+#endif
+	for (idx_t i = threads.size(); i < new_thread_count; i++) {
+		// divide the workers evenly over the NUMA nodes, adjacent workers are placed on the same node
+		vector<idx_t> cpus;
+		if (!numa_nodes.empty()) {
+			cpus = numa_nodes[i * numa_nodes.size() / new_thread_count];
+		}
+		// launch a thread and assign it a cancellation marker
+		auto marker = unique_ptr<bool>(new bool(true));
+		auto worker_thread = make_unique<thread>(ThreadExecuteTasks, this, (*new_queues)[i].get(), marker.get(), i,
+		                                         move(cpus));
+		auto thread_wrapper = make_unique<SchedulerThread>(move(worker_thread));
+
+		threads.push_back(move(thread_wrapper));
+		markers.push_back(move(marker));
 	}
 #endif
 }
@@ -121,7 +121,7 @@ BindResult SelectBinder::BindWindow(WindowExpression &window, idx_t depth) {
 	for (auto &order : window.orders) {
 		auto type = order.type == OrderType::ORDER_DEFAULT ? config.default_order_type : order.type;
 		auto null_order =
-		    order.null_order == OrderByNullType::ORDER_DEFAULT ? config.default_null_order : order.null_order;
+		    order.null_order == OrderByNullType::ORDER_DEFAULT ? config.GetDefaultNullOrder(type) : order.null_order;
 		auto expression = GetExpression(order.expression);
 		result->orders.emplace_back(type, null_order, move(expression));
 	}
@@ -91,8 +91,10 @@ void Binder::BindModifiers(OrderBinder &order_binder, QueryNode &statement, Boun
 					continue;
 				}
 				auto type = order_node.type == OrderType::ORDER_DEFAULT ? config.default_order_type : order_node.type;
-				auto null_order = order_node.null_order == OrderByNullType::ORDER_DEFAULT ? config.default_null_order
-				                                                                          : order_node.null_order;
+				auto null_order = order_node.null_order;
+				if (null_order == OrderByNullType::ORDER_DEFAULT) {
+					null_order = config.GetDefaultNullOrder(type);
+				}
 				bound_order->orders.emplace_back(type, null_order, move(order_expression));
 			}
 			if (!bound_order->orders.empty()) {
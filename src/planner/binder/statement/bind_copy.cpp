@@ -38,10 +38,67 @@ BoundStatement Binder::BindCopyTo(CopyStatement &stmt) {
 		throw NotImplementedException("COPY TO is not supported for FORMAT \"%s\"", stmt.info->format);
 	}
 
-	auto function_data =
-	    copy_function->function.copy_to_bind(context, *stmt.info, select_node.names, select_node.types);
+	// the partitioning options are handled by the copy operator rather than by the copy function
+	auto info = stmt.info->Copy();
+	vector<idx_t> partition_columns;
+	idx_t max_open_files = LogicalCopyToFile::DEFAULT_MAX_OPEN_FILES;
+	for (auto option = info->options.begin(); option != info->options.end();) {
+		auto loption = StringUtil::Lower(option->first);
+		if (loption == "partition_by") {
+			for (auto &partition : option->second) {
+				auto partition_name = partition.ToString();
+				auto entry = std::find_if(select_node.names.begin(), select_node.names.end(), [&](const string &name) {
+					return StringUtil::Lower(name) == StringUtil::Lower(partition_name);
+				});
+				if (entry == select_node.names.end()) {
+					throw BinderException("PARTITION_BY column \"%s\" not found in the query", partition_name);
+				}
+				auto column_idx = entry - select_node.names.begin();
+				if (select_node.types[column_idx].InternalType() == PhysicalType::STRUCT ||
+				    select_node.types[column_idx].InternalType() == PhysicalType::LIST) {
+					throw BinderException("Cannot partition by column \"%s\" of type %s", partition_name,
+					                      select_node.types[column_idx].ToString());
+				}
+				partition_columns.push_back(column_idx);
+			}
+			if (partition_columns.empty()) {
+				throw BinderException("PARTITION_BY requires at least one column");
+			}
+		} else if (loption == "max_open_files") {
+			if (option->second.size() != 1) {
+				throw BinderException("MAX_OPEN_FILES requires a single argument");
+			}
+			auto value = option->second[0].CastAs(LogicalType::BIGINT).GetValue<int64_t>();
+			if (value <= 0) {
+				throw BinderException("MAX_OPEN_FILES must be a positive number of files");
+			}
+			max_open_files = value;
+		} else {
+			option++;
+			continue;
+		}
+		option = info->options.erase(option);
+	}
+	// the partition columns are encoded in the directories, the files contain the remaining columns
+	auto names = select_node.names;
+	auto types = select_node.types;
+	for (idx_t i = select_node.names.size(); i > 0; i--) {
+		if (std::find(partition_columns.begin(), partition_columns.end(), i - 1) != partition_columns.end()) {
+			names.erase(names.begin() + i - 1);
+			types.erase(types.begin() + i - 1);
+		}
+	}
+	if (!partition_columns.empty() && names.empty()) {
+		throw BinderException("PARTITION_BY requires at least one column that is not partitioned by");
+	}
+
+	auto function_data = copy_function->function.copy_to_bind(context, *info, names, types);
 	// now create the copy information
 	auto copy = make_unique<LogicalCopyToFile>(copy_function->function, move(function_data));
+	copy->file_path = info->file_path;
+	copy->names = select_node.names;
+	copy->partition_columns = move(partition_columns);
+	copy->max_open_files = max_open_files;
 	copy->AddChild(move(select_node.plan));
 
 	result.plan = move(copy);
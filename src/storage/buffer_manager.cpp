@@ -3,7 +3,14 @@
 #include "duckdb/storage/storage_manager.hpp"
 
 #include "duckdb/common/exception.hpp"
+#include "duckdb/main/config.hpp"
+#include "duckdb/main/database.hpp"
 #include "duckdb/parallel/concurrentqueue.hpp"
+#include "duckdb/parallel/task_scheduler.hpp"
+
+#include <condition_variable>
+#include <queue>
+#include <thread>
 
 namespace duckdb {
 
@@ -15,6 +22,8 @@ BlockHandle::BlockHandle(DatabaseInstance &db, block_id_t block_id_p) : db(db) {
 	state = BlockState::BLOCK_UNLOADED;
 	can_destroy = false;
 	memory_usage = Storage::BLOCK_ALLOC_SIZE;
+	access_count = 0;
+	use_once = false;
 }
 
 BlockHandle::BlockHandle(DatabaseInstance &db, block_id_t block_id_p, unique_ptr<FileBuffer> buffer_p,
@@ -28,6 +37,8 @@ BlockHandle::BlockHandle(DatabaseInstance &db, block_id_t block_id_p, unique_ptr
 	state = BlockState::BLOCK_LOADED;
 	can_destroy = can_destroy_p;
 	memory_usage = alloc_size;
+	access_count = 0;
+	use_once = false;
 }
 
 BlockHandle::~BlockHandle() {
@@ -37,6 +48,9 @@ BlockHandle::~BlockHandle() {
 		// the block is still loaded in memory: erase it
 		buffer.reset();
 		buffer_manager.current_memory -= memory_usage;
+		if (budget) {
+			budget->used -= memory_usage;
+		}
 	}
 	buffer_manager.UnregisterBlock(block_id, can_destroy);
 }
@@ -52,10 +66,8 @@ unique_ptr<BufferHandle> BlockHandle::Load(shared_ptr<BlockHandle> &handle) {
 	auto &buffer_manager = BufferManager::GetBufferManager(handle->db);
 	auto &block_manager = BlockManager::GetBlockManager(handle->db);
 	if (handle->block_id < MAXIMUM_BLOCK) {
-		// FIXME: currently we still require a lock for reading blocks from disk
-		// this is mainly down to the block manager only having a single pointer into the file
-		// this is relatively easy to fix later on
-		lock_guard<mutex> buffer_lock(buffer_manager.manager_lock);
+		// the block manager reads with positional I/O, so blocks can be read from disk concurrently
+		// concurrent loads of the same block are prevented by the block-level lock that is held while pinning
 		auto block = make_unique<Block>(handle->block_id);
 		block_manager.Read(*block);
 		handle->buffer = move(block);
@@ -85,6 +97,9 @@ void BlockHandle::Unload() {
 	}
 	buffer.reset();
 	buffer_manager.current_memory -= memory_usage;
+	if (budget) {
+		budget->used -= memory_usage;
+	}
 }
 
 bool BlockHandle::CanUnload() {
@@ -126,13 +141,83 @@ struct BufferEvictionNode {
 
 typedef moodycamel::ConcurrentQueue<unique_ptr<BufferEvictionNode>> eviction_queue_t;
 
+//! The eviction queues of the buffer manager (a simplified 2Q policy). Unpinned blocks that have been accessed at
+//! most once are placed in the cold queue, blocks that have been accessed repeatedly are placed in the hot queue.
+//! Blocks are evicted from the cold queue first. Entries are never removed from the queues when a block is pinned
+//! again: instead, stale entries are recognized by their eviction timestamp and skipped.
 struct EvictionQueue {
-	eviction_queue_t q;
+	eviction_queue_t cold;
+	eviction_queue_t hot;
+};
+
+MemoryBudget::MemoryBudget(idx_t limit) : limit(limit), used(0), queue(make_unique<EvictionQueue>()) {
+}
+
+MemoryBudget::~MemoryBudget() {
+}
+
+//! The BlockPrefetcher reads the blocks that are passed to BufferManager::Prefetch using a small set of background
+//! threads. The blocks are loaded into free memory of the buffer pool and left unpinned. The amount of threads
+//! follows the prefetch distance (and the amount of worker threads), threads are only added when it grows.
+struct BlockPrefetcher {
+	//! The maximum amount of pending prefetches, further prefetch requests are dropped
+	static constexpr idx_t MAXIMUM_PENDING_PREFETCHES = 1024;
+
+	explicit BlockPrefetcher(BufferManager &buffer_manager) : buffer_manager(buffer_manager), shutdown(false) {
+	}
+	~BlockPrefetcher() {
+		{
+			lock_guard<mutex> guard(lock);
+			shutdown = true;
+		}
+		pending_cv.notify_all();
+		for (auto &thread : threads) {
+			thread.join();
+		}
+	}
+
+	void Schedule(weak_ptr<BlockHandle> block, idx_t thread_count) {
+		{
+			lock_guard<mutex> guard(lock);
+			if (pending.size() >= MAXIMUM_PENDING_PREFETCHES) {
+				return;
+			}
+			while (threads.size() < thread_count) {
+				threads.emplace_back([this]() { Work(); });
+			}
+			pending.push(move(block));
+		}
+		pending_cv.notify_one();
+	}
+
+	void Work() {
+		while (true) {
+			weak_ptr<BlockHandle> block;
+			{
+				std::unique_lock<mutex> guard(lock);
+				pending_cv.wait(guard, [this]() { return shutdown || !pending.empty(); });
+				if (shutdown) {
+					return;
+				}
+				block = move(pending.front());
+				pending.pop();
+			}
+			buffer_manager.LoadPrefetchedBlock(block);
+		}
+	}
+
+	BufferManager &buffer_manager;
+	mutex lock;
+	std::condition_variable pending_cv;
+	std::queue<weak_ptr<BlockHandle>> pending;
+	bool shutdown;
+	vector<std::thread> threads;
 };
 
 BufferManager::BufferManager(DatabaseInstance &db, string tmp, idx_t maximum_memory)
     : db(db), current_memory(0), maximum_memory(maximum_memory), temp_directory(move(tmp)),
-      queue(make_unique<EvictionQueue>()), temporary_id(MAXIMUM_BLOCK) {
+      queue(make_unique<EvictionQueue>()), temporary_id(MAXIMUM_BLOCK), read_wait_time(0), block_hits(0),
+      block_misses(0), block_evictions(0) {
 	auto &fs = FileSystem::GetFileSystem(db);
 	if (!temp_directory.empty()) {
 		fs.CreateDirectory(temp_directory);
@@ -140,6 +225,8 @@ BufferManager::BufferManager(DatabaseInstance &db, string tmp, idx_t maximum_mem
 }
 
 BufferManager::~BufferManager() {
+	// stop the prefetch threads before anything else is torn down
+	prefetcher.reset();
 	auto &fs = FileSystem::GetFileSystem(db);
 	if (!temp_directory.empty()) {
 		fs.RemoveDirectory(temp_directory);
@@ -165,9 +252,40 @@ shared_ptr<BlockHandle> BufferManager::RegisterBlock(block_id_t block_id) {
 	return result;
 }
 
+//! The memory budget of the query that the current thread is working on
+static thread_local shared_ptr<MemoryBudget> thread_memory_budget;
+//! The time (in microseconds) that scans on the current thread have spent waiting for blocks to be read
+static thread_local idx_t thread_read_wait_time = 0;
+
+void BufferManager::AddReadWaitTime(idx_t microseconds) {
+	read_wait_time += microseconds;
+	thread_read_wait_time += microseconds;
+}
+
+idx_t BufferManager::GetThreadReadWaitTime() {
+	return thread_read_wait_time;
+}
+
+shared_ptr<MemoryBudget> BufferManager::SetThreadMemoryBudget(shared_ptr<MemoryBudget> budget) {
+	auto previous_budget = move(thread_memory_budget);
+	thread_memory_budget = move(budget);
+	return previous_budget;
+}
+
 shared_ptr<BlockHandle> BufferManager::RegisterMemory(idx_t alloc_size, bool can_destroy) {
+	// charge the buffer to the memory budget of the current query (if any)
+	auto budget = thread_memory_budget;
+	if (budget && !ReserveBudgetMemory(*budget, alloc_size)) {
+		throw OutOfRangeException(
+		    "Not enough memory to complete operation: could not allocate block of %lld bytes within the query memory "
+		    "limit of %lld bytes",
+		    alloc_size, budget->limit);
+	}
 	// first evict blocks until we have enough memory to store this buffer
 	if (!EvictBlocks(alloc_size, maximum_memory)) {
+		if (budget) {
+			budget->used -= alloc_size;
+		}
 		throw OutOfRangeException("Not enough memory to complete operation: could not allocate block of %lld bytes",
 		                          alloc_size);
 	}
@@ -177,7 +295,9 @@ shared_ptr<BlockHandle> BufferManager::RegisterMemory(idx_t alloc_size, bool can
 	auto buffer = make_unique<ManagedBuffer>(db, alloc_size, can_destroy, temp_id);
 
 	// create a new block pointer for this block
-	return make_shared<BlockHandle>(db, temp_id, move(buffer), can_destroy, alloc_size);
+	auto result = make_shared<BlockHandle>(db, temp_id, move(buffer), can_destroy, alloc_size);
+	result->budget = move(budget);
+	return result;
 }
 
 unique_ptr<BufferHandle> BufferManager::Allocate(idx_t alloc_size) {
@@ -191,11 +311,25 @@ unique_ptr<BufferHandle> BufferManager::Pin(shared_ptr<BlockHandle> &handle) {
 	// check if the block is already loaded
 	if (handle->state == BlockState::BLOCK_LOADED) {
 		// the block is loaded, increment the reader count and return a pointer to the handle
+		block_hits++;
 		handle->readers++;
 		return handle->Load(handle);
 	}
+	if (handle->block_id >= MAXIMUM_BLOCK && handle->can_destroy) {
+		// the buffer was destroyed when it was evicted: there is nothing to reload
+		return nullptr;
+	}
+	block_misses++;
+	if (handle->budget && !ReserveBudgetMemory(*handle->budget, handle->memory_usage)) {
+		throw OutOfRangeException("Not enough memory to complete operation: failed to pin block within the query "
+		                          "memory limit of %lld bytes",
+		                          handle->budget->limit);
+	}
 	// evict blocks until we have space for the current block
 	if (!EvictBlocks(handle->memory_usage, maximum_memory)) {
+		if (handle->budget) {
+			handle->budget->used -= handle->memory_usage;
+		}
 		throw OutOfRangeException("Not enough memory to complete operation: failed to pin block");
 	}
 	// now we can actually load the current block
@@ -208,40 +342,161 @@ void BufferManager::Unpin(shared_ptr<BlockHandle> &handle) {
 	lock_guard<mutex> lock(handle->lock);
 	D_ASSERT(handle->readers > 0);
 	handle->readers--;
+	if (handle->use_once) {
+		handle->use_once = false;
+	} else {
+		handle->access_count++;
+	}
 	if (handle->readers == 0) {
 		handle->eviction_timestamp++;
-		queue->q.enqueue(make_unique<BufferEvictionNode>(weak_ptr<BlockHandle>(handle), handle->eviction_timestamp));
+		auto node = make_unique<BufferEvictionNode>(weak_ptr<BlockHandle>(handle), handle->eviction_timestamp);
+		bool hot = handle->access_count > 1;
+		if (handle->budget) {
+			// the block is also added to the queues of its budget, whichever entry is dequeued first evicts it
+			auto budget_node =
+			    make_unique<BufferEvictionNode>(weak_ptr<BlockHandle>(handle), handle->eviction_timestamp);
+			auto &budget_queue = hot ? handle->budget->queue->hot : handle->budget->queue->cold;
+			budget_queue.enqueue(move(budget_node));
+		}
+		if (hot) {
+			queue->hot.enqueue(move(node));
+		} else {
+			queue->cold.enqueue(move(node));
+		}
 		// FIXME: do some house-keeping to prevent the queue from being flooded with many old blocks
 	}
 }
 
+void BufferManager::MarkUseOnce(BufferHandle &pin) {
+	auto &handle = pin.handle;
+	lock_guard<mutex> lock(handle->lock);
+	handle->use_once = true;
+}
+
+void BufferManager::Prefetch(block_id_t block_id) {
+	D_ASSERT(block_id < MAXIMUM_BLOCK);
+	lock_guard<mutex> lock(manager_lock);
+	auto entry = blocks.find(block_id);
+	if (entry == blocks.end() || entry->second.expired()) {
+		// the block is not in use: nothing to prefetch
+		return;
+	}
+#ifdef DUCKDB_NO_THREADS
+	return;
+#else
+	// there is no point in having more prefetch threads than blocks that are prefetched ahead of a scan
+	auto prefetch_blocks = DBConfig::GetConfig(db).prefetch_blocks;
+	auto thread_count = MinValue<idx_t>(prefetch_blocks, db.GetScheduler().NumberOfThreads());
+	if (!prefetcher) {
+		prefetcher = make_unique<BlockPrefetcher>(*this);
+	}
+	prefetcher->Schedule(entry->second, MaxValue<idx_t>(thread_count, 1));
+#endif
+}
+
+void BufferManager::LoadPrefetchedBlock(weak_ptr<BlockHandle> &block) {
+	auto handle = block.lock();
+	if (!handle) {
+		return;
+	}
+	unique_ptr<BufferHandle> pin;
+	{
+		lock_guard<mutex> lock(handle->lock);
+		if (handle->state == BlockState::BLOCK_LOADED) {
+			// already loaded (e.g. by the scan itself)
+			return;
+		}
+		// only prefetch into free memory: evicting other blocks to make room could evict blocks that the scan has
+		// prefetched but not read yet, which would then be read twice
+		if (!ReserveFreeMemory(handle->memory_usage)) {
+			return;
+		}
+		D_ASSERT(handle->readers == 0);
+		try {
+			handle->readers = 1;
+			pin = handle->Load(handle);
+		} catch (...) {
+			// prefetching is a best-effort optimization: if the block cannot be loaded the scan reads it itself
+			handle->state = BlockState::BLOCK_UNLOADED;
+			handle->buffer.reset();
+			handle->readers = 0;
+			current_memory -= handle->memory_usage;
+			return;
+		}
+		// the prefetch itself is not an access of the block: only the pin of the scan is counted
+		handle->use_once = true;
+	}
+	// unpinning adds the block to the eviction queue
+	pin.reset();
+}
+
+bool BufferManager::ReserveFreeMemory(idx_t memory) {
+	auto current = current_memory.load();
+	do {
+		if (current + memory > maximum_memory) {
+			return false;
+		}
+	} while (!current_memory.compare_exchange_weak(current, current + memory));
+	return true;
+}
+
+bool BufferManager::TryEvict(BufferEvictionNode &node) {
+	// get a reference to the underlying block pointer
+	auto handle = node.handle.lock();
+	if (!handle) {
+		return false;
+	}
+	if (!node.CanUnload(*handle)) {
+		// early out: we already know that we cannot unload this node
+		return false;
+	}
+	// we might be able to free this block: grab the mutex and check if we can free it
+	lock_guard<mutex> lock(handle->lock);
+	if (!node.CanUnload(*handle)) {
+		// something changed in the mean-time, bail out
+		return false;
+	}
+	// hooray, we can unload the block
+	// release the memory and mark the block as unloaded
+	handle->Unload();
+	block_evictions++;
+	return true;
+}
+
 bool BufferManager::EvictBlocks(idx_t extra_memory, idx_t memory_limit) {
 	unique_ptr<BufferEvictionNode> node;
 	current_memory += extra_memory;
 	while (current_memory > memory_limit) {
-		// get a block to unpin from the queue
-		if (!queue->q.try_dequeue(node)) {
+		// get a block to unpin from the queues: blocks that have not been accessed repeatedly go first
+		if (!queue->cold.try_dequeue(node) && !queue->hot.try_dequeue(node)) {
 			current_memory -= extra_memory;
 			return false;
 		}
-		// get a reference to the underlying block pointer
-		auto handle = node->handle.lock();
-		if (!handle) {
-			continue;
-		}
-		if (!node->CanUnload(*handle)) {
-			// early out: we already know that we cannot unload this node
-			continue;
-		}
-		// we might be able to free this block: grab the mutex and check if we can free it
-		lock_guard<mutex> lock(handle->lock);
-		if (!node->CanUnload(*handle)) {
-			// something changed in the mean-time, bail out
-			continue;
+		TryEvict(*node);
+	}
+	return true;
+}
+
+bool BufferManager::EvictBudgetBlocks(MemoryBudget &budget) {
+	unique_ptr<BufferEvictionNode> node;
+	while (budget.used > budget.limit) {
+		// the queues of the budget only contain blocks of the budget: blocks that have not been accessed repeatedly go
+		// first
+		if (!budget.queue->cold.try_dequeue(node) && !budget.queue->hot.try_dequeue(node)) {
+			return false;
 		}
-		// hooray, we can unload the block
-		// release the memory and mark the block as unloaded
-		handle->Unload();
+		TryEvict(*node);
+	}
+	return true;
+}
+
+bool BufferManager::ReserveBudgetMemory(MemoryBudget &budget, idx_t memory) {
+	budget.used += memory;
+	// only the result of the eviction is checked: other threads of the query can charge the budget concurrently, in
+	// which case they evict blocks for their own memory
+	if (!EvictBudgetBlocks(budget)) {
+		budget.used -= memory;
+		return false;
 	}
 	return true;
 }
@@ -6,6 +6,8 @@
 #include "duckdb/catalog/catalog_entry/table_catalog_entry.hpp"
 #include "duckdb/common/serializer/buffered_serializer.hpp"
 
+#include "duckdb/main/config.hpp"
+#include "duckdb/storage/compressed_segment.hpp"
 #include "duckdb/storage/numeric_segment.hpp"
 #include "duckdb/storage/string_segment.hpp"
 #include "duckdb/storage/table/column_segment.hpp"
@@ -51,6 +53,7 @@ void TableDataWriter::WriteTableData() {
 	// allocate the initial segments
 	segments.resize(table.columns.size());
 	data_pointers.resize(table.columns.size());
+	compression_types.resize(table.columns.size(), CompressionType::COMPRESSION_UNCOMPRESSED);
 	stats.reserve(table.columns.size());
 	column_stats.reserve(table.columns.size());
 	for (idx_t i = 0; i < table.columns.size(); i++) {
@@ -76,6 +79,8 @@ void TableDataWriter::CreateSegment(idx_t col_idx) {
 		auto string_segment = make_unique<StringSegment>(db, 0);
 		string_segment->overflow_writer = make_unique<WriteOverflowStringsToDisk>(db);
 		segments[col_idx] = move(string_segment);
+	} else if (compression_types[col_idx] != CompressionType::COMPRESSION_UNCOMPRESSED) {
+		segments[col_idx] = make_unique<CompressedSegment>(db, type_id, 0, compression_types[col_idx]);
 	} else {
 		segments[col_idx] = make_unique<NumericSegment>(db, type_id, 0);
 	}
@@ -87,6 +92,14 @@ void TableDataWriter::CheckpointColumn(ColumnData &col_data, idx_t col_idx) {
 	}
 	Vector intermediate(col_data.type);
 
+	// figure out which compression to use for the segments we are going to write
+	D_ASSERT(segments[col_idx]->tuple_count == 0);
+	auto compression = AnalyzeColumn(col_data, col_idx);
+	if (compression != compression_types[col_idx]) {
+		compression_types[col_idx] = compression;
+		CreateSegment(col_idx);
+	}
+
 	// scan the segments of the column data
 	// we create a new segment tree with all the new segments
 	SegmentTree new_tree;
@@ -110,6 +123,7 @@ void TableDataWriter::CheckpointColumn(ColumnData &col_data, idx_t col_idx) {
 				DataPointer pointer;
 				pointer.block_id = persistent.block_id;
 				pointer.offset = 0;
+				pointer.compression = persistent.compression;
 				pointer.row_start = segment->start;
 				pointer.tuple_count = persistent.count;
 				pointer.statistics = persistent.stats.statistics->Copy();
@@ -150,6 +164,44 @@ void TableDataWriter::CheckpointColumn(ColumnData &col_data, idx_t col_idx) {
 	col_data.data.Replace(new_tree);
 }
 
+CompressionType TableDataWriter::AnalyzeColumn(ColumnData &col_data, idx_t col_idx) {
+	auto type = col_data.type.InternalType();
+	// every type that can be compressed supports RLE
+	if (!CompressedSegment::SupportsCompression(type, CompressionType::COMPRESSION_RLE)) {
+		return CompressionType::COMPRESSION_UNCOMPRESSED;
+	}
+	auto &config = DBConfig::GetConfig(db);
+	if (config.force_compression != CompressionType::COMPRESSION_AUTO) {
+		// the compression type is forced
+		if (config.force_compression == CompressionType::COMPRESSION_UNCOMPRESSED ||
+		    !CompressedSegment::SupportsCompression(type, config.force_compression)) {
+			return CompressionType::COMPRESSION_UNCOMPRESSED;
+		}
+		return config.force_compression;
+	}
+	// scan all the segments that have to be rewritten and compute their compressed size for each compression type
+	CompressionAnalyzer analyzer(type);
+	Vector intermediate(col_data.type);
+	Vector scan_vector(col_data.type);
+	auto segment = (ColumnSegment *)col_data.data.root_node.get();
+	for (; segment; segment = (ColumnSegment *)segment->next.get()) {
+		if (segment->segment_type == ColumnSegmentType::PERSISTENT && !((PersistentSegment &)*segment).HasChanges()) {
+			// unchanged persistent segments are not rewritten
+			continue;
+		}
+		ColumnScanState state;
+		segment->InitializeScan(state);
+		for (idx_t vector_index = 0; vector_index * STANDARD_VECTOR_SIZE < segment->count; vector_index++) {
+			scan_vector.Reference(intermediate);
+
+			idx_t count = MinValue<idx_t>(segment->count - vector_index * STANDARD_VECTOR_SIZE, STANDARD_VECTOR_SIZE);
+			segment->ScanCommitted(state, vector_index, scan_vector);
+			analyzer.Analyze(scan_vector, count);
+		}
+	}
+	return analyzer.GetBestCompression();
+}
+
 void TableDataWriter::CheckpointDeletes(MorselInfo *morsel_info) {
 	// deletes! write them after the data pointers
 	while (morsel_info) {
@@ -207,6 +259,10 @@ void TableDataWriter::FlushSegment(SegmentTree &new_tree, idx_t col_idx) {
 	auto &buffer_manager = BufferManager::GetBufferManager(db);
 	auto &block_manager = BlockManager::GetBlockManager(db);
 
+	auto compression = compression_types[col_idx];
+	if (compression != CompressionType::COMPRESSION_UNCOMPRESSED) {
+		((CompressedSegment &)*segments[col_idx]).FinalizeAppend();
+	}
 	auto handle = buffer_manager.Pin(segments[col_idx]->block);
 
 	// get a free block id to write to
@@ -218,6 +274,7 @@ void TableDataWriter::FlushSegment(SegmentTree &new_tree, idx_t col_idx) {
 	DataPointer data_pointer;
 	data_pointer.block_id = block_id;
 	data_pointer.offset = offset_in_block;
+	data_pointer.compression = compression;
 	data_pointer.row_start = 0;
 	if (!data_pointers[col_idx].empty()) {
 		auto &last_pointer = data_pointers[col_idx].back();
@@ -229,7 +286,7 @@ void TableDataWriter::FlushSegment(SegmentTree &new_tree, idx_t col_idx) {
 	// construct a persistent segment that points to this block, and append it to the new segment tree
 	auto persistent_segment = make_unique<PersistentSegment>(db, block_id, offset_in_block, table.columns[col_idx].type,
 	                                                         data_pointer.row_start, data_pointer.tuple_count,
-	                                                         stats[col_idx]->statistics->Copy());
+	                                                         stats[col_idx]->statistics->Copy(), compression);
 	new_tree.AppendSegment(move(persistent_segment));
 
 	data_pointers[col_idx].push_back(move(data_pointer));
@@ -283,6 +340,7 @@ void TableDataWriter::WriteDataPointers() {
 			meta_writer.Write<idx_t>(data_pointer.tuple_count);
 			meta_writer.Write<block_id_t>(data_pointer.block_id);
 			meta_writer.Write<uint32_t>(data_pointer.offset);
+			meta_writer.Write<uint8_t>((uint8_t)data_pointer.compression);
 			data_pointer.statistics->Serialize(meta_writer);
 		}
 	}
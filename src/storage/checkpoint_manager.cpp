@@ -26,6 +26,7 @@
 
 #include "duckdb/transaction/transaction_manager.hpp"
 
+#include "duckdb/storage/data_table.hpp"
 #include "duckdb/storage/checkpoint/table_data_writer.hpp"
 #include "duckdb/storage/checkpoint/table_data_reader.hpp"
 #include "duckdb/main/config.hpp"
@@ -258,6 +259,23 @@ void CheckpointManager::WriteTable(TableCatalogEntry &table) {
 	// now we need to write the table data
 	TableDataWriter writer(db, table, *tabledata_writer);
 	writer.WriteTableData();
+
+	// finally write the indexes of the UNIQUE and PRIMARY KEY constraints
+	// these are created together with the table, so they are the first indexes of the table
+	idx_t index_count = 0;
+	for (auto &constraint : table.bound_constraints) {
+		if (constraint->type == ConstraintType::UNIQUE) {
+			index_count++;
+		}
+	}
+	auto &indexes = table.storage->info->indexes;
+	D_ASSERT(index_count <= indexes.size());
+	metadata_writer->Write<uint32_t>(index_count);
+	for (idx_t i = 0; i < index_count; i++) {
+		auto pointer = indexes[i]->Serialize(*tabledata_writer);
+		metadata_writer->Write<block_id_t>(pointer.block_id);
+		metadata_writer->Write<uint32_t>(pointer.offset);
+	}
 }
 
 void CheckpointManager::ReadTable(ClientContext &context, MetaBlockReader &reader) {
@@ -275,6 +293,15 @@ void CheckpointManager::ReadTable(ClientContext &context, MetaBlockReader &reade
 	TableDataReader data_reader(db, table_data_reader, *bound_info);
 	data_reader.ReadTableData();
 
+	// read the pointers to the indexes of the table, the indexes are read from disk when the table is created
+	auto index_count = reader.Read<uint32_t>();
+	for (idx_t i = 0; i < index_count; i++) {
+		BlockPointer pointer;
+		pointer.block_id = reader.Read<block_id_t>();
+		pointer.offset = reader.Read<uint32_t>();
+		bound_info->data->indexes.push_back(pointer);
+	}
+
 	// finally create the table in the catalog
 	auto &catalog = Catalog::GetCatalog(db);
 	catalog.CreateTable(context, bound_info.get());
@@ -5,6 +5,9 @@
 #include "duckdb/storage/storage_manager.hpp"
 #include "duckdb/storage/data_pointer.hpp"
 #include "duckdb/storage/checkpoint/table_data_writer.hpp"
+#include "duckdb/storage/compressed_segment.hpp"
+#include "duckdb/common/profiler.hpp"
+#include "duckdb/main/config.hpp"
 
 namespace duckdb {
 
@@ -20,10 +23,25 @@ void ColumnData::Initialize(vector<unique_ptr<PersistentSegment>> &segments) {
 	}
 }
 
+//! Scans of columns that take up more than this fraction of the memory limit pin their blocks as use-once, so that the
+//! scan does not evict the blocks that are used by other queries
+static constexpr idx_t USE_ONCE_SCAN_MEMORY_FRACTION = 4;
+
+static bool ScanIsUseOnce(DatabaseInstance &db, SegmentTree &data) {
+	auto max_memory = BufferManager::GetBufferManager(db).GetMaxMemory();
+	if (max_memory == (idx_t)-1) {
+		return false;
+	}
+	lock_guard<mutex> tree_lock(data.node_lock);
+	return data.nodes.size() * Storage::BLOCK_ALLOC_SIZE > max_memory / USE_ONCE_SCAN_MEMORY_FRACTION;
+}
+
 void ColumnData::InitializeScan(ColumnScanState &state) {
 	state.current = (ColumnSegment *)data.GetRootSegment();
 	state.vector_index = 0;
 	state.initialized = false;
+	state.last_prefetched = nullptr;
+	state.use_once = ScanIsUseOnce(db, data);
 }
 
 void ColumnData::InitializeScanWithOffset(ColumnScanState &state, idx_t vector_idx) {
@@ -31,13 +49,55 @@ void ColumnData::InitializeScanWithOffset(ColumnScanState &state, idx_t vector_i
 	state.current = (ColumnSegment *)data.GetSegment(row_idx);
 	state.vector_index = (row_idx - state.current->start) / STANDARD_VECTOR_SIZE;
 	state.initialized = false;
+	state.last_prefetched = nullptr;
+	state.use_once = ScanIsUseOnce(db, data);
 }
 
-void ColumnData::Scan(Transaction &transaction, ColumnScanState &state, Vector &result) {
-	if (!state.initialized) {
+//! Issue prefetches for the blocks of the persistent segments that follow the current segment of the scan
+static void PrefetchSegments(BufferManager &buffer_manager, ColumnScanState &state, idx_t prefetch_blocks) {
+	auto segment = (ColumnSegment *)state.current->next.get();
+	for (idx_t i = 0; segment && i < prefetch_blocks; i++) {
+		if (!state.last_prefetched || segment->start > state.last_prefetched->start) {
+			if (segment->segment_type == ColumnSegmentType::PERSISTENT) {
+				auto block_id = ((PersistentSegment *)segment)->block_id;
+				if (block_id < MAXIMUM_BLOCK) {
+					buffer_manager.Prefetch(block_id);
+				}
+			}
+			state.last_prefetched = segment;
+		}
+		segment = (ColumnSegment *)segment->next.get();
+	}
+}
+
+void ColumnData::InitializeSegmentScan(ColumnScanState &state) {
+	if (state.initialized) {
+		return;
+	}
+	if (state.current->segment_type != ColumnSegmentType::PERSISTENT) {
 		state.current->InitializeScan(state);
 		state.initialized = true;
+		return;
 	}
+	auto &buffer_manager = BufferManager::GetBufferManager(db);
+	auto prefetch_blocks = DBConfig::GetConfig(db).prefetch_blocks;
+	if (prefetch_blocks > 0) {
+		PrefetchSegments(buffer_manager, state, prefetch_blocks);
+	}
+	// initializing the scan of a persistent segment pins its block: time how long the scan waits for the block
+	Profiler read_timer;
+	read_timer.Start();
+	state.current->InitializeScan(state);
+	read_timer.End();
+	buffer_manager.AddReadWaitTime(read_timer.Elapsed() * 1000000);
+	if (state.use_once && state.primary_handle) {
+		buffer_manager.MarkUseOnce(*state.primary_handle);
+	}
+	state.initialized = true;
+}
+
+void ColumnData::Scan(Transaction &transaction, ColumnScanState &state, Vector &result) {
+	InitializeSegmentScan(state);
 	// perform a scan of this segment
 	state.current->Scan(transaction, state, state.vector_index, result);
 	// move over to the next vector
@@ -46,10 +106,7 @@ void ColumnData::Scan(Transaction &transaction, ColumnScanState &state, Vector &
 
 void ColumnData::FilterScan(Transaction &transaction, ColumnScanState &state, Vector &result, SelectionVector &sel,
                             idx_t &approved_tuple_count) {
-	if (!state.initialized) {
-		state.current->InitializeScan(state);
-		state.initialized = true;
-	}
+	InitializeSegmentScan(state);
 	// perform a scan of this segment
 	state.current->FilterScan(transaction, state, result, sel, approved_tuple_count);
 	// move over to the next vector
@@ -58,10 +115,7 @@ void ColumnData::FilterScan(Transaction &transaction, ColumnScanState &state, Ve
 
 void ColumnData::Select(Transaction &transaction, ColumnScanState &state, Vector &result, SelectionVector &sel,
                         idx_t &approved_tuple_count, vector<TableFilter> &table_filter) {
-	if (!state.initialized) {
-		state.current->InitializeScan(state);
-		state.initialized = true;
-	}
+	InitializeSegmentScan(state);
 	// perform a scan of this segment
 	state.current->Select(transaction, state, result, sel, approved_tuple_count, table_filter);
 	// move over to the next vector
@@ -69,10 +123,7 @@ void ColumnData::Select(Transaction &transaction, ColumnScanState &state, Vector
 }
 
 void ColumnData::IndexScan(ColumnScanState &state, Vector &result) {
-	if (!state.initialized) {
-		state.current->InitializeScan(state);
-		state.initialized = true;
-	}
+	InitializeSegmentScan(state);
 	// perform a scan of this segment
 	state.current->IndexScan(state, result);
 	// move over to the next vector
@@ -195,6 +246,47 @@ void ColumnData::FetchRow(ColumnFetchState &state, Transaction &transaction, row
 	segment->FetchRow(state, transaction, row_id, result, result_idx);
 }
 
+void ColumnData::GetStorageInfo(vector<vector<Value>> &result) {
+	idx_t segment_idx = 0;
+	auto segment = (ColumnSegment *)data.GetRootSegment();
+	for (; segment; segment = (ColumnSegment *)segment->next.get(), segment_idx++) {
+		bool persistent = segment->segment_type == ColumnSegmentType::PERSISTENT;
+		UncompressedSegment *segment_data;
+		Value block_id;
+		if (persistent) {
+			auto &persistent_segment = (PersistentSegment &)*segment;
+			segment_data = persistent_segment.data.get();
+			block_id = Value::BIGINT(persistent_segment.block_id);
+		} else {
+			segment_data = ((TransientSegment &)*segment).data.get();
+		}
+		idx_t vector_count = (segment->count + STANDARD_VECTOR_SIZE - 1) / STANDARD_VECTOR_SIZE;
+		idx_t uncompressed_size = vector_count * segment_data->vector_size;
+		idx_t compressed_size = uncompressed_size;
+		auto compression = CompressionType::COMPRESSION_UNCOMPRESSED;
+		if (persistent && ((PersistentSegment &)*segment).compression != CompressionType::COMPRESSION_UNCOMPRESSED) {
+			auto &compressed_segment = (CompressedSegment &)*segment_data;
+			compression = compressed_segment.GetCompressionType();
+			if (compression != CompressionType::COMPRESSION_UNCOMPRESSED) {
+				compressed_size = compressed_segment.GetCompressedSize();
+			}
+		}
+		vector<Value> row;
+		row.push_back(Value::BIGINT(column_idx));
+		row.push_back(Value::BIGINT(segment_idx));
+		row.push_back(Value(type.ToString()));
+		row.push_back(Value::BIGINT(segment->start));
+		row.push_back(Value::BIGINT(segment->count));
+		row.push_back(Value(CompressionTypeToString(compression)));
+		row.push_back(Value::BOOLEAN(persistent));
+		row.push_back(block_id);
+		row.push_back(Value::BIGINT(compressed_size));
+		row.push_back(Value::BIGINT(uncompressed_size));
+		row.push_back(Value::DOUBLE(compressed_size == 0 ? 1 : double(uncompressed_size) / double(compressed_size)));
+		result.push_back(move(row));
+	}
+}
+
 void ColumnData::AppendTransientSegment(idx_t start_row) {
 	auto new_segment = make_unique<TransientSegment>(db, type, start_row);
 	data.AppendSegment(move(new_segment));
@@ -0,0 +1,757 @@
+#include "duckdb/storage/compressed_segment.hpp"
+
+#include "duckdb/common/exception.hpp"
+#include "duckdb/common/types/vector.hpp"
+#include "duckdb/planner/table_filter.hpp"
+#include "duckdb/storage/buffer_manager.hpp"
+#include "duckdb/storage/table/append_state.hpp"
+#include "duckdb/transaction/update_info.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace duckdb {
+
+//! The header of a compressed block: the vector count and the end of the compressed data
+static constexpr idx_t COMPRESSED_HEADER_SIZE = 2 * sizeof(uint32_t);
+//! The header of every compressed vector: a flag indicating whether or not the vector has a validity mask (padded)
+static constexpr idx_t COMPRESSED_VECTOR_HEADER_SIZE = sizeof(uint64_t);
+//! Bit widths above this value are stored as plain 64-bit values, so that unpacking can always use a single load
+static constexpr idx_t MAXIMUM_PACKED_WIDTH = 56;
+//! The maximum compression ratio of a segment, this limits the size of the buffer a segment decompresses into
+static constexpr idx_t MAXIMUM_COMPRESSION_RATIO = 16;
+
+static inline idx_t AlignCompressedValue(idx_t n) {
+	return ((n + 7) / 8) * 8;
+}
+
+static idx_t MaximumCompressedVectorSize(idx_t type_size) {
+	return 64 + ValidityMask::STANDARD_MASK_SIZE + STANDARD_VECTOR_SIZE * (type_size + sizeof(uint64_t));
+}
+
+static inline idx_t VectorOffsetLocation(idx_t vector_index) {
+	return Storage::BLOCK_SIZE - (vector_index + 1) * sizeof(uint32_t);
+}
+
+//===--------------------------------------------------------------------===//
+// Bit-packing
+//===--------------------------------------------------------------------===//
+static idx_t RequiredBitWidth(uint64_t max_value) {
+	idx_t width = 0;
+	while (max_value > 0) {
+		width++;
+		max_value >>= 1;
+	}
+	return width > MAXIMUM_PACKED_WIDTH ? 64 : width;
+}
+
+static idx_t BitPackedSize(idx_t count, idx_t width) {
+	// we add an extra 8 bytes of padding so unpacking can always load a full 64-bit word
+	return AlignCompressedValue((count * width + 7) / 8 + sizeof(uint64_t));
+}
+
+static void BitPack(const uint64_t *source, idx_t count, idx_t width, data_ptr_t target) {
+	memset(target, 0, BitPackedSize(count, width));
+	if (width == 0) {
+		return;
+	}
+	if (width == 64) {
+		memcpy(target, source, count * sizeof(uint64_t));
+		return;
+	}
+	for (idx_t i = 0; i < count; i++) {
+		idx_t bit_position = i * width;
+		auto location = target + bit_position / 8;
+		auto word = Load<uint64_t>(location);
+		word |= source[i] << (bit_position % 8);
+		Store<uint64_t>(word, location);
+	}
+}
+
+static inline uint64_t BitUnpack(const_data_ptr_t source, idx_t index, idx_t width) {
+	if (width == 0) {
+		return 0;
+	}
+	if (width == 64) {
+		return Load<uint64_t>(source + index * sizeof(uint64_t));
+	}
+	idx_t bit_position = index * width;
+	auto word = Load<uint64_t>(source + bit_position / 8) >> (bit_position % 8);
+	return word & ((uint64_t(1) << width) - 1);
+}
+
+//===--------------------------------------------------------------------===//
+// Compression
+//===--------------------------------------------------------------------===//
+template <class T>
+static inline bool BitwiseEquals(const T &left, const T &right) {
+	return memcmp(&left, &right, sizeof(T)) == 0;
+}
+
+//! Copy the values of a vector, replacing NULL entries with the preceding value so that they do not break up runs or
+//! introduce additional distinct values
+template <class T>
+static void NormalizeValues(T *source, ValidityMask &mask, idx_t count, T *target) {
+	if (mask.AllValid()) {
+		memcpy(target, source, count * sizeof(T));
+		return;
+	}
+	T last_value;
+	memset(&last_value, 0, sizeof(T));
+	// find the first valid value
+	for (idx_t i = 0; i < count; i++) {
+		if (mask.RowIsValid(i)) {
+			last_value = source[i];
+			break;
+		}
+	}
+	for (idx_t i = 0; i < count; i++) {
+		if (mask.RowIsValid(i)) {
+			last_value = source[i];
+		}
+		target[i] = last_value;
+	}
+}
+
+template <class T>
+static idx_t RLECompress(T *values, idx_t count, data_ptr_t target) {
+	// first count the runs
+	uint32_t run_count = 1;
+	for (idx_t i = 1; i < count; i++) {
+		run_count += !BitwiseEquals<T>(values[i], values[i - 1]);
+	}
+	auto run_values = (T *)(target + sizeof(uint64_t));
+	auto run_lengths = (uint16_t *)(target + sizeof(uint64_t) + AlignCompressedValue(run_count * sizeof(T)));
+	Store<uint32_t>(run_count, target);
+
+	idx_t run_idx = 0;
+	run_values[0] = values[0];
+	run_lengths[0] = 1;
+	for (idx_t i = 1; i < count; i++) {
+		if (BitwiseEquals<T>(values[i], values[i - 1])) {
+			run_lengths[run_idx]++;
+		} else {
+			run_idx++;
+			run_values[run_idx] = values[i];
+			run_lengths[run_idx] = 1;
+		}
+	}
+	return sizeof(uint64_t) + AlignCompressedValue(run_count * sizeof(T)) +
+	       AlignCompressedValue(run_count * sizeof(uint16_t));
+}
+
+template <class T>
+static idx_t DictionaryCompress(T *values, idx_t count, data_ptr_t target) {
+	// sort the indices of the values so we can find the distinct values
+	sel_t indices[STANDARD_VECTOR_SIZE];
+	for (idx_t i = 0; i < count; i++) {
+		indices[i] = i;
+	}
+	std::sort(indices, indices + count,
+	          [&](sel_t left, sel_t right) { return memcmp(&values[left], &values[right], sizeof(T)) < 0; });
+
+	// assign a code to every distinct value
+	uint64_t codes[STANDARD_VECTOR_SIZE];
+	auto dictionary = (T *)(target + sizeof(uint64_t));
+	uint32_t dictionary_size = 0;
+	for (idx_t i = 0; i < count; i++) {
+		auto &value = values[indices[i]];
+		if (dictionary_size == 0 || !BitwiseEquals<T>(dictionary[dictionary_size - 1], value)) {
+			dictionary[dictionary_size++] = value;
+		}
+		codes[indices[i]] = dictionary_size - 1;
+	}
+	auto width = RequiredBitWidth(dictionary_size - 1);
+	Store<uint32_t>(dictionary_size, target);
+	Store<uint32_t>(width, target + sizeof(uint32_t));
+
+	auto packed_data = target + sizeof(uint64_t) + AlignCompressedValue(dictionary_size * sizeof(T));
+	BitPack(codes, count, width, packed_data);
+	return sizeof(uint64_t) + AlignCompressedValue(dictionary_size * sizeof(T)) + BitPackedSize(count, width);
+}
+
+template <class T, bool IS_INTEGRAL = std::is_integral<T>::value>
+struct BitpackingFunctions {
+	static idx_t Compress(T *values, idx_t count, data_ptr_t target) {
+		throw InternalException("Bit-packing is only supported for integral types");
+	}
+	static void Decompress(data_ptr_t source, idx_t count, T *result_data) {
+		throw InternalException("Bit-packing is only supported for integral types");
+	}
+};
+
+template <class T>
+struct BitpackingFunctions<T, true> {
+	typedef typename std::make_unsigned<T>::type UNSIGNED;
+
+	static idx_t Compress(T *values, idx_t count, data_ptr_t target) {
+		// frame of reference: store the deltas to the minimum value
+		T min_value = values[0];
+		for (idx_t i = 1; i < count; i++) {
+			if (values[i] < min_value) {
+				min_value = values[i];
+			}
+		}
+		uint64_t deltas[STANDARD_VECTOR_SIZE];
+		uint64_t max_delta = 0;
+		for (idx_t i = 0; i < count; i++) {
+			deltas[i] = UNSIGNED(UNSIGNED(values[i]) - UNSIGNED(min_value));
+			max_delta = MaxValue<uint64_t>(max_delta, deltas[i]);
+		}
+		auto width = RequiredBitWidth(max_delta);
+		Store<T>(min_value, target);
+		Store<uint64_t>(width, target + sizeof(uint64_t));
+		BitPack(deltas, count, width, target + 2 * sizeof(uint64_t));
+		return 2 * sizeof(uint64_t) + BitPackedSize(count, width);
+	}
+
+	static void Decompress(data_ptr_t source, idx_t count, T *result_data) {
+		auto min_value = UNSIGNED(Load<T>(source));
+		auto width = Load<uint64_t>(source + sizeof(uint64_t));
+		auto packed_data = source + 2 * sizeof(uint64_t);
+		for (idx_t i = 0; i < count; i++) {
+			result_data[i] = T(UNSIGNED(min_value + UNSIGNED(BitUnpack(packed_data, i, width))));
+		}
+	}
+};
+
+template <class T>
+static idx_t TemplatedCompressVector(CompressionType compression, data_ptr_t source, ValidityMask &mask, idx_t count,
+                                     data_ptr_t target) {
+	T values[STANDARD_VECTOR_SIZE];
+	NormalizeValues<T>((T *)source, mask, count, values);
+
+	// write the validity mask only if there are NULL values
+	bool has_nulls = !mask.CheckAllValid(count);
+	memset(target, 0, COMPRESSED_VECTOR_HEADER_SIZE);
+	Store<uint8_t>(has_nulls, target);
+	idx_t offset = COMPRESSED_VECTOR_HEADER_SIZE;
+	if (has_nulls) {
+		// the mask can be smaller than a standard vector: copy only the entries that cover the values
+		auto mask_size = ValidityMask::EntryCount(count) * sizeof(validity_t);
+		memcpy(target + offset, mask.GetData(), mask_size);
+		memset(target + offset + mask_size, 0xFF, ValidityMask::STANDARD_MASK_SIZE - mask_size);
+		offset += ValidityMask::STANDARD_MASK_SIZE;
+	}
+	switch (compression) {
+	case CompressionType::COMPRESSION_RLE:
+		return offset + RLECompress<T>(values, count, target + offset);
+	case CompressionType::COMPRESSION_BITPACKING:
+		return offset + BitpackingFunctions<T>::Compress(values, count, target + offset);
+	case CompressionType::COMPRESSION_DICTIONARY:
+		return offset + DictionaryCompress<T>(values, count, target + offset);
+	default:
+		throw InternalException("Unsupported compression type for compressed segment");
+	}
+}
+
+//! Compress a vector of the specified type, returns the amount of bytes written to the target
+static idx_t CompressVector(PhysicalType type, CompressionType compression, data_ptr_t source, ValidityMask &mask,
+                            idx_t count, data_ptr_t target) {
+	switch (type) {
+	case PhysicalType::BOOL:
+	case PhysicalType::UINT8:
+		return TemplatedCompressVector<uint8_t>(compression, source, mask, count, target);
+	case PhysicalType::INT8:
+		return TemplatedCompressVector<int8_t>(compression, source, mask, count, target);
+	case PhysicalType::INT16:
+		return TemplatedCompressVector<int16_t>(compression, source, mask, count, target);
+	case PhysicalType::INT32:
+		return TemplatedCompressVector<int32_t>(compression, source, mask, count, target);
+	case PhysicalType::INT64:
+		return TemplatedCompressVector<int64_t>(compression, source, mask, count, target);
+	case PhysicalType::UINT16:
+		return TemplatedCompressVector<uint16_t>(compression, source, mask, count, target);
+	case PhysicalType::UINT32:
+		return TemplatedCompressVector<uint32_t>(compression, source, mask, count, target);
+	case PhysicalType::UINT64:
+		return TemplatedCompressVector<uint64_t>(compression, source, mask, count, target);
+	case PhysicalType::INT128:
+		return TemplatedCompressVector<hugeint_t>(compression, source, mask, count, target);
+	case PhysicalType::FLOAT:
+		return TemplatedCompressVector<float>(compression, source, mask, count, target);
+	case PhysicalType::DOUBLE:
+		return TemplatedCompressVector<double>(compression, source, mask, count, target);
+	case PhysicalType::INTERVAL:
+		return TemplatedCompressVector<interval_t>(compression, source, mask, count, target);
+	default:
+		throw InternalException("Unsupported type for compressed segment");
+	}
+}
+
+//===--------------------------------------------------------------------===//
+// Decompression
+//===--------------------------------------------------------------------===//
+//! Decompress a vector into a flat (uncompressed) data array
+template <class T>
+static void DecompressValues(CompressionType compression, data_ptr_t source, idx_t count, T *result_data) {
+	switch (compression) {
+	case CompressionType::COMPRESSION_RLE: {
+		auto run_count = Load<uint32_t>(source);
+		auto run_values = (T *)(source + sizeof(uint64_t));
+		auto run_lengths = (uint16_t *)(source + sizeof(uint64_t) + AlignCompressedValue(run_count * sizeof(T)));
+		idx_t result_idx = 0;
+		for (idx_t run_idx = 0; run_idx < run_count; run_idx++) {
+			for (idx_t i = 0; i < run_lengths[run_idx]; i++) {
+				result_data[result_idx++] = run_values[run_idx];
+			}
+		}
+		D_ASSERT(result_idx == count);
+		break;
+	}
+	case CompressionType::COMPRESSION_BITPACKING:
+		BitpackingFunctions<T>::Decompress(source, count, result_data);
+		break;
+	case CompressionType::COMPRESSION_DICTIONARY: {
+		auto dictionary_size = Load<uint32_t>(source);
+		auto width = Load<uint32_t>(source + sizeof(uint32_t));
+		auto dictionary = (T *)(source + sizeof(uint64_t));
+		auto packed_data = source + sizeof(uint64_t) + AlignCompressedValue(dictionary_size * sizeof(T));
+		for (idx_t i = 0; i < count; i++) {
+			result_data[i] = dictionary[BitUnpack(packed_data, i, width)];
+		}
+		break;
+	}
+	default:
+		throw InternalException("Unsupported compression type for compressed segment");
+	}
+}
+
+//! Decompress a vector into a result vector. If possible (i.e. if allow_compressed_result is set and there are no NULL
+//! values) RLE vectors consisting of a single run are emitted as constant vectors, and dictionary encoded vectors are
+//! emitted as dictionary vectors.
+template <class T>
+static void TemplatedDecompressVector(CompressionType compression, data_ptr_t source, idx_t count, Vector &result,
+                                      bool allow_compressed_result) {
+	if (result.GetVectorType() == VectorType::DICTIONARY_VECTOR) {
+		// the result vector was previously sliced: reset it so we can write into it again
+		result.Initialize();
+	}
+	bool has_nulls = Load<uint8_t>(source);
+	auto payload = source + COMPRESSED_VECTOR_HEADER_SIZE;
+	if (has_nulls) {
+		allow_compressed_result = false;
+		payload += ValidityMask::STANDARD_MASK_SIZE;
+	}
+	if (allow_compressed_result) {
+		if (compression == CompressionType::COMPRESSION_RLE && Load<uint32_t>(payload) == 1) {
+			// a single run: emit a constant vector
+			result.SetVectorType(VectorType::CONSTANT_VECTOR);
+			ConstantVector::GetData<T>(result)[0] = Load<T>(payload + sizeof(uint64_t));
+			ConstantVector::SetNull(result, false);
+			return;
+		}
+		if (compression == CompressionType::COMPRESSION_DICTIONARY) {
+			// emit a dictionary vector that references the values of the dictionary
+			auto dictionary_size = Load<uint32_t>(payload);
+			auto width = Load<uint32_t>(payload + sizeof(uint32_t));
+			auto packed_data = payload + sizeof(uint64_t) + AlignCompressedValue(dictionary_size * sizeof(T));
+
+			Vector dictionary(result.GetType());
+			memcpy(FlatVector::GetData(dictionary), payload + sizeof(uint64_t), dictionary_size * sizeof(T));
+			SelectionVector sel(STANDARD_VECTOR_SIZE);
+			for (idx_t i = 0; i < count; i++) {
+				sel.set_index(i, BitUnpack(packed_data, i, width));
+			}
+			result.Slice(dictionary, sel, count);
+			return;
+		}
+	}
+	result.SetVectorType(VectorType::FLAT_VECTOR);
+	if (has_nulls) {
+		ValidityMask source_mask(source + COMPRESSED_VECTOR_HEADER_SIZE);
+		FlatVector::Validity(result).Copy(source_mask, count);
+	}
+	DecompressValues<T>(compression, payload, count, FlatVector::GetData<T>(result));
+}
+
+static void DecompressVectorSwitch(PhysicalType type, CompressionType compression, data_ptr_t source, idx_t count,
+                                   Vector &result, bool allow_compressed_result) {
+	switch (type) {
+	case PhysicalType::BOOL:
+	case PhysicalType::UINT8:
+		TemplatedDecompressVector<uint8_t>(compression, source, count, result, allow_compressed_result);
+		break;
+	case PhysicalType::INT8:
+		TemplatedDecompressVector<int8_t>(compression, source, count, result, allow_compressed_result);
+		break;
+	case PhysicalType::INT16:
+		TemplatedDecompressVector<int16_t>(compression, source, count, result, allow_compressed_result);
+		break;
+	case PhysicalType::INT32:
+		TemplatedDecompressVector<int32_t>(compression, source, count, result, allow_compressed_result);
+		break;
+	case PhysicalType::INT64:
+		TemplatedDecompressVector<int64_t>(compression, source, count, result, allow_compressed_result);
+		break;
+	case PhysicalType::UINT16:
+		TemplatedDecompressVector<uint16_t>(compression, source, count, result, allow_compressed_result);
+		break;
+	case PhysicalType::UINT32:
+		TemplatedDecompressVector<uint32_t>(compression, source, count, result, allow_compressed_result);
+		break;
+	case PhysicalType::UINT64:
+		TemplatedDecompressVector<uint64_t>(compression, source, count, result, allow_compressed_result);
+		break;
+	case PhysicalType::INT128:
+		TemplatedDecompressVector<hugeint_t>(compression, source, count, result, allow_compressed_result);
+		break;
+	case PhysicalType::FLOAT:
+		TemplatedDecompressVector<float>(compression, source, count, result, allow_compressed_result);
+		break;
+	case PhysicalType::DOUBLE:
+		TemplatedDecompressVector<double>(compression, source, count, result, allow_compressed_result);
+		break;
+	case PhysicalType::INTERVAL:
+		TemplatedDecompressVector<interval_t>(compression, source, count, result, allow_compressed_result);
+		break;
+	default:
+		throw InternalException("Unsupported type for compressed segment");
+	}
+}
+
+//! Decompress a vector into the layout used by the NumericSegment ([validity mask][data])
+template <class T>
+static void TemplatedDecompressToBuffer(CompressionType compression, data_ptr_t source, idx_t count,
+                                        data_ptr_t target) {
+	bool has_nulls = Load<uint8_t>(source);
+	auto payload = source + COMPRESSED_VECTOR_HEADER_SIZE;
+	if (has_nulls) {
+		memcpy(target, payload, ValidityMask::STANDARD_MASK_SIZE);
+		payload += ValidityMask::STANDARD_MASK_SIZE;
+	} else {
+		ValidityMask mask(target);
+		mask.SetAllValid(STANDARD_VECTOR_SIZE);
+	}
+	DecompressValues<T>(compression, payload, count, (T *)(target + ValidityMask::STANDARD_MASK_SIZE));
+}
+
+static void DecompressToBuffer(PhysicalType type, CompressionType compression, data_ptr_t source, idx_t count,
+                               data_ptr_t target) {
+	switch (type) {
+	case PhysicalType::BOOL:
+	case PhysicalType::UINT8:
+		TemplatedDecompressToBuffer<uint8_t>(compression, source, count, target);
+		break;
+	case PhysicalType::INT8:
+		TemplatedDecompressToBuffer<int8_t>(compression, source, count, target);
+		break;
+	case PhysicalType::INT16:
+		TemplatedDecompressToBuffer<int16_t>(compression, source, count, target);
+		break;
+	case PhysicalType::INT32:
+		TemplatedDecompressToBuffer<int32_t>(compression, source, count, target);
+		break;
+	case PhysicalType::INT64:
+		TemplatedDecompressToBuffer<int64_t>(compression, source, count, target);
+		break;
+	case PhysicalType::UINT16:
+		TemplatedDecompressToBuffer<uint16_t>(compression, source, count, target);
+		break;
+	case PhysicalType::UINT32:
+		TemplatedDecompressToBuffer<uint32_t>(compression, source, count, target);
+		break;
+	case PhysicalType::UINT64:
+		TemplatedDecompressToBuffer<uint64_t>(compression, source, count, target);
+		break;
+	case PhysicalType::INT128:
+		TemplatedDecompressToBuffer<hugeint_t>(compression, source, count, target);
+		break;
+	case PhysicalType::FLOAT:
+		TemplatedDecompressToBuffer<float>(compression, source, count, target);
+		break;
+	case PhysicalType::DOUBLE:
+		TemplatedDecompressToBuffer<double>(compression, source, count, target);
+		break;
+	case PhysicalType::INTERVAL:
+		TemplatedDecompressToBuffer<interval_t>(compression, source, count, target);
+		break;
+	default:
+		throw InternalException("Unsupported type for compressed segment");
+	}
+}
+
+//===--------------------------------------------------------------------===//
+// Compressed Segment
+//===--------------------------------------------------------------------===//
+CompressedSegment::CompressedSegment(DatabaseInstance &db, PhysicalType type, idx_t row_start,
+                                     CompressionType compression_p, block_id_t block_id)
+    : NumericSegment(db, type, row_start, block_id), compression(compression_p), compressed_vector_count(0),
+      data_end(COMPRESSED_HEADER_SIZE) {
+	D_ASSERT(SupportsCompression(type, compression));
+	if (block_id == INVALID_BLOCK) {
+		// new segment: the buffer allocated by the NumericSegment is used to hold the compressed data
+		// the uncompressed data is gathered in the append buffer one vector at a time
+		this->max_vector_count = MaximumVectorCount(type);
+		this->append_buffer = unique_ptr<data_t[]>(new data_t[vector_size]);
+		ValidityMask mask(append_buffer.get());
+		mask.SetAllValid(STANDARD_VECTOR_SIZE);
+	}
+}
+
+bool CompressedSegment::SupportsCompression(PhysicalType type, CompressionType compression) {
+	switch (type) {
+	case PhysicalType::BOOL:
+	case PhysicalType::INT8:
+	case PhysicalType::INT16:
+	case PhysicalType::INT32:
+	case PhysicalType::INT64:
+	case PhysicalType::UINT8:
+	case PhysicalType::UINT16:
+	case PhysicalType::UINT32:
+	case PhysicalType::UINT64:
+		return compression == CompressionType::COMPRESSION_RLE ||
+		       compression == CompressionType::COMPRESSION_BITPACKING ||
+		       compression == CompressionType::COMPRESSION_DICTIONARY;
+	case PhysicalType::INT128:
+	case PhysicalType::FLOAT:
+	case PhysicalType::DOUBLE:
+	case PhysicalType::INTERVAL:
+		return compression == CompressionType::COMPRESSION_RLE ||
+		       compression == CompressionType::COMPRESSION_DICTIONARY;
+	default:
+		return false;
+	}
+}
+
+idx_t CompressedSegment::MaximumVectorCount(PhysicalType type) {
+	idx_t uncompressed_vector_size = ValidityMask::STANDARD_MASK_SIZE + GetTypeIdSize(type) * STANDARD_VECTOR_SIZE;
+	return MAXIMUM_COMPRESSION_RATIO * (Storage::BLOCK_SIZE / uncompressed_vector_size);
+}
+
+bool CompressedSegment::IsCompressed(BufferHandle &handle) {
+	// the on-disk block holds the compressed data; once the segment is converted to a temporary block the data is
+	// stored uncompressed
+	return handle.handle->BlockId() < MAXIMUM_BLOCK;
+}
+
+CompressionType CompressedSegment::GetCompressionType() {
+	return block->BlockId() < MAXIMUM_BLOCK ? compression : CompressionType::COMPRESSION_UNCOMPRESSED;
+}
+
+idx_t CompressedSegment::GetCompressedSize() {
+	auto &buffer_manager = BufferManager::GetBufferManager(db);
+	auto handle = buffer_manager.Pin(block);
+	if (!IsCompressed(*handle)) {
+		return max_vector_count * vector_size;
+	}
+	auto vector_count = Load<uint32_t>(handle->node->buffer);
+	auto compressed_end = Load<uint32_t>(handle->node->buffer + sizeof(uint32_t));
+	return compressed_end + vector_count * sizeof(uint32_t);
+}
+
+void CompressedSegment::DecompressVector(data_ptr_t block_data, idx_t vector_index, Vector &result,
+                                         bool allow_compressed_result) {
+	D_ASSERT(vector_index < max_vector_count);
+	D_ASSERT(vector_index * STANDARD_VECTOR_SIZE <= tuple_count);
+	auto vector_offset = Load<uint32_t>(block_data + VectorOffsetLocation(vector_index));
+	DecompressVectorSwitch(type, compression, block_data + vector_offset, GetVectorCount(vector_index), result,
+	                       allow_compressed_result);
+}
+
+//===--------------------------------------------------------------------===//
+// Scan
+//===--------------------------------------------------------------------===//
+void CompressedSegment::FetchBaseData(ColumnScanState &state, idx_t vector_index, Vector &result) {
+	if (!IsCompressed(*state.primary_handle)) {
+		NumericSegment::FetchBaseData(state, vector_index, result);
+		return;
+	}
+	// we can only emit compressed vectors if we do not need to merge in any updates afterwards
+	bool has_updates = versions && versions[vector_index];
+	DecompressVector(state.primary_handle->node->buffer, vector_index, result, !has_updates);
+}
+
+void CompressedSegment::FilterFetchBaseData(ColumnScanState &state, Vector &result, SelectionVector &sel,
+                                            idx_t &approved_tuple_count) {
+	if (!IsCompressed(*state.primary_handle)) {
+		NumericSegment::FilterFetchBaseData(state, result, sel, approved_tuple_count);
+		return;
+	}
+	DecompressVector(state.primary_handle->node->buffer, state.vector_index, result, true);
+	result.Slice(sel, approved_tuple_count);
+}
+
+void CompressedSegment::Select(ColumnScanState &state, Vector &result, SelectionVector &sel,
+                               idx_t &approved_tuple_count, vector<TableFilter> &table_filter) {
+	auto &buffer_manager = BufferManager::GetBufferManager(db);
+	auto handle = buffer_manager.Pin(block);
+	if (!IsCompressed(*handle)) {
+		NumericSegment::Select(state, result, sel, approved_tuple_count, table_filter);
+		return;
+	}
+	// decompress the vector and apply the filters to the decompressed data
+	DecompressVector(handle->node->buffer, state.vector_index, result, false);
+	auto &mask = FlatVector::Validity(result);
+	for (auto &filter : table_filter) {
+		FilterSelection(sel, result, filter, approved_tuple_count, mask);
+	}
+}
+
+//===--------------------------------------------------------------------===//
+// Fetch
+//===--------------------------------------------------------------------===//
+void CompressedSegment::FetchRow(ColumnFetchState &state, Transaction &transaction, row_t row_id, Vector &result,
+                                 idx_t result_idx) {
+	{
+		auto read_lock = lock.GetSharedLock();
+		auto &buffer_manager = BufferManager::GetBufferManager(db);
+		auto handle = buffer_manager.Pin(block);
+		if (IsCompressed(*handle)) {
+			idx_t vector_index = row_id / STANDARD_VECTOR_SIZE;
+			idx_t id_in_vector = row_id - vector_index * STANDARD_VECTOR_SIZE;
+
+			Vector decompressed(result.GetType());
+			DecompressVector(handle->node->buffer, vector_index, decompressed, false);
+			FlatVector::SetNull(result, result_idx, FlatVector::IsNull(decompressed, id_in_vector));
+			memcpy(FlatVector::GetData(result) + result_idx * type_size,
+			       FlatVector::GetData(decompressed) + id_in_vector * type_size, type_size);
+			return;
+		}
+	}
+	NumericSegment::FetchRow(state, transaction, row_id, result, result_idx);
+}
+
+//===--------------------------------------------------------------------===//
+// Append
+//===--------------------------------------------------------------------===//
+idx_t CompressedSegment::Append(SegmentStatistics &stats, Vector &data, idx_t offset, idx_t count) {
+	D_ASSERT(data.GetType().InternalType() == type);
+	if (!append_buffer) {
+		// the segment has already been written: appends go to the decompressed in-memory buffer
+		D_ASSERT(!IsCompressed(*BufferManager::GetBufferManager(db).Pin(block)));
+		return NumericSegment::Append(stats, data, offset, count);
+	}
+	auto &buffer_manager = BufferManager::GetBufferManager(db);
+	auto handle = buffer_manager.Pin(block);
+
+	idx_t initial_count = tuple_count;
+	while (count > 0) {
+		idx_t current_tuple_count = tuple_count % STANDARD_VECTOR_SIZE;
+		if (current_tuple_count == 0) {
+			// we are starting a new vector: check if a compressed vector is guaranteed to fit in the block
+			idx_t vector_index = tuple_count / STANDARD_VECTOR_SIZE;
+			if (vector_index == max_vector_count ||
+			    data_end + MaximumCompressedVectorSize(type_size) > VectorOffsetLocation(vector_index)) {
+				break;
+			}
+		}
+		idx_t append_count = MinValue(STANDARD_VECTOR_SIZE - current_tuple_count, count);
+		append_function(stats, append_buffer.get(), current_tuple_count, data, offset, append_count);
+
+		count -= append_count;
+		offset += append_count;
+		tuple_count += append_count;
+		if (tuple_count % STANDARD_VECTOR_SIZE == 0) {
+			// the vector is full: compress it
+			CompressBufferedVector(handle->node->buffer);
+		}
+	}
+	return tuple_count - initial_count;
+}
+
+void CompressedSegment::CompressBufferedVector(data_ptr_t block_data) {
+	idx_t vector_index = compressed_vector_count;
+	idx_t count = tuple_count - vector_index * STANDARD_VECTOR_SIZE;
+	D_ASSERT(count > 0 && count <= STANDARD_VECTOR_SIZE);
+
+	ValidityMask mask(append_buffer.get());
+	auto compressed_size = CompressVector(type, compression, append_buffer.get() + ValidityMask::STANDARD_MASK_SIZE,
+	                                      mask, count, block_data + data_end);
+	Store<uint32_t>(data_end, block_data + VectorOffsetLocation(vector_index));
+	data_end += compressed_size;
+	D_ASSERT(data_end <= VectorOffsetLocation(vector_index));
+	compressed_vector_count++;
+
+	// reset the append buffer
+	mask.SetAllValid(STANDARD_VECTOR_SIZE);
+}
+
+void CompressedSegment::FinalizeAppend() {
+	D_ASSERT(append_buffer);
+	auto &buffer_manager = BufferManager::GetBufferManager(db);
+	auto handle = buffer_manager.Pin(block);
+	if (tuple_count % STANDARD_VECTOR_SIZE != 0) {
+		// compress the final partially filled vector
+		CompressBufferedVector(handle->node->buffer);
+	}
+	Store<uint32_t>(compressed_vector_count, handle->node->buffer);
+	Store<uint32_t>(data_end, handle->node->buffer + sizeof(uint32_t));
+	append_buffer.reset();
+}
+
+//===--------------------------------------------------------------------===//
+// ToTemporary
+//===--------------------------------------------------------------------===//
+void CompressedSegment::ToTemporary() {
+	auto write_lock = lock.GetExclusiveLock();
+	if (block->BlockId() >= MAXIMUM_BLOCK) {
+		// conversion has already been performed by a different thread
+		return;
+	}
+	auto &block_manager = BlockManager::GetBlockManager(db);
+	block_manager.MarkBlockAsModified(block->BlockId());
+
+	auto &buffer_manager = BufferManager::GetBufferManager(db);
+	auto current = buffer_manager.Pin(block);
+
+	// allocate an in-memory buffer that is big enough to hold all the vectors uncompressed, and decompress into it
+	auto alloc_size = MaxValue<idx_t>(Storage::BLOCK_SIZE, max_vector_count * vector_size) + Storage::BLOCK_HEADER_SIZE;
+	auto new_block = buffer_manager.RegisterMemory(alloc_size, false);
+	auto handle = buffer_manager.Pin(new_block);
+	for (idx_t vector_index = 0; vector_index < max_vector_count; vector_index++) {
+		auto target = handle->node->buffer + vector_index * vector_size;
+		if (vector_index * STANDARD_VECTOR_SIZE >= tuple_count) {
+			ValidityMask mask(target);
+			mask.SetAllValid(STANDARD_VECTOR_SIZE);
+			continue;
+		}
+		auto vector_offset = Load<uint32_t>(current->node->buffer + VectorOffsetLocation(vector_index));
+		DecompressToBuffer(type, compression, current->node->buffer + vector_offset, GetVectorCount(vector_index),
+		                   target);
+	}
+	this->block = move(new_block);
+}
+
+//===--------------------------------------------------------------------===//
+// Compression Analyzer
+//===--------------------------------------------------------------------===//
+CompressionAnalyzer::CompressionAnalyzer(PhysicalType type) : type(type), uncompressed_size(0) {
+	CompressionType candidates[] = {CompressionType::COMPRESSION_RLE, CompressionType::COMPRESSION_BITPACKING,
+	                                CompressionType::COMPRESSION_DICTIONARY};
+	for (auto &compression : candidates) {
+		if (CompressedSegment::SupportsCompression(type, compression)) {
+			compressed_sizes.push_back(std::make_pair(compression, 0));
+		}
+	}
+	if (!compressed_sizes.empty()) {
+		compress_buffer = unique_ptr<data_t[]>(new data_t[MaximumCompressedVectorSize(GetTypeIdSize(type))]);
+	}
+}
+
+void CompressionAnalyzer::Analyze(Vector &data, idx_t count) {
+	uncompressed_size += ValidityMask::STANDARD_MASK_SIZE + count * GetTypeIdSize(type);
+	if (compressed_sizes.empty()) {
+		return;
+	}
+	data.Normalify(count);
+	auto &mask = FlatVector::Validity(data);
+	for (auto &entry : compressed_sizes) {
+		entry.second +=
+		    CompressVector(type, entry.first, FlatVector::GetData(data), mask, count, compress_buffer.get());
+	}
+}
+
+CompressionType CompressionAnalyzer::GetBestCompression() {
+	auto best_compression = CompressionType::COMPRESSION_UNCOMPRESSED;
+	auto best_size = uncompressed_size;
+	for (auto &entry : compressed_sizes) {
+		if (entry.second < best_size) {
+			best_compression = entry.first;
+			best_size = entry.second;
+		}
+	}
+	return best_compression;
+}
+
+} // namespace duckdb
@@ -6,6 +6,7 @@
 #include "duckdb/common/vector_operations/vector_operations.hpp"
 #include "duckdb/execution/expression_executor.hpp"
 #include "duckdb/main/client_context.hpp"
+#include "duckdb/parallel/task_scheduler.hpp"
 #include "duckdb/planner/constraints/list.hpp"
 #include "duckdb/planner/table_filter.hpp"
 #include "duckdb/storage/storage_manager.hpp"
@@ -17,6 +18,9 @@
 #include "duckdb/storage/checkpoint/table_data_writer.hpp"
 #include "duckdb/common/chrono.hpp"
 
+#include <condition_variable>
+#include <exception>
+
 namespace duckdb {
 
 DataTable::DataTable(DatabaseInstance &db, const string &schema, const string &table, vector<LogicalType> types_p,
@@ -1043,6 +1047,158 @@ void DataTable::AddIndex(unique_ptr<Index> index, vector<unique_ptr<Expression>>
 	info->indexes.push_back(move(index));
 }
 
+struct CreateIndexGlobalState {
+	CreateIndexGlobalState() : constraint_violation(false), finished_tasks(0) {
+	}
+
+	std::atomic<bool> constraint_violation;
+	mutex lock;
+	//! The amount of tasks that have finished (protected by the lock), the tasks signal the condition variable
+	idx_t finished_tasks;
+	std::condition_variable task_finished;
+	//! The exceptions that were thrown by the tasks (protected by the lock), rethrown unchanged by the caller
+	vector<std::exception_ptr> exceptions;
+};
+
+//! A task that collects the index entries of a range of the rows of the table, and adds them to the index
+class CreateIndexTask : public Task {
+public:
+	CreateIndexTask(DataTable &table, Index &index, vector<unique_ptr<Expression>> &expressions,
+	                const vector<column_t> &column_ids, CreateIndexScanState &scan_state,
+	                CreateIndexGlobalState &gstate, idx_t start_row, idx_t end_row)
+	    : table(table), index(index), expressions(expressions), column_ids(column_ids), scan_state(scan_state),
+	      gstate(gstate), start_row(start_row), end_row(end_row) {
+	}
+
+	void Execute() override {
+		try {
+			auto build_state = index.InitializeBuild();
+			table.BuildIndexRange(scan_state, index, *build_state, expressions, column_ids, start_row, end_row);
+			if (!index.BuildCombine(*build_state)) {
+				gstate.constraint_violation = true;
+			}
+		} catch (...) {
+			lock_guard<mutex> glock(gstate.lock);
+			gstate.exceptions.push_back(std::current_exception());
+		}
+		// notify while holding the lock: the global state is destroyed once the waiting thread sees the last task finish
+		lock_guard<mutex> glock(gstate.lock);
+		gstate.finished_tasks++;
+		gstate.task_finished.notify_one();
+	}
+
+private:
+	DataTable &table;
+	Index &index;
+	vector<unique_ptr<Expression>> &expressions;
+	const vector<column_t> &column_ids;
+	CreateIndexScanState &scan_state;
+	CreateIndexGlobalState &gstate;
+	idx_t start_row;
+	idx_t end_row;
+};
+
+void DataTable::BuildIndexRange(CreateIndexScanState &state, Index &index, IndexBuildState &build_state,
+                                vector<unique_ptr<Expression>> &expressions, const vector<column_t> &column_ids,
+                                idx_t start_row, idx_t end_row) {
+	DataChunk result;
+	result.Initialize(index.logical_types);
+
+	DataChunk intermediate;
+	vector<LogicalType> intermediate_types;
+	for (auto &id : index.column_ids) {
+		intermediate_types.push_back(types[id]);
+	}
+	intermediate_types.push_back(LOGICAL_ROW_TYPE);
+	intermediate.Initialize(intermediate_types);
+
+	// the version info is not needed (and its lock is held by the main thread): only initialize the column scans
+	D_ASSERT(start_row % STANDARD_VECTOR_SIZE == 0);
+	state.column_scans = unique_ptr<ColumnScanState[]>(new ColumnScanState[column_ids.size()]);
+	for (idx_t i = 0; i < column_ids.size(); i++) {
+		auto column = column_ids[i];
+		if (column != COLUMN_IDENTIFIER_ROW_ID) {
+			columns[column]->InitializeScanWithOffset(state.column_scans[i], start_row / STANDARD_VECTOR_SIZE);
+		} else {
+			state.column_scans[i].current = nullptr;
+		}
+	}
+	state.column_count = column_ids.size();
+	state.current_row = start_row;
+	state.base_row = start_row;
+	state.max_row = end_row;
+	ExpressionExecutor executor(expressions);
+	while (true) {
+		intermediate.Reset();
+		if (!ScanCreateIndex(state, column_ids, intermediate, state.current_row, state.max_row)) {
+			break;
+		}
+		executor.Execute(intermediate, result);
+		index.BuildAppend(build_state, result, intermediate.data[intermediate.ColumnCount() - 1]);
+	}
+}
+
+void DataTable::AddIndex(ClientContext &context, unique_ptr<Index> index,
+                         vector<unique_ptr<Expression>> &expressions) {
+	// bulk loading sorts the keys and merges the sub-trees of the threads, which only pays off with multiple threads
+	auto &scheduler = TaskScheduler::GetScheduler(context);
+	if (!context.parallel_index_creation || scheduler.NumberOfThreads() <= 1 || !index->InitializeBuild()) {
+		AddIndex(move(index), expressions);
+		return;
+	}
+	auto column_ids = index->column_ids;
+	column_ids.push_back(COLUMN_IDENTIFIER_ROW_ID);
+
+	// the scan state of the main thread holds the locks that keep the table from being changed during the build
+	CreateIndexScanState state;
+	InitializeCreateIndexScan(state, column_ids);
+
+	if (!is_root) {
+		throw TransactionException("Transaction conflict: cannot add an index to a table that has been altered!");
+	}
+
+	// split the rows of the table into one range per thread, every thread collects and sorts the keys of its range
+	// and merges the sub-tree it constructs from them into the index
+	idx_t vector_count = (total_rows + STANDARD_VECTOR_SIZE - 1) / STANDARD_VECTOR_SIZE;
+	idx_t morsel_count = (total_rows + MorselInfo::MORSEL_SIZE - 1) / MorselInfo::MORSEL_SIZE;
+	idx_t task_count = MinValue<idx_t>(scheduler.NumberOfThreads(), morsel_count);
+	if (task_count == 0) {
+		info->indexes.push_back(move(index));
+		return;
+	}
+	idx_t rows_per_task = ((vector_count + task_count - 1) / task_count) * STANDARD_VECTOR_SIZE;
+
+	CreateIndexGlobalState gstate;
+	// the scan states of the tasks keep the locks on the segments they scanned until the index is built
+	vector<CreateIndexScanState> scan_states(task_count);
+	auto producer = scheduler.CreateProducer();
+	idx_t scheduled_tasks = 0;
+	for (idx_t start_row = 0; start_row < total_rows; start_row += rows_per_task) {
+		auto end_row = MinValue<idx_t>(start_row + rows_per_task, total_rows);
+		auto task = make_unique<CreateIndexTask>(*this, *index, expressions, column_ids, scan_states[scheduled_tasks],
+		                                         gstate, start_row, end_row);
+		scheduler.ScheduleTask(*producer, move(task));
+		scheduled_tasks++;
+	}
+	// execute the tasks that were not picked up by a worker thread, then wait for the workers to finish the others
+	unique_ptr<Task> task;
+	while (scheduler.GetTaskFromProducer(*producer, task)) {
+		task->Execute();
+		task.reset();
+	}
+	{
+		std::unique_lock<mutex> glock(gstate.lock);
+		gstate.task_finished.wait(glock, [&]() { return gstate.finished_tasks == scheduled_tasks; });
+	}
+	if (!gstate.exceptions.empty()) {
+		std::rethrow_exception(gstate.exceptions[0]);
+	}
+	if (gstate.constraint_violation) {
+		throw ConstraintException("Cant create unique index, table contains duplicate data on indexed column(s)");
+	}
+	info->indexes.push_back(move(index));
+}
+
 unique_ptr<BaseStatistics> DataTable::GetStatistics(ClientContext &context, column_t column_id) {
 	if (column_id == COLUMN_IDENTIFIER_ROW_ID) {
 		return nullptr;
@@ -1061,6 +1217,14 @@ void DataTable::Checkpoint(TableDataWriter &writer) {
 	}
 }
 
+vector<vector<Value>> DataTable::GetStorageInfo() {
+	vector<vector<Value>> result;
+	for (auto &column : columns) {
+		column->GetStorageInfo(result);
+	}
+	return result;
+}
+
 void DataTable::CheckpointDeletes(TableDataWriter &writer) {
 	// then we checkpoint the deleted tuples
 	D_ASSERT(versions);
@@ -1090,6 +1254,9 @@ void DataTable::CommitDropTable() {
 	for (size_t i = 0; i < columns.size(); i++) {
 		CommitDropColumn(i);
 	}
+	for (auto &index : info->indexes) {
+		index->CommitDrop();
+	}
 }
 
 } // namespace duckdb
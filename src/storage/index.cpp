@@ -38,6 +38,14 @@ void Index::Delete(DataChunk &entries, Vector &row_identifiers) {
 	Delete(state, entries, row_identifiers);
 }
 
+BlockPointer Index::Serialize(MetaBlockWriter &writer) {
+	throw NotImplementedException("This index type cannot be written to disk");
+}
+
+void Index::Deserialize(DatabaseInstance &db, BlockPointer pointer) {
+	throw NotImplementedException("This index type cannot be read from disk");
+}
+
 void Index::ExecuteExpressions(DataChunk &input, DataChunk &result) {
 	executor.Execute(input, result);
 }
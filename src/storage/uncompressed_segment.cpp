@@ -379,8 +379,9 @@ void UncompressedSegment::FilterScan(Transaction &transaction, ColumnScanState &
 }
 
 void UncompressedSegment::IndexScan(ColumnScanState &state, idx_t vector_index, Vector &result) {
-	if (vector_index == 0) {
-		// vector_index = 0, obtain a shared lock on the segment that we keep until the index scan is complete
+	if (vector_index == 0 || state.locks.empty()) {
+		// first vector of the segment (or the first vector of a scan that starts in the middle of the segment): obtain a
+		// shared lock on the segment that we keep until the index scan is complete
 		state.locks.push_back(lock.GetSharedLock());
 	}
 	if (versions && versions[vector_index]) {
@@ -2,6 +2,7 @@
 #include "test_helpers.hpp"
 
 #include <chrono>
+#include <set>
 #include <thread>
 
 using namespace duckdb;
@@ -180,6 +181,44 @@ TEST_CASE("Test making and dropping connections in parallel to a single database
 	REQUIRE(CHECK_COLUMN(result, 0, {Value(), 1, 2, 3}));
 }
 
+static mutex query_threads_lock;
+static std::set<std::thread::id> query_thread_ids;
+
+//! Records the threads that evaluate the function, every chunk takes a while so all available threads get involved
+static void RecordThread(DataChunk &args, ExpressionState &state, Vector &result) {
+	{
+		lock_guard<mutex> guard(query_threads_lock);
+		query_thread_ids.insert(std::this_thread::get_id());
+	}
+	std::this_thread::sleep_for(std::chrono::microseconds(500));
+	result.Reference(args.data[0]);
+}
+
+static idx_t CountQueryThreads(Connection &con) {
+	query_thread_ids.clear();
+	auto result = con.Query("SELECT SUM(record_thread(i)) FROM integers");
+	REQUIRE(CHECK_COLUMN(result, 0, {Value::HUGEINT(1999999000000)}));
+	return query_thread_ids.size();
+}
+
+TEST_CASE("Test that the per-query thread limit bounds the threads that execute a query", "[api]") {
+	DuckDB db(nullptr);
+	Connection con(db);
+	REQUIRE_NO_FAIL(con.Query("PRAGMA threads=4"));
+	REQUIRE_NO_FAIL(con.Query("CREATE TABLE integers AS SELECT i FROM range(0, 2000000) tbl(i)"));
+	con.CreateVectorizedFunction("record_thread", {LogicalType::BIGINT}, LogicalType::BIGINT, &RecordThread);
+
+	// without a limit the worker threads help executing the query
+	REQUIRE(CountQueryThreads(con) > 1);
+	// only the thread of the connection executes the query
+	REQUIRE_NO_FAIL(con.Query("PRAGMA query_threads=1"));
+	REQUIRE(CountQueryThreads(con) == 1);
+	REQUIRE_NO_FAIL(con.Query("PRAGMA query_threads=2"));
+	REQUIRE(CountQueryThreads(con) <= 2);
+	REQUIRE_NO_FAIL(con.Query("PRAGMA query_threads=0"));
+	REQUIRE(CountQueryThreads(con) > 1);
+}
+
 TEST_CASE("Test multiple result sets", "[api]") {
 	unique_ptr<QueryResult> result;
 	DuckDB db(nullptr);
@@ -0,0 +1,426 @@
+#include "catch.hpp"
+#include "test_helpers.hpp"
+#include "parquet-extension.hpp"
+#include "httpfs-extension.hpp"
+#include "s3fs.hpp"
+#include "crypto.hpp"
+#include "duckdb/storage/buffer_manager.hpp"
+#define CPPHTTPLIB_OPENSSL_SUPPORT
+#include "httplib.hpp"
+
+#include <atomic>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+using namespace duckdb;
+using namespace std;
+
+//! A local HTTP server that serves the files of a directory, and counts the GET requests it receives
+class TestHTTPServer {
+public:
+	explicit TestHTTPServer(string directory_p) : directory(move(directory_p)), get_requests(0) {
+		server.Get("/(.*)", [&](const httplib::Request &req, httplib::Response &res) {
+			std::ifstream file(directory + "/" + req.matches[1].str(), std::ios::binary);
+			if (!file) {
+				res.status = 404;
+				return;
+			}
+			std::stringstream contents;
+			contents << file.rdbuf();
+			auto data = contents.str();
+			if (req.method == "GET") {
+				get_requests++;
+			}
+			res.set_header("ETag", "\"" + to_string(std::hash<string>()(data)) + "\"");
+			res.set_header("Last-Modified", "Mon, 01 Mar 2021 00:00:00 GMT");
+			res.set_content(data, "application/octet-stream");
+		});
+		port = server.bind_to_any_port("127.0.0.1");
+		thread = std::thread([&]() { server.listen_after_bind(); });
+		while (!server.is_running()) {
+			std::this_thread::yield();
+		}
+	}
+	~TestHTTPServer() {
+		server.stop();
+		thread.join();
+	}
+
+	string URL(const string &file) {
+		return "http://127.0.0.1:" + to_string(port) + "/" + file;
+	}
+
+	string directory;
+	std::atomic<idx_t> get_requests;
+
+private:
+	httplib::Server server;
+	std::thread thread;
+	int port;
+};
+
+static void CreateTestFile(Connection &con, const string &path, idx_t offset) {
+	REQUIRE_NO_FAIL(con.Query("COPY (SELECT i + " + to_string(offset) +
+	                          " AS i, i % 100 AS j, 'str' || i::VARCHAR AS s FROM range(0, 1000000) tbl(i)) TO '" +
+	                          path + "' (FORMAT 'parquet')"));
+}
+
+static string QueryTestFile(Connection &con, const string &path) {
+	auto result = con.Query("SELECT SUM(i), SUM(j), MIN(s), MAX(s) FROM parquet_scan('" + path + "')");
+	REQUIRE(result->success);
+	return result->ToString();
+}
+
+TEST_CASE("Test reading Parquet files over HTTP with the block cache", "[httpfs]") {
+	auto local_path = TestCreatePath("httpfs_test.parquet");
+	TestHTTPServer server(TestDirectoryPath());
+	auto url = server.URL("httpfs_test.parquet");
+
+	DuckDB db(nullptr);
+	db.LoadExtension<ParquetExtension>();
+	db.LoadExtension<HTTPFsExtension>();
+	Connection con(db);
+	REQUIRE_NO_FAIL(con.Query("PRAGMA threads=4"));
+	CreateTestFile(con, local_path, 0);
+
+	// the remote file returns the same result as the local file
+	auto local_result = QueryTestFile(con, local_path);
+	auto result = QueryTestFile(con, url);
+	REQUIRE(result == local_result);
+	// the column chunks are prefetched using a few coalesced requests instead of many small reads
+	auto file_size = db.instance->GetFileSystem().GetFileSize(
+	    *db.instance->GetFileSystem().OpenFile(local_path, FileFlags::FILE_FLAGS_READ));
+	auto first_requests = server.get_requests.load();
+	REQUIRE(first_requests > 0);
+	REQUIRE(first_requests <= (idx_t)file_size / HTTPBlockCache::BLOCK_SIZE + 4);
+
+	// a repeated query is answered from the cache
+	result = QueryTestFile(con, url);
+	REQUIRE(result == local_result);
+	REQUIRE(server.get_requests == first_requests);
+
+	// modifying the file changes its ETag, which invalidates the cached blocks
+	CreateTestFile(con, local_path, 42);
+	local_result = QueryTestFile(con, local_path);
+	result = QueryTestFile(con, url);
+	REQUIRE(result == local_result);
+	REQUIRE(server.get_requests > first_requests);
+
+	// without a cache every query fetches the file again
+	REQUIRE_NO_FAIL(con.Query("SET http_cache_size=0"));
+	auto requests = server.get_requests.load();
+	result = QueryTestFile(con, url);
+	REQUIRE(result == local_result);
+	REQUIRE(server.get_requests > requests);
+	requests = server.get_requests.load();
+	result = QueryTestFile(con, url);
+	REQUIRE(result == local_result);
+	REQUIRE(server.get_requests > requests);
+}
+
+TEST_CASE("Test that the HTTP block cache is charged to the memory limit", "[httpfs]") {
+	auto local_path = TestCreatePath("httpfs_memory_test.parquet");
+	TestHTTPServer server(TestDirectoryPath());
+	auto url = server.URL("httpfs_memory_test.parquet");
+
+	DuckDB db(nullptr);
+	db.LoadExtension<ParquetExtension>();
+	db.LoadExtension<HTTPFsExtension>();
+	Connection con(db);
+	CreateTestFile(con, local_path, 0);
+	auto local_result = QueryTestFile(con, local_path);
+
+	// the cached blocks are held in buffers of the buffer manager
+	auto &buffer_manager = BufferManager::GetBufferManager(*db.instance);
+	auto used_memory = buffer_manager.GetUsedMemory();
+	REQUIRE(QueryTestFile(con, url) == local_result);
+	REQUIRE(buffer_manager.GetUsedMemory() >= used_memory + 2 * HTTPBlockCache::BLOCK_SIZE);
+
+	// the buffer manager evicts cached blocks to stay within a lower memory limit
+	idx_t memory_limit = 8 * 1024 * 1024;
+	REQUIRE_NO_FAIL(con.Query("PRAGMA memory_limit='8MB'"));
+	REQUIRE(buffer_manager.GetUsedMemory() <= memory_limit);
+	REQUIRE(QueryTestFile(con, url) == local_result);
+	REQUIRE(buffer_manager.GetUsedMemory() <= memory_limit);
+}
+
+//! The total size of the files in the cache directory
+static idx_t CacheDirectorySize(const string &directory) {
+	FileSystem fs;
+	idx_t total_size = 0;
+	fs.ListFiles(directory, [&](string file_name, bool is_directory) {
+		auto handle = fs.OpenFile(fs.JoinPath(directory, file_name).c_str(), FileFlags::FILE_FLAGS_READ);
+		total_size += fs.GetFileSize(*handle);
+	});
+	return total_size;
+}
+
+TEST_CASE("Test the on-disk HTTP block cache", "[httpfs]") {
+	auto local_path = TestCreatePath("httpfs_disk_test.parquet");
+	auto cache_directory = TestCreatePath("httpfs_cache");
+	TestHTTPServer server(TestDirectoryPath());
+	auto url = server.URL("httpfs_disk_test.parquet");
+
+	string local_result;
+	{
+		DuckDB db(nullptr);
+		db.LoadExtension<ParquetExtension>();
+		db.LoadExtension<HTTPFsExtension>();
+		Connection con(db);
+		REQUIRE_NO_FAIL(con.Query("SET http_cache_directory='" + cache_directory + "'"));
+		CreateTestFile(con, local_path, 0);
+		local_result = QueryTestFile(con, local_path);
+		auto result = QueryTestFile(con, url);
+		REQUIRE(result == local_result);
+		REQUIRE(server.get_requests > 0);
+	}
+	// a new database instance reads the blocks from the cache directory
+	auto requests = server.get_requests.load();
+	auto cache_size = CacheDirectorySize(cache_directory);
+	REQUIRE(cache_size > 2 * HTTPBlockCache::BLOCK_SIZE);
+	{
+		DuckDB db(nullptr);
+		db.LoadExtension<ParquetExtension>();
+		db.LoadExtension<HTTPFsExtension>();
+		Connection con(db);
+		REQUIRE_NO_FAIL(con.Query("SET http_cache_directory='" + cache_directory + "'"));
+		auto result = QueryTestFile(con, url);
+		REQUIRE(result == local_result);
+		REQUIRE(server.get_requests == requests);
+		REQUIRE(CacheDirectorySize(cache_directory) == cache_size);
+	}
+	// the blocks written by an earlier instance count towards the disk limit, and are evicted when it is exceeded
+	DuckDB db(nullptr);
+	db.LoadExtension<ParquetExtension>();
+	db.LoadExtension<HTTPFsExtension>();
+	Connection con(db);
+	REQUIRE_NO_FAIL(con.Query("SET http_cache_directory='" + cache_directory + "'"));
+	REQUIRE_NO_FAIL(con.Query("SET http_cache_disk_size=" + to_string(2 * HTTPBlockCache::BLOCK_SIZE)));
+	auto result = QueryTestFile(con, url);
+	REQUIRE(result == local_result);
+	REQUIRE(CacheDirectorySize(cache_directory) <= 2 * HTTPBlockCache::BLOCK_SIZE);
+}
+
+//! A local S3-compatible server that supports the requests used to read files and to write them using multipart
+//! uploads. It verifies the payload hash that is signed by the S3 file system. Uploads to keys containing "fail" fail.
+class TestS3Server {
+public:
+	TestS3Server() : upload_count(0), part_count(0), max_part_size(0), completed_uploads(0), aborted_uploads(0) {
+		server.Get("/(.*)", [&](const httplib::Request &req, httplib::Response &res) {
+			lock_guard<mutex> guard(lock);
+			auto entry = objects.find(req.matches[1].str());
+			if (entry == objects.end()) {
+				res.status = 404;
+				return;
+			}
+			res.set_header("ETag", "\"" + to_string(std::hash<string>()(entry->second)) + "\"");
+			res.set_header("Last-Modified", "Mon, 01 Mar 2021 00:00:00 GMT");
+			res.set_content(entry->second, "application/octet-stream");
+		});
+		server.Post("/(.*)", [&](const httplib::Request &req, httplib::Response &res) {
+			lock_guard<mutex> guard(lock);
+			if (!VerifyPayload(req, res)) {
+				return;
+			}
+			if (req.has_param("uploads")) {
+				auto upload_id = "upload/" + to_string(++upload_count);
+				uploads[upload_id].clear();
+				res.set_content("<InitiateMultipartUploadResult><UploadId>" + upload_id +
+				                    "</UploadId></InitiateMultipartUploadResult>",
+				                "application/xml");
+				return;
+			}
+			auto upload = uploads.find(req.get_param_value("uploadId"));
+			if (upload == uploads.end()) {
+				res.status = 404;
+				return;
+			}
+			// concatenate the parts listed in the request
+			string data;
+			idx_t part_number = 1;
+			idx_t pos = 0;
+			while ((pos = req.body.find("<PartNumber>", pos)) != string::npos) {
+				auto etag_start = req.body.find("<ETag>", pos) + 6;
+				auto etag = req.body.substr(etag_start, req.body.find("</ETag>", pos) - etag_start);
+				auto &part = upload->second[part_number++];
+				if (etag != PartETag(part)) {
+					res.status = 400;
+					return;
+				}
+				data += part;
+				pos = etag_start;
+			}
+			if (part_number - 1 != upload->second.size()) {
+				res.status = 400;
+				return;
+			}
+			objects[req.matches[1].str()] = data;
+			uploads.erase(upload);
+			completed_uploads++;
+			res.set_content("<CompleteMultipartUploadResult></CompleteMultipartUploadResult>", "application/xml");
+		});
+		server.Put("/(.*)", [&](const httplib::Request &req, httplib::Response &res) {
+			lock_guard<mutex> guard(lock);
+			if (!VerifyPayload(req, res)) {
+				return;
+			}
+			auto upload = uploads.find(req.get_param_value("uploadId"));
+			if (upload == uploads.end() || req.matches[1].str().find("fail") != string::npos) {
+				res.status = 403;
+				return;
+			}
+			auto &part = upload->second[std::stoll(req.get_param_value("partNumber"))];
+			part = req.body;
+			part_count++;
+			max_part_size = MaxValue<idx_t>(max_part_size, part.size());
+			res.set_header("ETag", PartETag(part));
+		});
+		server.Delete("/(.*)", [&](const httplib::Request &req, httplib::Response &res) {
+			lock_guard<mutex> guard(lock);
+			if (!VerifyPayload(req, res)) {
+				return;
+			}
+			// abort a multipart upload, which discards its parts
+			auto upload = uploads.find(req.get_param_value("uploadId"));
+			if (upload == uploads.end()) {
+				res.status = 404;
+				return;
+			}
+			uploads.erase(upload);
+			aborted_uploads++;
+			res.status = 204;
+		});
+		port = server.bind_to_any_port("127.0.0.1");
+		thread = std::thread([&]() { server.listen_after_bind(); });
+		while (!server.is_running()) {
+			std::this_thread::yield();
+		}
+	}
+	~TestS3Server() {
+		server.stop();
+		thread.join();
+	}
+
+	void Configure(Connection &con, idx_t part_size) {
+		REQUIRE_NO_FAIL(con.Query("SET s3_endpoint='127.0.0.1:" + to_string(port) + "'"));
+		REQUIRE_NO_FAIL(con.Query("SET s3_url_style='path'"));
+		REQUIRE_NO_FAIL(con.Query("SET s3_use_ssl=false"));
+		REQUIRE_NO_FAIL(con.Query("SET s3_region='us-east-1'"));
+		REQUIRE_NO_FAIL(con.Query("SET s3_access_key_id='key'"));
+		REQUIRE_NO_FAIL(con.Query("SET s3_secret_access_key='secret'"));
+		REQUIRE_NO_FAIL(con.Query("SET s3_upload_part_size=" + to_string(part_size)));
+	}
+
+	mutex lock;
+	std::map<string, string> objects;
+	std::map<string, std::map<idx_t, string>> uploads;
+	idx_t upload_count;
+	idx_t part_count;
+	idx_t max_part_size;
+	idx_t completed_uploads;
+	idx_t aborted_uploads;
+
+private:
+	httplib::Server server;
+	std::thread thread;
+	int port;
+
+	static string PartETag(const string &part) {
+		return "\"" + to_string(std::hash<string>()(part)) + "\"";
+	}
+
+	static bool VerifyPayload(const httplib::Request &req, httplib::Response &res) {
+		hash_bytes hash;
+		hash_str hash_hex;
+		sha256(req.body.c_str(), req.body.size(), hash);
+		hex256(hash, hash_hex);
+		if (req.get_header_value("x-amz-content-sha256") != string((char *)hash_hex, sizeof(hash_str)) ||
+		    req.get_header_value("Authorization").find("AWS4-HMAC-SHA256 Credential=key/") != 0) {
+			res.status = 403;
+			return false;
+		}
+		return true;
+	}
+};
+
+static string ReadLocalFile(const string &path) {
+	std::ifstream file(path, std::ios::binary);
+	std::stringstream contents;
+	contents << file.rdbuf();
+	return contents.str();
+}
+
+TEST_CASE("Test writing files to S3 with multipart uploads", "[httpfs]") {
+	TestS3Server server;
+	DuckDB db(nullptr);
+	db.LoadExtension<ParquetExtension>();
+	db.LoadExtension<HTTPFsExtension>();
+	Connection con(db);
+	REQUIRE_NO_FAIL(con.Query("PRAGMA threads=4"));
+	server.Configure(con, S3FileSystem::MIN_UPLOAD_PART_SIZE);
+
+	// Parquet files are uploaded in multiple parts, and can be read back
+	auto local_path = TestCreatePath("s3_test.parquet");
+	CreateTestFile(con, local_path, 0);
+	CreateTestFile(con, "s3://bucket/dir/test.parquet", 0);
+	REQUIRE(server.completed_uploads == 1);
+	REQUIRE(server.part_count > 1);
+	REQUIRE(server.objects["bucket/dir/test.parquet"].size() == ReadLocalFile(local_path).size());
+	REQUIRE(QueryTestFile(con, "s3://bucket/dir/test.parquet") == QueryTestFile(con, local_path));
+
+	// CSV files are written as well
+	auto csv_path = TestCreatePath("s3_test.csv");
+	REQUIRE_NO_FAIL(con.Query("COPY (SELECT * FROM parquet_scan('" + local_path + "')) TO '" + csv_path + "'"));
+	REQUIRE_NO_FAIL(con.Query("COPY (SELECT * FROM parquet_scan('" + local_path + "')) TO 's3://bucket/test.csv'"));
+	REQUIRE(server.completed_uploads == 2);
+	REQUIRE(server.objects["bucket/test.csv"] == ReadLocalFile(csv_path));
+
+	// an empty file is uploaded as a single empty part
+	REQUIRE_NO_FAIL(con.Query("COPY (SELECT 42 WHERE 1=0) TO 's3://bucket/empty.csv'"));
+	REQUIRE(server.completed_uploads == 3);
+	REQUIRE(server.objects.find("bucket/empty.csv") != server.objects.end());
+	REQUIRE(server.objects["bucket/empty.csv"].empty());
+
+	// a failed part upload fails the copy, the file is not created and the parts that were uploaded are discarded
+	REQUIRE_FAIL(con.Query("COPY (SELECT * FROM parquet_scan('" + local_path + "')) TO 's3://bucket/fail.csv'"));
+	REQUIRE(server.completed_uploads == 3);
+	REQUIRE(server.objects.find("bucket/fail.csv") == server.objects.end());
+	REQUIRE(server.aborted_uploads == 1);
+	REQUIRE(server.uploads.empty());
+
+	// a file with more parts than are uploaded at the same time
+	auto part_count = server.part_count;
+	auto large_path = TestCreatePath("s3_large_test.csv");
+	auto query = "COPY (SELECT i, 'row ' || i::VARCHAR AS s FROM range(0, 3000000) tbl(i)) TO ";
+	REQUIRE_NO_FAIL(con.Query(string(query) + "'" + large_path + "'"));
+	REQUIRE_NO_FAIL(con.Query(string(query) + "'s3://bucket/large.csv'"));
+	REQUIRE(server.completed_uploads == 4);
+	REQUIRE(server.part_count - part_count > (idx_t)S3FileSystem::MAX_PARALLEL_UPLOADS);
+	REQUIRE(server.objects["bucket/large.csv"] == ReadLocalFile(large_path));
+}
+
+TEST_CASE("Test the part size of multipart uploads to S3", "[httpfs]") {
+	TestS3Server server;
+	DuckDB db(nullptr);
+	db.LoadExtension<HTTPFsExtension>();
+	Connection con(db);
+	server.Configure(con, S3FileSystem::MIN_UPLOAD_PART_SIZE);
+
+	// S3 does not accept parts smaller than 5MB (except the last one)
+	REQUIRE_NO_FAIL(con.Query("SET s3_upload_part_size=" + to_string(S3FileSystem::MIN_UPLOAD_PART_SIZE - 1)));
+	REQUIRE_FAIL(con.Query("COPY (SELECT 42) TO 's3://bucket/small_parts.csv'"));
+	REQUIRE(server.upload_count == 0);
+
+	// the part size doubles every PART_SIZE_DOUBLING_INTERVAL parts, so files of about 5TB (the maximum object size of
+	// S3) stay below the part limit of S3
+	idx_t part_size = S3FileSystem::DEFAULT_UPLOAD_PART_SIZE;
+	idx_t total_size = 0;
+	for (idx_t part_number = 1; part_number <= S3FileSystem::MAX_UPLOAD_PARTS; part_number++) {
+		total_size += part_size;
+		part_size = S3FileSystem::NextPartSize(part_size, part_number);
+	}
+	REQUIRE(total_size > (idx_t)5000000000000);
+}
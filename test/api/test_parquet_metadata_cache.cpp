@@ -0,0 +1,193 @@
+#include "catch.hpp"
+#include "test_helpers.hpp"
+#include "parquet-extension.hpp"
+
+#include <algorithm>
+#include <sys/stat.h>
+#include <utime.h>
+
+using namespace duckdb;
+using namespace std;
+
+//! The modification times of the files in this test lie well in the past, so their metadata is trusted by the cache
+static void SetModifiedTime(const string &path, time_t modified_time) {
+	struct utimbuf times;
+	times.actime = modified_time;
+	times.modtime = modified_time;
+	REQUIRE(utime(path.c_str(), &times) == 0);
+}
+
+static time_t GetModifiedTime(const string &path) {
+	struct stat file_stat;
+	REQUIRE(stat(path.c_str(), &file_stat) == 0);
+	return file_stat.st_mtime;
+}
+
+//! Returns the paths of the metadata files in the cache directory
+static vector<string> MetadataFiles(const string &directory) {
+	FileSystem fs;
+	vector<string> result;
+	fs.ListFiles(directory, [&](string file_name, bool is_directory) {
+		if (StringUtil::EndsWith(file_name, ".metadata")) {
+			result.push_back(fs.JoinPath(directory, file_name));
+		}
+	});
+	return result;
+}
+
+static void WriteTestFile(Connection &con, const string &path, idx_t count, time_t modified_time) {
+	REQUIRE_NO_FAIL(con.Query("COPY (SELECT i FROM range(0, " + to_string(count) + ") tbl(i)) TO '" + path +
+	                          "' (FORMAT PARQUET)"));
+	SetModifiedTime(path, modified_time);
+}
+
+static void CheckTestFile(Connection &con, const string &path, idx_t count) {
+	auto result = con.Query("SELECT count(*), sum(i) FROM parquet_scan('" + path + "')");
+	REQUIRE(CHECK_COLUMN(result, 0, {Value::BIGINT(count)}));
+	REQUIRE(CHECK_COLUMN(result, 1, {Value::HUGEINT(count * (count - 1) / 2)}));
+}
+
+TEST_CASE("Test invalidation and persistence of the on-disk Parquet metadata cache", "[parquet]") {
+	auto path = TestCreatePath("metadata_cache_test.parquet");
+	auto cache_directory = TestCreatePath("metadata_cache_test");
+	// a cache entry that is not rewritten by a scan keeps this modification time
+	const time_t old_time = 1500000000;
+	const time_t file_time = 1600000000;
+
+	{
+		DuckDB db(nullptr);
+		db.LoadExtension<ParquetExtension>();
+		Connection con(db);
+		REQUIRE_NO_FAIL(con.Query("SET parquet_metadata_cache_directory='" + cache_directory + "'"));
+		WriteTestFile(con, path, 1000, file_time);
+		CheckTestFile(con, path, 1000);
+	}
+	auto cache_files = MetadataFiles(cache_directory);
+	REQUIRE(cache_files.size() == 1);
+	auto cache_file = cache_files[0];
+
+	DuckDB db(nullptr);
+	db.LoadExtension<ParquetExtension>();
+	Connection con(db);
+	REQUIRE_NO_FAIL(con.Query("SET parquet_metadata_cache_directory='" + cache_directory + "'"));
+
+	// after a restart the metadata is read from the cache: the cache entry is not written again
+	SetModifiedTime(cache_file, old_time);
+	CheckTestFile(con, path, 1000);
+	REQUIRE(GetModifiedTime(cache_file) == old_time);
+
+	// a cache entry with another format version (e.g. written by another version of the extension) is a cache miss,
+	// and is replaced
+	{
+		FileSystem fs;
+		auto handle = fs.OpenFile(cache_file, FileFlags::FILE_FLAGS_WRITE);
+		uint32_t version = 0xFFFFFFFF;
+		fs.Write(*handle, &version, sizeof(uint32_t), sizeof(uint32_t));
+	}
+	SetModifiedTime(cache_file, old_time);
+	CheckTestFile(con, path, 1000);
+	REQUIRE(GetModifiedTime(cache_file) != old_time);
+	SetModifiedTime(cache_file, old_time);
+	CheckTestFile(con, path, 1000);
+	REQUIRE(GetModifiedTime(cache_file) == old_time);
+
+	// a file with another modification time is read again, and its cache entry is replaced
+	SetModifiedTime(path, file_time + 100);
+	CheckTestFile(con, path, 1000);
+	REQUIRE(GetModifiedTime(cache_file) != old_time);
+	SetModifiedTime(cache_file, old_time);
+	CheckTestFile(con, path, 1000);
+	REQUIRE(GetModifiedTime(cache_file) == old_time);
+
+	// a file with another size but the same modification time is read again as well
+	WriteTestFile(con, path, 2000, file_time + 100);
+	CheckTestFile(con, path, 2000);
+	REQUIRE(GetModifiedTime(cache_file) != old_time);
+	REQUIRE(MetadataFiles(cache_directory).size() == 1);
+}
+
+TEST_CASE("Test the size limit of the on-disk Parquet metadata cache", "[parquet]") {
+	auto cache_directory = TestCreatePath("metadata_cache_limit_test");
+	DuckDB db(nullptr);
+	db.LoadExtension<ParquetExtension>();
+	Connection con(db);
+	REQUIRE_NO_FAIL(con.Query("SET parquet_metadata_cache_directory='" + cache_directory + "'"));
+
+	vector<string> paths;
+	for (idx_t i = 0; i < 10; i++) {
+		paths.push_back(TestCreatePath("metadata_cache_limit_" + to_string(i) + ".parquet"));
+		WriteTestFile(con, paths.back(), 100, 1600000000);
+		CheckTestFile(con, paths.back(), 100);
+	}
+	REQUIRE(MetadataFiles(cache_directory).size() == 10);
+	idx_t entry_size;
+	{
+		FileSystem fs;
+		auto handle = fs.OpenFile(MetadataFiles(cache_directory)[0], FileFlags::FILE_FLAGS_READ);
+		entry_size = fs.GetFileSize(*handle);
+	}
+
+	// the least recently used entries are removed once the cache exceeds its size limit (the entry of the extra file
+	// is a few bytes larger, as its path is longer)
+	REQUIRE_NO_FAIL(con.Query("SET parquet_metadata_cache_size=" + to_string(3 * entry_size + 64)));
+	CheckTestFile(con, paths[0], 100);
+	auto extra_path = TestCreatePath("metadata_cache_limit_extra.parquet");
+	WriteTestFile(con, extra_path, 100, 1600000000);
+	CheckTestFile(con, extra_path, 100);
+	auto cache_files = MetadataFiles(cache_directory);
+	REQUIRE(cache_files.size() == 3);
+	// the entry of the first file was used recently, so it is kept
+	auto first_entry = FileSystem().JoinPath(cache_directory, to_string(std::hash<string>()(paths[0])) + ".metadata");
+	REQUIRE(std::find(cache_files.begin(), cache_files.end(), first_entry) != cache_files.end());
+
+	// without space in the cache, nothing is kept
+	REQUIRE_NO_FAIL(con.Query("SET parquet_metadata_cache_size=0"));
+	for (auto &path : paths) {
+		CheckTestFile(con, path, 100);
+	}
+	REQUIRE(MetadataFiles(cache_directory).empty());
+}
+
+//! Returns the paths of the glob statistics files in the cache directory
+static vector<string> StatisticsFiles(const string &directory) {
+	FileSystem fs;
+	vector<string> result;
+	fs.ListFiles(directory, [&](string file_name, bool is_directory) {
+		if (StringUtil::EndsWith(file_name, ".statistics")) {
+			result.push_back(fs.JoinPath(directory, file_name));
+		}
+	});
+	return result;
+}
+
+TEST_CASE("Test the modification time granularity of the cached Parquet glob statistics", "[parquet]") {
+	FileSystem fs;
+	auto directory = TestCreatePath("glob_statistics_test");
+	auto cache_directory = TestCreatePath("glob_statistics_cache");
+	fs.CreateDirectory(directory);
+	DuckDB db(nullptr);
+	db.LoadExtension<ParquetExtension>();
+	Connection con(db);
+	REQUIRE_NO_FAIL(con.Query("SET parquet_metadata_cache_directory='" + cache_directory + "'"));
+
+	vector<string> paths;
+	for (idx_t i = 0; i < 3; i++) {
+		paths.push_back(fs.JoinPath(directory, "glob_statistics_" + to_string(i) + ".parquet"));
+		WriteTestFile(con, paths.back(), 100, 1600000000);
+	}
+	auto glob = fs.JoinPath(directory, "*.parquet");
+	// the first scan caches the metadata of every file, the second one merges it into the statistics of the glob
+	for (idx_t i = 0; i < 2; i++) {
+		REQUIRE_NO_FAIL(con.Query("SELECT * FROM parquet_scan('" + glob + "') WHERE i > 1000"));
+	}
+	REQUIRE(StatisticsFiles(cache_directory).size() == 1);
+
+	// the statistics of a glob with a file that was modified just now are not cached, as a modification within the
+	// granularity of the modification time could go unnoticed
+	fs.RemoveFile(StatisticsFiles(cache_directory)[0]);
+	WriteTestFile(con, paths[0], 100, time(nullptr));
+	for (idx_t i = 0; i < 2; i++) {
+		REQUIRE_NO_FAIL(con.Query("SELECT * FROM parquet_scan('" + glob + "') WHERE i > 1000"));
+	}
+	REQUIRE(StatisticsFiles(cache_directory).empty());
+}
@@ -1,7 +1,9 @@
 #include "catch.hpp"
 #include "test_helpers.hpp"
 
+#include <atomic>
 #include <iostream>
+#include <thread>
 
 using namespace duckdb;
 using namespace std;
@@ -23,3 +25,47 @@ TEST_CASE("Test query profiler", "[api]") {
 	output = con.GetProfilingInformation(ProfilerPrintFormat::JSON);
 	REQUIRE(output.size() > 0);
 }
+
+static double ExtractIOWait(const string &json) {
+	auto pos = json.find("\"io_wait\": ");
+	REQUIRE(pos != string::npos);
+	return std::stod(json.substr(pos + 11));
+}
+
+TEST_CASE("Test I/O wait time of the query profiler", "[api]") {
+	auto db_path = TestCreatePath("profiler_io_wait.db");
+	DeleteDatabase(db_path);
+	{
+		DuckDB db(db_path);
+		Connection con(db);
+		REQUIRE_NO_FAIL(con.Query("CREATE TABLE integers AS SELECT i FROM range(0, 2000000) tbl(i)"));
+	}
+	{
+		// the first scan of the persistent table reads its blocks from the database file
+		DuckDB db(db_path);
+		Connection con(db);
+		con.EnableProfiling();
+		REQUIRE_NO_FAIL(con.Query("SELECT SUM(i) FROM integers"));
+		REQUIRE(ExtractIOWait(con.GetProfilingInformation(ProfilerPrintFormat::JSON)) > 0);
+	}
+	DuckDB db(db_path);
+	Connection con(db);
+	Connection other(db);
+	REQUIRE_NO_FAIL(con.Query("CREATE TEMPORARY TABLE temp_integers AS SELECT i FROM range(0, 2000000) tbl(i)"));
+	con.EnableProfiling();
+
+	// a scan of the in-memory temporary table never waits for reads, even while another connection reads the
+	// blocks of the persistent table
+	std::atomic<bool> done(false);
+	auto reader = thread([&]() {
+		while (!done) {
+			other.Query("SELECT SUM(i) FROM integers");
+		}
+	});
+	for (idx_t i = 0; i < 5; i++) {
+		REQUIRE_NO_FAIL(con.Query("SELECT SUM(i) FROM temp_integers"));
+		REQUIRE(ExtractIOWait(con.GetProfilingInformation(ProfilerPrintFormat::JSON)) == 0);
+	}
+	done = true;
+	reader.join();
+}
@@ -5,6 +5,7 @@
 #include "duckdb/common/types/time.hpp"
 #include "duckdb/common/types/timestamp.hpp"
 
+#include <limits>
 #include <vector>
 
 using namespace duckdb;
@@ -267,3 +268,39 @@ TEST_CASE("Test appender with string lengths", "[appender]") {
 	result = con.Query("SELECT * FROM my_table");
 	REQUIRE(CHECK_COLUMN(result, 0, {"asd"}));
 }
+
+TEST_CASE("Test appending extreme BIGINT values to a bit-packed column", "[appender]") {
+	unique_ptr<QueryResult> result;
+	auto storage_database = TestCreatePath("appender_bitpacking");
+	DeleteDatabase(storage_database);
+	// INT64_MIN cannot be written in SQL, the appender writes it to the column directly
+	const int64_t min_value = std::numeric_limits<int64_t>::min();
+	const int64_t max_value = std::numeric_limits<int64_t>::max();
+	vector<Value> values {Value::BIGINT(min_value), Value::BIGINT(min_value + 1), Value::BIGINT(max_value),
+	                      Value::BIGINT(0), Value()};
+	{
+		DuckDB db(storage_database);
+		Connection con(db);
+		REQUIRE_NO_FAIL(con.Query("PRAGMA force_compression='bitpacking'"));
+		REQUIRE_NO_FAIL(con.Query("CREATE TABLE extremes(a BIGINT)"));
+		Appender appender(con, "extremes");
+		appender.AppendRow(min_value);
+		appender.AppendRow(min_value + 1);
+		appender.AppendRow(max_value);
+		appender.AppendRow((int64_t)0);
+		appender.AppendRow(nullptr);
+		appender.Close();
+		REQUIRE_NO_FAIL(con.Query("CHECKPOINT"));
+
+		result = con.Query("SELECT compression FROM pragma_storage_info('extremes') WHERE segment_type='BIGINT'");
+		REQUIRE(CHECK_COLUMN(result, 0, {"BitPacking"}));
+	}
+	// the full bit width survives a restart
+	{
+		DuckDB db(storage_database);
+		Connection con(db);
+		result = con.Query("SELECT a FROM extremes ORDER BY rowid");
+		REQUIRE(CHECK_COLUMN(result, 0, values));
+	}
+	DeleteDatabase(storage_database);
+}
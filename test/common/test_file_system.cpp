@@ -57,6 +57,79 @@ TEST_CASE("Make sure file system operators work as advertised", "[file_system]")
 	REQUIRE(!fs.FileExists(fname_in_dir2));
 }
 
+TEST_CASE("Test that a glob reports the size and modification time of the files it lists", "[file_system]") {
+	FileSystem fs;
+	auto dname = TestCreatePath("TEST_GLOB_DIR");
+	if (fs.DirectoryExists(dname)) {
+		fs.RemoveDirectory(dname);
+	}
+	fs.CreateDirectory(dname);
+	auto fname = fs.JoinPath(dname, "TEST_FILE");
+	create_dummy_file(fname);
+
+	vector<string> files;
+	vector<FileInfo> file_info;
+	REQUIRE(fs.GlobFileInfo(fs.JoinPath(dname, "TEST_*"), files, file_info));
+	REQUIRE(files.size() == 1);
+	REQUIRE(file_info.size() == 1);
+	auto handle = fs.OpenFile(fname, FileFlags::FILE_FLAGS_READ);
+	REQUIRE(file_info[0].file_size == (idx_t)fs.GetFileSize(*handle));
+	REQUIRE(file_info[0].last_modified == fs.GetLastModifiedTime(*handle));
+	handle.reset();
+
+	// a path without a glob is not listed, so the caller falls back to Glob
+	REQUIRE(!fs.GlobFileInfo(fname, files, file_info));
+	REQUIRE(files.empty());
+	REQUIRE(file_info.empty());
+	REQUIRE(fs.Glob(fname).size() == 1);
+
+	fs.RemoveDirectory(dname);
+}
+
+//! A file system with a single directory, which lists its files through the virtual ListFiles
+class ListingFileSystem : public FileSystem {
+public:
+	explicit ListingFileSystem(bool report_file_info) : report_file_info(report_file_info) {
+	}
+
+	bool ListFiles(const string &directory, const std::function<void(string, bool)> &callback) override {
+		return ListFiles(directory, [&](const string &name, bool is_directory, const FileInfo &) {
+			callback(name, is_directory);
+		});
+	}
+	bool ListFiles(const string &directory,
+	               const std::function<void(const string &, bool, const FileInfo &)> &callback) override {
+		if (!report_file_info || directory != "/listing") {
+			return false;
+		}
+		FileInfo file_info;
+		file_info.file_size = 42;
+		file_info.last_modified = 1600000000;
+		callback("file.parquet", false, file_info);
+		return true;
+	}
+
+private:
+	bool report_file_info;
+};
+
+TEST_CASE("Test that a glob lists the files through the file system", "[file_system]") {
+	ListingFileSystem fs(true);
+	vector<string> files;
+	vector<FileInfo> file_info;
+	REQUIRE(fs.GlobFileInfo("/listing/*.parquet", files, file_info));
+	REQUIRE(files.size() == 1);
+	REQUIRE(files[0] == "/listing/file.parquet");
+	REQUIRE(file_info[0].file_size == 42);
+	REQUIRE(file_info[0].last_modified == 1600000000);
+
+	// without the file info, GlobFileInfo fails
+	ListingFileSystem fs_without_info(false);
+	REQUIRE(!fs_without_info.GlobFileInfo("/listing/*.parquet", files, file_info));
+	REQUIRE(files.empty());
+	REQUIRE(file_info.empty());
+}
+
 // note: the integer count is chosen as 512 so that we write 512*8=4096 bytes to the file
 // this is required for the Direct-IO as on Windows Direct-IO can only write multiples of sector sizes
 // sector sizes are typically one of [512/1024/2048/4096] bytes, hence a 4096 bytes write succeeds.
@@ -129,3 +202,72 @@ TEST_CASE("Test file buffers for reading/writing to file", "[file_system]") {
 
 	fs.RemoveFile(fname);
 }
+
+//! A file system that keeps files in memory and only implements sequential reads and writes
+class SequentialMemoryFileSystem : public FileSystem {
+public:
+	struct MemoryFileHandle : public FileHandle {
+		MemoryFileHandle(FileSystem &file_system, string path, string &data)
+		    : FileHandle(file_system, move(path)), data(data), position(0) {
+		}
+
+		string &data;
+		idx_t position;
+
+	protected:
+		void Close() override {
+		}
+	};
+
+	unique_ptr<FileHandle> OpenFile(const char *path, uint8_t flags, FileLockType lock) override {
+		return make_unique<MemoryFileHandle>(*this, path, files[path]);
+	}
+	int64_t Read(FileHandle &handle, void *buffer, int64_t nr_bytes) override {
+		auto &memory_handle = (MemoryFileHandle &)handle;
+		auto bytes_read = MinValue<int64_t>(nr_bytes, memory_handle.data.size() - memory_handle.position);
+		memcpy(buffer, memory_handle.data.data() + memory_handle.position, bytes_read);
+		memory_handle.position += bytes_read;
+		return bytes_read;
+	}
+	int64_t Write(FileHandle &handle, void *buffer, int64_t nr_bytes) override {
+		auto &memory_handle = (MemoryFileHandle &)handle;
+		if (memory_handle.data.size() < memory_handle.position + nr_bytes) {
+			memory_handle.data.resize(memory_handle.position + nr_bytes);
+		}
+		memcpy((char *)memory_handle.data.data() + memory_handle.position, buffer, nr_bytes);
+		memory_handle.position += nr_bytes;
+		return nr_bytes;
+	}
+	using FileSystem::Read;
+	using FileSystem::Write;
+
+protected:
+	void SetFilePointer(FileHandle &handle, idx_t location) override {
+		((MemoryFileHandle &)handle).position = location;
+	}
+
+private:
+	unordered_map<string, string> files;
+};
+
+TEST_CASE("Test positional reads and writes on a file system without positional I/O", "[file_system]") {
+	SequentialMemoryFileSystem fs;
+	int64_t test_data[10];
+	for (int i = 0; i < 10; i++) {
+		test_data[i] = i;
+	}
+	auto handle = fs.OpenFile("test_file", FileFlags::FILE_FLAGS_WRITE, FileLockType::NO_LOCK);
+	// the positional writes fall back to seeking and writing sequentially
+	REQUIRE_NOTHROW(handle->Write((void *)(test_data + 5), sizeof(int64_t) * 5, sizeof(int64_t) * 5));
+	REQUIRE_NOTHROW(handle->Write((void *)test_data, sizeof(int64_t) * 5, 0));
+
+	for (int i = 0; i < 10; i++) {
+		test_data[i] = 0;
+	}
+	REQUIRE_NOTHROW(handle->Read((void *)test_data, sizeof(int64_t) * 10, 0));
+	for (int i = 0; i < 10; i++) {
+		REQUIRE(test_data[i] == i);
+	}
+	// reading past the end of the file fails
+	REQUIRE_THROWS(handle->Read((void *)test_data, sizeof(int64_t), sizeof(int64_t) * 10));
+}
@@ -301,3 +301,122 @@ TEST_CASE("Parallel appends to table with index with transactions", "[index][.]"
 	REQUIRE(CHECK_COLUMN(result, 0, {Value::BIGINT(CONCURRENT_INDEX_THREAD_COUNT * 50)}));
 	REQUIRE(CHECK_COLUMN(result, 1, {Value::BIGINT(CONCURRENT_INDEX_THREAD_COUNT * 50)}));
 }
+
+static void lookup_in_primary_key(DuckDB *db, bool *correct, idx_t thread_nr) {
+	Connection con(*db);
+	std::uniform_int_distribution<> distribution(0, 9999);
+	std::mt19937 gen;
+	gen.seed(thread_nr);
+
+	correct[thread_nr] = true;
+	while (!is_finished) {
+		// the keys below 10000 are never changed
+		auto key = distribution(gen);
+		auto result = con.Query("SELECT i FROM integers WHERE i = " + to_string(key));
+		if (!CHECK_COLUMN(result, 0, {Value::INTEGER(key)})) {
+			correct[thread_nr] = false;
+		}
+	}
+}
+
+static void insert_and_delete_primary_key(DuckDB *db, bool *correct, idx_t thread_nr) {
+	Connection con(*db);
+	correct[thread_nr] = true;
+	for (int32_t i = 0; i < 20; i++) {
+		int32_t start = 10000 + ((thread_nr / 2) * 20 + i) * 100;
+		auto result = con.Query("INSERT INTO integers SELECT * FROM range(" + to_string(start) + ", " +
+		                        to_string(start + 100) + ")");
+		if (!result->success) {
+			correct[thread_nr] = false;
+		}
+		result = con.Query("DELETE FROM integers WHERE i >= " + to_string(start) + " AND i < " +
+		                   to_string(start + 50));
+		if (!result->success) {
+			correct[thread_nr] = false;
+		}
+	}
+}
+
+TEST_CASE("Concurrent point lookups during inserts and deletes on PRIMARY KEY column", "[index][.]") {
+	unique_ptr<QueryResult> result;
+	DuckDB db(nullptr);
+	Connection con(db);
+
+	REQUIRE_NO_FAIL(con.Query("CREATE TABLE integers(i INTEGER PRIMARY KEY)"));
+	REQUIRE_NO_FAIL(con.Query("INSERT INTO integers SELECT * FROM range(0, 10000)"));
+
+	// half of the threads look up keys while the other half changes the tree around them
+	is_finished = false;
+	bool correct[CONCURRENT_INDEX_THREAD_COUNT];
+	thread threads[CONCURRENT_INDEX_THREAD_COUNT];
+	for (idx_t i = 0; i < CONCURRENT_INDEX_THREAD_COUNT; i++) {
+		threads[i] =
+		    thread(i % 2 == 0 ? lookup_in_primary_key : insert_and_delete_primary_key, &db, correct, i);
+	}
+	for (idx_t i = 1; i < CONCURRENT_INDEX_THREAD_COUNT; i += 2) {
+		threads[i].join();
+	}
+	is_finished = true;
+	for (idx_t i = 0; i < CONCURRENT_INDEX_THREAD_COUNT; i += 2) {
+		threads[i].join();
+	}
+	for (idx_t i = 0; i < CONCURRENT_INDEX_THREAD_COUNT; i++) {
+		REQUIRE(correct[i]);
+	}
+
+	result = con.Query("SELECT COUNT(*), COUNT(DISTINCT i) FROM integers");
+	REQUIRE(CHECK_COLUMN(result, 0, {Value::BIGINT(10000 + CONCURRENT_INDEX_THREAD_COUNT / 2 * 20 * 50)}));
+	REQUIRE(CHECK_COLUMN(result, 1, {Value::BIGINT(10000 + CONCURRENT_INDEX_THREAD_COUNT / 2 * 20 * 50)}));
+	// the deleted keys can be inserted again
+	REQUIRE_NO_FAIL(con.Query("INSERT INTO integers SELECT * FROM range(10000, 10050)"));
+	REQUIRE_FAIL(con.Query("INSERT INTO integers VALUES (10050)"));
+}
+
+static void insert_ranges_to_primary_key(DuckDB *db, bool *correct, atomic<idx_t> *count, idx_t thread_nr) {
+	Connection con(*db);
+	correct[thread_nr] = true;
+	for (int32_t i = 0; i < 20; i++) {
+		// every thread inserts its own keys, together with a range of keys that all threads try to insert
+		int32_t start = (thread_nr * 20 + i) * 100;
+		auto result = con.Query("INSERT INTO integers SELECT * FROM range(" + to_string(start) + ", " +
+		                        to_string(start + 100) + ")");
+		if (!result->success) {
+			correct[thread_nr] = false;
+		}
+		start = -100 * (i + 1);
+		result = con.Query("INSERT INTO integers SELECT * FROM range(" + to_string(start) + ", " +
+		                   to_string(start + 100) + ")");
+		if (result->success) {
+			(*count)++;
+		}
+	}
+}
+
+TEST_CASE("Concurrent inserts of ranges into PRIMARY KEY column", "[index][.]") {
+	unique_ptr<QueryResult> result;
+	DuckDB db(nullptr);
+	Connection con(db);
+
+	REQUIRE_NO_FAIL(con.Query("CREATE TABLE integers(i INTEGER PRIMARY KEY)"));
+
+	// the constraint checks of the threads run concurrently with the index appends of the other threads
+	atomic<idx_t> count;
+	count = 0;
+	bool correct[CONCURRENT_INDEX_THREAD_COUNT];
+	thread threads[CONCURRENT_INDEX_THREAD_COUNT];
+	for (idx_t i = 0; i < CONCURRENT_INDEX_THREAD_COUNT; i++) {
+		threads[i] = thread(insert_ranges_to_primary_key, &db, correct, &count, i);
+	}
+	for (idx_t i = 0; i < CONCURRENT_INDEX_THREAD_COUNT; i++) {
+		threads[i].join();
+		REQUIRE(correct[i]);
+	}
+	// every shared range was inserted by exactly one thread
+	REQUIRE(count == 20);
+
+	result = con.Query("SELECT COUNT(*), COUNT(DISTINCT i) FROM integers");
+	REQUIRE(CHECK_COLUMN(result, 0, {Value::BIGINT(CONCURRENT_INDEX_THREAD_COUNT * 20 * 100 + 20 * 100)}));
+	REQUIRE(CHECK_COLUMN(result, 1, {Value::BIGINT(CONCURRENT_INDEX_THREAD_COUNT * 20 * 100 + 20 * 100)}));
+	REQUIRE_FAIL(con.Query("INSERT INTO integers VALUES (0)"));
+	REQUIRE_FAIL(con.Query("INSERT INTO integers VALUES (-1)"));
+}